@@ -116,4 +116,15 @@ enum class VarianceMethod
     PopulationVariance
     };
 
+/// @brief How batch projects handle documents that are nearly identical to
+///     a document loaded before them.
+enum class NearDuplicateHandling
+    {
+    Include,                       /*!< Analyze near duplicates like any other document.*/
+    Report,                        /*!< Analyze near duplicates, but list them as warnings.*/
+    Skip,                          /*!< List near duplicates as warnings and leave them
+                                        out of the results (but keep them in the project).*/
+    NEAR_DUPLICATE_HANDLING_COUNT  /*!< The number of handling methods.*/
+    };
+
 #endif //__OPTION_ENUMS_H__
@@ -12,13 +12,14 @@
  ********************************************************************************/
 
 #include "readability_app.h"
-#include "../Wisteria-Dataviz/src/CRCpp/inc/CRC.h"
 #include "../Wisteria-Dataviz/src/ui/dialogs/filelistdlg.h"
 #include "../Wisteria-Dataviz/src/ui/dialogs/getdirdlg.h"
 #include "../Wisteria-Dataviz/src/ui/dialogs/graphdlg.h"
 #include "../Wisteria-Dataviz/src/ui/dialogs/radioboxdlg.h"
 #include "../Wisteria-Dataviz/src/ui/ribbon/artmetro.h"
 #include "../document-helpers/chapter_split.h"
+#include "../document-helpers/duplicate_file_finder.h"
+#include "../indexing/pipeline_stats.h"
 #include "../projects/batch_project_doc.h"
 #include "../projects/batch_project_view.h"
 #include "../projects/standard_project_doc.h"
@@ -29,6 +30,7 @@
 #include "../ui/dialogs/project_wizard_dlg.h"
 #include "../ui/dialogs/test_bundle_dlg.h"
 #include "../ui/dialogs/tools_options_dlg.h"
+#include <wx/msgout.h>
 
 using namespace Wisteria;
 using namespace Wisteria::GraphItems;
@@ -298,6 +300,30 @@ void ReadabilityApp::OnEventLoopEnter(wxEventLoopBase* loop)
                   wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
                 { wxCMD_LINE_OPTION, _DT("lua"), _DT("lua"), wxTRANSLATE("Runs a Lua script"),
                   wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_SWITCH, _DT("headless"), _DT("headless"),
+                  wxTRANSLATE("Runs the Lua script (or watches the folder) without showing any "
+                              "windows or prompts; a script exits when finished "
+                              "(returning non-zero if it failed)"),
+                  wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_OPTION, nullptr, _DT("watch"),
+                  wxTRANSLATE("Scores the documents in a folder (and its subfolders) as they are "
+                              "added or changed; use with --headless to run as a service"),
+                  wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_OPTION, nullptr, _DT("serve"),
+                  wxTRANSLATE("Scores text and files sent to this port on the local machine "
+                              "(over HTTP); use with --headless to run as a service"),
+                  wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_OPTION, nullptr, _DT("results"),
+                  wxTRANSLATE("The file to append the watched folder's scores to "
+                              "(default is readability-results.jsonl in the folder)"),
+                  wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_OPTION, nullptr, _DT("workers"),
+                  wxTRANSLATE("The number of documents (or connections, when serving) to score "
+                              "at the same time (default is one per core)"),
+                  wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+                { wxCMD_LINE_OPTION, nullptr, _DT("bundle"),
+                  wxTRANSLATE("The test bundle to score documents with (when watching or serving)"),
+                  wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
                 { wxCMD_LINE_OPTION, _DT("loglevel"), _DT("loglevel"),
                   wxTRANSLATE("Log report level (0 = none, 1 = standard, 2 = verbose, 3 = max)."),
                   wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
@@ -332,8 +358,59 @@ void ReadabilityApp::OnEventLoopEnter(wxEventLoopBase* loop)
                     wxLog::SetLogLevel(wxLOG_Max);
                     }
                 }
+            // there is no help window to show when running headless, so print the usage instead
+            if (IsHeadless() && CommandLineResult == -1)
+                {
+                cmdParser.Usage();
+                loop->ScheduleExit(EXIT_SUCCESS);
+                initEventProcessing = false;
+                return;
+                }
+            // score a folder's documents as they arrive, or requests sent to a port
+            // (these run until the program is closed)
+            const bool watchFolder = cmdParser.Found(_DT(L"watch"));
+            const bool serveScores = cmdParser.Found(_DT(L"serve"));
+            if (watchFolder || serveScores)
+                {
+                const bool servicesStarted =
+                    (!watchFolder || StartWatchFolderService(cmdParser)) &&
+                    (!serveScores || StartScoringServer(cmdParser));
+                if (IsHeadless())
+                    {
+                    if (!servicesStarted)
+                        {
+                        loop->ScheduleExit(EXIT_FAILURE);
+                        }
+                    initEventProcessing = false;
+                    return;
+                    }
+                }
             // run a Lua script
             wxString luaScriptPath;
+            if (IsHeadless())
+                {
+                bool scriptSucceeded{ false };
+                if (cmdParser.Found(_DT(L"lua"), &luaScriptPath))
+                    {
+                    GetLuaRunner().RemoveInterfaceLibraries();
+                    scriptSucceeded = GetLuaRunner().RunLuaFile(luaScriptPath);
+                    }
+                else
+                    {
+                    wxMessageOutputStderr{}.Output(
+                        _(L"A Lua script (--lua), folder to watch (--watch), or port to serve "
+                      "(--serve) must be specified when running headless."));
+                    }
+                // close whatever projects the script left open, without prompting to save them
+                for (auto* doc : GetDocManager()->GetDocumentsVector())
+                    {
+                    doc->Modify(false);
+                    }
+                GetDocManager()->CloseDocuments(true);
+                loop->ScheduleExit(scriptSucceeded ? EXIT_SUCCESS : EXIT_FAILURE);
+                initEventProcessing = false;
+                return;
+                }
             if (cmdParser.Found(_DT(L"lua"), &luaScriptPath))
                 {
                 wxString luaScript, errorMessage;
@@ -409,6 +486,75 @@ void ReadabilityApp::OnEventLoopEnter(wxEventLoopBase* loop)
         }
     }
 
+//-------------------------------------------
+bool ReadabilityApp::IsHeadlessSwitch(const wxString& arg)
+    {
+    return (arg == _DT(L"--headless") || arg == _DT(L"-headless")
+#ifdef __WXMSW__
+            || arg.CmpNoCase(_DT(L"/headless")) == 0
+#endif
+    );
+    }
+
+//-------------------------------------------
+bool ReadabilityApp::Initialize(int& argc, wxChar** argv)
+    {
+    // The command line isn't fully parsed until the event loop starts,
+    // but whether to connect to the windowing system needs to be known before then.
+    for (int i = 1; i < argc; ++i)
+        {
+        if (IsHeadlessSwitch(argv[i]))
+            {
+            m_headless = true;
+            break;
+            }
+        }
+    if (!m_headless)
+        {
+        return BaseApp::Initialize(argc, argv);
+        }
+
+    // Running headless is meant for machines without a display (e.g., a server
+    // or a build agent), so skip the GUI toolkit's initialization and run like a
+    // console application. Nothing in this mode creates a window.
+#ifdef __WXMSW__
+    // this is built as a GUI program, so borrow the console that launched it (if any)
+    // for the messages written to stdout and stderr
+    if (::AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+        [[maybe_unused]]
+        FILE* consoleStream{ nullptr };
+        freopen_s(&consoleStream, "CONOUT$", "w", stdout);
+        freopen_s(&consoleStream, "CONOUT$", "w", stderr);
+        }
+#endif
+    return wxAppConsole::Initialize(argc, argv);
+    }
+
+//-------------------------------------------
+void ReadabilityApp::CleanUp()
+    {
+    if (IsHeadless())
+        {
+        wxAppConsole::CleanUp();
+        }
+    else
+        {
+        BaseApp::CleanUp();
+        }
+    }
+
+//-------------------------------------------
+bool ReadabilityApp::OnInitGui() { return IsHeadless() ? true : BaseApp::OnInitGui(); }
+
+//-------------------------------------------
+wxAppTraits* ReadabilityApp::CreateTraits()
+    {
+    // console traits provide a console event loop (which still handles timers,
+    // sockets, and file system watchers), rather than the toolkit's
+    return IsHeadless() ? wxAppConsole::CreateTraits() : BaseApp::CreateTraits();
+    }
+
 //-------------------------------------------
 bool ReadabilityApp::OnInit()
     {
@@ -447,7 +593,10 @@ bool ReadabilityApp::OnInit()
             }
         }
 #ifdef __WXMSW__
-    MSWEnableDarkMode();
+    if (!IsHeadless())
+        {
+        MSWEnableDarkMode();
+        }
 #endif
     GetAppOptions().LoadOptionsFile(AppSettingFolderPath + L"Settings.xml", true);
 
@@ -580,14 +729,17 @@ bool ReadabilityApp::OnInit()
                          std::make_pair(_(L"Seasons"), DONTTRANSLATE(L"seasons")),
                          std::make_pair(_(L"Meadow Sunset"), DONTTRANSLATE(L"meadowsunset")) };
 
-    // this needs to be called before prompting for the
-    // serial number because wxGetTextFromUser will need a parent
-    LoadInterface();
+    if (!IsHeadless())
+        {
+        // this needs to be called before prompting for the
+        // serial number because wxGetTextFromUser will need a parent
+        LoadInterface();
 
-    ShowSplashscreen();
+        ShowSplashscreen();
 
-    // now load any menus which are affected by licensing
-    LoadInterfaceLicensableFeatures();
+        // now load any menus which are affected by licensing
+        LoadInterfaceLicensableFeatures();
+        }
 
     m_dynamicIdMap = {
         /* This maps internal (dynamic) IDs to constants in "resources/scripting/rs-constants.lua".
@@ -781,36 +933,43 @@ bool ReadabilityApp::OnInit()
                           _DT(L"rsbp"), _DT(L"rsbp Doc"), _DT(L"View"),
                           wxCLASSINFO(BatchProjectDoc), wxCLASSINFO(BatchProjectView));
 
-    wxArrayString extensions;
-    extensions.Add(GetAppFileExtension());
-    extensions.Add(_DT(L"rsbp"));
-    GetMainFrame()->SetDefaultFileExtensions(extensions);
-
-    // printer options
-    GetMainFrame()->GetDocumentManager()->GetPageSetupDialogData().GetPrintData().SetPaperId(
-        static_cast<wxPaperSize>(GetAppOptions().GetPaperId()));
-    GetMainFrame()->GetDocumentManager()->GetPageSetupDialogData().GetPrintData().SetOrientation(
-        GetAppOptions().GetPaperOrientation());
-    GetMainFrame()->GetDocumentManager()->GetPageSetupDialogData().EnableMargins(false);
-
-    // get a random image for the About box
-    std::uniform_int_distribution<size_t> randNum(0, GetSplashscreenPaths().GetCount() - 1);
-    const size_t imageIndex = randNum(GetRandomNumberEngine());
-    if (imageIndex < GetSplashscreenPaths().GetCount())
-        {
-        wxString ext{ GetSplashscreenPaths()[imageIndex] };
-        auto scaledBmp =
-            GetScaledImage(GetSplashscreenPaths()[imageIndex],
-                           Image::GetImageFileTypeFromExtension(ext), wxSize{ 500, 400 });
-        // crop the bottom
-        GetMainFrameEx()->SetAboutDialogImage(
-            wxBitmap(wxImage(scaledBmp.ConvertToImage())
-                         .Resize(GetMainFrame()->FromDIP(wxSize{ 500, 200 }), wxPoint(0, 0))));
-        }
-
-    // set the help
-    GetMainFrame()->SetHelpDirectory(FindResourceDirectory(L"readability-studio-manual"));
-    wxLogMessage(L"Documentation Location: %s", GetMainFrame()->GetHelpDirectory());
+    // (there is no main window when running headless)
+    if (!IsHeadless())
+        {
+        wxArrayString extensions;
+        extensions.Add(GetAppFileExtension());
+        extensions.Add(_DT(L"rsbp"));
+        GetMainFrame()->SetDefaultFileExtensions(extensions);
+
+        // printer options
+        GetMainFrame()->GetDocumentManager()->GetPageSetupDialogData().GetPrintData().SetPaperId(
+            static_cast<wxPaperSize>(GetAppOptions().GetPaperId()));
+        GetMainFrame()
+            ->GetDocumentManager()
+            ->GetPageSetupDialogData()
+            .GetPrintData()
+            .SetOrientation(GetAppOptions().GetPaperOrientation());
+        GetMainFrame()->GetDocumentManager()->GetPageSetupDialogData().EnableMargins(false);
+
+        // get a random image for the About box
+        std::uniform_int_distribution<size_t> randNum(0, GetSplashscreenPaths().GetCount() - 1);
+        const size_t imageIndex = randNum(GetRandomNumberEngine());
+        if (imageIndex < GetSplashscreenPaths().GetCount())
+            {
+            wxString ext{ GetSplashscreenPaths()[imageIndex] };
+            auto scaledBmp =
+                GetScaledImage(GetSplashscreenPaths()[imageIndex],
+                               Image::GetImageFileTypeFromExtension(ext), wxSize{ 500, 400 });
+            // crop the bottom
+            GetMainFrameEx()->SetAboutDialogImage(wxBitmap(
+                wxImage(scaledBmp.ConvertToImage())
+                    .Resize(GetMainFrame()->FromDIP(wxSize{ 500, 200 }), wxPoint(0, 0))));
+            }
+
+        // set the help
+        GetMainFrame()->SetHelpDirectory(FindResourceDirectory(L"readability-studio-manual"));
+        wxLogMessage(L"Documentation Location: %s", GetMainFrame()->GetHelpDirectory());
+        }
 
     // load the full set of user settings
     GetAppOptions().LoadOptionsFile(AppSettingFolderPath + L"Settings.xml", false);
@@ -830,7 +989,10 @@ bool ReadabilityApp::OnInit()
     PskBundle.SetLanguage(readability::test_language::english_test);
     PskBundle.Lock();
     BaseProject::m_testBundles.insert(PskBundle);
-    dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(PskBundle.GetName().c_str());
+    if (!IsHeadless())
+        {
+        dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(PskBundle.GetName().c_str());
+        }
 
     // Kincaid's Navy Personnel tests
     TestBundle NavyBundle(ReadabilityMessages::GetKincaidNavyBundleName().wc_str());
@@ -843,7 +1005,10 @@ bool ReadabilityApp::OnInit()
     NavyBundle.SetLanguage(readability::test_language::english_test);
     NavyBundle.Lock();
     BaseProject::m_testBundles.insert(NavyBundle);
-    dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(NavyBundle.GetName().c_str());
+    if (!IsHeadless())
+        {
+        dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(NavyBundle.GetName().c_str());
+        }
 
     // Grundner's Consent Forms
     TestBundle ConsentFormsBundle(ReadabilityMessages::GetConsentFormsBundleName().wc_str());
@@ -875,7 +1040,10 @@ bool ReadabilityApp::OnInit()
     ConsentFormsBundle.SetLanguage(readability::test_language::english_test);
     ConsentFormsBundle.Lock();
     BaseProject::m_testBundles.insert(ConsentFormsBundle);
-    dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(ConsentFormsBundle.GetName().c_str());
+    if (!IsHeadless())
+        {
+        dynamic_cast<MainFrame*>(GetMainFrame())->AddTestBundleToMenus(ConsentFormsBundle.GetName().c_str());
+        }
     // clang-format on
 
     // See if ClearType is turned on. If not, then graphs will look awful, so ask user about turning
@@ -884,7 +1052,7 @@ bool ReadabilityApp::OnInit()
     int fontSmoothing{ 0 }, smoothingType{ 0 };
     ::SystemParametersInfo(SPI_GETFONTSMOOTHING, 0, &fontSmoothing, 0);
     ::SystemParametersInfo(SPI_GETFONTSMOOTHINGTYPE, 0, &smoothingType, 0);
-    if (fontSmoothing == 0 || smoothingType != FE_FONTSMOOTHINGCLEARTYPE)
+    if (!IsHeadless() && (fontSmoothing == 0 || smoothingType != FE_FONTSMOOTHINGCLEARTYPE))
         {
         std::vector<WarningMessage>::iterator warningIter =
             WarningManager::GetWarning(_DT(L"clear-type-turned-off"));
@@ -930,8 +1098,7 @@ bool ReadabilityApp::LoadWordLists(const wxString& AppSettingFolderPath)
     wxFile theFile;
     if (!theFile.Open(FindResourceFile(L"words.wad"), wxFile::read))
         {
-        wxMessageBox(_(L"Word & phrase file missing or corrupt. Please reinstall."), _(L"Error"),
-                     wxOK | wxICON_EXCLAMATION);
+        ReportStartupError(_(L"Word & phrase file missing or corrupt. Please reinstall."));
         return false;
         }
     auto wordyZipFileText = std::make_unique<char[]>(theFile.Length() + 1);
@@ -1341,6 +1508,15 @@ void ReadabilityApp::LoadInterface()
         GetDocManager()->FileHistoryAddFilesToMenu(&GetMainFrameEx()->m_fileOpenMenu);
         }
     FillPrintMenu(GetMainFrameEx()->m_printMenu, RibbonType::MainFrameRibbon);
+    GetMainFrameEx()->m_pipelineStatsMenu.AppendCheckItem(XRCID("ID_PIPELINE_STATS_COLLECT"),
+                                                          _(L"Collect Timings"));
+    GetMainFrameEx()->m_pipelineStatsMenu.Append(XRCID("ID_PIPELINE_STATS_EXPORT_JSON"),
+                                                 _(L"Export Timings (JSON)..."));
+    GetMainFrameEx()->m_pipelineStatsMenu.Append(XRCID("ID_PIPELINE_STATS_EXPORT_TRACE"),
+                                                 _(L"Export Timings (Chrome Trace)..."));
+    GetMainFrameEx()->m_pipelineStatsMenu.AppendSeparator();
+    GetMainFrameEx()->m_pipelineStatsMenu.Append(XRCID("ID_PIPELINE_STATS_CLEAR"),
+                                                 _(L"Clear Timings"));
     GetMainFrameEx()->AddExamplesToMenu(&GetMainFrameEx()->m_exampleMenu);
     MainFrame::FillMenuWithCustomTests(&GetMainFrameEx()->m_customTestsMenu, nullptr, false);
     MainFrame::FillMenuWithTestBundles(&GetMainFrameEx()->m_testsBundleMenu, nullptr, false);
@@ -1402,11 +1578,95 @@ void ReadabilityApp::LoadInterface()
     SetTopWindow(GetMainFrame());
     }
 
+//-----------------------------------
+void ReadabilityApp::ReportStartupError(const wxString& message) const
+    {
+    if (IsHeadless())
+        {
+        wxMessageOutputStderr{}.Output(message);
+        }
+    else
+        {
+        wxMessageBox(message, _(L"Error"), wxOK | wxICON_EXCLAMATION);
+        }
+    }
+
+//-----------------------------------
+bool ReadabilityApp::StartWatchFolderService(const wxCmdLineParser& cmdParser)
+    {
+    wxString folder, storePath, bundleName;
+    long workerCount{ 0 };
+    cmdParser.Found(_DT(L"watch"), &folder);
+    if (!cmdParser.Found(_DT(L"results"), &storePath))
+        {
+        storePath = wxFileName{ folder, _DT(L"readability-results.jsonl") }.GetFullPath();
+        }
+    if (cmdParser.Found(_DT(L"workers"), &workerCount) && workerCount < 0)
+        {
+        workerCount = 0;
+        }
+
+    auto scorer = std::make_unique<DocumentScorer>();
+    if (cmdParser.Found(_DT(L"bundle"), &bundleName) && !scorer->UseTestBundle(bundleName))
+        {
+        ReportStartupError(wxString::Format(_(L"Test bundle not found: %s"), bundleName));
+        return false;
+        }
+    auto service = std::make_unique<WatchFolderService>(
+        folder, storePath, static_cast<size_t>(workerCount), std::move(scorer),
+        wxString{ GetAppOptions().ALL_DOCUMENTS_WILDCARD.data() });
+    wxString errorMessage;
+    if (!service->Start(errorMessage))
+        {
+        ReportStartupError(errorMessage);
+        return false;
+        }
+    m_watchFolderService = std::move(service);
+    return true;
+    }
+
+//-----------------------------------
+bool ReadabilityApp::StartScoringServer(const wxCmdLineParser& cmdParser)
+    {
+    long port{ 0 }, workerCount{ 0 };
+    wxString bundleName;
+    cmdParser.Found(_DT(L"serve"), &port);
+    if (port < 0 || port > 65'535)
+        {
+        ReportStartupError(wxString::Format(_(L"Invalid port: %ld"), port));
+        return false;
+        }
+    if (cmdParser.Found(_DT(L"workers"), &workerCount) && workerCount < 0)
+        {
+        workerCount = 0;
+        }
+
+    auto scorer = std::make_unique<DocumentScorer>();
+    if (cmdParser.Found(_DT(L"bundle"), &bundleName) && !scorer->UseTestBundle(bundleName))
+        {
+        ReportStartupError(wxString::Format(_(L"Test bundle not found: %s"), bundleName));
+        return false;
+        }
+    auto server = std::make_unique<ScoringServer>(
+        static_cast<unsigned short>(port), static_cast<size_t>(workerCount), std::move(scorer));
+    wxString errorMessage;
+    if (!server->Start(errorMessage))
+        {
+        ReportStartupError(errorMessage);
+        return false;
+        }
+    m_scoringServer = std::move(server);
+    return true;
+    }
+
 //-----------------------------------
 int ReadabilityApp::OnExit()
     {
     wxLogDebug(__func__);
     m_webHarvester.CancelPending();
+    // wait for the documents being scored
+    m_scoringServer.reset();
+    m_watchFolderService.reset();
     GetAppOptions().SaveOptionsFile();
 
     return BaseApp::OnExit();
@@ -2776,6 +3036,9 @@ wxRibbonBar* ReadabilityApp::CreateRibbon(wxWindow* frame, const wxDocument* doc
             toolButtonBar->AddButton(XRCID("ID_SCRIPT_WINDOW"), _(L"Lua Script"),
                                      ReadRibbonSvgIcon(L"ribbon/lua.svg"),
                                      _(L"Edit and run scripts to automate tasks."));
+            toolButtonBar->AddDropdownButton(
+                XRCID("ID_PIPELINE_STATS"), _(L"Timings"), ReadRibbonSvgIcon(L"ribbon/clock.svg"),
+                _(L"Collect and export how long each stage of analyzing documents takes."));
 #ifndef NDEBUG
     #ifdef ENABLE_PROFILING
             toolButtonBar->AddButton(XRCID("ID_VIEW_PROFILE_REPORT"), _(L"Profile Report"),
@@ -3617,6 +3880,12 @@ MainFrame::MainFrame(wxDocManager* manager, wxFrame* frame,
 
     Bind(wxEVT_RIBBONBUTTONBAR_CLICKED, &MainFrame::OnViewProfileReport, this,
          XRCID("ID_VIEW_PROFILE_REPORT"));
+    Bind(wxEVT_RIBBONBUTTONBAR_DROPDOWN_CLICKED, &MainFrame::OnPipelineStatsDropdown, this,
+         XRCID("ID_PIPELINE_STATS"));
+    Bind(wxEVT_MENU, &MainFrame::OnPipelineStats, this, XRCID("ID_PIPELINE_STATS_COLLECT"));
+    Bind(wxEVT_MENU, &MainFrame::OnPipelineStats, this, XRCID("ID_PIPELINE_STATS_EXPORT_JSON"));
+    Bind(wxEVT_MENU, &MainFrame::OnPipelineStats, this, XRCID("ID_PIPELINE_STATS_EXPORT_TRACE"));
+    Bind(wxEVT_MENU, &MainFrame::OnPipelineStats, this, XRCID("ID_PIPELINE_STATS_CLEAR"));
     Bind(
         wxEVT_MENU,
         [this]([[maybe_unused]] wxCommandEvent&)
@@ -4033,6 +4302,48 @@ void MainFrame::OnBlankGraphDropdown(wxRibbonButtonBarEvent& event)
     event.PopupMenu(&m_blankGraphMenu);
     }
 
+//---------------------------------------------------
+void MainFrame::OnPipelineStatsDropdown(wxRibbonButtonBarEvent& event)
+    {
+    m_pipelineStatsMenu.Check(XRCID("ID_PIPELINE_STATS_COLLECT"), pipeline_stats::is_enabled());
+    event.PopupMenu(&m_pipelineStatsMenu);
+    }
+
+//-------------------------------------------------------
+void MainFrame::OnPipelineStats(wxCommandEvent& event)
+    {
+    if (event.GetId() == XRCID("ID_PIPELINE_STATS_COLLECT"))
+        {
+        pipeline_stats::set_enabled(!pipeline_stats::is_enabled());
+        wxLogMessage(pipeline_stats::is_enabled() ? _(L"Pipeline timings enabled.") :
+                                                    _(L"Pipeline timings disabled."));
+        return;
+        }
+    if (event.GetId() == XRCID("ID_PIPELINE_STATS_CLEAR"))
+        {
+        pipeline_stats::reset();
+        return;
+        }
+
+    const bool exportTrace = (event.GetId() == XRCID("ID_PIPELINE_STATS_EXPORT_TRACE"));
+    wxFileDialog dialog(this, _(L"Export Timings"), wxString{},
+                        exportTrace ? _DT(L"timings-trace.json") : _DT(L"timings.json"),
+                        _(L"JSON Files (*.json)|*.json"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dialog.ShowModal() != wxID_OK)
+        {
+        return;
+        }
+
+    const std::string json =
+        exportTrace ? pipeline_stats::to_chrome_trace() : pipeline_stats::to_json();
+    wxFile outputFile(dialog.GetPath(), wxFile::write);
+    if (!outputFile.IsOpened() || outputFile.Write(json.data(), json.length()) != json.length())
+        {
+        wxMessageBox(wxString::Format(_(L"Unable to write to \"%s\"."), dialog.GetPath()),
+                     _(L"Export Error"), wxOK | wxICON_EXCLAMATION);
+        }
+    }
+
 //---------------------------------------------------
 void MainFrame::OnEditEnglishDictionary([[maybe_unused]] wxCommandEvent& event)
     {
@@ -5319,39 +5630,40 @@ void MainFrame::OnFindDuplicateFiles([[maybe_unused]] wxRibbonButtonBarEvent& ev
         files = FilterFiles(files, ExtractExtensionsFromFileFilter(dirDlg.GetSelectedFileFilter()));
         }
 
-    // get the checksums
-    multi_value_aggregate_map<std::uint32_t, wxString> filesMap;
+    // find the identical files (files are grouped by size, then by sampled content,
+    // and then by full content, so that most files never have to be read)
+    std::vector<std::vector<wxString>> duplicateGroups;
         {
         wxProgressDialog progressDlg(_(L"Duplicate Files"), _(L"Searching for duplicate files..."),
-                                     files.size(), wxGetApp().GetParentingWindow(),
+                                     100, wxGetApp().GetParentingWindow(),
                                      wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME |
-                                         wxPD_ESTIMATED_TIME | wxPD_REMAINING_TIME |
                                          wxPD_CAN_ABORT | wxPD_APP_MODAL);
         progressDlg.Centre();
 
-        int counter{ 1 };
-        for (const auto& curFile : files)
+        DuplicateFileFinder duplicateFinder;
+        // the user may delete duplicates from the results, so make sure that they really are
+        duplicateFinder.VerifyContent(true);
+        duplicateFinder.SetProgressCallback(
+            [&progressDlg](const wxString& message, const size_t processed, const size_t total)
             {
-            progressDlg.SetTitle(wxString::Format(
-                _(L"Processing %s of %s files..."),
-                wxNumberFormatter::ToString(counter, 0,
-                                            wxNumberFormatter::Style::Style_NoTrailingZeroes |
-                                                wxNumberFormatter::Style::Style_WithThousandsSep),
-                wxNumberFormatter::ToString(files.size(), 0,
-                                            wxNumberFormatter::Style::Style_NoTrailingZeroes |
-                                                wxNumberFormatter::Style::Style_WithThousandsSep)));
-            if (!progressDlg.Update(counter, wxFileName(curFile).GetFullName()))
-                {
-                return;
-                }
-            MemoryMappedFile memFile(curFile, true, true);
-            if (memFile.IsOk())
-                {
-                const std::uint32_t crc =
-                    CRC::Calculate(memFile.GetStream(), memFile.GetMapSize(), CRC::CRC_32());
-                filesMap.insert(crc, curFile);
-                }
-            ++counter;
+                constexpr int numberStyle = wxNumberFormatter::Style::Style_NoTrailingZeroes |
+                                            wxNumberFormatter::Style::Style_WithThousandsSep;
+                progressDlg.SetTitle(
+                    wxString::Format(_(L"Processing %s of %s files..."),
+                                     wxNumberFormatter::ToString(processed, 0, numberStyle),
+                                     wxNumberFormatter::ToString(total, 0, numberStyle)));
+                const int range = static_cast<int>(std::max<size_t>(total, 1));
+                if (progressDlg.GetRange() != range)
+                    {
+                    progressDlg.SetRange(range);
+                    }
+                return progressDlg.Update(static_cast<int>(std::min<size_t>(processed, range)),
+                                          message);
+            });
+        duplicateGroups = duplicateFinder.FindDuplicates(files);
+        if (duplicateFinder.WasCancelled())
+            {
+            return;
             }
         }
 
@@ -5368,25 +5680,22 @@ void MainFrame::OnFindDuplicateFiles([[maybe_unused]] wxRibbonButtonBarEvent& ev
 #endif
         unsigned long groupId{ 1 };
         bool alternatingColor{ true };
-        for (const auto& mapVal : filesMap.get_data())
+        for (const auto& duplicateGroup : duplicateGroups)
             {
-            if (mapVal.second.second > 1)
+            for (const auto& curFile : duplicateGroup)
                 {
-                for (const auto& curFile : mapVal.second.first)
-                    {
-                    const wxFileName fn(curFile);
-                    wxItemAttr attribs;
-                    attribs.SetBackgroundColour(
-                        (alternatingColor ? (*wxGREEN).ChangeLightness(160) : *wxWHITE));
-                    fileListDlg.GetListCtrlData()->SetRowAttributes(rowCount, attribs);
-                    fileListDlg.GetListCtrlData()->SetItemText(rowCount, 0, fn.GetFullName());
-                    fileListDlg.GetListCtrlData()->SetItemText(rowCount, 1, fn.GetPath());
-                    fileListDlg.GetListCtrlData()->SetItemValue(rowCount++, 2, groupId);
-                    }
-                // flip it for next group of duplicates
-                alternatingColor = !alternatingColor;
-                ++groupId;
+                const wxFileName fn(curFile);
+                wxItemAttr attribs;
+                attribs.SetBackgroundColour(
+                    (alternatingColor ? (*wxGREEN).ChangeLightness(160) : *wxWHITE));
+                fileListDlg.GetListCtrlData()->SetRowAttributes(rowCount, attribs);
+                fileListDlg.GetListCtrlData()->SetItemText(rowCount, 0, fn.GetFullName());
+                fileListDlg.GetListCtrlData()->SetItemText(rowCount, 1, fn.GetPath());
+                fileListDlg.GetListCtrlData()->SetItemValue(rowCount++, 2, groupId);
                 }
+            // flip it for next group of duplicates
+            alternatingColor = !alternatingColor;
+            ++groupId;
             }
         fileListDlg.GetListCtrl()->SetVirtualDataSize(rowCount);
         fileListDlg.GetListCtrl()->DistributeColumns(-1);
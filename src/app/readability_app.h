@@ -31,6 +31,10 @@
 #include "../Wisteria-Dataviz/src/wxStartPage/startpage.h"
 #include "../app/readability_app_options.h"
 #include "../lua-scripting/lua_interface.h"
+#include "../projects/document_scorer.h"
+#include "../projects/scoring_server.h"
+#include "../projects/source_file_watcher.h"
+#include "../projects/watch_folder_service.h"
 #include "../readability/custom_readability_test.h"
 #include "../readability/readability_project_test.h"
 #include "../test-helpers/tests_functional.h"
@@ -42,6 +46,7 @@
 #include "version.h"
 #include <algorithm>
 #include <map>
+#include <wx/cmdline.h>
 #include <wx/evtloop.h>
 #include <wx/file.h>
 #include <wx/imaglist.h>
@@ -106,6 +111,7 @@ class MainFrame final : public Wisteria::UI::BaseMainFrame
     void OnTestsOverview([[maybe_unused]] wxRibbonButtonBarEvent& event);
     void OnViewLogReport([[maybe_unused]] wxRibbonButtonBarEvent& event);
     void OnViewProfileReport([[maybe_unused]] wxRibbonButtonBarEvent& event);
+    void OnPipelineStats(wxCommandEvent& event);
     void OnClose(wxCloseEvent& event);
     void OnToolsOptions([[maybe_unused]] wxRibbonButtonBarEvent& event);
     void OnEditWordList([[maybe_unused]] wxCommandEvent& event);
@@ -132,6 +138,7 @@ class MainFrame final : public Wisteria::UI::BaseMainFrame
     void OnWordList(wxRibbonButtonBarEvent& event);
     void OnWordListDropdown(wxRibbonButtonBarEvent& event);
     void OnBlankGraphDropdown(wxRibbonButtonBarEvent& event);
+    void OnPipelineStatsDropdown(wxRibbonButtonBarEvent& event);
     void OnNewDropdown(wxRibbonButtonBarEvent& event);
     void OnOpenDropdown(wxRibbonButtonBarEvent& event);
     void OnPrintDropdown(wxRibbonButtonBarEvent& event);
@@ -256,6 +263,7 @@ class MainFrame final : public Wisteria::UI::BaseMainFrame
     wxMenu m_customTestsMenu;
     wxMenu m_wordListMenu;
     wxMenu m_blankGraphMenu;
+    wxMenu m_pipelineStatsMenu;
     wxMenu* m_customTestsRegularMenu{ nullptr };
     wxMenu m_testsBundleMenu;
     wxMenu* m_testsBundleRegularMenu{ nullptr };
@@ -295,6 +303,14 @@ class ReadabilityApp final : public Wisteria::UI::BaseApp
     bool OnInit() final;
     int OnExit() final;
 
+    /// @brief Initializes the application, without connecting to the windowing system
+    ///     if running headless.
+    bool Initialize(int& argc, wxChar** argv) final;
+    /// @private
+    void CleanUp() final;
+    /// @private
+    bool OnInitGui() final;
+
     void LoadInterface();
     void LoadInterfaceLicensableFeatures();
 
@@ -349,12 +365,51 @@ class ReadabilityApp final : public Wisteria::UI::BaseApp
         return m_LuaRunner;
         }
 
+    /** @returns @c true if the program was launched with @c --headless
+            (along with @c --lua) to run a script unattended, or (along with @c --watch
+            or @c --serve) to run as a service that scores documents.
+        @details In this mode, the GUI toolkit is never initialized (the program runs
+            like a console application, so no display is needed). There is no main window,
+            projects opened by scripts are window-less (only their results are calculated),
+            prompts from scripts and projects are written to the log (and the console),
+            and the program exits when the script finishes
+            (services run until the program is terminated).\n
+            On Windows, @c /headless is also accepted.*/
+    [[nodiscard]]
+    bool IsHeadless() const noexcept
+        {
+        return m_headless;
+        }
+
     [[nodiscard]]
     WebHarvester& GetWebHarvester() noexcept
         {
         return m_webHarvester;
         }
 
+    /// @returns The service that notifies real-time projects when their
+    ///     source documents change.
+    [[nodiscard]]
+    SourceFileWatcher& GetSourceFileWatcher() noexcept
+        {
+        return m_sourceFileWatcher;
+        }
+
+    /// @returns The service scoring the documents in a watched folder
+    ///     (if launched with @c --watch), or null.
+    [[nodiscard]]
+    WatchFolderService* GetWatchFolderService() noexcept
+        {
+        return m_watchFolderService.get();
+        }
+
+    /// @returns The local scoring server (if launched with @c --serve), or null.
+    [[nodiscard]]
+    ScoringServer* GetScoringServer() noexcept
+        {
+        return m_scoringServer.get();
+        }
+
     enum class RibbonType
         {
         MainFrameRibbon,
@@ -473,15 +528,32 @@ class ReadabilityApp final : public Wisteria::UI::BaseApp
 
     std::unique_ptr<ReadabilityAppOptions> m_appOptions{ nullptr };
     bool LoadWordLists(const wxString& AppSettingFolderPath);
+    /// @brief Starts scoring the documents in a folder, from the command line options.
+    /// @returns @c false (after reporting the reason) if the service could not start.
+    bool StartWatchFolderService(const wxCmdLineParser& cmdParser);
+    /// @brief Starts the (local) scoring server, from the command line options.
+    /// @returns @c false (after reporting the reason) if the server could not start.
+    bool StartScoringServer(const wxCmdLineParser& cmdParser);
+    /// @brief Shows (or, if headless, prints) why the program or a service could not start.
+    void ReportStartupError(const wxString& message) const;
+    /// @returns Console traits (and thus a console event loop) if running headless.
+    wxAppTraits* CreateTraits() final;
+    /// @returns @c true if a command line argument is the switch to run headless.
+    [[nodiscard]]
+    static bool IsHeadlessSwitch(const wxString& arg);
     wxArrayString m_lastSelectedWebPages;
     wxString m_lastSelectedDocFilter;
     LuaInterpreter m_LuaRunner;
+    bool m_headless{ false };
     wxString m_CustomEnglishDictionaryPath;
     wxString m_CustomSpanishDictionaryPath;
     wxString m_CustomGermanDictionaryPath;
     double m_dpiScaleFactor{ 1.0 };
     wxArrayString m_splashscreenImagePaths;
     WebHarvester m_webHarvester;
+    SourceFileWatcher m_sourceFileWatcher;
+    std::unique_ptr<WatchFolderService> m_watchFolderService;
+    std::unique_ptr<ScoringServer> m_scoringServer;
     std::mt19937_64 m_mersenneTwister;
 
     std::map<wxString, wxString> m_shapeMap;
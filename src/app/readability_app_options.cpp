@@ -24,9 +24,51 @@ using namespace Wisteria::UI;
 
 wxDECLARE_APP(ReadabilityApp);
 
+namespace
+    {
+    // When running headless, the GUI toolkit isn't initialized (and there may not be a
+    // display), so the system's colors, fonts, and metrics can't be queried.
+    // Fixed defaults are used instead, which only affect output such as exported graphs.
+
+    //------------------------------------------------
+    wxColour GetSystemColour(const wxSystemColour index)
+        {
+        if (!wxGetApp().IsHeadless())
+            {
+            return wxSystemSettings::GetColour(index);
+            }
+        switch (index)
+            {
+        case wxSYS_COLOUR_WINDOW:
+            return *wxWHITE;
+        case wxSYS_COLOUR_BTNFACE:
+            return wxColour(240, 240, 240);
+        default:
+            return *wxBLACK;
+            }
+        }
+
+    //------------------------------------------------
+    wxFont GetDefaultGuiFont()
+        {
+        return wxGetApp().IsHeadless() ? wxFont(wxFontInfo(9).Family(wxFONTFAMILY_SWISS)) :
+                                         wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT);
+        }
+
+    //------------------------------------------------
+    int GetSystemMetric(const wxSystemMetric index)
+        {
+        if (!wxGetApp().IsHeadless())
+            {
+            return wxSystemSettings::GetMetric(index);
+            }
+        return (index == wxSYS_SCREEN_X) ? 1920 : (index == wxSYS_SCREEN_Y) ? 1080 : -1;
+        }
+    } // namespace
+
 ReadabilityAppOptions::ReadabilityAppOptions()
     : m_textHighlight(TextHighlight::HighlightBackground),
-      m_fontColor(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT))
+      m_fontColor(GetSystemColour(wxSYS_COLOUR_WINDOWTEXT))
     {
     SetFonts();
     SetColorsFromSystem();
@@ -176,8 +218,12 @@ ReadabilityAppOptions::ReadabilityAppOptions()
 //------------------------------------------------
 void ReadabilityAppOptions::SetFonts()
     {
-    auto systemFont{ wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT) };
-    systemFont.SetFaceName(Wisteria::GraphItems::Label::GetFirstAvailableWordProcessorFont());
+    auto systemFont{ GetDefaultGuiFont() };
+    // (looking through the system's fonts needs the GUI toolkit)
+    if (!wxGetApp().IsHeadless())
+        {
+        systemFont.SetFaceName(Wisteria::GraphItems::Label::GetFirstAvailableWordProcessorFont());
+        }
     m_editorFont = systemFont.Larger().Larger();
     m_xAxisFont = systemFont;
     m_yAxisFont = systemFont;
@@ -187,22 +233,25 @@ void ReadabilityAppOptions::SetFonts()
     m_rightTitleFont = systemFont;
     m_textViewFont = systemFont.Larger().Larger();
     // fix font issues in case the system is using a hidden font for its default (happens on macOS)
-    Wisteria::GraphItems::Label::FixFont(m_editorFont);
-    Wisteria::GraphItems::Label::FixFont(m_xAxisFont);
-    Wisteria::GraphItems::Label::FixFont(m_yAxisFont);
-    Wisteria::GraphItems::Label::FixFont(m_topTitleFont);
-    Wisteria::GraphItems::Label::FixFont(m_bottomTitleFont);
-    Wisteria::GraphItems::Label::FixFont(m_leftTitleFont);
-    Wisteria::GraphItems::Label::FixFont(m_rightTitleFont);
-    Wisteria::GraphItems::Label::FixFont(m_textViewFont);
+    if (!wxGetApp().IsHeadless())
+        {
+        Wisteria::GraphItems::Label::FixFont(m_editorFont);
+        Wisteria::GraphItems::Label::FixFont(m_xAxisFont);
+        Wisteria::GraphItems::Label::FixFont(m_yAxisFont);
+        Wisteria::GraphItems::Label::FixFont(m_topTitleFont);
+        Wisteria::GraphItems::Label::FixFont(m_bottomTitleFont);
+        Wisteria::GraphItems::Label::FixFont(m_leftTitleFont);
+        Wisteria::GraphItems::Label::FixFont(m_rightTitleFont);
+        Wisteria::GraphItems::Label::FixFont(m_textViewFont);
+        }
     }
 
 //------------------------------------------------
 void ReadabilityAppOptions::SetColorsFromSystem()
     {
     // Ribbon colors
-    m_ribbonActiveTabColor = wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE);
-    m_ribbonInactiveTabColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW);
+    m_ribbonActiveTabColor = GetSystemColour(wxSYS_COLOUR_BTNFACE);
+    m_ribbonInactiveTabColor = GetSystemColour(wxSYS_COLOUR_WINDOW);
     // if active and inactive colors are close, then change the inactive color slightly
     if (std::abs(m_ribbonActiveTabColor.GetLuminance() - m_ribbonInactiveTabColor.GetLuminance()) <
         .05)
@@ -219,12 +268,12 @@ void ReadabilityAppOptions::SetColorsFromSystem()
         }
     m_ribbonHoverColor = wxColour(253, 211, 155); // light orange color
     m_ribbonHoverFontColor = *wxBLACK;
-    m_ribbonActiveFontColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
-    m_ribbonInactiveFontColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
+    m_ribbonActiveFontColor = GetSystemColour(wxSYS_COLOUR_WINDOWTEXT);
+    m_ribbonInactiveFontColor = GetSystemColour(wxSYS_COLOUR_WINDOWTEXT);
 
     // Sidebar colors
     // if ugly Windows default gray, then override the system with prettier colors
-    if (wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE) == wxColour(240, 240, 240))
+    if (GetSystemColour(wxSYS_COLOUR_BTNFACE) == wxColour(240, 240, 240))
         {
         m_sideBarBackgroundColor = wxColour(200, 211, 231); // Serenity
         m_sideBarParentColor = wxColour(180, 189, 207);     // slightly darker
@@ -238,7 +287,7 @@ void ReadabilityAppOptions::SetColorsFromSystem()
     m_sideBarActiveFontColor = *wxBLACK;
     m_sideBarHoverColor = m_ribbonHoverColor;
     m_sideBarHoverFontColor = *wxBLACK;
-    m_sideBarFontColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
+    m_sideBarFontColor = GetSystemColour(wxSYS_COLOUR_WINDOWTEXT);
     }
 
 //------------------------------------------------
@@ -267,7 +316,7 @@ void ReadabilityAppOptions::ResetSettings()
     // theme settings
     SetColorsFromSystem();
 
-    m_editorFontColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
+    m_editorFontColor = GetSystemColour(wxSYS_COLOUR_WINDOWTEXT);
     m_editorIndent = true;
     m_editorSpaceAfterNewlines = false;
     m_editorTextAlignment = wxTextAttrAlignment::wxTEXT_ALIGNMENT_JUSTIFIED;
@@ -298,7 +347,7 @@ void ReadabilityAppOptions::ResetSettings()
     m_excludedTextHighlightColor = wxColour(175, 175, 175);
     m_duplicateWordHighlightColor = wxColour(255, 128, 128);
     m_wordyPhraseHighlightColor = wxColour(0, 255, 255);
-    m_fontColor = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
+    m_fontColor = GetSystemColour(wxSYS_COLOUR_WINDOWTEXT);
     m_textSource = TextSource::FromFile;
     m_batchGroupDefault = 2;
     m_longSentenceMethod = LongSentence::LongerThanSpecifiedLength;
@@ -340,6 +389,7 @@ void ReadabilityAppOptions::ResetSettings()
         ReadabilityMessages::ReadingAgeDisplay::ReadingAgeAsARange);
     // document linking information
     m_documentStorageMethod = TextStorage::NoEmbedText;
+    m_projectCompressionLevel = 9;
     // internet
     m_userAgent = _DT(L"Mozilla/5.0 (") + wxGetOsDescription() + _DT(L") WebKit/12.0 WebLion");
     wxGetApp().GetWebHarvester().SetUserAgent(m_userAgent);
@@ -405,6 +455,7 @@ void ReadabilityAppOptions::ResetSettings()
     GetWordsBreakdownInfo().EnableAll();
     GetSentencesBreakdownInfo().EnableAll();
     m_minDocWordCountForBatch = 50;
+    m_nearDuplicateHandling = NearDuplicateHandling::Report;
     m_randomSampleSizeForBatch = 15;
     m_filePathTruncationMode =
         ListCtrlEx::ColumnInfo::ColumnFilePathTruncationMode::OnlyShowFileNames;
@@ -528,8 +579,8 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
 
     ResetSettings();
 
-    m_appWindowWidth = wxSystemSettings::GetMetric(wxSYS_SCREEN_X) - 100;
-    m_appWindowHeight = wxSystemSettings::GetMetric(wxSYS_SCREEN_Y) - 100;
+    m_appWindowWidth = GetSystemMetric(wxSYS_SCREEN_X) - 100;
+    m_appWindowHeight = GetSystemMetric(wxSYS_SCREEN_Y) - 100;
 
     lily_of_the_valley::html_extract_text filter_html;
 
@@ -882,7 +933,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                 {
                 int pointSize = fontNode->ToElement()->IntAttribute(
                     XmlFormat::GetFontPointSize().mb_str(),
-                    wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                    GetDefaultGuiFont().GetPointSize());
                 int style = fontNode->ToElement()->IntAttribute(XmlFormat::GetFontStyle().mb_str(),
                                                                 wxFONTSTYLE_NORMAL);
                 int weight = fontNode->ToElement()->IntAttribute(
@@ -893,7 +944,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                 m_editorFont.SetPointSize(
                     (pointSize > 0) ?
                         pointSize :
-                        wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                        GetDefaultGuiFont().GetPointSize());
                 // get the font style
                 m_editorFont.SetStyle(static_cast<wxFontStyle>(style));
                 // get the font weight
@@ -1159,6 +1210,13 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                     m_documentStorageMethod = TextStorage::NoEmbedText;
                     }
                 }
+            auto compressionLevelNode =
+                projectSettings->FirstChildElement(XML_PROJECT_COMPRESSION_LEVEL.data());
+            if (compressionLevelNode)
+                {
+                SetProjectCompressionLevel(compressionLevelNode->ToElement()->IntAttribute(
+                    XML_VALUE.data(), GetProjectCompressionLevel()));
+                }
             auto projectLang = projectSettings->FirstChildElement(XML_PROJECT_LANGUAGE.data());
             if (projectLang)
                 {
@@ -1204,6 +1262,20 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                     }
                 SetMinDocWordCountForBatch(static_cast<size_t>(value));
                 }
+            auto nearDuplicateHandlingNode =
+                projectSettings->FirstChildElement(XML_NEAR_DUPLICATE_HANDLING.data());
+            if (nearDuplicateHandlingNode)
+                {
+                const int value = nearDuplicateHandlingNode->ToElement()->IntAttribute(
+                    XML_VALUE.data(), static_cast<int>(GetNearDuplicateHandling()));
+                // verify that this is a sensical value
+                if (value >= 0 &&
+                    value < static_cast<decltype(value)>(
+                                NearDuplicateHandling::NEAR_DUPLICATE_HANDLING_COUNT))
+                    {
+                    SetNearDuplicateHandling(static_cast<NearDuplicateHandling>(value));
+                    }
+                }
             auto filePathTruncModeNode =
                 projectSettings->FirstChildElement(XML_FILE_PATH_TRUNC_MODE.data());
             if (filePathTruncModeNode)
@@ -1640,8 +1712,12 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                         statNode = statNode->NextSiblingElement(XML_BUNDLE_STATISTIC.data());
                         }
                     BaseProject::m_testBundles.insert(bundle);
-                    dynamic_cast<MainFrame*>(wxGetApp().GetMainFrame())
-                        ->AddTestBundleToMenus(bundleName);
+                    // (there are no menus when running headless)
+                    if (!wxGetApp().IsHeadless())
+                        {
+                        dynamic_cast<MainFrame*>(wxGetApp().GetMainFrame())
+                            ->AddTestBundleToMenus(bundleName);
+                        }
 
                     testBundleNode = testBundleNode->NextSiblingElement(XML_TEST_BUNDLE.data());
                     }
@@ -2513,7 +2589,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2523,7 +2599,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_xAxisFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_xAxisFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -2568,7 +2644,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2578,7 +2654,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_yAxisFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_yAxisFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -2630,7 +2706,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2640,7 +2716,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_topTitleFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_topTitleFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -2688,7 +2764,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2698,7 +2774,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_bottomTitleFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_bottomTitleFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -2745,7 +2821,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2755,7 +2831,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_leftTitleFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_leftTitleFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -2803,7 +2879,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             {
                             int pointSize = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontPointSize().mb_str(),
-                                wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                                GetDefaultGuiFont().GetPointSize());
                             int style = fontNode->ToElement()->IntAttribute(
                                 XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                             int weight = fontNode->ToElement()->IntAttribute(
@@ -2813,7 +2889,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                             // get the font point size
                             m_rightTitleFont.SetPointSize(
                                 (pointSize > 0) ? pointSize :
-                                                  wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT)
+                                                  GetDefaultGuiFont()
                                                       .GetPointSize());
                             // get the font style
                             m_rightTitleFont.SetStyle(static_cast<wxFontStyle>(style));
@@ -3379,7 +3455,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                     {
                     int pointSize = fontNode->ToElement()->IntAttribute(
                         XmlFormat::GetFontPointSize().mb_str(),
-                        wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                        GetDefaultGuiFont().GetPointSize());
                     int style = fontNode->ToElement()->IntAttribute(
                         XmlFormat::GetFontStyle().mb_str(), wxFONTSTYLE_NORMAL);
                     int weight = fontNode->ToElement()->IntAttribute(
@@ -3390,7 +3466,7 @@ bool ReadabilityAppOptions::LoadOptionsFile(const wxString& optionsFile,
                     m_textViewFont.SetPointSize(
                         (pointSize > 0) ?
                             pointSize :
-                            wxSystemSettings::GetFont(wxSYS_DEFAULT_GUI_FONT).GetPointSize());
+                            GetDefaultGuiFont().GetPointSize());
                     // get the font style
                     m_textViewFont.SetStyle(static_cast<wxFontStyle>(style));
                     // get the font weight
@@ -3713,6 +3789,10 @@ bool ReadabilityAppOptions::SaveOptionsFile(const wxString& optionsFile /*= wxSt
     docStorageMethod->SetAttribute(XML_METHOD.data(), static_cast<int>(m_documentStorageMethod));
     projectSettings->InsertEndChild(docStorageMethod);
 
+    auto compressionLevel = doc.NewElement(XML_PROJECT_COMPRESSION_LEVEL.data());
+    compressionLevel->SetAttribute(XML_VALUE.data(), GetProjectCompressionLevel());
+    projectSettings->InsertEndChild(compressionLevel);
+
     // Project language
     auto projectLang = doc.NewElement(XML_PROJECT_LANGUAGE.data());
     projectLang->SetAttribute(XML_VALUE.data(), static_cast<int>(GetProjectLanguage()));
@@ -3723,6 +3803,12 @@ bool ReadabilityAppOptions::SaveOptionsFile(const wxString& optionsFile /*= wxSt
     minDocSize->SetAttribute(XML_VALUE.data(), static_cast<int>(GetMinDocWordCountForBatch()));
     projectSettings->InsertEndChild(minDocSize);
 
+    // how near-duplicate documents are handled in batch projects
+    auto nearDuplicateHandling = doc.NewElement(XML_NEAR_DUPLICATE_HANDLING.data());
+    nearDuplicateHandling->SetAttribute(XML_VALUE.data(),
+                                        static_cast<int>(GetNearDuplicateHandling()));
+    projectSettings->InsertEndChild(nearDuplicateHandling);
+
     // how file paths are shown in batch projects
     auto filePathTruncMode = doc.NewElement(XML_FILE_PATH_TRUNC_MODE.data());
     filePathTruncMode->SetAttribute(XML_VALUE.data(),
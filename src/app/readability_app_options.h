@@ -30,6 +30,7 @@
 #include "../results-format/readability_messages.h"
 #include "../tinyxml2/tinyxml2.h"
 #include "optionenums.h"
+#include <algorithm>
 #include <wx/colourdata.h>
 
 /// @brief Class for managing what is included in the statistics section.
@@ -1284,6 +1285,18 @@ class ReadabilityAppOptions
         m_documentStorageMethod = method;
         }
 
+    // compression level (0-9) of embedded text when saving projects
+    [[nodiscard]]
+    int GetProjectCompressionLevel() const noexcept
+        {
+        return m_projectCompressionLevel;
+        }
+
+    void SetProjectCompressionLevel(const int level) noexcept
+        {
+        m_projectCompressionLevel = std::clamp(level, 0, 9);
+        }
+
     // how documents are grouped
     [[nodiscard]]
     int GetBatchGroupMethod() const noexcept
@@ -2229,6 +2242,19 @@ class ReadabilityAppOptions
         return m_minDocWordCountForBatch;
         }
 
+    /// @brief Sets how batch projects handle documents that are nearly identical
+    ///     to another document in the project.
+    void SetNearDuplicateHandling(const NearDuplicateHandling handling) noexcept
+        {
+        m_nearDuplicateHandling = handling;
+        }
+
+    [[nodiscard]]
+    NearDuplicateHandling GetNearDuplicateHandling() const noexcept
+        {
+        return m_nearDuplicateHandling;
+        }
+
     // random sampling size
     void SetBatchRandomSamplingSize(const size_t size) noexcept
         {
@@ -2628,6 +2654,7 @@ class ReadabilityAppOptions
     int m_batchGroupDefault{ 2 };
     // document storage/linking information
     TextStorage m_documentStorageMethod{ TextStorage::NoEmbedText };
+    int m_projectCompressionLevel{ 9 };
     // Window information
     bool m_appWindowMaximized{ true };
     int m_appWindowWidth{ 800 };
@@ -2731,6 +2758,7 @@ class ReadabilityAppOptions
     // project settings
     VarianceMethod m_varianceMethod{ VarianceMethod::PopulationVariance };
     size_t m_minDocWordCountForBatch{ 50 };
+    NearDuplicateHandling m_nearDuplicateHandling{ NearDuplicateHandling::Report };
     size_t m_randomSampleSizeForBatch{ 15 };
     bool m_randomSampling{ false };
     Wisteria::UI::ListCtrlEx::ColumnInfo::ColumnFilePathTruncationMode m_filePathTruncationMode{
@@ -3031,11 +3059,13 @@ class ReadabilityAppOptions
     const std::string_view XML_APPENDED_DOC_PATH{ _DT("appended-doc-path") };
     // document linking information
     const std::string_view XML_DOCUMENT_STORAGE_METHOD{ _DT("document-storage-method") };
+    const std::string_view XML_PROJECT_COMPRESSION_LEVEL{ _DT("project-compression-level") };
     // stats information
     const std::string_view XML_STATISTICS_RESULTS{ _DT("statistics-results") };
     const std::string_view XML_STATISTICS_REPORT{ _DT("statistics-report") };
     // Min doc size
     const std::string_view XML_MIN_DOC_SIZE_FOR_BATCH{ _DT("min-doc-size-for-batch") };
+    const std::string_view XML_NEAR_DUPLICATE_HANDLING{ _DT("near-duplicate-handling") };
     const std::string_view XML_RANDOM_SAMPLE_SIZE{ _DT("random-sample-size") };
     const std::string_view XML_RANDOM_SAMPLE_ENABLED{ _DT("random-sample-size-enabled") };
     const std::string_view XML_FILE_PATH_TRUNC_MODE{ _DT("filepath-truncation-mode") };
@@ -0,0 +1,463 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "duplicate_file_finder.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <wx/filename.h>
+#include <wx/intl.h>
+#include <wx/log.h>
+
+//----------------------------------
+void DuplicateFileFinder::StreamHash::Update(const void* data, size_t length)
+    {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    m_totalLength += length;
+    // finish a stripe started by a previous update
+    if (m_bufferedLength > 0)
+        {
+        const size_t toCopy = std::min(length, STRIPE_SIZE - m_bufferedLength);
+        std::memcpy(m_buffer + m_bufferedLength, bytes, toCopy);
+        m_bufferedLength += toCopy;
+        bytes += toCopy;
+        length -= toCopy;
+        if (m_bufferedLength < STRIPE_SIZE)
+            {
+            return;
+            }
+        ConsumeStripe(m_buffer);
+        m_bufferedLength = 0;
+        }
+    for (; length >= STRIPE_SIZE; bytes += STRIPE_SIZE, length -= STRIPE_SIZE)
+        {
+        ConsumeStripe(bytes);
+        }
+    std::memcpy(m_buffer, bytes, length);
+    m_bufferedLength = length;
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::StreamHash::GetDigest() const noexcept
+    {
+    uint64_t hashValue = (m_totalLength >= STRIPE_SIZE) ?
+                             MergeAccumulators() :
+                             (m_accumulators[2] /*the seed*/ + PRIME5);
+    hashValue += m_totalLength;
+
+    const uint8_t* bytes = m_buffer;
+    size_t length = m_bufferedLength;
+    for (; length >= 8; bytes += 8, length -= 8)
+        {
+        hashValue ^= Round(0, Read64(bytes));
+        hashValue = std::rotl(hashValue, 27) * PRIME1 + PRIME4;
+        }
+    if (length >= 4)
+        {
+        hashValue ^= static_cast<uint64_t>(Read32(bytes)) * PRIME1;
+        hashValue = std::rotl(hashValue, 23) * PRIME2 + PRIME3;
+        bytes += 4;
+        length -= 4;
+        }
+    for (; length > 0; ++bytes, --length)
+        {
+        hashValue ^= (*bytes) * PRIME5;
+        hashValue = std::rotl(hashValue, 11) * PRIME1;
+        }
+
+    // avalanche
+    hashValue ^= hashValue >> 33;
+    hashValue *= PRIME2;
+    hashValue ^= hashValue >> 29;
+    hashValue *= PRIME3;
+    hashValue ^= hashValue >> 32;
+    return hashValue;
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::StreamHash::Read64(const uint8_t* bytes) noexcept
+    {
+    uint64_t value{ 0 };
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+    }
+
+//----------------------------------
+uint32_t DuplicateFileFinder::StreamHash::Read32(const uint8_t* bytes) noexcept
+    {
+    uint32_t value{ 0 };
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::StreamHash::Round(uint64_t accumulator,
+                                                const uint64_t input) noexcept
+    {
+    accumulator += input * PRIME2;
+    return std::rotl(accumulator, 31) * PRIME1;
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::StreamHash::MergeRound(uint64_t hashValue,
+                                                     const uint64_t accumulator) noexcept
+    {
+    hashValue ^= Round(0, accumulator);
+    return hashValue * PRIME1 + PRIME4;
+    }
+
+//----------------------------------
+void DuplicateFileFinder::StreamHash::ConsumeStripe(const uint8_t* bytes) noexcept
+    {
+    for (size_t i = 0; i < 4; ++i)
+        {
+        m_accumulators[i] = Round(m_accumulators[i], Read64(bytes + (i * 8)));
+        }
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::StreamHash::MergeAccumulators() const noexcept
+    {
+    uint64_t hashValue = std::rotl(m_accumulators[0], 1) + std::rotl(m_accumulators[1], 7) +
+                         std::rotl(m_accumulators[2], 12) + std::rotl(m_accumulators[3], 18);
+    for (const auto accumulator : m_accumulators)
+        {
+        hashValue = MergeRound(hashValue, accumulator);
+        }
+    return hashValue;
+    }
+
+//----------------------------------
+uint64_t DuplicateFileFinder::HashBytes(const void* data, const size_t length)
+    {
+    StreamHash hash;
+    hash.Update(data, length);
+    return hash.GetDigest();
+    }
+
+//----------------------------------
+std::vector<std::vector<wxString>> DuplicateFileFinder::FindDuplicates(const wxArrayString& files)
+    {
+    m_cancelled = false;
+
+    std::vector<FileEntry> entries(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+        {
+        entries[i].m_path = files[i];
+        }
+
+    // sizes
+    if (!RunParallel(_(L"Reviewing file sizes..."), entries.size(),
+                     [&entries](const size_t index)
+                     {
+                         const wxULongLong fileSize = wxFileName::GetSize(entries[index].m_path);
+                         if (fileSize == wxInvalidSize)
+                             {
+                             entries[index].m_isOk = false;
+                             }
+                         else
+                             {
+                             entries[index].m_size =
+                                 static_cast<wxFileOffset>(fileSize.GetValue());
+                             }
+                     }))
+        {
+        return {};
+        }
+    std::vector<std::vector<FileEntry*>> groups(1);
+    for (auto& entry : entries)
+        {
+        if (entry.m_isOk && entry.m_size > 0)
+            {
+            groups.front().push_back(&entry);
+            }
+        }
+    // files with a unique size can't have a duplicate, so they are never read
+    groups = GroupEntries(groups);
+
+    // sample (beginning and end) hashes
+    std::vector<FileEntry*> candidates;
+    for (const auto& group : groups)
+        {
+        candidates.insert(candidates.end(), group.cbegin(), group.cend());
+        }
+    if (!RunParallel(_(L"Sampling files..."), candidates.size(),
+                     [&candidates](const size_t index) { HashSample(*candidates[index]); }))
+        {
+        return {};
+        }
+    groups = GroupEntries(groups);
+
+    // full hashes (for files larger than what the sample covered)
+    candidates.clear();
+    for (const auto& group : groups)
+        {
+        for (auto* entry : group)
+            {
+            if (!entry->m_fullyHashed)
+                {
+                candidates.push_back(entry);
+                }
+            }
+        }
+    if (!RunParallel(_(L"Searching for duplicate files..."), candidates.size(),
+                     [&candidates](const size_t index) { HashFile(*candidates[index]); }))
+        {
+        return {};
+        }
+    groups = GroupEntries(groups);
+
+    // byte-for-byte comparisons, splitting up any groups with hash collisions
+    if (IsVerifyingContent())
+        {
+        std::vector<std::vector<std::vector<FileEntry*>>> verifiedGroups(groups.size());
+        if (!RunParallel(_(L"Comparing duplicate files..."), groups.size(),
+                         [&groups, &verifiedGroups](const size_t index)
+                         {
+                             auto& contentGroups = verifiedGroups[index];
+                             for (auto* entry : groups[index])
+                                 {
+                                 auto contentGroup = std::find_if(
+                                     contentGroups.begin(), contentGroups.end(),
+                                     [entry](const auto& group)
+                                     {
+                                         return AreFilesEqual(group.front()->m_path,
+                                                              entry->m_path);
+                                     });
+                                 if (contentGroup != contentGroups.end())
+                                     {
+                                     contentGroup->push_back(entry);
+                                     }
+                                 else
+                                     {
+                                     contentGroups.push_back({ entry });
+                                     }
+                                 }
+                         }))
+            {
+            return {};
+            }
+        groups.clear();
+        for (auto& contentGroups : verifiedGroups)
+            {
+            for (auto& group : contentGroups)
+                {
+                if (group.size() > 1)
+                    {
+                    groups.push_back(std::move(group));
+                    }
+                }
+            }
+        }
+
+    std::vector<std::vector<wxString>> duplicates;
+    duplicates.reserve(groups.size());
+    for (const auto& group : groups)
+        {
+        std::vector<wxString> paths;
+        paths.reserve(group.size());
+        for (const auto* entry : group)
+            {
+            paths.push_back(entry->m_path);
+            }
+        std::sort(paths.begin(), paths.end());
+        duplicates.push_back(std::move(paths));
+        }
+    std::sort(duplicates.begin(), duplicates.end(),
+              [](const auto& first, const auto& second) { return first.front() < second.front(); });
+    return duplicates;
+    }
+
+//----------------------------------
+bool DuplicateFileFinder::RunParallel(const wxString& message, const size_t count,
+                                      const std::function<void(const size_t)>& task)
+    {
+    std::atomic<size_t> nextIndex{ 0 };
+    std::atomic<size_t> processedCount{ 0 };
+    const auto processFiles = [this, &task, &nextIndex, &processedCount, count]()
+    {
+        // unreadable files are skipped, so don't log an error for each one
+        wxLogNull noLogging;
+        for (size_t i = nextIndex++; i < count && !m_cancelled; i = nextIndex++)
+            {
+            task(i);
+            ++processedCount;
+            }
+    };
+
+    const size_t workerCount = std::min(
+        count, (m_threadCount > 0) ? m_threadCount :
+                                     std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        {
+        workers.push_back(std::async(std::launch::async, processFiles));
+        }
+
+    const auto reportProgress = [this, &message, &processedCount, count]()
+    {
+        if (m_progressCallback && !m_cancelled &&
+            !m_progressCallback(message, processedCount, count))
+            {
+            m_cancelled = true;
+            }
+    };
+    // this thread only reports progress (e.g., to a progress dialog),
+    // so that the UI stays responsive while the workers read the files
+    for (auto& worker : workers)
+        {
+        while (worker.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+            {
+            reportProgress();
+            }
+        }
+    // rethrow any exceptions from the workers
+    for (auto& worker : workers)
+        {
+        worker.get();
+        }
+    reportProgress();
+    return !m_cancelled;
+    }
+
+//----------------------------------
+std::vector<std::vector<DuplicateFileFinder::FileEntry*>>
+DuplicateFileFinder::GroupEntries(const std::vector<std::vector<FileEntry*>>& groups)
+    {
+    const auto getKey = [](const FileEntry* entry)
+    { return std::tie(entry->m_size, entry->m_hash); };
+
+    std::vector<std::vector<FileEntry*>> newGroups;
+    for (const auto& group : groups)
+        {
+        std::vector<FileEntry*> sortedGroup;
+        sortedGroup.reserve(group.size());
+        std::copy_if(group.cbegin(), group.cend(), std::back_inserter(sortedGroup),
+                     [](const FileEntry* entry) { return entry->m_isOk; });
+        std::sort(sortedGroup.begin(), sortedGroup.end(),
+                  [&getKey](const FileEntry* first, const FileEntry* second)
+                  { return getKey(first) < getKey(second); });
+        for (auto groupStart = sortedGroup.cbegin(); groupStart != sortedGroup.cend();)
+            {
+            const auto groupEnd = std::find_if(groupStart, sortedGroup.cend(),
+                                               [&getKey, groupStart](const FileEntry* entry)
+                                               { return getKey(entry) != getKey(*groupStart); });
+            if (std::distance(groupStart, groupEnd) > 1)
+                {
+                newGroups.emplace_back(groupStart, groupEnd);
+                }
+            groupStart = groupEnd;
+            }
+        }
+    return newGroups;
+    }
+
+//----------------------------------
+void DuplicateFileFinder::HashSample(FileEntry& entry)
+    {
+    wxFile file(entry.m_path);
+    if (!file.IsOpened())
+        {
+        entry.m_isOk = false;
+        return;
+        }
+    // small files are read in full, which also serves as their full hash
+    entry.m_fullyHashed = (entry.m_size <= static_cast<wxFileOffset>(SAMPLE_SIZE * 2));
+    std::vector<char> buffer(entry.m_fullyHashed ? static_cast<size_t>(entry.m_size) :
+                                                   SAMPLE_SIZE * 2);
+    if (entry.m_fullyHashed)
+        {
+        entry.m_isOk = (file.Read(buffer.data(), buffer.size()) ==
+                        static_cast<ssize_t>(buffer.size()));
+        }
+    else
+        {
+        entry.m_isOk =
+            (file.Read(buffer.data(), SAMPLE_SIZE) == static_cast<ssize_t>(SAMPLE_SIZE) &&
+             file.Seek(-static_cast<wxFileOffset>(SAMPLE_SIZE), wxFromEnd) != wxInvalidOffset &&
+             file.Read(buffer.data() + SAMPLE_SIZE, SAMPLE_SIZE) ==
+                 static_cast<ssize_t>(SAMPLE_SIZE));
+        }
+    if (entry.m_isOk)
+        {
+        entry.m_hash = HashBytes(buffer.data(), buffer.size());
+        }
+    }
+
+//----------------------------------
+void DuplicateFileFinder::HashFile(FileEntry& entry)
+    {
+    wxFile file(entry.m_path);
+    if (!file.IsOpened())
+        {
+        entry.m_isOk = false;
+        return;
+        }
+    StreamHash hash;
+    std::vector<char> buffer(READ_BLOCK_SIZE);
+    wxFileOffset totalRead{ 0 };
+    for (;;)
+        {
+        const ssize_t bytesRead = file.Read(buffer.data(), buffer.size());
+        if (bytesRead == wxInvalidOffset)
+            {
+            entry.m_isOk = false;
+            return;
+            }
+        if (bytesRead == 0)
+            {
+            break;
+            }
+        hash.Update(buffer.data(), static_cast<size_t>(bytesRead));
+        totalRead += bytesRead;
+        }
+    // the file changed since its size was read
+    entry.m_isOk = (totalRead == entry.m_size);
+    entry.m_hash = hash.GetDigest();
+    }
+
+//----------------------------------
+bool DuplicateFileFinder::AreFilesEqual(const wxString& firstPath, const wxString& secondPath)
+    {
+    wxFile firstFile(firstPath);
+    wxFile secondFile(secondPath);
+    if (!firstFile.IsOpened() || !secondFile.IsOpened())
+        {
+        return false;
+        }
+    std::vector<char> firstBuffer(READ_BLOCK_SIZE);
+    std::vector<char> secondBuffer(READ_BLOCK_SIZE);
+    for (;;)
+        {
+        const ssize_t firstRead = firstFile.Read(firstBuffer.data(), firstBuffer.size());
+        const ssize_t secondRead = secondFile.Read(secondBuffer.data(), secondBuffer.size());
+        if (firstRead == wxInvalidOffset || firstRead != secondRead)
+            {
+            return false;
+            }
+        if (firstRead == 0)
+            {
+            return true;
+            }
+        if (std::memcmp(firstBuffer.data(), secondBuffer.data(), static_cast<size_t>(firstRead)) !=
+            0)
+            {
+            return false;
+            }
+        }
+    }
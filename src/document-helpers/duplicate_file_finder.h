@@ -0,0 +1,189 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __DUPLICATE_FILE_FINDER_H__
+#define __DUPLICATE_FILE_FINDER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <wx/arrstr.h>
+#include <wx/file.h>
+#include <wx/string.h>
+
+/** @brief Finds groups of files with identical content.
+    @details Files are compared in stages, with each stage only reading the files that
+        are still candidates for being duplicates:
+        -# Files are grouped by size; files with a unique size are dropped without being read.
+        -# The remaining files have a sample (their beginning and end) hashed, and are
+           regrouped by size and sample hash.
+        -# Files still sharing a group are hashed in full (with a 64-bit hash).
+        -# Optionally, files in the final groups are compared byte for byte, in case of a
+           hash collision (see VerifyContent()).
+
+        Reading and hashing files is spread across multiple threads.
+    @note Empty files and files that cannot be read are skipped.*/
+class DuplicateFileFinder
+    {
+  public:
+    /** @brief Callback for reporting progress.
+        @details This is called from the thread that called FindDuplicates(), periodically
+            while the files are being read.\n
+            The parameters are a description of the current stage, the number of files
+            processed so far in that stage, and the number of files in the stage.
+            Return @c false to cancel the search.*/
+    using ProgressCallback =
+        std::function<bool(const wxString& message, const size_t processed, const size_t total)>;
+
+    /// @private
+    DuplicateFileFinder() = default;
+    /// @private
+    DuplicateFileFinder(const DuplicateFileFinder&) = delete;
+    /// @private
+    DuplicateFileFinder& operator=(const DuplicateFileFinder&) = delete;
+
+    /** @brief Sets whether files with matching hashes should be compared byte for byte
+            before being reported as duplicates.
+        @details This guarantees that there are no false positives (at the cost of reading
+            the duplicate files again), which is recommended if the duplicates
+            will be deleted.
+        @param verify @c true to compare the files' content.*/
+    void VerifyContent(const bool verify) noexcept { m_verifyContent = verify; }
+
+    /// @returns @c true if files with matching hashes are compared byte for byte.
+    [[nodiscard]]
+    bool IsVerifyingContent() const noexcept
+        {
+        return m_verifyContent;
+        }
+
+    /** @brief Sets the number of threads to read files with.
+        @param threadCount The number of threads; @c 0 (the default) uses one per core.*/
+    void SetThreadCount(const size_t threadCount) noexcept { m_threadCount = threadCount; }
+
+    /// @returns The number of threads used to read files (@c 0 meaning one per core).
+    [[nodiscard]]
+    size_t GetThreadCount() const noexcept
+        {
+        return m_threadCount;
+        }
+
+    /** @brief Sets the function to report progress (and check for cancellation) with.
+        @param callback The progress callback.*/
+    void SetProgressCallback(ProgressCallback callback)
+        {
+        m_progressCallback = std::move(callback);
+        }
+
+    /** @brief Finds the files with identical content.
+        @param files The files to review.
+        @returns The groups of identical files (each having at least two files).
+            Files are sorted within each group, and groups are sorted by their first file.
+            If the search was cancelled, then this will be empty.*/
+    [[nodiscard]]
+    std::vector<std::vector<wxString>> FindDuplicates(const wxArrayString& files);
+
+    /// @returns @c true if the last search was cancelled from the progress callback.
+    [[nodiscard]]
+    bool WasCancelled() const noexcept
+        {
+        return m_cancelled;
+        }
+
+    /** @returns The 64-bit (XXH64) hash of a block of memory.
+        @param data The data to hash.
+        @param length The length of @c data (in bytes).*/
+    [[nodiscard]]
+    static uint64_t HashBytes(const void* data, const size_t length);
+
+  private:
+#ifdef __UNITTEST
+  public:
+#endif
+    /// @brief Incremental XXH64 hash (with a seed of zero).
+    class StreamHash
+        {
+      public:
+        /// @brief Hashes the next block of data.
+        void Update(const void* data, size_t length);
+        /// @returns The hash of all the data so far.
+        [[nodiscard]]
+        uint64_t GetDigest() const noexcept;
+
+      private:
+        constexpr static uint64_t PRIME1{ 11'400'714'785'074'694'791ULL };
+        constexpr static uint64_t PRIME2{ 14'029'467'366'897'019'727ULL };
+        constexpr static uint64_t PRIME3{ 1'609'587'929'392'839'161ULL };
+        constexpr static uint64_t PRIME4{ 9'650'029'242'287'828'579ULL };
+        constexpr static uint64_t PRIME5{ 2'870'177'450'012'600'261ULL };
+        constexpr static size_t STRIPE_SIZE{ 32 };
+
+        [[nodiscard]]
+        static uint64_t Read64(const uint8_t* bytes) noexcept;
+        [[nodiscard]]
+        static uint32_t Read32(const uint8_t* bytes) noexcept;
+        [[nodiscard]]
+        static uint64_t Round(uint64_t accumulator, const uint64_t input) noexcept;
+        [[nodiscard]]
+        static uint64_t MergeRound(uint64_t hashValue, const uint64_t accumulator) noexcept;
+        void ConsumeStripe(const uint8_t* bytes) noexcept;
+        [[nodiscard]]
+        uint64_t MergeAccumulators() const noexcept;
+
+        uint64_t m_accumulators[4]{ PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1 };
+        uint8_t m_buffer[STRIPE_SIZE]{ 0 };
+        size_t m_bufferedLength{ 0 };
+        uint64_t m_totalLength{ 0 };
+        };
+#ifdef __UNITTEST
+  private:
+#endif
+
+    struct FileEntry
+        {
+        wxString m_path;
+        wxFileOffset m_size{ wxInvalidOffset };
+        uint64_t m_hash{ 0 };
+        // set if the sample hash covered the whole file
+        bool m_fullyHashed{ false };
+        bool m_isOk{ true };
+        };
+
+    /// @brief Runs @c task for each index in [0, count) across the worker threads,
+    ///     reporting progress from the calling thread.
+    /// @returns @c false if cancelled.
+    bool RunParallel(const wxString& message, const size_t count,
+                     const std::function<void(const size_t)>& task);
+    /// @returns The groups of entries that share a size and hash (dropping unique ones).
+    [[nodiscard]]
+    static std::vector<std::vector<FileEntry*>>
+    GroupEntries(const std::vector<std::vector<FileEntry*>>& groups);
+    static void HashSample(FileEntry& entry);
+    static void HashFile(FileEntry& entry);
+    [[nodiscard]]
+    static bool AreFilesEqual(const wxString& firstPath, const wxString& secondPath);
+
+    // bytes read from the start and end of files for the sample hash
+    constexpr static size_t SAMPLE_SIZE{ 16 * 1024 };
+    // bytes read at a time when hashing or comparing full files
+    constexpr static size_t READ_BLOCK_SIZE{ 1024 * 1024 };
+
+    bool m_verifyContent{ false };
+    size_t m_threadCount{ 0 };
+    ProgressCallback m_progressCallback;
+    std::atomic<bool> m_cancelled{ false };
+    };
+
+#endif //__DUPLICATE_FILE_FINDER_H__
@@ -15,7 +15,12 @@
 #define __CHARACTERS_H__
 
 #include "../Wisteria-Dataviz/src/util/string_util.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
 /// @brief Namespace for punctuation classes.
 /// @details Recognizes the following character sets:
@@ -46,7 +51,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_alpha(const wchar_t ch) noexcept
             {
-            return (is_upper(ch) || is_lower(ch));
+            return has_property(ch, property::alpha, &reference::is_alpha);
             }
 
         /** @returns @c true if a character is a letter (English alphabet only,
@@ -64,25 +69,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_upper(const wchar_t ch) noexcept
             {
-            return (
-                // A-Z
-                (ch >= 0x41 && ch <= 0x5A) ||
-                // A-Z, full-width
-                (ch >= 0xFF21 && ch <= 0xFF3A) ||
-                // uppercase extended ASCII set
-                (ch >= 0xC0 && ch <= 0xD6) || (ch >= 0xD8 && ch <= 0xDE) ||
-                (ch == 0x0112) || // E with macron
-                // Y with umlaut
-                (ch == 0x0178) ||
-                // OE ligature
-                (ch == 0x0152) ||
-                // Eastern European
-                // C with acute, R with acuate, L with stroke, R with charon, A with breve, C with
-                // charon, A with ogonek, O with double accent
-                (ch == 0x0106 || ch == 0x0154 || ch == 0x0141 || ch == 0x0158 || ch == 0x0102 ||
-                 ch == 0x010C || ch == 0x0104 || ch == 0x0150) ||
-                // Russian
-                (ch >= 0x0410 && ch <= 0x042F) || (ch == 0x0401));
+            return has_property(ch, property::upper, &reference::is_upper);
             }
 
         /** @returns @c true if a character is a lowercased letter.
@@ -90,29 +77,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_lower(const wchar_t ch) noexcept
             {
-            return (
-                // a-z
-                (ch >= 0x61 && ch <= 0x7A) ||
-                // a-z, full-width
-                (ch >= 0xFF41 && ch <= 0xFF5A) ||
-                // lowercase extended ASCII set
-                (ch >= 0xE0 && ch <= 0xF6) || (ch >= 0xF8 && ch <= 0xFF) ||
-                (ch == 0x0113) || // e with macron
-                // OE ligature
-                (ch == 0x0153) ||
-                // superscript letters
-                string_util::is_superscript_lowercase(ch) || // n
-                // subscript letters
-                (ch >= 0x2090 && ch <= 0x209C) ||
-                // German eszett (not exactly lowercase, but words never begin with these)
-                (ch == 0xDF) ||
-                // Eastern European
-                // C with acute, R with acuate, L with stroke, R with charon, A with breve, C with
-                // charon, A with ogonek, O with double accent
-                (ch == 0x0107 || ch == 0x0155 || ch == 0x0142 || ch == 0x0159 || ch == 0x0103 ||
-                 ch == 0x010D || ch == 0x0105 || ch == 0x0151) ||
-                // Russian
-                (ch >= 0x0430 && ch <= 0x044F) || (ch == 0x0451));
+            return has_property(ch, property::lower, &reference::is_lower);
             }
 
         /** @returns The lowercased version of a letter, or the letter itself
@@ -146,44 +111,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_vowel(const wchar_t letter) noexcept
             {
-            return ((letter == L'a') || (letter == L'e') || (letter == L'i') || (letter == L'o') ||
-                    (letter == L'u') || (letter == L'y') || (letter == L'A') || (letter == L'E') ||
-                    (letter == L'I') || (letter == L'O') || (letter == L'U') || (letter == L'Y') ||
-                    (letter == 0x1D43) || // superscript a
-                    (letter == 0x1D49) || // superscript e
-                    (letter == 0x2071) || // superscript i
-                    (letter == 0x1D52) || // superscript o
-                    (letter == 0x1D58) || // superscript u
-                    (letter == 0x02B8) || // superscript y
-                    (letter == 0x2090) || // subscript a
-                    (letter == 0x2091) || // subscript e
-                    (letter == 0x2092) || // subscript o
-                    (letter == 0x2094) || // subscript upsidedown e
-                    // full-width a,e,i,o,u,y
-                    (letter == 0xFF21) || (letter == 0xFF25) || (letter == 0xFF29) ||
-                    (letter == 0xFF2F) || (letter == 0xFF35) || (letter == 0xFF39) ||
-                    (letter == 0xFF41) || (letter == 0xFF45) || (letter == 0xFF49) ||
-                    (letter == 0xFF4F) || (letter == 0xFF55) || (letter == 0xFF59) ||
-                    // Extended ASCII Western European letters
-                    (letter >= 0xC0 && letter <= 0xC6) || (letter >= 0xC8 && letter <= 0xCF) ||
-                    (letter >= 0xD2 && letter <= 0xD6) || (letter >= 0xD8 && letter <= 0xDC) ||
-                    (letter >= 0xE0 && letter <= 0xE6) || (letter >= 0xE8 && letter <= 0xEF) ||
-                    (letter >= 0xF2 && letter <= 0xF6) || (letter >= 0xF8 && letter <= 0xFC) ||
-                    (letter >= 0x152 && letter <= 0x153) || // OE ligature
-                    // e with macron
-                    (letter == 0x0112 || letter == 0x0113) ||
-                    // basic Russian alphabet
-                    is_either<wchar_t>(letter, 0x0401, 0x0451) ||
-                    is_either<wchar_t>(letter, 0x0410, 0x0430) ||
-                    is_either<wchar_t>(letter, 0x0415, 0x0435) ||
-                    is_either<wchar_t>(letter, 0x0418, 0x0438) ||
-                    is_either<wchar_t>(letter, 0x0419, 0x0439) ||
-                    is_either<wchar_t>(letter, 0x041E, 0x043E) ||
-                    is_either<wchar_t>(letter, 0x0423, 0x0443) ||
-                    is_either<wchar_t>(letter, 0x042B, 0x044B) ||
-                    is_either<wchar_t>(letter, 0x042D, 0x044D) ||
-                    is_either<wchar_t>(letter, 0x042E, 0x044E) ||
-                    is_either<wchar_t>(letter, 0x042F, 0x044F));
+            return has_property(letter, property::vowel, &reference::is_vowel);
             }
 
         /** @returns @c true if a character is a consonant.
@@ -194,53 +122,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_consonant(const wchar_t letter) noexcept
             {
-            return (
-                (letter >= L'B' && letter <= L'D') || (letter >= L'F' && letter <= L'H') ||
-                (letter >= L'J' && letter <= L'N') || (letter >= L'P' && letter <= L'T') ||
-                // just treat 'y' as a vowel for the sake of argument
-                (letter >= L'V' && letter <= L'X') || (letter == L'Z') ||
-                (letter >= L'b' && letter <= L'd') || (letter >= L'f' && letter <= L'h') ||
-                (letter >= L'j' && letter <= L'n') || (letter >= L'p' && letter <= L't') ||
-                // just treat 'y' as a vowel for the sake of argument
-                (letter >= L'v' && letter <= L'x') || (letter == L'z') ||
-                // superscripts
-                (letter == 0x1D47) || (letter == 0x1D9C) || (letter == 0x1D48) ||
-                (letter == 0x1DA0) || (letter == 0x1D4D) || (letter == 0x02B0) ||
-                (letter == 0x02B2) || (letter == 0x1D4F) || (letter == 0x02E1) ||
-                (letter == 0x1D50) || (letter == 0x207F) || (letter == 0x1D56) ||
-                (letter == 0x02B3) || (letter == 0x02E2) || (letter == 0x1D57) ||
-                (letter == 0x1D5B) || (letter == 0x02B7) || (letter == 0x02E3) ||
-                (letter == 0x1DBB) || (letter == 0x2093) || // subscript x
-                (letter >= 0x2095 &&
-                 letter <= 0x209C) || // subscript h - t (not all those letters, though)
-                // full-width letters
-                (letter >= 0xFF22 && letter <= 0xFF24) ||
-                (letter >= 0xFF26 && letter <= 0xFF28) || (letter >= 0xFF2A && letter <= 0xFF2E) ||
-                (letter >= 0xFF30 && letter <= 0xFF34) ||
-                // just treat 'y' as a vowel for the sake of argument
-                (letter >= 0xFF36 && letter <= 0xFF38) || (letter == 0xFF3A) ||
-                (letter >= 0xFF42 && letter <= 0xFF44) || (letter >= 0xFF46 && letter <= 0xFF48) ||
-                (letter >= 0xFF4A && letter <= 0xFF4E) || (letter >= 0xFF50 && letter <= 0xFF54) ||
-                // just treat 'y' as a vowel for the sake of argument
-                (letter >= 0xFF56 && letter <= 0xFF58) || (letter == 0xFF5A) ||
-                // Extended ASCII Western European letters
-                (letter == 0xC7) ||                   // upper C with cedilla
-                (letter == 0xD0) ||                   // upper Eth
-                (letter == 0xD1) ||                   // upper N with tilde
-                (letter >= 0xDD && letter <= 0xDF) || // upper Y with acute to Eszett
-                (letter == 0xE7) ||                   // lower C with cedilla
-                (letter == 0xF0) ||                   // lower Eth
-                (letter == 0xF1) ||                   // lower N with tilde
-                (letter >= 0xFD && letter <= 0xFF) || // lower Y with acute to Y with umlauts
-                (letter == 0x0178) ||
-                // basic Russian alphabet
-                (letter >= 0x0411 && letter <= 0x414) || (letter >= 0x0416 && letter <= 0x417) ||
-                (letter >= 0x041A && letter <= 0x041D) || (letter >= 0x041F && letter <= 0x0422) ||
-                (letter >= 0x0424 && letter <= 0x042A) ||
-                is_either<wchar_t>(letter, 0x042C, 0x044C) ||
-                (letter >= 0x0431 && letter <= 0x434) || (letter >= 0x0436 && letter <= 0x437) ||
-                (letter >= 0x043A && letter <= 0x043D) || (letter >= 0x043F && letter <= 0x0442) ||
-                (letter >= 0x0444 && letter <= 0x044A));
+            return has_property(letter, property::consonant, &reference::is_consonant);
             }
 
         /** @returns @c true if a character is a lowercased consonant.
@@ -250,7 +132,12 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_lower_consonant(const wchar_t letter) noexcept
             {
-            return (is_lower(letter) && is_consonant(letter));
+            if (std::is_constant_evaluated() || !is_in_table(letter))
+                {
+                return (reference::is_lower(letter) && reference::is_consonant(letter));
+                }
+            constexpr uint32_t lowerConsonant{ property::lower | property::consonant };
+            return ((get_property_table().get(letter) & lowerConsonant) == lowerConsonant);
             }
 
         /** @returns @c true if a character can begin a word.
@@ -258,38 +145,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool can_character_begin_word(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
-                    true :
-                   is_either<wchar_t>(ch, 37, 0xFF05) ? // % (could be the entire word)
-                    true :
-                   is_either<wchar_t>(ch, 36, 0xFF04) ? // $
-                    true :
-                   is_either<wchar_t>(ch, L'&', 0xFF06) ?
-                    true :
-                   is_numeric_simple(ch) ?
-                    true :
-                   // don't allow words to start with super/subscripts or fractions
-                   (is_alpha(ch) && !string_util::is_superscript(ch) &&
-                    !string_util::is_subscript(ch)) ?
-                    true :
-                   // Doxygen tags (e.g., @note) or used as a whole word
-                   // (e.g., "meet @ 5:00")
-                   is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
-                   (ch == 0x9F) ? // Y with diaeresis
-                    true :
-                   is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
-                    true :
-                   is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
-                    true :
-                   (ch == 0x20B1) ? // Cuban peso
-                    true :
-                   (ch == 0x20A9) ? // Korean Won (currency)
-                    true :
-                   (ch == 177) ? // plus/minus±
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::begin_word, &reference::can_character_begin_word);
             }
 
         /** @returns @c true if a character is an uppercased letter that
@@ -298,29 +154,8 @@ namespace characters
         [[nodiscard]]
         constexpr static bool can_character_begin_word_uppercase(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
-                    true :
-                   is_either<wchar_t>(ch, 36, 0xFF04) ? // $
-                    true :
-                   is_either<wchar_t>(ch, L'&', 0xFF06) ? true :
-                   is_numeric(ch)                       ? true :
-                   is_upper(ch)                         ? true :
-                   is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
-                   (ch == 0x9F) ? // Y with diaeresis
-                    true :
-                   is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
-                    true :
-                   is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
-                    true :
-                   (ch == 0x20B1) ? // Cuban peso
-                    true :
-                   (ch == 0x20A9) ? // Korean Won (currency)
-                    true :
-                   (ch == 177) ? // plus/minus
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::begin_word_uppercase,
+                                &reference::can_character_begin_word_uppercase);
             }
 
         /** @returns @c true if a (non-numeric) character can appear at the end of a word.
@@ -328,33 +163,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool can_character_end_word(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
-                    true :
-                   is_either<wchar_t>(ch, 37, 0xFF05) ? // %
-                    true :
-                   is_either<wchar_t>(ch, L'&', 0xFF06) ? // &
-                    true :
-                   (ch == 46) ? // .
-                    true :
-                   is_either<wchar_t>(ch, 47, 0xFF0F) ? // '/'
-                    true :
-                   is_numeric(ch)    ? true :
-                   is_alpha(ch)      ? true :
-                   is_apostrophe(ch) ? true :
-                   // could be an entire word
-                   is_either<wchar_t>(ch, L'@', 0xFF20) ?
-                    true :
-                   is_either<wchar_t>(ch, 92, 0xFF3C) ? /*\*/
-                    true :
-                   (ch == 0x9F) ? // Y with diaeresis
-                    true :
-                   is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
-                    true :
-                   is_either<wchar_t>(ch, 176, 0xFFEE) ? // degree
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::end_word, &reference::can_character_end_word);
             }
 
         /** @returns @c true if a (non-numeric) character can appear at the end of a number.
@@ -362,15 +171,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool can_character_end_numeral(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 37, 0xFF05) ? // %
-                    true :
-                   is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
-                    true :
-                   is_either<wchar_t>(ch, 176, 0xFFEE) ? // degree
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::end_numeral, &reference::can_character_end_numeral);
             }
 
         /** @returns @c true if a character can appear inside the word.
@@ -379,40 +180,7 @@ namespace characters
         constexpr bool
         operator()(const wchar_t ch) const noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
-                    true :
-                   is_either<wchar_t>(ch, 37, 0xFF05) ? // %
-                    true :
-                   is_either<wchar_t>(ch, 38, 0xFF06) ? // &
-                    true :
-                   (ch == 46) ? // .
-                    true :
-                   is_either<wchar_t>(ch, 47, 0xFF0F) ? // /
-                    true :
-                   is_either<wchar_t>(ch, 58, 0xFF1A) ? // :
-                    true :
-                   is_numeric(ch)                       ? true :
-                   is_alpha(ch)                         ? true :
-                   is_hyphen(ch)                        ? true :
-                   is_apostrophe(ch)                    ? true :
-                   is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
-                   is_either<wchar_t>(ch, 92, 0xFF3C) ? /*\*/
-                    true :
-                   (ch >= 0x5F && ch <= 0x60) ? // _`
-                    true :
-                   (ch >= 0xFF3F && ch <= 0xFF40) ? // full-width _`
-                    true :
-                   (ch == 126) ? // tilde (usually appear inside a file path)
-                    true :
-                   (ch == 159) ? // Y with diaeresis
-                    true :
-                   is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
-                    true :
-                   is_either<wchar_t>( ch, 176, 0xFFEE) ? // degree
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::word_character, &reference::is_word_character);
             }
 
         /** @returns @c true if a character is a hyphen.
@@ -437,23 +205,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_dash(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 0x2012) ? // figure dash
-                    true :
-                   (ch == 0x2013) ? // en dash
-                    true :
-                   (ch == 0x2014) ? // em dash
-                    true :
-                   (ch == 0x2015) ? // horizontal bar
-                    true :
-                   (ch == 0x2E17) ? // Japanese double oblique hyphen
-                    true :
-                   (ch == 0x30A0) ? // Katakana-Hiragana double hyphen
-                    true :
-                   (ch == 0x301C) ? // Japanese wave dash
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::dash, &reference::is_dash);
             }
 
         /** @returns @c true if a character is an apostrophe (includes straight single quotes).
@@ -461,19 +213,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_apostrophe(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 39) ? // '
-                    true :
-                   (ch == 146) ? // apostrophe
-                    true :
-                   (ch == 180) ? // apostrophe
-                    true :
-                   (ch == 0xFF07) ? // full-width apostrophe
-                    true :
-                   (ch == 0x2019) ? // right single apostrophe
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::apostrophe, &reference::is_apostrophe);
             }
 
         /** @returns @c true if a character is a period.
@@ -491,29 +231,8 @@ namespace characters
         [[nodiscard]]
         constexpr static bool can_character_prefix_numeral(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
-                    true :
-                   is_either<wchar_t>(ch, 36, 0xFF04) ? // $
-                    true :
-                   (ch >= 43 && ch <= 46) ? //+,-.
-                    true :
-                   (ch >= 0xFF0B && ch <= 0xFF0E) ? // full-width +,-.
-                    true :
-                   is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
-                    true :
-                   is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
-                    true :
-                   (ch == 165) ? // Yen
-                    true :
-                   (ch == 177) ? // plus/minus
-                    true :
-                   (ch == 0x20B1) ? // Cuban peso
-                    true :
-                   (ch == 0x20A9) ? // Korean Won (currency)
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::prefix_numeral,
+                                &reference::can_character_prefix_numeral);
             }
 
         /** @returns @c true if a character stream is an ellipsis, and the number of periods
@@ -589,7 +308,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_quote(const wchar_t ch) noexcept
             {
-            return (is_single_quote(ch) || is_double_quote(ch));
+            return has_property(ch, property::quote, &reference::is_quote);
             }
 
         /** @returns @c true if a character is a single quote (includes Unicode and smart quotes).
@@ -597,27 +316,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_single_quote(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 39) ? // '
-                    true :
-                   (ch == 0xFF07) ? // full-width apostrophe
-                    true :
-                   (ch == 96) ? // `
-                    true :
-                   (ch == 130 || ch == 0x201A) ? // ‚ curved single quote
-                    true :
-                   (ch == 139 || ch == 0x2039) ? // ‹ left single quote (European)
-                    true :
-                   (ch == 155 || ch == 0x203A) ? // › right single quote (European)
-                    true :
-                   (ch == 145 || ch == 146) ? // Windows 1252 quote surrogates (single)
-                    true :
-                   (ch >= 0x2018 && ch <= 0x201B) ? // smart single quotes
-                    true :
-                   (ch == 0x300C || ch == 0x300D) ? // Japanese single quotes
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::single_quote, &reference::is_single_quote);
             }
 
         /** @returns @c true if a character is a double quote (includes Unicode and smart quotes).
@@ -625,21 +324,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_double_quote(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 34) ? // " straight double quote
-                    true :
-                   (ch == 132) ? // „ curved double quote
-                    true :
-                   (ch == 171 || ch == 187) ? // «» left/right double quote (European)
-                    true :
-                   (ch >= 147 && ch <= 148) ? // Windows 1252 quote surrogates (double)
-                    true :
-                   (ch >= 0x201C && ch <= 0x201F) ? // smart double quotes
-                    true :
-                   (ch == 0x300E || ch == 0x300F) ? // Japanese double quotes
-                    true :
-                    false;
-            // clang-format on
+            return has_property(ch, property::double_quote, &reference::is_double_quote);
             }
 
         /** @returns Whether a character sequence is a number (works with wide Unicode numbers too).
@@ -690,10 +375,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_numeric(const wchar_t ch) noexcept
             {
-            return is_numeric_simple(ch) ?
-                       // superscripts and fractions
-                       true :
-                       is_extended_numeric(ch) ? true : false;
+            return has_property(ch, property::numeric, &reference::is_numeric);
             }
 
         /** @returns Whether a character is a superscript, subscript, or fraction.
@@ -701,10 +383,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_extended_numeric(const wchar_t ch) noexcept
             {
-            return (string_util::is_fraction(ch) || string_util::is_superscript_number(ch) ||
-                    string_util::is_subscript_number(ch)) ?
-                       true :
-                       false;
+            return has_property(ch, property::extended_numeric, &reference::is_extended_numeric);
             }
 
         /** @returns Whether a character is a number
@@ -726,7 +405,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_space(const wchar_t ch) noexcept
             {
-            return (is_space_vertical(ch) || is_space_horizontal(ch));
+            return has_property(ch, property::space, &reference::is_space);
             }
 
         /** @returns Whether a character is a horizontal space or tab.
@@ -735,19 +414,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_space_horizontal(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 0x20) ? // regular space
-                    true :
-                   (ch == 0x09) ? // tab
-                    true :
-                   (ch == 0xA0 || ch == 0x202F) ? // no-break space, narrow
-                    true :
-                   (ch == 0x3000) ? // Japanese Ideographic Space
-                                    // En quad, thin space, hair space, em space,
-                                    // zero-width non-joiner (word separator), etc.
-                    true :
-                   (ch >= 0x2000 && ch <= 0x200C) ? true : false;
-            // clang-format on
+            return has_property(ch, property::space_horizontal, &reference::is_space_horizontal);
             }
 
         /** @returns Whether a character is a horizontal space.
@@ -756,17 +423,8 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_space_horizontal_except_tab(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 0x20) ? // regular space
-                    true :
-                   (ch == 0xA0 || ch == 0x202F) ? // no-break space, narrow
-                    true :
-                   (ch == 0x3000) ? // Japanese Ideographic Space
-                                    // En quad, thin space, hair space, em space,
-                                    // zero-width non-joiner (word separator), etc.
-                    true :
-                   (ch >= 0x2000 && ch <= 0x200C) ? true : false;
-            // clang-format on
+            return has_property(ch, property::space_horizontal_except_tab,
+                                &reference::is_space_horizontal_except_tab);
             }
 
         /** @returns Whether a character is a line-ending type character.
@@ -775,17 +433,7 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_space_vertical(const wchar_t ch) noexcept
             {
-            // clang-format off
-            return (ch == 0x0D) ? true :
-                   (ch == 0x0A) ? true :
-                   (ch == 0x0C) ? // form feed
-                    true :
-                   (ch == 0x2028) ? // line separator
-                    true :
-                   (ch == 0x2029) ? // paragraph separator
-                   true :
-                   false;
-            // clang-format on
+            return has_property(ch, property::space_vertical, &reference::is_space_vertical);
             }
 
         /** @returns Whether a character is a punctuation mark.
@@ -793,10 +441,725 @@ namespace characters
         [[nodiscard]]
         constexpr static bool is_punctuation(const wchar_t ch) noexcept
             {
-            // see if it is either a space, control character, or alphanumeric and negate that
-            return !(is_numeric(ch) || is_alpha(ch) || is_space(ch) ||
-                     // control characters
-                     ((ch >= 0x00) && (ch <= 0x20)));
+            return has_property(ch, property::punctuation, &reference::is_punctuation);
+            }
+
+        /// @brief Bit flags for the character classes stored in the lookup table.
+        enum property : uint32_t
+            {
+            upper = 1U << 0,                        /*!< is_upper()*/
+            lower = 1U << 1,                        /*!< is_lower()*/
+            alpha = 1U << 2,                        /*!< is_alpha()*/
+            vowel = 1U << 3,                        /*!< is_vowel()*/
+            consonant = 1U << 4,                    /*!< is_consonant()*/
+            begin_word = 1U << 5,                   /*!< can_character_begin_word()*/
+            begin_word_uppercase = 1U << 6,         /*!< can_character_begin_word_uppercase()*/
+            end_word = 1U << 7,                     /*!< can_character_end_word()*/
+            end_numeral = 1U << 8,                  /*!< can_character_end_numeral()*/
+            word_character = 1U << 9,               /*!< operator()*/
+            dash = 1U << 10,                        /*!< is_dash()*/
+            apostrophe = 1U << 11,                  /*!< is_apostrophe()*/
+            prefix_numeral = 1U << 12,              /*!< can_character_prefix_numeral()*/
+            quote = 1U << 13,                       /*!< is_quote()*/
+            single_quote = 1U << 14,                /*!< is_single_quote()*/
+            double_quote = 1U << 15,                /*!< is_double_quote()*/
+            numeric = 1U << 16,                     /*!< is_numeric()*/
+            extended_numeric = 1U << 17,            /*!< is_extended_numeric()*/
+            space = 1U << 18,                       /*!< is_space()*/
+            space_horizontal = 1U << 19,            /*!< is_space_horizontal()*/
+            space_horizontal_except_tab = 1U << 20, /*!< is_space_horizontal_except_tab()*/
+            space_vertical = 1U << 21,              /*!< is_space_vertical()*/
+            punctuation = 1U << 22                  /*!< is_punctuation()*/
+            };
+
+        /** @returns The character classes (a combination of property flags) of a character,
+                from the lookup table.
+            @param ch The character to look up.
+            @note Characters outside of the Basic Multilingual Plane are classified
+                with the reference definitions (and are much slower).*/
+        [[nodiscard]]
+        static uint32_t get_properties(const wchar_t ch) noexcept
+            {
+            if (!is_in_table(ch))
+                {
+                return calculate_properties(ch);
+                }
+            return get_property_table().get(ch);
+            }
+
+        /** @brief The definitions of the character classes that the lookup table is built from.
+            @details These are also used in constant expressions and for characters
+                outside of the Basic Multilingual Plane.
+            @note When changing a character class, change it here.*/
+        class reference
+            {
+          public:
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_upper(const wchar_t ch) noexcept
+                {
+                return (
+                    // A-Z
+                    (ch >= 0x41 && ch <= 0x5A) ||
+                    // A-Z, full-width
+                    (ch >= 0xFF21 && ch <= 0xFF3A) ||
+                    // uppercase extended ASCII set
+                    (ch >= 0xC0 && ch <= 0xD6) || (ch >= 0xD8 && ch <= 0xDE) ||
+                    (ch == 0x0112) || // E with macron
+                    // Y with umlaut
+                    (ch == 0x0178) ||
+                    // OE ligature
+                    (ch == 0x0152) ||
+                    // Eastern European
+                    // C with acute, R with acuate, L with stroke, R with charon, A with breve,
+                    // C with charon, A with ogonek, O with double accent
+                    (ch == 0x0106 || ch == 0x0154 || ch == 0x0141 || ch == 0x0158 || ch == 0x0102 ||
+                     ch == 0x010C || ch == 0x0104 || ch == 0x0150) ||
+                    // Russian
+                    (ch >= 0x0410 && ch <= 0x042F) || (ch == 0x0401));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_lower(const wchar_t ch) noexcept
+                {
+                return (
+                    // a-z
+                    (ch >= 0x61 && ch <= 0x7A) ||
+                    // a-z, full-width
+                    (ch >= 0xFF41 && ch <= 0xFF5A) ||
+                    // lowercase extended ASCII set
+                    (ch >= 0xE0 && ch <= 0xF6) || (ch >= 0xF8 && ch <= 0xFF) ||
+                    (ch == 0x0113) || // e with macron
+                    // OE ligature
+                    (ch == 0x0153) ||
+                    // superscript letters
+                    string_util::is_superscript_lowercase(ch) || // n
+                    // subscript letters
+                    (ch >= 0x2090 && ch <= 0x209C) ||
+                    // German eszett (not exactly lowercase, but words never begin with these)
+                    (ch == 0xDF) ||
+                    // Eastern European
+                    // C with acute, R with acuate, L with stroke, R with charon, A with breve,
+                    // C with charon, A with ogonek, O with double accent
+                    (ch == 0x0107 || ch == 0x0155 || ch == 0x0142 || ch == 0x0159 || ch == 0x0103 ||
+                     ch == 0x010D || ch == 0x0105 || ch == 0x0151) ||
+                    // Russian
+                    (ch >= 0x0430 && ch <= 0x044F) || (ch == 0x0451));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_alpha(const wchar_t ch) noexcept
+                {
+                return (is_upper(ch) || is_lower(ch));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_vowel(const wchar_t letter) noexcept
+                {
+                return ((letter == L'a') || (letter == L'e') || (letter == L'i') ||
+                        (letter == L'o') || (letter == L'u') || (letter == L'y') ||
+                        (letter == L'A') || (letter == L'E') || (letter == L'I') ||
+                        (letter == L'O') || (letter == L'U') || (letter == L'Y') ||
+                        (letter == 0x1D43) || // superscript a
+                        (letter == 0x1D49) || // superscript e
+                        (letter == 0x2071) || // superscript i
+                        (letter == 0x1D52) || // superscript o
+                        (letter == 0x1D58) || // superscript u
+                        (letter == 0x02B8) || // superscript y
+                        (letter == 0x2090) || // subscript a
+                        (letter == 0x2091) || // subscript e
+                        (letter == 0x2092) || // subscript o
+                        (letter == 0x2094) || // subscript upsidedown e
+                        // full-width a,e,i,o,u,y
+                        (letter == 0xFF21) || (letter == 0xFF25) || (letter == 0xFF29) ||
+                        (letter == 0xFF2F) || (letter == 0xFF35) || (letter == 0xFF39) ||
+                        (letter == 0xFF41) || (letter == 0xFF45) || (letter == 0xFF49) ||
+                        (letter == 0xFF4F) || (letter == 0xFF55) || (letter == 0xFF59) ||
+                        // Extended ASCII Western European letters
+                        (letter >= 0xC0 && letter <= 0xC6) || (letter >= 0xC8 && letter <= 0xCF) ||
+                        (letter >= 0xD2 && letter <= 0xD6) || (letter >= 0xD8 && letter <= 0xDC) ||
+                        (letter >= 0xE0 && letter <= 0xE6) || (letter >= 0xE8 && letter <= 0xEF) ||
+                        (letter >= 0xF2 && letter <= 0xF6) || (letter >= 0xF8 && letter <= 0xFC) ||
+                        (letter >= 0x152 && letter <= 0x153) || // OE ligature
+                        // e with macron
+                        (letter == 0x0112 || letter == 0x0113) ||
+                        // basic Russian alphabet
+                        is_either<wchar_t>(letter, 0x0401, 0x0451) ||
+                        is_either<wchar_t>(letter, 0x0410, 0x0430) ||
+                        is_either<wchar_t>(letter, 0x0415, 0x0435) ||
+                        is_either<wchar_t>(letter, 0x0418, 0x0438) ||
+                        is_either<wchar_t>(letter, 0x0419, 0x0439) ||
+                        is_either<wchar_t>(letter, 0x041E, 0x043E) ||
+                        is_either<wchar_t>(letter, 0x0423, 0x0443) ||
+                        is_either<wchar_t>(letter, 0x042B, 0x044B) ||
+                        is_either<wchar_t>(letter, 0x042D, 0x044D) ||
+                        is_either<wchar_t>(letter, 0x042E, 0x044E) ||
+                        is_either<wchar_t>(letter, 0x042F, 0x044F));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_consonant(const wchar_t letter) noexcept
+                {
+                return (
+                    (letter >= L'B' && letter <= L'D') || (letter >= L'F' && letter <= L'H') ||
+                    (letter >= L'J' && letter <= L'N') || (letter >= L'P' && letter <= L'T') ||
+                    // just treat 'y' as a vowel for the sake of argument
+                    (letter >= L'V' && letter <= L'X') || (letter == L'Z') ||
+                    (letter >= L'b' && letter <= L'd') || (letter >= L'f' && letter <= L'h') ||
+                    (letter >= L'j' && letter <= L'n') || (letter >= L'p' && letter <= L't') ||
+                    // just treat 'y' as a vowel for the sake of argument
+                    (letter >= L'v' && letter <= L'x') || (letter == L'z') ||
+                    // superscripts
+                    (letter == 0x1D47) || (letter == 0x1D9C) || (letter == 0x1D48) ||
+                    (letter == 0x1DA0) || (letter == 0x1D4D) || (letter == 0x02B0) ||
+                    (letter == 0x02B2) || (letter == 0x1D4F) || (letter == 0x02E1) ||
+                    (letter == 0x1D50) || (letter == 0x207F) || (letter == 0x1D56) ||
+                    (letter == 0x02B3) || (letter == 0x02E2) || (letter == 0x1D57) ||
+                    (letter == 0x1D5B) || (letter == 0x02B7) || (letter == 0x02E3) ||
+                    (letter == 0x1DBB) || (letter == 0x2093) || // subscript x
+                    (letter >= 0x2095 &&
+                     letter <= 0x209C) || // subscript h - t (not all those letters, though)
+                    // full-width letters
+                    (letter >= 0xFF22 && letter <= 0xFF24) ||
+                    (letter >= 0xFF26 && letter <= 0xFF28) ||
+                    (letter >= 0xFF2A && letter <= 0xFF2E) ||
+                    (letter >= 0xFF30 && letter <= 0xFF34) ||
+                    // just treat 'y' as a vowel for the sake of argument
+                    (letter >= 0xFF36 && letter <= 0xFF38) || (letter == 0xFF3A) ||
+                    (letter >= 0xFF42 && letter <= 0xFF44) ||
+                    (letter >= 0xFF46 && letter <= 0xFF48) ||
+                    (letter >= 0xFF4A && letter <= 0xFF4E) ||
+                    (letter >= 0xFF50 && letter <= 0xFF54) ||
+                    // just treat 'y' as a vowel for the sake of argument
+                    (letter >= 0xFF56 && letter <= 0xFF58) || (letter == 0xFF5A) ||
+                    // Extended ASCII Western European letters
+                    (letter == 0xC7) ||                   // upper C with cedilla
+                    (letter == 0xD0) ||                   // upper Eth
+                    (letter == 0xD1) ||                   // upper N with tilde
+                    (letter >= 0xDD && letter <= 0xDF) || // upper Y with acute to Eszett
+                    (letter == 0xE7) ||                   // lower C with cedilla
+                    (letter == 0xF0) ||                   // lower Eth
+                    (letter == 0xF1) ||                   // lower N with tilde
+                    (letter >= 0xFD && letter <= 0xFF) || // lower Y with acute to Y with umlauts
+                    (letter == 0x0178) ||
+                    // basic Russian alphabet
+                    (letter >= 0x0411 && letter <= 0x414) ||
+                    (letter >= 0x0416 && letter <= 0x417) ||
+                    (letter >= 0x041A && letter <= 0x041D) ||
+                    (letter >= 0x041F && letter <= 0x0422) ||
+                    (letter >= 0x0424 && letter <= 0x042A) ||
+                    is_either<wchar_t>(letter, 0x042C, 0x044C) ||
+                    (letter >= 0x0431 && letter <= 0x434) ||
+                    (letter >= 0x0436 && letter <= 0x437) ||
+                    (letter >= 0x043A && letter <= 0x043D) ||
+                    (letter >= 0x043F && letter <= 0x0442) ||
+                    (letter >= 0x0444 && letter <= 0x044A));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool can_character_begin_word(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
+                        true :
+                       is_either<wchar_t>(ch, 37, 0xFF05) ? // % (could be the entire word)
+                        true :
+                       is_either<wchar_t>(ch, 36, 0xFF04) ? // $
+                        true :
+                       is_either<wchar_t>(ch, L'&', 0xFF06) ?
+                        true :
+                       is_numeric_simple(ch) ?
+                        true :
+                       // don't allow words to start with super/subscripts or fractions
+                       (is_alpha(ch) && !string_util::is_superscript(ch) &&
+                        !string_util::is_subscript(ch)) ?
+                        true :
+                       // Doxygen tags (e.g., @note) or used as a whole word
+                       // (e.g., "meet @ 5:00")
+                       is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
+                       (ch == 0x9F) ? // Y with diaeresis
+                        true :
+                       is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
+                        true :
+                       is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
+                        true :
+                       (ch == 0x20B1) ? // Cuban peso
+                        true :
+                       (ch == 0x20A9) ? // Korean Won (currency)
+                        true :
+                       (ch == 177) ? // plus/minus±
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool can_character_begin_word_uppercase(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
+                        true :
+                       is_either<wchar_t>(ch, 36, 0xFF04) ? // $
+                        true :
+                       is_either<wchar_t>(ch, L'&', 0xFF06) ? true :
+                       is_numeric(ch)                       ? true :
+                       is_upper(ch)                         ? true :
+                       is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
+                       (ch == 0x9F) ? // Y with diaeresis
+                        true :
+                       is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
+                        true :
+                       is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
+                        true :
+                       (ch == 0x20B1) ? // Cuban peso
+                        true :
+                       (ch == 0x20A9) ? // Korean Won (currency)
+                        true :
+                       (ch == 177) ? // plus/minus
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool can_character_end_word(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
+                        true :
+                       is_either<wchar_t>(ch, 37, 0xFF05) ? // %
+                        true :
+                       is_either<wchar_t>(ch, L'&', 0xFF06) ? // &
+                        true :
+                       (ch == 46) ? // .
+                        true :
+                       is_either<wchar_t>(ch, 47, 0xFF0F) ? // '/'
+                        true :
+                       is_numeric(ch)    ? true :
+                       is_alpha(ch)      ? true :
+                       is_apostrophe(ch) ? true :
+                       // could be an entire word
+                       is_either<wchar_t>(ch, L'@', 0xFF20) ?
+                        true :
+                       is_either<wchar_t>(ch, 92, 0xFF3C) ? /*\*/
+                        true :
+                       (ch == 0x9F) ? // Y with diaeresis
+                        true :
+                       is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
+                        true :
+                       is_either<wchar_t>(ch, 176, 0xFFEE) ? // degree
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool can_character_end_numeral(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 37, 0xFF05) ? // %
+                        true :
+                       is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
+                        true :
+                       is_either<wchar_t>(ch, 176, 0xFFEE) ? // degree
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_word_character(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
+                        true :
+                       is_either<wchar_t>(ch, 37, 0xFF05) ? // %
+                        true :
+                       is_either<wchar_t>(ch, 38, 0xFF06) ? // &
+                        true :
+                       (ch == 46) ? // .
+                        true :
+                       is_either<wchar_t>(ch, 47, 0xFF0F) ? // /
+                        true :
+                       is_either<wchar_t>(ch, 58, 0xFF1A) ? // :
+                        true :
+                       is_numeric(ch)                       ? true :
+                       is_alpha(ch)                         ? true :
+                       is_hyphen(ch)                        ? true :
+                       is_apostrophe(ch)                    ? true :
+                       is_either<wchar_t>(ch, L'@', 0xFF20) ? true :
+                       is_either<wchar_t>(ch, 92, 0xFF3C) ? /*\*/
+                        true :
+                       (ch >= 0x5F && ch <= 0x60) ? // _`
+                        true :
+                       (ch >= 0xFF3F && ch <= 0xFF40) ? // full-width _`
+                        true :
+                       (ch == 126) ? // tilde (usually appear inside a file path)
+                        true :
+                       (ch == 159) ? // Y with diaeresis
+                        true :
+                       is_either<wchar_t>(ch, 162, 0xFFE0) ? // cent
+                        true :
+                       is_either<wchar_t>( ch, 176, 0xFFEE) ? // degree
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_dash(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 0x2012) ? // figure dash
+                        true :
+                       (ch == 0x2013) ? // en dash
+                        true :
+                       (ch == 0x2014) ? // em dash
+                        true :
+                       (ch == 0x2015) ? // horizontal bar
+                        true :
+                       (ch == 0x2E17) ? // Japanese double oblique hyphen
+                        true :
+                       (ch == 0x30A0) ? // Katakana-Hiragana double hyphen
+                        true :
+                       (ch == 0x301C) ? // Japanese wave dash
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_apostrophe(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 39) ? // '
+                        true :
+                       (ch == 146) ? // apostrophe
+                        true :
+                       (ch == 180) ? // apostrophe
+                        true :
+                       (ch == 0xFF07) ? // full-width apostrophe
+                        true :
+                       (ch == 0x2019) ? // right single apostrophe
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool can_character_prefix_numeral(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return is_either<wchar_t>(ch, 35, 0xFF03) ? // #
+                        true :
+                       is_either<wchar_t>(ch, 36, 0xFF04) ? // $
+                        true :
+                       (ch >= 43 && ch <= 46) ? //+,-.
+                        true :
+                       (ch >= 0xFF0B && ch <= 0xFF0E) ? // full-width +,-.
+                        true :
+                       is_either<wchar_t>(ch, 0x80, 0x20AC) ? // Euro
+                        true :
+                       is_either<wchar_t>(ch, 163, 0xFFE1) ? // Pound Sterling
+                        true :
+                       (ch == 165) ? // Yen
+                        true :
+                       (ch == 177) ? // plus/minus
+                        true :
+                       (ch == 0x20B1) ? // Cuban peso
+                        true :
+                       (ch == 0x20A9) ? // Korean Won (currency)
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_quote(const wchar_t ch) noexcept
+                {
+                return (is_single_quote(ch) || is_double_quote(ch));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_single_quote(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 39) ? // '
+                        true :
+                       (ch == 0xFF07) ? // full-width apostrophe
+                        true :
+                       (ch == 96) ? // `
+                        true :
+                       (ch == 130 || ch == 0x201A) ? // ‚ curved single quote
+                        true :
+                       (ch == 139 || ch == 0x2039) ? // ‹ left single quote (European)
+                        true :
+                       (ch == 155 || ch == 0x203A) ? // › right single quote (European)
+                        true :
+                       (ch == 145 || ch == 146) ? // Windows 1252 quote surrogates (single)
+                        true :
+                       (ch >= 0x2018 && ch <= 0x201B) ? // smart single quotes
+                        true :
+                       (ch == 0x300C || ch == 0x300D) ? // Japanese single quotes
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_double_quote(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 34) ? // " straight double quote
+                        true :
+                       (ch == 132) ? // „ curved double quote
+                        true :
+                       (ch == 171 || ch == 187) ? // «» left/right double quote (European)
+                        true :
+                       (ch >= 147 && ch <= 148) ? // Windows 1252 quote surrogates (double)
+                        true :
+                       (ch >= 0x201C && ch <= 0x201F) ? // smart double quotes
+                        true :
+                       (ch == 0x300E || ch == 0x300F) ? // Japanese double quotes
+                        true :
+                        false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_numeric(const wchar_t ch) noexcept
+                {
+                return is_numeric_simple(ch) ?
+                           // superscripts and fractions
+                           true :
+                           is_extended_numeric(ch) ? true : false;
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_extended_numeric(const wchar_t ch) noexcept
+                {
+                return (string_util::is_fraction(ch) || string_util::is_superscript_number(ch) ||
+                        string_util::is_subscript_number(ch)) ?
+                           true :
+                           false;
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_space(const wchar_t ch) noexcept
+                {
+                return (is_space_vertical(ch) || is_space_horizontal(ch));
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_space_horizontal(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 0x20) ? // regular space
+                        true :
+                       (ch == 0x09) ? // tab
+                        true :
+                       (ch == 0xA0 || ch == 0x202F) ? // no-break space, narrow
+                        true :
+                       (ch == 0x3000) ? // Japanese Ideographic Space
+                                        // En quad, thin space, hair space, em space,
+                                        // zero-width non-joiner (word separator), etc.
+                        true :
+                       (ch >= 0x2000 && ch <= 0x200C) ? true : false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_space_horizontal_except_tab(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 0x20) ? // regular space
+                        true :
+                       (ch == 0xA0 || ch == 0x202F) ? // no-break space, narrow
+                        true :
+                       (ch == 0x3000) ? // Japanese Ideographic Space
+                                        // En quad, thin space, hair space, em space,
+                                        // zero-width non-joiner (word separator), etc.
+                        true :
+                       (ch >= 0x2000 && ch <= 0x200C) ? true : false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_space_vertical(const wchar_t ch) noexcept
+                {
+                // clang-format off
+                return (ch == 0x0D) ? true :
+                       (ch == 0x0A) ? true :
+                       (ch == 0x0C) ? // form feed
+                        true :
+                       (ch == 0x2028) ? // line separator
+                        true :
+                       (ch == 0x2029) ? // paragraph separator
+                       true :
+                       false;
+                // clang-format on
+                }
+
+            /// @private
+            [[nodiscard]]
+            constexpr static bool is_punctuation(const wchar_t ch) noexcept
+                {
+                // see if it is either a space, control character, or alphanumeric and negate that
+                return !(is_numeric(ch) || is_alpha(ch) || is_space(ch) ||
+                         // control characters
+                         ((ch >= 0x00) && (ch <= 0x20)));
+                }
+            };
+
+      private:
+        /// @brief Two-level lookup table of the properties of every character in the
+        ///     Basic Multilingual Plane.
+        /// @details The high byte of a character selects a block of 256 entries
+        ///     (identical blocks are shared, so only about a dozen 1KB blocks are needed),
+        ///     and the low byte selects the character's entry in that block.
+        class property_table
+            {
+          public:
+            property_table()
+                {
+                m_blocks.reserve(32);
+                std::array<uint32_t, BLOCK_SIZE> block{};
+                for (size_t blockIndex = 0; blockIndex < BLOCK_COUNT; ++blockIndex)
+                    {
+                    for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                        {
+                        block[i] = calculate_properties(
+                            static_cast<wchar_t>((blockIndex * BLOCK_SIZE) + i));
+                        }
+                    const auto existingBlock = std::find(m_blocks.cbegin(), m_blocks.cend(), block);
+                    if (existingBlock != m_blocks.cend())
+                        {
+                        m_block_index[blockIndex] =
+                            static_cast<uint8_t>(std::distance(m_blocks.cbegin(), existingBlock));
+                        }
+                    else
+                        {
+                        assert(m_blocks.size() < 256 && "Too many unique character blocks!");
+                        m_block_index[blockIndex] = static_cast<uint8_t>(m_blocks.size());
+                        m_blocks.push_back(block);
+                        }
+                    }
+                }
+
+            /// @returns The properties of a character (must be in the BMP).
+            /// @param ch The character.
+            [[nodiscard]]
+            uint32_t get(const wchar_t ch) const noexcept
+                {
+                const auto index = static_cast<size_t>(ch);
+                return m_blocks[m_block_index[index >> 8]][index & 0xFF];
+                }
+
+          private:
+            constexpr static size_t BLOCK_SIZE{ 256 };
+            constexpr static size_t BLOCK_COUNT{ 256 };
+            std::array<uint8_t, BLOCK_COUNT> m_block_index{};
+            std::vector<std::array<uint32_t, BLOCK_SIZE>> m_blocks;
+            };
+
+        /// @returns The lookup table, which is built the first time that it is needed.
+        [[nodiscard]]
+        static const property_table& get_property_table()
+            {
+            static const property_table table;
+            return table;
+            }
+
+        /// @returns @c true if a character is in the lookup table (i.e., is in the BMP).
+        [[nodiscard]]
+        constexpr static bool is_in_table(const wchar_t ch) noexcept
+            {
+            if constexpr (sizeof(wchar_t) > 2)
+                {
+                return (static_cast<std::make_unsigned_t<wchar_t>>(ch) <= 0xFFFF);
+                }
+            else
+                {
+                return true;
+                }
+            }
+
+        /// @returns @c true if a character has a property, using the lookup table if possible.
+        /// @param ch The character to review.
+        /// @param prop The property to check for.
+        /// @param referenceCheck The reference definition of the property, which is used in
+        ///     constant expressions and for characters that aren't in the table.
+        [[nodiscard]]
+        constexpr static bool has_property(const wchar_t ch, const property prop,
+                                           bool (*referenceCheck)(const wchar_t) noexcept) noexcept
+            {
+            if (std::is_constant_evaluated() || !is_in_table(ch))
+                {
+                return referenceCheck(ch);
+                }
+            return ((get_property_table().get(ch) & prop) != 0);
+            }
+
+        /// @returns The properties of a character, calculated from the reference definitions.
+        /// @param ch The character to review.
+        [[nodiscard]]
+        constexpr static uint32_t calculate_properties(const wchar_t ch) noexcept
+            {
+            uint32_t props{ 0 };
+            const auto setIf = [&props](const bool hasProperty, const property prop)
+            {
+                if (hasProperty)
+                    {
+                    props |= prop;
+                    }
+            };
+            setIf(reference::is_upper(ch), property::upper);
+            setIf(reference::is_lower(ch), property::lower);
+            setIf(reference::is_alpha(ch), property::alpha);
+            setIf(reference::is_vowel(ch), property::vowel);
+            setIf(reference::is_consonant(ch), property::consonant);
+            setIf(reference::can_character_begin_word(ch), property::begin_word);
+            setIf(reference::can_character_begin_word_uppercase(ch),
+                  property::begin_word_uppercase);
+            setIf(reference::can_character_end_word(ch), property::end_word);
+            setIf(reference::can_character_end_numeral(ch), property::end_numeral);
+            setIf(reference::is_word_character(ch), property::word_character);
+            setIf(reference::is_dash(ch), property::dash);
+            setIf(reference::is_apostrophe(ch), property::apostrophe);
+            setIf(reference::can_character_prefix_numeral(ch), property::prefix_numeral);
+            setIf(reference::is_quote(ch), property::quote);
+            setIf(reference::is_single_quote(ch), property::single_quote);
+            setIf(reference::is_double_quote(ch), property::double_quote);
+            setIf(reference::is_numeric(ch), property::numeric);
+            setIf(reference::is_extended_numeric(ch), property::extended_numeric);
+            setIf(reference::is_space(ch), property::space);
+            setIf(reference::is_space_horizontal(ch), property::space_horizontal);
+            setIf(reference::is_space_horizontal_except_tab(ch),
+                  property::space_horizontal_except_tab);
+            setIf(reference::is_space_vertical(ch), property::space_vertical);
+            setIf(reference::is_punctuation(ch), property::punctuation);
+            return props;
             }
         };
     } // namespace characters
@@ -14,11 +14,7 @@
 #ifndef __CONJUNCTION_H__
 #define __CONJUNCTION_H__
 
-#include "../Wisteria-Dataviz/src/util/string_util.h"
-#include "character_traits.h"
-#include <algorithm>
-#include <functional>
-#include <set>
+#include "perfect_hash_set.h"
 #include <string_view>
 
 namespace grammar
@@ -34,10 +30,6 @@ namespace grammar
             @param text The word to review.
             @returns Whether or not this word is a coordinating conjunction.*/
         virtual bool operator()(const std::wstring_view text) const = 0;
-
-      protected:
-        /// @private
-        using string_type = std::basic_string_view<wchar_t, traits::case_insensitive_ex>;
         };
 
     /** @brief Predicate for determining if a word is an
@@ -52,16 +44,12 @@ namespace grammar
         bool
         operator()(const std::wstring_view text) const final
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            return m_conjunctions.find(string_type(text.data(), text.length())) !=
-                   m_conjunctions.cend();
+            return m_conjunctions.contains(text);
             }
 
       private:
-        static const std::set<string_type> m_conjunctions;
+        static constexpr perfect_hash_set m_conjunctions{ {
+            L"&", L"and", L"but", L"nor", L"or", L"so", L"yet" } };
         };
 
     /** Predicate for determining if a word is a Spanish coordinating
@@ -76,16 +64,20 @@ namespace grammar
         bool
         operator()(const std::wstring_view text) const final
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            return m_conjunctions.find(string_type(text.data(), text.length())) !=
-                   m_conjunctions.cend();
+            return m_conjunctions.contains(text);
             }
 
       private:
-        static const std::set<string_type> m_conjunctions;
+        static constexpr perfect_hash_set m_conjunctions{ {
+            L"&",
+            L"e",    // and
+            L"ni",   // nor
+            L"o",    // or
+            L"pero", // but
+            L"sino", // but
+            L"u",    // or
+            L"y"     // and
+        } };
         };
 
     /** @brief Predicate for determining if a word is a German coordinating
@@ -100,22 +92,23 @@ namespace grammar
         bool
         operator()(const std::wstring_view text) const final
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            return m_conjunctions.find(string_type(text.data(), text.length())) !=
-                   m_conjunctions.cend();
+            return m_conjunctions.contains(text);
             }
 
       private:
-        static const std::set<string_type> m_conjunctions;
+        static constexpr perfect_hash_set m_conjunctions{ {
+            L"&",
+            L"und",     // and
+            L"oder",    // or
+            L"denn",    // for, because
+            L"aber",    // but
+            L"sondern", // but (instead)
+        } };
         };
 
     /// @brief Predicate for determining if a word is a Russian coordinating
     ///     conjunction (case insensitive).
     /// @todo add '&'
-    /// @todo make this a binary searchable set
     class is_russian_coordinating_conjunction final : public is_coordinating_conjunction
         {
       public:
@@ -127,44 +120,20 @@ namespace grammar
         bool
         operator()(const std::wstring_view text) const noexcept final
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            // coordinating conjunctions
-            return (text.length() == 1 &&
-                    // i (and/both...and)
-                    string_util::is_either<wchar_t>(text[0], 0x0418, 0x0438)) ||
-                   // a (but)
-                   (text.length() == 1 &&
-                    string_util::is_either<wchar_t>(text[0], 0x0410, 0x0430)) ||
-                   (text.length() == 2 &&
-                    string_util::is_either<wchar_t>(text[0], 0x041D, 0x043D) &&
-                    // ni (neither...nor)
-                    string_util::is_either<wchar_t>(text[1], 0x0418, 0x0438)) ||
-                   (text.length() == 2 &&
-                    string_util::is_either<wchar_t>(text[0], 0x041D, 0x043D) &&
-                    // no (but)
-                    string_util::is_either<wchar_t>(text[1], 0x041E, 0x043E)) ||
-                   (text.length() == 2 &&
-                    string_util::is_either<wchar_t>(text[0], 0x0414, 0x0434) &&
-                    // da (and)
-                    string_util::is_either<wchar_t>(text[1], 0x0410, 0x0430)) ||
-                   (text.length() == 2 &&
-                    string_util::is_either<wchar_t>(text[0], 0x0422, 0x0442) &&
-                    // to (first...then)
-                    string_util::is_either<wchar_t>(text[1], 0x041E, 0x043E)) ||
-                   (text.length() == 3 &&
-                    string_util::is_either<wchar_t>(text[0], 0x041A, 0x043A) &&
-                    string_util::is_either<wchar_t>(text[1], 0x0422, 0x0442) &&
-                    // kto (some...other)
-                    string_util::is_either<wchar_t>(text[2], 0x041E, 0x043E)) ||
-                   (text.length() == 3 &&
-                    string_util::is_either<wchar_t>(text[0], 0x0418, 0x0438) &&
-                    string_util::is_either<wchar_t>(text[1], 0x041B, 0x043B) &&
-                    // ili (either...or)
-                    string_util::is_either<wchar_t>(text[2], 0x0418, 0x0438));
+            return m_conjunctions.contains(text);
             }
+
+      private:
+        static constexpr perfect_hash_set m_conjunctions{ {
+            L"\u0438",             // i (and/both...and)
+            L"\u0430",             // a (but)
+            L"\u043D\u0438",       // ni (neither...nor)
+            L"\u043D\u043E",       // no (but)
+            L"\u0434\u0430",       // da (and)
+            L"\u0442\u043E",       // to (first...then)
+            L"\u043A\u0442\u043E", // kto (some...other)
+            L"\u0438\u043B\u0438"  // ili (either...or)
+        } };
         };
     } // namespace grammar
 
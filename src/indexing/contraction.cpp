@@ -13,31 +13,6 @@
 
 #include "contraction.h"
 
-// Words that end with "'s" that are NOT possessive, they are contractions of "is" or "has".
-const std::set<grammar::is_contraction::string_type> grammar::is_contraction::m_s_contractions = {
-    L"anything's", L"everything's", L"it's",        L"he's",    L"here's",  L"how's",
-    L"let's",      L"she's",        L"something's", L"that's",  L"there's", L"this's",
-    L"what's",     L"when's",       L"where's",     L"which's", L"who's",   L"why's"
-};
-
-// Words following an "'s" that indicate that it may be a contraction
-// of "is" or "has". These are used when the word connected to the "'s"
-// is unknown and can be ambiguous as a possessive  word. For example:
-// "Frank's got a new car. Frank's a happy man. Frank's car is nice."
-// The first two "Frank's" are contractions, the last one is a possessive  noun.
-const std::set<grammar::is_contraction::string_type>
-    grammar::is_contraction::m_s_contractions_following_word = {
-    L"a", L"an", L"got", L"the"
-};
-
-// Contractions that would start with an apostrophe (that parser may not be including).
-const std::set<grammar::is_contraction::string_type>
-    grammar::is_contraction::m_contraction_without_apostrophe = {
-    L"tis", L"twas", L"twere", L"twould", L"twill",
-    // Contractions of two words without an apostrophe (e.g., going to -> gonna).
-    L"gonna", L"wanna", L"kinda", L"shoulda", L"woulda", L"coulda", L"dunno", L"gimme", L"gotta"
-};
-
 //--------------------------------------------------------
 bool grammar::is_contraction::operator()(
     const std::wstring_view text,
@@ -56,17 +31,14 @@ bool grammar::is_contraction::operator()(
                 {
                 // If something like "that's", then we know it is "that is"
                 // and indeed a contraction.
-                if (m_s_contractions.find(string_type{ text.data(), text.length() }) !=
-                    m_s_contractions.cend())
+                if (m_s_contractions.contains(text))
                     {
                     return true;
                     }
                 // ...otherwise, it might be a possessive word; review it.
                 if (nextWord.length() > 0)
                     {
-                    return m_s_contractions_following_word.find(
-                                string_type{ nextWord.data(), nextWord.length() }) !=
-                            m_s_contractions_following_word.cend();
+                    return m_s_contractions_following_word.contains(nextWord);
                     }
                 return false;
                 }
@@ -75,10 +47,5 @@ bool grammar::is_contraction::operator()(
             }
         }
     // "it [word]" being contracted to "t[word]"
-    if (m_contraction_without_apostrophe.find(string_type{ text.data(), text.length() }) !=
-        m_contraction_without_apostrophe.cend())
-        {
-        return true;
-        }
-    return false;
+    return m_contraction_without_apostrophe.contains(text);
     }
@@ -163,6 +163,13 @@ namespace grammar
             return m_syllable_count;
             }
 
+        /// @returns A new German syllabizer.
+        [[nodiscard]]
+        std::unique_ptr<base_syllabize> clone() const final
+            {
+            return std::make_unique<german_syllabize>();
+            }
+
       protected:
         /** @brief Sees if a word begins with a "ge" prefix which should always end as a syllable
            division.
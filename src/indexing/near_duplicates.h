@@ -0,0 +1,402 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __NEAR_DUPLICATES_H__
+#define __NEAR_DUPLICATES_H__
+
+#include "character_traits.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/** @brief A MinHash fingerprint of a document's words.
+    @details The document is viewed as the set of its shingles (runs of
+        @c SHINGLE_SIZE consecutive words, compared case insensitively).
+        For each of @c SIGNATURE_SIZE hash functions, the signature keeps the smallest hash
+        of any shingle. The fraction of positions where two signatures agree estimates
+        the Jaccard similarity of the two documents' shingle sets.\n
+        Signatures are small and fixed in size, so they can be kept after a document's
+        words have been freed.
+    @code
+        minhash_signature sig;
+        sig.add_words(doc.get_words().cbegin(), doc.get_words().cend());
+        // later...
+        if (sig.estimate_similarity(otherSig) >= 0.9)
+            { ... }
+    @endcode*/
+class minhash_signature
+    {
+  public:
+    /// @brief The number of hash functions (values) in a signature.
+    constexpr static size_t SIGNATURE_SIZE{ 128 };
+    /// @brief The number of consecutive words that make up a shingle.
+    constexpr static size_t SHINGLE_SIZE{ 3 };
+
+    /** @brief Adds a document's words to the signature.
+        @details If there are fewer words than a shingle's length, then the words
+            are treated as a single shingle.
+        @param begin The start of the words.
+        @param end The end of the words.
+        @tparam word_iterator An iterator to a string type providing @c c_str() and
+            @c length() (e.g., the words from a @c document).
+        @note This should only be called once per document, as shingles are not
+            formed across calls.*/
+    template<typename word_iterator>
+    void add_words(word_iterator begin, const word_iterator end)
+        {
+        if (begin == end)
+            {
+            return;
+            }
+        std::array<uint64_t, SHINGLE_SIZE> window{};
+        size_t wordsInWindow{ 0 };
+        for (/* nothing*/; begin != end; ++begin)
+            {
+            // slide the window of word hashes over
+            std::shift_left(window.begin(), window.end(), 1);
+            window.back() = hash_word({ begin->c_str(), begin->length() });
+            if (++wordsInWindow >= SHINGLE_SIZE)
+                {
+                add_shingle(window.cbegin(), window.cend());
+                }
+            }
+        if (wordsInWindow < SHINGLE_SIZE)
+            {
+            add_shingle(window.cend() - wordsInWindow, window.cend());
+            }
+        }
+
+    /// @returns @c true if no words have been added.
+    [[nodiscard]]
+    bool empty() const noexcept
+        {
+        return m_shingleCount == 0;
+        }
+
+    /// @returns The number of shingles (not necessarily unique) that were added.
+    [[nodiscard]]
+    size_t get_shingle_count() const noexcept
+        {
+        return m_shingleCount;
+        }
+
+    /// @returns The signature's values.
+    [[nodiscard]]
+    const std::array<uint64_t, SIGNATURE_SIZE>& get_values() const noexcept
+        {
+        return m_values;
+        }
+
+    /** @returns The estimated Jaccard similarity (0-1) between this and another document.
+        @param that The other document's signature.
+        @note Empty signatures are never similar to anything.*/
+    [[nodiscard]]
+    double estimate_similarity(const minhash_signature& that) const noexcept
+        {
+        if (empty() || that.empty())
+            {
+            return 0;
+            }
+        size_t matches{ 0 };
+        for (size_t i = 0; i < SIGNATURE_SIZE; ++i)
+            {
+            if (m_values[i] == that.m_values[i])
+                {
+                ++matches;
+                }
+            }
+        return static_cast<double>(matches) / SIGNATURE_SIZE;
+        }
+
+  private:
+    /// @returns The (FNV-1a) hash of a word, folded to lowercase.
+    [[nodiscard]]
+    static uint64_t hash_word(const std::wstring_view word) noexcept
+        {
+        uint64_t result{ 14'695'981'039'346'656'037ULL };
+        for (const auto ch : word)
+            {
+            result ^= static_cast<uint64_t>(traits::case_insensitive_ex::tolower(ch));
+            result *= 1'099'511'628'211ULL;
+            }
+        return result;
+        }
+
+    /// @returns A 64-bit finalizer (from SplitMix64), used to derive the hash functions.
+    [[nodiscard]]
+    constexpr static uint64_t mix(uint64_t value) noexcept
+        {
+        value ^= value >> 30;
+        value *= 0xBF58'476D'1CE4'E5B9ULL;
+        value ^= value >> 27;
+        value *= 0x94D0'49BB'1331'11EBULL;
+        value ^= value >> 31;
+        return value;
+        }
+
+    template<typename hash_iterator>
+    void add_shingle(hash_iterator begin, const hash_iterator end) noexcept
+        {
+        uint64_t shingleHash{ 0 };
+        for (/* nothing*/; begin != end; ++begin)
+            {
+            shingleHash = mix(shingleHash ^ *begin);
+            }
+        // each hash function is a different seed mixed into the shingle's hash
+        for (size_t i = 0; i < SIGNATURE_SIZE; ++i)
+            {
+            m_values[i] =
+                std::min(m_values[i], mix(shingleHash + (i + 1) * 0x9E37'79B9'7F4A'7C15ULL));
+            }
+        ++m_shingleCount;
+        }
+
+    /// @returns The values of a signature without any shingles.
+    [[nodiscard]]
+    constexpr static std::array<uint64_t, SIGNATURE_SIZE> make_empty_values() noexcept
+        {
+        std::array<uint64_t, SIGNATURE_SIZE> values{};
+        values.fill(std::numeric_limits<uint64_t>::max());
+        return values;
+        }
+
+    std::array<uint64_t, SIGNATURE_SIZE> m_values{ make_empty_values() };
+    size_t m_shingleCount{ 0 };
+    };
+
+/** @brief Finds near-duplicate documents from their MinHash signatures.
+    @details Uses locality-sensitive hashing: each signature is split into @c BAND_COUNT
+        bands, and documents that have an identical band are candidates for being
+        near duplicates. Only candidates have their signatures compared, so finding
+        the near duplicates of a collection takes roughly linear time (rather than
+        comparing every pair of documents).\n
+        With 16 bands of 8 values, documents that are 90% similar become candidates
+        with a probability of over 99.9%, while documents that are less than 50% similar
+        rarely do.
+    @code
+        near_duplicate_index index;
+        for (size_t i = 0; i < signatures.size(); ++i)
+            {
+            index.add(i, signatures[i]);
+            }
+        // each cluster is a list of the IDs of similar documents
+        const auto clusters = index.find_clusters(0.9);
+    @endcode*/
+class near_duplicate_index
+    {
+  public:
+    /// @brief The number of bands that signatures are split into.
+    constexpr static size_t BAND_COUNT{ 16 };
+    /// @brief The number of signature values in each band.
+    constexpr static size_t ROWS_PER_BAND{ minhash_signature::SIGNATURE_SIZE / BAND_COUNT };
+    static_assert(BAND_COUNT * ROWS_PER_BAND == minhash_signature::SIGNATURE_SIZE,
+                  "Signature must split evenly into bands.");
+
+    /** @brief A document that is similar to a queried one.*/
+    struct match
+        {
+        /// @brief The ID of the indexed document.
+        size_t m_id{ 0 };
+        /// @brief The estimated similarity (0-1) to the queried document.
+        double m_similarity{ 0 };
+        };
+
+    /** @brief Adds a document to the index.
+        @param id The caller's ID for the document (e.g., its position in a list).
+        @param signature The document's signature.
+        @note Empty signatures are ignored.*/
+    void add(const size_t id, const minhash_signature& signature)
+        {
+        if (signature.empty())
+            {
+            return;
+            }
+        const size_t entry = m_entries.size();
+        m_entries.push_back({ id, signature });
+        for (size_t band = 0; band < BAND_COUNT; ++band)
+            {
+            m_buckets[band][hash_band(signature, band)].push_back(entry);
+            }
+        }
+
+    /** @returns The most similar indexed document that is at least @c threshold similar to
+            the signature, or @c std::nullopt if there isn't one.
+        @param signature The signature of the document to look up.
+        @param threshold The minimum (estimated) similarity, from 0-1.*/
+    [[nodiscard]]
+    std::optional<match> find_most_similar(const minhash_signature& signature,
+                                           const double threshold) const
+        {
+        std::optional<match> best;
+        for (const auto entry : get_candidates(signature))
+            {
+            const double similarity = signature.estimate_similarity(m_entries[entry].m_signature);
+            if (similarity >= threshold && (!best || similarity > best->m_similarity))
+                {
+                best = match{ m_entries[entry].m_id, similarity };
+                }
+            }
+        return best;
+        }
+
+    /** @returns The groups of indexed documents that are near duplicates of each other.
+        @details Documents are grouped transitively (if A is similar to B and B to C,
+            then all three are in the same group).\n
+            IDs are sorted within each group (in the order that they were added), and groups
+            are sorted by their first ID. Documents without any near duplicates are not
+            included.
+        @param threshold The minimum (estimated) similarity, from 0-1.*/
+    [[nodiscard]]
+    std::vector<std::vector<size_t>> find_clusters(const double threshold) const
+        {
+        std::vector<size_t> parents(m_entries.size());
+        std::iota(parents.begin(), parents.end(), 0);
+        const auto findRoot = [&parents](size_t entry) noexcept
+        {
+            while (parents[entry] != entry)
+                {
+                parents[entry] = parents[parents[entry]];
+                entry = parents[entry];
+                }
+            return entry;
+        };
+
+        std::vector<size_t> representatives;
+        for (const auto& bandBuckets : m_buckets)
+            {
+            for (const auto& [bandHash, entries] : bandBuckets)
+                {
+                // Compare each entry against one member of each group already found in
+                // this bucket (rather than every entry before it), so that a large number
+                // of identical documents doesn't take quadratic time.
+                representatives.clear();
+                for (const auto entry : entries)
+                    {
+                    for (const auto representative : representatives)
+                        {
+                        const size_t root = findRoot(entry);
+                        const size_t otherRoot = findRoot(representative);
+                        if (root != otherRoot &&
+                            m_entries[entry].m_signature.estimate_similarity(
+                                m_entries[representative].m_signature) >= threshold)
+                            {
+                            parents[std::max(root, otherRoot)] = std::min(root, otherRoot);
+                            }
+                        }
+                    const size_t root = findRoot(entry);
+                    if (std::none_of(representatives.cbegin(), representatives.cend(),
+                                     [&findRoot, root](const auto representative)
+                                     { return findRoot(representative) == root; }))
+                        {
+                        representatives.push_back(entry);
+                        }
+                    }
+                }
+            }
+
+        std::unordered_map<size_t, std::vector<size_t>> groups;
+        for (size_t i = 0; i < m_entries.size(); ++i)
+            {
+            groups[findRoot(i)].push_back(i);
+            }
+        std::vector<std::vector<size_t>> clusters;
+        for (auto& [root, entries] : groups)
+            {
+            if (entries.size() > 1)
+                {
+                std::vector<size_t> ids;
+                ids.reserve(entries.size());
+                std::sort(entries.begin(), entries.end());
+                for (const auto entry : entries)
+                    {
+                    ids.push_back(m_entries[entry].m_id);
+                    }
+                clusters.push_back(std::move(ids));
+                }
+            }
+        std::sort(clusters.begin(), clusters.end(),
+                  [](const auto& lhv, const auto& rhv) noexcept
+                  { return lhv.front() < rhv.front(); });
+        return clusters;
+        }
+
+    /// @returns The number of documents in the index.
+    [[nodiscard]]
+    size_t size() const noexcept
+        {
+        return m_entries.size();
+        }
+
+    /// @brief Removes all documents from the index.
+    void clear() noexcept
+        {
+        m_entries.clear();
+        for (auto& bandBuckets : m_buckets)
+            {
+            bandBuckets.clear();
+            }
+        }
+
+  private:
+    struct entry
+        {
+        size_t m_id{ 0 };
+        minhash_signature m_signature;
+        };
+
+    /// @returns The hash of one band of a signature.
+    [[nodiscard]]
+    static uint64_t hash_band(const minhash_signature& signature, const size_t band) noexcept
+        {
+        uint64_t result{ 14'695'981'039'346'656'037ULL };
+        for (size_t i = band * ROWS_PER_BAND; i < (band + 1) * ROWS_PER_BAND; ++i)
+            {
+            result = (result ^ signature.get_values()[i]) * 1'099'511'628'211ULL;
+            }
+        return result;
+        }
+
+    /// @returns The (unique) indexed entries sharing at least one band with the signature.
+    [[nodiscard]]
+    std::vector<size_t> get_candidates(const minhash_signature& signature) const
+        {
+        std::vector<size_t> candidates;
+        if (signature.empty())
+            {
+            return candidates;
+            }
+        for (size_t band = 0; band < BAND_COUNT; ++band)
+            {
+            const auto bucket = m_buckets[band].find(hash_band(signature, band));
+            if (bucket != m_buckets[band].cend())
+                {
+                candidates.insert(candidates.end(), bucket->second.cbegin(),
+                                  bucket->second.cend());
+                }
+            }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        return candidates;
+        }
+
+    std::vector<entry> m_entries;
+    std::array<std::unordered_map<uint64_t, std::vector<size_t>>, BAND_COUNT> m_buckets;
+    };
+
+#endif //__NEAR_DUPLICATES_H__
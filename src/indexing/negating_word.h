@@ -14,10 +14,7 @@
 #ifndef __NEGATING_WORD_H__
 #define __NEGATING_WORD_H__
 
-#include "character_traits.h"
-#include <algorithm>
-#include <functional>
-#include <set>
+#include "perfect_hash_set.h"
 #include <string_view>
 
 namespace grammar
@@ -33,16 +30,18 @@ namespace grammar
         bool
         operator()(std::wstring_view text) const
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            return m_words.find(string_type{ text.data(), text.length() }) != m_words.cend();
+            return m_words.contains(text);
             }
 
       private:
-        using string_type = std::basic_string_view<wchar_t, traits::case_insensitive_ex>;
-        static const std::set<string_type> m_words;
+        static constexpr perfect_hash_set m_words{ {
+            L"ain't", L"aren't", L"can't", L"cannot", L"couldn't", L"didn't", L"doesn't", L"don't",
+            L"hadn't", L"hasn't", L"haven't", L"isn't", L"mustn't", L"never", L"no", L"non", L"not",
+            L"nowhere", L"shan't", L"wasn't", L"weren't", L"won't", L"wouldn't",
+            // for writers with an aversion to proper punctuation *eye-roll*
+            L"aint", L"arent", L"cant", L"couldnt", L"didnt", L"doesnt", L"dont", L"hadnt",
+            L"hasnt", L"havent", L"isnt", L"mustnt", L"shant", L"wasnt", L"werent", L"wont",
+            L"wouldnt" } };
         };
     } // namespace grammar
 
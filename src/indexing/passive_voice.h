@@ -15,10 +15,8 @@
 #define __PASSIVE_VOICE_H__
 
 #include "character_traits.h"
+#include "perfect_hash_set.h"
 #include "word_list.h"
-#include <algorithm>
-#include <functional>
-#include <set>
 #include <string_view>
 
 namespace grammar
@@ -27,9 +25,6 @@ namespace grammar
     class is_english_passive_voice
         {
       public:
-        /// @private
-        using string_type = std::basic_string_view<wchar_t, traits::case_insensitive_ex>;
-
         /** @brief Determines if a word combination is passive voice.
             @param words The list of words
                 ("to be" verb and any past participles and what not after it).
@@ -50,8 +45,7 @@ namespace grammar
                 return false;
                 }
             // see is the verb is a "to be" verb
-            if (m_to_be_verbs.find(string_type{ words[0].c_str(), words[0].length() }) ==
-                m_to_be_verbs.cend())
+            if (!m_to_be_verbs.contains({ words[0].c_str(), words[0].length() }))
                 {
                 return false;
                 }
@@ -132,7 +126,9 @@ namespace grammar
                      traits::case_insensitive_ex::eq(word[word.length() - 1], L'n')));
             }
 
-        static std::set<string_type> m_to_be_verbs;
+        static constexpr perfect_hash_set m_to_be_verbs{ {
+            L"am", L"are", L"aren't", L"be", L"been", L"being", L"is", L"isn't", L"was",
+            L"wasn't", L"were", L"weren't" } };
         static word_list m_past_participle_exeptions;
         };
     } // namespace grammar
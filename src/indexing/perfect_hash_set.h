@@ -0,0 +1,166 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __PERFECT_HASH_SET_H__
+#define __PERFECT_HASH_SET_H__
+
+#include "character_traits.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace grammar
+    {
+    /** @brief A fixed set of words, hashed (case insensitively) into a collision-free table
+            when it is compiled.
+        @details This is meant for the small, closed word lists that the grammar functors
+            check every token against (e.g., the "to be" verbs). A lookup is a single pass
+            over the word to hash it and a comparison against at most one entry;
+            there are no tree walks or allocations.\n
+            Words are compared the same way that traits::case_insensitive_ex compares them:
+            case insensitively, with full-width characters matching their narrow versions
+            and all apostrophes being equal.
+        @tparam N The number of words in the set.
+        @code
+            static constexpr perfect_hash_set words{ { L"am", L"are", L"is" } };
+            const bool isToBe = words.contains(L"IS");
+        @endcode*/
+    template<size_t N>
+    class perfect_hash_set
+        {
+        static_assert(N > 0, "A perfect hash set must contain at least one word.");
+
+      public:
+        /** @brief Builds the table from a list of words.
+            @param words The words in the set. These must be unique (case insensitively)
+                and not empty.
+            @note This can only be called in a constant expression, so bad input
+                (or a set that cannot be hashed) fails the build.*/
+        consteval explicit perfect_hash_set(const std::wstring_view (&words)[N])
+            {
+            std::array<uint32_t, N> wordHashes{};
+            for (size_t i = 0; i < N; ++i)
+                {
+                if (words[i].empty())
+                    {
+                    throw std::invalid_argument("Empty word in perfect hash set.");
+                    }
+                wordHashes[i] = hash(words[i]);
+                }
+
+            // search for a seed that maps every word to its own slot
+            for (uint32_t seed = 0; seed < MAX_SEED_SEARCH; ++seed)
+                {
+                std::array<bool, TABLE_SIZE> used{};
+                bool collided{ false };
+                for (size_t i = 0; i < N; ++i)
+                    {
+                    const size_t slot = get_slot(wordHashes[i], seed);
+                    if (used[slot])
+                        {
+                        collided = true;
+                        break;
+                        }
+                    used[slot] = true;
+                    }
+                if (!collided)
+                    {
+                    m_seed = seed;
+                    for (size_t i = 0; i < N; ++i)
+                        {
+                        m_table[get_slot(wordHashes[i], seed)] = words[i];
+                        }
+                    return;
+                    }
+                }
+            throw std::logic_error("Unable to build perfect hash set; check for duplicate words.");
+            }
+
+        /** @returns @c true if @c text is in the set.
+            @param text The word to look for.*/
+        [[nodiscard]]
+        constexpr bool contains(const std::wstring_view text) const noexcept
+            {
+            if (text.empty())
+                {
+                return false;
+                }
+            const std::wstring_view& entry = m_table[get_slot(hash(text), m_seed)];
+            if (entry.length() != text.length())
+                {
+                return false;
+                }
+            for (size_t i = 0; i < text.length(); ++i)
+                {
+                if (fold(entry[i]) != fold(text[i]))
+                    {
+                    return false;
+                    }
+                }
+            return true;
+            }
+
+        /// @returns The number of words in the set.
+        [[nodiscard]]
+        constexpr static size_t size() noexcept
+            {
+            return N;
+            }
+
+      private:
+        /// @brief Power of two, with at least half of the slots empty.
+        constexpr static size_t TABLE_SIZE = std::bit_ceil(N) * 2;
+        constexpr static uint32_t MAX_SEED_SEARCH = 100'000;
+
+        /// @returns The character as it is compared (lowercased, narrow, and
+        ///     with all apostrophes being the same).
+        [[nodiscard]]
+        constexpr static wchar_t fold(const wchar_t ch) noexcept
+            {
+            return characters::is_character::is_apostrophe(ch) ?
+                       L'\'' :
+                       traits::case_insensitive_ex::tolower(ch);
+            }
+
+        /// @returns The (seedless) FNV-1a hash of the folded word.
+        [[nodiscard]]
+        constexpr static uint32_t hash(const std::wstring_view text) noexcept
+            {
+            uint32_t result{ 2'166'136'261U };
+            for (const auto ch : text)
+                {
+                result ^= static_cast<uint32_t>(fold(ch));
+                result *= 16'777'619U;
+                }
+            return result;
+            }
+
+        /// @returns The table slot for a word's hash, scrambled with the seed.
+        [[nodiscard]]
+        constexpr static size_t get_slot(uint32_t wordHash, const uint32_t seed) noexcept
+            {
+            wordHash ^= seed * 0x9E37'79B9U;
+            wordHash ^= wordHash >> 16;
+            wordHash *= 0x85EB'CA6BU;
+            wordHash ^= wordHash >> 13;
+            return static_cast<size_t>(wordHash & (TABLE_SIZE - 1));
+            }
+
+        std::array<std::wstring_view, TABLE_SIZE> m_table{};
+        uint32_t m_seed{ 0 };
+        };
+    } // namespace grammar
+
+#endif //__PERFECT_HASH_SET_H__
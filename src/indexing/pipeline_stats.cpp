@@ -0,0 +1,342 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "pipeline_stats.h"
+#include "../projects/json_string.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace pipeline_stats
+    {
+    namespace
+        {
+        constexpr auto STAGE_COUNT = static_cast<size_t>(stage::STAGE_COUNT);
+        // cap the trace for each thread, so that a long session doesn't grow without bounds
+        // (the totals are still updated after this)
+        constexpr size_t MAX_EVENTS_PER_THREAD{ 100'000 };
+
+        struct stage_totals
+            {
+            size_t m_calls{ 0 };
+            size_t m_items{ 0 };
+            std::chrono::steady_clock::duration m_total{ 0 };
+            std::chrono::steady_clock::duration m_longest{ 0 };
+            };
+
+        struct trace_event
+            {
+            stage m_stage{ stage::extract };
+            const char* m_label{ nullptr };
+            std::string m_detail;
+            std::chrono::steady_clock::time_point m_start;
+            std::chrono::steady_clock::duration m_duration{ 0 };
+            size_t m_items{ 0 };
+            };
+
+        struct thread_stats
+            {
+            // only contended while exporting or resetting
+            std::mutex m_mutex;
+            uint32_t m_thread_id{ 0 };
+            std::array<stage_totals, STAGE_COUNT> m_totals;
+            std::vector<trace_event> m_events;
+            size_t m_dropped_events{ 0 };
+            };
+
+        // the buffers of every thread that has recorded something
+        // (kept alive after their threads end, so that their results can still be exported,
+        // until the next reset())
+        struct registry
+            {
+            std::mutex m_mutex;
+            std::vector<std::shared_ptr<thread_stats>> m_threads;
+            // IDs are not reused, so that a thread's trace isn't mixed up
+            // with one that was pruned
+            uint32_t m_next_thread_id{ 1 };
+            };
+
+        registry& get_registry()
+            {
+            static registry reg;
+            return reg;
+            }
+
+        const std::chrono::steady_clock::time_point& get_epoch()
+            {
+            static const auto epoch = std::chrono::steady_clock::now();
+            return epoch;
+            }
+
+        thread_stats& get_thread_stats()
+            {
+            thread_local std::shared_ptr<thread_stats> threadStats = []()
+            {
+                auto stats = std::make_shared<thread_stats>();
+                auto& reg = get_registry();
+                const std::scoped_lock lock(reg.m_mutex);
+                stats->m_thread_id = reg.m_next_thread_id++;
+                reg.m_threads.push_back(stats);
+                return stats;
+            }();
+            return *threadStats;
+            }
+
+        // how many timers of each stage are currently open on this thread
+        thread_local std::array<uint32_t, STAGE_COUNT> t_open_timers{};
+
+        [[nodiscard]]
+        double to_milliseconds(const std::chrono::steady_clock::duration duration)
+            {
+            return std::chrono::duration<double, std::milli>(duration).count();
+            }
+
+        [[nodiscard]]
+        long long to_microseconds(const std::chrono::steady_clock::duration duration)
+            {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+            }
+
+        void append_totals(std::string& json, const std::array<stage_totals, STAGE_COUNT>& totals)
+            {
+            json += '[';
+            bool first{ true };
+            for (size_t i = 0; i < STAGE_COUNT; ++i)
+                {
+                if (totals[i].m_calls == 0)
+                    {
+                    continue;
+                    }
+                if (!first)
+                    {
+                    json += ',';
+                    }
+                first = false;
+                json += "{\"stage\":";
+                AppendJsonString(json, get_stage_name(static_cast<stage>(i)));
+                json += ",\"calls\":" + std::to_string(totals[i].m_calls) +
+                        ",\"items\":" + std::to_string(totals[i].m_items) +
+                        ",\"totalMs\":" + std::to_string(to_milliseconds(totals[i].m_total)) +
+                        ",\"longestMs\":" + std::to_string(to_milliseconds(totals[i].m_longest)) +
+                        '}';
+                }
+            json += ']';
+            }
+
+        void add_to_totals(stage_totals& totals, const std::chrono::steady_clock::duration duration,
+                           const size_t items)
+            {
+            ++totals.m_calls;
+            totals.m_items += items;
+            totals.m_total += duration;
+            totals.m_longest = std::max(totals.m_longest, duration);
+            }
+        } // namespace
+
+    //------------------------------------------------
+    const char* get_stage_name(const stage stg) noexcept
+        {
+        switch (stg)
+            {
+        case stage::extract:
+            return "extract";
+        case stage::tokenize:
+            return "tokenize";
+        case stage::syllabize:
+            return "syllabize";
+        case stage::finalize:
+            return "finalize";
+        case stage::statistics:
+            return "statistics";
+        case stage::tests:
+            return "tests";
+        case stage::ui_population:
+            return "ui-population";
+        default:
+            return "unknown";
+            }
+        }
+
+    //------------------------------------------------
+    void record(const stage stg, const char* label, std::string detail,
+                const std::chrono::steady_clock::time_point start,
+                const std::chrono::steady_clock::duration duration, const size_t items,
+                const bool nested)
+        {
+        auto& threadStats = get_thread_stats();
+        const std::scoped_lock lock(threadStats.m_mutex);
+        if (!nested)
+            {
+            add_to_totals(threadStats.m_totals[static_cast<size_t>(stg)], duration, items);
+            }
+        if (threadStats.m_events.size() < MAX_EVENTS_PER_THREAD)
+            {
+            threadStats.m_events.push_back(
+                { stg, label, std::move(detail), start, duration, items });
+            }
+        else
+            {
+            ++threadStats.m_dropped_events;
+            }
+        }
+
+    //------------------------------------------------
+    void add_time(const stage stg, const std::chrono::steady_clock::duration duration,
+                  const size_t items)
+        {
+        auto& threadStats = get_thread_stats();
+        const std::scoped_lock lock(threadStats.m_mutex);
+        add_to_totals(threadStats.m_totals[static_cast<size_t>(stg)], duration, items);
+        }
+
+    //------------------------------------------------
+    void reset()
+        {
+        auto& reg = get_registry();
+        const std::scoped_lock lock(reg.m_mutex);
+        // drop the buffers of threads that have exited (only the registry still holds them),
+        // so that a long session with short-lived workers doesn't accumulate them
+        std::erase_if(reg.m_threads,
+                      [](const auto& threadStats) { return threadStats.use_count() == 1; });
+        for (auto& threadStats : reg.m_threads)
+            {
+            const std::scoped_lock threadLock(threadStats->m_mutex);
+            threadStats->m_totals.fill(stage_totals{});
+            threadStats->m_events.clear();
+            threadStats->m_dropped_events = 0;
+            }
+        }
+
+    //------------------------------------------------
+    std::string to_json()
+        {
+        std::array<stage_totals, STAGE_COUNT> overall;
+        std::string threadsJson{ "[" };
+        size_t droppedEvents{ 0 };
+
+        auto& reg = get_registry();
+        const std::scoped_lock lock(reg.m_mutex);
+        for (const auto& threadStats : reg.m_threads)
+            {
+            const std::scoped_lock threadLock(threadStats->m_mutex);
+            droppedEvents += threadStats->m_dropped_events;
+            if (std::none_of(threadStats->m_totals.cbegin(), threadStats->m_totals.cend(),
+                             [](const auto& totals) { return totals.m_calls > 0; }))
+                {
+                continue;
+                }
+            for (size_t i = 0; i < STAGE_COUNT; ++i)
+                {
+                overall[i].m_calls += threadStats->m_totals[i].m_calls;
+                overall[i].m_items += threadStats->m_totals[i].m_items;
+                overall[i].m_total += threadStats->m_totals[i].m_total;
+                overall[i].m_longest =
+                    std::max(overall[i].m_longest, threadStats->m_totals[i].m_longest);
+                }
+            if (threadsJson.length() > 1)
+                {
+                threadsJson += ',';
+                }
+            threadsJson += "{\"thread\":" + std::to_string(threadStats->m_thread_id) +
+                           ",\"stages\":";
+            append_totals(threadsJson, threadStats->m_totals);
+            threadsJson += '}';
+            }
+        threadsJson += ']';
+
+        std::string json{ "{\"enabled\":" };
+        json += is_enabled() ? "true" : "false";
+        json += ",\"droppedTraceEvents\":" + std::to_string(droppedEvents) + ",\"stages\":";
+        append_totals(json, overall);
+        json += ",\"threads\":" + threadsJson + '}';
+        return json;
+        }
+
+    //------------------------------------------------
+    std::string to_chrome_trace()
+        {
+        std::string json{ "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" };
+        bool first{ true };
+
+        auto& reg = get_registry();
+        const std::scoped_lock lock(reg.m_mutex);
+        for (const auto& threadStats : reg.m_threads)
+            {
+            const std::scoped_lock threadLock(threadStats->m_mutex);
+            for (const auto& event : threadStats->m_events)
+                {
+                if (!first)
+                    {
+                    json += ',';
+                    }
+                first = false;
+                json += "{\"name\":";
+                AppendJsonString(json, (event.m_label != nullptr) ?
+                                           std::string_view{ event.m_label } :
+                                           std::string_view{ get_stage_name(event.m_stage) });
+                json += ",\"cat\":";
+                AppendJsonString(json, get_stage_name(event.m_stage));
+                json += ",\"ph\":\"X\",\"pid\":1,\"tid\":" +
+                        std::to_string(threadStats->m_thread_id) +
+                        ",\"ts\":" + std::to_string(to_microseconds(event.m_start - get_epoch())) +
+                        ",\"dur\":" + std::to_string(to_microseconds(event.m_duration)) +
+                        ",\"args\":{\"items\":" + std::to_string(event.m_items);
+                if (!event.m_detail.empty())
+                    {
+                    json += ",\"detail\":";
+                    AppendJsonString(json, event.m_detail);
+                    }
+                json += "}}";
+                }
+            }
+        json += "]}";
+        return json;
+        }
+
+    //------------------------------------------------
+    scoped_timer::scoped_timer(const stage stg, const char* label) noexcept
+        : m_stage(stg), m_label(label), m_active(is_enabled())
+        {
+        if (m_active)
+            {
+            // make sure the epoch is set before any event starts
+            [[maybe_unused]]
+            const auto& epoch = get_epoch();
+            m_nested = (t_open_timers[static_cast<size_t>(m_stage)]++ > 0);
+            m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+    //------------------------------------------------
+    scoped_timer::~scoped_timer()
+        {
+        if (m_active)
+            {
+            const auto duration = std::chrono::steady_clock::now() - m_start;
+            --t_open_timers[static_cast<size_t>(m_stage)];
+            try
+                {
+                record(m_stage, m_label, std::move(m_detail), m_start, duration, m_items,
+                       m_nested);
+                }
+            catch (...)
+                {
+                // not worth throwing from a destructor over
+                }
+            }
+        }
+    } // namespace pipeline_stats
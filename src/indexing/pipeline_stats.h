@@ -0,0 +1,163 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __PIPELINE_STATS_H__
+#define __PIPELINE_STATS_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/// @brief Timings and counters for the stages of analyzing a document.
+/// @details Unlike @c PROFILE() (which only exists in debug builds with @c ENABLE_PROFILING),
+///     this is compiled into every build and is switched on at runtime.\n
+///     While disabled, a timer costs a single relaxed atomic load.
+///     While enabled, each thread records into its own buffer (registered once per thread),
+///     so worker threads do not contend with each other.\n
+///     Results can be exported as JSON (totals per stage and per thread) or in the
+///     Chrome trace event format (for @c chrome://tracing or Perfetto).
+namespace pipeline_stats
+    {
+    /// @brief The stages of the analysis pipeline.
+    enum class stage
+        {
+        extract,       /*!< Extracting text from the source file.*/
+        tokenize,      /*!< Breaking the text into words, sentences, and paragraphs.*/
+        syllabize,     /*!< Counting syllables (recorded as totals only, and also
+                            included in the time for tokenize).*/
+        finalize,      /*!< Post-load indexing (proper nouns, grammar, etc.).*/
+        statistics,    /*!< Calculating the statistics and word-list passes.*/
+        tests,         /*!< Running the readability tests.*/
+        ui_population, /*!< Filling in the results windows.*/
+        STAGE_COUNT    /*!< The number of stages.*/
+        };
+
+    /// @private
+    namespace detail
+        {
+        inline std::atomic<bool> m_enabled{ false };
+        }
+
+    /// @returns @c true if stats are being collected.
+    [[nodiscard]]
+    inline bool is_enabled() noexcept
+        {
+        return detail::m_enabled.load(std::memory_order_relaxed);
+        }
+
+    /** @brief Turns collecting on or off.
+        @param enable @c true to start collecting.
+        @note Results already collected are kept until reset() is called.*/
+    inline void set_enabled(const bool enable) noexcept
+        {
+        detail::m_enabled.store(enable, std::memory_order_relaxed);
+        }
+
+    /// @returns The display name of a stage (e.g., "ui-population").
+    /// @param stg The stage.
+    [[nodiscard]]
+    const char* get_stage_name(const stage stg) noexcept;
+
+    /** @brief Records a timed section for the calling thread.
+        @param stg The stage that was timed.
+        @param label A description of the section (e.g., the function name).\n
+            This must be a string literal (or otherwise outlive the stats).
+        @param detail Optional further information (e.g., a file path).
+        @param start When the section started.
+        @param duration How long the section took.
+        @param items The number of items (e.g., words) processed.
+        @param nested @c true if the section is within another section of the same stage
+            on this thread. Nested sections are added to the trace, but not to the totals
+            (so that their time is not counted twice).*/
+    void record(const stage stg, const char* label, std::string detail,
+                const std::chrono::steady_clock::time_point start,
+                const std::chrono::steady_clock::duration duration, const size_t items,
+                const bool nested);
+
+    /** @brief Adds time to a stage's totals without adding a trace event.
+        @details This is meant for work that is spread out in small pieces
+            (e.g., counting syllables one word at a time) that the caller adds up itself.
+        @param stg The stage.
+        @param duration The total time spent.
+        @param items The number of items processed.*/
+    void add_time(const stage stg, const std::chrono::steady_clock::duration duration,
+                  const size_t items);
+
+    /// @brief Clears all collected results (for every thread).
+    /// @details Threads that have exited since they recorded something are forgotten.
+    void reset();
+
+    /** @returns The totals for each stage (overall and per thread) as JSON.
+        @details Times are in milliseconds.*/
+    [[nodiscard]]
+    std::string to_json();
+
+    /** @returns The timed sections in the Chrome trace event format (JSON).
+        @details Times are in microseconds, relative to when the program started.*/
+    [[nodiscard]]
+    std::string to_chrome_trace();
+
+    /** @brief Times a section of code (from construction to destruction) and
+            records it under a stage.
+        @details Does nothing (other than checking is_enabled()) if stats are not
+            being collected when the timer is created.*/
+    class scoped_timer
+        {
+      public:
+        /** @brief Constructor, which starts the timer.
+            @param stg The stage being timed.
+            @param label A description of the section (e.g., the function name).
+                This must be a string literal.*/
+        scoped_timer(const stage stg, const char* label) noexcept;
+        /// @private
+        scoped_timer(const scoped_timer&) = delete;
+        /// @private
+        scoped_timer& operator=(const scoped_timer&) = delete;
+        /// @brief Destructor, which records the section.
+        ~scoped_timer();
+
+        /// @returns @c true if this timer is recording
+        ///     (callers can check this before building a detail string).
+        [[nodiscard]]
+        bool is_active() const noexcept
+            {
+            return m_active;
+            }
+
+        /// @brief Sets the number of items (e.g., words) processed in this section.
+        /// @param items The number of items.
+        void set_items(const size_t items) noexcept { m_items = items; }
+
+        /// @brief Sets further information about the section (e.g., a file path).
+        /// @param detail The information.
+        void set_detail(std::string detail)
+            {
+            if (m_active)
+                {
+                m_detail = std::move(detail);
+                }
+            }
+
+      private:
+        stage m_stage{ stage::extract };
+        const char* m_label{ nullptr };
+        std::string m_detail;
+        std::chrono::steady_clock::time_point m_start;
+        size_t m_items{ 0 };
+        bool m_active{ false };
+        bool m_nested{ false };
+        };
+    } // namespace pipeline_stats
+
+#endif //__PIPELINE_STATS_H__
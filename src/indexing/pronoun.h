@@ -14,10 +14,7 @@
 #ifndef __PRONOUN_H__
 #define __PRONOUN_H__
 
-#include "character_traits.h"
-#include <algorithm>
-#include <functional>
-#include <set>
+#include "perfect_hash_set.h"
 #include <string_view>
 
 namespace grammar
@@ -33,16 +30,14 @@ namespace grammar
         bool
         operator()(std::wstring_view text) const
             {
-            if (text.empty())
-                {
-                return false;
-                }
-            return m_words.find(string_type{ text.data(), text.length() }) != m_words.cend();
+            return m_words.contains(text);
             }
 
       private:
-        using string_type = std::basic_string_view<wchar_t, traits::case_insensitive_ex>;
-        static const std::set<string_type> m_words;
+        static constexpr perfect_hash_set m_words{ {
+            // English
+            L"he", L"her", L"him", L"I", L"it", L"me", L"she", L"them", L"they", L"us", L"we",
+            L"you" } };
         };
     } // namespace grammar
 
@@ -173,6 +173,13 @@ namespace grammar
             return m_syllable_count;
             }
 
+        /// @returns A new Russian syllabizer.
+        [[nodiscard]]
+        std::unique_ptr<base_syllabize> clone() const override
+            {
+            return std::make_unique<russian_syllabize<Tcharacter_traits>>();
+            }
+
       protected:
         /// Sees if a word begins with a special prefixes which should always end as a syllable
         /// division. Note that some of the prefixes from the article are omitted because they
@@ -193,6 +193,13 @@ namespace grammar
             return m_syllable_count;
             }
 
+        /// @returns A new Spanish syllabizer.
+        [[nodiscard]]
+        std::unique_ptr<base_syllabize> clone() const final
+            {
+            return std::make_unique<spanish_syllabize>();
+            }
+
       protected:
         inline void finalize_special_cases(const wchar_t* start) noexcept
             {
@@ -18,6 +18,7 @@
 #include "../Wisteria-Dataviz/src/util/string_util.h"
 #include "character_traits.h"
 #include "characters.h"
+#include <memory>
 #include <set>
 
 namespace grammar
@@ -35,6 +36,12 @@ namespace grammar
 
         virtual size_t operator()(const wchar_t* start, const size_t length) = 0;
 
+        /** @returns A new syllabizer of the same type.
+            @details Syllabizers keep state while counting a word, so each thread
+                that counts syllables needs its own copy.*/
+        [[nodiscard]]
+        virtual std::unique_ptr<base_syllabize> clone() const = 0;
+
       protected:
         void reset() noexcept
             {
@@ -281,6 +288,13 @@ namespace grammar
         size_t
         operator()(const wchar_t* start, const size_t length) final;
 
+        /// @returns A new English syllabizer.
+        [[nodiscard]]
+        std::unique_ptr<base_syllabize> clone() const final
+            {
+            return std::make_unique<english_syllabize>();
+            }
+
       private:
         /// @brief Analyzes the overall string for special situations that
         ///     they standard syllabizer would have missed.
@@ -22,10 +22,138 @@
 #include "punctuation.h"
 #include "sentence.h"
 #include "word.h"
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define __TOKENIZE_AVX2__
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define __TOKENIZE_SSE2__
+#endif
+
 namespace tokenize
     {
+    /// @private
+    namespace detail
+        {
+        /// @returns @c true if a character is a (regular) space or tab.
+        /// @param ch The character to review.
+        [[nodiscard]]
+        constexpr bool is_space_or_tab(const wchar_t ch) noexcept
+            {
+            return (ch == L' ' || ch == L'\t');
+            }
+
+#if defined(__TOKENIZE_AVX2__)
+        /// @brief The number of characters compared at once by compare_block().
+        constexpr size_t CHARS_PER_BLOCK{ sizeof(__m256i) / sizeof(wchar_t) };
+#elif defined(__TOKENIZE_SSE2__)
+        /// @brief The number of characters compared at once by compare_block().
+        constexpr size_t CHARS_PER_BLOCK{ sizeof(__m128i) / sizeof(wchar_t) };
+#endif
+
+#if defined(__TOKENIZE_AVX2__) || defined(__TOKENIZE_SSE2__)
+        /** @brief Compares a block of characters against spaces and tabs.
+            @param block The start of the block (must have at least @c CHARS_PER_BLOCK
+                characters).
+            @param[out] tabBits The tabs in the block.
+            @param[out] otherBits The characters in the block that aren't spaces or tabs.
+            @note The bit masks have a bit for each byte, so every character sets
+                @c sizeof(wchar_t) bits.*/
+        inline void compare_block(const wchar_t* block, uint32_t& tabBits,
+                                  uint32_t& otherBits) noexcept
+            {
+    #if defined(__TOKENIZE_AVX2__)
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i tabLanes{}, spaceLanes{};
+            if constexpr (sizeof(wchar_t) == sizeof(uint16_t))
+                {
+                tabLanes = _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(L'\t'));
+                spaceLanes = _mm256_cmpeq_epi16(chars, _mm256_set1_epi16(L' '));
+                }
+            else
+                {
+                tabLanes = _mm256_cmpeq_epi32(chars, _mm256_set1_epi32(L'\t'));
+                spaceLanes = _mm256_cmpeq_epi32(chars, _mm256_set1_epi32(L' '));
+                }
+            tabBits = static_cast<uint32_t>(_mm256_movemask_epi8(tabLanes));
+            otherBits = ~static_cast<uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(tabLanes, spaceLanes)));
+    #else
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i tabLanes{}, spaceLanes{};
+            if constexpr (sizeof(wchar_t) == sizeof(uint16_t))
+                {
+                tabLanes = _mm_cmpeq_epi16(chars, _mm_set1_epi16(L'\t'));
+                spaceLanes = _mm_cmpeq_epi16(chars, _mm_set1_epi16(L' '));
+                }
+            else
+                {
+                tabLanes = _mm_cmpeq_epi32(chars, _mm_set1_epi32(L'\t'));
+                spaceLanes = _mm_cmpeq_epi32(chars, _mm_set1_epi32(L' '));
+                }
+            tabBits = static_cast<uint32_t>(_mm_movemask_epi8(tabLanes));
+            otherBits =
+                ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(tabLanes, spaceLanes))) &
+                0xFFFFU;
+    #endif
+            }
+#endif
+
+        /** @brief Steps over a run of spaces and tabs.
+            @details Blocks of characters are compared at once with AVX2 or SSE2
+                (if available), which helps with text that is heavily indented or
+                laid out with spaces (e.g., tables and code listings).\n
+                Only regular spaces and tabs are skipped; other whitespace is left for
+                the caller to review one character at a time.
+            @param first The start of the text.
+            @param last The end of the text.
+            @param[out] tabFound Set to @c true if any of the skipped characters are tabs
+                (otherwise, it is left as-is).
+            @returns The first character that is not a space or tab, or @c last.*/
+        [[nodiscard]]
+        inline const wchar_t* skip_spaces_and_tabs(const wchar_t* first,
+                                                   const wchar_t* const last,
+                                                   bool& tabFound) noexcept
+            {
+            // most runs are a single space between words, so check for that
+            // before loading any blocks
+            if (first == last || !is_space_or_tab(first[0]))
+                {
+                return first;
+                }
+            tabFound = tabFound || (first[0] == L'\t');
+            ++first;
+#if defined(__TOKENIZE_AVX2__) || defined(__TOKENIZE_SSE2__)
+            while (first != last && is_space_or_tab(first[0]) &&
+                   static_cast<size_t>(last - first) >= CHARS_PER_BLOCK)
+                {
+                uint32_t tabBits{ 0 }, otherBits{ 0 };
+                compare_block(first, tabBits, otherBits);
+                if (otherBits != 0)
+                    {
+                    const auto stopBit = std::countr_zero(otherBits);
+                    // only the tabs in front of where we are stopping count
+                    tabFound = tabFound || ((tabBits & ((1U << stopBit) - 1)) != 0);
+                    return first + (stopBit / sizeof(wchar_t));
+                    }
+                tabFound = tabFound || (tabBits != 0);
+                first += CHARS_PER_BLOCK;
+                }
+#endif
+            while (first != last && is_space_or_tab(first[0]))
+                {
+                tabFound = tabFound || (first[0] == L'\t');
+                ++first;
+                }
+            return first;
+            }
+        } // namespace detail
+
     /** @brief Class for tokenizing a text block into words, sentences, and paragraphs.*/
     template<typename is_characerT = characters::is_character,
              typename is_punctuationT = punctuation::is_punctuation>
@@ -100,6 +228,14 @@ namespace tokenize
             const wchar_t* scanPosition = m_current_char;
             while (scanPosition != m_text_block_end)
                 {
+                // spaces and tabs can't begin a word or end a line, so step over them in blocks
+                if (detail::is_space_or_tab(scanPosition[0]))
+                    {
+                    bool tabFound{ false };
+                    scanPosition =
+                        detail::skip_spaces_and_tabs(scanPosition, m_text_block_end, tabFound);
+                    continue;
+                    }
                 if (is_character.can_character_begin_word(scanPosition[0]) )
                     { break; }
                 // record whether or not there are any newlines between previous and next word.
@@ -132,6 +268,13 @@ namespace tokenize
                 }
             while (m_current_char < scanPosition)
                 {
+                if (detail::is_space_or_tab(m_current_char[0]))
+                    {
+                    m_current_char =
+                        detail::skip_spaces_and_tabs(m_current_char, scanPosition, m_is_tabbed);
+                    whiteSpaceEncountered = true;
+                    continue;
+                    }
                 if (is_character.can_character_begin_word(m_current_char[0]) )
                     { break; }
                 else if (m_moved_past_beginning_nontext &&
@@ -197,18 +340,7 @@ namespace tokenize
                    then just do that.
                    Also, see if the next line is indented, bulleted, or a line of symbols uses as a line separator.
                    If so, then treat it as a new sentence and paragraph too.*/
-                if (m_word_count > 0 &&
-                    m_is_previous_word_numeric && get_punctuation().size() > 2 &&
-                    get_punctuation().at(get_punctuation().size()-1).get_word_position() == m_word_count-1 &&
-                    get_punctuation().at(get_punctuation().size()-2).get_word_position() == m_word_count-1 &&
-                    string_util::is_either<wchar_t>(
-                        string_util::full_width_to_narrow(
-                            get_punctuation().at(get_punctuation().size()-1).get_punctuation_mark()), L'.',
-                        common_lang_constants::ELLIPSE) &&
-                    string_util::is_either<wchar_t>(
-                        string_util::full_width_to_narrow(
-                            get_punctuation().at(get_punctuation().size()-2).get_punctuation_mark()), L'.',
-                        common_lang_constants::ELLIPSE))
+                if (m_is_previous_word_numeric && is_last_word_after_leader_dots())
                     {
                     ++m_current_sentence_index;
                     ++m_current_paragraph_index;
@@ -291,6 +423,13 @@ namespace tokenize
                    see if previous sentence was the end of a paragraph*/
                 while (m_current_char != m_text_block_end)
                     {
+                    if (detail::is_space_or_tab(m_current_char[0]))
+                        {
+                        bool tabFound{ false };
+                        m_current_char = detail::skip_spaces_and_tabs(m_current_char,
+                                                                      m_text_block_end, tabFound);
+                        continue;
+                        }
                     /* only count one new paragraph from last sentence.
                        Sometimes there may be many blank lines between paragraphs,
                        so don't count extra carriage returns as different paragraphs*/
@@ -885,6 +1024,135 @@ namespace tokenize
                                            (charCounts >= 3 && at_eol) ? (next_line - start) : 0);
             }
 
+        /** @brief The parts of the tokenizer's state that affect how the rest of the text is read.
+            @details This leaves out the sentence, paragraph, and word counters, which only
+                shift the indices of what is read afterwards.\n
+                If two tokenizers over the same text have equal states, then they will read the
+                rest of the text the same way.*/
+        struct resume_state
+            {
+            /// @private
+            const wchar_t* m_current_char{ nullptr };
+            /// @private
+            const wchar_t* m_pending_sentence_ending_punctuation_pos{ nullptr };
+            /// @private
+            size_t m_sentence_position{ 0 };
+            /// @private
+            wchar_t m_pending_sentence_ending_punctuation{ L'.' };
+            /// @private
+            wchar_t m_current_sentence_ending_punctuation{ L' ' };
+            /// @private
+            bool m_at_eol{ false };
+            /// @private
+            bool m_is_at_end_of_sentence{ false };
+            /// @private
+            bool m_is_numeric{ false };
+            /// @private
+            bool m_moved_past_beginning_nontext{ false };
+            /// @private
+            bool m_is_toc_page_number{ false };
+
+            /// @private
+            [[nodiscard]]
+            bool operator==(const resume_state&) const = default;
+            };
+
+        /// @returns The state that the next read will start from.
+        [[nodiscard]]
+        resume_state get_resume_state() const noexcept
+            {
+            // A pending sentence terminator behind the current position can't be stepped over
+            // again, so only its character matters after this.
+            const wchar_t* const pendingPos = m_pending_sentence_ending_punctuation_pos;
+            return resume_state{ m_current_char,
+                                 (pendingPos != nullptr && pendingPos >= m_current_char) ?
+                                     pendingPos : nullptr,
+                                 m_sentence_position,
+                                 (pendingPos != nullptr) ? *pendingPos : L'.',
+                                 m_current_sentence_ending_punctuation,
+                                 m_at_eol,
+                                 m_is_at_end_of_sentence,
+                                 m_is_numeric,
+                                 m_moved_past_beginning_nontext,
+                                 m_is_numeric && is_last_word_after_leader_dots() };
+            }
+
+        /** @brief Finds the next hard paragraph break (a blank line or a form feed).
+            @param position Where to start searching.
+            @returns The start of the text after the break (and any whitespace after it),
+                or the end of the text if there are no more breaks.*/
+        [[nodiscard]]
+        const wchar_t* find_paragraph_break(const wchar_t* position) const noexcept
+            {
+            while (position < m_text_block_end)
+                {
+                if (!isEol(position[0]))
+                    {
+                    ++position;
+                    continue;
+                    }
+                size_t lineCount{ 0 };
+                bool isPageBreak{ false };
+                while (position < m_text_block_end &&
+                       characters::is_character::is_space(position[0]))
+                    {
+                    if (position[0] == L'\f')
+                        {
+                        isPageBreak = true;
+                        }
+                    // CRLF counts as one line
+                    else if (position[0] == L'\n' ||
+                             (position[0] == L'\r' &&
+                              (position + 1 == m_text_block_end || position[1] != L'\n')))
+                        {
+                        ++lineCount;
+                        }
+                    ++position;
+                    }
+                if (isPageBreak || lineCount > 1)
+                    {
+                    return position;
+                    }
+                }
+            return m_text_block_end;
+            }
+
+        /** @brief Moves the tokenizer to the start of a paragraph in the middle of the text,
+                so that a section of the text can be read separately from what is in front of it.
+            @details The state is set to what it most likely would be after reading the
+                previous paragraph. Because that is only a guess, what is read by the next call
+                should be ignored. After that call, if get_resume_state() matches the state of
+                a tokenizer that read up to the same word from the start of the text, then
+                everything read afterwards will be the same (other than the counters).
+            @param position The start of the paragraph (see find_paragraph_break()).*/
+        void start_at_paragraph(const wchar_t* position)
+            {
+            assert(position >= m_text_block_beginning && position <= m_text_block_end);
+            m_current_char = position;
+            m_moved_past_beginning_nontext = true;
+            // step back over the paragraph break (and any closing quotes or parentheses)
+            // to see if the previous paragraph ended a sentence
+            const wchar_t* previousChar = position;
+            while (previousChar > m_text_block_beginning &&
+                   (characters::is_character::is_space(previousChar[-1]) ||
+                    isEndOfSentence.can_character_begin_or_end_parenthetical_or_quoted_section(
+                        previousChar[-1])))
+                {
+                --previousChar;
+                }
+            if (previousChar > m_text_block_beginning &&
+                isEndOfSentence.can_character_end_sentence_strict(previousChar[-1]))
+                {
+                m_is_at_end_of_sentence = true;
+                m_pending_sentence_ending_punctuation_pos = previousChar - 1;
+                }
+            // The check for table of contents lines needs more than two punctuation marks,
+            // so stand in (with a mark that can't be next to any word) for the punctuation
+            // in front of this.
+            m_punctuation.assign(
+                1, punctuation::punctuation_mark(L' ', std::numeric_limits<size_t>::max(), false));
+            }
+
         /** @brief Sets a list of known (spelled correctly) words.
             @param splist The list of known words.*/
         void set_known_spellings(const word_list* splist) noexcept
@@ -903,6 +1171,28 @@ namespace tokenize
             {
             return string_util::is_one_of(string_util::full_width_to_narrow(ch), L"+@-#*");
             }
+        /// @returns @c true if the last word read is preceded by at least two periods
+        ///     (or ellipses), like the page number at the end of a table of contents line
+        ///     (e.g., "Overview....17").
+        [[nodiscard]]
+        bool is_last_word_after_leader_dots() const
+            {
+            if (m_word_count == 0 || get_punctuation().size() <= 2)
+                {
+                return false;
+                }
+            const auto& lastMark = get_punctuation().at(get_punctuation().size() - 1);
+            const auto& secondToLastMark = get_punctuation().at(get_punctuation().size() - 2);
+            return (lastMark.get_word_position() == m_word_count - 1 &&
+                    secondToLastMark.get_word_position() == m_word_count - 1 &&
+                    string_util::is_either<wchar_t>(
+                        string_util::full_width_to_narrow(lastMark.get_punctuation_mark()), L'.',
+                        common_lang_constants::ELLIPSE) &&
+                    string_util::is_either<wchar_t>(
+                        string_util::full_width_to_narrow(secondToLastMark.get_punctuation_mark()),
+                        L'.', common_lang_constants::ELLIPSE));
+            }
+
         grammar::is_end_of_line isEol;
         is_characerT is_character;
         is_punctuationT isPunctuation;
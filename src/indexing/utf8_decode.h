@@ -0,0 +1,353 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __UTF8_DECODE_H__
+#define __UTF8_DECODE_H__
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define __UTF8_DECODE_SSE2__
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define __UTF8_DECODE_NEON__
+#endif
+
+/// @brief Byte-order-mark sniffing and UTF-8 validation/widening.
+/// @details Runs of 7-bit ASCII (the bulk of most documents, including HTML markup) are
+///     scanned and widened 16 bytes at a time with SSE2 (x86) or NEON (ARM64);
+///     other platforms use an 8-byte scalar fallback. Multi-byte sequences are
+///     validated and decoded one at a time.
+namespace encoding
+    {
+    /// @brief Byte-order marks that a text stream may begin with.
+    enum class byte_order_mark
+        {
+        none,                /*!< No BOM.*/
+        utf8,                /*!< UTF-8 (EF BB BF).*/
+        utf16_little_endian, /*!< UTF-16 LE (FF FE).*/
+        utf16_big_endian,    /*!< UTF-16 BE (FE FF).*/
+        utf32_little_endian, /*!< UTF-32 LE (FF FE 00 00).*/
+        utf32_big_endian     /*!< UTF-32 BE (00 00 FE FF).*/
+        };
+
+    /** @returns The byte-order mark at the start of a stream.
+        @param text The stream to review.*/
+    [[nodiscard]]
+    constexpr byte_order_mark sniff_bom(const std::string_view text) noexcept
+        {
+        const auto byteAt = [&text](const size_t index)
+        { return static_cast<uint8_t>(text[index]); };
+
+        if (text.length() >= 4 && byteAt(0) == 0xFF && byteAt(1) == 0xFE && byteAt(2) == 0 &&
+            byteAt(3) == 0)
+            {
+            return byte_order_mark::utf32_little_endian;
+            }
+        if (text.length() >= 4 && byteAt(0) == 0 && byteAt(1) == 0 && byteAt(2) == 0xFE &&
+            byteAt(3) == 0xFF)
+            {
+            return byte_order_mark::utf32_big_endian;
+            }
+        if (text.length() >= 3 && byteAt(0) == 0xEF && byteAt(1) == 0xBB && byteAt(2) == 0xBF)
+            {
+            return byte_order_mark::utf8;
+            }
+        if (text.length() >= 2 && byteAt(0) == 0xFF && byteAt(1) == 0xFE)
+            {
+            return byte_order_mark::utf16_little_endian;
+            }
+        if (text.length() >= 2 && byteAt(0) == 0xFE && byteAt(1) == 0xFF)
+            {
+            return byte_order_mark::utf16_big_endian;
+            }
+        return byte_order_mark::none;
+        }
+
+    /** @returns The length (in bytes) of a byte-order mark.
+        @param bom The byte-order mark.*/
+    [[nodiscard]]
+    constexpr size_t bom_length(const byte_order_mark bom) noexcept
+        {
+        switch (bom)
+            {
+        case byte_order_mark::utf8:
+            return 3;
+        case byte_order_mark::utf16_little_endian:
+            [[fallthrough]];
+        case byte_order_mark::utf16_big_endian:
+            return 2;
+        case byte_order_mark::utf32_little_endian:
+            [[fallthrough]];
+        case byte_order_mark::utf32_big_endian:
+            return 4;
+        default:
+            return 0;
+            }
+        }
+
+    /** @returns The number of leading 7-bit ASCII bytes in a stream.
+        @param text The stream to scan.*/
+    [[nodiscard]]
+    inline size_t ascii_prefix_length(const std::string_view text) noexcept
+        {
+        const char* const data = text.data();
+        const size_t length = text.length();
+        size_t i{ 0 };
+#if defined(__UTF8_DECODE_SSE2__)
+        for (; i + 16 <= length; i += 16)
+            {
+            // the high bit of each byte is gathered into a 16-bit mask
+            const int highBits =
+                _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            if (highBits != 0)
+                {
+                return i + std::countr_zero(static_cast<unsigned int>(highBits));
+                }
+            }
+#elif defined(__UTF8_DECODE_NEON__)
+        for (; i + 16 <= length; i += 16)
+            {
+            if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i))) >= 0x80)
+                {
+                break;
+                }
+            }
+#endif
+        for (; i + 8 <= length; i += 8)
+            {
+            uint64_t word{ 0 };
+            std::memcpy(&word, data + i, sizeof(word));
+            if ((word & 0x8080808080808080ULL) != 0)
+                {
+                break;
+                }
+            }
+        for (; i < length; ++i)
+            {
+            if (static_cast<uint8_t>(data[i]) >= 0x80)
+                {
+                return i;
+                }
+            }
+        return length;
+        }
+
+    namespace detail
+        {
+        /** @brief Widens a run of 7-bit ASCII bytes.
+            @param source The ASCII bytes.
+            @param length The number of bytes to widen.
+            @param[out] dest Where to write the wide characters
+                (must have room for @c length characters).*/
+        inline void widen_ascii(const uint8_t* source, const size_t length, wchar_t* dest) noexcept
+            {
+            size_t i{ 0 };
+#if defined(__UTF8_DECODE_SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= length; i += 16)
+                {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                const __m128i low = _mm_unpacklo_epi8(chunk, zero);
+                const __m128i high = _mm_unpackhi_epi8(chunk, zero);
+                if constexpr (sizeof(wchar_t) == sizeof(uint16_t))
+                    {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), low);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8), high);
+                    }
+                else
+                    {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                                     _mm_unpacklo_epi16(low, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 4),
+                                     _mm_unpackhi_epi16(low, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 8),
+                                     _mm_unpacklo_epi16(high, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i + 12),
+                                     _mm_unpackhi_epi16(high, zero));
+                    }
+                }
+#elif defined(__UTF8_DECODE_NEON__)
+            for (; i + 16 <= length; i += 16)
+                {
+                const uint8x16_t chunk = vld1q_u8(source + i);
+                const uint16x8_t low = vmovl_u8(vget_low_u8(chunk));
+                const uint16x8_t high = vmovl_u8(vget_high_u8(chunk));
+                if constexpr (sizeof(wchar_t) == sizeof(uint16_t))
+                    {
+                    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i), low);
+                    vst1q_u16(reinterpret_cast<uint16_t*>(dest + i + 8), high);
+                    }
+                else
+                    {
+                    vst1q_u32(reinterpret_cast<uint32_t*>(dest + i), vmovl_u16(vget_low_u16(low)));
+                    vst1q_u32(reinterpret_cast<uint32_t*>(dest + i + 4),
+                              vmovl_u16(vget_high_u16(low)));
+                    vst1q_u32(reinterpret_cast<uint32_t*>(dest + i + 8),
+                              vmovl_u16(vget_low_u16(high)));
+                    vst1q_u32(reinterpret_cast<uint32_t*>(dest + i + 12),
+                              vmovl_u16(vget_high_u16(high)));
+                    }
+                }
+#endif
+            for (; i < length; ++i)
+                {
+                dest[i] = static_cast<wchar_t>(source[i]);
+                }
+            }
+
+        /** @brief Decodes and validates one multi-byte UTF-8 sequence.
+            @param source The stream.
+            @param length The length of the stream.
+            @param[in,out] position The start of the sequence; on success, moved past it.
+            @param[out] codePoint The decoded code point.
+            @returns @c false if the sequence is malformed, overlong, truncated,
+                or encodes a surrogate or a value past U+10FFFF.*/
+        [[nodiscard]]
+        inline bool decode_sequence(const uint8_t* source, const size_t length, size_t& position,
+                                    char32_t& codePoint) noexcept
+            {
+            const uint8_t lead = source[position];
+            size_t trailCount{ 0 };
+            // bounds for the first trailing byte, which rule out overlong forms,
+            // surrogates, and values past U+10FFFF
+            uint8_t minTrail{ 0x80 };
+            uint8_t maxTrail{ 0xBF };
+            if (lead >= 0xC2 && lead <= 0xDF)
+                {
+                trailCount = 1;
+                codePoint = lead & 0x1F;
+                }
+            else if (lead >= 0xE0 && lead <= 0xEF)
+                {
+                trailCount = 2;
+                codePoint = lead & 0x0F;
+                if (lead == 0xE0)
+                    {
+                    minTrail = 0xA0;
+                    }
+                else if (lead == 0xED)
+                    {
+                    maxTrail = 0x9F;
+                    }
+                }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+                {
+                trailCount = 3;
+                codePoint = lead & 0x07;
+                if (lead == 0xF0)
+                    {
+                    minTrail = 0x90;
+                    }
+                else if (lead == 0xF4)
+                    {
+                    maxTrail = 0x8F;
+                    }
+                }
+            else
+                {
+                return false;
+                }
+            if (position + trailCount >= length)
+                {
+                return false;
+                }
+            for (size_t i = 1; i <= trailCount; ++i)
+                {
+                const uint8_t trail = source[position + i];
+                if (trail < minTrail || trail > maxTrail)
+                    {
+                    return false;
+                    }
+                minTrail = 0x80;
+                maxTrail = 0xBF;
+                codePoint = (codePoint << 6) | (trail & 0x3F);
+                }
+            position += trailCount + 1;
+            return true;
+            }
+        } // namespace detail
+
+    /** @returns @c true if a stream is valid UTF-8 (7-bit ASCII is valid UTF-8).
+        @param text The stream to validate.*/
+    [[nodiscard]]
+    inline bool is_valid_utf8(const std::string_view text) noexcept
+        {
+        const auto* const source = reinterpret_cast<const uint8_t*>(text.data());
+        size_t position{ 0 };
+        char32_t codePoint{ 0 };
+        while (position < text.length())
+            {
+            position += ascii_prefix_length(text.substr(position));
+            if (position < text.length() &&
+                !detail::decode_sequence(source, text.length(), position, codePoint))
+                {
+                return false;
+                }
+            }
+        return true;
+        }
+
+    /** @brief Validates and converts UTF-8 into a wide string in a single pass.
+        @param text The UTF-8 stream (without a BOM).
+        @param[out] buffer The buffer to write to. Its content is replaced,
+            but its capacity is reused.
+        @returns @c false if @c text is not valid UTF-8, in which case
+            the content of @c buffer is unspecified.
+        @note On platforms with a 16-bit @c wchar_t, code points past U+FFFF
+            are written as surrogate pairs.*/
+    inline bool utf8_to_wide(const std::string_view text, std::wstring& buffer)
+        {
+        // a UTF-8 stream never has fewer bytes than the UTF-16/32 units that it decodes to
+        buffer.resize(text.length());
+        const auto* const source = reinterpret_cast<const uint8_t*>(text.data());
+        wchar_t* dest = buffer.data();
+        size_t position{ 0 };
+        char32_t codePoint{ 0 };
+        while (position < text.length())
+            {
+            const size_t asciiLength = ascii_prefix_length(text.substr(position));
+            detail::widen_ascii(source + position, asciiLength, dest);
+            position += asciiLength;
+            dest += asciiLength;
+            if (position >= text.length())
+                {
+                break;
+                }
+            if (!detail::decode_sequence(source, text.length(), position, codePoint))
+                {
+                return false;
+                }
+            if constexpr (sizeof(wchar_t) == sizeof(uint16_t))
+                {
+                if (codePoint > 0xFFFF)
+                    {
+                    codePoint -= 0x10000;
+                    *dest++ = static_cast<wchar_t>(0xD800 + (codePoint >> 10));
+                    *dest++ = static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF));
+                    continue;
+                    }
+                }
+            *dest++ = static_cast<wchar_t>(codePoint);
+            }
+        buffer.resize(static_cast<size_t>(dest - buffer.data()));
+        return true;
+        }
+    } // namespace encoding
+
+#endif //__UTF8_DECODE_H__
@@ -15,6 +15,9 @@
 #define __WORD_COLLECTION_H__
 
 #include <numeric>
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <limits>
 #include <map>
 #include <vector>
@@ -22,6 +25,9 @@
 #include <string>
 #include <stdexcept>
 #include <cstdlib>
+#include <chrono>
+#include <optional>
+#include <thread>
 #include "word_functional.h"
 #include "sentence.h"
 #include "syllable.h"
@@ -38,6 +44,7 @@
 #include "negating_word.h"
 #include "pronoun.h"
 #include "character_traits.h"
+#include "pipeline_stats.h"
 #include "../OleanderStemmingLibrary/src/common_lang_constants.h"
 #include "../Wisteria-Dataviz/src/math/mathematics.h"
 #include "../Wisteria-Dataviz/src/util/frequencymap.h"
@@ -101,6 +108,9 @@ public:
         // on average, every 5 or 6 characters in a text stream is a single word
         reserve_word_size(length/5);
 
+        std::optional<pipeline_stats::scoped_timer> tokenizeTimer{ std::in_place,
+            pipeline_stats::stage::tokenize, "document::load" };
+
         tokenize::document_tokenize<> tokenize_text(words, length, m_treat_eol_as_eos,
             m_ignore_blank_lines_when_determing_paragraph_split,
             m_ignore_indenting_when_determing_paragraph_split,
@@ -108,89 +118,43 @@ public:
 
         tokenize_text.set_known_spellings(is_correctly_spelled.get_word_list());
 
-        grammar::base_syllabize& count_syllables = *syllabize;
-        punctuation::punctuation_count count_punctuation;
-
-        const wchar_t* current_char = nullptr;
+        // syllable counting is interleaved with tokenizing, so (when collecting stats)
+        // its time is added up word by word and recorded as a total
+        const bool timeSyllabizing = tokenizeTimer->is_active();
+        syllable_counter countSyllables(*syllabize, timeSyllabizing);
 
-        while ( (current_char = tokenize_text()) != nullptr)
+        wchar_t sentenceEndingPunctuation{ L' ' };
+        if (m_tokenize_in_parallel)
             {
-            if (!tokenize_text.is_split_word())
-                {
-                m_words.emplace_back(current_char,
-                            tokenize_text.get_current_word_length(),
-                            tokenize_text.get_current_sentence_index(),
-                            tokenize_text.get_sentence_position(),
-                            tokenize_text.get_current_paragraph_index(),
-                            tokenize_text.is_numeric(),
-                            // these are really calculated after the entire document is loaded,
-                            // so just set reasonable default values for now
-                            true, false, false,
-                            count_syllables(current_char, tokenize_text.get_current_word_length()),
-                            count_punctuation({ current_char, tokenize_text.get_current_word_length() }) );
-                }
-            // Review words at the end of the line that are hyphenated,
-            // because they usually are connected to the word on the next line.
-            else
+            sentenceEndingPunctuation =
+                load_sections_in_parallel(words, length, tokenize_text, countSyllables);
+            }
+        else
+            {
+            token_info token;
+            // scratch buffer for rebuilding words split across lines
+            // (reused, so that it only allocates when a longer word comes along)
+            word_list::word_type splitWordNoHyphens;
+
+            const wchar_t* current_char = nullptr;
+            while ( (current_char = tokenize_text()) != nullptr)
                 {
-                PROFILE_SECTION_START("document::load(): split word");
-                // Review versions of the word with and without hyphens to see which one we should use.
-                // Also strip out newlines.
-                wchar_t* currentWord = new wchar_t[tokenize_text.get_current_word_length()+1];
-                std::wmemset(currentWord,0,tokenize_text.get_current_word_length()+1);
-
-                wchar_t* currentWordNoHyphens = new wchar_t[tokenize_text.get_current_word_length()+1];
-                std::wmemset(currentWordNoHyphens,0,tokenize_text.get_current_word_length()+1);
-                size_t currentWordSize = 0, currentWordNoHyphensSize = 0;
-                for (size_t i = 0; i < tokenize_text.get_current_word_length(); ++i)
-                    {
-                    if (!characters::is_character::is_space(current_char[i]))
-                        { currentWord[currentWordSize++] = current_char[i]; }
-                    if (!characters::is_character::is_space(current_char[i]) &&
-                        !characters::is_character::is_hyphen(current_char[i]))
-                        { currentWordNoHyphens[currentWordNoHyphensSize++] = current_char[i]; }
-                    }
-                if (is_correctly_spelled(Tword_type(currentWordNoHyphens)))
-                    {
-                    m_words.emplace_back(currentWordNoHyphens,
-                                currentWordNoHyphensSize,
-                                tokenize_text.get_current_sentence_index(),
-                                tokenize_text.get_sentence_position(),
-                                tokenize_text.get_current_paragraph_index(),
-                                tokenize_text.is_numeric(),
-                                // these are really calculated after the entire document is loaded,
-                                // so just set reasonable default values for now
-                                true, false, false,
-                                count_syllables(current_char, tokenize_text.get_current_word_length()),
-                                count_punctuation({ current_char, tokenize_text.get_current_word_length() }) );
-                    }
-                else
-                    {
-                    m_words.emplace_back(currentWord,
-                                currentWordSize,
-                                tokenize_text.get_current_sentence_index(),
-                                tokenize_text.get_sentence_position(),
-                                tokenize_text.get_current_paragraph_index(),
-                                tokenize_text.is_numeric(),
-                                // these are really calculated after the entire document is loaded,
-                                // so just set reasonable default values for now
-                                true, false, false,
-                                count_syllables(current_char, tokenize_text.get_current_word_length()),
-                                count_punctuation({ current_char, tokenize_text.get_current_word_length() }) );
-                    }
-                delete [] currentWord;
-                delete [] currentWordNoHyphens;
-                PROFILE_SECTION_END();
+                read_token(current_char, tokenize_text, countSyllables, splitWordNoHyphens, token);
+                add_token(token, 0, 0);
                 }
-            update_sentence_paragraph_info(tokenize_text.get_current_sentence_index(),
-                        tokenize_text.get_current_paragraph_index(),
-                        tokenize_text.get_current_sentence_ending_punctuation(),
-                        tokenize_text.get_current_leading_end_of_line_count() );
+            m_punctuation = std::move(tokenize_text.m_punctuation);
+            sentenceEndingPunctuation = tokenize_text.get_current_sentence_ending_punctuation();
             }
 
-        m_punctuation = std::move(tokenize_text.m_punctuation);
+        if (timeSyllabizing)
+            {
+            pipeline_stats::add_time(pipeline_stats::stage::syllabize, countSyllables.get_time(),
+                                     m_words.size());
+            }
+        tokenizeTimer->set_items(m_words.size());
+        tokenizeTimer.reset();
 
-        finalize(tokenize_text.get_current_sentence_ending_punctuation());
+        finalize(sentenceEndingPunctuation);
         }
 
     /** Allocates space for the information structures. Their sizes are
@@ -242,6 +206,9 @@ public:
     void finalize(const wchar_t sentence_ending_punctuation)
         {
         PROFILE();
+        pipeline_stats::scoped_timer finalizeTimer(pipeline_stats::stage::finalize,
+                                                   "document::finalize");
+        finalizeTimer.set_items(m_words.size());
         if (m_words.empty())
             { return; }
         const grammar::is_coordinating_conjunction& isConjunction = *is_conjunction;
@@ -921,6 +888,29 @@ public:
     void sentence_start_must_be_uppercased(const bool mustBeUppercased) noexcept
         { m_sentence_start_must_be_uppercased = mustBeUppercased; }
 
+    /** @brief Sets whether to tokenize large documents with multiple threads.
+        @details The text is split into sections at hard paragraph breaks (blank lines or
+            form feeds), and the sections are tokenized concurrently. Each section is then
+            joined to the one in front of it only if the tokenizer would have been in the
+            same state there when reading the text from the start; otherwise, that section
+            is read again sequentially. Either way, the results are the same as
+            tokenizing the whole document sequentially.
+        @param parallel @c true to tokenize in parallel.*/
+    void tokenize_in_parallel(const bool parallel) noexcept
+        { m_tokenize_in_parallel = parallel; }
+    /// @returns @c true if large documents are tokenized with multiple threads.
+    [[nodiscard]]
+    bool is_tokenizing_in_parallel() const noexcept
+        { return m_tokenize_in_parallel; }
+    /** @brief Sets the minimum length (in characters) of the sections that the text is split
+            into when tokenizing in parallel.
+        @details Sections are extended to the next paragraph break, so they are usually
+            longer than this. Documents that are shorter than two sections are tokenized
+            sequentially.
+        @param length The minimum section length.*/
+    void set_parallel_section_length(const size_t length) noexcept
+        { m_parallel_section_length = std::max<size_t>(length, 1); }
+
     void ignore_trailing_copyright_notice_paragraphs(const bool ignore) noexcept
         { m_ignore_trailing_copyright_notice_paragraphs = ignore; }
 
@@ -1140,6 +1130,334 @@ public:
             }
         }
 private:
+    /// @brief Counts syllables, adding up the time spent when collecting stats.
+    class syllable_counter
+        {
+    public:
+        syllable_counter(grammar::base_syllabize& syllabizer, const bool timeSyllabizing) noexcept :
+            m_syllabizer(syllabizer), m_time_syllabizing(timeSyllabizing)
+            {}
+        [[nodiscard]]
+        size_t operator()(const wchar_t* word, const size_t wordLength)
+            {
+            if (!m_time_syllabizing)
+                { return m_syllabizer(word, wordLength); }
+            const auto start = std::chrono::steady_clock::now();
+            const auto syllableCount = m_syllabizer(word, wordLength);
+            m_time += std::chrono::steady_clock::now() - start;
+            return syllableCount;
+            }
+        /// @returns @c true if adding up the time spent.
+        [[nodiscard]]
+        bool is_timing() const noexcept
+            { return m_time_syllabizing; }
+        /// @returns The time spent counting syllables.
+        [[nodiscard]]
+        std::chrono::steady_clock::duration get_time() const noexcept
+            { return m_time; }
+        /// @brief Adds time spent counting syllables elsewhere (e.g., on another thread).
+        /// @param duration The time to add.
+        void add_time(const std::chrono::steady_clock::duration duration) noexcept
+            { m_time += duration; }
+    private:
+        grammar::base_syllabize& m_syllabizer;
+        bool m_time_syllabizing{ false };
+        std::chrono::steady_clock::duration m_time{ 0 };
+        };
+
+    /// @brief A word read by the tokenizer, before it is added to the document.
+    struct token_info
+        {
+        const wchar_t* m_start{ nullptr };
+        size_t m_length{ 0 };
+        // a word split across lines, with the newlines (and maybe the hyphens) removed
+        word_list::word_type m_split_word;
+        size_t m_sentence_index{ 0 };
+        size_t m_sentence_position{ 0 };
+        size_t m_paragraph_index{ 0 };
+        size_t m_syllable_count{ 0 };
+        size_t m_punctuation_count{ 0 };
+        size_t m_leading_end_of_line_count{ 0 };
+        wchar_t m_sentence_ending_punctuation{ L' ' };
+        bool m_is_numeric{ false };
+        bool m_is_split_word{ false };
+        };
+
+    /// @brief The words read from a section of the text (when tokenizing in parallel).
+    struct tokenized_section
+        {
+        std::optional<tokenize::document_tokenize<>> m_tokenizer;
+        // The first word read (and the tokenizer's state after reading it).
+        // This is only used to see if the section can be joined to the one in front of it.
+        const wchar_t* m_first_word{ nullptr };
+        tokenize::document_tokenize<>::resume_state m_first_word_state;
+        size_t m_first_word_sentence_index{ 0 };
+        size_t m_first_word_paragraph_index{ 0 };
+        size_t m_first_word_punctuation_count{ 0 };
+        // the words after the first one, through the first word of the next section
+        std::vector<token_info> m_tokens;
+        std::chrono::steady_clock::duration m_syllabize_time{ 0 };
+        bool m_reached_end{ false };
+        };
+
+    /** @brief Copies the word that a tokenizer just read into @c token.
+        @param wordStart The start of the word (returned from the tokenizer).
+        @param tokenizer The tokenizer.
+        @param countSyllables The syllable counter.
+        @param splitWordNoHyphens Scratch buffer for rebuilding words split across lines.
+        @param[out] token The token to write to.*/
+    void read_token(const wchar_t* wordStart, const tokenize::document_tokenize<>& tokenizer,
+                    syllable_counter& countSyllables,
+                    word_list::word_type& splitWordNoHyphens, token_info& token) const
+        {
+        token.m_start = wordStart;
+        token.m_length = tokenizer.get_current_word_length();
+        token.m_sentence_index = tokenizer.get_current_sentence_index();
+        token.m_sentence_position = tokenizer.get_sentence_position();
+        token.m_paragraph_index = tokenizer.get_current_paragraph_index();
+        token.m_sentence_ending_punctuation = tokenizer.get_current_sentence_ending_punctuation();
+        token.m_leading_end_of_line_count = tokenizer.get_current_leading_end_of_line_count();
+        token.m_is_numeric = tokenizer.is_numeric();
+        token.m_is_split_word = tokenizer.is_split_word();
+        // Review words at the end of the line that are hyphenated,
+        // because they usually are connected to the word on the next line.
+        if (token.m_is_split_word)
+            {
+            PROFILE_SECTION_START("document::load(): split word");
+            // Review versions of the word with and without hyphens to see which one we should use.
+            // Also strip out newlines.
+            token.m_split_word.clear();
+            splitWordNoHyphens.clear();
+            for (size_t i = 0; i < token.m_length; ++i)
+                {
+                if (!characters::is_character::is_space(wordStart[i]))
+                    {
+                    token.m_split_word += wordStart[i];
+                    if (!characters::is_character::is_hyphen(wordStart[i]))
+                        { splitWordNoHyphens += wordStart[i]; }
+                    }
+                }
+            // a plain string lookup (no stemming) is enough to see if the joined word is known
+            // (swapping keeps both buffers' memory around for the next split word)
+            if (is_correctly_spelled.is_known_spelling(splitWordNoHyphens))
+                { token.m_split_word.swap(splitWordNoHyphens); }
+            PROFILE_SECTION_END();
+            }
+        token.m_syllable_count = countSyllables(wordStart, token.m_length);
+        token.m_punctuation_count = punctuation::punctuation_count{}({ wordStart, token.m_length });
+        }
+
+    /** @brief Adds a word read by the tokenizer to the document.
+        @param token The word.
+        @param sentenceOffset The amount to shift the word's sentence index by.
+        @param paragraphOffset The amount to shift the word's paragraph index by.*/
+    void add_token(const token_info& token, const size_t sentenceOffset,
+                   const size_t paragraphOffset)
+        {
+        m_words.emplace_back(token.m_is_split_word ? token.m_split_word.c_str() : token.m_start,
+                    token.m_is_split_word ? token.m_split_word.length() : token.m_length,
+                    token.m_sentence_index + sentenceOffset,
+                    token.m_sentence_position,
+                    token.m_paragraph_index + paragraphOffset,
+                    token.m_is_numeric,
+                    // these are really calculated after the entire document is loaded,
+                    // so just set reasonable default values for now
+                    true, false, false,
+                    token.m_syllable_count,
+                    token.m_punctuation_count);
+        update_sentence_paragraph_info(token.m_sentence_index + sentenceOffset,
+                    token.m_paragraph_index + paragraphOffset,
+                    token.m_sentence_ending_punctuation,
+                    token.m_leading_end_of_line_count);
+        }
+
+    /** @brief Reads the words in a section of the text (on a worker thread),
+            starting from a guess of what the tokenizer's state would be there.
+        @param words The text.
+        @param length The length of the text.
+        @param sectionStart The start of the section (at the start of a paragraph).
+        @param sectionEnd The start of the next section (or the end of the text).
+        @param syllabizer The syllabizer to use (only used by this thread).
+        @param timeSyllabizing Whether to add up the time spent counting syllables.
+        @param[out] section Where to write the results.*/
+    void read_section(const wchar_t* words, const size_t length,
+                      const wchar_t* sectionStart, const wchar_t* sectionEnd,
+                      grammar::base_syllabize& syllabizer, const bool timeSyllabizing,
+                      tokenized_section& section) const
+        {
+        auto& tokenizer = section.m_tokenizer.emplace(words, length, m_treat_eol_as_eos,
+            m_ignore_blank_lines_when_determing_paragraph_split,
+            m_ignore_indenting_when_determing_paragraph_split,
+            m_sentence_start_must_be_uppercased);
+        tokenizer.set_known_spellings(is_correctly_spelled.get_word_list());
+        tokenizer.start_at_paragraph(sectionStart);
+
+        section.m_first_word = tokenizer();
+        if (section.m_first_word == nullptr)
+            {
+            section.m_reached_end = true;
+            return;
+            }
+        section.m_first_word_state = tokenizer.get_resume_state();
+        section.m_first_word_sentence_index = tokenizer.get_current_sentence_index();
+        section.m_first_word_paragraph_index = tokenizer.get_current_paragraph_index();
+        section.m_first_word_punctuation_count = tokenizer.get_punctuation().size();
+
+        syllable_counter countSyllables(syllabizer, timeSyllabizing);
+        word_list::word_type splitWordNoHyphens;
+        // read through the first word of the next section,
+        // which is where the next section will be joined to this one
+        const wchar_t* current_char = section.m_first_word;
+        while (current_char < sectionEnd)
+            {
+            current_char = tokenizer();
+            if (current_char == nullptr)
+                {
+                section.m_reached_end = true;
+                break;
+                }
+            read_token(current_char, tokenizer, countSyllables, splitWordNoHyphens,
+                       section.m_tokens.emplace_back());
+            }
+        section.m_syllabize_time = countSyllables.get_time();
+        }
+
+    /** @brief Loads the words by tokenizing sections of the text concurrently.
+        @details See tokenize_in_parallel() for how the sections are joined.
+        @param words The text.
+        @param length The length of the text.
+        @param tokenize_text The tokenizer for the whole text, which reads the first section
+            and any section that can't be joined to the one in front of it.
+        @param countSyllables The syllable counter used with @c tokenize_text.
+        @returns The ending punctuation of the last sentence.*/
+    [[nodiscard]]
+    wchar_t load_sections_in_parallel(const wchar_t* words, const size_t length,
+                                      tokenize::document_tokenize<>& tokenize_text,
+                                      syllable_counter& countSyllables)
+        {
+        const wchar_t* const textEnd = words + length;
+        std::vector<const wchar_t*> sectionStarts{ words };
+        while (static_cast<size_t>(textEnd - sectionStarts.back()) > m_parallel_section_length)
+            {
+            const wchar_t* const sectionStart = tokenize_text.find_paragraph_break(
+                sectionStarts.back() + m_parallel_section_length);
+            if (sectionStart == textEnd)
+                { break; }
+            sectionStarts.push_back(sectionStart);
+            }
+        sectionStarts.push_back(textEnd);
+
+        // the first section is read by the main tokenizer, the rest by the workers
+        std::vector<tokenized_section> sections(sectionStarts.size() - 1);
+        std::atomic<size_t> nextSection{ 1 };
+        const bool timeSyllabizing = countSyllables.is_timing();
+        const auto readSections = [&]()
+            {
+            // syllabizers keep state while counting, so each thread needs its own
+            const auto syllabizer = syllabize->clone();
+            for (size_t i = nextSection++; i < sections.size(); i = nextSection++)
+                {
+                read_section(words, length, sectionStarts[i], sectionStarts[i + 1],
+                             *syllabizer, timeSyllabizing, sections[i]);
+                }
+            };
+        // the main thread reads the first section (and then helps with the rest)
+        const size_t workerCount = std::min<size_t>(sections.size() - 1,
+            std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+        std::vector<std::future<void>> workers;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+            { workers.push_back(std::async(std::launch::async, readSections)); }
+
+        // the tokenizer that the document is being read from, and the amounts to shift
+        // its sentence, paragraph, and word indices by
+        tokenize::document_tokenize<>* currentTokenizer = &tokenize_text;
+        size_t sentenceOffset{ 0 };
+        size_t paragraphOffset{ 0 };
+        size_t wordOffset{ 0 };
+        // how many of the current tokenizer's punctuation marks are in the document
+        size_t punctuationRead{ 0 };
+        const wchar_t* lastWord{ nullptr };
+        bool reachedEnd{ false };
+        token_info token;
+        word_list::word_type splitWordNoHyphens;
+
+        const auto addPunctuation = [&]()
+            {
+            const auto& marks = currentTokenizer->get_punctuation();
+            for (size_t i = punctuationRead; i < marks.size(); ++i)
+                {
+                m_punctuation.emplace_back(marks[i].get_punctuation_mark(),
+                                           marks[i].get_word_position() + wordOffset,
+                                           marks[i].is_connected_to_previous_word());
+                }
+            punctuationRead = marks.size();
+            };
+        // reads from the current tokenizer through the first word of the next section
+        const auto readThrough = [&](const wchar_t* sectionEnd)
+            {
+            while (lastWord == nullptr || lastWord < sectionEnd)
+                {
+                const wchar_t* const current_char = (*currentTokenizer)();
+                if (current_char == nullptr)
+                    {
+                    reachedEnd = true;
+                    break;
+                    }
+                read_token(current_char, *currentTokenizer, countSyllables, splitWordNoHyphens,
+                           token);
+                add_token(token, sentenceOffset, paragraphOffset);
+                lastWord = current_char;
+                }
+            addPunctuation();
+            };
+
+        readThrough(sectionStarts[1]);
+        readSections();
+        // rethrows anything thrown by the workers
+        for (auto& worker : workers)
+            { worker.get(); }
+
+        for (size_t i = 1; i < sections.size() && !reachedEnd; ++i)
+            {
+            auto& section = sections[i];
+            countSyllables.add_time(section.m_syllabize_time);
+            /* The section can be joined if it starts on the last word read and the tokenizer
+               was left in the same state after reading that word.
+               The check for table of contents lines only looks at punctuation read after that,
+               except that it also needs more than two marks in total. The section's tokenizer
+               stands in one mark for the punctuation in front of the section, so the document
+               needs to have some punctuation already also.*/
+            if (section.m_first_word != nullptr && section.m_first_word == lastWord &&
+                !m_punctuation.empty() &&
+                section.m_first_word_state == currentTokenizer->get_resume_state())
+                {
+                // unsigned arithmetic wraps around, so these are fine even if
+                // the section's counters are ahead of the document's
+                sentenceOffset = (currentTokenizer->get_current_sentence_index() + sentenceOffset) -
+                    section.m_first_word_sentence_index;
+                paragraphOffset =
+                    (currentTokenizer->get_current_paragraph_index() + paragraphOffset) -
+                    section.m_first_word_paragraph_index;
+                // the section's first word is its word zero
+                wordOffset = m_words.size() - 1;
+                for (const auto& sectionToken : section.m_tokens)
+                    { add_token(sectionToken, sentenceOffset, paragraphOffset); }
+                currentTokenizer = &section.m_tokenizer.value();
+                punctuationRead = section.m_first_word_punctuation_count;
+                addPunctuation();
+                if (!section.m_tokens.empty())
+                    { lastWord = section.m_tokens.back().m_start; }
+                reachedEnd = section.m_reached_end;
+                }
+            // otherwise, keep reading from where the last section left off
+            else
+                { readThrough(sectionStarts[i + 1]); }
+            }
+
+        return currentTokenizer->get_current_sentence_ending_punctuation();
+        }
+
     void search_for_excluded_words()
         {
         PROFILE();
@@ -2519,6 +2837,8 @@ private:
     bool m_ignore_blank_lines_when_determing_paragraph_split{ false };
     bool m_ignore_indenting_when_determing_paragraph_split{ false };
     bool m_sentence_start_must_be_uppercased{ false };
+    bool m_tokenize_in_parallel{ false };
+    size_t m_parallel_section_length{ 64 * 1024 };
     bool m_ignore_trailing_copyright_notice_paragraphs{ true };
     bool m_ignore_citation_sections{ true };
     bool m_treat_header_words_as_valid{ false };
@@ -18,8 +18,17 @@
 #include "../Wisteria-Dataviz/src/util/string_util.h"
 #include "abbreviation.h"
 #include "characters.h"
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 /** @brief Counting/Searching functor for `std::count_if` or `std::find`
@@ -887,6 +896,140 @@ class is_file_extension
     static std::set<traits::case_insensitive_wstring_ex> m_file_extensions;
     };
 
+/** @brief Thread-safe cache of spelling verdicts, which can be shared between spell checkers
+        (e.g., the ones used by every document in a batch).
+    @details Only the dictionary-based part of a spelling check is cached (i.e., looking the
+        word up in the word lists and checking for programmer code and colloquialisms), which is
+        keyed by the word's exact text and the spell checker options that affect it.
+
+        Verdicts are tied to the word lists (and their revisions) that they were based on;
+        if a word list is edited (e.g., words are added to a custom dictionary), then the
+        cached verdicts are discarded the next time that a verdict is added.
+    @note A cache should only be shared between spell checkers that use the same word lists
+        (e.g., one cache per language), otherwise they will keep discarding each other's
+        verdicts.*/
+class spelling_verdict_cache
+    {
+  public:
+    /// @brief The word lists (and their revisions) that verdicts are based on.
+    struct dictionary_stamp
+        {
+        /// @brief The main, secondary, and programmer word lists.
+        std::array<const void*, 3> m_word_lists{ nullptr, nullptr, nullptr };
+        /// @brief The revisions of the respective word lists.
+        std::array<size_t, 3> m_revisions{ 0, 0, 0 };
+        /// @private
+        [[nodiscard]]
+        bool operator==(const dictionary_stamp&) const = default;
+        };
+
+    /// @private
+    spelling_verdict_cache() = default;
+    /// @private
+    spelling_verdict_cache(const spelling_verdict_cache&) = delete;
+    /// @private
+    spelling_verdict_cache& operator=(const spelling_verdict_cache&) = delete;
+
+    /** @returns The cached verdict for a word, or @c std::nullopt if not cached.
+        @param word The word's text.
+        @param options The spell checker options (and word flags) that the verdict depends on.
+        @param stamp The word lists that the spell checker is using.*/
+    [[nodiscard]]
+    std::optional<bool> find(const std::wstring_view word, const uint8_t options,
+                             const dictionary_stamp& stamp) const
+        {
+        std::shared_lock lock(m_mutex);
+        if (stamp != m_stamp)
+            {
+            return std::nullopt;
+            }
+        const auto verdictPos = m_verdicts.find(key_view{ word, options });
+        return (verdictPos != m_verdicts.cend()) ? std::optional<bool>(verdictPos->second) :
+                                                   std::nullopt;
+        }
+
+    /** @brief Adds a verdict for a word.
+        @param word The word's text.
+        @param options The spell checker options (and word flags) that the verdict depends on.
+        @param stamp The word lists that the spell checker is using.
+        @param isCorrect Whether the word is spelled correctly.*/
+    void insert(const std::wstring_view word, const uint8_t options,
+                const dictionary_stamp& stamp, const bool isCorrect)
+        {
+        std::unique_lock lock(m_mutex);
+        // verdicts from edited (or different) word lists are stale, and
+        // the cache is restarted if it grows out of hand
+        if (stamp != m_stamp || m_verdicts.size() >= MAX_VERDICTS)
+            {
+            m_verdicts.clear();
+            m_stamp = stamp;
+            }
+        m_verdicts.try_emplace(key{ std::wstring{ word }, options }, isCorrect);
+        }
+
+    /// @brief Removes all cached verdicts.
+    void clear()
+        {
+        std::unique_lock lock(m_mutex);
+        m_verdicts.clear();
+        m_stamp = dictionary_stamp{};
+        }
+
+    /// @returns The number of cached verdicts.
+    [[nodiscard]]
+    size_t size() const
+        {
+        std::shared_lock lock(m_mutex);
+        return m_verdicts.size();
+        }
+
+  private:
+    struct key_view
+        {
+        std::wstring_view m_word;
+        uint8_t m_options{ 0 };
+        };
+
+    struct key
+        {
+        std::wstring m_word;
+        uint8_t m_options{ 0 };
+
+        operator key_view() const noexcept { return key_view{ m_word, m_options }; }
+        };
+
+    // hashing and comparing work with either keys or views of them,
+    // so that looking up a word doesn't copy it
+    struct key_hash
+        {
+        using is_transparent = void;
+
+        [[nodiscard]]
+        size_t operator()(const key_view& value) const noexcept
+            {
+            return std::hash<std::wstring_view>{}(value.m_word) ^
+                   (static_cast<size_t>(value.m_options) * 0x9E37'79B9U);
+            }
+        };
+
+    struct key_equal
+        {
+        using is_transparent = void;
+
+        [[nodiscard]]
+        bool operator()(const key_view& first, const key_view& second) const noexcept
+            {
+            return first.m_options == second.m_options && first.m_word == second.m_word;
+            }
+        };
+
+    constexpr static size_t MAX_VERDICTS{ 250'000 };
+
+    mutable std::shared_mutex m_mutex;
+    dictionary_stamp m_stamp;
+    std::unordered_map<key, bool, key_hash, key_equal> m_verdicts;
+    };
+
 /** @brief Used for spell checking.
     @details Performs a binary search through a list of known words to see if the provided
         value is in there. Also takes into account whether the word is
@@ -1064,17 +1207,11 @@ class is_correctly_spelled_word
                                                                  // uppercased words
             (is_ignoring_uppercased() && (the_word.is_acronym() || the_word.is_exclamatory())) ||
             // file address
-            (is_ignoring_file_addresses() &&
-             (the_word.is_file_address() ||
-              is_file_extension::is_extension(the_word.c_str()))) ||
+            (is_ignoring_file_addresses() && the_word.is_file_address()) ||
             // hashtags
             (is_ignoring_social_media_tags() && the_word.is_social_media_tag()) ||
             // proper noun
             (is_ignoring_proper_nouns() && the_word.is_proper_noun()) ||
-            // or programmer code
-            (is_ignoring_programmer_code() && is_programmer_code(the_word)) ||
-            // or colloquialisms
-            (is_allowing_colloquialisms() && is_colloquialisms(the_word)) ||
             // if initials (or dotted acronym) then always consider it spelled properly
             ((the_word.is_exclamatory() || the_word.is_acronym()) &&
              ((the_word.length() == 2 && the_word.operator[](1) == common_lang_constants::PERIOD) ||
@@ -1083,16 +1220,85 @@ class is_correctly_spelled_word
             {
             return true;
             }
-        else
-            {
-            return is_on_list(the_word);
-            }
         // clang-format on
+        // file extension, programmer code, colloquialisms, or on the word lists
+        return is_known_spelling_cached(the_word,
+                                        (the_word.is_acronym() || the_word.is_numeric()));
+        }
+
+    /** @brief Stem-free spelling check for text that has not been indexed as a word yet
+            (e.g., the candidate spellings of a word split across lines).
+        @details This gives the same result as calling operator() with a newly constructed
+            word (i.e., one without any flags, such as numeric or acronym, set), but without
+            constructing (and stemming) one.
+        @param the_word The text to review.
+        @returns @c true if spelled correctly.*/
+    [[nodiscard]]
+    bool is_known_spelling(const typename wordlistT::word_type& the_word) const
+        {
+        return is_known_spelling_cached(the_word, false);
+        }
+
+    /** @brief Sets the cache of spelling verdicts to share with other spell checkers.
+        @param cache The cache, or @c nullptr to not cache verdicts.
+        @note The cache is not owned by the spell checker and must outlive it.*/
+    void set_verdict_cache(spelling_verdict_cache* cache) noexcept { m_verdict_cache = cache; }
+
+    /// @returns The cache of spelling verdicts, or @c nullptr if not caching.
+    [[nodiscard]]
+    spelling_verdict_cache* get_verdict_cache() const noexcept
+        {
+        return m_verdict_cache;
         }
 
   private:
+    /// @returns @c true if the word is a file extension, programmer code, a colloquialism,
+    ///     or on the word lists, looking up (and saving) the verdict in the verdict cache.
+    /// @param the_word The word to review.
+    /// @param isAcronymOrNumeric Whether the word is flagged as an acronym or number
+    ///     (which is always considered programmer code).
+    template<typename T>
     [[nodiscard]]
-    bool is_colloquialisms(const word_typeT& the_word) const
+    bool is_known_spelling_cached(const T& the_word, const bool isAcronymOrNumeric) const
+        {
+        const auto isKnownSpelling = [this, &the_word]()
+        {
+            return ((is_ignoring_file_addresses() &&
+                     is_file_extension::is_extension(the_word.c_str())) ||
+                    (is_ignoring_programmer_code() && is_programmer_code(the_word)) ||
+                    (is_allowing_colloquialisms() && is_colloquialisms(the_word)) ||
+                    is_on_list(the_word));
+        };
+        if (m_verdict_cache == nullptr || the_word.length() == 0)
+            {
+            return isKnownSpelling();
+            }
+
+        // the options that the verdict depends on
+        const uint8_t options = (is_ignoring_uppercased() ? 1 : 0) |
+                                (is_ignoring_file_addresses() ? 1 << 1 : 0) |
+                                (is_ignoring_programmer_code() ? 1 << 2 : 0) |
+                                (is_allowing_colloquialisms() ? 1 << 3 : 0) |
+                                (isAcronymOrNumeric ? 1 << 4 : 0);
+        spelling_verdict_cache::dictionary_stamp stamp;
+        stamp.m_word_lists = { m_wordlist, m_secondary_wordlist, m_programmer_wordlist };
+        stamp.m_revisions = { (m_wordlist ? m_wordlist->get_revision() : 0),
+                              (m_secondary_wordlist ? m_secondary_wordlist->get_revision() : 0),
+                              (m_programmer_wordlist ? m_programmer_wordlist->get_revision() : 0) };
+
+        const std::wstring_view text{ the_word.c_str(), the_word.length() };
+        if (const auto verdict = m_verdict_cache->find(text, options, stamp); verdict)
+            {
+            return verdict.value();
+            }
+        const bool isKnown = isKnownSpelling();
+        m_verdict_cache->insert(text, options, stamp, isKnown);
+        return isKnown;
+        }
+
+    template<typename T>
+    [[nodiscard]]
+    bool is_colloquialisms(const T& the_word) const
         {
         typename wordlistT::word_type alteredWord = the_word.c_str();
         // strip off "'s" to make things simple
@@ -1188,18 +1394,23 @@ class is_correctly_spelled_word
     /// @note This function does not narrow full-width characters,
     ///     it assumes programmer code is ASCII text.\n
     ///     It is also sensitive to casing, unlike other functions in the spell checker.
+    template<typename T>
     [[nodiscard]]
-    bool is_programmer_code(const word_typeT& the_word) const
+    bool is_programmer_code(const T& the_word) const
         {
         // Single uppercase word (not in a block of other uppercased words)
         // is probably a constant or macro command.
         // Ignore numbers explicitly too.
-        if (the_word.is_acronym() || the_word.is_numeric())
+        // (Plain strings don't have these flags, so they skip this check.)
+        if constexpr (requires { the_word.is_acronym(); })
             {
-            return true;
+            if (the_word.is_acronym() || the_word.is_numeric())
+                {
+                return true;
+                }
             }
         // ignore UI ampersand with escaping ampersand in front of it.
-        else if (the_word.length() == 2 && the_word[0] == L'&' && the_word[1] == L'&')
+        if (the_word.length() == 2 && the_word[0] == L'&' && the_word[1] == L'&')
             {
             return true;
             }
@@ -1237,11 +1448,9 @@ class is_correctly_spelled_word
             }
         // if it contains an underscore (common for variables),
         // percent (like a printf command), or accessors
-        else if (the_word.find(L'_') != word_typeT::npos ||
-                 the_word.find(L'%') != word_typeT::npos ||
+        else if (the_word.find(L'_') != T::npos || the_word.find(L'%') != T::npos ||
                  // C++ accessors
-                 the_word.find(L"::") != word_typeT::npos ||
-                 the_word.find(L"->") != word_typeT::npos)
+                 the_word.find(L"::") != T::npos || the_word.find(L"->") != T::npos)
             {
             return true;
             }
@@ -1325,15 +1534,28 @@ class is_correctly_spelled_word
             } // no list or word is blank, then don't bother looking
 
         // first, see if the full word is already in our dictionaries
-        typename wordlistT::word_type compValue{ the_word.c_str() };
-        if (std::binary_search(m_wordlist->get_words().begin(), m_wordlist->get_words().end(),
-                               compValue) ||
-            std::binary_search(m_secondary_wordlist->get_words().begin(),
-                               m_secondary_wordlist->get_words().end(), compValue))
+        // (searching for it directly if it is already the lists' string type)
+        const auto isOnEitherList = [this](const typename wordlistT::word_type& value)
+        {
+            return std::binary_search(m_wordlist->get_words().begin(),
+                                      m_wordlist->get_words().end(), value) ||
+                   std::binary_search(m_secondary_wordlist->get_words().begin(),
+                                      m_secondary_wordlist->get_words().end(), value);
+        };
+        if constexpr (std::is_same_v<T, typename wordlistT::word_type>)
+            {
+            if (isOnEitherList(the_word))
+                {
+                return true;
+                }
+            }
+        else if (isOnEitherList(typename wordlistT::word_type{ the_word.c_str() }))
             {
             return true;
             }
 
+        typename wordlistT::word_type compValue;
+
         // see if the word is a hyphenated (or slashed) compound word
         string_util::string_tokenize<T> tkzr(
             the_word, common_lang_constants::COMPOUND_WORD_SEPARATORS.c_str(), true);
@@ -1389,6 +1611,8 @@ class is_correctly_spelled_word
     bool m_ignore_programmer_code{ false };
     bool m_allow_colloquialisms{ true };
     bool m_ignore_social_media_tags{ true };
+    // verdicts shared with other spell checkers (not owned)
+    spelling_verdict_cache* m_verdict_cache{ nullptr };
     grammar::is_acronym isAcronym;
     };
 
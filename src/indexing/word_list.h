@@ -19,6 +19,7 @@
 #include "../Wisteria-Dataviz/src/util/string_util.h"
 #include "character_traits.h"
 #include <algorithm>
+#include <atomic>
 #include <map>
 
 /** @brief Container class for encapsulating a list of words.*/
@@ -44,6 +45,7 @@ class word_list
             @c true will preserve them.*/
     void load_words(const wchar_t* text, const bool sort_list, const bool preserve_words)
         {
+        ++m_revision;
         if (!preserve_words)
             {
             m_words.clear();
@@ -97,6 +99,7 @@ class word_list
         @param theWord The word to be added.*/
     void add_word(const word_type& theWord)
         {
+        ++m_revision;
         std::vector<word_type>::iterator insertionPoint =
             std::lower_bound(m_words.begin(), m_words.end(), theWord);
         m_words.insert(insertionPoint, theWord);
@@ -106,6 +109,7 @@ class word_list
         @param theWords A list of words to add.*/
     void add_words(const std::vector<word_type>& theWords)
         {
+        ++m_revision;
         const size_t previousSize = get_list_size();
         m_words.resize(m_words.size() + theWords.size());
         std::copy(theWords.cbegin(), theWords.cend(), m_words.begin() + previousSize);
@@ -113,11 +117,16 @@ class word_list
         }
 
     /** @brief Sorts the word list (in A-Z [ascending] order).*/
-    void sort() noexcept { std::sort(m_words.begin(), m_words.end()); }
+    void sort() noexcept
+        {
+        ++m_revision;
+        std::sort(m_words.begin(), m_words.end());
+        }
 
     /** @brief Sorts and removes any duplicate words in the list.*/
     void remove_duplicates()
         {
+        ++m_revision;
         sort();
         std::vector<word_type>::iterator endOfUniquePos =
             std::unique(m_words.begin(), m_words.end());
@@ -128,7 +137,11 @@ class word_list
         }
 
     /** @brief Clears the word list.*/
-    void clear() noexcept { m_words.clear(); }
+    void clear() noexcept
+        {
+        ++m_revision;
+        m_words.clear();
+        }
 
     /** @returns Whether the list is sorted (in ascending order).*/
     [[nodiscard]]
@@ -148,8 +161,19 @@ class word_list
         return true;
         }
 
+    /** @returns A number that changes whenever the list is edited.
+        @details This is used by anything that caches results based on the list's content
+            (e.g., spelling_verdict_cache) to tell if those results are out of date.\n
+            Those caches are process-wide and read this from several threads, so it is atomic.*/
+    [[nodiscard]]
+    size_t get_revision() const noexcept
+        {
+        return m_revision.load();
+        }
+
   private:
     std::vector<word_type> m_words;
+    std::atomic<size_t> m_revision{ 0 };
     };
 
 /** @brief Container class for encapsulating a list of words, with suggested replacements.*/
@@ -0,0 +1,588 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "lua_analysis_views.h"
+#include <algorithm>
+#include <limits>
+#include <new>
+
+// NOLINTBEGIN(readability-identifier-length)
+// NOLINTBEGIN(readability-implicit-bool-conversion)
+
+namespace
+    {
+    constexpr char ANALYSIS_ARRAY_METATABLE[] = "AnalysisArray";
+    constexpr char ANALYSIS_TABLE_METATABLE[] = "AnalysisTable";
+
+    using LuaScripting::AnalysisArrayType;
+
+    /// @brief The userdata behind an array view.
+    struct AnalysisArray
+        {
+        std::shared_ptr<const CaseInSensitiveNonStemmingDocument> m_document;
+        // only used for table columns
+        std::shared_ptr<const std::vector<double>> m_values;
+        AnalysisArrayType m_type{ AnalysisArrayType::WordText };
+        };
+
+    /// @brief The userdata behind a table view.
+    struct AnalysisTable
+        {
+        std::shared_ptr<const LuaScripting::AnalysisTableData> m_data;
+        };
+
+    //-------------------------------------------------------------
+    [[nodiscard]]
+    AnalysisArray& CheckArray(lua_State* L, const int index)
+        {
+        return *static_cast<AnalysisArray*>(luaL_checkudata(L, index, ANALYSIS_ARRAY_METATABLE));
+        }
+
+    //-------------------------------------------------------------
+    [[nodiscard]]
+    AnalysisTable& CheckTable(lua_State* L, const int index)
+        {
+        return *static_cast<AnalysisTable*>(luaL_checkudata(L, index, ANALYSIS_TABLE_METATABLE));
+        }
+
+    //-------------------------------------------------------------
+    [[nodiscard]]
+    size_t GetLength(const AnalysisArray& array)
+        {
+        if (array.m_type == AnalysisArrayType::TableColumn)
+            {
+            return (array.m_values != nullptr) ? array.m_values->size() : 0;
+            }
+        if (array.m_document == nullptr)
+            {
+            return 0;
+            }
+
+        switch (array.m_type)
+            {
+        case AnalysisArrayType::WordText:
+            [[fallthrough]];
+        case AnalysisArrayType::WordSyllableCounts:
+            [[fallthrough]];
+        case AnalysisArrayType::WordCharacterCounts:
+            [[fallthrough]];
+        case AnalysisArrayType::WordSentenceIndices:
+            [[fallthrough]];
+        case AnalysisArrayType::WordValidity:
+            return array.m_document->get_words().size();
+        case AnalysisArrayType::SentenceWordCounts:
+            [[fallthrough]];
+        case AnalysisArrayType::SentenceFirstWordIndices:
+            [[fallthrough]];
+        case AnalysisArrayType::SentenceValidity:
+            return array.m_document->get_sentences().size();
+        case AnalysisArrayType::ParagraphSentenceCounts:
+            [[fallthrough]];
+        case AnalysisArrayType::ParagraphFirstSentenceIndices:
+            return array.m_document->get_paragraphs().size();
+        case AnalysisArrayType::RepeatedWordIndices:
+            return array.m_document->get_duplicate_word_indices().size();
+        case AnalysisArrayType::ArticleMismatchIndices:
+            return array.m_document->get_incorrect_article_indices().size();
+        case AnalysisArrayType::PassiveVoiceIndices:
+            return array.m_document->get_passive_voice_indices().size();
+        case AnalysisArrayType::ConjunctionStartingSentenceIndices:
+            return array.m_document->get_conjunction_beginning_sentences().size();
+        case AnalysisArrayType::LowercasedSentenceIndices:
+            return array.m_document->get_lowercase_beginning_sentences().size();
+        default:
+            return 0;
+            }
+        }
+
+    /** @brief Calls @c fn with the numeric value of each item in [first, last).
+        @details The switch is done once per call, rather than once per item,
+            so that reductions run as tight loops over the document's own vectors.
+        @note Word text has no numeric value, so nothing is visited for it.*/
+    template<typename Fn>
+    void VisitNumbers(const AnalysisArray& array, const size_t first, const size_t last, Fn fn)
+        {
+        if (first >= last ||
+            (array.m_type == AnalysisArrayType::TableColumn ? array.m_values == nullptr :
+                                                              array.m_document == nullptr))
+            {
+            return;
+            }
+        const auto visit = [first, last, &fn](const auto& values, const auto& toNumber)
+        {
+            for (size_t i = first; i < last; ++i)
+                {
+                fn(static_cast<double>(toNumber(values[i])));
+                }
+        };
+        // indices are returned 1-based, so that they can be used to index other views
+        const auto toLuaIndex = [](const size_t index) { return index + 1; };
+
+        switch (array.m_type)
+            {
+        case AnalysisArrayType::WordSyllableCounts:
+            visit(array.m_document->get_words(),
+                  [](const auto& word) { return word.get_syllable_count(); });
+            break;
+        case AnalysisArrayType::WordCharacterCounts:
+            visit(array.m_document->get_words(),
+                  [](const auto& word) { return word.get_length_excluding_punctuation(); });
+            break;
+        case AnalysisArrayType::WordSentenceIndices:
+            visit(array.m_document->get_words(),
+                  [](const auto& word) { return word.get_sentence_index() + 1; });
+            break;
+        case AnalysisArrayType::WordValidity:
+            visit(array.m_document->get_words(),
+                  [](const auto& word) { return word.is_valid() ? 1 : 0; });
+            break;
+        case AnalysisArrayType::SentenceWordCounts:
+            visit(array.m_document->get_sentences(),
+                  [](const auto& sentence) { return sentence.get_word_count(); });
+            break;
+        case AnalysisArrayType::SentenceFirstWordIndices:
+            visit(array.m_document->get_sentences(),
+                  [](const auto& sentence) { return sentence.get_first_word_index() + 1; });
+            break;
+        case AnalysisArrayType::SentenceValidity:
+            visit(array.m_document->get_sentences(),
+                  [](const auto& sentence) { return sentence.is_valid() ? 1 : 0; });
+            break;
+        case AnalysisArrayType::ParagraphSentenceCounts:
+            visit(array.m_document->get_paragraphs(),
+                  [](const auto& paragraph) { return paragraph.get_sentence_count(); });
+            break;
+        case AnalysisArrayType::ParagraphFirstSentenceIndices:
+            visit(array.m_document->get_paragraphs(), [](const auto& paragraph)
+                  { return paragraph.get_first_sentence_index() + 1; });
+            break;
+        case AnalysisArrayType::RepeatedWordIndices:
+            visit(array.m_document->get_duplicate_word_indices(), toLuaIndex);
+            break;
+        case AnalysisArrayType::ArticleMismatchIndices:
+            visit(array.m_document->get_incorrect_article_indices(), toLuaIndex);
+            break;
+        case AnalysisArrayType::PassiveVoiceIndices:
+            visit(array.m_document->get_passive_voice_indices(),
+                  [](const auto& phrase) { return phrase.first + 1; });
+            break;
+        case AnalysisArrayType::ConjunctionStartingSentenceIndices:
+            visit(array.m_document->get_conjunction_beginning_sentences(), toLuaIndex);
+            break;
+        case AnalysisArrayType::LowercasedSentenceIndices:
+            visit(array.m_document->get_lowercase_beginning_sentences(), toLuaIndex);
+            break;
+        case AnalysisArrayType::TableColumn:
+            visit(*array.m_values, [](const double value) { return value; });
+            break;
+        default:
+            break;
+            }
+        }
+
+    //-------------------------------------------------------------
+    [[nodiscard]]
+    bool IsBoolean(const AnalysisArrayType arrayType) noexcept
+        {
+        return arrayType == AnalysisArrayType::WordValidity ||
+               arrayType == AnalysisArrayType::SentenceValidity;
+        }
+
+    /// @brief Pushes the item at a 0-based index (which must be in range).
+    void PushArrayItem(lua_State* L, const AnalysisArray& array, const size_t index)
+        {
+        if (array.m_type == AnalysisArrayType::WordText)
+            {
+            const auto& word = array.m_document->get_word(index);
+            lua_pushstring(L, wxString{ word.c_str(), word.length() }.utf8_str());
+            return;
+            }
+        VisitNumbers(array, index, index + 1,
+                     [L, &array](const double value)
+                     {
+                         if (IsBoolean(array.m_type))
+                             {
+                             lua_pushboolean(L, value != 0);
+                             }
+                         else if (array.m_type == AnalysisArrayType::TableColumn)
+                             {
+                             lua_pushnumber(L, value);
+                             }
+                         else
+                             {
+                             lua_pushinteger(L, static_cast<lua_Integer>(value));
+                             }
+                     });
+        }
+
+    /** @returns The 0-based index from a 1-based Lua index at @c stackIndex,
+            or @c -1 if it isn't a whole number within @c [1, length].*/
+    [[nodiscard]]
+    ptrdiff_t GetZeroBasedIndex(lua_State* L, const int stackIndex, const size_t length)
+        {
+        int isNumber{ 0 };
+        const lua_Integer index = lua_tointegerx(L, stackIndex, &isNumber);
+        if (!isNumber || index < 1 || static_cast<size_t>(index) > length)
+            {
+            return -1;
+            }
+        return static_cast<ptrdiff_t>(index - 1);
+        }
+
+    //-------------------------------------------------------------
+    void VerifyNumericArray(lua_State* L, const AnalysisArray& array, const char* functionName)
+        {
+        if (array.m_type == AnalysisArrayType::WordText)
+            {
+            luaL_error(L, "%s: word text has no numeric values.", functionName);
+            }
+        }
+
+    // AnalysisArray methods
+    //-------------------------------------------------------------
+    int ArrayIndex(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        if (lua_type(L, 2) == LUA_TNUMBER)
+            {
+            const auto index = GetZeroBasedIndex(L, 2, GetLength(array));
+            if (index < 0)
+                {
+                lua_pushnil(L);
+                }
+            else
+                {
+                PushArrayItem(L, array, static_cast<size_t>(index));
+                }
+            return 1;
+            }
+        // otherwise, look up the method (the methods table is the upvalue)
+        lua_pushvalue(L, 2);
+        lua_gettable(L, lua_upvalueindex(1));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayLength(lua_State* L)
+        {
+        lua_pushinteger(L, static_cast<lua_Integer>(GetLength(CheckArray(L, 1))));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayToString(lua_State* L)
+        {
+        lua_pushfstring(L, "%s (%I values)", ANALYSIS_ARRAY_METATABLE,
+                        static_cast<lua_Integer>(GetLength(CheckArray(L, 1))));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayCollect(lua_State* L)
+        {
+        CheckArray(L, 1).~AnalysisArray();
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int ArraySum(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        VerifyNumericArray(L, array, __func__);
+        double total{ 0 };
+        VisitNumbers(array, 0, GetLength(array), [&total](const double value) { total += value; });
+        lua_pushnumber(L, total);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayMean(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        VerifyNumericArray(L, array, __func__);
+        const size_t length = GetLength(array);
+        if (length == 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        double total{ 0 };
+        VisitNumbers(array, 0, length, [&total](const double value) { total += value; });
+        lua_pushnumber(L, total / static_cast<double>(length));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayMin(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        VerifyNumericArray(L, array, __func__);
+        const size_t length = GetLength(array);
+        if (length == 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        double minValue{ std::numeric_limits<double>::max() };
+        VisitNumbers(array, 0, length,
+                     [&minValue](const double value) { minValue = std::min(minValue, value); });
+        lua_pushnumber(L, minValue);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int ArrayMax(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        VerifyNumericArray(L, array, __func__);
+        const size_t length = GetLength(array);
+        if (length == 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        double maxValue{ std::numeric_limits<double>::lowest() };
+        VisitNumbers(array, 0, length,
+                     [&maxValue](const double value) { maxValue = std::max(maxValue, value); });
+        lua_pushnumber(L, maxValue);
+        return 1;
+        }
+
+    /// @brief Copies the view into a regular Lua table
+    ///     (for scripts that need to sort or modify the values).
+    int ArrayToTable(lua_State* L)
+        {
+        const auto& array = CheckArray(L, 1);
+        const size_t length = GetLength(array);
+        lua_createtable(
+            L, static_cast<int>(std::min<size_t>(length, std::numeric_limits<int>::max())), 0);
+        for (size_t i = 0; i < length; ++i)
+            {
+            PushArrayItem(L, array, i);
+            lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+            }
+        return 1;
+        }
+
+    // AnalysisTable methods
+    //-------------------------------------------------------------
+    [[nodiscard]]
+    ptrdiff_t GetColumnIndex(lua_State* L, const LuaScripting::AnalysisTableData& data,
+                             const int stackIndex)
+        {
+        if (lua_type(L, stackIndex) == LUA_TNUMBER)
+            {
+            return GetZeroBasedIndex(L, stackIndex, data.m_columnNames.size());
+            }
+        const wxString columnName(luaL_checkstring(L, stackIndex), wxConvUTF8);
+        const auto columnPos =
+            std::find_if(data.m_columnNames.cbegin(), data.m_columnNames.cend(),
+                         [&columnName](const auto& name)
+                         { return name.CmpNoCase(columnName) == 0; });
+        return (columnPos == data.m_columnNames.cend()) ?
+                   -1 :
+                   std::distance(data.m_columnNames.cbegin(), columnPos);
+        }
+
+    //-------------------------------------------------------------
+    int TableIndex(lua_State* L)
+        {
+        CheckTable(L, 1);
+        lua_pushvalue(L, 2);
+        lua_gettable(L, lua_upvalueindex(1));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableRowCount(lua_State* L)
+        {
+        lua_pushinteger(L,
+                        static_cast<lua_Integer>(CheckTable(L, 1).m_data->m_documentPaths.size()));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableColumnCount(lua_State* L)
+        {
+        lua_pushinteger(L,
+                        static_cast<lua_Integer>(CheckTable(L, 1).m_data->m_columnNames.size()));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableToString(lua_State* L)
+        {
+        const auto& data = *CheckTable(L, 1).m_data;
+        lua_pushfstring(L, "%s (%I rows, %I columns)", ANALYSIS_TABLE_METATABLE,
+                        static_cast<lua_Integer>(data.m_documentPaths.size()),
+                        static_cast<lua_Integer>(data.m_columnNames.size()));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableCollect(lua_State* L)
+        {
+        CheckTable(L, 1).~AnalysisTable();
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int TableGetColumnName(lua_State* L)
+        {
+        const auto& data = *CheckTable(L, 1).m_data;
+        const auto column = GetZeroBasedIndex(L, 2, data.m_columnNames.size());
+        if (column < 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        lua_pushstring(L, data.m_columnNames[column].utf8_str());
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableGetColumn(lua_State* L)
+        {
+        const auto& table = CheckTable(L, 1);
+        const auto column = GetColumnIndex(L, *table.m_data, 2);
+        if (column < 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        auto* array = static_cast<AnalysisArray*>(lua_newuserdatauv(L, sizeof(AnalysisArray), 0));
+        new (array) AnalysisArray{ nullptr,
+                                   // aliasing constructor, so that the column keeps
+                                   // the whole table alive
+                                   std::shared_ptr<const std::vector<double>>(
+                                       table.m_data, table.m_data->m_columns[column].get()),
+                                   AnalysisArrayType::TableColumn };
+        luaL_setmetatable(L, ANALYSIS_ARRAY_METATABLE);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableGetValue(lua_State* L)
+        {
+        const auto& data = *CheckTable(L, 1).m_data;
+        const auto row = GetZeroBasedIndex(L, 2, data.m_documentPaths.size());
+        const auto column = GetColumnIndex(L, data, 3);
+        if (row < 0 || column < 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        lua_pushnumber(L, data.m_columns[column]->at(row));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableGetDocumentPath(lua_State* L)
+        {
+        const auto& data = *CheckTable(L, 1).m_data;
+        const auto row = GetZeroBasedIndex(L, 2, data.m_documentPaths.size());
+        if (row < 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        lua_pushstring(L, data.m_documentPaths[row].utf8_str());
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int TableGetDocumentLabel(lua_State* L)
+        {
+        const auto& data = *CheckTable(L, 1).m_data;
+        const auto row = GetZeroBasedIndex(L, 2, data.m_documentLabels.size());
+        if (row < 0)
+            {
+            lua_pushnil(L);
+            return 1;
+            }
+        lua_pushstring(L, data.m_documentLabels[row].utf8_str());
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    void RegisterMetatable(lua_State* L, const char* name, const luaL_Reg* metamethods,
+                           const luaL_Reg* methods, const lua_CFunction indexFunction)
+        {
+        luaL_newmetatable(L, name);
+        luaL_setfuncs(L, metamethods, 0);
+        // __index is a closure over the methods table,
+        // so that it can handle numeric keys as well as method names
+        lua_newtable(L);
+        luaL_setfuncs(L, methods, 0);
+        lua_pushcclosure(L, indexFunction, 1);
+        lua_setfield(L, -2, "__index");
+        lua_pop(L, 1);
+        }
+    } // namespace
+
+namespace LuaScripting
+    {
+    //-------------------------------------------------------------
+    void PushAnalysisArray(lua_State* L,
+                           std::shared_ptr<const CaseInSensitiveNonStemmingDocument> document,
+                           const AnalysisArrayType arrayType)
+        {
+        auto* array = static_cast<AnalysisArray*>(lua_newuserdatauv(L, sizeof(AnalysisArray), 0));
+        new (array) AnalysisArray{ std::move(document), nullptr, arrayType };
+        luaL_setmetatable(L, ANALYSIS_ARRAY_METATABLE);
+        }
+
+    //-------------------------------------------------------------
+    void PushAnalysisTable(lua_State* L, std::shared_ptr<const AnalysisTableData> table)
+        {
+        auto* tableView =
+            static_cast<AnalysisTable*>(lua_newuserdatauv(L, sizeof(AnalysisTable), 0));
+        new (tableView) AnalysisTable{ std::move(table) };
+        luaL_setmetatable(L, ANALYSIS_TABLE_METATABLE);
+        }
+
+    //-------------------------------------------------------------
+    void RegisterAnalysisViews(lua_State* L)
+        {
+        static const luaL_Reg arrayMetamethods[] = { { "__len", ArrayLength },
+                                                     { "__tostring", ArrayToString },
+                                                     { "__gc", ArrayCollect },
+                                                     { nullptr, nullptr } };
+        static const luaL_Reg arrayMethods[] = { { "Sum", ArraySum },
+                                                 { "Mean", ArrayMean },
+                                                 { "Min", ArrayMin },
+                                                 { "Max", ArrayMax },
+                                                 { "ToTable", ArrayToTable },
+                                                 { nullptr, nullptr } };
+        RegisterMetatable(L, ANALYSIS_ARRAY_METATABLE, arrayMetamethods, arrayMethods,
+                          ArrayIndex);
+
+        static const luaL_Reg tableMetamethods[] = { { "__len", TableRowCount },
+                                                     { "__tostring", TableToString },
+                                                     { "__gc", TableCollect },
+                                                     { nullptr, nullptr } };
+        static const luaL_Reg tableMethods[] = { { "GetRowCount", TableRowCount },
+                                                 { "GetColumnCount", TableColumnCount },
+                                                 { "GetColumnName", TableGetColumnName },
+                                                 { "GetColumn", TableGetColumn },
+                                                 { "GetValue", TableGetValue },
+                                                 { "GetDocumentPath", TableGetDocumentPath },
+                                                 { "GetDocumentLabel", TableGetDocumentLabel },
+                                                 { nullptr, nullptr } };
+        RegisterMetatable(L, ANALYSIS_TABLE_METATABLE, tableMetamethods, tableMethods,
+                          TableIndex);
+        }
+    } // namespace LuaScripting
+
+// NOLINTEND(readability-implicit-bool-conversion)
+// NOLINTEND(readability-identifier-length)
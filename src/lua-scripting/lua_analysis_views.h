@@ -0,0 +1,107 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef LUA_ANALYSIS_VIEWS_H
+#define LUA_ANALYSIS_VIEWS_H
+
+#include "../test-helpers/tests_functional.h"
+#include "lua.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+
+// NOLINTBEGIN(readability-identifier-length)
+
+namespace LuaScripting
+    {
+    /// @brief Which values from a document an AnalysisArray is viewing.
+    enum class AnalysisArrayType
+        {
+        /// @brief Each word's text.
+        WordText,
+        /// @brief Each word's syllable count.
+        WordSyllableCounts,
+        /// @brief Each word's character count (excluding punctuation).
+        WordCharacterCounts,
+        /// @brief Each word's (1-based) sentence index.
+        WordSentenceIndices,
+        /// @brief Whether each word is valid (i.e., not excluded).
+        WordValidity,
+        /// @brief Each sentence's word count.
+        SentenceWordCounts,
+        /// @brief Each sentence's (1-based) first word index.
+        SentenceFirstWordIndices,
+        /// @brief Whether each sentence is valid (i.e., not excluded).
+        SentenceValidity,
+        /// @brief Each paragraph's sentence count.
+        ParagraphSentenceCounts,
+        /// @brief Each paragraph's (1-based) first sentence index.
+        ParagraphFirstSentenceIndices,
+        /// @brief (1-based) indices of repeated words.
+        RepeatedWordIndices,
+        /// @brief (1-based) indices of mismatched articles.
+        ArticleMismatchIndices,
+        /// @brief (1-based) indices of the first word of passive voice phrases.
+        PassiveVoiceIndices,
+        /// @brief (1-based) indices of sentences that begin with a conjunction.
+        ConjunctionStartingSentenceIndices,
+        /// @brief (1-based) indices of sentences that begin with a lowercased word.
+        LowercasedSentenceIndices,
+        /// @brief A column of numbers from an AnalysisTable.
+        TableColumn
+        };
+
+    /** @brief Per-document statistics and scores from a batch project,
+            stored as columns that scripts can read in bulk.*/
+    struct AnalysisTableData
+        {
+        /// @brief The documents' file paths.
+        std::vector<wxString> m_documentPaths;
+        /// @brief The documents' labels.
+        std::vector<wxString> m_documentLabels;
+        /// @brief The names of the numeric columns.
+        std::vector<wxString> m_columnNames;
+        /// @brief The numeric columns (each one has a value for every document).
+        std::vector<std::shared_ptr<const std::vector<double>>> m_columns;
+        };
+
+    /** @brief Pushes a read-only, array-like view over a document's data onto the Lua stack.
+        @details The view shares ownership of the document (rather than copying from it),
+            so a script can index it (1-based) or call its reductions
+            (@c Sum, @c Mean, @c Min, @c Max) without marshaling every value
+            through the Lua stack.\n
+            Projects re-index their document in place, so if the project is re-indexed,
+            existing views will see the new results (and their lengths may change).
+        @param L The Lua state.
+        @param document The indexed document to view. If null, then an empty view is pushed.
+        @param arrayType Which values to view.*/
+    void PushAnalysisArray(lua_State* L,
+                           std::shared_ptr<const CaseInSensitiveNonStemmingDocument> document,
+                           const AnalysisArrayType arrayType);
+
+    /** @brief Pushes a read-only table of per-document statistics onto the Lua stack.
+        @details Its columns can be retrieved as array views (via @c GetColumn),
+            which share the table's data instead of copying it.
+        @param L The Lua state.
+        @param table The data to view.*/
+    void PushAnalysisTable(lua_State* L, std::shared_ptr<const AnalysisTableData> table);
+
+    /// @brief Registers the metatables for the analysis views.
+    /// @param L The Lua state.
+    void RegisterAnalysisViews(lua_State* L);
+    } // namespace LuaScripting
+
+// NOLINTEND(readability-identifier-length)
+
+#endif // LUA_ANALYSIS_VIEWS_H
@@ -393,6 +393,48 @@ namespace LuaScripting
         return 1;
         }
 
+    //-------------------------------------------------------------
+    int SetWebHarvesterMaxInMemoryUrls(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+
+        const auto maxUrls = luaL_checkinteger(L, 1);
+        const auto expectedUrls = (lua_gettop(L) >= 2) ? luaL_checkinteger(L, 2) : 10'000'000;
+        wxGetApp().GetWebHarvester().SetMaxInMemoryUrls(
+            static_cast<size_t>(std::max<lua_Integer>(maxUrls, 0)),
+            static_cast<size_t>(std::max<lua_Integer>(expectedUrls, 1)));
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int SaveWebHarvesterState(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+
+        lua_pushboolean(L, wxGetApp().GetWebHarvester().SaveCrawlState(
+                               wxString{ luaL_checkstring(L, 1), wxConvUTF8 }));
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int LoadWebHarvesterState(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+
+        lua_pushboolean(L, wxGetApp().GetWebHarvester().LoadCrawlState(
+                               wxString{ luaL_checkstring(L, 1), wxConvUTF8 }));
+        return 1;
+        }
+
     //-------------------------------------------------------------
     int GetLuaConstantsPath(lua_State* L)
         {
@@ -403,8 +445,7 @@ namespace LuaScripting
     //-------------------------------------------------------------
     int GetActiveBatchProject(lua_State* L)
         {
-        wxDocument* currentDoc =
-            wxGetApp().GetMainFrame()->GetDocumentManager()->GetCurrentDocument();
+        wxDocument* currentDoc = wxGetApp().GetDocManager()->GetCurrentDocument();
         if (currentDoc && currentDoc->IsKindOf(wxCLASSINFO(BatchProjectDoc)))
             {
             BatchProject* batchProject = new BatchProject(L);
@@ -433,8 +474,7 @@ namespace LuaScripting
 
     int GetActiveStandardProject(lua_State* L)
         {
-        wxDocument* currentDoc =
-            wxGetApp().GetMainFrame()->GetDocumentManager()->GetCurrentDocument();
+        wxDocument* currentDoc = wxGetApp().GetDocManager()->GetCurrentDocument();
         if (currentDoc && currentDoc->IsKindOf(wxCLASSINFO(ProjectDoc)))
             {
             StandardProject* standardProject = new StandardProject(L);
@@ -499,17 +539,17 @@ namespace LuaScripting
             }
         if (lua_isboolean(L, 1))
             {
-            wxMessageBox(lua_toboolean(L, 1) ? _(L"true") : _(L"false"),
-                         (lua_gettop(L) > 1) ? wxString(luaL_checkstring(L, 2), wxConvUTF8) :
-                                               wxGetApp().GetAppName(),
-                         wxOK | wxICON_INFORMATION);
+            ShowMessage(lua_toboolean(L, 1) ? _(L"true") : _(L"false"),
+                        (lua_gettop(L) > 1) ? wxString(luaL_checkstring(L, 2), wxConvUTF8) :
+                                              wxGetApp().GetAppName(),
+                        wxOK | wxICON_INFORMATION);
             }
         else if (lua_isstring(L, 1))
             {
-            wxMessageBox(wxString(luaL_checkstring(L, 1), wxConvUTF8),
-                         (lua_gettop(L) > 1) ? wxString(luaL_checkstring(L, 2), wxConvUTF8) :
-                                               wxGetApp().GetAppName(),
-                         wxOK | wxICON_INFORMATION);
+            ShowMessage(wxString(luaL_checkstring(L, 1), wxConvUTF8),
+                        (lua_gettop(L) > 1) ? wxString(luaL_checkstring(L, 2), wxConvUTF8) :
+                                              wxGetApp().GetAppName(),
+                        wxOK | wxICON_INFORMATION);
             }
         return 0;
         }
@@ -580,8 +620,8 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(wxString::Format(_(L"%s: file not found."), inputFile),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(_(L"%s: file not found."), inputFile),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 lua_pushboolean(L, false);
                 return 1;
                 }
@@ -613,8 +653,8 @@ namespace LuaScripting
         const wxString inPath(luaL_checkstring(L, 1), wxConvUTF8);
         if (!wxFile::Exists(inPath))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid image file path."), inPath),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid image file path."), inPath),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -641,16 +681,16 @@ namespace LuaScripting
         const wxString path(luaL_checkstring(L, 1), wxConvUTF8);
         if (!wxFile::Exists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid image file path."), path),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid image file path."), path),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
         const wxImage img = Wisteria::GraphItems::Image::LoadFile(path);
         if (!img.IsOk())
             {
-            wxMessageBox(wxString::Format(_(L"%s: unable to load image."), path),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: unable to load image."), path),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -732,6 +772,11 @@ namespace LuaScripting
             {
             return 0;
             }
+        if (wxGetApp().IsHeadless())
+            {
+            lua_pushboolean(L, false);
+            return 1;
+            }
         assert(wxGetApp().GetSplashscreenPaths().GetCount());
         const auto index = std::clamp<size_t>(luaL_checkinteger(L, 1) - 1 /*make it zero-indexed*/,
                                               0, wxGetApp().GetSplashscreenPaths().GetCount() - 1);
@@ -773,8 +818,8 @@ namespace LuaScripting
 
         if (!wxFileName::DirExists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid folder path."), path), _(L"Script Error"),
-                         wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid folder path."), path), _(L"Script Error"),
+                        wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -850,7 +895,7 @@ namespace LuaScripting
         // write out the warnings of bad links
         for (const auto& badLink : badLinks)
             {
-            wxGetApp().GetMainFrameEx()->GetLuaEditor()->DebugOutput(
+            DebugPrint(
                 wxString::Format(_DT(L"Broken link in '<span style='font-weight:bold;'>%s</span>': "
                                      "<span style='color:red; font-weight:bold;'>%s</span>",
                                      DTExplanation::DebugMessage),
@@ -865,7 +910,7 @@ namespace LuaScripting
         // match their size specified in a topic
         for (const auto& badImage : badImageSizes)
             {
-            wxGetApp().GetMainFrameEx()->GetLuaEditor()->DebugOutput(wxString::Format(
+            DebugPrint(wxString::Format(
                 _DT(L"Bad image size in '<span style='font-weight:bold;'>%s</span>%s</span>': "
                     "<span style='color:red; font-weight:bold;'>%s</span>"),
                 badImage.first, badImage.second));
@@ -884,7 +929,7 @@ namespace LuaScripting
     //-------------------------------------------------------------
     int Close(lua_State*)
         {
-        if (wxGetApp().GetMainFrame()->GetDocumentManager()->CloseDocuments())
+        if (wxGetApp().GetDocManager()->CloseDocuments() && wxGetApp().GetTopWindow() != nullptr)
             {
             wxGetApp().GetTopWindow()->Close();
             }
@@ -990,8 +1035,8 @@ namespace LuaScripting
         wxString path(luaL_checkstring(L, 1), wxConvUTF8);
         if (!wxFile::Exists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -1007,8 +1052,8 @@ namespace LuaScripting
         path = wxString(luaL_checkstring(L, 2), wxConvUTF8);
         if (!wxFile::Exists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -1062,8 +1107,8 @@ namespace LuaScripting
         wxString path(luaL_checkstring(L, 1), wxConvUTF8);
         if (!wxFile::Exists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -1109,8 +1154,8 @@ namespace LuaScripting
         wxString path(luaL_checkstring(L, 1), wxConvUTF8);
         if (!wxFile::Exists(path))
             {
-            wxMessageBox(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(_(L"%s: invalid file path."), wxString(__func__)),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
             return 1;
             }
@@ -1210,8 +1255,8 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(wxString::Format(_(L"%s: file not found."), inputFile),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(_(L"%s: file not found."), inputFile),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 lua_pushboolean(L, false);
                 return 1;
                 }
@@ -1223,10 +1268,10 @@ namespace LuaScripting
             {
             if (phrase.first.to_string() == phrase.second)
                 {
-                wxMessageBox(wxString::Format(_(L"%s: phrase '%s' and suggested replacement are "
-                                                "the same.\nPlease review your phrase file."),
-                                              inputFile, phrase.first.to_string().c_str()),
-                             _(L"Warning"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(_(L"%s: phrase '%s' and suggested replacement are "
+                                               "the same.\nPlease review your phrase file."),
+                                             inputFile, phrase.first.to_string().c_str()),
+                            _(L"Warning"), wxOK | wxICON_EXCLAMATION);
                 }
             }
 
@@ -1263,8 +1308,8 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(wxString::Format(_(L"%s: file not found."), inputFile),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(_(L"%s: file not found."), inputFile),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 lua_pushboolean(L, false);
                 return 1;
                 }
@@ -3696,6 +3741,11 @@ namespace LuaScripting
             {
             return 0;
             }
+        // there is no main window when running headless
+        if (wxGetApp().IsHeadless())
+            {
+            return 0;
+            }
         wxGetApp().GetMainFrame()->Maximize(false);
         wxGetApp().GetMainFrame()->SetSize(
             wxGetApp().GetMainFrame()->FromDIP(luaL_checkinteger(L, 1)),
@@ -65,6 +65,9 @@ namespace LuaScripting
     int SetWebHarvesterFileFilter(lua_State* L /*string filter*/); // Sets the file types that the web harvester will download. This should be a semicolon separated list of file wildcards (e.g., "*.html;*.png").
     int SetWebHarvesterWebsite(lua_State* L /*string Url*/); // Sets the website to harvest next.
     int /*boolean*/ WebHarvest(lua_State* L); // Begins crawling the web harvester's currently loaded website.
+    int SetWebHarvesterMaxInMemoryUrls(lua_State* L /*number maxUrls, number expectedUrls*/); // Sets how many crawled URLs the web harvester tracks in memory before moving them to disk.
+    int /*boolean*/ SaveWebHarvesterState(lua_State* L /*string folderPath*/); // Saves the web harvester's crawl state, so that an interrupted crawl can be resumed later.
+    int /*boolean*/ LoadWebHarvesterState(lua_State* L /*string folderPath*/); // Loads a crawl state saved by SaveWebHarvesterState(), so that the next WebHarvest() resumes it.
 
     int /*table*/ FindFiles(lua_State* L /*string directory, string filePattern, boolean recursive*/); // Returns a list of all files from a folder matching the provided file pattern.
     int Close(lua_State*); // Closes the program.
@@ -381,6 +384,9 @@ namespace LuaScripting
         { "SetWebHarvesterFileFilter", SetWebHarvesterFileFilter },
         { "SetWebHarvesterWebsite", SetWebHarvesterWebsite },
         { "WebHarvest", WebHarvest },
+        { "SetWebHarvesterMaxInMemoryUrls", SetWebHarvesterMaxInMemoryUrls },
+        { "SaveWebHarvesterState", SaveWebHarvesterState },
+        { "LoadWebHarvesterState", LoadWebHarvesterState },
         { "FindFiles", FindFiles },
         { "GetTestId", GetTestId },
         { "GetFileCheckSum", GetFileCheckSum },
@@ -19,6 +19,7 @@
 #include "../projects/batch_project_view.h"
 #include "../projects/standard_project_doc.h"
 #include "../ui/dialogs/tools_options_dlg.h"
+#include "lua_analysis_views.h"
 
 using namespace Wisteria;
 using namespace Wisteria::Graphs;
@@ -77,8 +78,7 @@ namespace LuaScripting
         const auto createProject = [this](const wxString& folderPath)
         {
             // create a batch project and load a folder
-            const wxList& templateList =
-                wxGetApp().GetMainFrame()->GetDocumentManager()->GetTemplates();
+            const wxList& templateList = wxGetApp().GetDocManager()->GetTemplates();
             for (size_t i = 0; i < templateList.GetCount(); ++i)
                 {
                 wxDocTemplate* docTemplate =
@@ -91,7 +91,15 @@ namespace LuaScripting
                     if (m_project && !m_project->OnNewDocument())
                         {
                         // Document is implicitly deleted by DeleteAllViews
-                        m_project->DeleteAllViews();
+                        // (unless it doesn't have any, when running headless)
+                        if (m_project->GetViews().empty())
+                            {
+                            wxGetApp().GetDocManager()->CloseDocument(m_project, true);
+                            }
+                        else
+                            {
+                            m_project->DeleteAllViews();
+                            }
                         m_project = nullptr;
                         }
                     break;
@@ -108,14 +116,17 @@ namespace LuaScripting
                          wxPATH_NORM_ABSOLUTE);
             if (fn.GetExt().CmpNoCase(_DT(L"rsbp")) == 0)
                 {
-                m_project =
-                    dynamic_cast<BatchProjectDoc*>(wxGetApp().GetMainFrame()->OpenFile(path));
+                // (there is no main frame to open it when running headless)
+                m_project = dynamic_cast<BatchProjectDoc*>(
+                    wxGetApp().IsHeadless() ?
+                        wxGetApp().GetDocManager()->CreateDocument(path, wxDOC_SILENT) :
+                        wxGetApp().GetMainFrame()->OpenFile(path));
                 }
             else if (fn.GetExt().CmpNoCase(_DT(L"rsp")) == 0)
                 {
                 m_project = nullptr;
-                wxMessageBox(_(L"A batch project cannot open a standard project file."),
-                             _(L"Project File Mismatch"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(_(L"A batch project cannot open a standard project file."),
+                            _(L"Project File Mismatch"), wxOK | wxICON_EXCLAMATION);
                 return;
                 }
             else if (path.empty())
@@ -187,11 +198,22 @@ namespace LuaScripting
             const bool recursive = ((lua_gettop(L) > 2) ? int_to_bool(lua_toboolean(L, 3)) : true);
             wxArrayString files;
                 {
-                const wxWindowDisabler disableAll;
-                const wxBusyInfo wait(_(L"Retrieving files..."), m_project->GetDocumentWindow());
+                // (no busy window when running unattended)
+                const std::unique_ptr<wxWindowDisabler> disableAll{
+                    wxGetApp().IsHeadless() ? nullptr : std::make_unique<wxWindowDisabler>()
+                };
+                const std::unique_ptr<wxBusyInfo> wait{
+                    wxGetApp().IsHeadless() ?
+                        nullptr :
+                        std::make_unique<wxBusyInfo>(_(L"Retrieving files..."),
+                                                     m_project->GetDocumentWindow())
+                };
 #ifdef __WXGTK__
-                wxMilliSleep(100);
-                wxTheApp->Yield();
+                if (!wxGetApp().IsHeadless())
+                    {
+                    wxMilliSleep(100);
+                    wxTheApp->Yield();
+                    }
 #endif
                 wxDir::GetAllFiles(path, &files, wxString{},
                                    recursive ? (wxDIR_FILES | wxDIR_DIRS) : wxDIR_FILES);
@@ -236,6 +258,82 @@ namespace LuaScripting
         return 1;
         }
 
+    //-------------------------------------------------------------
+    int BatchProject::GetDocumentStatistics(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        const auto meanOrNaN = [](const std::vector<double>& values)
+        {
+            return values.empty() ? std::numeric_limits<double>::quiet_NaN() :
+                                    statistics::mean(values);
+        };
+        const std::vector<std::pair<wxString, std::function<double(const BaseProject&)>>>
+            columnDefinitions = {
+                { _DT(L"Words"), [](const BaseProject& doc) { return doc.GetTotalWords(); } },
+                { _DT(L"UniqueWords"),
+                  [](const BaseProject& doc) { return doc.GetTotalUniqueWords(); } },
+                { _DT(L"Sentences"),
+                  [](const BaseProject& doc) { return doc.GetTotalSentences(); } },
+                { _DT(L"Paragraphs"),
+                  [](const BaseProject& doc) { return doc.GetTotalParagraphs(); } },
+                { _DT(L"Syllables"),
+                  [](const BaseProject& doc) { return doc.GetTotalSyllables(); } },
+                { _DT(L"Characters"),
+                  [](const BaseProject& doc) { return doc.GetTotalCharacters(); } },
+                { _DT(L"3PlusSyllableWords"),
+                  [](const BaseProject& doc) { return doc.GetTotal3PlusSyllabicWords(); } },
+                { _DT(L"6PlusCharacterWords"),
+                  [](const BaseProject& doc) { return doc.GetTotalLongWords(); } },
+                { _DT(L"OverlyLongSentences"),
+                  [](const BaseProject& doc) { return doc.GetTotalOverlyLongSentences(); } },
+                { _DT(L"MeanGradeLevel"), [&meanOrNaN](const BaseProject& doc)
+                  { return meanOrNaN(doc.GetAggregatedGradeScores()); } },
+                { _DT(L"MeanClozeScore"), [&meanOrNaN](const BaseProject& doc)
+                  { return meanOrNaN(doc.GetAggregatedClozeScores()); } }
+            };
+
+        // snapshot the statistics into columns, so that scripts can read (and reduce)
+        // an entire column without a call per document
+        // (documents left out of the results, e.g., near duplicates, are skipped,
+        // as they are in the project's own lists and graphs)
+        std::vector<const BaseProject*> documents;
+        documents.reserve(m_project->GetDocuments().size());
+        for (const auto* doc : m_project->GetDocuments())
+            {
+            if (doc->IsIncludedInResults())
+                {
+                documents.push_back(doc);
+                }
+            }
+        auto table = std::make_shared<AnalysisTableData>();
+        table->m_documentPaths.reserve(documents.size());
+        table->m_documentLabels.reserve(documents.size());
+        for (const auto* doc : documents)
+            {
+            table->m_documentPaths.push_back(doc->GetOriginalDocumentFilePath());
+            table->m_documentLabels.push_back(doc->GetOriginalDocumentDescription());
+            }
+        for (const auto& [columnName, getValue] : columnDefinitions)
+            {
+            std::vector<double> column;
+            column.reserve(documents.size());
+            for (const auto* doc : documents)
+                {
+                column.push_back(getValue(*doc));
+                }
+            table->m_columnNames.push_back(columnName);
+            table->m_columns.push_back(
+                std::make_shared<const std::vector<double>>(std::move(column)));
+            }
+
+        PushAnalysisTable(L, std::move(table));
+        return 1;
+        }
+
     //-------------------------------------------------------------
     int BatchProject::SetWindowSize(lua_State* L)
         {
@@ -2944,7 +3042,7 @@ namespace LuaScripting
                     }
                 else
                     {
-                    wxMessageBox(
+                    ShowMessage(
                         wxString::Format(_(L"%s: unknown test could not be added."), testName),
                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                     lua_pushboolean(L, false);
@@ -2981,7 +3079,7 @@ namespace LuaScripting
                         }
                     else
                         {
-                        wxMessageBox(
+                        ShowMessage(
                             wxString::Format(_(L"%s: unknown test could not be added."), testName),
                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                         lua_pushboolean(L, false);
@@ -3064,7 +3162,7 @@ namespace LuaScripting
             const auto listId = ReadabilityApp::GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (listId == ReadabilityApp::GetDynamicIdMap().cend())
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified list (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -3142,10 +3240,10 @@ namespace LuaScripting
             const auto sectionId = ReadabilityApp::GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (sectionId == ReadabilityApp::GetDynamicIdMap().cend())
                 {
-                wxMessageBox(wxString::Format(
-                                 _(L"Unable to find the specified section (%d) in the project."),
-                                 static_cast<int>(luaL_checkinteger(L, 2))),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(
+                                _(L"Unable to find the specified section (%d) in the project."),
+                                static_cast<int>(luaL_checkinteger(L, 2))),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 return 0;
                 }
             // Use mapped value or numeric value from a script, which may be a literal (unmapped)
@@ -3197,7 +3295,7 @@ namespace LuaScripting
                 wxGetApp().Yield();
                 return 1;
                 }
-            wxMessageBox(
+            ShowMessage(
                 wxString::Format(_(L"Unable to find the specified graph (%d) in the project."),
                                  static_cast<int>(luaL_checkinteger(L, 3))),
                 _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -3267,10 +3365,10 @@ namespace LuaScripting
             const auto sectionId = ReadabilityApp::GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (sectionId == ReadabilityApp::GetDynamicIdMap().cend())
                 {
-                wxMessageBox(wxString::Format(
-                                 _(L"Unable to find the specified section (%d) in the project."),
-                                 static_cast<int>(luaL_checkinteger(L, 2))),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(
+                                _(L"Unable to find the specified section (%d) in the project."),
+                                static_cast<int>(luaL_checkinteger(L, 2))),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 return 0;
                 }
             std::optional<wxWindowID> windowId{ std::nullopt };
@@ -3281,10 +3379,10 @@ namespace LuaScripting
                     ReadabilityApp::GetDynamicIdMap().find(luaL_checkinteger(L, 3));
                 if (userWindowId == ReadabilityApp::GetDynamicIdMap().cend())
                     {
-                    wxMessageBox(wxString::Format(
-                                     _(L"Unable to find the specified window (%d) in the project."),
-                                     static_cast<int>(luaL_checkinteger(L, 3))),
-                                 _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                    ShowMessage(wxString::Format(
+                                    _(L"Unable to find the specified window (%d) in the project."),
+                                    static_cast<int>(luaL_checkinteger(L, 3))),
+                                _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                     return 0;
                     }
                 windowId = userWindowId->second;
@@ -3334,7 +3432,7 @@ namespace LuaScripting
                 ReadabilityApp::GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (windowOrSectionId == ReadabilityApp::GetDynamicIdMap().cend())
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified list (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -3382,6 +3480,12 @@ namespace LuaScripting
             return 0;
             }
 
+        // (no dialogs to show when running headless)
+        if (wxGetApp().IsHeadless())
+            {
+            return 0;
+            }
+
         if (m_settingsDlg == nullptr)
             {
             m_settingsDlg = new ToolsOptionsDlg(wxGetApp().GetMainFrame(), m_project);
@@ -3421,6 +3525,7 @@ namespace LuaScripting
         LUNA_DECLARE_METHOD(BatchProject, LoadFolder),
         LUNA_DECLARE_METHOD(BatchProject, LoadFiles),
         LUNA_DECLARE_METHOD(BatchProject, GetTitle),
+        LUNA_DECLARE_METHOD(BatchProject, GetDocumentStatistics),
         LUNA_DECLARE_METHOD(BatchProject, SetWindowSize),
         LUNA_DECLARE_METHOD(BatchProject, DelayReloading),
         LUNA_DECLARE_METHOD(BatchProject, SetLanguage),
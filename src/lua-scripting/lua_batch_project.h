@@ -40,9 +40,9 @@ namespace LuaScripting
             {
             if (m_project == nullptr)
                 {
-                wxMessageBox(wxString::Format(_(L"%s: accessing project that is already closed."),
-                                              functionName),
-                             _(L"Warning"), wxOK | wxICON_INFORMATION);
+                ShowMessage(wxString::Format(_(L"%s: accessing project that is already closed."),
+                                             functionName),
+                            _(L"Warning"), wxOK | wxICON_INFORMATION);
                 return false;
                 }
             return true;
@@ -61,7 +61,7 @@ namespace LuaScripting
             // routing the function to the class object.
             if ((lua_gettop(L) - 1) < minParameterCount)
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(
                         // TRANSLATORS: %s is a function name that failed from a script
                         _(L"%s: invalid number of arguments.\n\n%d expected, %d provided."),
@@ -98,6 +98,7 @@ namespace LuaScripting
         int LoadFiles(lua_State* L /*table files*/); // Analyses a list of provided file paths.
 
         int /*string*/ GetTitle(lua_State* L); // Returns the title of the project.
+        int /*AnalysisTable*/ GetDocumentStatistics(lua_State* L); // Returns a table of statistics and scores for each document included in the batch's results.
         int SetWindowSize(lua_State* L /*number width, number height*/); // Sets the size of the project window.
 
         int DelayReloading(lua_State* L /*boolean delay*/); // Prevents a project from updating while settings are being changed.
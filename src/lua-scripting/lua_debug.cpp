@@ -14,6 +14,10 @@
 #include "lua_debug.h"
 #include "../Wisteria-Dataviz/src/base/reportbuilder.h"
 #include "../app/readability_app.h"
+#include "../indexing/pipeline_stats.h"
+#include <algorithm>
+#include <chrono>
+#include <wx/msgout.h>
 
 // NOLINTBEGIN(readability-identifier-length)
 // NOLINTBEGIN(readability-implicit-bool-conversion)
@@ -88,11 +92,11 @@ namespace LuaScripting
         assert(minParemeterCount >= 0);
         if (lua_gettop(L) < minParemeterCount)
             {
-            wxMessageBox(wxString::Format(
-                             // TRANSLATORS: %s is a function name that failed from a script
-                             _(L"%s: invalid number of arguments.\n\n%d expected, %d provided."),
-                             functionName, minParemeterCount, lua_gettop(L)),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(wxString::Format(
+                            // TRANSLATORS: %s is a function name that failed from a script
+                            _(L"%s: invalid number of arguments.\n\n%d expected, %d provided."),
+                            functionName, minParemeterCount, lua_gettop(L)),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             return false;
             }
         else
@@ -104,10 +108,61 @@ namespace LuaScripting
     //-------------------------------------------------------------
     void DebugPrint(const wxString& str)
         {
+        if (wxGetApp().IsHeadless())
+            {
+            // strip the highlighting tags meant for the debug window
+            wxString plainText;
+            plainText.reserve(str.length());
+            bool inTag{ false };
+            for (const auto& chr : str)
+                {
+                if (chr == L'<')
+                    {
+                    inTag = true;
+                    }
+                else if (chr == L'>' && inTag)
+                    {
+                    inTag = false;
+                    }
+                else if (!inTag)
+                    {
+                    plainText += chr;
+                    }
+                }
+            wxMessageOutputStderr{}.Output(plainText);
+            wxLogMessage(L"%s", plainText);
+            return;
+            }
         wxGetApp().GetMainFrameEx()->GetLuaEditor()->DebugOutput(str);
         wxGetApp().Yield();
         }
 
+    //-------------------------------------------------------------
+    int ShowMessage(const wxString& message, const wxString& caption, const int style)
+        {
+        if (!wxGetApp().IsHeadless())
+            {
+            return wxMessageBox(message, caption, style);
+            }
+
+        wxString logMessage{ caption.empty() ? message : caption + L": " + message };
+        logMessage.Replace(L"\n", L" ", true);
+        wxMessageOutputStderr{}.Output(logMessage);
+        if (style & wxICON_ERROR)
+            {
+            wxLogError(L"%s", logMessage);
+            }
+        else if (style & wxICON_EXCLAMATION)
+            {
+            wxLogWarning(L"%s", logMessage);
+            }
+        else
+            {
+            wxLogMessage(L"%s", logMessage);
+            }
+        return wxOK;
+        }
+
     //-------------------------------------------------------------
     int GetScriptFolder(lua_State* L)
         {
@@ -140,10 +195,81 @@ namespace LuaScripting
     //-------------------------------------------------------------
     int Clear([[maybe_unused]] lua_State* L)
         {
+        if (wxGetApp().IsHeadless())
+            {
+            return 0;
+            }
         wxGetApp().GetMainFrameEx()->GetLuaEditor()->DebugClear();
         wxGetApp().Yield();
         return 0;
         }
+
+    //-------------------------------------------------------------
+    int SetInstructionBudget(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+        LuaInterpreter::SetInstructionBudget(
+            static_cast<uint64_t>(std::max<lua_Integer>(0, luaL_checkinteger(L, 1))));
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int SetTimeBudget(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+        LuaInterpreter::SetTimeBudget(std::chrono::milliseconds{
+            static_cast<int64_t>(std::max<lua_Number>(0, luaL_checknumber(L, 1)) * 1000) });
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int StartProfiler([[maybe_unused]] lua_State* L)
+        {
+        LuaInterpreter::StartProfiler();
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int StopProfiler([[maybe_unused]] lua_State* L)
+        {
+        LuaInterpreter::StopProfiler();
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int EnablePipelineTimings(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            return 0;
+            }
+        pipeline_stats::set_enabled(int_to_bool(lua_toboolean(L, 1)));
+        return 0;
+        }
+
+    //-------------------------------------------------------------
+    int ExportPipelineTimings(lua_State* L)
+        {
+        if (!VerifyParameterCount(L, 1, __func__))
+            {
+            lua_pushboolean(L, false);
+            return 1;
+            }
+        const wxString filePath{ luaL_checkstring(L, 1), wxConvUTF8 };
+        const bool chromeTrace = (lua_gettop(L) >= 2) ? int_to_bool(lua_toboolean(L, 2)) : false;
+        const std::string json =
+            chromeTrace ? pipeline_stats::to_chrome_trace() : pipeline_stats::to_json();
+        wxFile outputFile(filePath, wxFile::write);
+        lua_pushboolean(L, outputFile.IsOpened() &&
+                               outputFile.Write(json.data(), json.length()) == json.length());
+        return 1;
+        }
     } // namespace LuaScripting
 
 // NOLINTEND(readability-implicit-bool-conversion)
@@ -32,9 +32,19 @@ namespace LuaScripting
     [[nodiscard]]
     bool VerifyParameterCount(lua_State* L, const int minParemeterCount,
                               const wxString& functionName);
-    /** @brief Prints a message to the debug window.
+    /** @brief Prints a message to the debug window
+            (or to the console, if running headless).
         @param str The message to print.*/
     void DebugPrint(const wxString& str);
+    /** @brief Shows a message box or, if the program is running headless,
+            writes the message to the log and the console instead.
+        @param message The message to show.
+        @param caption The caption of the message box.
+        @param style The message box's style. If running headless,
+            its icon determines which log level to use.
+        @returns The button that was clicked, or @c wxOK if running headless.*/
+    int ShowMessage(const wxString& message, const wxString& caption,
+                    const int style = wxOK | wxCENTRE);
 
     /// @brief Helper function to load font attributes for a project.
     void LoadFontAttributes(lua_State* L, wxFont& font, wxColour& fontColor, bool calledFromObject);
@@ -46,12 +56,24 @@ namespace LuaScripting
     int Print(lua_State* /*string message*/); // Prints a message to the script editor's debug window.
     int Clear(lua_State*); // Clears the log window.
     int /*string*/ GetScriptFolder(lua_State*); // Returns the folder path of the currently running script.
+    int SetInstructionBudget(lua_State* /*number instructionCount*/); // Stops the script once it has run more than this many instructions in total, counted from its start (0 for no limit).
+    int SetTimeBudget(lua_State* /*number seconds*/); // Stops the script once it has run longer than this many seconds in total, counted from its start (0 for no limit).
+    int StartProfiler(lua_State*); // Starts reporting the script's hottest lines and its time spent in project methods.
+    int StopProfiler(lua_State*); // Stops the profiler and prints its report (also printed when the script finishes).
+    int EnablePipelineTimings(lua_State* /*boolean enable*/); // Starts (or stops) collecting how long each stage of analyzing documents takes.
+    int /*boolean*/ ExportPipelineTimings(lua_State* /*string filePath, boolean chromeTrace*/); // Saves the collected timings as JSON (or as a Chrome trace, if chromeTrace is true).
     // clang-format on
     // quneiform-suppress-end
 
     static const luaL_Reg DebugLib[] = { { "Print", Print },
                                          { "Clear", Clear },
                                          { "GetScriptFolder", GetScriptFolder },
+                                         { "SetInstructionBudget", SetInstructionBudget },
+                                         { "SetTimeBudget", SetTimeBudget },
+                                         { "StartProfiler", StartProfiler },
+                                         { "StopProfiler", StopProfiler },
+                                         { "EnablePipelineTimings", EnablePipelineTimings },
+                                         { "ExportPipelineTimings", ExportPipelineTimings },
                                          { nullptr, nullptr } };
     } // namespace LuaScripting
 
@@ -13,6 +13,7 @@
 
 #include "lua_interface.h"
 #include "../app/readability_app.h"
+#include "lua_analysis_views.h"
 #include "lua_application.h"
 #include "lua_batch_project.h"
 #include "lua_debug.h"
@@ -26,6 +27,11 @@ wxDECLARE_APP(ReadabilityApp);
 
 bool LuaInterpreter::m_isRunning = false;
 bool LuaInterpreter::m_quitRequested = false;
+uint64_t LuaInterpreter::m_instructionBudget = 0;
+uint64_t LuaInterpreter::m_instructionsRun = 0;
+std::chrono::milliseconds LuaInterpreter::m_timeBudget{ 0 };
+std::chrono::steady_clock::time_point LuaInterpreter::m_scriptStartTime;
+LuaProfiler LuaInterpreter::m_profiler;
 
 //------------------------------------------------------
 LuaInterpreter::LuaInterpreter()
@@ -40,6 +46,7 @@ LuaInterpreter::LuaInterpreter()
     lua_setglobal(m_L, "Debug");
     Luna<LuaScripting::StandardProject>::Register(m_L);
     Luna<LuaScripting::BatchProject>::Register(m_L);
+    LuaScripting::RegisterAnalysisViews(m_L);
     }
 
 //------------------------------------------------------
@@ -50,22 +57,26 @@ LuaInterpreter::~LuaInterpreter()
     }
 
 //------------------------------------------------------
-void LuaInterpreter::RunLuaFile(const wxString& filePath)
+void LuaInterpreter::RemoveInterfaceLibraries()
+    {
+    lua_pushnil(m_L);
+    lua_setglobal(m_L, "ScreenshotLib");
+    }
+
+//------------------------------------------------------
+bool LuaInterpreter::RunLuaFile(const wxString& filePath)
     {
     if (IsRunning())
         {
-        wxMessageBox(_(L"Another Lua script is already running. "
-                       "Please wait for the other script to finish."),
-                     _(L"Lua Script"), wxOK | wxICON_INFORMATION);
-        return;
+        LuaScripting::ShowMessage(_(L"Another Lua script is already running. "
+                                    "Please wait for the other script to finish."),
+                                  _(L"Lua Script"), wxOK | wxICON_INFORMATION);
+        return false;
         }
-    m_quitRequested = false;
-    m_isRunning = true;
-    SetScriptFilePath(filePath);
-
-    lua_sethook(m_L, &LuaInterpreter::LineHookCallback, LUA_MASKLINE, 0);
+    BeginScript(filePath);
     const wxDateTime startTime(wxDateTime::Now());
-    if (luaL_dofile(m_L, filePath.utf8_str()) != 0)
+    const bool succeeded = (luaL_dofile(m_L, filePath.utf8_str()) == 0);
+    if (!succeeded)
         {
         // Error message from Lua has cryptic section in front of it showing the first line of the
         // script and just shows the line number without saying "line" in front of it,
@@ -76,7 +87,8 @@ void LuaInterpreter::RunLuaFile(const wxString& filePath)
             {
             errorMessage.erase(0, endOfErrorHeader + 2);
             }
-        wxMessageBox(_(L"Line #") + errorMessage, _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+        LuaScripting::ShowMessage(_(L"Line #") + errorMessage, _(L"Script Error"),
+                                  wxOK | wxICON_EXCLAMATION);
         LuaScripting::DebugPrint(wxString::Format(
             // TRANSLATORS: %s around "Error" are highlight tags.
             // The last one is a line number.
@@ -87,8 +99,8 @@ void LuaInterpreter::RunLuaFile(const wxString& filePath)
     LuaScripting::DebugPrint(
         wxString::Format(_(L"Script ran for %s"), endTime.Subtract(startTime).Format()));
 
-    m_quitRequested = false;
-    m_isRunning = false;
+    EndScript();
+    return succeeded;
     }
 
 //------------------------------------------------------
@@ -97,17 +109,13 @@ void LuaInterpreter::RunLuaCode(const wxString& code, const wxString& filePath,
     {
     if (IsRunning())
         {
-        wxMessageBox(_(L"Another Lua script is already running. "
-                       "Please wait for the other script to finish."),
-                     _(L"Lua Script"), wxOK | wxICON_INFORMATION);
+        LuaScripting::ShowMessage(_(L"Another Lua script is already running. "
+                                    "Please wait for the other script to finish."),
+                                  _(L"Lua Script"), wxOK | wxICON_INFORMATION);
         return;
         }
     errorMessage.clear();
-    m_quitRequested = false;
-    m_isRunning = true;
-    SetScriptFilePath(filePath);
-
-    lua_sethook(m_L, &LuaInterpreter::LineHookCallback, LUA_MASKLINE, 0);
+    BeginScript(filePath);
     const wxDateTime startTime(wxDateTime::Now());
     if (luaL_dostring(m_L, code.utf8_str()) != 0)
         {
@@ -146,8 +154,7 @@ void LuaInterpreter::RunLuaCode(const wxString& code, const wxString& filePath,
     LuaScripting::DebugPrint(
         wxString::Format(_(L"Script ran for %s"), endTime.Subtract(startTime).Format()));
 
-    m_quitRequested = false;
-    m_isRunning = false;
+    EndScript();
 
     // in case the script window was hidden and the script either forgot to show it again
     // or the script failed, then show it
@@ -155,12 +162,97 @@ void LuaInterpreter::RunLuaCode(const wxString& code, const wxString& filePath,
     }
 
 //------------------------------------------------------
-void LuaInterpreter::LineHookCallback(lua_State* L, lua_Debug* ar)
+void LuaInterpreter::BeginScript(const wxString& filePath)
+    {
+    m_quitRequested = false;
+    m_isRunning = true;
+    m_instructionsRun = 0;
+    m_scriptStartTime = std::chrono::steady_clock::now();
+    SetScriptFilePath(filePath);
+
+    lua_sethook(m_L, &LuaInterpreter::CountHookCallback, LUA_MASKCOUNT,
+                HOOK_INSTRUCTION_INTERVAL);
+    }
+
+//------------------------------------------------------
+void LuaInterpreter::EndScript()
+    {
+    if (m_profiler.IsRunning())
+        {
+        StopProfiler();
+        }
+    m_instructionBudget = 0;
+    m_timeBudget = std::chrono::milliseconds{ 0 };
+    m_quitRequested = false;
+    m_isRunning = false;
+    }
+
+//------------------------------------------------------
+void LuaInterpreter::StartProfiler()
+    {
+    m_profiler.Start();
+    LunaCallObserver::callback = &LuaInterpreter::NativeCallCallback;
+    }
+
+//------------------------------------------------------
+void LuaInterpreter::StopProfiler()
+    {
+    if (!m_profiler.IsRunning())
+        {
+        return;
+        }
+    LunaCallObserver::callback = nullptr;
+    m_profiler.Stop();
+    // the debug window is HTML, so send each line separately
+    const wxArrayString reportLines = wxSplit(m_profiler.FormatReport(), L'\n', 0);
+    for (const auto& line : reportLines)
+        {
+        LuaScripting::DebugPrint(line);
+        }
+    }
+
+//------------------------------------------------------
+void LuaInterpreter::NativeCallCallback(const char* className, const char* methodName,
+                                        const std::chrono::steady_clock::duration duration)
+    {
+    m_profiler.RecordNativeCall(className, methodName, duration);
+    }
+
+//------------------------------------------------------
+void LuaInterpreter::CountHookCallback(lua_State* L, lua_Debug* ar)
     {
     if (m_quitRequested)
         {
+        lua_getinfo(L, "l", ar);
         luaL_error(L, "BREAK_LINE:%d", ar->currentline);
         }
+
+    m_instructionsRun += HOOK_INSTRUCTION_INTERVAL;
+    // Budget errors are raised without luaL_where() (which would describe the caller
+    // of the current function when called from a hook), just a "line: message" like
+    // the other errors that the script runners reformat.
+    // Also, note that Lua is compiled as C, so errors longjmp out of here; hence, no
+    // objects with destructors are in scope when raising them.
+    if (m_instructionBudget > 0 && m_instructionsRun > m_instructionBudget)
+        {
+        lua_getinfo(L, "l", ar);
+        lua_pushfstring(L, "%d: script exceeded its budget of %I instructions.", ar->currentline,
+                        static_cast<lua_Integer>(m_instructionBudget));
+        lua_error(L);
+        }
+    if (m_timeBudget.count() > 0 &&
+        std::chrono::steady_clock::now() - m_scriptStartTime > m_timeBudget)
+        {
+        lua_getinfo(L, "l", ar);
+        lua_pushfstring(L, "%d: script exceeded its time budget of %f seconds.", ar->currentline,
+                        static_cast<lua_Number>(m_timeBudget.count()) / 1000);
+        lua_error(L);
+        }
+
+    if (m_profiler.IsRunning())
+        {
+        m_profiler.RecordSample(L, ar);
+        }
     }
 
 // NOLINTEND(readability-implicit-bool-conversion)
@@ -14,7 +14,10 @@
 #ifndef LUAINTERFACE_H
 #define LUAINTERFACE_H
 
+#include "lua_profiler.h"
 #include "luna.h"
+#include <chrono>
+#include <cstdint>
 #include <wx/wx.h>
 
 // NOLINTBEGIN(readability-identifier-length)
@@ -36,8 +39,9 @@ class LuaInterpreter
     /// @private
     LuaInterpreter& operator=(const LuaInterpreter&) = delete;
     /** @brief Runs a Lua script.
-        @param filePath The script's file path. Code will be loaded from this file.*/
-    void RunLuaFile(const wxString& filePath);
+        @param filePath The script's file path. Code will be loaded from this file.
+        @returns @c true if the script ran without errors.*/
+    bool RunLuaFile(const wxString& filePath);
     /** @brief Runs a block of Lua code.
         @param code The code to run.
         @param filePath The script's file path. This is only used for any calls to GetScriptPath()
@@ -48,6 +52,12 @@ class LuaInterpreter
             the message reported by the interpreter.*/
     void RunLuaCode(const wxString& code, const wxString& filePath, wxString& errorMessage);
 
+    /** @brief Removes the libraries that only work with the program's windows
+            (i.e., @c ScreenshotLib).
+        @details This is called when running headless, so that scripts calling them
+            fail with a Lua error instead of accessing windows that don't exist.*/
+    void RemoveInterfaceLibraries();
+
     /// @returns @c true if another block of Lua code is already running.
     [[nodiscard]]
     static bool IsRunning() noexcept
@@ -58,6 +68,38 @@ class LuaInterpreter
     /// @brief Stop running the current script.
     static void Quit() { m_quitRequested = true; }
 
+    /** @brief Sets how many Lua instructions a script may run before it is stopped.
+        @details This (and the time budget) applies to the next script that is run
+            (or, if called from a script, to that script) and is cleared once
+            the script finishes.\n
+            The count is cumulative across the whole run, so instructions that ran
+            before this was called (from within the script) count against it.\n
+            The limit is checked every @c HOOK_INSTRUCTION_INTERVAL instructions,
+            so a script may go slightly past it.
+        @param instructionCount The instruction limit. @c 0 means no limit.*/
+    static void SetInstructionBudget(const uint64_t instructionCount) noexcept
+        {
+        m_instructionBudget = instructionCount;
+        }
+
+    /** @brief Sets how long a script may run before it is stopped.
+        @details Like the instruction budget, this is measured from when the script started.\n
+            Time spent inside of a native call (e.g., loading a batch project)
+            is counted, but the script is only stopped once control returns to Lua.
+        @param duration The time limit. @c 0 means no limit.*/
+    static void SetTimeBudget(const std::chrono::milliseconds duration) noexcept
+        {
+        m_timeBudget = duration;
+        }
+
+    /** @brief Starts sampling the running script's lines and timing its calls
+            into native project methods.
+        @details The report is printed when StopProfiler() is called, or when
+            the script finishes.*/
+    static void StartProfiler();
+    /// @brief Stops the profiler and prints its report.
+    static void StopProfiler();
+
     /// @returns The file path of the currently running script
     ///     (may be empty if RunLuaCode() was called with no defined file path).
     [[nodiscard]]
@@ -71,11 +113,25 @@ class LuaInterpreter
     void SetScriptFilePath(const wxString& path) { m_scriptFilePath = path; }
 
   private:
-    static void LineHookCallback(lua_State* L, lua_Debug* ar);
+    /// @brief How many instructions are run between calls to the hook.
+    /// @details A line hook would be called for every line, which is more overhead than
+    ///     needed for checking for a quit request or a budget being exceeded.
+    constexpr static int HOOK_INSTRUCTION_INTERVAL{ 1000 };
+
+    static void CountHookCallback(lua_State* L, lua_Debug* ar);
+    static void NativeCallCallback(const char* className, const char* methodName,
+                                   const std::chrono::steady_clock::duration duration);
+    void BeginScript(const wxString& filePath);
+    static void EndScript();
 
     lua_State* m_L{ nullptr };
     static bool m_isRunning;
     static bool m_quitRequested;
+    static uint64_t m_instructionBudget;
+    static uint64_t m_instructionsRun;
+    static std::chrono::milliseconds m_timeBudget;
+    static std::chrono::steady_clock::time_point m_scriptStartTime;
+    static LuaProfiler m_profiler;
     wxString m_scriptFilePath;
     };
 
@@ -0,0 +1,99 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "lua_profiler.h"
+#include <algorithm>
+#include <vector>
+#include <wx/intl.h>
+#include <wx/numformatter.h>
+
+// NOLINTBEGIN(readability-identifier-length)
+
+//------------------------------------------------------
+void LuaProfiler::Start()
+    {
+    m_sampleCount = 0;
+    m_lineSamples.clear();
+    m_nativeCalls.clear();
+    m_isRunning = true;
+    }
+
+//------------------------------------------------------
+void LuaProfiler::RecordSample(lua_State* L, lua_Debug* ar)
+    {
+    if (!m_isRunning || lua_getinfo(L, "Sl", ar) == 0 || ar->currentline < 0)
+        {
+        return;
+        }
+    ++m_sampleCount;
+    ++m_lineSamples[std::string{ ar->short_src } + ':' + std::to_string(ar->currentline)];
+    }
+
+//------------------------------------------------------
+void LuaProfiler::RecordNativeCall(const char* className, const char* methodName,
+                                   const std::chrono::steady_clock::duration duration)
+    {
+    if (!m_isRunning)
+        {
+        return;
+        }
+    auto& stats = m_nativeCalls[std::string{ className } + ':' + methodName];
+    ++stats.m_callCount;
+    stats.m_totalTime += duration;
+    }
+
+//------------------------------------------------------
+wxString LuaProfiler::FormatReport(const size_t maxLines /*= 20*/) const
+    {
+    wxString report = wxString::Format(
+        _(L"Profiler: %s samples"),
+        wxNumberFormatter::ToString(static_cast<double>(m_sampleCount), 0,
+                                    wxNumberFormatter::Style::Style_WithThousandsSep));
+
+    std::vector<std::pair<std::string, uint64_t>> hotLines(m_lineSamples.cbegin(),
+                                                           m_lineSamples.cend());
+    std::sort(hotLines.begin(), hotLines.end(),
+              [](const auto& first, const auto& second) { return first.second > second.second; });
+    if (!hotLines.empty())
+        {
+        report += L"\n" + _(L"Hot lines:");
+        }
+    for (size_t i = 0; i < std::min(maxLines, hotLines.size()); ++i)
+        {
+        report += wxString::Format(
+            L"\n    %s    %.1f%% (%s)", wxString{ hotLines[i].first.c_str(), wxConvUTF8 },
+            (static_cast<double>(hotLines[i].second) / m_sampleCount) * 100,
+            wxNumberFormatter::ToString(static_cast<double>(hotLines[i].second), 0,
+                                        wxNumberFormatter::Style::Style_WithThousandsSep));
+        }
+
+    std::vector<std::pair<std::string, NativeCallStats>> nativeCalls(m_nativeCalls.cbegin(),
+                                                                     m_nativeCalls.cend());
+    std::sort(nativeCalls.begin(), nativeCalls.end(), [](const auto& first, const auto& second)
+              { return first.second.m_totalTime > second.second.m_totalTime; });
+    if (!nativeCalls.empty())
+        {
+        report += L"\n" + _(L"Time in native calls:");
+        }
+    for (size_t i = 0; i < std::min(maxLines, nativeCalls.size()); ++i)
+        {
+        report += wxString::Format(
+            // TRANSLATORS: a method name, its call count, and time (in seconds) spent in it
+            L"\n    %s    " + _(L"%zu call(s), %.3f seconds"),
+            wxString{ nativeCalls[i].first.c_str(), wxConvUTF8 }, nativeCalls[i].second.m_callCount,
+            std::chrono::duration<double>(nativeCalls[i].second.m_totalTime).count());
+        }
+    return report;
+    }
+
+// NOLINTEND(readability-identifier-length)
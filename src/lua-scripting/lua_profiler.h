@@ -0,0 +1,84 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef LUA_PROFILER_H
+#define LUA_PROFILER_H
+
+#include "lua.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <wx/string.h>
+
+// NOLINTBEGIN(readability-identifier-length)
+
+/** @brief Sampling profiler for Lua scripts.
+    @details The interpreter's count hook calls RecordSample() every so many instructions,
+        so the number of samples a line receives is proportional to the time spent on it
+        (without paying for a hook on every line).\n
+        Calls into native project methods (e.g., @c BatchProject:LoadFolder()) are
+        timed separately, as a single Lua line that calls into them can be where most
+        of the script's time actually goes.*/
+class LuaProfiler
+    {
+  public:
+    /// @brief Clears any previous results and starts collecting.
+    void Start();
+
+    /// @brief Stops collecting (results are kept until the next Start()).
+    void Stop() noexcept { m_isRunning = false; }
+
+    /// @returns @c true if the profiler is collecting samples.
+    [[nodiscard]]
+    bool IsRunning() const noexcept
+        {
+        return m_isRunning;
+        }
+
+    /** @brief Records a sample of the line that is currently running.
+        @param L The Lua state.
+        @param ar The debug info from the hook.*/
+    void RecordSample(lua_State* L, lua_Debug* ar);
+
+    /** @brief Records the duration of a call into a native method.
+        @param className The class that the method belongs to.
+        @param methodName The method's name.
+        @param duration How long the call took.*/
+    void RecordNativeCall(const char* className, const char* methodName,
+                          const std::chrono::steady_clock::duration duration);
+
+    /** @returns A report of the most frequently sampled lines and the
+            time spent in native methods (slowest first).
+        @param maxLines The maximum number of lines (and methods) to list.*/
+    [[nodiscard]]
+    wxString FormatReport(const size_t maxLines = 20) const;
+
+  private:
+    struct NativeCallStats
+        {
+        size_t m_callCount{ 0 };
+        std::chrono::steady_clock::duration m_totalTime{ 0 };
+        };
+
+    bool m_isRunning{ false };
+    uint64_t m_sampleCount{ 0 };
+    // "source:line" and its sample count
+    std::unordered_map<std::string, uint64_t> m_lineSamples;
+    // "Class:Method" and its timings
+    std::unordered_map<std::string, NativeCallStats> m_nativeCalls;
+    };
+
+// NOLINTEND(readability-identifier-length)
+
+#endif // LUA_PROFILER_H
@@ -1342,7 +1342,7 @@ namespace LuaScripting
         {
         if (lua_gettop(L) < 5)
             {
-            wxMessageBox(
+            ShowMessage(
                 wxString::Format(_(L"%s: invalid number of arguments."), wxString(__func__)),
                 _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
@@ -1367,7 +1367,7 @@ namespace LuaScripting
         {
         if (lua_gettop(L) < 7)
             {
-            wxMessageBox(
+            ShowMessage(
                 wxString::Format(_(L"%s: invalid number of arguments."), wxString(__func__)),
                 _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushboolean(L, false);
@@ -19,6 +19,7 @@
 #include "../projects/batch_project_view.h"
 #include "../projects/standard_project_doc.h"
 #include "../ui/dialogs/tools_options_dlg.h"
+#include "lua_analysis_views.h"
 
 using namespace Wisteria;
 using namespace Wisteria::Graphs;
@@ -44,8 +45,7 @@ namespace LuaScripting
         const auto createProject = [this](const wxString& folderPath)
         {
             // create a standard project and dump the text into it
-            const wxList& templateList =
-                wxGetApp().GetMainFrame()->GetDocumentManager()->GetTemplates();
+            const wxList& templateList = wxGetApp().GetDocManager()->GetTemplates();
             for (size_t i = 0; i < templateList.GetCount(); ++i)
                 {
                 wxDocTemplate* docTemplate =
@@ -67,7 +67,15 @@ namespace LuaScripting
                         if (!m_project->OnNewDocument())
                             {
                             // Document is implicitly deleted by DeleteAllViews
-                            m_project->DeleteAllViews();
+                            // (unless it doesn't have any, when running headless)
+                            if (m_project->GetViews().empty())
+                                {
+                                wxGetApp().GetDocManager()->CloseDocument(m_project, true);
+                                }
+                            else
+                                {
+                                m_project->DeleteAllViews();
+                                }
                             m_project = nullptr;
                             }
                         else if (folderPath == L"EMPTY_PROJECT")
@@ -90,13 +98,17 @@ namespace LuaScripting
                          wxPATH_NORM_ABSOLUTE);
             if (fn.GetExt().CmpNoCase(_DT(L"rsp")) == 0)
                 {
-                m_project = dynamic_cast<ProjectDoc*>(wxGetApp().GetMainFrame()->OpenFile(path));
+                // (there is no main frame to open it when running headless)
+                m_project = dynamic_cast<ProjectDoc*>(
+                    wxGetApp().IsHeadless() ?
+                        wxGetApp().GetDocManager()->CreateDocument(path, wxDOC_SILENT) :
+                        wxGetApp().GetMainFrame()->OpenFile(path));
                 }
             else if (fn.GetExt().CmpNoCase(_DT(L"rsbp")) == 0)
                 {
                 m_project = nullptr;
-                wxMessageBox(_(L"A standard project cannot open a batch project file."),
-                             _(L"Project File Mismatch"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(_(L"A standard project cannot open a batch project file."),
+                            _(L"Project File Mismatch"), wxOK | wxICON_EXCLAMATION);
                 return;
                 }
             else if (path.empty())
@@ -150,6 +162,20 @@ namespace LuaScripting
         return 0;
         }
 
+    //-------------------------------------------------------------
+    bool StandardProject::VerifyWordListIsLoaded(const readability::test_factor wordList)
+        {
+        // the list's pass is skipped during indexing if no included test needed it then
+        if (!m_project->GetLoadedWordListFactors().test(static_cast<size_t>(wordList)) &&
+            m_project->GetRequiredWordListFactors().test(static_cast<size_t>(wordList)))
+            {
+            m_project->RefreshRequired(ProjectRefresh::FullReindexing);
+            m_project->RefreshProject();
+            wxGetApp().Yield();
+            }
+        return m_project->GetLoadedWordListFactors().test(static_cast<size_t>(wordList));
+        }
+
     //-------------------------------------------------------------
     int StandardProject::DelayReloading(lua_State* L)
         {
@@ -241,8 +267,8 @@ namespace LuaScripting
             }
         if (m_project->GetProjectLanguage() == readability::test_language::german_test)
             {
-            wxMessageBox(_(L"ProperNounCount() not supported for German projects."),
-                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessage(_(L"ProperNounCount() not supported for German projects."),
+                        _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
             lua_pushinteger(L, 0);
             return 1;
             }
@@ -402,6 +428,15 @@ namespace LuaScripting
             {
             return 0;
             }
+        if (!VerifyWordListIsLoaded(readability::test_factor::word_familiarity_spache))
+            {
+            return luaL_error(
+                L, "%s",
+                static_cast<const char*>(wxString::Format(
+                    // TRANSLATORS: %s is a function name that failed from a script
+                    _(L"%s: the Spache test must be included to count its unfamiliar words."),
+                    __func__)));
+            }
 
         lua_pushinteger(L, m_project->GetTotalHardWordsSpache());
         return 1;
@@ -414,6 +449,15 @@ namespace LuaScripting
             {
             return 0;
             }
+        if (!VerifyWordListIsLoaded(readability::test_factor::word_familiarity_dale_chall))
+            {
+            return luaL_error(
+                L, "%s",
+                static_cast<const char*>(wxString::Format(
+                    // TRANSLATORS: %s is a function name that failed from a script
+                    _(L"%s: the Dale-Chall test must be included to count its unfamiliar words."),
+                    __func__)));
+            }
 
         lua_pushinteger(L, m_project->GetTotalHardWordsDaleChall());
         return 1;
@@ -426,11 +470,200 @@ namespace LuaScripting
             {
             return 0;
             }
+        if (!VerifyWordListIsLoaded(readability::test_factor::word_familiarity_harris_jacobson))
+            {
+            return luaL_error(
+                L, "%s",
+                static_cast<const char*>(wxString::Format(
+                    // TRANSLATORS: %s is a function name that failed from a script
+                    _(L"%s: the Harris-Jacobson test must be included to count its unfamiliar words."),
+                    __func__)));
+            }
 
         lua_pushinteger(L, m_project->GetTotalHardWordsHarrisJacobson());
         return 1;
         }
 
+    //-------------------------------------------------------------
+    int StandardProject::GetWords(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::WordText);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetWordSyllableCounts(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::WordSyllableCounts);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetWordCharacterCounts(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::WordCharacterCounts);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetWordSentenceIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::WordSentenceIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetWordValidity(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::WordValidity);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetSentenceWordCounts(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::SentenceWordCounts);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetSentenceFirstWordIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::SentenceFirstWordIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetSentenceValidity(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::SentenceValidity);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetParagraphSentenceCounts(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::ParagraphSentenceCounts);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetParagraphFirstSentenceIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::ParagraphFirstSentenceIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetRepeatedWordIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::RepeatedWordIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetArticleMismatchIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::ArticleMismatchIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetPassiveVoiceIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::PassiveVoiceIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetConjunctionStartingSentenceIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::ConjunctionStartingSentenceIndices);
+        return 1;
+        }
+
+    //-------------------------------------------------------------
+    int StandardProject::GetLowercasedSentenceIndices(lua_State* L)
+        {
+        if (!VerifyProjectIsOpen(__func__))
+            {
+            return 0;
+            }
+
+        PushAnalysisArray(L, m_project->GetWords(), AnalysisArrayType::LowercasedSentenceIndices);
+        return 1;
+        }
+
     //-------------------------------------------------------------
     int StandardProject::SetTextExclusion(lua_State* L)
         {
@@ -3565,7 +3798,7 @@ namespace LuaScripting
                     }
                 else
                     {
-                    wxMessageBox(
+                    ShowMessage(
                         wxString::Format(_(L"%s: unknown test could not be added."), testName),
                         _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                     lua_pushboolean(L, false);
@@ -3621,7 +3854,7 @@ namespace LuaScripting
                         }
                     else
                         {
-                        wxMessageBox(
+                        ShowMessage(
                             wxString::Format(_(L"%s: unknown test could not be added."), testName),
                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                         lua_pushboolean(L, false);
@@ -3737,8 +3970,8 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(_(L"Unable to find the scores in the project."), _(L"Script Error"),
-                             wxOK | wxICON_EXCLAMATION);
+                ShowMessage(_(L"Unable to find the scores in the project."), _(L"Script Error"),
+                            wxOK | wxICON_EXCLAMATION);
                 lua_pushboolean(L, false);
                 return 1;
                 }
@@ -3766,7 +3999,7 @@ namespace LuaScripting
             const auto idPos = wxGetApp().GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (idPos == wxGetApp().GetDynamicIdMap().cend())
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified graph (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -3828,7 +4061,7 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified graph (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -3892,7 +4125,7 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(
                         _(L"Unable to find the specified highlighted words (%d) in the project."),
                         static_cast<int>(luaL_checkinteger(L, 2))),
@@ -3982,7 +4215,7 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified report (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -4065,7 +4298,7 @@ namespace LuaScripting
                 }
             else
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified list (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -4198,10 +4431,10 @@ namespace LuaScripting
             const auto sectionId = wxGetApp().GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (sectionId == wxGetApp().GetDynamicIdMap().cend())
                 {
-                wxMessageBox(wxString::Format(
-                                 _(L"Unable to find the specified section (%d) in the project."),
-                                 static_cast<int>(luaL_checkinteger(L, 2))),
-                             _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
+                ShowMessage(wxString::Format(
+                                _(L"Unable to find the specified section (%d) in the project."),
+                                static_cast<int>(luaL_checkinteger(L, 2))),
+                            _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
                 return 0;
                 }
             std::optional<wxWindowID> windowId{ std::nullopt };
@@ -4354,7 +4587,7 @@ namespace LuaScripting
             const auto graphID = wxGetApp().GetDynamicIdMap().find(luaL_checkinteger(L, 2));
             if (graphID == wxGetApp().GetDynamicIdMap().cend())
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(_(L"Unable to find the specified graph (%d) in the project."),
                                      static_cast<int>(luaL_checkinteger(L, 2))),
                     _(L"Script Error"), wxOK | wxICON_EXCLAMATION);
@@ -4547,6 +4780,12 @@ namespace LuaScripting
             return 0;
             }
 
+        // (no dialogs to show when running headless)
+        if (wxGetApp().IsHeadless())
+            {
+            return 0;
+            }
+
         if (m_settingsDlg == nullptr)
             {
             m_settingsDlg = new ToolsOptionsDlg(wxGetApp().GetMainFrame(), m_project);
@@ -4604,6 +4843,21 @@ namespace LuaScripting
         LUNA_DECLARE_METHOD(StandardProject, GetUnfamiliarSpacheWordCount),
         LUNA_DECLARE_METHOD(StandardProject, GetUnfamiliarDCWordCount),
         LUNA_DECLARE_METHOD(StandardProject, GetUnfamiliarHJWordCount),
+        LUNA_DECLARE_METHOD(StandardProject, GetWords),
+        LUNA_DECLARE_METHOD(StandardProject, GetWordSyllableCounts),
+        LUNA_DECLARE_METHOD(StandardProject, GetWordCharacterCounts),
+        LUNA_DECLARE_METHOD(StandardProject, GetWordSentenceIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetWordValidity),
+        LUNA_DECLARE_METHOD(StandardProject, GetSentenceWordCounts),
+        LUNA_DECLARE_METHOD(StandardProject, GetSentenceFirstWordIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetSentenceValidity),
+        LUNA_DECLARE_METHOD(StandardProject, GetParagraphSentenceCounts),
+        LUNA_DECLARE_METHOD(StandardProject, GetParagraphFirstSentenceIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetRepeatedWordIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetArticleMismatchIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetPassiveVoiceIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetConjunctionStartingSentenceIndices),
+        LUNA_DECLARE_METHOD(StandardProject, GetLowercasedSentenceIndices),
         LUNA_DECLARE_METHOD(StandardProject, SetPhraseExclusionList),
         LUNA_DECLARE_METHOD(StandardProject, GetPhraseExclusionList),
         LUNA_DECLARE_METHOD(StandardProject, SetBlockExclusionTags),
@@ -14,6 +14,7 @@
 #ifndef LUA_STANDARD_PROJECTS_H
 #define LUA_STANDARD_PROJECTS_H
 
+#include "../readability/readability_test.h"
 #include "lua_debug.h"
 #include "luna.h"
 #include <wx/wx.h>
@@ -41,9 +42,9 @@ namespace LuaScripting
             {
             if (m_project == nullptr)
                 {
-                wxMessageBox(wxString::Format(_(L"%s: accessing project that is already closed."),
-                                              functionName),
-                             _(L"Warning"), wxOK | wxICON_INFORMATION);
+                ShowMessage(wxString::Format(_(L"%s: accessing project that is already closed."),
+                                             functionName),
+                            _(L"Warning"), wxOK | wxICON_INFORMATION);
                 return false;
                 }
             else
@@ -65,7 +66,7 @@ namespace LuaScripting
             // routing the function to the class object.
             if ((lua_gettop(L) - 1) < minParameterCount)
                 {
-                wxMessageBox(
+                ShowMessage(
                     wxString::Format(
                         // TRANSLATORS: %s is a function name that failed from a script
                         _(L"%s: invalid number of arguments.\n\n%d expected, %d provided."),
@@ -81,6 +82,10 @@ namespace LuaScripting
 
         bool ReloadIfNotDelayed();
         bool ReloadIfNotDelayedSimple();
+        /// @returns @c true if the document was indexed with the pass for the given
+        ///     familiar-word list, reindexing it first if an included test needs the list.
+        [[nodiscard]]
+        bool VerifyWordListIsLoaded(const readability::test_factor wordList);
         bool m_delayReloading{ false };
 
       public:
@@ -126,6 +131,23 @@ namespace LuaScripting
         int /*number*/ GetUnfamiliarDCWordCount(lua_State* L); // Returns the number of words unfamiliar to the Dale-Chall test from the document.
         int /*number*/ GetUnfamiliarHJWordCount(lua_State* L); // Returns the number of words unfamiliar to the Harris-Jacobson test from the document.
 
+        // Analysis data (read-only array views over the indexed document)
+        int /*AnalysisArray*/ GetWords(lua_State* L); // Returns an array view of the document's words.
+        int /*AnalysisArray*/ GetWordSyllableCounts(lua_State* L); // Returns an array view of the syllable count of each word.
+        int /*AnalysisArray*/ GetWordCharacterCounts(lua_State* L); // Returns an array view of the character count (excluding punctuation) of each word.
+        int /*AnalysisArray*/ GetWordSentenceIndices(lua_State* L); // Returns an array view of the index of the sentence that each word belongs to.
+        int /*AnalysisArray*/ GetWordValidity(lua_State* L); // Returns an array view of whether each word is included in the analysis (i.e., not excluded).
+        int /*AnalysisArray*/ GetSentenceWordCounts(lua_State* L); // Returns an array view of the word count of each sentence.
+        int /*AnalysisArray*/ GetSentenceFirstWordIndices(lua_State* L); // Returns an array view of the index of the first word of each sentence.
+        int /*AnalysisArray*/ GetSentenceValidity(lua_State* L); // Returns an array view of whether each sentence is included in the analysis (i.e., not excluded).
+        int /*AnalysisArray*/ GetParagraphSentenceCounts(lua_State* L); // Returns an array view of the sentence count of each paragraph.
+        int /*AnalysisArray*/ GetParagraphFirstSentenceIndices(lua_State* L); // Returns an array view of the index of the first sentence of each paragraph.
+        int /*AnalysisArray*/ GetRepeatedWordIndices(lua_State* L); // Returns an array view of the indices of repeated words.
+        int /*AnalysisArray*/ GetArticleMismatchIndices(lua_State* L); // Returns an array view of the indices of mismatched articles.
+        int /*AnalysisArray*/ GetPassiveVoiceIndices(lua_State* L); // Returns an array view of the indices of the first word of each passive voice phrase.
+        int /*AnalysisArray*/ GetConjunctionStartingSentenceIndices(lua_State* L); // Returns an array view of the indices of sentences that begin with a conjunction.
+        int /*AnalysisArray*/ GetLowercasedSentenceIndices(lua_State* L); // Returns an array view of the indices of sentences that begin with a lowercased word.
+
         // SUMMARY STATS
         int SetSummaryStatsResultsOptions(lua_State* L /*boolean includeFormattedReport, boolean TabularReport*/); // Sets which results in the summary statistics section should be included.
         int SetSummaryStatsReportOptions(lua_State* L /*boolean includeParagraphs, boolean includeSentences, boolean includeWords, boolean includeExtendedWords, boolean includeGrammar, boolean includeNotes, boolean includeExtendedInfo*/); // Sets which results in the summary statistics reports should be included.
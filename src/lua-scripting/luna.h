@@ -8,8 +8,21 @@
 #define LUA_LUNA_H
 
 #include "lua.hpp"
+#include <chrono>
 #include <string.h> // For strlen
 
+/*
+@ LunaCallObserver
+Optional callback that is notified after each bound constructor or method call,
+with the class and method names and how long the call took (e.g., for profiling).
+Leave as null (the default) to call the methods without timing them.
+*/
+struct LunaCallObserver {
+    using Callback = void (*)(const char* className, const char* methodName,
+                              std::chrono::steady_clock::duration duration);
+    static inline Callback callback = nullptr;
+};
+
 template < typename T > class Luna {
 public:
 
@@ -175,7 +188,10 @@ public:
     */
     static int constructor(lua_State * L)
     {
+        const auto start = std::chrono::steady_clock::now();
         T*  ap = new T(L);
+        if (LunaCallObserver::callback)
+            LunaCallObserver::callback(T::className, "new", std::chrono::steady_clock::now() - start);
         T** a = static_cast<T**>(lua_newuserdata(L, sizeof(T *))); // Push value = userdata
         *a = ap;
 
@@ -294,7 +310,16 @@ public:
         int i = (int)lua_tonumber(L, lua_upvalueindex(1));
         T** obj = static_cast < T ** >(lua_touserdata(L, lua_upvalueindex(2)));
 
-        return ((*obj)->*(T::methods[i].func)) (L);
+        if (!LunaCallObserver::callback)
+            return ((*obj)->*(T::methods[i].func)) (L);
+
+        const auto start = std::chrono::steady_clock::now();
+        const int result = ((*obj)->*(T::methods[i].func)) (L);
+        // re-read the callback, the method may have stopped the profiler
+        if (LunaCallObserver::callback)
+            LunaCallObserver::callback(T::className, T::methods[i].name,
+                                       std::chrono::steady_clock::now() - start);
+        return result;
     }
 
     /*
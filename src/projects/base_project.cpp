@@ -19,11 +19,13 @@
 #include "../app/readability_app.h"
 #include "../indexing/diacritics.h"
 #include "../indexing/romanize.h"
+#include "../indexing/utf8_decode.h"
 #include "../results-format/project_report_format.h"
 #include "../results-format/word_collectiont_text_formatting.h"
 #include "../ui/dialogs/filtered_text_preview_dlg.h"
 #include "base_project_doc.h"
 #include "base_project_view.h"
+#include <cstring>
 
 wxDECLARE_APP(ReadabilityApp);
 
@@ -41,6 +43,9 @@ word_list BaseProject::known_spanish_spellings;
 word_list BaseProject::known_custom_spanish_spellings;
 word_list BaseProject::known_german_spellings;
 word_list BaseProject::known_custom_german_spellings;
+spelling_verdict_cache BaseProject::english_spelling_verdicts;
+spelling_verdict_cache BaseProject::spanish_spelling_verdicts;
+spelling_verdict_cache BaseProject::german_spelling_verdicts;
 word_list BaseProject::m_dale_chall_word_list;
 word_list BaseProject::m_dale_chall_plus_stocker_catholic_word_list;
 word_list BaseProject::m_stocker_catholic_word_list;
@@ -133,6 +138,7 @@ void BaseProject::UpdateDocumentSettings()
     GetWords()->ignore_indenting_when_determing_paragraph_split(
         IsIgnoringIndentingForParagraphsParser());
     GetWords()->sentence_start_must_be_uppercased(GetSentenceStartMustBeUppercased());
+    GetWords()->tokenize_in_parallel(IsTokenizingInParallel());
     GetWords()->set_copyright_phrase_function(&copyright_notice_phrases);
     GetWords()->set_citation_phrase_function(&citation_phrases);
     GetWords()->set_known_proper_nouns(&known_proper_nouns);
@@ -168,6 +174,7 @@ void BaseProject::UpdateDocumentSettings()
         GetWords()->set_known_phrase_function(&spanish_wordy_phrases);
         GetWords()->get_spell_checker().set_word_list(&known_spanish_spellings);
         GetWords()->get_spell_checker().set_secondary_word_list(&known_custom_spanish_spellings);
+        GetWords()->get_spell_checker().set_verdict_cache(&spanish_spelling_verdicts);
         GetWords()->set_search_for_proper_nouns(true);
         GetWords()->set_mismatched_article_function(nullptr);
         GetWords()->set_search_for_passive_voice(false);
@@ -181,6 +188,7 @@ void BaseProject::UpdateDocumentSettings()
         GetWords()->set_known_phrase_function(&german_wordy_phrases);
         GetWords()->get_spell_checker().set_word_list(&known_german_spellings);
         GetWords()->get_spell_checker().set_secondary_word_list(&known_custom_german_spellings);
+        GetWords()->get_spell_checker().set_verdict_cache(&german_spelling_verdicts);
         GetWords()->set_search_for_proper_nouns(false);
         GetWords()->set_mismatched_article_function(nullptr);
         GetWords()->set_search_for_passive_voice(false);
@@ -194,6 +202,7 @@ void BaseProject::UpdateDocumentSettings()
         GetWords()->set_known_phrase_function(&english_wordy_phrases);
         GetWords()->get_spell_checker().set_word_list(&known_english_spellings);
         GetWords()->get_spell_checker().set_secondary_word_list(&known_custom_english_spellings);
+        GetWords()->get_spell_checker().set_verdict_cache(&english_spelling_verdicts);
         GetWords()->set_search_for_proper_nouns(true);
         GetWords()->set_mismatched_article_function(&m_english_mismatched_article);
         GetWords()->set_search_for_passive_voice(true);
@@ -216,7 +225,8 @@ void BaseProject::LogMessage(wxString message, const wxString& title, const int
         {
         AddQueuedMessage(WarningMessage(messageId, message, title, wxString{}, icon));
         }
-    else if (HasUI())
+    // (unattended script runs keep these for the log, rather than blocking on a dialog)
+    else if (HasUI() && !wxGetApp().IsHeadless())
         {
         wxRichMessageDialog msg(wxGetApp().GetParentingWindow(), message,
                                 (title.length() ? title : wxGetApp().GetAppDisplayName()), icon);
@@ -249,31 +259,98 @@ void BaseProject::LogMessage(wxString message, const wxString& title, const int
     }
 
 //-------------------------------------------------------
-void BaseProject::FormatFilteredText(std::wstring& text, const bool romanizeText,
+bool BaseProject::FormatFilteredText(std::wstring& text, const bool romanizeText,
                                      const bool removeEllipses, const bool removeBullets,
                                      const bool removeFilePaths, const bool stripAbbreviations,
                                      const bool narrowFullWithText) const
     {
-    auto project = std::make_unique<BaseProject>();
-    project->CopySettings(*this);
-    project->SetAppendedDocumentText(GetAppendedDocumentText());
-    project->ShareExcludePhrases(*this);
-    project->SetUIMode(false);
-    project->SetOriginalDocumentFilePath(GetOriginalDocumentFilePath());
+    text.clear();
+    // a project to re-index the document is only needed if its index was freed
+    if (GetWords() != nullptr)
+        {
+        FormatFilteredWords(GetWords(), text, romanizeText, removeEllipses, removeBullets,
+                            removeFilePaths, stripAbbreviations, narrowFullWithText);
+        return true;
+        }
+    BaseProject indexingProject;
+    return FormatFilteredText(indexingProject, text, romanizeText, removeEllipses, removeBullets,
+                              removeFilePaths, stripAbbreviations, narrowFullWithText);
+    }
 
-    if (project->GetDocumentStorageMethod() == TextStorage::NoEmbedText)
+//-------------------------------------------------------
+bool BaseProject::FormatFilteredText(BaseProject& indexingProject, std::wstring& text,
+                                     const bool romanizeText, const bool removeEllipses,
+                                     const bool removeBullets, const bool removeFilePaths,
+                                     const bool stripAbbreviations,
+                                     const bool narrowFullWithText) const
+    {
+    text.clear();
+    if (GetWords() != nullptr)
         {
-        project->FreeDocumentText();
+        FormatFilteredWords(GetWords(), text, romanizeText, removeEllipses, removeBullets,
+                            removeFilePaths, stripAbbreviations, narrowFullWithText);
+        return true;
         }
-    if (!project->LoadDocumentAsSubProject(project->GetOriginalDocumentFilePath(),
-                                           project->GetDocumentText(), 1) ||
-        project->GetDocumentText().empty())
+
+    // re-index the document from its embedded text, its (local) file, or
+    // (as a last resort) from wherever the project normally loads it
+    indexingProject.CopySettings(*this);
+    // CopySettings() copies the UI mode too, but this may be on a worker thread
+    indexingProject.SetUIMode(false);
+    indexingProject.SetAppendedDocumentText(GetAppendedDocumentText());
+    indexingProject.ShareExcludePhrases(*this);
+    indexingProject.SetOriginalDocumentFilePath(GetOriginalDocumentFilePath());
+    indexingProject.GetDocumentText().assign(GetDocumentText());
+    if (indexingProject.GetDocumentText().empty() &&
+        FilePathResolver{ GetOriginalDocumentFilePath(), false }.IsLocalOrNetworkFile() &&
+        wxFile::Exists(GetOriginalDocumentFilePath()))
         {
-        return;
+        try
+            {
+            MemoryMappedFile sourceFile(GetOriginalDocumentFilePath(), true, true);
+            if (!indexingProject.ExtractRawText(
+                    { static_cast<const char*>(sourceFile.GetStream()), sourceFile.GetMapSize() },
+                    wxFileName{ GetOriginalDocumentFilePath() }.GetExt(),
+                    indexingProject.GetDocumentText()))
+                {
+                return false;
+                }
+            }
+        catch (const std::exception& exp)
+            {
+            wxLogWarning(L"%s: %s", GetOriginalDocumentFilePath(), wxString{ exp.what() });
+            return false;
+            }
+        catch (...)
+            {
+            wxLogWarning(L"%s: unable to read file.", GetOriginalDocumentFilePath());
+            return false;
+            }
+        }
+    if (!indexingProject.LoadDocumentAsSubProject(indexingProject.GetOriginalDocumentFilePath(),
+                                                  indexingProject.GetDocumentText(), 1) ||
+        indexingProject.GetWords() == nullptr)
+        {
+        return false;
         }
-    text.reserve(GetDocumentText().length());
+
+    FormatFilteredWords(indexingProject.GetWords(), text, romanizeText, removeEllipses,
+                        removeBullets, removeFilePaths, stripAbbreviations, narrowFullWithText);
+    // free the index, but keep the text buffer for the next document
+    indexingProject.DeleteUniqueWordMap();
+    indexingProject.DeleteWords();
+    indexingProject.GetDocumentText().clear();
+    return true;
+    }
+
+//-------------------------------------------------------
+void BaseProject::FormatFilteredWords(
+    const std::shared_ptr<CaseInSensitiveNonStemmingDocument>& words, std::wstring& text,
+    const bool romanizeText, const bool removeEllipses, const bool removeBullets,
+    const bool removeFilePaths, const bool stripAbbreviations, const bool narrowFullWithText) const
+    {
     FormatFilteredWordCollection(
-        project->GetWords(), text,
+        words, text,
         (GetInvalidSentenceMethod() == InvalidSentence::IncludeAsFullSentences) ?
             InvalidTextFilterFormat::IncludeAllText :
             InvalidTextFilterFormat::IncludeOnlyValidText,
@@ -286,6 +363,14 @@ void BaseProject::FormatFilteredText(std::wstring& text, const bool romanizeText
                     narrowFullWithText);
     }
 
+//-------------------------------------------------------
+bool BaseProject::CanFormatFilteredTextConcurrently() const
+    {
+    return GetWords() != nullptr || !GetDocumentText().empty() ||
+           (FilePathResolver{ GetOriginalDocumentFilePath(), false }.IsLocalOrNetworkFile() &&
+            wxFile::Exists(GetOriginalDocumentFilePath()));
+    }
+
 //-------------------------------------------------------
 bool BaseProject::IsIncludingClozeTest() const
     {
@@ -345,6 +430,7 @@ bool BaseProject::IsIncludingGradeTest() const
 //-------------------------------------------------------
 BaseProject::BaseProject()
     : m_minDocWordCountForBatch(wxGetApp().GetAppOptions().GetMinDocWordCountForBatch()),
+      m_nearDuplicateHandling(wxGetApp().GetAppOptions().GetNearDuplicateHandling()),
       m_includeIncompleteSentencesIfLongerThan(
           wxGetApp().GetAppOptions().GetIncludeIncompleteSentencesIfLongerThanValue()),
 
@@ -2001,6 +2087,9 @@ void BaseProject::InitializeStandardReadabilityTests()
 //-------------------------------------------------------
 void BaseProject::AddCustomReadabilityTests()
     {
+    pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::tests,
+                                            "BaseProject::AddCustomReadabilityTests");
+    stageTimer.set_items(m_customTestsInUse.size());
     // run through the tests
     for (const auto& pos : m_customTestsInUse)
         {
@@ -2008,10 +2097,39 @@ void BaseProject::AddCustomReadabilityTests()
         }
     }
 
+//-------------------------------------------------------
+readability::test_factor_set BaseProject::GetRequiredWordListFactors() const
+    {
+    readability::test_factor_set wordListFactors;
+    wordListFactors.set(
+        static_cast<size_t>(readability::test_factor::word_familiarity_dale_chall));
+    wordListFactors.set(static_cast<size_t>(readability::test_factor::word_familiarity_spache));
+    wordListFactors.set(
+        static_cast<size_t>(readability::test_factor::word_familiarity_harris_jacobson));
+    // custom formulas can reference the statistics from any of the standard lists
+    if (!m_customTestsInUse.empty())
+        {
+        return wordListFactors;
+        }
+    return (GetReadabilityTests().get_included_test_factors() & wordListFactors);
+    }
+
 //-------------------------------------------------------
 void BaseProject::LoadHardWords()
     {
     PROFILE();
+    pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::statistics,
+                                            "BaseProject::LoadHardWords");
+    stageTimer.set_items(GetWords()->get_word_count());
+    // only run the familiar-word list passes that the included tests need
+    m_loadedWordListFactors = GetRequiredWordListFactors();
+    const bool loadDaleChall = m_loadedWordListFactors.test(
+        static_cast<size_t>(readability::test_factor::word_familiarity_dale_chall));
+    const bool loadSpache = m_loadedWordListFactors.test(
+        static_cast<size_t>(readability::test_factor::word_familiarity_spache));
+    const bool loadHarrisJacobson = m_loadedWordListFactors.test(
+        static_cast<size_t>(readability::test_factor::word_familiarity_harris_jacobson));
+
     // complex words (3+ syllable)
     if (HasUI())
         {
@@ -2042,7 +2160,7 @@ void BaseProject::LoadHardWords()
     m_unique6CharsPlusWords = 0;
 
     // hard words (DC)
-    if (HasUI())
+    if (HasUI() && loadDaleChall)
         {
         if (GetDaleChallHardWordData() == nullptr)
             {
@@ -2070,7 +2188,7 @@ void BaseProject::LoadHardWords()
     m_uniqueHardFogWords = 0;
 
     // hard words (Spache)
-    if (HasUI())
+    if (HasUI() && loadSpache)
         {
         if (GetSpacheHardWordData() == nullptr)
             {
@@ -2104,7 +2222,7 @@ void BaseProject::LoadHardWords()
             &m_harris_jacobson_word_list,
             readability::proper_noun_counting_method::all_proper_nouns_are_unfamiliar, true);
     m_uniqueHarrisJacobsonHardWords = m_totalHardWordsHarrisJacobson = 0;
-    if (HasUI())
+    if (HasUI() && loadHarrisJacobson)
         {
         if (GetHarrisJacobsonHardWordDataData() == nullptr)
             {
@@ -2490,7 +2608,7 @@ void BaseProject::LoadHardWords()
             ++m_uniqueMiniWords;
             m_totalMiniWords += wordPos->second.first;
             }
-        if (!allInstancesAreProper &&
+        if (loadHarrisJacobson && !allInstancesAreProper &&
             (GetHarrisJacobsonTextExclusionMode() ==
              SpecializedTestTextExclusion::UseSystemDefault) &&
             !isHarrisJacobsonWord(wordPos->first))
@@ -2527,7 +2645,8 @@ void BaseProject::LoadHardWords()
             ++m_uniqueHarrisJacobsonHardWords;
             m_totalHardWordsHarrisJacobson += nonProperCount;
             }
-        if ((GetDaleChallTextExclusionMode() == SpecializedTestTextExclusion::UseSystemDefault) &&
+        if (loadDaleChall &&
+            (GetDaleChallTextExclusionMode() == SpecializedTestTextExclusion::UseSystemDefault) &&
             !isDCWord(wordPos->first))
             {
             // all forms of word are proper and proper words are familiar?
@@ -2641,7 +2760,7 @@ void BaseProject::LoadHardWords()
                                                  nonProperCount + 1;
                 }
             }
-        if (!allInstancesAreProper && !isSpacheWord(wordPos->first))
+        if (loadSpache && !allInstancesAreProper && !isSpacheWord(wordPos->first))
             {
             // only load the data for standard projects
             if (HasUI())
@@ -2900,8 +3019,9 @@ void BaseProject::LoadHardWords()
             }
         }
     // resize the difficult word vectors
-    if (HasUI() && (GetHarrisJacobsonTextExclusionMode() ==
-                    SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings))
+    if (HasUI() && loadHarrisJacobson &&
+        (GetHarrisJacobsonTextExclusionMode() ==
+         SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings))
         {
         if (GetHarrisJacobsonHardWordDataData() == nullptr)
             {
@@ -2912,8 +3032,9 @@ void BaseProject::LoadHardWords()
         GetHarrisJacobsonHardWordDataData()->SetSize(
             complete_sent_and_header_word_frequency_map.get_data().size(), 3);
         }
-    if (HasUI() && (GetDaleChallTextExclusionMode() ==
-                    SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings))
+    if (HasUI() && loadDaleChall &&
+        (GetDaleChallTextExclusionMode() ==
+         SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings))
         {
         if (GetDaleChallHardWordData() == nullptr)
             {
@@ -2955,7 +3076,7 @@ void BaseProject::LoadHardWords()
             {
             m_totalHardWordsSol += wordPos->second.first;
             }
-        if (!allInstancesAreProper &&
+        if (loadHarrisJacobson && !allInstancesAreProper &&
             (GetHarrisJacobsonTextExclusionMode() ==
              SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings) &&
             !isHarrisJacobsonWord(wordPos->first))
@@ -2992,7 +3113,8 @@ void BaseProject::LoadHardWords()
             ++m_uniqueHarrisJacobsonHardWords;
             m_totalHardWordsHarrisJacobson += nonProperCount;
             }
-        if ((GetDaleChallTextExclusionMode() ==
+        if (loadDaleChall &&
+            (GetDaleChallTextExclusionMode() ==
              SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings) &&
             !isDCWord(wordPos->first))
             {
@@ -3297,6 +3419,10 @@ void BaseProject::LoadHardWords()
 //-------------------------------------------------------
 void BaseProject::CalculateStatisticsIgnoringInvalidSentences()
     {
+    pipeline_stats::scoped_timer stageTimer(
+        pipeline_stats::stage::statistics,
+        "BaseProject::CalculateStatisticsIgnoringInvalidSentences");
+    stageTimer.set_items(GetWords()->get_word_count());
     m_totalWords = GetWords()->get_valid_word_count();
     m_totalSentences = GetWords()->get_complete_sentence_count();
     m_totalParagraphs = GetWords()->get_valid_paragraph_count();
@@ -3474,6 +3600,9 @@ void BaseProject::CalculateStatisticsIgnoringInvalidSentences()
 //-------------------------------------------------------
 void BaseProject::CalculateStatistics()
     {
+    pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::statistics,
+                                            "BaseProject::CalculateStatistics");
+    stageTimer.set_items(GetWords()->get_word_count());
     m_totalWords = GetWords()->get_word_count();
     m_totalSentences = GetWords()->get_sentence_count();
     m_totalParagraphs = GetWords()->get_paragraph_count();
@@ -3666,7 +3795,7 @@ BaseProject::ExtractRawTextWithEncoding(const std::wstring& sourceFileText,
                 }
             if (convertDiacritics(filteredText))
                 {
-                filteredText = convertDiacritics.get_conversion();
+                filteredText = std::move(convertDiacritics.get_conversion());
                 }
             label = coalesce<wchar_t>({ filter_html.get_subject(), filter_html.get_title(),
                                         filter_html.get_keywords(), filter_html.get_description(),
@@ -3721,7 +3850,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractDocxRawText(std::string_view s
         std::wstring extractedText = filter_docx.get_filtered_buffer();
         if (convertDiacritics(extractedText))
             {
-            extractedText = convertDiacritics.get_conversion();
+            extractedText = std::move(convertDiacritics.get_conversion());
             }
         return std::make_pair(true, std::move(extractedText));
         }
@@ -3755,7 +3884,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractDocRawText(std::string_view so
         std::wstring extractedText = filter_word.get_filtered_buffer();
         if (convertDiacritics(extractedText))
             {
-            extractedText = convertDiacritics.get_conversion();
+            extractedText = std::move(convertDiacritics.get_conversion());
             }
         return std::make_pair(true, std::move(extractedText));
         }
@@ -3849,7 +3978,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractRtfRawText(std::string_view so
         std::wstring extractedText = filter_rtf.get_filtered_buffer();
         if (convertDiacritics(extractedText))
             {
-            extractedText = convertDiacritics.get_conversion();
+            extractedText = std::move(convertDiacritics.get_conversion());
             }
         return std::make_pair(true, std::move(extractedText));
         }
@@ -3973,7 +4102,7 @@ BaseProject::ExtractOpenDocumentRawText(std::string_view sourceFileText)
         std::wstring extractedText = filter_odt.get_filtered_buffer();
         if (convertDiacritics(extractedText))
             {
-            extractedText = convertDiacritics.get_conversion();
+            extractedText = std::move(convertDiacritics.get_conversion());
             }
         return std::make_pair(true, std::move(extractedText));
         }
@@ -3994,11 +4123,7 @@ BaseProject::ExtractHtmlRawText(std::string_view sourceFileText,
     {
     if (isHtmlExtension.IsDynamicExtension(fileExtension))
         {
-        const size_t bomStartLength =
-            (utf8::starts_with_bom(sourceFileText.data(),
-                                   sourceFileText.data() + sourceFileText.length()) ?
-                 3 :
-                 0);
+        const size_t bomStartLength = encoding::bom_length(encoding::sniff_bom(sourceFileText));
         size_t firstCharIndex{ bomStartLength };
         while (firstCharIndex < sourceFileText.length() &&
                characters::is_character::is_space(sourceFileText[firstCharIndex]))
@@ -4012,27 +4137,19 @@ BaseProject::ExtractHtmlRawText(std::string_view sourceFileText,
             return std::make_pair(false, std::wstring{});
             }
         }
-    std::pair<bool, std::wstring> extractResult(false, std::wstring{});
     wxString label;
-    // if UTF-8 or simply 7-bit ASCII, then just convert as UTF-8 and run the HTML parser on it
-    if (utf8::is_valid(sourceFileText.data(), sourceFileText.data() + sourceFileText.length()))
-        {
-        extractResult =
-            ExtractRawTextWithEncoding(Wisteria::TextStream::CharStreamToUnicode(
-                                           sourceFileText.data(), sourceFileText.length()),
-                                       L"html", GetOriginalDocumentFilePath(), label);
-        }
-    // Otherwise, need to search for the encoding in the HTML itself and convert using that,
-    // then run the HTML parser on it
-    else
-        {
-        extractResult =
-            ExtractRawTextWithEncoding(Wisteria::TextStream::CharStreamToUnicode(
-                                           sourceFileText.data(), sourceFileText.length(),
-                                           WebHarvester::GetCharsetFromPageContent(
-                                               { sourceFileText.data(), sourceFileText.length() })),
-                                       L"html", GetOriginalDocumentFilePath(), label);
-        }
+    // if UTF-8 or simply 7-bit ASCII, then just convert as UTF-8 and run the HTML parser on it;
+    // otherwise, need to search for the encoding in the HTML itself and convert using that
+    std::wstring htmlText;
+    if (!DecodeUtf8Stream(sourceFileText, htmlText))
+        {
+        htmlText = Wisteria::TextStream::CharStreamToUnicode(
+            sourceFileText.data(), sourceFileText.length(),
+            WebHarvester::GetCharsetFromPageContent(
+                { sourceFileText.data(), sourceFileText.length() }));
+        }
+    std::pair<bool, std::wstring> extractResult =
+        ExtractRawTextWithEncoding(htmlText, L"html", GetOriginalDocumentFilePath(), label);
     if (!extractResult.first)
         {
         LogMessage(_(L"An unknown error occurred while importing. "
@@ -4106,7 +4223,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractPowerPointRawText(std::string_
 
     if (convertDiacritics(pptParsedText))
         {
-        pptParsedText = convertDiacritics.get_conversion();
+        pptParsedText = std::move(convertDiacritics.get_conversion());
         }
     return std::make_pair(true, std::move(pptParsedText));
     }
@@ -4132,7 +4249,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractWorkshopRawText(std::string_vi
         std::wstring extractedText = filter_hhc_hhk.get_filtered_buffer();
         if (convertDiacritics(extractedText))
             {
-            extractedText = convertDiacritics.get_conversion();
+            extractedText = std::move(convertDiacritics.get_conversion());
             }
         return std::make_pair(true, std::move(extractedText));
         }
@@ -4161,7 +4278,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractIdlRawText(std::string_view so
     std::wstring extractedText = filter_idl.get_filtered_buffer();
     if (convertDiacritics(extractedText))
         {
-        extractedText = convertDiacritics.get_conversion();
+        extractedText = std::move(convertDiacritics.get_conversion());
         }
     return std::make_pair(true, std::move(extractedText));
     }
@@ -4183,7 +4300,7 @@ std::pair<bool, std::wstring> BaseProject::ExtractCppRawText(std::string_view so
     std::wstring extractedText = filter_cpp.get_filtered_buffer();
     if (convertDiacritics(extractedText))
         {
-        extractedText = convertDiacritics.get_conversion();
+        extractedText = std::move(convertDiacritics.get_conversion());
         }
     return std::make_pair(true, std::move(extractedText));
     }
@@ -4202,91 +4319,141 @@ std::pair<bool, std::wstring> BaseProject::ExtractMarkdownRawText(std::string_vi
     std::wstring extractedText = filter_md.get_filtered_buffer();
     if (convertDiacritics(extractedText))
         {
-        extractedText = convertDiacritics.get_conversion();
+        extractedText = std::move(convertDiacritics.get_conversion());
         }
     return std::make_pair(true, std::move(extractedText));
     }
 
+//------------------------------------------------
+bool BaseProject::DecodeUtf8Stream(std::string_view sourceFileText, std::wstring& buffer)
+    {
+    const auto bom = encoding::sniff_bom(sourceFileText);
+    if (bom != encoding::byte_order_mark::none && bom != encoding::byte_order_mark::utf8)
+        {
+        return false;
+        }
+    sourceFileText.remove_prefix(encoding::bom_length(bom));
+    // Embedded NULs are a sign of a BOM-less UTF-16 file, so let TextStream sort that out.
+    return (std::memchr(sourceFileText.data(), 0, sourceFileText.length()) == nullptr &&
+            encoding::utf8_to_wide(sourceFileText, buffer));
+    }
+
+//------------------------------------------------
+void BaseProject::DecodeTextStream(std::string_view sourceFileText, std::wstring& buffer)
+    {
+    // UTF-8 (or 7-bit ASCII) is validated and widened straight into the buffer in one pass,
+    // reusing its capacity; anything else goes through TextStream's encoding detection
+    if (!DecodeUtf8Stream(sourceFileText, buffer))
+        {
+        buffer = Wisteria::TextStream::CharStreamToUnicode(sourceFileText.data(),
+                                                           sourceFileText.length());
+        }
+    }
+
 //------------------------------------------------
 std::pair<bool, std::wstring> BaseProject::ExtractRawText(std::string_view sourceFileText,
                                                           const wxString& fileExtension)
     {
+    std::wstring extractedText;
+    const bool extracted = ExtractRawText(sourceFileText, fileExtension, extractedText);
+    return std::make_pair(extracted, std::move(extractedText));
+    }
+
+//------------------------------------------------
+bool BaseProject::ExtractRawText(std::string_view sourceFileText, const wxString& fileExtension,
+                                 std::wstring& buffer)
+    {
     PROFILE();
+    pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::extract,
+                                            "BaseProject::ExtractRawText");
+    if (stageTimer.is_active())
+        {
+        stageTimer.set_items(sourceFileText.length());
+        stageTimer.set_detail(GetOriginalDocumentFilePath().utf8_string());
+        }
     if (sourceFileText.empty())
         {
-        return std::make_pair(false, std::wstring{});
+        buffer.clear();
+        return false;
         }
     wxLogVerbose(L"%s parser being called.", fileExtension.Upper());
 
+    // the format-specific parsers produce their own strings, so move those into the buffer
+    const auto moveIntoBuffer = [&buffer](std::pair<bool, std::wstring>&& extractResult)
+    {
+        buffer = std::move(extractResult.second);
+        return extractResult.first;
+    };
+
     const WebPageExtension isHtmlExtension;
 
     if (fileExtension.CmpNoCase(L"rtf") == 0)
         {
-        return ExtractRtfRawText(sourceFileText);
+        return moveIntoBuffer(ExtractRtfRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"doc") == 0 || fileExtension.CmpNoCase(L"dot") == 0)
         {
-        return ExtractDocRawText(sourceFileText);
+        return moveIntoBuffer(ExtractDocRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"docx") == 0 || fileExtension.CmpNoCase(L"docm") == 0)
         {
-        return ExtractDocxRawText(sourceFileText);
+        return moveIntoBuffer(ExtractDocxRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"hhc") == 0 || fileExtension.CmpNoCase(L"hhk") == 0)
         {
-        return ExtractWorkshopRawText(sourceFileText);
+        return moveIntoBuffer(ExtractWorkshopRawText(sourceFileText));
         }
     else if (isHtmlExtension(fileExtension))
         {
-        return ExtractHtmlRawText(sourceFileText, isHtmlExtension, fileExtension);
+        return moveIntoBuffer(ExtractHtmlRawText(sourceFileText, isHtmlExtension, fileExtension));
         }
     else if (fileExtension.CmpNoCase(L"ps") == 0)
         {
-        return ExtractPostscriptRawText(sourceFileText);
+        return moveIntoBuffer(ExtractPostscriptRawText(sourceFileText));
         }
     // OpenDocument text or presentation files
     else if (fileExtension.CmpNoCase(L"odt") == 0 || fileExtension.CmpNoCase(L"ott") == 0 ||
              fileExtension.CmpNoCase(L"odp") == 0 || fileExtension.CmpNoCase(L"otp") == 0)
         {
-        return ExtractOpenDocumentRawText(sourceFileText);
+        return moveIntoBuffer(ExtractOpenDocumentRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"pptx") == 0 || fileExtension.CmpNoCase(L"pptm") == 0)
         {
-        return ExtractPowerPointRawText(sourceFileText);
+        return moveIntoBuffer(ExtractPowerPointRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"idl") == 0)
         {
-        return ExtractIdlRawText(sourceFileText);
+        return moveIntoBuffer(ExtractIdlRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"cpp") == 0 || fileExtension.CmpNoCase(L"c") == 0 ||
              fileExtension.CmpNoCase(L"h") == 0)
         {
-        return ExtractCppRawText(sourceFileText);
+        return moveIntoBuffer(ExtractCppRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"md") == 0 || fileExtension.CmpNoCase(L"rmd") == 0 ||
              fileExtension.CmpNoCase(L"qmd") == 0)
         {
-        return ExtractMarkdownRawText(sourceFileText);
+        return moveIntoBuffer(ExtractMarkdownRawText(sourceFileText));
         }
     else if (fileExtension.CmpNoCase(L"txt") == 0)
         {
         SetOriginalDocumentDescription(
             coalesce({ GetOriginalDocumentDescription(),
                        wxFileName(GetOriginalDocumentFilePath()).GetName() }));
-        std::wstring extractedText = Wisteria::TextStream::CharStreamToUnicode(
-            sourceFileText.data(), sourceFileText.length());
+        DecodeTextStream(sourceFileText, buffer);
         grammar::convert_ligatures_and_diacritics convertDiacritics;
-        if (convertDiacritics(extractedText))
+        if (convertDiacritics(buffer))
             {
-            extractedText = convertDiacritics.get_conversion();
+            buffer.swap(convertDiacritics.get_conversion());
             }
-        return std::make_pair(true, std::move(extractedText));
+        return true;
         }
     else if (fileExtension.CmpNoCase(L"pdf") == 0)
         {
         LogMessage(_(L"PDF files are not supported."), _(L"Import Error"),
                    wxOK | wxICON_EXCLAMATION);
-        return std::make_pair(false, std::wstring{});
+        buffer.clear();
+        return false;
         }
     // Unknown (or no) extension
     else
@@ -4294,33 +4461,24 @@ std::pair<bool, std::wstring> BaseProject::ExtractRawText(std::string_view sourc
         // See if it is HTML, given that a lot of web pages may not use a known file extension
         if (string_util::stristr(sourceFileText.data(), "<html"))
             {
-            std::pair<bool, std::wstring> extractResult(false, std::wstring{});
             wxString title;
             // if UTF-8 or simply 7-bit ASCII, then just convert as UTF-8 and
-            // run the HTML parser on it
-            if (utf8::is_valid(sourceFileText.data(),
-                               sourceFileText.data() + sourceFileText.length()))
+            // run the HTML parser on it; otherwise, need to search for the encoding
+            // in the HTML itself and convert using that
+            if (!DecodeUtf8Stream(sourceFileText, buffer))
                 {
-                extractResult =
-                    ExtractRawTextWithEncoding(Wisteria::TextStream::CharStreamToUnicode(
-                                                   sourceFileText.data(), sourceFileText.length()),
-                                               L"html", GetOriginalDocumentFilePath(), title);
-                }
-            // Otherwise, need to search for the encoding in the HTML itself and convert using that,
-            // then run the HTML parser on it
-            else
-                {
-                const std::wstring str = Wisteria::TextStream::CharStreamToUnicode(
+                buffer = Wisteria::TextStream::CharStreamToUnicode(
                     sourceFileText.data(), sourceFileText.length(),
                     WebHarvester::GetCharsetFromPageContent(
                         { sourceFileText.data(), sourceFileText.length() }));
-                extractResult =
-                    ExtractRawTextWithEncoding(str, L"html", GetOriginalDocumentFilePath(), title);
                 }
+            std::pair<bool, std::wstring> extractResult =
+                ExtractRawTextWithEncoding(buffer, L"html", GetOriginalDocumentFilePath(), title);
             SetOriginalDocumentDescription(
                 coalesce({ GetOriginalDocumentDescription(), title,
                            wxFileName(GetOriginalDocumentFilePath()).GetName() }));
-            return std::make_pair(true, std::move(extractResult.second));
+            buffer = std::move(extractResult.second);
+            return true;
             }
         // ...otherwise, just load it as regular text
         else
@@ -4328,8 +4486,8 @@ std::pair<bool, std::wstring> BaseProject::ExtractRawText(std::string_view sourc
             // This should be logged instead of shown to the user;
             // otherwise, they will see this warning every time they refresh.
             wxLogWarning(L"Unknown file extension. File will be imported as plain text.");
-            return std::make_pair(true, Wisteria::TextStream::CharStreamToUnicode(
-                                            sourceFileText.data(), sourceFileText.length()));
+            DecodeTextStream(sourceFileText, buffer);
+            return true;
             }
         }
     }
@@ -4410,7 +4568,9 @@ bool BaseProject::LoadExternalDocument()
 
             if (!wxFile::Exists(GetOriginalDocumentFilePath()))
                 {
-                if (wxMessageBox(wxString::Format(_(L"%s:\n\nDocument could not be located. "
+                // (there is no one to ask when running headless)
+                if (!wxGetApp().IsHeadless() &&
+                    wxMessageBox(wxString::Format(_(L"%s:\n\nDocument could not be located. "
                                                     "Do you wish to search for it?"),
                                                   GetOriginalDocumentFilePath()),
                                  _(L"Document Not Found"), wxYES_NO | wxICON_QUESTION) == wxYES)
@@ -4462,13 +4622,13 @@ bool BaseProject::LoadExternalDocument()
         // read in the text from the file
         try
             {
+            // the parsers read straight from the mapped file, and the text is
+            // extracted into the document's buffer (reusing its capacity)
             MemoryMappedFile sourceFile(GetOriginalDocumentFilePath(), true, true);
-            std::pair<bool, std::wstring> extractResult = ExtractRawText(
-                { static_cast<const char*>(sourceFile.GetStream()), sourceFile.GetMapSize() },
-                wxFileName(GetOriginalDocumentFilePath()).GetExt());
-            if (extractResult.first)
+            if (ExtractRawText(
+                    { static_cast<const char*>(sourceFile.GetStream()), sourceFile.GetMapSize() },
+                    wxFileName(GetOriginalDocumentFilePath()).GetExt(), GetDocumentText()))
                 {
-                SetDocumentText(std::move(extractResult.second));
                 try
                     {
                     LoadDocument();
@@ -4541,13 +4701,11 @@ bool BaseProject::LoadExternalDocument()
             LogMessage(zc.GetMessages().back().m_message, poundFn.GetFullPath(),
                        zc.GetMessages().back().m_icon);
             }
-        std::pair<bool, std::wstring> extractResult = ExtractRawText(
-            { static_cast<const char*>(memstream.GetOutputStreamBuffer()->GetBufferStart()),
-              static_cast<size_t>(memstream.GetLength()) },
-            wxFileName(GetOriginalDocumentFilePath()).GetExt());
-        if (extractResult.first)
+        if (ExtractRawText(
+                { static_cast<const char*>(memstream.GetOutputStreamBuffer()->GetBufferStart()),
+                  static_cast<size_t>(memstream.GetLength()) },
+                wxFileName(GetOriginalDocumentFilePath()).GetExt(), GetDocumentText()))
             {
-            SetDocumentText(std::move(extractResult.second));
             try
                 {
                 LoadDocument();
@@ -4657,7 +4815,11 @@ bool BaseProject::LoadDocumentAsSubProject(const wxString& path, const std::wstr
         }
     else
         {
-        SetDocumentText(text);
+        // the caller may have already put the text in this project's buffer
+        if (&text != &GetDocumentText())
+            {
+            SetDocumentText(text);
+            }
         if (text.empty())
             {
             SetLoadingOriginalTextSucceeded(false);
@@ -6294,6 +6456,13 @@ bool BaseProject::AddColemanLiauTest(const bool setFocus)
 bool BaseProject::AddStandardReadabilityTest(const wxString& id, const bool setFocus /*= true*/)
     {
     PROFILE();
+    pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::tests,
+                                            "BaseProject::AddStandardReadabilityTest");
+    if (stageTimer.is_active())
+        {
+        stageTimer.set_items(1);
+        stageTimer.set_detail(id.utf8_string());
+        }
     const auto theTest = GetReadabilityTests().get_test(id);
     if (!theTest.second)
         {
@@ -8551,7 +8720,8 @@ bool BaseProject::FindMissingFile(const wxString& filePath,
         auto warningIter =
             WarningManager::GetWarning(_DT(L"file-autosearch-from-project-directory"));
         // if they want to be prompted for this...
-        if (warningIter != WarningManager::GetWarnings().end() && warningIter->ShouldBeShown())
+        if (warningIter != WarningManager::GetWarnings().end() && warningIter->ShouldBeShown() &&
+            !wxGetApp().IsHeadless())
             {
             wxRichMessageDialog msg(
                 wxGetApp().GetParentingWindow(),
@@ -8647,6 +8817,7 @@ void BaseProject::CopySettings(const BaseProject& that)
         }
     m_varianceMethod = that.GetVarianceMethod();
     m_minDocWordCountForBatch = that.m_minDocWordCountForBatch;
+    m_nearDuplicateHandling = that.m_nearDuplicateHandling;
 
     // grammar
     m_spellcheck_ignore_proper_nouns = that.m_spellcheck_ignore_proper_nouns;
@@ -294,9 +294,33 @@ class BaseProject : public ProjectRefresh
         }
 
     void CopySettings(const BaseProject& that);
-    void FormatFilteredText(std::wstring& text, const bool romanizeText, const bool removeEllipses,
+    /** @brief Formats the document's text (only what was analyzed), for exporting.
+        @details If the document is still indexed (e.g., a standard project), then the text is
+            formatted straight from that; otherwise, the document is indexed again with this
+            project's settings.
+        @param[out] text The formatted text.
+        @returns @c false if the document could not be loaded.*/
+    bool FormatFilteredText(std::wstring& text, const bool romanizeText, const bool removeEllipses,
                             const bool removeBullets, const bool removeFilePaths,
                             const bool stripAbbreviations, const bool narrowFullWithText) const;
+    /** @brief Same as the above, but indexes the document (if it needs to be) in
+            @c indexingProject, which can be reused from document to document.
+        @details This is meant for exporting many documents on worker threads, where each
+            worker has its own (window-less) indexing project, created on the main thread.
+        @param indexingProject The project to index the document in. Its settings are
+            replaced with this project's, and its UI mode is turned off.
+        @warning This can only be called from a worker thread if
+            CanFormatFilteredTextConcurrently() is @c true.*/
+    bool FormatFilteredText(BaseProject& indexingProject, std::wstring& text,
+                            const bool romanizeText, const bool removeEllipses,
+                            const bool removeBullets, const bool removeFilePaths,
+                            const bool stripAbbreviations, const bool narrowFullWithText) const;
+    /** @returns @c true if the document can be formatted (and indexed again, if necessary)
+            without the main thread. That is the case if it is still indexed, its text is
+            embedded, or it is a local file that exists. (Webpages, archives, and missing files
+            may need to download or prompt the user.)*/
+    [[nodiscard]]
+    bool CanFormatFilteredTextConcurrently() const;
     /** @brief Loads a "thin" project where only the statistics, scores, and hard word lists are
        loaded.
         @param path The document's file path.
@@ -514,6 +538,30 @@ class BaseProject : public ProjectRefresh
             GetReadabilityTests().is_test_included(ReadabilityMessages::SMOG_BAMBERGER_VANECEK()));
         }
 
+    /** @returns The familiar-word lists (as test factors) that the included tests depend on.
+        @details LoadHardWords() only runs the unfamiliar-word passes (and populates
+            the word lists) for these.*/
+    [[nodiscard]]
+    readability::test_factor_set GetRequiredWordListFactors() const;
+
+    /// @returns The familiar-word lists (as test factors) that the last call to
+    ///     LoadHardWords() ran passes for.
+    [[nodiscard]]
+    const readability::test_factor_set& GetLoadedWordListFactors() const noexcept
+        {
+        return m_loadedWordListFactors;
+        }
+
+    /** @returns @c true if a test was included since the document was last indexed that
+            needs a familiar-word list pass which was skipped at that time.
+        @note The document needs to be reindexed in this case, as the word frequencies
+            that LoadHardWords() works from are not kept afterwards.*/
+    [[nodiscard]]
+    bool IsMissingWordListPasses() const
+        {
+        return (GetRequiredWordListFactors() & ~GetLoadedWordListFactors()).any();
+        }
+
     /// analysis options
     [[nodiscard]]
     LongSentence GetLongSentenceMethod() const noexcept
@@ -872,6 +920,25 @@ class BaseProject : public ProjectRefresh
         m_loadingOriginalTextSucceeded = succeeded;
         }
 
+    /// @brief Leaves a (successfully loaded) document out of its batch project's results,
+    ///     while keeping it in the project.
+    /// @details This is used for near duplicates of other documents in the batch.
+    void ExcludeFromResults(const bool exclude) noexcept { m_excludedFromResults = exclude; }
+
+    /// @returns @c true if the document is left out of its batch project's results.
+    [[nodiscard]]
+    bool IsExcludedFromResults() const noexcept
+        {
+        return m_excludedFromResults;
+        }
+
+    /// @returns @c true if the document was loaded and is not excluded from the results.
+    [[nodiscard]]
+    bool IsIncludedInResults() const noexcept
+        {
+        return m_loadingOriginalTextSucceeded && !m_excludedFromResults;
+        }
+
     /// @returns variance method
     [[nodiscard]]
     VarianceMethod GetVarianceMethod() const noexcept
@@ -893,6 +960,19 @@ class BaseProject : public ProjectRefresh
         return m_minDocWordCountForBatch;
         }
 
+    /// @brief Sets how a batch project handles documents that are nearly identical
+    ///     to another document in the project.
+    void SetNearDuplicateHandling(const NearDuplicateHandling handling) noexcept
+        {
+        m_nearDuplicateHandling = handling;
+        }
+
+    [[nodiscard]]
+    NearDuplicateHandling GetNearDuplicateHandling() const noexcept
+        {
+        return m_nearDuplicateHandling;
+        }
+
     [[nodiscard]]
     const double& GetTotalSyllables() const noexcept
         {
@@ -1364,6 +1444,22 @@ class BaseProject : public ProjectRefresh
         return m_hasUI;
         }
 
+    /** @brief Sets whether long documents (e.g., books) are split at paragraph breaks
+            and tokenized concurrently.
+        @details This is off by default, as it is only worth it for a project that
+            is loaded by itself. Projects that are already loaded alongside others
+            (e.g., a batch's documents or the scoring workers' projects) would only
+            compete with each other for the same cores.
+        @param parallel @c true to tokenize in parallel.*/
+    void TokenizeInParallel(const bool parallel) noexcept { m_tokenizeInParallel = parallel; }
+
+    /// @returns @c true if long documents are tokenized concurrently.
+    [[nodiscard]]
+    bool IsTokenizingInParallel() const noexcept
+        {
+        return m_tokenizeInParallel;
+        }
+
     /// @brief Logs a message to multiple outputs.
     /// @details If there is no UI attached to the project,
     ///     then queue a message to be handled by the caller later.
@@ -1534,6 +1630,15 @@ class BaseProject : public ProjectRefresh
     [[nodiscard]]
     std::pair<bool, std::wstring> ExtractRawText(std::string_view sourceFileText,
                                                  const wxString& fileExtension);
+    /** @brief Extracts raw/encoded text into a buffer.
+        @details Plain text is widened directly into @c buffer (reusing its capacity),
+            so callers loading many documents can pass the same buffer for each one.
+        @param sourceFileText The encoded text to filter (e.g., a view of a memory-mapped file).
+        @param fileExtension The file's extension.
+        @param[out] buffer The buffer to write the filtered text to.
+        @returns @c true on success, @c false otherwise.*/
+    bool ExtractRawText(std::string_view sourceFileText, const wxString& fileExtension,
+                        std::wstring& buffer);
 
     [[nodiscard]]
     const double& GetUnusedDolchConjunctions() const noexcept
@@ -2273,6 +2378,9 @@ class BaseProject : public ProjectRefresh
     static word_list known_custom_spanish_spellings;
     static word_list known_german_spellings;
     static word_list known_custom_german_spellings;
+    static spelling_verdict_cache english_spelling_verdicts;
+    static spelling_verdict_cache spanish_spelling_verdicts;
+    static spelling_verdict_cache german_spelling_verdicts;
     static word_list m_dale_chall_word_list;
     static word_list m_dale_chall_plus_stocker_catholic_word_list;
     static word_list m_stocker_catholic_word_list;
@@ -2301,7 +2409,21 @@ class BaseProject : public ProjectRefresh
         }
 
     void UpdateDocumentSettings();
-
+    /// @brief Formats an indexed document's valid text (see FormatFilteredText()).
+    void FormatFilteredWords(const std::shared_ptr<CaseInSensitiveNonStemmingDocument>& words,
+                             std::wstring& text, const bool romanizeText,
+                             const bool removeEllipses, const bool removeBullets,
+                             const bool removeFilePaths, const bool stripAbbreviations,
+                             const bool narrowFullWithText) const;
+
+    /// @brief Converts a UTF-8 (or 7-bit ASCII) stream into @c buffer, replacing its content
+    ///     but reusing its capacity.
+    /// @returns @c false if the stream isn't UTF-8, in which case @c buffer is unspecified.
+    [[nodiscard]]
+    static bool DecodeUtf8Stream(std::string_view sourceFileText, std::wstring& buffer);
+    /// @brief Converts a plain-text stream into @c buffer, replacing its content
+    ///     but reusing its capacity.
+    static void DecodeTextStream(std::string_view sourceFileText, std::wstring& buffer);
     [[nodiscard]]
     std::pair<bool, std::wstring> ExtractRtfRawText(std::string_view sourceFileText);
     [[nodiscard]]
@@ -2530,6 +2652,7 @@ class BaseProject : public ProjectRefresh
 
     // options
     double m_minDocWordCountForBatch{ 0 };
+    NearDuplicateHandling m_nearDuplicateHandling{ NearDuplicateHandling::Report };
     double m_includeIncompleteSentencesIfLongerThan{ 0 };
     int m_difficultSentenceLength{ 0 };
 
@@ -2565,6 +2688,7 @@ class BaseProject : public ProjectRefresh
 
     bool m_includeDolchSightWords{ false };
     bool m_hasUI{ true };
+    bool m_tokenizeInParallel{ false };
 
     // grammar options
     bool m_spellcheck_ignore_proper_nouns{ false };
@@ -2589,6 +2713,8 @@ class BaseProject : public ProjectRefresh
 
     // flag indicating that loading the original text failed or succeeded when opening the project
     bool m_loadingOriginalTextSucceeded{ true };
+    // a batch's near duplicates are left out of its results
+    bool m_excludedFromResults{ false };
     bool m_isRefreshing{ false };
     // test options
     bool m_fogUseSentenceUnits{ false };
@@ -2669,6 +2795,8 @@ class BaseProject : public ProjectRefresh
     ReadabilityMessages m_readMessages;
     TestCollectionType m_readabilityTests;
     std::vector<CustomReadabilityTestInterface> m_customTestsInUse;
+    // the familiar-word lists that LoadHardWords() last ran passes for
+    readability::test_factor_set m_loadedWordListFactors{ 0 };
 
     std::vector<WarningMessage> m_queuedMessages;
 
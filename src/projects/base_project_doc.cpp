@@ -15,6 +15,8 @@
 #include "../Wisteria-Dataviz/src/base/reportenumconvert.h"
 #include "../Wisteria-Dataviz/src/import/html_encode.h"
 #include "../app/readability_app.h"
+#include "settings_xml_index.h"
+#include <tuple>
 
 wxIMPLEMENT_DYNAMIC_CLASS(BaseProjectDoc, wxDocument)
 
@@ -26,6 +28,23 @@ using namespace Wisteria::Graphs;
 using namespace Wisteria::Colors;
 using namespace Wisteria::UI;
 
+namespace
+    {
+    /// @brief Shows a message box, or prints the message if running headless
+    ///     (where no one would be there to close it).
+    void ShowMessageBox(const wxString& message, const wxString& caption, const int style)
+        {
+        if (wxGetApp().IsHeadless())
+            {
+            wxMessageOutputStderr{}.Output(caption + L": " + message);
+            }
+        else
+            {
+            wxMessageBox(message, caption, style);
+            }
+        }
+    } // namespace
+
 wxString BaseProjectDoc::m_exportTextViewExt = L"htm";
 wxString BaseProjectDoc::m_exportListExt = L"htm";
 wxString BaseProjectDoc::m_exportGraphExt = L"png";
@@ -131,6 +150,45 @@ BaseProjectDoc::BaseProjectDoc()
     {
     }
 
+//------------------------------------------------
+bool BaseProjectDoc::IsSafeToUpdate() const
+    {
+    if (IsProcessing())
+        {
+        ShowMessageBox(_(L"Project still being reloaded. Please wait..."), GetTitle(),
+                       wxOK | wxICON_EXCLAMATION);
+        return false;
+        }
+    else
+        {
+        return true;
+        }
+    }
+
+//------------------------------------------------
+wxString BaseProjectDoc::GetWatchableFilePath(const wxString& documentPath)
+    {
+    FilePathResolver resolvePath(documentPath, false);
+    if (!resolvePath.IsLocalOrNetworkFile() && !resolvePath.IsArchivedFile() &&
+        !resolvePath.IsExcelCell())
+        {
+        return wxString{};
+        }
+    wxString filePath = resolvePath.GetResolvedPath();
+    // a file inside of an archive or spreadsheet changes when its container does
+    if (resolvePath.IsArchivedFile() || resolvePath.IsExcelCell())
+        {
+        const wxString containerExt =
+            resolvePath.IsArchivedFile() ? wxString{ _DT(L".zip#") } : wxString{ _DT(L".xlsx#") };
+        const size_t containerTag = filePath.Lower().find(containerExt);
+        if (containerTag != wxString::npos)
+            {
+            filePath.Truncate(containerTag + containerExt.length() - 1);
+            }
+        }
+    return wxFileName::FileExists(filePath) ? filePath : wxString{};
+    }
+
 //------------------------------------------------
 void BaseProjectDoc::CopyDocumentLevelSettings(const BaseProjectDoc& that, const bool reloadImages)
     {
@@ -716,7 +774,9 @@ void BaseProjectDoc::RemoveGlobalCustomReadabilityTest(const wxString& testName)
         const BaseProjectDoc* doc = dynamic_cast<BaseProjectDoc*>(docs.Item(i)->GetData());
         if (doc->HasCustomTest(testName))
             {
-            if (wxMessageBox(_(L"This test will need to be removed from any open projects "
+            // (a headless script asking for this has already decided)
+            if (!wxGetApp().IsHeadless() &&
+                wxMessageBox(_(L"This test will need to be removed from any open projects "
                                "that are currently including it.\n"
                                "Do you wish to proceed with removing this test?"),
                              _(L"Project Update"), wxYES_NO | wxICON_QUESTION) == wxNO)
@@ -804,6 +864,11 @@ bool BaseProjectDoc::AddGlobalCustomReadabilityTest(CustomReadabilityTest& custo
             if (std::find(m_custom_word_tests.begin(), m_custom_word_tests.end(), name) !=
                 m_custom_word_tests.end())
                 {
+                // there is no one to ask when running headless, so keep the existing test
+                if (wxGetApp().IsHeadless())
+                    {
+                    return true;
+                    }
                 wxMessageDialog msDlg(
                     wxGetApp().GetParentingWindow(),
                     wxString::Format(
@@ -841,7 +906,7 @@ bool BaseProjectDoc::AddGlobalCustomReadabilityTest(CustomReadabilityTest& custo
         if (!project.GetFormulaParser().compile(
                 wxString(customTest.get_formula().c_str()).ToStdString()))
             {
-            wxMessageBox(
+            ShowMessageBox(
                 wxString::Format(_(L"Error in formula, cannot add custom test \"%s\":\n\n"),
                                  customTest.get_name().c_str()),
                 _(L"Error in Formula"), wxOK | wxICON_EXCLAMATION);
@@ -850,21 +915,24 @@ bool BaseProjectDoc::AddGlobalCustomReadabilityTest(CustomReadabilityTest& custo
         }
     catch (const std::exception& exp)
         {
-        wxMessageBox(
+        ShowMessageBox(
             wxString::Format(_(L"%s\nPlease verify the syntax of the formula."), exp.what()),
             _(L"Error in Formula"), wxOK | wxICON_EXCLAMATION);
         return false;
         }
     catch (...)
         {
-        wxMessageBox(wxString::Format(_(L"An unknown error occurred while validating the formula. "
-                                        "Cannot add custom test \"%s\"."),
-                                      customTest.get_name().c_str()),
-                     _(L"Error in Formula"), wxOK | wxICON_EXCLAMATION);
+        ShowMessageBox(
+            wxString::Format(_(L"An unknown error occurred while validating the formula. "
+                               "Cannot add custom test \"%s\"."),
+                             customTest.get_name().c_str()),
+            _(L"Error in Formula"), wxOK | wxICON_EXCLAMATION);
         return false;
         }
 
-    wxBusyCursor wait;
+    const std::unique_ptr<wxBusyCursor> wait{ wxGetApp().IsHeadless() ?
+                                                  nullptr :
+                                                  std::make_unique<wxBusyCursor>() };
 
     // read in the word file--note that the file path might be changed by user,
     // so update the path in the test
@@ -876,7 +944,8 @@ bool BaseProjectDoc::AddGlobalCustomReadabilityTest(CustomReadabilityTest& custo
         {
         if (!Wisteria::TextStream::ReadFile(wordFilePath, fileText))
             {
-            wxMessageBox(_(L"Unable to load word list."), _(L"Error"), wxOK | wxICON_EXCLAMATION);
+            ShowMessageBox(_(L"Unable to load word list."), _(L"Error"),
+                           wxOK | wxICON_EXCLAMATION);
             return false;
             }
         }
@@ -887,7 +956,7 @@ bool BaseProjectDoc::AddGlobalCustomReadabilityTest(CustomReadabilityTest& custo
     m_custom_word_tests.push_back(customTest);
 
     MainFrame* mainFrame = dynamic_cast<MainFrame*>(wxGetApp().GetMainFrame());
-    assert(mainFrame);
+    assert(mainFrame || wxGetApp().IsHeadless());
     if (mainFrame)
         {
         mainFrame->AddCustomTestToMenus(customTest.get_name().c_str());
@@ -922,12 +991,12 @@ bool BaseProjectDoc::OnCloseDocument()
 //------------------------------------------------
 void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
     {
-    wxString currentStartTag;
-    wxString currentEndTag;
     const wchar_t* settingsFileTextEnd = settingsFileText + std::wcslen(settingsFileText);
+    // index the elements in one pass, rather than searching the text for each section
+    const SettingsXmlIndex settingsIndex(settingsFileText, settingsFileTextEnd);
 
     // first, get the project format version number
-    currentStartTag.clear();
+    wxString currentStartTag;
     currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_PROJECT_HEADER.data());
     const wchar_t* projectSection = std::wcsstr(settingsFileText, currentStartTag.wc_str());
     wxString docVersionNumber = L"1.0";
@@ -965,12 +1034,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // original text source (e.g., document file) information
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_DOCUMENT.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</").append(wxGetApp().GetAppOptions().XML_DOCUMENT.data()).append(L">");
-    const wchar_t* docParsingSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* docParsingSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [docParsingSection, docParsingSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_DOCUMENT);
     if (docParsingSection && docParsingSectionEnd && (docParsingSection < docParsingSectionEnd))
         {
         /* see if the text was from a file or manually entered
@@ -1022,6 +1087,17 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             {
             SetMinDocWordCountForBatch(1);
             }
+        // how near-duplicate documents are handled
+        const long nearDuplicateHandling = XmlFormat::GetLong(
+            docParsingSection, docParsingSectionEnd,
+            wxGetApp().GetAppOptions().XML_NEAR_DUPLICATE_HANDLING.data(),
+            static_cast<long>(wxGetApp().GetAppOptions().GetNearDuplicateHandling()));
+        SetNearDuplicateHandling(
+            (nearDuplicateHandling >= 0 &&
+             nearDuplicateHandling < static_cast<decltype(nearDuplicateHandling)>(
+                                         NearDuplicateHandling::NEAR_DUPLICATE_HANDLING_COUNT)) ?
+                static_cast<NearDuplicateHandling>(nearDuplicateHandling) :
+                wxGetApp().GetAppOptions().GetNearDuplicateHandling());
         // how file paths are shown in batch projects
         long truncMode = XmlFormat::GetLong(
             docParsingSection, docParsingSectionEnd,
@@ -1052,14 +1128,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // sentences breakdown
-    const wchar_t* sentencesBreakdownSection =
-        html_extract_text::find_element(settingsFileText, settingsFileTextEnd,
-                                        wxGetApp().GetAppOptions().XML_SENTENCES_BREAKDOWN_W, true);
-    const wchar_t* sentencesBreakdownSectionEnd =
-        sentencesBreakdownSection ? html_extract_text::find_closing_element(
-                                        sentencesBreakdownSection, settingsFileTextEnd,
-                                        wxGetApp().GetAppOptions().XML_SENTENCES_BREAKDOWN_W) :
-                                    nullptr;
+    const auto [sentencesBreakdownSection, sentencesBreakdownSectionEnd] =
+        settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_SENTENCES_BREAKDOWN_W);
     if (sentencesBreakdownSection && sentencesBreakdownSectionEnd)
         {
         const wxString wordsBreakdownInfo =
@@ -1072,14 +1142,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // words breakdown
-    const wchar_t* wordsBreakdownSection =
-        html_extract_text::find_element(settingsFileText, settingsFileTextEnd,
-                                        wxGetApp().GetAppOptions().XML_WORDS_BREAKDOWN_W, true);
-    const wchar_t* wordsBreakdownSectionSectionEnd =
-        wordsBreakdownSection ? html_extract_text::find_closing_element(
-                                    wordsBreakdownSection, settingsFileTextEnd,
-                                    wxGetApp().GetAppOptions().XML_WORDS_BREAKDOWN_W) :
-                                nullptr;
+    const auto [wordsBreakdownSection, wordsBreakdownSectionSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_WORDS_BREAKDOWN_W);
     if (wordsBreakdownSection && wordsBreakdownSectionSectionEnd)
         {
         const wxString wordsBreakdownInfo =
@@ -1092,12 +1156,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // grammar
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_GRAMMAR.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</").append(wxGetApp().GetAppOptions().XML_GRAMMAR.data()).append(L">");
-    const wchar_t* grammarSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* grammarSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [grammarSection, grammarSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_GRAMMAR);
     if (grammarSection && grammarSectionEnd && (grammarSection < grammarSectionEnd))
         {
         SpellCheckIgnoreProperNouns(XmlFormat::GetBoolean(
@@ -1137,15 +1197,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // read in the parsing and analysis logic
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(
-        wxGetApp().GetAppOptions().XML_DOCUMENT_ANALYSIS_LOGIC.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</")
-        .append(wxGetApp().GetAppOptions().XML_DOCUMENT_ANALYSIS_LOGIC.data())
-        .append(L">");
-    const wchar_t* parsingSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* parsingSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [parsingSection, parsingSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_DOCUMENT_ANALYSIS_LOGIC);
     if (parsingSection && parsingSectionEnd && (parsingSection < parsingSectionEnd))
         {
         // get the method for determining a long sentence
@@ -1196,31 +1249,20 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             XmlFormat::GetString(parsingSection, parsingSectionEnd,
                                  wxGetApp().GetAppOptions().XML_EXCLUDED_PHRASES_PATH.data()));
         LoadExcludePhrases();
-        const wchar_t* exclusionBlockTagSection = html_extract_text::find_element(
-            parsingSection, parsingSectionEnd, wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAGS_W,
-            true);
-        const wchar_t* exclusionBlockTagSectionEnd =
-            exclusionBlockTagSection ? html_extract_text::find_closing_element(
-                                           exclusionBlockTagSection, parsingSectionEnd,
-                                           wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAGS_W) :
-                                       nullptr;
+        const auto [exclusionBlockTagSection, exclusionBlockTagSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAGS_W,
+                                      parsingSection, parsingSectionEnd);
         if (exclusionBlockTagSection && exclusionBlockTagSectionEnd)
             {
             GetExclusionBlockTags().clear();
             const wchar_t* exclusionBlockTag = exclusionBlockTagSection;
             while (exclusionBlockTag)
                 {
-                exclusionBlockTag = html_extract_text::find_element(
-                    exclusionBlockTag, parsingSectionEnd,
-                    wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAG_W, true);
-                if (!exclusionBlockTag)
-                    {
-                    break;
-                    }
-                const wchar_t* exclusionBlockTagEnd = html_extract_text::find_closing_element(
-                    exclusionBlockTag, parsingSectionEnd,
-                    wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAG_W);
-                if (!exclusionBlockTagEnd)
+                const wchar_t* exclusionBlockTagEnd{ nullptr };
+                std::tie(exclusionBlockTag, exclusionBlockTagEnd) = settingsIndex.FindSection(
+                    wxGetApp().GetAppOptions().XML_EXCLUDE_BLOCK_TAG_W, exclusionBlockTag,
+                    exclusionBlockTagSectionEnd);
+                if (!exclusionBlockTag || !exclusionBlockTagEnd)
                     {
                     break;
                     }
@@ -1304,30 +1346,18 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         {
         LogMessage(wxString::Format(_(L"Warning: \"%s\" section not found in project file. "
                                       "Default configurations will be used."),
-                                    currentStartTag),
+                                    wxGetApp().GetAppOptions().XML_DOCUMENT_ANALYSIS_LOGIC.data()),
                    _(L"Error"), wxOK | wxICON_ERROR);
         }
 
     // read in the custom tests
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_CUSTOM_TESTS.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</")
-        .append(wxGetApp().GetAppOptions().XML_CUSTOM_TESTS.data())
-        .append(L">");
-    const wchar_t* customTestSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* customTestSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [customTestSection, customTestSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_CUSTOM_TESTS);
     if (customTestSection && customTestSectionEnd && (customTestSection < customTestSectionEnd))
         {
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(
-            wxGetApp().GetAppOptions().XML_CUSTOM_FAMILIAR_WORD_TEST.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_CUSTOM_FAMILIAR_WORD_TEST.data())
-            .append(L">");
-        const wchar_t* customFamiliarTestSection = std::wcsstr(customTestSection, currentStartTag);
-        const wchar_t* customFamiliarTestSectionEnd = std::wcsstr(customTestSection, currentEndTag);
+        auto [customFamiliarTestSection, customFamiliarTestSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_CUSTOM_FAMILIAR_WORD_TEST,
+                                      customTestSection, customTestSectionEnd);
         while (customFamiliarTestSection && customFamiliarTestSectionEnd)
             {
             wxString testName =
@@ -1504,24 +1534,15 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                 GetTestGoals().insert({ cTest.get_name(), minGoal, maxGoal });
                 }
             // go to next test
-            customFamiliarTestSection = std::wcsstr(++customFamiliarTestSection, currentStartTag);
-            if (!customFamiliarTestSection)
-                {
-                break;
-                }
-            customFamiliarTestSectionEnd = std::wcsstr(customFamiliarTestSection, currentEndTag);
+            std::tie(customFamiliarTestSection, customFamiliarTestSectionEnd) =
+                settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_CUSTOM_FAMILIAR_WORD_TEST,
+                                          customFamiliarTestSectionEnd, customTestSectionEnd);
             }
         }
 
     // read in the graph configurations
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_GRAPH_SETTINGS.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</")
-        .append(wxGetApp().GetAppOptions().XML_GRAPH_SETTINGS.data())
-        .append(L">");
-    const wchar_t* graphsSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* graphsSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [graphsSection, graphsSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_GRAPH_SETTINGS);
     if (graphsSection && graphsSectionEnd && (graphsSection < graphsSectionEnd))
         {
         // color scheme
@@ -1634,14 +1655,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         SetRaygorStyle(static_cast<Wisteria::Graphs::RaygorStyle>(raygorStyle));
 
         // Lix gauge
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_LIX_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_LIX_SETTINGS.data())
-            .append(L">");
-        const wchar_t* lixGaugeSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* lixGaugeSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [lixGaugeSection, lixGaugeSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_LIX_SETTINGS, graphsSection, graphsSectionEnd);
         if (lixGaugeSection && lixGaugeSectionEnd && (lixGaugeSection < lixGaugeSectionEnd))
             {
             UseEnglishLabelsForGermanLix(XmlFormat::GetBoolean(
@@ -1651,15 +1666,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // Flesch chart
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(
-            wxGetApp().GetAppOptions().XML_FLESCH_CHART_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_FLESCH_CHART_SETTINGS.data())
-            .append(L">");
-        const wchar_t* fleschChartSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* fleschChartSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [fleschChartSection, fleschChartSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_FLESCH_CHART_SETTINGS, graphsSection, graphsSectionEnd);
         if (fleschChartSection && fleschChartSectionEnd &&
             (fleschChartSection < fleschChartSectionEnd))
             {
@@ -1674,15 +1682,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // box plot settings
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(
-            wxGetApp().GetAppOptions().XML_BOX_PLOT_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_BOX_PLOT_SETTINGS.data())
-            .append(L">");
-        const wchar_t* boxPlotSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* boxPlotSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [boxPlotSection, boxPlotSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_BOX_PLOT_SETTINGS, graphsSection, graphsSectionEnd);
         if (boxPlotSection && boxPlotSectionEnd && (boxPlotSection < boxPlotSectionEnd))
             {
             SetGraphBoxColor(XmlFormat::GetColor(boxPlotSection, boxPlotSectionEnd,
@@ -1717,15 +1718,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // histogram settings
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(
-            wxGetApp().GetAppOptions().XML_HISTOGRAM_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_HISTOGRAM_SETTINGS.data())
-            .append(L">");
-        const wchar_t* histoSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* histoSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [histoSection, histoSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_HISTOGRAM_SETTINGS, graphsSection, graphsSectionEnd);
         if (histoSection && histoSectionEnd && (histoSection < histoSectionEnd))
             {
             long barEffect = XmlFormat::GetLong(
@@ -1798,15 +1792,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // bar chart settings
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(
-            wxGetApp().GetAppOptions().XML_BAR_CHART_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_BAR_CHART_SETTINGS.data())
-            .append(L">");
-        const wchar_t* barSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* barSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [barSection, barSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_BAR_CHART_SETTINGS, graphsSection, graphsSectionEnd);
         if (barSection && barSectionEnd && (barSection < barSectionEnd))
             {
             SetBarChartBarColor(XmlFormat::GetColor(
@@ -1842,25 +1829,13 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // axis settings
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_AXIS_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_AXIS_SETTINGS.data())
-            .append(L">");
-        const wchar_t* axisSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* axisSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [axisSection, axisSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_AXIS_SETTINGS, graphsSection, graphsSectionEnd);
         if (axisSection && axisSectionEnd && (axisSection < axisSectionEnd))
             {
             // x axis
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_X_AXIS.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_X_AXIS.data())
-                .append(L">");
-            const wchar_t* xAxisSection = std::wcsstr(axisSection, currentStartTag);
-            const wchar_t* xAxisSectionEnd = std::wcsstr(axisSection, currentEndTag);
+            const auto [xAxisSection, xAxisSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_X_AXIS, axisSection, axisSectionEnd);
             if (xAxisSection && xAxisSectionEnd && (xAxisSection < xAxisSectionEnd))
                 {
                 SetXAxisFontColor(XmlFormat::GetColor(
@@ -1871,14 +1846,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                                                 wxGetApp().GetAppOptions().GetXAxisFont()));
                 }
             // y axis
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_Y_AXIS.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_Y_AXIS.data())
-                .append(L">");
-            const wchar_t* yAxisSection = std::wcsstr(axisSection, currentStartTag);
-            const wchar_t* yAxisSectionEnd = std::wcsstr(axisSection, currentEndTag);
+            const auto [yAxisSection, yAxisSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_Y_AXIS, axisSection, axisSectionEnd);
             if (yAxisSection && yAxisSectionEnd && (yAxisSection < yAxisSectionEnd))
                 {
                 SetYAxisFontColor(XmlFormat::GetColor(
@@ -1891,25 +1860,13 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             }
 
         // title settings
-        currentStartTag.clear();
-        currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_TITLE_SETTINGS.data());
-        currentEndTag.clear();
-        currentEndTag.append(L"</")
-            .append(wxGetApp().GetAppOptions().XML_TITLE_SETTINGS.data())
-            .append(L">");
-        const wchar_t* titleSection = std::wcsstr(graphsSection, currentStartTag);
-        const wchar_t* titleSectionEnd = std::wcsstr(graphsSection, currentEndTag);
+        const auto [titleSection, titleSectionEnd] = settingsIndex.FindSection(
+            wxGetApp().GetAppOptions().XML_TITLE_SETTINGS, graphsSection, graphsSectionEnd);
         if (titleSection && titleSectionEnd && (titleSection < titleSectionEnd))
             {
             // top title
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_TOP_TITLE.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_TOP_TITLE.data())
-                .append(L">");
-            const wchar_t* topTitleSection = std::wcsstr(titleSection, currentStartTag);
-            const wchar_t* topTitleSectionEnd = std::wcsstr(titleSection, currentEndTag);
+            const auto [topTitleSection, topTitleSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_TOP_TITLE, titleSection, titleSectionEnd);
             if (topTitleSection && topTitleSectionEnd && (topTitleSection < topTitleSectionEnd))
                 {
                 SetGraphTopTitleFontColor(
@@ -1922,14 +1879,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                 }
 
             // bottom title
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_BOTTOM_TITLE.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_BOTTOM_TITLE.data())
-                .append(L">");
-            const wchar_t* bottomTitleSection = std::wcsstr(titleSection, currentStartTag);
-            const wchar_t* bottomTitleSectionEnd = std::wcsstr(titleSection, currentEndTag);
+            const auto [bottomTitleSection, bottomTitleSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_BOTTOM_TITLE, titleSection, titleSectionEnd);
             if (bottomTitleSection && bottomTitleSectionEnd &&
                 (bottomTitleSection < bottomTitleSectionEnd))
                 {
@@ -1944,14 +1895,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                 }
 
             // left title
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_LEFT_TITLE.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_LEFT_TITLE.data())
-                .append(L">");
-            const wchar_t* leftTitleSection = std::wcsstr(titleSection, currentStartTag);
-            const wchar_t* leftTitleSectionEnd = std::wcsstr(titleSection, currentEndTag);
+            const auto [leftTitleSection, leftTitleSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_LEFT_TITLE, titleSection, titleSectionEnd);
             if (leftTitleSection && leftTitleSectionEnd && (leftTitleSection < leftTitleSectionEnd))
                 {
                 SetGraphLeftTitleFontColor(
@@ -1965,14 +1910,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                 }
 
             // right title
-            currentStartTag.clear();
-            currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_RIGHT_TITLE.data());
-            currentEndTag.clear();
-            currentEndTag.append(L"</")
-                .append(wxGetApp().GetAppOptions().XML_RIGHT_TITLE.data())
-                .append(L">");
-            const wchar_t* rightTitleSection = std::wcsstr(titleSection, currentStartTag);
-            const wchar_t* rightTitleSectionEnd = std::wcsstr(titleSection, currentEndTag);
+            const auto [rightTitleSection, rightTitleSectionEnd] = settingsIndex.FindSection(
+                wxGetApp().GetAppOptions().XML_RIGHT_TITLE, titleSection, titleSectionEnd);
             if (rightTitleSection && rightTitleSectionEnd &&
                 (rightTitleSection < rightTitleSectionEnd))
                 {
@@ -1989,13 +1928,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // read stat goals
-    const wchar_t* statGoalsSection = html_extract_text::find_element(
-        settingsFileText, settingsFileTextEnd, wxGetApp().GetAppOptions().XML_STAT_GOALS_W, true);
-    const wchar_t* statGoalsSectionEnd =
-        statGoalsSection ?
-            html_extract_text::find_closing_element(statGoalsSection, settingsFileTextEnd,
-                                                    wxGetApp().GetAppOptions().XML_STAT_GOALS_W) :
-            nullptr;
+    const auto [statGoalsSection, statGoalsSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_STAT_GOALS_W);
     if (statGoalsSection && statGoalsSectionEnd)
         {
         for (const auto& statGoal : GetStatGoalLabels())
@@ -2016,14 +1950,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // read in the statistics configurations
-    const wchar_t* statsSection =
-        html_extract_text::find_element(settingsFileText, settingsFileTextEnd,
-                                        wxGetApp().GetAppOptions().XML_STATISTICS_SECTION_W, true);
-    const wchar_t* statsSectionEnd = statsSection ?
-                                         html_extract_text::find_closing_element(
-                                             statsSection, settingsFileTextEnd,
-                                             wxGetApp().GetAppOptions().XML_STATISTICS_SECTION_W) :
-                                         nullptr;
+    const auto [statsSection, statsSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_STATISTICS_SECTION_W);
     if (statsSection && statsSectionEnd)
         {
         SetVarianceMethod(static_cast<VarianceMethod>(XmlFormat::GetLong(
@@ -2045,14 +1973,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // read in the readability tests' configurations
-    const wchar_t* readabilityTestSection = html_extract_text::find_element(
-        settingsFileText, settingsFileTextEnd,
-        wxGetApp().GetAppOptions().XML_READABILITY_TESTS_SECTION_W, true);
-    const wchar_t* readabilityTestSectionEnd =
-        readabilityTestSection ? html_extract_text::find_closing_element(
-                                     readabilityTestSection, settingsFileTextEnd,
-                                     wxGetApp().GetAppOptions().XML_READABILITY_TESTS_SECTION_W) :
-                                 nullptr;
+    const auto [readabilityTestSection, readabilityTestSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_READABILITY_TESTS_SECTION_W);
     if (readabilityTestSection && readabilityTestSectionEnd)
         {
         // readability score results
@@ -2109,15 +2031,9 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
             wxGetApp().GetAppOptions().XML_DOLCH_SIGHT_WORDS_TEST.data(), false));
 
         // test-specific options
-        const wchar_t* fleschKincaidOptionsSection = html_extract_text::find_element(
-            readabilityTestSection, readabilityTestSectionEnd,
-            wxGetApp().GetAppOptions().XML_FLESCH_KINCAID_OPTIONS_W, true);
-        const wchar_t* fleschKincaidOptionsSectionEnd =
-            fleschKincaidOptionsSection ?
-                html_extract_text::find_closing_element(
-                    fleschKincaidOptionsSection, readabilityTestSectionEnd,
-                    wxGetApp().GetAppOptions().XML_FLESCH_KINCAID_OPTIONS_W) :
-                nullptr;
+        const auto [fleschKincaidOptionsSection, fleschKincaidOptionsSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_FLESCH_KINCAID_OPTIONS_W,
+                                      readabilityTestSection, readabilityTestSectionEnd);
         if (fleschKincaidOptionsSection && fleschKincaidOptionsSectionEnd)
             {
             SetFleschKincaidNumeralSyllabizeMethod(
@@ -2128,14 +2044,9 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                         wxGetApp().GetAppOptions().GetFleschKincaidNumeralSyllabizeMethod()))));
             }
 
-        const wchar_t* fleschOptionsSection =
-            html_extract_text::find_element(readabilityTestSection, readabilityTestSectionEnd,
-                                            wxGetApp().GetAppOptions().XML_FLESCH_OPTIONS_W, true);
-        const wchar_t* fleschOptionsSectionEnd =
-            fleschOptionsSection ? html_extract_text::find_closing_element(
-                                       fleschOptionsSection, readabilityTestSectionEnd,
-                                       wxGetApp().GetAppOptions().XML_FLESCH_OPTIONS_W) :
-                                   nullptr;
+        const auto [fleschOptionsSection, fleschOptionsSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_FLESCH_OPTIONS_W,
+                                      readabilityTestSection, readabilityTestSectionEnd);
         if (fleschOptionsSection && fleschOptionsSectionEnd)
             {
             SetFleschNumeralSyllabizeMethod(static_cast<FleschNumeralSyllabize>(XmlFormat::GetLong(
@@ -2144,14 +2055,9 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                 static_cast<int>(wxGetApp().GetAppOptions().GetFleschNumeralSyllabizeMethod()))));
             }
 
-        const wchar_t* fogOptionsSection = html_extract_text::find_element(
-            readabilityTestSection, readabilityTestSectionEnd,
-            wxGetApp().GetAppOptions().XML_GUNNING_FOG_OPTIONS_W, true);
-        const wchar_t* fogOptionsSectionEnd =
-            fogOptionsSection ? html_extract_text::find_closing_element(
-                                    fogOptionsSection, readabilityTestSectionEnd,
-                                    wxGetApp().GetAppOptions().XML_GUNNING_FOG_OPTIONS_W) :
-                                nullptr;
+        const auto [fogOptionsSection, fogOptionsSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_GUNNING_FOG_OPTIONS_W,
+                                      readabilityTestSection, readabilityTestSectionEnd);
         if (fogOptionsSection && fogOptionsSectionEnd)
             {
             FogUseSentenceUnits(
@@ -2160,14 +2066,9 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                                       wxGetApp().GetAppOptions().IsFogUsingSentenceUnits()));
             }
 
-        const wchar_t* hjOptionsSection = html_extract_text::find_element(
-            readabilityTestSection, readabilityTestSectionEnd,
-            wxGetApp().GetAppOptions().XML_HARRIS_JACOBSON_OPTIONS_W, true);
-        const wchar_t* hjOptionsSectionEnd =
-            hjOptionsSection ? html_extract_text::find_closing_element(
-                                   hjOptionsSection, readabilityTestSectionEnd,
-                                   wxGetApp().GetAppOptions().XML_HARRIS_JACOBSON_OPTIONS_W) :
-                               nullptr;
+        const auto [hjOptionsSection, hjOptionsSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_HARRIS_JACOBSON_OPTIONS_W,
+                                      readabilityTestSection, readabilityTestSectionEnd);
         if (hjOptionsSection && hjOptionsSectionEnd)
             {
             SetHarrisJacobsonTextExclusionMode(
@@ -2178,14 +2079,9 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
                         wxGetApp().GetAppOptions().GetHarrisJacobsonTextExclusionMode()))));
             }
 
-        const wchar_t* dcOptionsSection = html_extract_text::find_element(
-            readabilityTestSection, readabilityTestSectionEnd,
-            wxGetApp().GetAppOptions().XML_NEW_DALE_CHALL_OPTIONS_W, true);
-        const wchar_t* dcOptionsSectionEnd =
-            dcOptionsSection ? html_extract_text::find_closing_element(
-                                   dcOptionsSection, readabilityTestSectionEnd,
-                                   wxGetApp().GetAppOptions().XML_NEW_DALE_CHALL_OPTIONS_W) :
-                               nullptr;
+        const auto [dcOptionsSection, dcOptionsSectionEnd] =
+            settingsIndex.FindSection(wxGetApp().GetAppOptions().XML_NEW_DALE_CHALL_OPTIONS_W,
+                                      readabilityTestSection, readabilityTestSectionEnd);
         if (dcOptionsSection && dcOptionsSectionEnd)
             {
             IncludeStockerCatholicSupplement(XmlFormat::GetBoolean(
@@ -2214,14 +2110,8 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         }
 
     // read in the text view configurations
-    currentStartTag.clear();
-    currentStartTag.append(L"<").append(wxGetApp().GetAppOptions().XML_TEXT_VIEWS_SECTION.data());
-    currentEndTag.clear();
-    currentEndTag.append(L"</")
-        .append(wxGetApp().GetAppOptions().XML_TEXT_VIEWS_SECTION.data())
-        .append(L">");
-    const wchar_t* textViewsSection = std::wcsstr(settingsFileText, currentStartTag);
-    const wchar_t* textViewsSectionEnd = std::wcsstr(settingsFileText, currentEndTag);
+    const auto [textViewsSection, textViewsSectionEnd] = settingsIndex.FindSection(
+        wxGetApp().GetAppOptions().XML_TEXT_VIEWS_SECTION);
     if (textViewsSection && textViewsSectionEnd && (textViewsSection < textViewsSectionEnd))
         {
         m_textHighlight = static_cast<TextHighlight>(XmlFormat::GetLong(
@@ -2293,7 +2183,7 @@ void BaseProjectDoc::LoadSettingsFile(const wchar_t* settingsFileText)
         {
         LogMessage(wxString::Format(_(L"Warning: \"%s\" section not found in project file. "
                                       "No highlighted text views will be displayed."),
-                                    currentStartTag),
+                                    wxGetApp().GetAppOptions().XML_TEXT_VIEWS_SECTION.data()),
                    _(L"Error"), wxOK | wxICON_ERROR);
         }
 
@@ -2345,6 +2235,12 @@ wxString BaseProjectDoc::FormatProjectSettings() const
                              GetMinDocWordCountForBatch(), 2);
     fileText += sectionText;
 
+    // how near-duplicate documents are handled
+    XmlFormat::FormatSection(sectionText,
+                             wxGetApp().GetAppOptions().XML_NEAR_DUPLICATE_HANDLING.data(),
+                             static_cast<int>(GetNearDuplicateHandling()), 2);
+    fileText += sectionText;
+
     // how file paths are shown in batch projects
     XmlFormat::FormatSection(sectionText,
                              wxGetApp().GetAppOptions().XML_FILE_PATH_TRUNC_MODE.data(),
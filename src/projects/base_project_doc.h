@@ -65,6 +65,14 @@ class BaseProjectDoc : public BaseProject, public wxDocument
         return m_realTimeUpdate;
         }
 
+    /** @returns The file on disk to watch for changes to a (linked) document, or an empty
+            string if the document isn't a local file (e.g., a webpage).
+        @details For a file inside of an archive (or a path from a spreadsheet cell),
+            this will be the archive (or spreadsheet) itself.
+        @param documentPath The path of the document.*/
+    [[nodiscard]]
+    static wxString GetWatchableFilePath(const wxString& documentPath);
+
     // graph information
     //------------------------------
     void SetStippleImagePath(const wxString& filePath);
@@ -1111,19 +1119,7 @@ class BaseProjectDoc : public BaseProject, public wxDocument
     /// @brief Determines whether the project is safe to have its options or tests changed.
     /// @returns @c false if the project is being reloaded.
     [[nodiscard]]
-    bool IsSafeToUpdate() const
-        {
-        if (IsProcessing())
-            {
-            wxMessageBox(_(L"Project still being reloaded. Please wait..."), GetTitle(),
-                         wxOK | wxICON_EXCLAMATION);
-            return false;
-            }
-        else
-            {
-            return true;
-            }
-        }
+    bool IsSafeToUpdate() const;
 
     /// @returns The path part of the project file location.
     [[nodiscard]]
@@ -17,10 +17,20 @@
 #include "../Wisteria-Dataviz/src/util/string_util.h"
 #include "../app/readability_app.h"
 #include "../indexing/character_traits.h"
+#include "../indexing/near_duplicates.h"
 #include "../results-format/project_report_format.h"
 #include "../ui/dialogs/project_wizard_dlg.h"
 #include "batch_project_view.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
 
 using namespace Wisteria;
 using namespace Wisteria::Graphs;
@@ -35,6 +45,11 @@ wxIMPLEMENT_DYNAMIC_CLASS(BatchProjectDoc, wxDocument)
     void BatchProjectDoc::ShowQueuedMessages()
     {
     BaseProjectView* view = dynamic_cast<BaseProjectView*>(GetFirstView());
+    // without a view, these have already been logged
+    if (view == nullptr)
+        {
+        return;
+        }
     for (auto queuedMsgIter = GetQueuedMessages().cbegin();
          queuedMsgIter != GetQueuedMessages().cend(); ++queuedMsgIter)
         {
@@ -128,6 +143,10 @@ void BatchProjectDoc::RemoveMisspellings(const wxArrayString& misspellingsToRemo
             }
         }
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     Wisteria::UI::ListCtrlEx* listView = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
         view->GetGrammarView().FindWindowById(BaseProjectView::MISSPELLED_WORD_LIST_PAGE_ID));
     if (listView)
@@ -163,13 +182,22 @@ bool BatchProjectDoc::OnCreate(const wxString& path, long flags)
             {
             wxArrayString files;
                 {
-                wxWindowDisabler disableAll;
-                wxBusyInfo wait(wxBusyInfoFlags()
-                                    .Text(_(L"Retrieving files..."))
-                                    .Parent(wxGetApp().GetParentingWindow()));
+                const std::unique_ptr<wxWindowDisabler> disableAll{
+                    wxGetApp().IsHeadless() ? nullptr : std::make_unique<wxWindowDisabler>()
+                };
+                const std::unique_ptr<wxBusyInfo> wait{
+                    wxGetApp().IsHeadless() ?
+                        nullptr :
+                        std::make_unique<wxBusyInfo>(wxBusyInfoFlags()
+                                                         .Text(_(L"Retrieving files..."))
+                                                         .Parent(wxGetApp().GetParentingWindow()))
+                };
 #ifdef __WXGTK__
-                wxMilliSleep(100);
-                wxTheApp->Yield();
+                if (!wxGetApp().IsHeadless())
+                    {
+                    wxMilliSleep(100);
+                    wxTheApp->Yield();
+                    }
 #endif
                 wxDir::GetAllFiles(path, &files, wxString{}, wxDIR_FILES | wxDIR_DIRS);
                 files = FilterFiles(files, ExtractExtensionsFromFileFilter(
@@ -183,7 +211,7 @@ bool BatchProjectDoc::OnCreate(const wxString& path, long flags)
                 GetSourceFilesInfo().push_back(comparable_first_pair{ fl, wxString{} });
                 }
             ProjectWizardDlg::SetLastSelectedFolder(path);
-            return wxDocument::OnCreate(wxString{}, flags);
+            return CreateView(wxString{}, flags);
             }
         // if passed a single, "regular" file (i.e., not an archive or spreadsheet), then just load
         // it with the defaults and bypass the wizard.
@@ -195,20 +223,54 @@ bool BatchProjectDoc::OnCreate(const wxString& path, long flags)
 
             const wxArrayString folders = wxFileName(wxFileName(path).GetPathWithSep()).GetDirs();
             ProjectWizardDlg::SetLastSelectedFolder(folders.size() ? folders.back() : wxString{});
-            return wxDocument::OnCreate(wxString{}, flags);
+            return CreateView(wxString{}, flags);
             }
         // scripting framework passes this in to create an empty project
         // that can have files added later
         else if (path == L"EMPTY_PROJECT")
             {
-            return wxDocument::OnCreate(wxString{}, flags);
+            return CreateView(wxString{}, flags);
+            }
+        // the wizard is interactive, so it can't be used headless
+        else if (wxGetApp().IsHeadless())
+            {
+            LogMessage(wxString::Format(_(L"'%s': unable to create project."), path), _(L"Error"),
+                       wxOK | wxICON_EXCLAMATION);
+            return false;
             }
         else if (!RunProjectWizard(path))
             {
             return false;
             }
         }
-    return wxDocument::OnCreate(path, flags);
+    return CreateView(path, flags);
+    }
+
+//-------------------------------------------------------
+bool BatchProjectDoc::CreateView(const wxString& path, const long flags)
+    {
+    // when running headless, projects are only used for their results
+    // and don't have a window (or view) to display them in
+    return wxGetApp().IsHeadless() ? true : wxDocument::OnCreate(path, flags);
+    }
+
+//-------------------------------------------------------
+BatchProjectDoc::LoadingProgress::LoadingProgress(const wxString& title, const wxString& message,
+                                                  const int maximum, wxWindow* parent,
+                                                  const int style)
+    {
+    if (!wxGetApp().IsHeadless())
+        {
+        m_dialog = std::make_unique<wxProgressDialog>(title, message, maximum, parent, style);
+        m_dialog->Centre();
+        }
+    }
+
+//-------------------------------------------------------
+bool BatchProjectDoc::LoadingProgress::Update(const int value, const wxString& message)
+    {
+    m_value = value;
+    return (m_dialog != nullptr) ? m_dialog->Update(value, message) : true;
     }
 
 //-------------------------------------------------------
@@ -232,7 +294,8 @@ bool BatchProjectDoc::OnNewDocument()
     // load appended template file (if there is one)
     LoadAppendedDocument();
 
-    wxProgressDialog progressDlg(
+    // (only counted when running headless)
+    LoadingProgress progressDlg(
         _(L"Creating Project"),
         wxString::Format(
             _(L"Analyzing %s documents..."),
@@ -240,7 +303,6 @@ bool BatchProjectDoc::OnNewDocument()
                                         wxNumberFormatter::Style::Style_WithThousandsSep)),
         static_cast<int>(GetSourceFilesInfo().size() + 13), nullptr,
         wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_CAN_ABORT | wxPD_APP_MODAL);
-    progressDlg.Centre();
     int counter{ 1 };
 
     InitializeDocuments();
@@ -339,20 +401,24 @@ bool BatchProjectDoc::OnNewDocument()
         }
     DisplayWarnings();
 
+    // (projects created by headless scripts don't have a view)
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
-    view->UpdateSideBarIcons();
-    view->UpdateRibbonState();
-    view->Present();
-    UpdateAllViews();
+    if (view != nullptr)
+        {
+        view->UpdateSideBarIcons();
+        view->UpdateRibbonState();
+        view->Present();
+        UpdateAllViews();
 
-    view->GetSideBar()->SelectSubItem(
-        view->GetSideBar()->FindSubItem(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
+        view->GetSideBar()->SelectSubItem(
+            view->GetSideBar()->FindSubItem(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
 
-    auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
-        view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
-    if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
-        {
-        scoresWindow->Select(0);
+        auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
+            view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
+        if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
+            {
+            scoresWindow->Select(0);
+            }
         }
 
     // try to base the default name of this project from the folder/web domain of the first file
@@ -394,6 +460,7 @@ bool BatchProjectDoc::OnNewDocument()
             }
         }
 
+    RestartRealtimeUpdate();
     Modify(true);
 
     return true;
@@ -419,6 +486,8 @@ void BatchProjectDoc::InitializeDocuments()
         m_docs[i]->SetAppendedDocumentText(GetAppendedDocumentText());
         m_docs[i]->ShareExcludePhrases(*this);
         m_docs[i]->SetUIMode(false);
+        // (the documents are already loaded concurrently)
+        m_docs[i]->TokenizeInParallel(false);
         m_docs[i]->GetSourceFilesInfo().clear();
         m_docs[i]->GetSourceFilesInfo().push_back(GetSourceFilesInfo().at(i));
         }
@@ -431,7 +500,7 @@ void BatchProjectDoc::LoadGroupingLabelsFromDocumentsInfo()
     m_groupStringTable.clear();
     for (const auto doc : m_docs)
         {
-        if (doc->LoadingOriginalTextSucceeded())
+        if (doc->IsIncludedInResults())
             {
             auto [item, inserted] =
                 m_docLabels.try_emplace(doc->GetOriginalDocumentDescription().wc_str(), 0);
@@ -467,6 +536,22 @@ bool BatchProjectDoc::CheckForFailedDocuments()
             }
         }
 
+    // no one to ask when running unattended, so log and remove them
+    if (wxGetApp().IsHeadless())
+        {
+        if (failedDocs.empty())
+            {
+            return false;
+            }
+        for (const auto& failedDoc : failedDocs)
+            {
+            wxLogWarning(L"'%s': document could not be loaded and was removed from the project.",
+                         failedDoc);
+            }
+        RemoveFailedDocuments();
+        return true;
+        }
+
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
     wxASSERT_MSG(view->GetFrame(), L"Invalid frame for newly created document!");
     // show the names of the failed documents somehow so the user can review it before removing them
@@ -528,6 +613,15 @@ void BatchProjectDoc::RefreshStatisticsReports()
         }
 
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    // a window-less project (from a headless script) only needs its statistics reloaded
+    if (view == nullptr)
+        {
+        BaseProjectProcessingLock processingLock(this);
+        LoadSummaryStatsSection();
+        Modify(true);
+        ResetRefreshRequired();
+        return;
+        }
     const wxString currentlySelectedFile = view->GetCurrentlySelectedFileName();
     const auto selectedItem = view->GetSideBar()->GetSelectedFolderId();
 
@@ -570,6 +664,13 @@ void BatchProjectDoc::RefreshGraphs()
         {
         return;
         }
+
+    if (GetFirstView() == nullptr)
+        {
+        ResetRefreshRequired();
+        return;
+        }
+
     BaseProjectProcessingLock processingLock(this);
     wxWindowUpdateLocker noUpdates(GetDocumentWindow());
 
@@ -589,15 +690,46 @@ void BatchProjectDoc::RefreshProject()
         {
         return;
         }
-    wxBusyCursor wait;
+    const std::unique_ptr<wxBusyCursor> wait{ wxGetApp().IsHeadless() ?
+                                                  nullptr :
+                                                  std::make_unique<wxBusyCursor>() };
 
     // if refresh is not necessary then return
     if (IsRefreshRequired() == false)
         {
         return;
         }
+
+    // Refreshing for anything else (e.g., new settings) reloads every document,
+    // which takes care of any changed documents still queued.
+    if (!m_reloadingChangedDocuments)
+        {
+        m_changedDocuments.clear();
+        }
+
+    // a newly included test may need a familiar-word list that was skipped
+    // when the documents were last indexed (all of them are reloaded then,
+    // not just the ones whose files changed)
+    const auto requiredWordListFactors = GetRequiredWordListFactors();
+    for (const auto* doc : m_docs)
+        {
+        if (doc->LoadingOriginalTextSucceeded() &&
+            RefreshRequiredForMissingPasses(requiredWordListFactors,
+                                            doc->GetLoadedWordListFactors()))
+            {
+            m_changedDocuments.clear();
+            break;
+            }
+        }
+
+    // headless scripts create projects without a view, so only the results get recalculated
+    BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+
     BaseProjectProcessingLock processingLock(this);
-    wxWindowUpdateLocker noUpdates(GetDocumentWindow());
+    const std::unique_ptr<wxWindowUpdateLocker> noUpdates{
+        (view != nullptr) ? std::make_unique<wxWindowUpdateLocker>(GetDocumentWindow()) : nullptr
+    };
+    StopRealtimeUpdate();
 
     // reload the excluded phrases
     LoadExcludePhrases();
@@ -605,17 +737,18 @@ void BatchProjectDoc::RefreshProject()
     // load appended template file (if there is one)
     LoadAppendedDocument();
 
-    BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
-    wxProgressDialog progressDlg(
+    LoadingProgress progressDlg(
         wxString::Format(_(L"Reloading \"%s\""), GetTitle()), _(L"Analyzing documents..."),
         IsDocumentReindexingRequired() ? static_cast<int>(GetSourceFilesInfo().size() + 13) : 13,
-        view->GetFrame(), wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_APP_MODAL);
-    progressDlg.Centre();
+        (view != nullptr) ? view->GetFrame() : nullptr,
+        wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_APP_MODAL);
     int counter{ 1 };
 
     progressDlg.Update(counter++);
 
-    if (IsDocumentReindexingRequired() && GetDocumentStorageMethod() == TextStorage::NoEmbedText)
+    // (if only some linked documents changed, then keep the others and just reload those)
+    if (IsDocumentReindexingRequired() && GetDocumentStorageMethod() == TextStorage::NoEmbedText &&
+        m_changedDocuments.empty())
         {
         InitializeDocuments();
         }
@@ -630,6 +763,7 @@ void BatchProjectDoc::RefreshProject()
         m_docs[i]->SetAppendedDocumentText(GetAppendedDocumentText());
         m_docs[i]->ShareExcludePhrases(*this);
         m_docs[i]->SetUIMode(false);
+        m_docs[i]->TokenizeInParallel(false);
         }
     if (IsDocumentReindexingRequired())
         {
@@ -647,7 +781,8 @@ void BatchProjectDoc::RefreshProject()
         }
 
     // get this before list controls are recreated
-    const wxString currentlySelectedFile = view->GetCurrentlySelectedFileName();
+    const wxString currentlySelectedFile =
+        (view != nullptr) ? view->GetCurrentlySelectedFileName() : wxString{};
 
     progressDlg.Update(counter++, _(L"Loading Dolch statistics..."));
     LoadDolchSection();
@@ -688,37 +823,132 @@ void BatchProjectDoc::RefreshProject()
     progressDlg.Update(counter++);
     DisplayWarnings();
 
-    const auto selectedItem = view->GetSideBar()->GetSelectedSubItemId();
-    const auto selectedFolder = view->GetSideBar()->GetSelectedFolderId();
-    view->UpdateSideBarIcons();
-    view->UpdateRibbonState();
-    view->Present();
-    UpdateAllViews();
+    if (view != nullptr)
+        {
+        const auto selectedItem = view->GetSideBar()->GetSelectedSubItemId();
+        const auto selectedFolder = view->GetSideBar()->GetSelectedFolderId();
+        view->UpdateSideBarIcons();
+        view->UpdateRibbonState();
+        view->Present();
+        UpdateAllViews();
+
+        if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+            {
+            // fall back to folder that may not have subitems (e.g., the Warning section),
+            // and then the score section if the folder isn't there anymore.
+            if (!view->GetSideBar()->SelectFolder(selectedFolder.value_or(0), true, true))
+                {
+                view->GetSideBar()->SelectFolder(0, true, true);
+                }
+            }
+        view->ShowSideBar(view->IsSideBarShown());
+        auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
+            view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
+        if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
+            {
+            scoresWindow->Select(0);
+            }
 
-    if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+        view->UpdateStatAndTestPanes(currentlySelectedFile);
+        }
+
+    Modify(true);
+
+    if (view != nullptr)
         {
-        // fall back to folder that may not have subitems (e.g., the Warning section),
-        // and then the score section if the folder isn't there anymore.
-        if (!view->GetSideBar()->SelectFolder(selectedFolder.value_or(0), true, true))
+        GetDocumentWindow()->Refresh();
+        }
+
+    ResetRefreshRequired();
+    RestartRealtimeUpdate();
+    }
+
+//------------------------------------------------
+void BatchProjectDoc::StopRealtimeUpdate() { wxGetApp().GetSourceFileWatcher().Unwatch(this); }
+
+//------------------------------------------------
+void BatchProjectDoc::RestartRealtimeUpdate()
+    {
+    if (!IsRealTimeUpdating() || GetDocumentStorageMethod() != TextStorage::NoEmbedText)
+        {
+        StopRealtimeUpdate();
+        return;
+        }
+
+    // documents inside of the same archive (or spreadsheet) share a file to watch
+    std::set<wxString> sourceFiles;
+    for (const auto* doc : m_docs)
+        {
+        const wxString sourceFile = GetWatchableFilePath(doc->GetOriginalDocumentFilePath());
+        if (!sourceFile.empty())
             {
-            view->GetSideBar()->SelectFolder(0, true, true);
+            sourceFiles.insert(sourceFile);
             }
         }
-    view->ShowSideBar(view->IsSideBarShown());
-    auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
-        view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
-    if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
+    wxArrayString watchedFiles;
+    watchedFiles.reserve(sourceFiles.size());
+    for (const auto& sourceFile : sourceFiles)
         {
-        scoresWindow->Select(0);
+        watchedFiles.push_back(sourceFile);
         }
+    wxGetApp().GetSourceFileWatcher().Watch(this, watchedFiles,
+                                            [this](const wxArrayString& changedFiles)
+                                            { OnSourceFilesChanged(changedFiles); });
+    }
 
-    view->UpdateStatAndTestPanes(currentlySelectedFile);
+//------------------------------------------------
+void BatchProjectDoc::OnSourceFilesChanged(const wxArrayString& changedFiles)
+    {
+    if (!IsRealTimeUpdating() || GetDocumentStorageMethod() != TextStorage::NoEmbedText)
+        {
+        return;
+        }
 
-    Modify(true);
+    // queue the documents from the changed files, even if the project is busy right now
+    // (their files won't be reported again, so they can't be dropped)
+    const std::set<wxString> changedSourceFiles(changedFiles.begin(), changedFiles.end());
+    for (const auto* doc : m_docs)
+        {
+        if (changedSourceFiles.find(GetWatchableFilePath(doc->GetOriginalDocumentFilePath())) !=
+            changedSourceFiles.cend())
+            {
+            m_changedDocuments.insert(doc->GetOriginalDocumentFilePath());
+            }
+        }
+    ReloadChangedDocuments();
+    }
 
-    GetDocumentWindow()->Refresh();
+//------------------------------------------------
+void BatchProjectDoc::ReloadChangedDocuments()
+    {
+    if (m_changedDocuments.empty() || !IsRealTimeUpdating() ||
+        GetDocumentStorageMethod() != TextStorage::NoEmbedText)
+        {
+        m_changedDocuments.clear();
+        return;
+        }
 
-    ResetRefreshRequired();
+    // still reloading (or exporting, etc.), so try again after it is done
+    // (rather than interrupting the user with a message about it)
+    if (IsProcessing())
+        {
+        m_changedDocumentsTimer.StartOnce(SourceFileWatcher::DEBOUNCE_INTERVAL);
+        return;
+        }
+
+    // If the project is already waiting on a refresh (e.g., its settings were changed),
+    // then every document needs to be reloaded anyway. Otherwise, only the changed
+    // documents are reloaded and the others reuse their indexed data.
+    if (IsRefreshRequired())
+        {
+        m_changedDocuments.clear();
+        }
+
+    RefreshRequired(ProjectRefresh::FullReindexing);
+    m_reloadingChangedDocuments = true;
+    RefreshProject();
+    m_reloadingChangedDocuments = false;
+    m_changedDocuments.clear();
     }
 
 //------------------------------------------------------------
@@ -739,7 +969,7 @@ void BatchProjectDoc::LoadDolchSection()
     for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
         {
         // dolch words
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             // completion stats
             m_dolchCompletionData->SetItemText(dolchDocumentCount, 0,
@@ -963,12 +1193,12 @@ void BatchProjectDoc::LoadHardWordsSection()
         {
         extraColumnCount += IsSmogLikeTestIncluded() ? 2 : 0;
         extraColumnCount +=
-            GetReadabilityTests().is_test_included(ReadabilityMessages::GUNNING_FOG()) ? 2 : 0;
+            GetReadabilityTests().is_test_included(readability::test_key::gunning_fog) ? 2 : 0;
         extraColumnCount += IsDaleChallLikeTestIncluded() ? 2 : 0;
         extraColumnCount +=
-            GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()) ? 2 : 0;
+            GetReadabilityTests().is_test_included(readability::test_key::spache) ? 2 : 0;
         extraColumnCount +=
-            GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()) ? 2 : 0;
+            GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson) ? 2 : 0;
         extraColumnCount += GetCustTestsInUse().size() * 2;
         }
     // doc name, description, overall words, complex words and %, long words and % = 7
@@ -980,7 +1210,7 @@ void BatchProjectDoc::LoadHardWordsSection()
         {
         // hard word statistics (note the ordering here must match the column ordering in
         // DisplayHardWords())
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             size_t columnIndex = 0;
             m_hardWordsData->SetItemText(hardWordRowCount, columnIndex++,
@@ -1030,7 +1260,7 @@ void BatchProjectDoc::LoadHardWordsSection()
                                          true));
                     }
                 // hard FOG words
-                if (GetReadabilityTests().is_test_included(ReadabilityMessages::GUNNING_FOG()))
+                if (GetReadabilityTests().is_test_included(readability::test_key::gunning_fog))
                     {
                     m_hardWordsData->SetItemValue(
                         hardWordRowCount, columnIndex++,
@@ -1076,7 +1306,7 @@ void BatchProjectDoc::LoadHardWordsSection()
                                          true));
                     }
                 // hard spache words
-                if (GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+                if (GetReadabilityTests().is_test_included(readability::test_key::spache))
                     {
                     m_hardWordsData->SetItemValue(
                         hardWordRowCount, columnIndex++,
@@ -1091,7 +1321,7 @@ void BatchProjectDoc::LoadHardWordsSection()
                                          true));
                     }
                 // hard HJ words
-                if (GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+                if (GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
                     {
                     m_hardWordsData->SetItemValue(
                         hardWordRowCount, columnIndex++,
@@ -1225,18 +1455,18 @@ void BatchProjectDoc::LoadSummaryStatsSection()
             m_summaryStatsColumnNames.push_back(_(L"Number of Dale-Chall unfamiliar words"));
             m_summaryStatsColumnNames.push_back(_(L"Number of unique Dale-Chall unfamiliar words"));
             }
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
             {
             m_summaryStatsColumnNames.push_back(_(L"Number of Harris-Jacobson unfamiliar words"));
             m_summaryStatsColumnNames.push_back(
                 _(L"Number of unique Harris-Jacobson unfamiliar words"));
             }
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::spache))
             {
             m_summaryStatsColumnNames.push_back(_(L"Number of Spache unfamiliar words"));
             m_summaryStatsColumnNames.push_back(_(L"Number of unique Spache unfamiliar words"));
             }
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::EFLAW()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::eflaw))
             {
             m_summaryStatsColumnNames.push_back(_(L"Number of McAlpine EFLAW miniwords"));
             m_summaryStatsColumnNames.push_back(
@@ -1276,6 +1506,10 @@ void BatchProjectDoc::LoadSummaryStatsSection()
     size_t rowCount{ 0 };
     for (const auto& doc : m_docs)
         {
+        if (doc->IsExcludedFromResults())
+            {
+            continue;
+            }
         size_t columnCount{ 0 };
         m_summaryStatsData->SetItemText(rowCount, columnCount++,
                                         doc->GetOriginalDocumentFilePath());
@@ -1509,7 +1743,7 @@ void BatchProjectDoc::LoadSummaryStatsSection()
                 m_summaryStatsData->SetItemValue(rowCount, columnCount++,
                                                  doc->GetTotalUniqueDCHardWords());
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
                 {
                 assert(m_summaryStatsColumnNames[columnCount] ==
                        _(L"Number of Harris-Jacobson unfamiliar words"));
@@ -1520,7 +1754,7 @@ void BatchProjectDoc::LoadSummaryStatsSection()
                 m_summaryStatsData->SetItemValue(rowCount, columnCount++,
                                                  doc->GetTotalUniqueHarrisJacobsonHardWords());
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::spache))
                 {
                 assert(m_summaryStatsColumnNames[columnCount] ==
                        _(L"Number of Spache unfamiliar words"));
@@ -1531,7 +1765,7 @@ void BatchProjectDoc::LoadSummaryStatsSection()
                 m_summaryStatsData->SetItemValue(rowCount, columnCount++,
                                                  doc->GetTotalUniqueHardWordsSpache());
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::EFLAW()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::eflaw))
                 {
                 assert(m_summaryStatsColumnNames[columnCount] ==
                        _(L"Number of McAlpine EFLAW miniwords"));
@@ -1647,288 +1881,356 @@ void BatchProjectDoc::LoadWarningsSection()
     }
 
 //------------------------------------------------------------
-bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
+void BatchProjectDoc::LoadDocument(BaseProject* doc,
+                                   std::map<wxString, Wisteria::ZipCatalog*>& archiveFiles,
+                                   std::map<wxString, ExcelFile*>& excelFiles,
+                                   std::wstring& documentTextBuffer)
     {
-    GetRepeatedWordData()->DeleteAllItems();
-    GetRepeatedWordData()->SetSize(m_docs.size(), 4);
-    m_incorrectArticleData->DeleteAllItems();
-    m_incorrectArticleData->SetSize(m_docs.size(), 4);
-    m_overusedWordBySentenceData->DeleteAllItems();
-    m_overusedWordBySentenceData->SetSize(m_docs.size(), 4);
-    m_passiveVoiceData->DeleteAllItems();
-    m_passiveVoiceData->SetSize(m_docs.size(), 4);
-    GetMisspelledWordData()->DeleteAllItems();
-    GetMisspelledWordData()->SetSize(m_docs.size(), 5);
-    m_overlyLongSentenceData->DeleteAllItems();
-    m_overlyLongSentenceData->SetSize(m_docs.size(), 5);
-    m_sentenceStartingWithConjunctionsData->DeleteAllItems();
-    m_sentenceStartingWithConjunctionsData->SetSize(m_docs.size(), 4);
-    m_sentenceStartingWithLowercaseData->DeleteAllItems();
-    m_sentenceStartingWithLowercaseData->SetSize(m_docs.size(), 4);
-    m_wordyPhraseData->DeleteAllItems();
-    m_wordyPhraseData->SetSize(m_docs.size(), 5);
-    m_redundantPhraseData->DeleteAllItems();
-    m_redundantPhraseData->SetSize(m_docs.size(), 5);
-    m_wordingErrorData->DeleteAllItems();
-    m_wordingErrorData->SetSize(m_docs.size(), 5);
-    m_clichePhraseData->DeleteAllItems();
-    m_clichePhraseData->SetSize(m_docs.size(), 5);
-
-    size_t dupWordCount = 0;
-    size_t incorrectArticleCount = 0;
-    size_t overusedWordBySentenceCount = 0;
-    size_t passiveVoiceCount = 0;
-    size_t misspelledWordCount = 0;
-    size_t longSenteceCount = 0;
-    size_t conjunctionSentencesCount = 0;
-    size_t lowercaseSentencesCount = 0;
-    size_t wordyPhraseCount = 0;
-    size_t redundantPhraseCount = 0;
-    size_t wordingErrorCount = 0;
-    size_t clicheCount = 0;
-
-    int counter{ progressDlg.GetValue() };
-
-    double_frequency_set<word_case_insensitive_no_stem> wordsFromAllDocs;
-
-    std::map<wxString, Wisteria::ZipCatalog*> archiveFiles;
-    std::map<wxString, ExcelFile*> excelFiles;
-    for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
+    // clear the document's text just in case the user switched from embedding to linking.
+    // If the user switched from linking to embedded then note that the documents will need
+    // to be externally loaded here to reacquire the text.
+    if (GetDocumentStorageMethod() == TextStorage::NoEmbedText)
         {
-        // clear the document's text just in case the user switched from embedding to linking.
-        // If the user switched from linking to embedded then note that the documents will need
-        // to be externally loaded here to reacquire the text.
-        if (GetDocumentStorageMethod() == TextStorage::NoEmbedText)
-            {
-            (*pos)->FreeDocumentText();
-            }
-        // pre-2007 Microsoft Word files (*.doc) are difficult to detect lists in, so if we are
-        // not explicitly specifying "fitted to the page" analysis for this project (above),
-        // then override the global option and set it to treat all newlines as the
-        // end of a paragraph.
-        if (m_adjustParagraphParserForDocFiles &&
-            wxFileName((*pos)->GetOriginalDocumentFilePath()).GetExt().CmpNoCase(_DT(L"doc")) == 0)
-            {
-            (*pos)->SetParagraphsParsingMethod(ParagraphParse::EachNewLineIsAParagraph);
-            }
+        doc->FreeDocumentText();
+        }
+    // pre-2007 Microsoft Word files (*.doc) are difficult to detect lists in, so if we are
+    // not explicitly specifying "fitted to the page" analysis for this project (above),
+    // then override the global option and set it to treat all newlines as the
+    // end of a paragraph.
+    if (m_adjustParagraphParserForDocFiles &&
+        wxFileName(doc->GetOriginalDocumentFilePath()).GetExt().CmpNoCase(_DT(L"doc")) == 0)
+        {
+        doc->SetParagraphsParsingMethod(ParagraphParse::EachNewLineIsAParagraph);
+        }
 
-        FilePathResolver fileResolve((*pos)->GetOriginalDocumentFilePath(), false);
-        if (fileResolve.IsExcelCell())
+    FilePathResolver fileResolve(doc->GetOriginalDocumentFilePath(), false);
+    if (fileResolve.IsExcelCell())
+        {
+        FilePathResolver fileResolver;
+        size_t excelTag = doc->GetOriginalDocumentFilePath().Lower().find(_DT(L".xlsx#"));
+        assert(excelTag != std::wstring::npos);
+        if (excelTag != std::wstring::npos)
             {
-            FilePathResolver fileResolver;
-            size_t excelTag = (*pos)->GetOriginalDocumentFilePath().Lower().find(_DT(L".xlsx#"));
-            assert(excelTag != std::wstring::npos);
-            if (excelTag != std::wstring::npos)
+            wxFileName fn(doc->GetOriginalDocumentFilePath().substr(0, excelTag + 5));
+            if (!wxFile::Exists(fn.GetFullPath()))
                 {
-                wxFileName fn((*pos)->GetOriginalDocumentFilePath().substr(0, excelTag + 5));
-                if (!wxFile::Exists(fn.GetFullPath()))
+                wxString fileBySameNameInProjectDirectory;
+                if (FindMissingFile(fn.GetFullPath(), fileBySameNameInProjectDirectory))
                     {
-                    wxString fileBySameNameInProjectDirectory;
-                    if (FindMissingFile(fn.GetFullPath(), fileBySameNameInProjectDirectory))
+                    doc->SetOriginalDocumentFilePath(
+                        fileBySameNameInProjectDirectory +
+                        doc->GetOriginalDocumentFilePath().substr(excelTag + 5));
+                    excelTag = doc->GetOriginalDocumentFilePath().Lower().find(_DT(L".xlsx#"));
+                    fn.Assign(fileBySameNameInProjectDirectory);
+                    SetModifiedFlag();
+                    }
+                }
+            wxString worksheetName = doc->GetOriginalDocumentFilePath().substr(excelTag + 6);
+            const size_t slash = worksheetName.find_last_of(L'#');
+            if (slash != wxString::npos)
+                {
+                wxString CellName = worksheetName.substr(slash + 1);
+                worksheetName.Truncate(slash);
+                const wxString workSheetPath = fn.GetFullPath() + L"#" + worksheetName;
+                std::map<wxString, ExcelFile*>::iterator excelFilePos =
+                    excelFiles.find(workSheetPath);
+                if (excelFilePos == excelFiles.end())
+                    {
+                    excelFilePos = excelFiles
+                                       .insert(std::pair<wxString, ExcelFile*>(
+                                           workSheetPath, new ExcelFile(fn.GetFullPath())))
+                                       .first;
+                    // read in the worksheets
+                    std::wstring workBookFileText =
+                        excelFilePos->second->m_zip.ReadTextFile(L"xl/workbook.xml");
+                    excelFilePos->second->m_xlsx_extract.read_worksheet_names(
+                        workBookFileText.c_str(), workBookFileText.length());
+                    // read in the string table
+                    const std::wstring sharedStrings =
+                        excelFilePos->second->m_zip.ReadTextFile(L"xl/sharedStrings.xml");
+                    if (sharedStrings.length())
                         {
-                        (*pos)->SetOriginalDocumentFilePath(
-                            fileBySameNameInProjectDirectory +
-                            (*pos)->GetOriginalDocumentFilePath().substr(excelTag + 5));
-                        excelTag =
-                            (*pos)->GetOriginalDocumentFilePath().Lower().find(_DT(L".xlsx#"));
-                        fn.Assign(fileBySameNameInProjectDirectory);
-                        SetModifiedFlag();
+                        excelFilePos->second->m_xlsx_extract.read_shared_strings(
+                            sharedStrings.c_str(), sharedStrings.length());
                         }
                     }
-                wxString worksheetName = (*pos)->GetOriginalDocumentFilePath().substr(excelTag + 6);
-                const size_t slash = worksheetName.find_last_of(L'#');
-                if (slash != wxString::npos)
+
+                // find the sheet to get the cells from
+                auto sheetPos = std::find(
+                    excelFilePos->second->m_xlsx_extract.get_worksheet_names().begin(),
+                    excelFilePos->second->m_xlsx_extract.get_worksheet_names().end(),
+                    worksheetName.wc_str());
+                if (sheetPos != excelFilePos->second->m_xlsx_extract.get_worksheet_names().end())
                     {
-                    wxString CellName = worksheetName.substr(slash + 1);
-                    worksheetName.Truncate(slash);
-                    const wxString workSheetPath = fn.GetFullPath() + L"#" + worksheetName;
-                    std::map<wxString, ExcelFile*>::iterator excelFilePos =
-                        excelFiles.find(workSheetPath);
-                    if (excelFilePos == excelFiles.end())
+                    const wxString internalSheetName = wxString::Format(
+                        L"xl/worksheets/sheet%zu.xml",
+                        (sheetPos -
+                         excelFilePos->second->m_xlsx_extract.get_worksheet_names().begin()) +
+                            1);
+                    // see if this worksheet is already loaded
+                    ExcelFile::Workbook::iterator internalSheetPos =
+                        excelFilePos->second->m_worksheets.find(internalSheetName);
+                    // wasn't loaded before, so load it now
+                    if (internalSheetPos == excelFilePos->second->m_worksheets.end())
                         {
-                        excelFilePos = excelFiles
-                                           .insert(std::pair<wxString, ExcelFile*>(
-                                               workSheetPath, new ExcelFile(fn.GetFullPath())))
-                                           .first;
-                        // read in the worksheets
-                        std::wstring workBookFileText =
-                            excelFilePos->second->m_zip.ReadTextFile(L"xl/workbook.xml");
-                        excelFilePos->second->m_xlsx_extract.read_worksheet_names(
-                            workBookFileText.c_str(), workBookFileText.length());
-                        // read in the string table
-                        const std::wstring sharedStrings =
-                            excelFilePos->second->m_zip.ReadTextFile(L"xl/sharedStrings.xml");
-                        if (sharedStrings.length())
+                        std::pair<ExcelFile::Workbook::iterator, bool> insertPos =
+                            excelFilePos->second->m_worksheets.insert(
+                                std::pair<wxString,
+                                          lily_of_the_valley::xlsx_extract_text::worksheet>(
+                                    internalSheetName,
+                                    lily_of_the_valley::xlsx_extract_text::worksheet()));
+                        internalSheetPos = insertPos.first;
+                        const std::wstring sheetFile =
+                            excelFilePos->second->m_zip.ReadTextFile(internalSheetName);
+                        if (sheetFile.length())
                             {
-                            excelFilePos->second->m_xlsx_extract.read_shared_strings(
-                                sharedStrings.c_str(), sharedStrings.length());
+                            excelFilePos->second->m_xlsx_extract(sheetFile.c_str(),
+                                                                 sheetFile.length(),
+                                                                 internalSheetPos->second);
                             }
                         }
-
-                    // find the sheet to get the cells from
-                    auto sheetPos = std::find(
-                        excelFilePos->second->m_xlsx_extract.get_worksheet_names().begin(),
-                        excelFilePos->second->m_xlsx_extract.get_worksheet_names().end(),
-                        worksheetName.wc_str());
-                    if (sheetPos !=
-                        excelFilePos->second->m_xlsx_extract.get_worksheet_names().end())
+                    wxString cellText = excelFilePos->second->m_xlsx_extract.get_cell_text(
+                        CellName.wc_str(), internalSheetPos->second);
+                    fileResolver.ResolvePath(cellText, false);
+                    if (!fileResolver.IsInvalidFile())
                         {
-                        const wxString internalSheetName = wxString::Format(
-                            L"xl/worksheets/sheet%zu.xml",
-                            (sheetPos -
-                             excelFilePos->second->m_xlsx_extract.get_worksheet_names().begin()) +
-                                1);
-                        // see if this worksheet is already loaded
-                        ExcelFile::Workbook::iterator internalSheetPos =
-                            excelFilePos->second->m_worksheets.find(internalSheetName);
-                        // wasn't loaded before, so load it now
-                        if (internalSheetPos == excelFilePos->second->m_worksheets.end())
-                            {
-                            std::pair<ExcelFile::Workbook::iterator, bool> insertPos =
-                                excelFilePos->second->m_worksheets.insert(
-                                    std::pair<wxString,
-                                              lily_of_the_valley::xlsx_extract_text::worksheet>(
-                                        internalSheetName,
-                                        lily_of_the_valley::xlsx_extract_text::worksheet()));
-                            internalSheetPos = insertPos.first;
-                            const std::wstring sheetFile =
-                                excelFilePos->second->m_zip.ReadTextFile(internalSheetName);
-                            if (sheetFile.length())
-                                {
-                                excelFilePos->second->m_xlsx_extract(sheetFile.c_str(),
-                                                                     sheetFile.length(),
-                                                                     internalSheetPos->second);
-                                }
-                            }
-                        wxString cellText = excelFilePos->second->m_xlsx_extract.get_cell_text(
-                            CellName.wc_str(), internalSheetPos->second);
-                        fileResolver.ResolvePath(cellText, false);
-                        if (!fileResolver.IsInvalidFile())
-                            {
-                            // this will change the spreadsheet cell path to the real file path
-                            (*pos)->LoadDocumentAsSubProject(fileResolver.GetResolvedPath(),
-                                                             std::wstring{},
-                                                             GetMinDocWordCountForBatch());
-                            }
-                        else
-                            {
-                            (*pos)->SetDocumentText(cellText.wc_string());
-                            (*pos)->LoadDocumentAsSubProject((*pos)->GetOriginalDocumentFilePath(),
-                                                             (*pos)->GetDocumentText(),
-                                                             GetMinDocWordCountForBatch());
-                            }
+                        // this will change the spreadsheet cell path to the real file path
+                        doc->LoadDocumentAsSubProject(fileResolver.GetResolvedPath(),
+                                                      std::wstring{}, GetMinDocWordCountForBatch());
                         }
                     else
                         {
-                        (*pos)->SetLoadingOriginalTextSucceeded(false);
+                        doc->SetDocumentText(cellText.wc_string());
+                        doc->LoadDocumentAsSubProject(doc->GetOriginalDocumentFilePath(),
+                                                      doc->GetDocumentText(),
+                                                      GetMinDocWordCountForBatch());
                         }
                     }
                 else
                     {
-                    (*pos)->SetLoadingOriginalTextSucceeded(false);
+                    doc->SetLoadingOriginalTextSucceeded(false);
                     }
                 }
             else
                 {
-                (*pos)->SetLoadingOriginalTextSucceeded(false);
+                doc->SetLoadingOriginalTextSucceeded(false);
                 }
             }
-        else if (fileResolve.IsArchivedFile())
+        else
+            {
+            doc->SetLoadingOriginalTextSucceeded(false);
+            }
+        }
+    else if (fileResolve.IsArchivedFile())
+        {
+        size_t archiveTag = doc->GetOriginalDocumentFilePath().Lower().find(_DT(L".zip#"));
+        assert(archiveTag != std::wstring::npos);
+        if (archiveTag != std::wstring::npos)
             {
-            size_t archiveTag = (*pos)->GetOriginalDocumentFilePath().Lower().find(_DT(L".zip#"));
-            assert(archiveTag != std::wstring::npos);
-            if (archiveTag != std::wstring::npos)
+            wxFileName fn(doc->GetOriginalDocumentFilePath().substr(0, archiveTag + 4));
+            if (!wxFile::Exists(fn.GetFullPath()))
                 {
-                wxFileName fn((*pos)->GetOriginalDocumentFilePath().substr(0, archiveTag + 4));
-                if (!wxFile::Exists(fn.GetFullPath()))
-                    {
-                    wxString fileBySameNameInProjectDirectory;
-                    if (FindMissingFile(fn.GetFullPath(), fileBySameNameInProjectDirectory))
-                        {
-                        (*pos)->SetOriginalDocumentFilePath(
-                            fileBySameNameInProjectDirectory +
-                            (*pos)->GetOriginalDocumentFilePath().substr(archiveTag + 4));
-                        archiveTag =
-                            (*pos)->GetOriginalDocumentFilePath().Lower().find(_DT(L".zip#"));
-                        fn.Assign(fileBySameNameInProjectDirectory);
-                        SetModifiedFlag();
-                        }
-                    }
-                auto archiveFilePos = archiveFiles.find(fn.GetFullPath());
-                if (archiveFilePos == archiveFiles.end())
-                    {
-                    archiveFilePos =
-                        archiveFiles
-                            .insert(std::pair<wxString, Wisteria::ZipCatalog*>(
-                                fn.GetFullPath(), new Wisteria::ZipCatalog(fn.GetFullPath())))
-                            .first;
-                    }
-                wxMemoryOutputStream memstream;
-                if (!archiveFilePos->second->ReadFile(
-                        (*pos)->GetOriginalDocumentFilePath().substr(archiveTag + 5), memstream) &&
-                    archiveFilePos->second->GetMessages().size())
-                    {
-                    AddQuietSubProjectMessage(
-                        archiveFilePos->second->GetMessages().back().m_message,
-                        archiveFilePos->second->GetMessages().back().m_icon);
-                    archiveFilePos->second->ClearMessages();
-                    }
-                // Only load the document if the archive read didn't fail.
-                // Otherwise, LoadDocumentNoUI() will try to load the ZIP file and
-                // get the same error.
-                if (memstream.GetLength())
-                    {
-                    const std::pair<bool, std::wstring> extractResult = (*pos)->ExtractRawText(
-                        { static_cast<const char*>(
-                              memstream.GetOutputStreamBuffer()->GetBufferStart()),
-                          static_cast<size_t>(memstream.GetLength()) },
-                        wxFileName((*pos)->GetOriginalDocumentFilePath()).GetExt());
-                    (*pos)->LoadDocumentAsSubProject((*pos)->GetOriginalDocumentFilePath(),
-                                                     extractResult.second,
-                                                     GetMinDocWordCountForBatch());
-                    }
-                else
+                wxString fileBySameNameInProjectDirectory;
+                if (FindMissingFile(fn.GetFullPath(), fileBySameNameInProjectDirectory))
                     {
-                    (*pos)->SetLoadingOriginalTextSucceeded(false);
+                    doc->SetOriginalDocumentFilePath(
+                        fileBySameNameInProjectDirectory +
+                        doc->GetOriginalDocumentFilePath().substr(archiveTag + 4));
+                    archiveTag = doc->GetOriginalDocumentFilePath().Lower().find(_DT(L".zip#"));
+                    fn.Assign(fileBySameNameInProjectDirectory);
+                    SetModifiedFlag();
                     }
                 }
+            auto archiveFilePos = archiveFiles.find(fn.GetFullPath());
+            if (archiveFilePos == archiveFiles.end())
+                {
+                archiveFilePos =
+                    archiveFiles
+                        .insert(std::pair<wxString, Wisteria::ZipCatalog*>(
+                            fn.GetFullPath(), new Wisteria::ZipCatalog(fn.GetFullPath())))
+                        .first;
+                }
+            wxMemoryOutputStream memstream;
+            if (!archiveFilePos->second->ReadFile(
+                    doc->GetOriginalDocumentFilePath().substr(archiveTag + 5), memstream) &&
+                archiveFilePos->second->GetMessages().size())
+                {
+                AddQuietSubProjectMessage(archiveFilePos->second->GetMessages().back().m_message,
+                    archiveFilePos->second->GetMessages().back().m_icon);
+                archiveFilePos->second->ClearMessages();
+                }
+            // Only load the document if the archive read didn't fail.
+            // Otherwise, LoadDocumentNoUI() will try to load the ZIP file and
+            // get the same error.
+            if (memstream.GetLength())
+                {
+                doc->ExtractRawText(
+                    { static_cast<const char*>(
+                          memstream.GetOutputStreamBuffer()->GetBufferStart()),
+                      static_cast<size_t>(memstream.GetLength()) },
+                    wxFileName(doc->GetOriginalDocumentFilePath()).GetExt(),
+                    documentTextBuffer);
+                doc->SetDocumentText(std::move(documentTextBuffer));
+                doc->LoadDocumentAsSubProject(doc->GetOriginalDocumentFilePath(),
+                                              doc->GetDocumentText(), GetMinDocWordCountForBatch());
+                }
             else
                 {
-                (*pos)->SetLoadingOriginalTextSucceeded(false);
+                doc->SetLoadingOriginalTextSucceeded(false);
                 }
             }
         else
             {
-            if (fileResolve.IsLocalOrNetworkFile() &&
-                !wxFile::Exists((*pos)->GetOriginalDocumentFilePath()))
+            doc->SetLoadingOriginalTextSucceeded(false);
+            }
+        }
+    else
+        {
+        if (fileResolve.IsLocalOrNetworkFile() &&
+            !wxFile::Exists(doc->GetOriginalDocumentFilePath()))
+            {
+            wxString fileBySameNameInProjectDirectory;
+            if (FindMissingFile(doc->GetOriginalDocumentFilePath(),
+                                fileBySameNameInProjectDirectory))
                 {
-                wxString fileBySameNameInProjectDirectory;
-                if (FindMissingFile((*pos)->GetOriginalDocumentFilePath(),
-                                    fileBySameNameInProjectDirectory))
-                    {
-                    (*pos)->SetOriginalDocumentFilePath(fileBySameNameInProjectDirectory);
-                    SetModifiedFlag();
-                    }
+                doc->SetOriginalDocumentFilePath(fileBySameNameInProjectDirectory);
+                SetModifiedFlag();
                 }
-            (*pos)->LoadDocumentAsSubProject((*pos)->GetOriginalDocumentFilePath(),
-                                             (*pos)->GetDocumentText(),
-                                             GetMinDocWordCountForBatch());
             }
-        // passing in an archived file that we extracted here will cause the
-        // subproject to use embedded text, see reset it after loading the document
-        (*pos)->SetDocumentStorageMethod(GetDocumentStorageMethod());
-        // free the text from the document to conserve memory
-        // (unless we are embedding it in the project)
-        if (GetDocumentStorageMethod() == TextStorage::NoEmbedText)
+        // if the text isn't embedded, then the file will be extracted into
+        // the (empty) buffer that we lend the document here
+        if (doc->GetDocumentText().empty())
             {
-            (*pos)->FreeDocumentText();
+            documentTextBuffer.clear();
+            doc->SetDocumentText(std::move(documentTextBuffer));
+            }
+        doc->LoadDocumentAsSubProject(doc->GetOriginalDocumentFilePath(), doc->GetDocumentText(),
+                                      GetMinDocWordCountForBatch());
+        }
+    // passing in an archived file that we extracted here will cause the
+    // subproject to use embedded text, see reset it after loading the document
+    doc->SetDocumentStorageMethod(GetDocumentStorageMethod());
+    // free the text from the document to conserve memory
+    // (unless we are embedding it in the project), taking its buffer back for the next one
+    if (GetDocumentStorageMethod() == TextStorage::NoEmbedText)
+        {
+        documentTextBuffer = std::move(doc->GetDocumentText());
+        doc->FreeDocumentText();
+        }
+    }
+
+//------------------------------------------------------------
+bool BatchProjectDoc::LoadDocuments(LoadingProgress& progressDlg)
+    {
+    // the finding lists are rebuilt below, so any strings they interned are no longer needed
+    GetRepeatedWordData()->DeleteAllItems();
+    m_incorrectArticleData->DeleteAllItems();
+    m_passiveVoiceData->DeleteAllItems();
+    m_sentenceStartingWithConjunctionsData->DeleteAllItems();
+    m_sentenceStartingWithLowercaseData->DeleteAllItems();
+    m_wordyPhraseData->DeleteAllItems();
+    m_redundantPhraseData->DeleteAllItems();
+    m_wordingErrorData->DeleteAllItems();
+    m_clichePhraseData->DeleteAllItems();
+    m_findingsStringPool->Clear();
+    m_overusedWordBySentenceData->DeleteAllItems();
+    m_overusedWordBySentenceData->SetSize(m_docs.size(), 4);
+    GetMisspelledWordData()->DeleteAllItems();
+    GetMisspelledWordData()->SetSize(m_docs.size(), 5);
+    m_overlyLongSentenceData->DeleteAllItems();
+    m_overlyLongSentenceData->SetSize(m_docs.size(), 5);
+
+    size_t overusedWordBySentenceCount = 0;
+    size_t misspelledWordCount = 0;
+    size_t longSenteceCount = 0;
+
+    int counter{ progressDlg.GetValue() };
+
+    double_frequency_set<word_case_insensitive_no_stem> wordsFromAllDocs;
+
+    // If updating in real time, then the documents' indexed data are kept so that
+    // only the documents that were changed need to be re-read when files change.
+    // That is the full word index of every document (instead of one at a time), so it
+    // is capped at MAX_KEPT_INDEXED_WORDS; the documents past that are freed as usual
+    // and simply re-read on every update.
+    const bool keepIndexedDocuments =
+        IsRealTimeUpdating() && GetDocumentStorageMethod() == TextStorage::NoEmbedText;
+    size_t keptIndexedWords{ 0 };
+    const bool reloadAllDocuments = m_changedDocuments.empty();
+
+    // Fingerprints of the documents loaded so far, to find documents that are nearly identical
+    // to one loaded before them. Only the signatures are kept, as each document's words are
+    // freed after it is reviewed below.
+    near_duplicate_index nearDuplicates;
+
+    std::map<wxString, Wisteria::ZipCatalog*> archiveFiles;
+    std::map<wxString, ExcelFile*> excelFiles;
+    // Text buffer that is handed from document to document. Each document's text is only
+    // needed while it is being indexed, so reusing one buffer avoids reallocating
+    // (and growing) a new one for every file.
+    std::wstring documentTextBuffer;
+    for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
+        {
+        if (reloadAllDocuments || (*pos)->GetWords() == nullptr ||
+            m_changedDocuments.find((*pos)->GetOriginalDocumentFilePath()) !=
+                m_changedDocuments.cend())
+            {
+            LoadDocument(*pos, archiveFiles, excelFiles, documentTextBuffer);
+            }
+
+        // near duplicates
+        (*pos)->ExcludeFromResults(false);
+        if (GetNearDuplicateHandling() != NearDuplicateHandling::Include &&
+            (*pos)->LoadingOriginalTextSucceeded() && (*pos)->GetWords() != nullptr)
+            {
+            const size_t docIndex = std::distance(m_docs.begin(), pos);
+            minhash_signature signature;
+            signature.add_words((*pos)->GetWords()->get_words().cbegin(),
+                                (*pos)->GetWords()->get_words().cend());
+            const auto original =
+                nearDuplicates.find_most_similar(signature, NEAR_DUPLICATE_SIMILARITY);
+            if (original && GetNearDuplicateHandling() == NearDuplicateHandling::Skip)
+                {
+                // the document stays in the project, but is left out of all the results
+                // (so log this in the batch's warnings)
+                AddQuietSubProjectMessage(
+                    wxString::Format(_(L"'%s' was left out of the results because it is "
+                                       "%.0f%% similar to '%s'."),
+                                     (*pos)->GetOriginalDocumentFilePath(),
+                                     original->m_similarity * 100,
+                                     m_docs[original->m_id]->GetOriginalDocumentFilePath()),
+                    wxICON_INFORMATION);
+                (*pos)->ExcludeFromResults(true);
+                (*pos)->DeleteUniqueWordMap();
+                (*pos)->DeleteWords();
+
+                if (!progressDlg.Update(counter++))
+                    {
+                    return false;
+                    }
+                continue;
+                }
+            // only the first document of each cluster is indexed, so that a near duplicate
+            // is always reported against that (and not against another near duplicate)
+            if (original)
+                {
+                (*pos)->AddQuietSubProjectMessage(
+                    wxString::Format(_(L"Document is %.0f%% similar to '%s'."),
+                                     original->m_similarity * 100,
+                                     m_docs[original->m_id]->GetOriginalDocumentFilePath()),
+                    wxICON_INFORMATION);
+                }
+            else
+                {
+                nearDuplicates.add(docIndex, signature);
+                }
             }
 
         // NOTE: Grammar info needs to be loaded here before the documents'
         // word collections are deleted
 
         // misspellings
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_misspelled_words().size())
             {
             GetMisspelledWordData()->SetItemText(misspelledWordCount, 0,
@@ -1971,71 +2273,24 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
             GetMisspelledWordData()->SetItemText(misspelledWordCount++, 4, misspelledWordsStr);
             }
         // repeated (duplicate) words
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_duplicate_word_indices().size())
             {
-            GetRepeatedWordData()->SetItemText(dupWordCount, 0,
-                                               (*pos)->GetOriginalDocumentFilePath());
-            GetRepeatedWordData()->SetItemText(dupWordCount, 1,
-                                               (*pos)->GetOriginalDocumentDescription());
-            GetRepeatedWordData()->SetItemValue(
-                dupWordCount, 2, (*pos)->GetWords()->get_duplicate_word_indices().size());
-            wxString doubleWordsStr;
             frequency_set<traits::case_insensitive_wstring_ex> doubleWords;
-            const auto& dupWordIndices = (*pos)->GetWords()->get_duplicate_word_indices();
-            for (size_t i = 0; i < dupWordIndices.size(); ++i)
-                {
-                doubleWords.insert((*pos)->GetWords()->get_word(dupWordIndices[i]).c_str());
-                }
-            const bool useQuotes{ doubleWords.get_data().size() > 1 };
-            for (const auto& doubleWord : doubleWords.get_data())
-                {
-                if (doubleWord.second > 1)
-                    {
-                    doubleWordsStr.Append(L'\"')
-                        .Append(doubleWord.first.c_str())
-                        .Append(L' ')
-                        .Append(doubleWord.first.c_str())
-                        .Append(wxString::Format(L"\" * %zu, ", doubleWord.second));
-                    }
-                else
-                    {
-                    if (useQuotes)
-                        {
-                        doubleWordsStr.Append(L'\"')
-                            .Append(doubleWord.first.c_str())
-                            .Append(L' ')
-                            .Append(doubleWord.first.c_str())
-                            .Append(L"\", ");
-                        }
-                    else
-                        {
-                        doubleWordsStr.Append(doubleWord.first.c_str())
-                            .Append(L' ')
-                            .Append(doubleWord.first.c_str())
-                            .Append(L", ");
-                        }
-                    }
-                }
-            // chop off the last ", "
-            if (doubleWordsStr.length() > 2)
+            const auto& dupWordIndices = (*pos)->GetWords()->get_duplicate_word_indices();
+            for (size_t i = 0; i < dupWordIndices.size(); ++i)
                 {
-                doubleWordsStr.RemoveLast(2);
+                const auto& dupWord = (*pos)->GetWords()->get_word(dupWordIndices[i]);
+                doubleWords.insert(dupWord + L' ' + dupWord);
                 }
-            GetRepeatedWordData()->SetItemText(dupWordCount++, 3, doubleWordsStr);
+            GetRepeatedWordData()->AddDocument((*pos)->GetOriginalDocumentFilePath(),
+                                               (*pos)->GetOriginalDocumentDescription(),
+                                               dupWordIndices.size(), doubleWords.get_data());
             }
         // incorrect articles
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_incorrect_article_indices().size())
             {
-            m_incorrectArticleData->SetItemText(incorrectArticleCount, 0,
-                                                (*pos)->GetOriginalDocumentFilePath());
-            m_incorrectArticleData->SetItemText(incorrectArticleCount, 1,
-                                                (*pos)->GetOriginalDocumentDescription());
-            m_incorrectArticleData->SetItemValue(
-                incorrectArticleCount, 2,
-                (*pos)->GetWords()->get_incorrect_article_indices().size());
-            wxString incorrectArticleStr;
             frequency_set<traits::case_insensitive_wstring_ex> incorrectArticles;
             const auto& incorrectArticleIndices =
                 (*pos)->GetWords()->get_incorrect_article_indices();
@@ -2046,38 +2301,12 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
                     (*pos)->GetWords()->get_word(incorrectArticleIndices[i]) + L' ' +
                     (*pos)->GetWords()->get_word(incorrectArticleIndices[i] + 1));
                 }
-            const bool useQuotes{ incorrectArticles.get_data().size() > 1 };
-            for (const auto& incorrectArticle : incorrectArticles.get_data())
-                {
-                if (incorrectArticle.second > 1)
-                    {
-                    incorrectArticleStr.Append(L'\"')
-                        .Append(incorrectArticle.first.c_str())
-                        .Append(wxString::Format(L"\" * %zu, ", incorrectArticle.second));
-                    }
-                else
-                    {
-                    if (useQuotes)
-                        {
-                        incorrectArticleStr.Append(L'\"')
-                            .Append(incorrectArticle.first.c_str())
-                            .Append(L"\", ");
-                        }
-                    else
-                        {
-                        incorrectArticleStr.Append(incorrectArticle.first.c_str()).Append(L", ");
-                        }
-                    }
-                }
-            // chop off the last ", "
-            if (incorrectArticleStr.length() > 2)
-                {
-                incorrectArticleStr.RemoveLast(2);
-                }
-            m_incorrectArticleData->SetItemText(incorrectArticleCount++, 3, incorrectArticleStr);
+            m_incorrectArticleData->AddDocument(
+                (*pos)->GetOriginalDocumentFilePath(), (*pos)->GetOriginalDocumentDescription(),
+                incorrectArticleIndices.size(), incorrectArticles.get_data());
             }
         // overused words (by sentence)
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_overused_words_by_sentence().size())
             {
             m_overusedWordBySentenceData->SetItemText(overusedWordBySentenceCount, 0,
@@ -2115,16 +2344,9 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
             m_overusedWordBySentenceData->SetItemText(overusedWordBySentenceCount++, 3, theWords);
             }
         // passive Voice
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_passive_voice_indices().size())
             {
-            m_passiveVoiceData->SetItemText(passiveVoiceCount, 0,
-                                            (*pos)->GetOriginalDocumentFilePath());
-            m_passiveVoiceData->SetItemText(passiveVoiceCount, 1,
-                                            (*pos)->GetOriginalDocumentDescription());
-            m_passiveVoiceData->SetItemValue(
-                passiveVoiceCount, 2, (*pos)->GetWords()->get_passive_voice_indices().size());
-            wxString passiveVoiceStr;
             frequency_set<traits::case_insensitive_wstring_ex> passiveVoices;
             const auto& passiveVoiceIndices = (*pos)->GetWords()->get_passive_voice_indices();
             for (size_t i = 0; i < passiveVoiceIndices.size(); ++i)
@@ -2144,38 +2366,12 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
                     }
                 passiveVoices.insert(currentPassivePhrase);
                 }
-            const bool useQuotes{ passiveVoices.get_data().size() > 1 };
-            for (const auto& passiveVoice : passiveVoices.get_data())
-                {
-                if (passiveVoice.second > 1)
-                    {
-                    passiveVoiceStr.Append(L'\"')
-                        .Append(passiveVoice.first.c_str())
-                        .Append(wxString::Format(L"\" * %zu, ", passiveVoice.second));
-                    }
-                else
-                    {
-                    if (useQuotes)
-                        {
-                        passiveVoiceStr.Append(L'\"')
-                            .Append(passiveVoice.first.c_str())
-                            .Append(L"\", ");
-                        }
-                    else
-                        {
-                        passiveVoiceStr.Append(passiveVoice.first.c_str()).Append(L", ");
-                        }
-                    }
-                }
-            // chop off the last ", "
-            if (passiveVoiceStr.length() > 2)
-                {
-                passiveVoiceStr.RemoveLast(2);
-                }
-            m_passiveVoiceData->SetItemText(passiveVoiceCount++, 3, passiveVoiceStr);
+            m_passiveVoiceData->AddDocument((*pos)->GetOriginalDocumentFilePath(),
+                                            (*pos)->GetOriginalDocumentDescription(),
+                                            passiveVoiceIndices.size(), passiveVoices.get_data());
             }
         // overly long sentences
-        if ((*pos)->LoadingOriginalTextSucceeded() && (*pos)->GetTotalOverlyLongSentences() > 0)
+        if ((*pos)->IsIncludedInResults() && (*pos)->GetTotalOverlyLongSentences() > 0)
             {
             m_overlyLongSentenceData->SetItemText(longSenteceCount, 0,
                                                   (*pos)->GetOriginalDocumentFilePath());
@@ -2198,16 +2394,9 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
             m_overlyLongSentenceData->SetItemText(longSenteceCount++, 4, currentSentence);
             }
         // sentences that start with conjunctions
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetSentenceStartingWithConjunctionsCount() > 0)
             {
-            m_sentenceStartingWithConjunctionsData->SetItemText(
-                conjunctionSentencesCount, 0, (*pos)->GetOriginalDocumentFilePath());
-            m_sentenceStartingWithConjunctionsData->SetItemText(
-                conjunctionSentencesCount, 1, (*pos)->GetOriginalDocumentDescription());
-            m_sentenceStartingWithConjunctionsData->SetItemValue(
-                conjunctionSentencesCount, 2, (*pos)->GetSentenceStartingWithConjunctionsCount());
-            wxString conjunctionsStr;
             frequency_set<traits::case_insensitive_wstring_ex> conjunctions;
             for (auto sentIter = (*pos)->GetWords()->get_conjunction_beginning_sentences().cbegin();
                  sentIter != (*pos)->GetWords()->get_conjunction_beginning_sentences().cend();
@@ -2217,39 +2406,14 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
                     (*pos)->GetWords()->get_sentences()[*sentIter].get_first_word_index();
                 conjunctions.insert((*pos)->GetWords()->get_words()[wordPos].c_str());
                 }
-            for (auto conIter = conjunctions.get_data().cbegin();
-                 conIter != conjunctions.get_data().cend(); ++conIter)
-                {
-                if (conIter->second > 1)
-                    {
-                    conjunctionsStr.Append(L'\"')
-                        .Append(conIter->first.c_str())
-                        .Append(wxString::Format(L"\" * %zu, ", conIter->second));
-                    }
-                else
-                    {
-                    conjunctionsStr.Append(L'\"').Append(conIter->first.c_str()).Append(L"\", ");
-                    }
-                }
-            // chop off the last ", "
-            if (conjunctionsStr.length() > 2)
-                {
-                conjunctionsStr.RemoveLast(2);
-                }
-            m_sentenceStartingWithConjunctionsData->SetItemText(conjunctionSentencesCount++, 3,
-                                                                conjunctionsStr);
+            m_sentenceStartingWithConjunctionsData->AddDocument(
+                (*pos)->GetOriginalDocumentFilePath(), (*pos)->GetOriginalDocumentDescription(),
+                (*pos)->GetSentenceStartingWithConjunctionsCount(), conjunctions.get_data());
             }
         // sentences that start with lowercase words
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetSentenceStartingWithLowercaseCount() > 0)
             {
-            m_sentenceStartingWithLowercaseData->SetItemText(lowercaseSentencesCount, 0,
-                                                             (*pos)->GetOriginalDocumentFilePath());
-            m_sentenceStartingWithLowercaseData->SetItemText(
-                lowercaseSentencesCount, 1, (*pos)->GetOriginalDocumentDescription());
-            m_sentenceStartingWithLowercaseData->SetItemValue(
-                lowercaseSentencesCount, 2, (*pos)->GetSentenceStartingWithLowercaseCount());
-            wxString lowercasesStr;
             frequency_set<traits::case_insensitive_wstring_ex> lowercases;
             for (auto sentIter = (*pos)->GetWords()->get_lowercase_beginning_sentences().cbegin();
                  sentIter != (*pos)->GetWords()->get_lowercase_beginning_sentences().cend();
@@ -2259,30 +2423,12 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
                     (*pos)->GetWords()->get_sentences()[*sentIter].get_first_word_index();
                 lowercases.insert((*pos)->GetWords()->get_words()[wordPos].c_str());
                 }
-            for (auto lcIter = lowercases.get_data().cbegin();
-                 lcIter != lowercases.get_data().cend(); ++lcIter)
-                {
-                if (lcIter->second > 1)
-                    {
-                    lowercasesStr.Append(L'\"')
-                        .Append(lcIter->first.c_str())
-                        .Append(wxString::Format(L"\" * %zu, ", lcIter->second));
-                    }
-                else
-                    {
-                    lowercasesStr.Append(L'\"').Append(lcIter->first.c_str()).Append(L"\", ");
-                    }
-                }
-            // chop off the last ", "
-            if (lowercasesStr.length() > 2)
-                {
-                lowercasesStr.RemoveLast(2);
-                }
-            m_sentenceStartingWithLowercaseData->SetItemText(lowercaseSentencesCount++, 3,
-                                                             lowercasesStr);
+            m_sentenceStartingWithLowercaseData->AddDocument(
+                (*pos)->GetOriginalDocumentFilePath(), (*pos)->GetOriginalDocumentDescription(),
+                (*pos)->GetSentenceStartingWithLowercaseCount(), lowercases.get_data());
             }
         // wordy items & cliches
-        if ((*pos)->LoadingOriginalTextSucceeded() &&
+        if ((*pos)->IsIncludedInResults() &&
             (*pos)->GetWords()->get_known_phrase_indices().size() > 0)
             {
             const auto& wordyIndices = (*pos)->GetWords()->get_known_phrase_indices();
@@ -2323,227 +2469,48 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
             // if anything was found in this document then add it to the lists
             if (errorsAndSuggestions.get_data().size())
                 {
-                wxString values;
-                wxString suggestions;
-                size_t totalCount{ 0 };
-                const bool useQuotes{ errorsAndSuggestions.get_data().size() > 1 };
-                for (const auto& errorAndSuggestion : errorsAndSuggestions.get_data())
-                    {
-                    if (errorAndSuggestion.second.second > 1)
-                        {
-                        // quotes will be needed if a multiplier is being added
-                        values.Append(L'\"')
-                            .Append(errorAndSuggestion.first.c_str())
-                            .Append(
-                                wxString::Format(L"\" * %zu, ", errorAndSuggestion.second.second));
-                        }
-                    else
-                        {
-                        // if there are multiple issues and suggestions, then wrap each
-                        // one in quotes
-                        if (useQuotes)
-                            {
-                            values.Append(L'\"')
-                                .Append(errorAndSuggestion.first.c_str())
-                                .Append(L"\", ");
-                            }
-                        else
-                            {
-                            values.Append(errorAndSuggestion.first.c_str()).Append(L", ");
-                            }
-                        }
-                    if (useQuotes)
-                        {
-                        suggestions.Append(L'\"')
-                            .Append(errorAndSuggestion.second.first)
-                            .Append(L"\", ");
-                        }
-                    else
-                        {
-                        suggestions.Append(errorAndSuggestion.second.first).Append(L", ");
-                        }
-                    totalCount += errorAndSuggestion.second.second;
-                    }
-                // trim off trailing comma and space
-                if (values.length() > 2)
-                    {
-                    values.RemoveLast(2);
-                    }
-                if (suggestions.length() > 2)
-                    {
-                    suggestions.RemoveLast(2);
-                    }
-                m_wordingErrorData->SetItemText(wordingErrorCount, 0,
-                                                (*pos)->GetOriginalDocumentFilePath());
-                m_wordingErrorData->SetItemText(wordingErrorCount, 1,
-                                                (*pos)->GetOriginalDocumentDescription());
-                m_wordingErrorData->SetItemValue(wordingErrorCount, 2, totalCount);
-                m_wordingErrorData->SetItemText(wordingErrorCount, 3, values);
-                m_wordingErrorData->SetItemText(wordingErrorCount++, 4, suggestions);
+                m_wordingErrorData->AddDocumentWithSuggestions(
+                    (*pos)->GetOriginalDocumentFilePath(),
+                    (*pos)->GetOriginalDocumentDescription(), errorsAndSuggestions.get_data());
                 }
             if (wordyPhrasesAndSuggestions.get_data().size())
                 {
-                wxString values;
-                wxString suggestions;
-                size_t totalCount{ 0 };
-                const bool useQuotes{ wordyPhrasesAndSuggestions.get_data().size() > 1 };
-                for (const auto& wordyPhrase : wordyPhrasesAndSuggestions.get_data())
-                    {
-                    if (wordyPhrase.second.second > 1)
-                        {
-                        values.Append(L'\"')
-                            .Append(wordyPhrase.first.c_str())
-                            .Append(wxString::Format(L"\" * %zu, ", wordyPhrase.second.second));
-                        }
-                    else
-                        {
-                        if (useQuotes)
-                            {
-                            values.Append(L'\"').Append(wordyPhrase.first.c_str()).Append(L"\", ");
-                            }
-                        else
-                            {
-                            values.Append(wordyPhrase.first.c_str()).Append(L", ");
-                            }
-                        }
-                    if (useQuotes)
-                        {
-                        suggestions.Append(L'\"').Append(wordyPhrase.second.first).Append(L"\", ");
-                        }
-                    else
-                        {
-                        suggestions.Append(wordyPhrase.second.first).Append(L", ");
-                        }
-                    totalCount += wordyPhrase.second.second;
-                    }
-                if (values.length() > 2)
-                    {
-                    values.RemoveLast(2);
-                    }
-                if (suggestions.length() > 2)
-                    {
-                    suggestions.RemoveLast(2);
-                    }
-                m_wordyPhraseData->SetItemText(wordyPhraseCount, 0,
-                                               (*pos)->GetOriginalDocumentFilePath());
-                m_wordyPhraseData->SetItemText(wordyPhraseCount, 1,
-                                               (*pos)->GetOriginalDocumentDescription());
-                m_wordyPhraseData->SetItemValue(wordyPhraseCount, 2, totalCount);
-                m_wordyPhraseData->SetItemText(wordyPhraseCount, 3, values);
-                m_wordyPhraseData->SetItemText(wordyPhraseCount++, 4, suggestions);
+                m_wordyPhraseData->AddDocumentWithSuggestions(
+                    (*pos)->GetOriginalDocumentFilePath(),
+                    (*pos)->GetOriginalDocumentDescription(),
+                    wordyPhrasesAndSuggestions.get_data());
                 }
             if (redundantPhrasesAndSuggestions.get_data().size())
                 {
-                wxString values;
-                wxString suggestions;
-                size_t totalCount{ 0 };
-                const bool useQuotes{ redundantPhrasesAndSuggestions.get_data().size() > 1 };
-                for (const auto& redundant : redundantPhrasesAndSuggestions.get_data())
-                    {
-                    if (redundant.second.second > 1)
-                        {
-                        values.Append(L'\"')
-                            .Append(redundant.first.c_str())
-                            .Append(wxString::Format(L"\" * %zu, ", redundant.second.second));
-                        }
-                    else
-                        {
-                        if (useQuotes)
-                            {
-                            values.Append(L'\"').Append(redundant.first.c_str()).Append(L"\", ");
-                            }
-                        else
-                            {
-                            values.Append(redundant.first.c_str()).Append(L", ");
-                            }
-                        }
-                    if (useQuotes)
-                        {
-                        suggestions.Append(L'\"').Append(redundant.second.first).Append(L"\", ");
-                        }
-                    else
-                        {
-                        suggestions.Append(redundant.second.first).Append(L", ");
-                        }
-                    totalCount += redundant.second.second;
-                    }
-                if (values.length() > 2)
-                    {
-                    values.RemoveLast(2);
-                    }
-                if (suggestions.length() > 2)
-                    {
-                    suggestions.RemoveLast(2);
-                    }
-                m_redundantPhraseData->SetItemText(redundantPhraseCount, 0,
-                                                   (*pos)->GetOriginalDocumentFilePath());
-                m_redundantPhraseData->SetItemText(redundantPhraseCount, 1,
-                                                   (*pos)->GetOriginalDocumentDescription());
-                m_redundantPhraseData->SetItemValue(redundantPhraseCount, 2, totalCount);
-                m_redundantPhraseData->SetItemText(redundantPhraseCount, 3, values);
-                m_redundantPhraseData->SetItemText(redundantPhraseCount++, 4, suggestions);
+                m_redundantPhraseData->AddDocumentWithSuggestions(
+                    (*pos)->GetOriginalDocumentFilePath(),
+                    (*pos)->GetOriginalDocumentDescription(),
+                    redundantPhrasesAndSuggestions.get_data());
                 }
             if (clichesAndSuggestions.get_data().size())
                 {
-                wxString values;
-                wxString suggestions;
-                size_t totalCount{ 0 };
-                const bool useQuotes{ clichesAndSuggestions.get_data().size() > 1 };
-                for (const auto& cliche : clichesAndSuggestions.get_data())
-                    {
-                    if (cliche.second.second > 1)
-                        {
-                        values.Append(L'\"')
-                            .Append(cliche.first.c_str())
-                            .Append(wxString::Format(L"\" * %zu, ", cliche.second.second));
-                        }
-                    else
-                        {
-                        if (useQuotes)
-                            {
-                            values.Append(L'\"').Append(cliche.first.c_str()).Append(L"\", ");
-                            }
-                        else
-                            {
-                            values.Append(cliche.first.c_str()).Append(L", ");
-                            }
-                        }
-                    if (useQuotes)
-                        {
-                        suggestions.Append(L'\"').Append(cliche.second.first).Append(L"\", ");
-                        }
-                    else
-                        {
-                        suggestions.Append(cliche.second.first).Append(L", ");
-                        }
-                    totalCount += cliche.second.second;
-                    }
-                if (values.length() > 2)
-                    {
-                    values.RemoveLast(2);
-                    }
-                if (suggestions.length() > 2)
-                    {
-                    suggestions.RemoveLast(2);
-                    }
-                m_clichePhraseData->SetItemText(clicheCount, 0,
-                                                (*pos)->GetOriginalDocumentFilePath());
-                m_clichePhraseData->SetItemText(clicheCount, 1,
-                                                (*pos)->GetOriginalDocumentDescription());
-                m_clichePhraseData->SetItemValue(clicheCount, 2, totalCount);
-                m_clichePhraseData->SetItemText(clicheCount, 3, values);
-                m_clichePhraseData->SetItemText(clicheCount++, 4, suggestions);
+                m_clichePhraseData->AddDocumentWithSuggestions(
+                    (*pos)->GetOriginalDocumentFilePath(),
+                    (*pos)->GetOriginalDocumentDescription(), clichesAndSuggestions.get_data());
                 }
             }
 
-        if ((*pos)->LoadingOriginalTextSucceeded() && (*pos)->GetWordsWithFrequencies())
+        if ((*pos)->IsIncludedInResults() && (*pos)->GetWordsWithFrequencies())
             {
             wordsFromAllDocs.insert_with_custom_increment(*(*pos)->GetWordsWithFrequencies(), 1);
             }
 
         // free up some memory by destroying the indexed data in the document
-        (*pos)->DeleteUniqueWordMap();
-        (*pos)->DeleteWords();
+        if (keepIndexedDocuments && (*pos)->GetWords() != nullptr &&
+            keptIndexedWords + (*pos)->GetWords()->get_words().size() <= MAX_KEPT_INDEXED_WORDS)
+            {
+            keptIndexedWords += (*pos)->GetWords()->get_words().size();
+            }
+        else
+            {
+            (*pos)->DeleteUniqueWordMap();
+            (*pos)->DeleteWords();
+            }
 
         if (!progressDlg.Update(counter++))
             {
@@ -2647,18 +2614,9 @@ bool BatchProjectDoc::LoadDocuments(wxProgressDialog& progressDlg)
         GetKeyWordsBatchData()->SetSize(uniqueImportWordsCount);
         }
 
-    GetRepeatedWordData()->SetSize(dupWordCount);
-    m_incorrectArticleData->SetSize(incorrectArticleCount);
     m_overusedWordBySentenceData->SetSize(overusedWordBySentenceCount);
-    m_passiveVoiceData->SetSize(passiveVoiceCount);
     GetMisspelledWordData()->SetSize(misspelledWordCount);
     m_overlyLongSentenceData->SetSize(longSenteceCount);
-    m_sentenceStartingWithConjunctionsData->SetSize(conjunctionSentencesCount);
-    m_sentenceStartingWithLowercaseData->SetSize(lowercaseSentencesCount);
-    m_wordyPhraseData->SetSize(wordyPhraseCount);
-    m_redundantPhraseData->SetSize(redundantPhraseCount);
-    m_wordingErrorData->SetSize(wordingErrorCount);
-    m_clichePhraseData->SetSize(clicheCount);
 
     // in case any webpaths were redirected, we will need to recreate the list of document paths
     SyncFilePathsWithDocuments();
@@ -2682,6 +2640,15 @@ void BatchProjectDoc::LoadScoresSection()
     {
     PROFILE();
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    // The graph-based tests are scored from their graphs, which a window-less project
+    // (from a headless script) doesn't have. These tests are only included there.
+    const auto isScoredByGraph = [view](const wxString& testId)
+    {
+        return view == nullptr &&
+               (testId == ReadabilityMessages::FRY() || testId == ReadabilityMessages::GPM_FRY() ||
+                testId == ReadabilityMessages::SCHWARTZ() ||
+                testId == ReadabilityMessages::RAYGOR() || testId == ReadabilityMessages::FRASE());
+    };
 
     // update any stats goals (test goals are reviewed as the tests are added below).
     for (auto doc : m_docs)
@@ -2780,7 +2747,7 @@ void BatchProjectDoc::LoadScoresSection()
         {
         (*pos)->GetAggregatedGradeScores().clear();
         (*pos)->GetAggregatedClozeScores().clear();
-        if (!(*pos)->LoadingOriginalTextSucceeded())
+        if (!(*pos)->IsIncludedInResults())
             {
             continue;
             }
@@ -2798,9 +2765,15 @@ void BatchProjectDoc::LoadScoresSection()
         for (auto rTests = GetReadabilityTests().get_tests().begin();
              rTests != GetReadabilityTests().get_tests().end(); ++rTests)
             {
+            if (rTests->is_included() && isScoredByGraph(rTests->get_test().get_id().c_str()))
+                {
+                m_scoreRawData->SetItemText(i, currentColumn++, wxString{});
+                (*pos)->ReviewTestGoal(rTests->get_test().get_id().c_str(),
+                                       std::numeric_limits<double>::quiet_NaN());
+                }
             // grade level tests
-            if (rTests->is_included() && rTests->get_test().get_test_type() ==
-                                             readability::readability_test_type::grade_level)
+            else if (rTests->is_included() && rTests->get_test().get_test_type() ==
+                                                  readability::readability_test_type::grade_level)
                 {
                 // have special logic for graphical tests
                 if (rTests->get_test().get_id() == ReadabilityMessages::FRY().wc_str())
@@ -3391,7 +3364,7 @@ void BatchProjectDoc::LoadScoresSection()
     currentRow = 0;
     for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             SetScoreStatsRow(m_aggregatedGradeScoresData, (*pos)->GetOriginalDocumentFilePath(),
                              // a bit of a hack--need to pass in something to force the use of
@@ -3413,7 +3386,7 @@ void BatchProjectDoc::LoadScoresSection()
     currentRow = 0;
     for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             SetScoreStatsRow(m_aggregatedClozeScoresData, (*pos)->GetOriginalDocumentFilePath(),
                              (*pos)->GetOriginalDocumentDescription().length() ?
@@ -3429,7 +3402,13 @@ void BatchProjectDoc::LoadScoresSection()
 //------------------------------------------------------------
 void BatchProjectDoc::DisplayWarnings()
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayWarnings");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     // initialize the warnings listctrl if it doesn't have any columns in it yet
     if (view->GetWarningsView()->GetColumnCount() == 0)
@@ -3471,7 +3450,13 @@ void BatchProjectDoc::DisplayWarnings()
 void BatchProjectDoc::DisplayScores()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayScores");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
         // main scores grid
         {
@@ -3651,7 +3636,7 @@ void BatchProjectDoc::DisplayScores()
         size_t i = 0;
         for (const auto& doc : m_docs)
             {
-            if (!doc->LoadingOriginalTextSucceeded())
+            if (!doc->IsIncludedInResults())
                 {
                 continue;
                 }
@@ -3807,47 +3792,47 @@ void BatchProjectDoc::DisplayScores()
 
     // add these here so that they are ordered after the aggregated stats
     if (view->GetCrawfordGraph() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::CRAWFORD()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::crawford) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetCrawfordGraph());
         }
     if (view->GetFleschChart() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::FLESCH()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::flesch) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetFleschChart());
         }
     if (view->GetDB2Plot() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::DANIELSON_BRYAN_2()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::danielson_bryan_2) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetDB2Plot());
         }
-    if (view->GetFryGraph() && GetReadabilityTests().is_test_included(ReadabilityMessages::FRY()) &&
+    if (view->GetFryGraph() && GetReadabilityTests().is_test_included(readability::test_key::fry) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetFryGraph());
         }
     if (view->GetGpmFryGraph() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::GPM_FRY()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::gpm_fry) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetGpmFryGraph());
         }
     if (view->GetFraseGraph() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::FRASE()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::frase) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetFraseGraph());
         }
     if (view->GetSchwartzGraph() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::SCHWARTZ()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::schwartz) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetSchwartzGraph());
         }
-    if (view->GetLixGauge() && GetReadabilityTests().is_test_included(ReadabilityMessages::LIX()) &&
+    if (view->GetLixGauge() && GetReadabilityTests().is_test_included(readability::test_key::lix) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetLixGauge());
@@ -3855,13 +3840,13 @@ void BatchProjectDoc::DisplayScores()
     if (view->GetGermanLixGauge() &&
         (GetReadabilityTests().is_test_included(
              ReadabilityMessages::LIX_GERMAN_CHILDRENS_LITERATURE()) ||
-         GetReadabilityTests().is_test_included(ReadabilityMessages::LIX_GERMAN_TECHNICAL())) &&
+         GetReadabilityTests().is_test_included(readability::test_key::lix_german_technical)) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetGermanLixGauge());
         }
     if (view->GetRaygorGraph() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::RAYGOR()) &&
+        GetReadabilityTests().is_test_included(readability::test_key::raygor) &&
         GetDocuments().size())
         {
         view->GetScoresView().AddWindow(view->GetRaygorGraph());
@@ -3876,6 +3861,10 @@ void BatchProjectDoc::DisplayScoreStatisticsWindow(
     const bool multiSelectable)
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     Wisteria::UI::ListCtrlEx* listView =
         dynamic_cast<Wisteria::UI::ListCtrlEx*>(view->GetScoresView().FindWindowById(windowId));
     if (!listView)
@@ -3944,6 +3933,10 @@ void BatchProjectDoc::DisplayScoreStatisticsWindow(
 void BatchProjectDoc::DisplayCrawfordGraph()
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const wxString scoresColumnName{ _DT(L"SCORES") };
     const wxString syllablesColumnName{ _DT(L"SYLLABLES") };
@@ -3958,7 +3951,7 @@ void BatchProjectDoc::DisplayCrawfordGraph()
 
     for (auto pos = GetDocuments().cbegin(); pos != GetDocuments().cend(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             const double gradeValue = readability::crawford(
                 (*pos)->GetTotalWords(), (*pos)->GetTotalSyllables(), (*pos)->GetTotalSentences());
@@ -3978,7 +3971,7 @@ void BatchProjectDoc::DisplayCrawfordGraph()
         }
 
     // Crawford Graph
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::CRAWFORD()) && m_docs.size())
+    if (GetReadabilityTests().is_test_included(readability::test_key::crawford) && m_docs.size())
         {
         std::shared_ptr<CrawfordGraph> crawfordGraph{ nullptr };
         Wisteria::Canvas* crawfordGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
@@ -4048,6 +4041,10 @@ void BatchProjectDoc::DisplayCrawfordGraph()
 void BatchProjectDoc::DisplayDB2Plot()
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const wxString scoresColumnName{ _DT(L"SCORES") };
     const wxString groupColumnName{ _DT(L"GROUP") };
@@ -4060,7 +4057,7 @@ void BatchProjectDoc::DisplayDB2Plot()
 
     for (auto pos = GetDocuments().cbegin(); pos != GetDocuments().cend(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             const auto score = readability::danielson_bryan_2(
                 (*pos)->GetTotalWords(), (*pos)->GetTotalCharactersPlusPunctuation(),
@@ -4079,7 +4076,7 @@ void BatchProjectDoc::DisplayDB2Plot()
         }
 
     // DB2
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::DANIELSON_BRYAN_2()) &&
+    if (GetReadabilityTests().is_test_included(readability::test_key::danielson_bryan_2) &&
         m_docs.size())
         {
         std::shared_ptr<DanielsonBryan2Plot> db2Plot{ nullptr };
@@ -4154,6 +4151,10 @@ void BatchProjectDoc::DisplayDB2Plot()
 void BatchProjectDoc::DisplayFleschChart()
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const wxString wordsColumnName{ _DT(L"WORDS") };
     const wxString scoresColumnName{ _DT(L"SCORES") };
@@ -4170,7 +4171,7 @@ void BatchProjectDoc::DisplayFleschChart()
 
     for (auto pos = GetDocuments().cbegin(); pos != GetDocuments().cend(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             const double ASL =
                 safe_divide<double>((*pos)->GetTotalWords(), (*pos)->GetTotalSentences());
@@ -4202,7 +4203,7 @@ void BatchProjectDoc::DisplayFleschChart()
         }
 
     // Flesch Chart
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::FLESCH()) && m_docs.size())
+    if (GetReadabilityTests().is_test_included(readability::test_key::flesch) && m_docs.size())
         {
         std::shared_ptr<FleschChart> fleschChart{ nullptr };
         Wisteria::Canvas* fleschChartCanvas = dynamic_cast<Wisteria::Canvas*>(
@@ -4270,6 +4271,10 @@ void BatchProjectDoc::DisplayFleschChart()
 void BatchProjectDoc::DisplayGermanLixGauge()
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const wxString scoresColumnName{ _DT(L"SCORES") };
     const wxString groupColumnName{ _DT(L"GROUP") };
@@ -4282,7 +4287,7 @@ void BatchProjectDoc::DisplayGermanLixGauge()
 
     for (auto pos = GetDocuments().cbegin(); pos != GetDocuments().cend(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             readability::german_lix_difficulty diffLevel;
             const size_t score = readability::german_lix(diffLevel, (*pos)->GetTotalWords(),
@@ -4304,7 +4309,7 @@ void BatchProjectDoc::DisplayGermanLixGauge()
     // German Lix Gauge
     if ((GetReadabilityTests().is_test_included(
              ReadabilityMessages::LIX_GERMAN_CHILDRENS_LITERATURE()) ||
-         GetReadabilityTests().is_test_included(ReadabilityMessages::LIX_GERMAN_TECHNICAL())) &&
+         GetReadabilityTests().is_test_included(readability::test_key::lix_german_technical)) &&
         m_docs.size())
         {
         std::shared_ptr<LixGaugeGerman> lixGauge{ nullptr };
@@ -4372,6 +4377,10 @@ void BatchProjectDoc::DisplayGermanLixGauge()
 void BatchProjectDoc::DisplayLixGauge()
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const wxString scoresColumnName{ _DT(L"SCORES") };
     const wxString groupColumnName{ _DT(L"GROUP") };
@@ -4384,7 +4393,7 @@ void BatchProjectDoc::DisplayLixGauge()
 
     for (auto pos = GetDocuments().cbegin(); pos != GetDocuments().cend(); ++pos)
         {
-        if ((*pos)->LoadingOriginalTextSucceeded())
+        if ((*pos)->IsIncludedInResults())
             {
             readability::lix_difficulty diffLevel;
             size_t gradeLevel{ 1 };
@@ -4404,7 +4413,7 @@ void BatchProjectDoc::DisplayLixGauge()
         }
 
     // Lix Gauge
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::LIX()) && m_docs.size())
+    if (GetReadabilityTests().is_test_included(readability::test_key::lix) && m_docs.size())
         {
         std::shared_ptr<LixGauge> lixGauge{ nullptr };
         Wisteria::Canvas* lixGaugeCanvas = dynamic_cast<Wisteria::Canvas*>(
@@ -4472,6 +4481,13 @@ void BatchProjectDoc::DisplayLixGauge()
 void BatchProjectDoc::DisplayReadabilityGraphs()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayReadabilityGraphs");
+    // (a window-less project from a headless script has no graphs to show)
+    if (GetFirstView() == nullptr)
+        {
+        return;
+        }
     DisplayFleschChart();
     DisplayDB2Plot();
     DisplayCrawfordGraph();
@@ -4512,7 +4528,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
 
     for (const auto doc : GetDocuments())
         {
-        if (doc->LoadingOriginalTextSucceeded())
+        if (doc->IsIncludedInResults())
             {
             auto foundGroupId =
                 GetDocumentLabels().find(doc->GetOriginalDocumentDescription().wc_str());
@@ -4538,7 +4554,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
     // Fry graph
     Wisteria::Canvas* fryGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
         view->GetScoresView().FindWindowById(BaseProjectView::FRY_PAGE_ID));
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::FRY()) && GetDocuments().size())
+    if (GetReadabilityTests().is_test_included(readability::test_key::fry) && GetDocuments().size())
         {
         std::shared_ptr<FryGraph> fryGraph{ nullptr };
         if (!fryGraphCanvas)
@@ -4607,7 +4623,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
     // GPM Fry graph
     fryGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
         view->GetScoresView().FindWindowById(BaseProjectView::GPM_FRY_PAGE_ID));
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::GPM_FRY()) &&
+    if (GetReadabilityTests().is_test_included(readability::test_key::gpm_fry) &&
         GetDocuments().size())
         {
         std::shared_ptr<FryGraph> gFryGraph{ nullptr };
@@ -4676,7 +4692,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
     // Schwartz graph
     Wisteria::Canvas* schwartzGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
         view->GetScoresView().FindWindowById(BaseProjectView::SCHWARTZ_PAGE_ID));
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::SCHWARTZ()) &&
+    if (GetReadabilityTests().is_test_included(readability::test_key::schwartz) &&
         GetDocuments().size())
         {
         std::shared_ptr<SchwartzGraph> schwartzGraph{ nullptr };
@@ -4746,7 +4762,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
     // FRASE graph
     Wisteria::Canvas* fraseGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
         view->GetScoresView().FindWindowById(BaseProjectView::FRASE_PAGE_ID));
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::FRASE()) &&
+    if (GetReadabilityTests().is_test_included(readability::test_key::frase) &&
         GetDocuments().size())
         {
         std::shared_ptr<FraseGraph> fraseGraph{ nullptr };
@@ -4814,7 +4830,7 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
     // Raygor graph
     Wisteria::Canvas* raygorGraphCanvas = dynamic_cast<Wisteria::Canvas*>(
         view->GetScoresView().FindWindowById(BaseProjectView::RAYGOR_PAGE_ID));
-    if (GetReadabilityTests().is_test_included(ReadabilityMessages::RAYGOR()) &&
+    if (GetReadabilityTests().is_test_included(readability::test_key::raygor) &&
         GetDocuments().size())
         {
         std::shared_ptr<RaygorGraph> raygorGraph{ nullptr };
@@ -4888,7 +4904,13 @@ void BatchProjectDoc::DisplayReadabilityGraphs()
 void BatchProjectDoc::DisplayBoxPlots()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayBoxPlots");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     // standard tests
     for (auto& sTest : GetReadabilityTests().get_tests())
@@ -5355,8 +5377,14 @@ void BatchProjectDoc::DisplayBoxPlots()
 void BatchProjectDoc::DisplayHistograms()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayHistograms");
     // First, remove any custom-test histograms that had their test removed from the project.
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     std::set<wxWindowID> validTestNames;
     for (auto rTests = GetReadabilityTests().get_tests().begin();
          rTests != GetReadabilityTests().get_tests().end(); ++rTests)
@@ -5476,6 +5504,10 @@ void BatchProjectDoc::DisplayHistogram(const wxString& name, const wxWindowID Id
                                        const bool startAtOne)
     {
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     Wisteria::Canvas* canvas =
         dynamic_cast<Wisteria::Canvas*>(view->GetHistogramsView().FindWindowByIdAndLabel(Id, name));
@@ -6054,6 +6086,10 @@ bool BatchProjectDoc::OnSaveDocument(const wxString& filename)
         return false;
         }
 
+    // unchanged embedded text is copied from here (this will differ from
+    // the new file path if coming from Save As)
+    const wxString previousFilePath{ GetFilename() };
+
     if (!GetFilename().empty() && GetFilename() != filename)
         {
         // must be coming from Save As, so make sure file isn't locked
@@ -6102,35 +6138,19 @@ bool BatchProjectDoc::OnSaveDocument(const wxString& filename)
        This helps us from corrupting the original file if something goes wrong
        during the write process.*/
     wxTempFileOutputStream out(filename);
-    wxZipOutputStream zip(out, 9 /*Maximum compression*/);
+    wxZipOutputStream zip(out, wxGetApp().GetAppOptions().GetProjectCompressionLevel());
 
     // settings.xml
     Wisteria::ZipCatalog::WriteText(zip, ProjectSettingsFileLabel(), FormatProjectSettings());
 
     // if storing indexed text, then include it
-    if (GetDocumentStorageMethod() == TextStorage::EmbedText)
+    std::vector<EmbeddedTextWriter::Fingerprint> embeddedTextFingerprints;
+    if (GetDocumentStorageMethod() == TextStorage::EmbedText &&
+        !SaveEmbeddedDocumentText(zip, previousFilePath, embeddedTextFingerprints))
         {
-        int counter{ 1 };
-        wxProgressDialog progressDlg(wxString::Format(_(L"Saving \"%s\""), GetTitle()), wxString{},
-                                     static_cast<int>(m_docs.size()), nullptr,
-                                     wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_CAN_ABORT |
-                                         wxPD_APP_MODAL);
-        progressDlg.Centre();
-        /* Use buffered output stream, NOT text output stream. Text output buffer
-           messes around with the newlines in the text, whereas buffer streams preserve the text.*/
-        for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
-            {
-            Wisteria::ZipCatalog::WriteText(
-                zip, wxString::Format(L"Content%zu.txt", pos - m_docs.begin()),
-                (*pos)->GetDocumentText());
-
-            if (!progressDlg.Update(counter++))
-                {
-                zip.Close();
-                m_File.Close();
-                return false;
-                }
-            }
+        zip.Close();
+        m_File.Close();
+        return false;
         }
     zip.Close();
 
@@ -6142,6 +6162,7 @@ bool BatchProjectDoc::OnSaveDocument(const wxString& filename)
                    _(L"Project Error"), wxOK | wxICON_EXCLAMATION);
         return false;
         }
+    m_embeddedTextFingerprints = std::move(embeddedTextFingerprints);
     if (!LockProjectFile())
         {
         return false;
@@ -6169,7 +6190,9 @@ bool BatchProjectDoc::OnOpenDocument(const wxString& filename)
             }
         }
 
-    wxBusyCursor wait;
+    const std::unique_ptr<wxBusyCursor> wait{ wxGetApp().IsHeadless() ?
+                                                  nullptr :
+                                                  std::make_unique<wxBusyCursor>() };
 
     // make sure the file exists first
     if (!wxFile::Exists(filename))
@@ -6264,7 +6287,8 @@ bool BatchProjectDoc::OnOpenDocument(const wxString& filename)
         return false;
         }
 
-    wxProgressDialog progressDlg(
+    // (only counted when running headless)
+    LoadingProgress progressDlg(
         wxString::Format(_(L"Opening \"%s\""), GetTitle()),
         wxString::Format(
             _(L"Analyzing %s documents..."),
@@ -6272,7 +6296,6 @@ bool BatchProjectDoc::OnOpenDocument(const wxString& filename)
                                         wxNumberFormatter::Style::Style_WithThousandsSep)),
         static_cast<int>(GetSourceFilesInfo().size() + 13), nullptr,
         wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_CAN_ABORT | wxPD_APP_MODAL);
-    progressDlg.Centre();
     int counter{ 1 };
 
     // If externally linking to the documents, then reset document collection.
@@ -6377,20 +6400,25 @@ bool BatchProjectDoc::OnOpenDocument(const wxString& filename)
     DisplayWarnings();
 
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
-    view->UpdateSideBarIcons();
-    view->UpdateRibbonState();
-    view->Present();
-    UpdateAllViews();
-
-    view->GetSideBar()->SelectSubItem(
-        view->GetSideBar()->FindSubItem(BatchProjectView::ID_SCORE_LIST_PAGE_ID));
-    auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
-        view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
-    if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
+    if (view != nullptr)
         {
-        scoresWindow->Select(0);
+        view->UpdateSideBarIcons();
+        view->UpdateRibbonState();
+        view->Present();
+        UpdateAllViews();
+
+        view->GetSideBar()->SelectSubItem(
+            view->GetSideBar()->FindSubItem(BatchProjectView::ID_SCORE_LIST_PAGE_ID));
+        auto* scoresWindow = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
+            view->GetScoresView().FindWindowById(BaseProjectView::ID_SCORE_LIST_PAGE_ID));
+        if (scoresWindow != nullptr && scoresWindow->GetItemCount() > 0)
+            {
+            scoresWindow->Select(0);
+            }
         }
 
+    RestartRealtimeUpdate();
+
     return true;
     }
 
@@ -6418,20 +6446,107 @@ void BatchProjectDoc::LoadProjectFile(const char* projectFileText, const size_t
     // and assign it to respective documents.
     if (GetDocumentStorageMethod() == TextStorage::EmbedText)
         {
-        for (auto pos = m_docs.begin(); pos != m_docs.end(); ++pos)
+        LoadEmbeddedDocumentText(projectFileText, textLength);
+        }
+    }
+
+//-------------------------------------------------------
+size_t BatchProjectDoc::GetWorkerCount(const size_t itemCount, const size_t minItemsPerWorker)
+    {
+    return std::clamp<size_t>(itemCount / std::max<size_t>(minItemsPerWorker, 1), 1,
+                              std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    }
+
+//-------------------------------------------------------
+void BatchProjectDoc::LoadEmbeddedDocumentText(const char* projectFileText,
+                                               const size_t textLength)
+    {
+    std::vector<std::wstring> documentTexts(m_docs.size());
+    m_embeddedTextFingerprints.assign(m_docs.size(), EmbeddedTextWriter::Fingerprint{});
+    // workers claim the next unread entry from here
+    std::atomic<size_t> nextEntry{ 0 };
+    const auto inflateEntries = [&]()
+        {
+        // a zip input stream can only read one entry at a time,
+        // so each worker needs its own catalog
+        Wisteria::ZipCatalog cat(projectFileText, textLength);
+        for (size_t i = nextEntry++; i < documentTexts.size(); i = nextEntry++)
+            {
+            documentTexts[i] = cat.ReadTextFile(EmbeddedTextWriter::GetEntryName(i));
+            m_embeddedTextFingerprints[i] = EmbeddedTextWriter::GetFingerprint(documentTexts[i]);
+            }
+        };
+
+    // Each worker indexes the central directory again, so only bring in more
+    // workers if they will each have a few documents to inflate.
+    constexpr size_t MIN_ENTRIES_PER_WORKER{ 4 };
+    const size_t workerCount = GetWorkerCount(documentTexts.size(), MIN_ENTRIES_PER_WORKER);
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount - 1);
+    for (size_t i = 1; i < workerCount; ++i)
+        {
+        workers.push_back(std::async(std::launch::async, inflateEntries));
+        }
+    inflateEntries();
+    // rethrows anything thrown by the workers
+    for (auto& worker : workers)
+        {
+        worker.get();
+        }
+
+    for (size_t i = 0; i < m_docs.size(); ++i)
+        {
+        m_docs[i]->SetDocumentText(std::move(documentTexts[i]));
+        }
+    }
+
+//-------------------------------------------------------
+bool BatchProjectDoc::SaveEmbeddedDocumentText(
+    wxZipOutputStream& zip, const wxString& previousFilePath,
+    std::vector<EmbeddedTextWriter::Fingerprint>& textFingerprints)
+    {
+    std::vector<const std::wstring*> texts;
+    texts.reserve(m_docs.size());
+    for (const auto* doc : m_docs)
+        {
+        texts.push_back(&doc->GetDocumentText());
+        }
+
+    wxProgressDialog progressDlg(wxString::Format(_(L"Saving \"%s\""), GetTitle()), wxString{},
+                                 static_cast<int>(m_docs.size()), nullptr,
+                                 wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_CAN_ABORT | wxPD_APP_MODAL);
+    progressDlg.Centre();
+
+    EmbeddedTextWriter writer(wxGetApp().GetAppOptions().GetProjectCompressionLevel());
+    writer.SetProgressCallback([&progressDlg](const size_t processed,
+                                              [[maybe_unused]] const size_t total)
+                               { return progressDlg.Update(static_cast<int>(processed)); });
+    if (!writer.Write(zip, texts, previousFilePath, m_embeddedTextFingerprints))
+        {
+        if (!writer.WasCancelled())
             {
-            (*pos)->SetDocumentText(
-                cat.ReadTextFile(wxString::Format(_DT(L"Content%zu.txt"), pos - m_docs.begin())));
+            LogMessage(
+                wxString::Format(_(L"Unable to write the text of '%s' to the project."),
+                                 m_docs[writer.GetFailedDocument()]->GetOriginalDocumentFilePath()),
+                _(L"Project Save"), wxOK | wxICON_EXCLAMATION);
             }
+        return false;
         }
+    textFingerprints = writer.GetFingerprints();
+    return true;
     }
 
 //-------------------------------------------------------
 void BatchProjectDoc::DisplayGrammar()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayGrammar");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
-    assert(view);
+    if (view == nullptr)
+        {
+        return;
+        }
 
     // Wording Errors
     Wisteria::UI::ListCtrlEx* listView = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
@@ -6963,7 +7078,13 @@ void BatchProjectDoc::DisplayGrammar()
 //-------------------------------------------------------
 void BatchProjectDoc::DisplaySummaryStats()
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplaySummaryStats");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     // summary stats
     Wisteria::UI::ListCtrlEx* listView = dynamic_cast<Wisteria::UI::ListCtrlEx*>(
         view->GetSummaryStatsView().FindWindowById(BaseProjectView::STATS_LIST_PAGE_ID));
@@ -7019,7 +7140,13 @@ void BatchProjectDoc::DisplaySummaryStats()
 //-------------------------------------------------------
 void BatchProjectDoc::DisplaySentencesBreakdown()
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplaySentencesBreakdown");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     // long sentences
     Wisteria::UI::ListCtrlEx* listView =
         dynamic_cast<Wisteria::UI::ListCtrlEx*>(view->GetSentencesBreakdownView().FindWindowById(
@@ -7074,7 +7201,13 @@ void BatchProjectDoc::DisplaySentencesBreakdown()
 void BatchProjectDoc::DisplayHardWords()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplayHardWords");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     // Difficult words
     if (m_hardWordsData->GetItemCount())
@@ -7115,7 +7248,7 @@ void BatchProjectDoc::DisplayHardWords()
                                        /* xgettext:no-c-format */ _(L"% of SMOG hard words"));
                 listView->InsertColumn(columnIndex++, _(L"SMOG hard words"));
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::GUNNING_FOG()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::gunning_fog))
                 {
                 listView->InsertColumn(columnIndex++,
                                        /* xgettext:no-c-format */ _(L"% of Fog hard words"));
@@ -7128,14 +7261,14 @@ void BatchProjectDoc::DisplayHardWords()
                     wxString::Format(_(L"%% of %s unfamiliar words"), _DT(L"Dale-Chall")));
                 listView->InsertColumn(columnIndex++, _(L"Dale-Chall unfamiliar words"));
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::spache))
                 {
                 listView->InsertColumn(
                     columnIndex++,
                     wxString::Format(_(L"%% of %s unfamiliar words"), _DT(L"Spache")));
                 listView->InsertColumn(columnIndex++, _(L"Spache unfamiliar words"));
                 }
-            if (GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+            if (GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
                 {
                 listView->InsertColumn(
                     columnIndex++, wxString::Format(_(L"%% of %s unfamiliar words"), _DT(L"HJ")));
@@ -7293,7 +7426,13 @@ void BatchProjectDoc::DisplayHardWords()
 void BatchProjectDoc::DisplaySightWords()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "BatchProjectDoc::DisplaySightWords");
     BatchProjectView* view = dynamic_cast<BatchProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     Wisteria::UI::ListCtrlEx* listView =
         dynamic_cast<Wisteria::UI::ListCtrlEx*>(view->GetDolchSightWordsView().FindWindowById(
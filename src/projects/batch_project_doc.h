@@ -17,11 +17,18 @@
 #include "../Wisteria-Dataviz/src/data/dataset.h"
 #include "../Wisteria-Dataviz/src/graphs/boxplot.h"
 #include "../Wisteria-Dataviz/src/graphs/histogram.h"
+#include "../ui/controls/batch_findings_provider.h"
 #include "base_project_doc.h"
 #include "base_project_view.h"
+#include "embedded_text_writer.h"
+#include <memory>
+#include <set>
 #include <vector>
 #include <wx/docview.h>
+#include <wx/progdlg.h>
+#include <wx/timer.h>
 #include <wx/wx.h>
+#include <wx/zipstrm.h>
 
 class BatchProjectDoc final : public BaseProjectDoc
     {
@@ -30,6 +37,9 @@ class BatchProjectDoc final : public BaseProjectDoc
         {
         // batches don't use manually entered text, so just set this to reflect that
         SetTextSource(TextSource::FromFile);
+        Bind(
+            wxEVT_TIMER, [this]([[maybe_unused]] wxTimerEvent& event)
+            { ReloadChangedDocuments(); }, m_changedDocumentsTimer.GetId());
         }
 
     BatchProjectDoc(const BatchProjectDoc&) = delete;
@@ -37,6 +47,8 @@ class BatchProjectDoc final : public BaseProjectDoc
 
     ~BatchProjectDoc()
         {
+        StopRealtimeUpdate();
+        m_changedDocumentsTimer.Stop();
         for (std::vector<BaseProject*>::iterator pos = m_docs.begin(); pos != m_docs.end(); ++pos)
             {
             wxDELETE(*pos);
@@ -50,6 +62,11 @@ class BatchProjectDoc final : public BaseProjectDoc
     bool OnOpenDocument(const wxString& filename) final;
 
     void RefreshProject() final;
+    /// @brief Stops reloading the project when its source documents change.
+    void StopRealtimeUpdate();
+    /// @brief Starts watching the (linked) source documents for changes,
+    ///     if real-time updating is enabled.
+    void RestartRealtimeUpdate();
     /// Only refresh the graphs, this assumes that no windows are being added
     /// or removed from the project.
     void RefreshGraphs() final;
@@ -115,13 +132,13 @@ class BatchProjectDoc final : public BaseProjectDoc
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetRepeatedWordData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetRepeatedWordData() const noexcept
         {
         return m_dupWordData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetIncorrectArticleData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetIncorrectArticleData() const noexcept
         {
         return m_incorrectArticleData;
         }
@@ -134,31 +151,31 @@ class BatchProjectDoc final : public BaseProjectDoc
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetPassiveVoiceData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetPassiveVoiceData() const noexcept
         {
         return m_passiveVoiceData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetWordyItemsData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetWordyItemsData() const noexcept
         {
         return m_wordyPhraseData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetRedundantPhrasesData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetRedundantPhrasesData() const noexcept
         {
         return m_redundantPhraseData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetWordingErrorsData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetWordingErrorsData() const noexcept
         {
         return m_wordingErrorData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetClicheData() const noexcept
+    const std::shared_ptr<BatchFindingsDataProvider>& GetClicheData() const noexcept
         {
         return m_clichePhraseData;
         }
@@ -182,20 +199,51 @@ class BatchProjectDoc final : public BaseProjectDoc
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>&
+    const std::shared_ptr<BatchFindingsDataProvider>&
     GetConjunctionStartingSentencesData() const noexcept
         {
         return m_sentenceStartingWithConjunctionsData;
         }
 
     [[nodiscard]]
-    const std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>&
+    const std::shared_ptr<BatchFindingsDataProvider>&
     GetLowerCasedSentencesData() const noexcept
         {
         return m_sentenceStartingWithLowercaseData;
         }
 
   private:
+    /// @brief Shows the progress of loading the documents in a progress dialog,
+    ///     or only keeps track of it when running headless (where there is no one to show it to).
+    class LoadingProgress
+        {
+      public:
+        /** @brief Constructor.
+            @param title The title of the dialog.
+            @param message The initial message of the dialog.
+            @param maximum The number of steps.
+            @param parent The parent of the dialog.
+            @param style The style of the dialog.*/
+        LoadingProgress(const wxString& title, const wxString& message, const int maximum,
+                        wxWindow* parent, const int style);
+        /** @brief Moves the progress to a step.
+            @param value The step.
+            @param message The new message to show (if not empty).
+            @returns @c false if the user cancelled.*/
+        bool Update(const int value, const wxString& message = wxString{});
+
+        /// @returns The current step.
+        [[nodiscard]]
+        int GetValue() const
+            {
+            return (m_dialog != nullptr) ? m_dialog->GetValue() : m_value;
+            }
+
+      private:
+        std::unique_ptr<wxProgressDialog> m_dialog;
+        int m_value{ 0 };
+        };
+
     [[nodiscard]]
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetMisspelledWordData() noexcept
         {
@@ -203,7 +251,7 @@ class BatchProjectDoc final : public BaseProjectDoc
         }
 
     [[nodiscard]]
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider>& GetRepeatedWordData() noexcept
+    std::shared_ptr<BatchFindingsDataProvider>& GetRepeatedWordData() noexcept
         {
         return m_dupWordData;
         }
@@ -226,9 +274,49 @@ class BatchProjectDoc final : public BaseProjectDoc
     void DisplayLixGauge();
     void DisplayGermanLixGauge();
     constexpr static size_t CUMULATIVE_STATS_COUNT = 13;
+    /// @brief The (estimated) shingle similarity at which a document is considered
+    ///     a near duplicate of another one.
+    constexpr static double NEAR_DUPLICATE_SIMILARITY{ 0.9 };
+    /// @brief The most indexed words (across all documents) kept in memory between
+    ///     real-time updates.
+    /// @details An indexed word (with its string, sentence/paragraph position, and
+    ///     syllable count) takes roughly 100 bytes, so this keeps about 500MB.
+    ///     Documents past this are freed after they are reviewed and re-read from their
+    ///     files on the next update, as if they had changed.
+    constexpr static size_t MAX_KEPT_INDEXED_WORDS{ 5'000'000 };
     void LoadProjectFile(const char* projectFileText, const size_t textLength);
+    /** @brief Reads the embedded text of each document from the project file.
+        @details The entries are inflated in parallel, each worker reading
+            through its own catalog of the (read-only) project file data.
+        @param projectFileText The project file's (zip) data.
+        @param textLength The length of @c projectFileText.*/
+    void LoadEmbeddedDocumentText(const char* projectFileText, const size_t textLength);
+    /** @brief Writes the embedded text of each document to the project file.
+        @details Only documents whose text changed since the project file was last
+            loaded or saved are recompressed (see EmbeddedTextWriter); the others are
+            copied verbatim from the previous project file.
+        @param zip The project file being written.
+        @param previousFilePath The path of the project file as it was last loaded or saved.
+        @param[out] textFingerprints The fingerprints of the documents' text that was written.
+        @returns @c false if the user cancelled or an entry could not be written.*/
+    bool SaveEmbeddedDocumentText(wxZipOutputStream& zip, const wxString& previousFilePath,
+                                  std::vector<EmbeddedTextWriter::Fingerprint>& textFingerprints);
+    /// @returns How many threads to split @c itemCount items between,
+    ///     giving each at least @c minItemsPerWorker items.
+    [[nodiscard]]
+    static size_t GetWorkerCount(const size_t itemCount, const size_t minItemsPerWorker);
     bool RunProjectWizard(const wxString& path);
-    bool LoadDocuments(wxProgressDialog& progressDlg);
+    /// @brief Creates the project's view, unless running headless.
+    bool CreateView(const wxString& path, const long flags);
+    bool LoadDocuments(LoadingProgress& progressDlg);
+    /// @brief Loads and indexes a document's text from its source file.
+    void LoadDocument(BaseProject* doc, std::map<wxString, Wisteria::ZipCatalog*>& archiveFiles,
+                      std::map<wxString, ExcelFile*>& excelFiles, std::wstring& documentTextBuffer);
+    /// @brief Queues the documents that were changed outside of the program to be reloaded.
+    void OnSourceFilesChanged(const wxArrayString& changedFiles);
+    /// @brief Reloads the queued (changed) documents, or tries again later if the project
+    ///     is busy.
+    void ReloadChangedDocuments();
     void LoadScoresSection();
     void LoadSummaryStatsSection();
     void LoadWarningsSection();
@@ -330,6 +418,16 @@ class BatchProjectDoc final : public BaseProjectDoc
     Wisteria::Icons::Schemes::StandardShapes m_iconScheme;
 
     std::vector<BaseProject*> m_docs;
+    // source paths of the documents to reload during a real-time update
+    // (if empty, then all documents are reloaded)
+    std::set<wxString> m_changedDocuments;
+    // set while RefreshProject() is only reloading the changed documents
+    bool m_reloadingChangedDocuments{ false };
+    // retries reloading the changed documents if they changed while the project was busy
+    wxTimer m_changedDocumentsTimer{ this };
+    // fingerprints of the documents' embedded text (Content<n>.txt) as it is in the project
+    // file, so that saving can reuse the entries of documents that have not changed
+    std::vector<EmbeddedTextWriter::Fingerprint> m_embeddedTextFingerprints;
     std::map<traits::case_insensitive_wstring_ex, Wisteria::Data::GroupIdType> m_docLabels;
     Wisteria::Data::ColumnWithStringTable::StringTableType m_groupStringTable;
     // score list data
@@ -349,41 +447,47 @@ class BatchProjectDoc final : public BaseProjectDoc
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
     };
     // grammar list data
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_dupWordData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    // (paths, labels, and findings shared by the per-document finding lists)
+    std::shared_ptr<BatchFindingsStringPool> m_findingsStringPool{
+        std::make_shared<BatchFindingsStringPool>()
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_incorrectArticleData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_dupWordData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, false)
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_passiveVoiceData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_incorrectArticleData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, false)
+    };
+    std::shared_ptr<BatchFindingsDataProvider> m_passiveVoiceData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, false)
     };
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_misspelledWordData{
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_wordyPhraseData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_wordyPhraseData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, true)
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_redundantPhraseData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_redundantPhraseData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, true)
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_wordingErrorData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_wordingErrorData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, true)
     };
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_overusedWordBySentenceData{
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_clichePhraseData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_clichePhraseData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, true)
     };
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_overlyLongSentenceData{
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_sentenceStartingWithConjunctionsData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_sentenceStartingWithConjunctionsData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, false,
+                                                    BatchFindingsDataProvider::QuoteMethod::AlwaysQuote)
     };
-    std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_sentenceStartingWithLowercaseData{
-        std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
+    std::shared_ptr<BatchFindingsDataProvider> m_sentenceStartingWithLowercaseData{
+        std::make_shared<BatchFindingsDataProvider>(m_findingsStringPool, false,
+                                                    BatchFindingsDataProvider::QuoteMethod::AlwaysQuote)
     };
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_allWordsBatchData{
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
@@ -25,6 +25,9 @@
 #include "../ui/dialogs/tools_options_dlg.h"
 #include "batch_project_doc.h"
 #include "standard_project_doc.h"
+#include <atomic>
+#include <future>
+#include <thread>
 
 using namespace lily_of_the_valley;
 using namespace Wisteria;
@@ -356,35 +359,18 @@ void BatchProjectView::OnBatchExportFilteredDocuments([[maybe_unused]] wxCommand
         return;
         }
 
-    wxProgressDialog progressDlg(_(L"Exporting"), _(L"Exporting filtered documents..."),
-                                 static_cast<int>(doc->GetDocuments().size()), nullptr,
-                                 wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_CAN_ABORT |
-                                     wxPD_APP_MODAL);
-    int counter{ 1 };
-
-    std::wstring validDocText;
-    bool errorsExport{ false };
-    for (const auto subDoc : doc->GetDocuments())
+    // work out where each document goes (and create its folder) up front
+    std::vector<std::pair<const BaseProject*, wxString>> exports;
+    std::vector<std::pair<const BaseProject*, wxString>> mainThreadExports;
+    std::atomic<bool> errorsExport{ false };
+    for (const auto* subDoc : doc->GetDocuments())
         {
-        wxGetApp().Yield(true);
-        if (!progressDlg.Update(counter++))
-            {
-            return;
-            }
-
-        subDoc->FormatFilteredText(validDocText, optDlg.IsReplacingCharacters(),
-                                   optDlg.IsRemovingEllipses(), optDlg.IsRemovingBullets(),
-                                   optDlg.IsRemovingFilePaths(), optDlg.IsStrippingAbbreviations(),
-                                   optDlg.IsNarrowingFullWidthCharacters());
-
         wxString folderStructure = dirDlg.GetPath() + wxFileName::GetPathSeparator();
-        wxArrayString dirs = wxFileName(subDoc->GetOriginalDocumentFilePath()).GetDirs();
+        const wxArrayString dirs = wxFileName(subDoc->GetOriginalDocumentFilePath()).GetDirs();
         for (const auto& dir : dirs)
             {
             folderStructure += StripIllegalFileCharacters(dir) + wxFileName::GetPathSeparator();
             }
-        const wxString exportFilePath =
-            folderStructure + wxFileName(subDoc->GetOriginalDocumentFilePath()).GetName() + L".txt";
         if (!wxDir::Exists(folderStructure) &&
             !wxDir::Make(folderStructure, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
             {
@@ -392,13 +378,105 @@ void BatchProjectView::OnBatchExportFilteredDocuments([[maybe_unused]] wxCommand
             errorsExport = true;
             continue;
             }
+        // documents that may need to be downloaded (or searched for) are done
+        // on this thread afterwards
+        (subDoc->CanFormatFilteredTextConcurrently() ? exports : mainThreadExports)
+            .emplace_back(subDoc,
+                          folderStructure +
+                              wxFileName(subDoc->GetOriginalDocumentFilePath()).GetName() +
+                              L".txt");
+        }
+
+    // (read the options here, as the dialog shouldn't be touched from the workers)
+    const bool replaceCharacters{ optDlg.IsReplacingCharacters() };
+    const bool removeEllipses{ optDlg.IsRemovingEllipses() };
+    const bool removeBullets{ optDlg.IsRemovingBullets() };
+    const bool removeFilePaths{ optDlg.IsRemovingFilePaths() };
+    const bool stripAbbreviations{ optDlg.IsStrippingAbbreviations() };
+    const bool narrowFullWidthCharacters{ optDlg.IsNarrowingFullWidthCharacters() };
+    const auto exportDocument = [&](const BaseProject& subDoc, const wxString& exportFilePath,
+                                    BaseProject& indexingProject, std::wstring& validDocText)
+    {
+        if (!subDoc.FormatFilteredText(indexingProject, validDocText, replaceCharacters,
+                                       removeEllipses, removeBullets, removeFilePaths,
+                                       stripAbbreviations, narrowFullWidthCharacters))
+            {
+            wxLogError(L"Unable to load '%s' for exporting.", subDoc.GetOriginalDocumentFilePath());
+            errorsExport = true;
+            return;
+            }
         wxFileName(exportFilePath).SetPermissions(wxS_DEFAULT);
         wxFile filteredFile(exportFilePath, wxFile::write);
         if (!filteredFile.Write(validDocText, wxConvUTF8))
             {
-            wxMessageBox(_(L"Unable to write to output file."), _(L"Error"),
-                         wxOK | wxICON_EXCLAMATION);
+            wxLogError(L"Unable to write to '%s'.", exportFilePath);
+            errorsExport = true;
+            }
+    };
+
+    wxProgressDialog progressDlg(_(L"Exporting"), _(L"Exporting filtered documents..."),
+                                 static_cast<int>(exports.size() + mainThreadExports.size()),
+                                 nullptr,
+                                 wxPD_AUTO_HIDE | wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_CAN_ABORT |
+                                     wxPD_APP_MODAL);
+
+    // Documents that are still indexed are formatted straight from that; the rest are indexed
+    // again. Either way, each worker formats and writes its own documents, so the export
+    // is mostly bound by reading and writing the files.
+    std::atomic<size_t> nextIndex{ 0 };
+    std::atomic<size_t> exportedCount{ 0 };
+    std::atomic<bool> cancelled{ false };
+    const size_t workerCount =
+        std::min(exports.size(), std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    // the workers' projects (for re-indexing) can only be created on this thread
+    std::vector<std::unique_ptr<BaseProject>> indexingProjects;
+    std::vector<std::future<void>> workers;
+    for (size_t i = 0; i < workerCount; ++i)
+        {
+        indexingProjects.push_back(std::make_unique<BaseProject>());
+        // (the workers already export documents concurrently)
+        indexingProjects.back()->TokenizeInParallel(false);
+        workers.push_back(std::async(
+            std::launch::async,
+            [&, indexingProject = indexingProjects.back().get()]()
+            {
+                std::wstring validDocText;
+                for (size_t j = nextIndex++; j < exports.size() && !cancelled; j = nextIndex++)
+                    {
+                    exportDocument(*exports[j].first, exports[j].second, *indexingProject,
+                                   validDocText);
+                    ++exportedCount;
+                    }
+            }));
+        }
+    for (auto& worker : workers)
+        {
+        while (worker.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+            {
+            if (!cancelled && !progressDlg.Update(static_cast<int>(exportedCount)))
+                {
+                cancelled = true;
+                }
+            }
+        }
+    for (auto& worker : workers)
+        {
+        worker.get();
+        }
+    if (cancelled)
+        {
+        return;
+        }
+
+    BaseProject indexingProject;
+    std::wstring validDocText;
+    for (const auto& [subDoc, exportFilePath] : mainThreadExports)
+        {
+        if (!progressDlg.Update(static_cast<int>(++exportedCount)))
+            {
+            return;
             }
+        exportDocument(*subDoc, exportFilePath, indexingProject, validDocText);
         }
 
     if (errorsExport)
@@ -1412,16 +1490,6 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
 
     BatchProjectDoc* doc = dynamic_cast<BatchProjectDoc*>(GetDocument());
     double score = 0;
-    const auto fleschPos = doc->GetReadabilityTests().get_test(ReadabilityMessages::FLESCH());
-    const auto eflawPos = doc->GetReadabilityTests().get_test(ReadabilityMessages::EFLAW());
-    const auto fjpPos =
-        doc->GetReadabilityTests().get_test(ReadabilityMessages::FARR_JENKINS_PATERSON());
-    const auto amstadPos = doc->GetReadabilityTests().get_test(ReadabilityMessages::AMSTAD());
-    const auto db2Pos =
-        doc->GetReadabilityTests().get_test(ReadabilityMessages::DANIELSON_BRYAN_2());
-    const auto drpPos =
-        doc->GetReadabilityTests().get_test(ReadabilityMessages::DEGREES_OF_READING_POWER());
-    const auto frasePos = doc->GetReadabilityTests().get_test(ReadabilityMessages::FRASE());
     for (long i = 2 /*skip document and description column*/; i < list->GetColumnCount(); ++i)
         {
         const wxString currentTestFullName = list->GetColumnName(i);
@@ -1430,6 +1498,7 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
         auto standardTestPos = doc->GetReadabilityTests().get_test(currentTest);
         if (standardTestPos.second)
             {
+            const readability::test_key testKey = standardTestPos.first->get_test().get_key();
             scoreText +=
                 wxString::Format(
                     L"<table style='width:100%%;'><thead><tr><td style='background:%s;'>"
@@ -1441,7 +1510,7 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
 
             // note that tests with their own scales have to be
             // formatted differently than the grade-level tests
-            if (eflawPos.second && *eflawPos.first == readability::readability_test(currentTest))
+            if (testKey == readability::test_key::eflaw)
                 {
                 if (ReadabilityMessages::GetScoreValue(list->GetItemTextEx(scoreListItem, i),
                                                        score))
@@ -1457,12 +1526,9 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
                         L"</td></tr></table>";
                     }
                 }
-            else if ((fleschPos.second &&
-                      *fleschPos.first == readability::readability_test(currentTest)) ||
-                     (fjpPos.second &&
-                      *fjpPos.first == readability::readability_test(currentTest)) ||
-                     (amstadPos.second &&
-                      *amstadPos.first == readability::readability_test(currentTest)))
+            else if (testKey == readability::test_key::flesch ||
+                     testKey == readability::test_key::farr_jenkins_paterson ||
+                     testKey == readability::test_key::amstad)
                 {
                 if (ReadabilityMessages::GetScoreValue(list->GetItemTextEx(scoreListItem, i),
                                                        score))
@@ -1478,7 +1544,7 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
                         L"</td></tr></table>";
                     }
                 }
-            else if (db2Pos.second && *db2Pos.first == readability::readability_test(currentTest))
+            else if (testKey == readability::test_key::danielson_bryan_2)
                 {
                 if (ReadabilityMessages::GetScoreValue(list->GetItemTextEx(scoreListItem, i),
                                                        score))
@@ -1494,7 +1560,7 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
                         L"</td></tr></table>";
                     }
                 }
-            else if (drpPos.second && *drpPos.first == readability::readability_test(currentTest))
+            else if (testKey == readability::test_key::degrees_of_reading_power)
                 {
                 if (ReadabilityMessages::GetScoreValue(list->GetItemTextEx(scoreListItem, i),
                                                        score))
@@ -1508,8 +1574,7 @@ void BatchProjectView::UpdateStatAndTestPanes(const long scoreListItem)
                         L"</td></tr></table>";
                     }
                 }
-            else if (frasePos.second &&
-                     *frasePos.first == readability::readability_test(currentTest))
+            else if (testKey == readability::test_key::frase)
                 {
                 if (ReadabilityMessages::GetScoreValue(list->GetItemTextEx(scoreListItem, i),
                                                        score))
@@ -0,0 +1,263 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "document_scorer.h"
+#include "../Wisteria-Dataviz/src/util/memorymappedfile.h"
+#include "../app/readability_app.h"
+
+//------------------------------------------------------
+DocumentScorer::DocumentScorer() : m_settings(std::make_unique<BaseProject>())
+    {
+    m_settings->SetUIMode(false);
+    m_settings->LoadExcludePhrases();
+    UseDefaultTests();
+    }
+
+//------------------------------------------------------
+bool DocumentScorer::UseTestBundle(const wxString& bundleName)
+    {
+    const auto testBundleIter = BaseProject::m_testBundles.find(TestBundle(bundleName.wc_str()));
+    if (testBundleIter == BaseProject::m_testBundles.cend())
+        {
+        return false;
+        }
+    m_settings->ExcludeAllTests();
+    m_settings->SetTestGoals(testBundleIter->GetTestGoals());
+    m_settings->SetStatGoals(testBundleIter->GetStatGoals());
+    for (const auto& bundledTest : testBundleIter->GetTestGoals())
+        {
+        if (m_settings->GetReadabilityTests().has_test(bundledTest.GetName().c_str()))
+            {
+            m_settings->GetReadabilityTests().include_test(bundledTest.GetName().c_str(), true);
+            }
+        else if (bundledTest.GetName() !=
+                 traits::case_insensitive_wstring_ex(ReadabilityMessages::DOLCH()))
+            {
+            m_settings->AddCustomReadabilityTest(wxString{ bundledTest.GetName().c_str() });
+            }
+        }
+    return true;
+    }
+
+//------------------------------------------------------
+void DocumentScorer::UseDefaultTests()
+    {
+    if (wxGetApp().GetAppOptions().GetTestRecommendation() == TestRecommendation::UseBundle &&
+        UseTestBundle(wxGetApp().GetAppOptions().GetSelectedTestBundle()))
+        {
+        return;
+        }
+    m_settings->ExcludeAllTests();
+    for (auto& test : m_settings->GetReadabilityTests().get_tests())
+        {
+        if (test.get_test().has_language(m_settings->GetProjectLanguage()) &&
+            !IsGraphicalTest(test.get_test().get_id().c_str()))
+            {
+            test.include(true);
+            }
+        }
+    }
+
+//------------------------------------------------------
+std::vector<wxString> DocumentScorer::GetTestNames() const
+    {
+    std::vector<wxString> testNames;
+    for (const auto& test : m_settings->GetReadabilityTests().get_tests())
+        {
+        if (test.is_included() && !IsGraphicalTest(test.get_test().get_id().c_str()))
+            {
+            testNames.emplace_back(test.get_test().get_id().c_str());
+            }
+        }
+    for (const auto& customTest : m_settings->GetCustTestsInUse())
+        {
+        testNames.push_back(customTest.GetTestName());
+        }
+    return testNames;
+    }
+
+//------------------------------------------------------
+std::unique_ptr<BaseProject> DocumentScorer::CreateProject() const
+    {
+    auto project = std::make_unique<BaseProject>();
+    project->CopySettings(*m_settings);
+    project->ShareExcludePhrases(*m_settings);
+    project->SetUIMode(false);
+    // the workers already score documents concurrently
+    project->TokenizeInParallel(false);
+    return project;
+    }
+
+//------------------------------------------------------
+std::unique_ptr<ScoringEngine::Worker> DocumentScorer::CreateWorker() const
+    {
+    // a worker is just a project that is reused for every document it scores
+    class ProjectWorker final : public Worker
+        {
+      public:
+        ProjectWorker(const DocumentScorer& scorer, std::unique_ptr<BaseProject> project)
+            : m_scorer(scorer), m_project(std::move(project))
+            {
+            }
+
+        [[nodiscard]]
+        Result ScoreFile(const wxString& filePath) final
+            {
+            return m_scorer.ScoreFile(*m_project, filePath);
+            }
+
+        [[nodiscard]]
+        Result ScoreText(std::wstring text, const wxString& label) final
+            {
+            return m_scorer.ScoreText(*m_project, std::move(text), label);
+            }
+
+      private:
+        const DocumentScorer& m_scorer;
+        std::unique_ptr<BaseProject> m_project;
+        };
+
+    return std::make_unique<ProjectWorker>(*this, CreateProject());
+    }
+
+//------------------------------------------------------
+DocumentScorer::Result DocumentScorer::ScoreFile(BaseProject& project,
+                                                 const wxString& filePath) const
+    {
+    // the project is reused, so don't report (or keep piling up) the last document's messages
+    project.ClearSubProjectMessages();
+    project.SetOriginalDocumentFilePath(filePath);
+    try
+        {
+        // extract straight from the mapped file into the project's buffer
+        MemoryMappedFile sourceFile(filePath, true, true);
+        if (!project.ExtractRawText(
+                { static_cast<const char*>(sourceFile.GetStream()), sourceFile.GetMapSize() },
+                wxFileName{ filePath }.GetExt(), project.GetDocumentText()))
+            {
+            Result result;
+            result.m_path = filePath;
+            result.m_error = GetLastMessage(project);
+            return result;
+            }
+        }
+    catch (const std::exception& exp)
+        {
+        Result result;
+        result.m_path = filePath;
+        result.m_error = wxString{ exp.what() };
+        return result;
+        }
+    catch (...)
+        {
+        Result result;
+        result.m_path = filePath;
+        result.m_error = _(L"Unable to open file.");
+        return result;
+        }
+    return Analyze(project, filePath);
+    }
+
+//------------------------------------------------------
+DocumentScorer::Result DocumentScorer::ScoreText(BaseProject& project, std::wstring text,
+                                                 const wxString& label) const
+    {
+    project.ClearSubProjectMessages();
+    project.SetDocumentText(std::move(text));
+    return Analyze(project, label);
+    }
+
+//------------------------------------------------------
+DocumentScorer::Result DocumentScorer::Analyze(BaseProject& project, const wxString& path) const
+    {
+    Result result;
+    result.m_path = path;
+    // (without text, the project would try to load the document from its path)
+    if (project.GetDocumentText().empty())
+        {
+        result.m_error = _(L"No text was found in the document.");
+        return result;
+        }
+    // the text is already in the project's buffer, so it will be indexed from there
+    if (!project.LoadDocumentAsSubProject(path, project.GetDocumentText(),
+                                          project.GetMinDocWordCountForBatch()))
+        {
+        result.m_error = GetLastMessage(project);
+        return result;
+        }
+    result.m_succeeded = true;
+    result.m_words = static_cast<size_t>(project.GetTotalWords());
+    result.m_sentences = static_cast<size_t>(project.GetTotalSentences());
+
+    std::vector<wxString> includedTests;
+    for (const auto& test : project.GetReadabilityTests().get_tests())
+        {
+        if (test.is_included() && !IsGraphicalTest(test.get_test().get_id().c_str()))
+            {
+            includedTests.emplace_back(test.get_test().get_id().c_str());
+            }
+        }
+    for (const auto& testId : includedTests)
+        {
+        if (project.AddStandardReadabilityTest(testId, false))
+            {
+            TestScore score;
+            score.m_id = testId;
+            score.m_name = project.GetReadabilityTests().get_test_short_name(testId).c_str();
+            ReadabilityMessages::GetScoreValue(project.GetLastGradeLevel(), score.m_gradeLevel);
+            score.m_indexScore = project.GetLastIndexScore();
+            score.m_clozeScore = project.GetLastClozeScore();
+            result.m_scores.push_back(std::move(score));
+            }
+        }
+
+    std::vector<wxString> customTests;
+    for (const auto& customTest : project.GetCustTestsInUse())
+        {
+        customTests.push_back(customTest.GetTestName());
+        }
+    for (const auto& testName : customTests)
+        {
+        if (project.AddCustomReadabilityTest(testName, true))
+            {
+            TestScore score;
+            score.m_id = score.m_name = testName;
+            ReadabilityMessages::GetScoreValue(project.GetLastGradeLevel(), score.m_gradeLevel);
+            score.m_indexScore = project.GetLastIndexScore();
+            score.m_clozeScore = project.GetLastClozeScore();
+            result.m_scores.push_back(std::move(score));
+            }
+        }
+
+    // only the scores are needed now
+    project.DeleteUniqueWordMap();
+    project.DeleteWords();
+    project.FreeDocumentText();
+    return result;
+    }
+
+//------------------------------------------------------
+bool DocumentScorer::IsGraphicalTest(const wxString& testId)
+    {
+    return testId == ReadabilityMessages::FRY() || testId == ReadabilityMessages::GPM_FRY() ||
+           testId == ReadabilityMessages::RAYGOR() || testId == ReadabilityMessages::FRASE() ||
+           testId == ReadabilityMessages::SCHWARTZ();
+    }
+
+//------------------------------------------------------
+wxString DocumentScorer::GetLastMessage(const BaseProject& project)
+    {
+    return project.GetSubProjectMessages().empty() ?
+               wxString{ _(L"Unable to analyze the document.") } :
+               project.GetSubProjectMessages().back().GetMessage();
+    }
@@ -0,0 +1,101 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __DOCUMENT_SCORER_H__
+#define __DOCUMENT_SCORER_H__
+
+#include "base_project.h"
+#include "scoring_engine.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+
+/** @brief Scores documents outside of a project window (e.g., for a service that
+        scores files as they arrive).
+    @details The settings and tests are read from the program options once, into a template
+        project. Each document is then scored with its own (window-less) project, created from
+        that template with CreateProject() and scored with ScoreFile() or ScoreText().
+        CreateWorker() wraps such a project for the services.\n
+        Projects must be created on the main thread (their constructors read the program
+        options), but they can be scored concurrently on worker threads, as the word lists
+        and other resources that they share are only read from while scoring.
+    @note Tests that are only calculated from their graphs (e.g., Fry and Raygor) are skipped.*/
+class DocumentScorer final : public ScoringEngine
+    {
+  public:
+    /// @brief Constructor, which reads the settings from the program options.
+    /// @details The default tests are used (see UseDefaultTests()).
+    /// @warning This must be called from the main thread.
+    DocumentScorer();
+    /// @private
+    DocumentScorer(const DocumentScorer&) = delete;
+    /// @private
+    DocumentScorer& operator=(const DocumentScorer&) = delete;
+
+    /** @brief Scores documents with the tests from a test bundle.
+        @param bundleName The name of the test bundle.
+        @returns @c false if the bundle was not found, in which case the tests are unchanged.*/
+    bool UseTestBundle(const wxString& bundleName);
+    /** @brief Scores documents with the test bundle selected in the program options
+            (if the options are set to use one). Otherwise, all the standard tests
+            for the project language are used.*/
+    void UseDefaultTests();
+
+    /// @returns The IDs (or names, for custom tests) of the tests that documents are scored with.
+    [[nodiscard]]
+    std::vector<wxString> GetTestNames() const final;
+
+    /** @returns A new worker (with its own project) to score documents with.
+        @warning This must be called from the main thread.*/
+    [[nodiscard]]
+    std::unique_ptr<Worker> CreateWorker() const final;
+
+    /** @returns A new project to score a document with.
+        @warning This must be called from the main thread.*/
+    [[nodiscard]]
+    std::unique_ptr<BaseProject> CreateProject() const;
+
+    /** @brief Scores a file.
+        @details The file's text is extracted with BaseProject::ExtractRawText(), indexed,
+            and then run through the tests. Nothing is shown to the user if this fails;
+            the reason is returned in the result instead.
+        @param project The project to analyze the file with (from CreateProject()).
+        @param filePath The path of the file (must be a local file).
+        @returns The results.\n This can be called from any thread.*/
+    [[nodiscard]]
+    Result ScoreFile(BaseProject& project, const wxString& filePath) const;
+
+    /** @brief Scores a block of text.
+        @param project The project to analyze the text with (from CreateProject()).
+        @param text The text to analyze (@c project takes ownership of it).
+        @param label A label for the text (e.g., its source), included in the result.
+        @returns The results.\n This can be called from any thread.*/
+    [[nodiscard]]
+    Result ScoreText(BaseProject& project, std::wstring text, const wxString& label) const;
+
+  private:
+    /// @brief Indexes the text already in the project and runs the tests.
+    [[nodiscard]]
+    Result Analyze(BaseProject& project, const wxString& path) const;
+    /// @returns @c true if a test can only be calculated from its graph.
+    [[nodiscard]]
+    static bool IsGraphicalTest(const wxString& testId);
+    /// @returns The last message that the project logged (e.g., why it failed).
+    [[nodiscard]]
+    static wxString GetLastMessage(const BaseProject& project);
+
+    std::unique_ptr<BaseProject> m_settings;
+    };
+
+#endif //__DOCUMENT_SCORER_H__
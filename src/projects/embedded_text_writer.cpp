@@ -0,0 +1,184 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "embedded_text_writer.h"
+#include "../Wisteria-Dataviz/src/util/zipcatalog.h"
+#include "../document-helpers/duplicate_file_finder.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <thread>
+#include <wx/file.h>
+#include <wx/wfstream.h>
+
+//-------------------------------------------------------
+EmbeddedTextWriter::Fingerprint EmbeddedTextWriter::GetFingerprint(const std::wstring& text)
+    {
+    return Fingerprint{ DuplicateFileFinder::HashBytes(text.data(),
+                                                       text.length() * sizeof(wchar_t)),
+                        text.length() };
+    }
+
+//-------------------------------------------------------
+bool EmbeddedTextWriter::Write(wxZipOutputStream& zip,
+                               const std::vector<const std::wstring*>& texts,
+                               const wxString& previousFilePath,
+                               const std::vector<Fingerprint>& previousFingerprints)
+    {
+    m_cancelled = false;
+    m_failedDocument = std::numeric_limits<size_t>::max();
+    m_fingerprints.assign(texts.size(), Fingerprint{});
+
+    // catalog the entries of the project file on disk (if any can be reused)
+    std::unique_ptr<wxFFileInputStream> previousFile;
+    std::unique_ptr<wxZipInputStream> previousZip;
+    std::map<wxString, std::unique_ptr<wxZipEntry>> previousEntries;
+    std::vector<bool> hasPreviousEntry(texts.size(), false);
+    if (!previousFingerprints.empty() && !previousFilePath.empty() &&
+        wxFile::Exists(previousFilePath))
+        {
+        previousFile = std::make_unique<wxFFileInputStream>(previousFilePath);
+        if (previousFile->IsOk())
+            {
+            previousZip = std::make_unique<wxZipInputStream>(*previousFile);
+            for (std::unique_ptr<wxZipEntry> entry{ previousZip->GetNextEntry() };
+                 entry != nullptr; entry.reset(previousZip->GetNextEntry()))
+                {
+                const wxString entryName{ entry->GetName() };
+                previousEntries[entryName] = std::move(entry);
+                }
+            }
+        for (size_t i = 0; i < std::min(texts.size(), previousFingerprints.size()); ++i)
+            {
+            hasPreviousEntry[i] = (previousEntries.find(GetEntryName(i)) != previousEntries.cend());
+            }
+        }
+
+    const size_t maxChunkDocuments =
+        MAX_CHUNK_DOCUMENTS_PER_THREAD * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<std::unique_ptr<wxMemoryOutputStream>> compressedEntries;
+    size_t chunkStart{ 0 };
+    while (chunkStart < texts.size())
+        {
+        size_t chunkEnd{ chunkStart };
+        size_t chunkTextLength{ 0 };
+        while (chunkEnd < texts.size() && (chunkEnd - chunkStart) < maxChunkDocuments &&
+               (chunkEnd == chunkStart || chunkTextLength < MAX_CHUNK_TEXT_LENGTH))
+            {
+            chunkTextLength += texts[chunkEnd++]->length();
+            }
+
+        compressedEntries.clear();
+        compressedEntries.resize(chunkEnd - chunkStart);
+        if (!CompressChunk(texts, chunkStart, chunkEnd, previousFingerprints, hasPreviousEntry,
+                           compressedEntries))
+            {
+            return false;
+            }
+
+        for (size_t i = chunkStart; i < chunkEnd; ++i)
+            {
+            bool entryCopied{ false };
+            if (auto& compressedEntry = compressedEntries[i - chunkStart];
+                compressedEntry != nullptr)
+                {
+                wxMemoryInputStream entryData(*compressedEntry);
+                wxZipInputStream entryZip(entryData);
+                entryCopied = zip.CopyEntry(entryZip.GetNextEntry(), entryZip);
+                compressedEntry.reset();
+                }
+            // text is unchanged, so copy it (without recompressing) from the previous file
+            else if (auto previousEntry = previousEntries.find(GetEntryName(i));
+                     previousEntry != previousEntries.end())
+                {
+                entryCopied = zip.CopyEntry(previousEntry->second.release(), *previousZip);
+                }
+
+            if (!entryCopied)
+                {
+                m_failedDocument = i;
+                return false;
+                }
+            ReportProgress(i + 1, texts.size());
+            if (m_cancelled)
+                {
+                return false;
+                }
+            }
+        chunkStart = chunkEnd;
+        }
+    return true;
+    }
+
+//-------------------------------------------------------
+bool EmbeddedTextWriter::CompressChunk(
+    const std::vector<const std::wstring*>& texts, const size_t chunkStart, const size_t chunkEnd,
+    const std::vector<Fingerprint>& previousFingerprints, const std::vector<bool>& hasPreviousEntry,
+    std::vector<std::unique_ptr<wxMemoryOutputStream>>& compressedEntries)
+    {
+    std::atomic<size_t> nextDocument{ chunkStart };
+    std::atomic<size_t> processedCount{ 0 };
+    const auto compressEntries = [&]()
+    {
+        for (size_t i = nextDocument++; i < chunkEnd && !m_cancelled; i = nextDocument++)
+            {
+            m_fingerprints[i] = GetFingerprint(*texts[i]);
+            if (!hasPreviousEntry[i] || !(previousFingerprints[i] == m_fingerprints[i]))
+                {
+                auto& compressedEntry = compressedEntries[i - chunkStart];
+                compressedEntry = std::make_unique<wxMemoryOutputStream>();
+                wxZipOutputStream entryZip(*compressedEntry, m_compressionLevel);
+                /* Use buffered output stream, NOT text output stream. Text output buffer
+                   messes around with the newlines in the text, whereas buffer streams
+                   preserve the text.*/
+                Wisteria::ZipCatalog::WriteText(entryZip, GetEntryName(i), *texts[i]);
+                entryZip.Close();
+                }
+            ++processedCount;
+            }
+    };
+
+    const size_t workerCount = std::clamp<size_t>(
+        chunkEnd - chunkStart, 1, std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    std::vector<std::future<void>> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        {
+        workers.push_back(std::async(std::launch::async, compressEntries));
+        }
+    // this thread only reports progress (e.g., to a progress dialog),
+    // so that the UI stays responsive while the workers compress the text
+    for (auto& worker : workers)
+        {
+        while (worker.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+            {
+            ReportProgress(chunkStart + processedCount, texts.size());
+            }
+        }
+    // rethrows anything thrown by the workers
+    for (auto& worker : workers)
+        {
+        worker.get();
+        }
+    return !m_cancelled;
+    }
+
+//-------------------------------------------------------
+void EmbeddedTextWriter::ReportProgress(const size_t processed, const size_t total)
+    {
+    if (m_progressCallback && !m_cancelled && !m_progressCallback(processed, total))
+        {
+        m_cancelled = true;
+        }
+    }
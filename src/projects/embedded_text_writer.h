@@ -0,0 +1,149 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __EMBEDDED_TEXT_WRITER_H__
+#define __EMBEDDED_TEXT_WRITER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/mstream.h>
+#include <wx/string.h>
+#include <wx/zipstrm.h>
+
+/** @brief Writes the embedded text of a batch project's documents
+        (<tt>Content<n>.txt</tt>) into its project file.
+    @details Documents whose text is unchanged since the project file was last loaded or
+        saved are copied, still compressed, from that file. The rest are compressed
+        in parallel.\n
+        Documents are compressed a chunk at a time, and each chunk is written out before the
+        next one is started. That way, only one chunk's compressed text is held in memory
+        (rather than the whole project's), and progress can be reported (and the save
+        cancelled) while the documents are being compressed.*/
+class EmbeddedTextWriter
+    {
+  public:
+    /// @brief Identifies the text of a document, to tell whether it changed since it
+    ///     was saved.
+    struct Fingerprint
+        {
+        /// @brief The 64-bit (XXH64) hash of the text.
+        uint64_t m_hash{ 0 };
+        /// @brief The length of the text. This is compared along with the hash, so that
+        ///     a hash collision between texts of different lengths is not taken as a match.
+        size_t m_length{ 0 };
+
+        /// @private
+        [[nodiscard]]
+        bool operator==(const Fingerprint& that) const noexcept
+            {
+            return m_hash == that.m_hash && m_length == that.m_length;
+            }
+        };
+
+    /** @brief Callback for reporting progress.
+        @details This is called from the thread that called Write(), periodically while
+            the documents are compressed and after each one is written.\n
+            The parameters are the number of documents processed so far and the
+            number of documents. Return @c false to cancel.*/
+    using ProgressCallback = std::function<bool(const size_t processed, const size_t total)>;
+
+    /// @brief Constructor.
+    /// @param compressionLevel The zip compression level (see wxZipOutputStream).
+    explicit EmbeddedTextWriter(const int compressionLevel) noexcept
+        : m_compressionLevel(compressionLevel)
+        {
+        }
+
+    /** @brief Sets the function to report progress (and check for cancellation) with.
+        @param callback The progress callback.*/
+    void SetProgressCallback(ProgressCallback callback)
+        {
+        m_progressCallback = std::move(callback);
+        }
+
+    /** @brief Writes the documents' text.
+        @param zip The project file being written.
+        @param texts The documents' text, in order.
+        @param previousFilePath The path of the project file as it was last loaded or saved
+            (empty if there is not one).
+        @param previousFingerprints The fingerprints of the documents' text in that file.
+        @returns @c false if cancelled or an entry could not be written
+            (see WasCancelled() and GetFailedDocument()).*/
+    bool Write(wxZipOutputStream& zip, const std::vector<const std::wstring*>& texts,
+               const wxString& previousFilePath,
+               const std::vector<Fingerprint>& previousFingerprints);
+
+    /// @returns The fingerprints of the text written by the last call to Write().
+    [[nodiscard]]
+    const std::vector<Fingerprint>& GetFingerprints() const noexcept
+        {
+        return m_fingerprints;
+        }
+
+    /// @returns @c true if the last write was cancelled from the progress callback.
+    [[nodiscard]]
+    bool WasCancelled() const noexcept
+        {
+        return m_cancelled;
+        }
+
+    /// @returns The index of the document that could not be written during the last write,
+    ///     or @c std::numeric_limits<size_t>::max() if none.
+    [[nodiscard]]
+    size_t GetFailedDocument() const noexcept
+        {
+        return m_failedDocument;
+        }
+
+    /** @returns The fingerprint of a document's text.
+        @param text The text.*/
+    [[nodiscard]]
+    static Fingerprint GetFingerprint(const std::wstring& text);
+
+    /** @returns The name of a document's entry in the project file.
+        @param index The index of the document.*/
+    [[nodiscard]]
+    static wxString GetEntryName(const size_t index)
+        {
+        return wxString::Format(L"Content%zu.txt", index);
+        }
+
+    /// @brief The most text (in characters) to compress before writing it out.
+    /// @note A chunk always has at least one document, however large.
+    constexpr static size_t MAX_CHUNK_TEXT_LENGTH{ 32 * 1024 * 1024 };
+    /// @brief The most documents (per thread) to compress before writing them out.
+    constexpr static size_t MAX_CHUNK_DOCUMENTS_PER_THREAD{ 8 };
+
+  private:
+    /** @brief Fingerprints the documents in [chunkStart, chunkEnd) and compresses the ones
+            that can't be copied from the previous project file, in parallel.
+        @returns @c false if cancelled.*/
+    bool CompressChunk(const std::vector<const std::wstring*>& texts, const size_t chunkStart,
+                       const size_t chunkEnd, const std::vector<Fingerprint>& previousFingerprints,
+                       const std::vector<bool>& hasPreviousEntry,
+                       std::vector<std::unique_ptr<wxMemoryOutputStream>>& compressedEntries);
+    void ReportProgress(const size_t processed, const size_t total);
+
+    int m_compressionLevel{ -1 };
+    ProgressCallback m_progressCallback;
+    std::vector<Fingerprint> m_fingerprints;
+    std::atomic<bool> m_cancelled{ false };
+    size_t m_failedDocument{ std::numeric_limits<size_t>::max() };
+    };
+
+#endif //__EMBEDDED_TEXT_WRITER_H__
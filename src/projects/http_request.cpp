@@ -0,0 +1,266 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "http_request.h"
+#include <algorithm>
+#include <cctype>
+
+namespace
+    {
+    //------------------------------------------------------
+    std::string_view TrimWhitespace(std::string_view text)
+        {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+            {
+            text.remove_prefix(1);
+            }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+            {
+            text.remove_suffix(1);
+            }
+        return text;
+        }
+
+    //------------------------------------------------------
+    std::string ToLower(std::string_view text)
+        {
+        std::string lowered{ text };
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                       [](const unsigned char ch) { return std::tolower(ch); });
+        return lowered;
+        }
+
+    //------------------------------------------------------
+    int HexValue(const char ch) noexcept
+        {
+        if (ch >= '0' && ch <= '9')
+            {
+            return ch - '0';
+            }
+        if (ch >= 'a' && ch <= 'f')
+            {
+            return ch - 'a' + 10;
+            }
+        if (ch >= 'A' && ch <= 'F')
+            {
+            return ch - 'A' + 10;
+            }
+        return -1;
+        }
+    } // namespace
+
+//------------------------------------------------------
+void HttpRequest::Reset()
+    {
+    m_method.clear();
+    m_path.clear();
+    m_query.clear();
+    m_headers.clear();
+    m_body.clear();
+    m_requestSize = 0;
+    m_keepAlive = false;
+    }
+
+//------------------------------------------------------
+HttpRequest::ParseResult HttpRequest::Parse(std::string_view buffer, const size_t maxBodySize)
+    {
+    Reset();
+
+    const size_t headerEnd = buffer.find("\r\n\r\n");
+    if (headerEnd == std::string_view::npos)
+        {
+        return (buffer.length() > MAX_HEADER_SIZE) ? ParseResult::TooLarge :
+                                                     ParseResult::Incomplete;
+        }
+    if (headerEnd > MAX_HEADER_SIZE)
+        {
+        return ParseResult::TooLarge;
+        }
+
+    // request line (e.g., "POST /score?label=abc HTTP/1.1")
+    std::string_view headers = buffer.substr(0, headerEnd + 2);
+    size_t lineEnd = headers.find("\r\n");
+    const std::string_view requestLine = headers.substr(0, lineEnd);
+    headers.remove_prefix(lineEnd + 2);
+    const size_t methodEnd = requestLine.find(' ');
+    const size_t targetEnd = requestLine.rfind(' ');
+    if (methodEnd == std::string_view::npos || methodEnd == 0 || targetEnd <= methodEnd + 1)
+        {
+        return ParseResult::Invalid;
+        }
+    const std::string_view version = requestLine.substr(targetEnd + 1);
+    if (version.substr(0, 7) != "HTTP/1.")
+        {
+        return ParseResult::Invalid;
+        }
+    m_method = requestLine.substr(0, methodEnd);
+    const std::string_view target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    if (target.front() != '/')
+        {
+        return ParseResult::Invalid;
+        }
+
+    const size_t queryStart = target.find('?');
+    m_path = DecodeUrl(target.substr(0, queryStart), false);
+    if (queryStart != std::string_view::npos)
+        {
+        std::string_view query = target.substr(queryStart + 1);
+        while (!query.empty())
+            {
+            const size_t paramEnd = query.find('&');
+            const std::string_view param = query.substr(0, paramEnd);
+            const size_t equals = param.find('=');
+            if (!param.empty())
+                {
+                m_query[DecodeUrl(param.substr(0, equals), true)] =
+                    (equals == std::string_view::npos) ?
+                        std::string{} :
+                        DecodeUrl(param.substr(equals + 1), true);
+                }
+            query.remove_prefix((paramEnd == std::string_view::npos) ? query.length() :
+                                                                       paramEnd + 1);
+            }
+        }
+
+    // headers
+    while (!headers.empty())
+        {
+        lineEnd = headers.find("\r\n");
+        const std::string_view line = headers.substr(0, lineEnd);
+        headers.remove_prefix(lineEnd + 2);
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0)
+            {
+            return ParseResult::Invalid;
+            }
+        m_headers[ToLower(TrimWhitespace(line.substr(0, colon)))] =
+            TrimWhitespace(line.substr(colon + 1));
+        }
+
+    // HTTP/1.1 keeps the connection open unless told not to; 1.0 is the other way around
+    const auto connection = GetHeader("connection");
+    m_keepAlive = (version == "HTTP/1.1") ?
+                      !(connection && ToLower(*connection) == "close") :
+                      (connection && ToLower(*connection) == "keep-alive");
+
+    if (GetHeader("transfer-encoding"))
+        {
+        return ParseResult::Invalid;
+        }
+    size_t bodySize{ 0 };
+    if (const auto contentLength = GetHeader("content-length"))
+        {
+        if (contentLength->empty() || contentLength->length() > 18 ||
+            !std::all_of(contentLength->cbegin(), contentLength->cend(),
+                         [](const unsigned char ch) { return std::isdigit(ch); }))
+            {
+            return ParseResult::Invalid;
+            }
+        bodySize = std::stoull(*contentLength);
+        }
+    if (bodySize > maxBodySize)
+        {
+        return ParseResult::TooLarge;
+        }
+
+    const size_t bodyStart = headerEnd + 4;
+    if (buffer.length() - bodyStart < bodySize)
+        {
+        return ParseResult::Incomplete;
+        }
+    m_body = buffer.substr(bodyStart, bodySize);
+    m_requestSize = bodyStart + bodySize;
+    return ParseResult::Complete;
+    }
+
+//------------------------------------------------------
+std::optional<std::string> HttpRequest::GetQueryValue(const std::string& name) const
+    {
+    const auto pos = m_query.find(name);
+    return (pos != m_query.cend()) ? std::optional<std::string>{ pos->second } : std::nullopt;
+    }
+
+//------------------------------------------------------
+std::optional<std::string> HttpRequest::GetHeader(const std::string& name) const
+    {
+    const auto pos = m_headers.find(name);
+    return (pos != m_headers.cend()) ? std::optional<std::string>{ pos->second } : std::nullopt;
+    }
+
+//------------------------------------------------------
+std::string HttpRequest::DecodeUrl(std::string_view text, const bool plusIsSpace)
+    {
+    std::string decoded;
+    decoded.reserve(text.length());
+    for (size_t i = 0; i < text.length(); ++i)
+        {
+        if (text[i] == '%' && i + 2 < text.length() && HexValue(text[i + 1]) >= 0 &&
+            HexValue(text[i + 2]) >= 0)
+            {
+            decoded += static_cast<char>((HexValue(text[i + 1]) << 4) | HexValue(text[i + 2]));
+            i += 2;
+            }
+        else if (text[i] == '+' && plusIsSpace)
+            {
+            decoded += ' ';
+            }
+        else
+            {
+            decoded += text[i];
+            }
+        }
+    return decoded;
+    }
+
+//------------------------------------------------------
+std::string HttpRequest::FormatResponse(const int statusCode, std::string_view contentType,
+                                        std::string_view body, const bool keepAlive)
+    {
+    std::string response{ "HTTP/1.1 " };
+    response += std::to_string(statusCode);
+    response += ' ';
+    response += GetReasonPhrase(statusCode);
+    response += "\r\nContent-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: ";
+    response += std::to_string(body.length());
+    response += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+    }
+
+//------------------------------------------------------
+std::string_view HttpRequest::GetReasonPhrase(const int statusCode) noexcept
+    {
+    switch (statusCode)
+        {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 413:
+        return "Content Too Large";
+    case 422:
+        return "Unprocessable Content";
+    case 500:
+        return "Internal Server Error";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Unknown";
+        }
+    }
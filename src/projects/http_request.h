@@ -0,0 +1,133 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __HTTP_REQUEST_H__
+#define __HTTP_REQUEST_H__
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/** @brief A minimal HTTP/1.x request parser (and response writer), for local services.
+    @details Requests are parsed from a buffer of bytes read from a connection. Because a
+        connection can send several requests in a row (keep-alive and pipelining),
+        GetRequestSize() reports how much of the buffer the request used, so that the
+        caller can remove it and parse the next one.\n
+        Only requests with a @c Content-Length (or no body) are supported;
+        chunked requests are reported as invalid.
+    @note This is meant for a service bound to the loopback interface, not for serving
+        the open internet.*/
+class HttpRequest
+    {
+  public:
+    /// @brief The result of parsing a buffer.
+    enum class ParseResult
+        {
+        /// @brief The buffer does not have the full request yet.
+        Incomplete,
+        /// @brief A request was read.
+        Complete,
+        /// @brief The buffer is not a (supported) HTTP request.
+        Invalid,
+        /// @brief The request's headers or body are larger than allowed.
+        TooLarge
+        };
+
+    /** @brief Parses a request from the start of a buffer.
+        @param buffer The bytes read from the connection.
+        @param maxBodySize The largest body allowed.
+        @returns Whether a full request was read.*/
+    ParseResult Parse(std::string_view buffer, const size_t maxBodySize);
+
+    /// @returns The method (e.g., @c GET or @c POST).
+    [[nodiscard]]
+    const std::string& GetMethod() const noexcept
+        {
+        return m_method;
+        }
+
+    /// @returns The (decoded) path of the request, without its query.
+    [[nodiscard]]
+    const std::string& GetPath() const noexcept
+        {
+        return m_path;
+        }
+
+    /// @returns The (decoded) value of a query parameter, if present.
+    /// @param name The name of the parameter.
+    [[nodiscard]]
+    std::optional<std::string> GetQueryValue(const std::string& name) const;
+
+    /// @returns The value of a header, if present.
+    /// @param name The name of the header (in lowercase).
+    [[nodiscard]]
+    std::optional<std::string> GetHeader(const std::string& name) const;
+
+    /// @returns The request's body.
+    [[nodiscard]]
+    const std::string& GetBody() const noexcept
+        {
+        return m_body;
+        }
+
+    /// @returns The number of bytes (from the start of the buffer) that the request used.
+    [[nodiscard]]
+    size_t GetRequestSize() const noexcept
+        {
+        return m_requestSize;
+        }
+
+    /// @returns @c true if the client wants to keep the connection open after the response.
+    [[nodiscard]]
+    bool IsKeepAlive() const noexcept
+        {
+        return m_keepAlive;
+        }
+
+    /** @brief Decodes a percent-encoded string.
+        @param text The text to decode.
+        @param plusIsSpace Whether '+' is decoded as a space (as it is in queries).
+        @returns The decoded text.*/
+    [[nodiscard]]
+    static std::string DecodeUrl(std::string_view text, const bool plusIsSpace);
+
+    /** @brief Writes a response.
+        @param statusCode The HTTP status code.
+        @param contentType The type of the body (e.g., @c application/json).
+        @param body The body.
+        @param keepAlive Whether the connection will be kept open.
+        @returns The response, ready to be sent.*/
+    [[nodiscard]]
+    static std::string FormatResponse(const int statusCode, std::string_view contentType,
+                                      std::string_view body, const bool keepAlive);
+
+    /// @brief The largest request line and headers allowed.
+    constexpr static size_t MAX_HEADER_SIZE{ 64 * 1024 };
+
+  private:
+    [[nodiscard]]
+    static std::string_view GetReasonPhrase(const int statusCode) noexcept;
+    void Reset();
+
+    std::string m_method;
+    std::string m_path;
+    std::map<std::string, std::string, std::less<>> m_query;
+    std::map<std::string, std::string, std::less<>> m_headers;
+    std::string m_body;
+    size_t m_requestSize{ 0 };
+    bool m_keepAlive{ false };
+    };
+
+#endif //__HTTP_REQUEST_H__
@@ -0,0 +1,66 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __JSON_STRING_H__
+#define __JSON_STRING_H__
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+/** @brief Writes text as a (quoted and escaped) JSON string.
+    @details This is what ScoringEngine::AppendJsonString() writes with; it is kept
+        free of wxWidgets so that lower-level code (e.g., the pipeline stats) can share it.
+    @param[in,out] json The string to append to.
+    @param utf8Text The text to write (already encoded as UTF-8).*/
+inline void AppendJsonString(std::string& json, const std::string_view utf8Text)
+    {
+    json += '"';
+    for (const char ch : utf8Text)
+        {
+        switch (ch)
+            {
+        case '"':
+            json += "\\\"";
+            break;
+        case '\\':
+            json += "\\\\";
+            break;
+        case '\n':
+            json += "\\n";
+            break;
+        case '\r':
+            json += "\\r";
+            break;
+        case '\t':
+            json += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                std::array<char, 8> escaped{};
+                std::snprintf(escaped.data(), escaped.size(), "\\u%04x",
+                              static_cast<unsigned int>(ch));
+                json += escaped.data();
+                }
+            else
+                {
+                json += ch;
+                }
+            }
+        }
+    json += '"';
+    }
+
+#endif //__JSON_STRING_H__
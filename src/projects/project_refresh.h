@@ -49,6 +49,23 @@ class ProjectRefresh
             }
         }
 
+    /** @brief Requests that the document(s) be reloaded if an analysis pass that is
+            needed now was skipped when they were last indexed.
+        @param requiredPasses The passes (as bit flags) that are needed now.
+        @param loadedPasses The passes that were run when the document was last indexed.
+        @returns @c true if reindexing was requested.*/
+    template<typename PassFlagsT>
+    bool RefreshRequiredForMissingPasses(const PassFlagsT& requiredPasses,
+                                         const PassFlagsT& loadedPasses) noexcept
+        {
+        if ((requiredPasses & ~loadedPasses).any())
+            {
+            RefreshRequired(FullReindexing);
+            return true;
+            }
+        return false;
+        }
+
     /// @brief Resets the state.
     void ResetRefreshRequired() noexcept { m_refreshNeeded = NoRefresh; }
 
@@ -0,0 +1,168 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "scoring_engine.h"
+#include "json_string.h"
+#include <array>
+#include <cmath>
+#include <cstdio>
+
+//------------------------------------------------------
+void ScoringEngine::AppendJson(std::string& json, const Result& result)
+    {
+    json += "{\"path\":";
+    AppendJsonString(json, result.m_path);
+    json += ",\"succeeded\":";
+    json += result.m_succeeded ? "true" : "false";
+    if (!result.m_succeeded)
+        {
+        json += ",\"error\":";
+        AppendJsonString(json, result.m_error);
+        json += '}';
+        return;
+        }
+    json += ",\"words\":" + std::to_string(result.m_words) +
+            ",\"sentences\":" + std::to_string(result.m_sentences) + ",\"scores\":[";
+    for (size_t i = 0; i < result.m_scores.size(); ++i)
+        {
+        if (i > 0)
+            {
+            json += ',';
+            }
+        const auto& score = result.m_scores[i];
+        json += "{\"id\":";
+        AppendJsonString(json, score.m_id);
+        json += ",\"name\":";
+        AppendJsonString(json, score.m_name);
+        json += ",\"grade-level\":";
+        AppendJsonNumber(json, score.m_gradeLevel);
+        json += ",\"index\":";
+        AppendJsonNumber(json, score.m_indexScore);
+        json += ",\"cloze\":";
+        AppendJsonNumber(json, score.m_clozeScore);
+        json += '}';
+        }
+    json += "]}";
+    }
+
+//------------------------------------------------------
+void ScoringEngine::AppendJsonString(std::string& json, const wxString& text)
+    {
+    ::AppendJsonString(json, text.utf8_string());
+    }
+
+//------------------------------------------------------
+void ScoringEngine::AppendJsonNumber(std::string& json, const double value)
+    {
+    if (!std::isfinite(value))
+        {
+        json += "null";
+        return;
+        }
+    std::array<char, 32> number{};
+    std::snprintf(number.data(), number.size(), "%.6g", value);
+    json += number.data();
+    }
+
+//------------------------------------------------------
+bool ScoringEngine::ReadJsonString(const std::string& json, size_t& pos, wxString& value)
+    {
+    if (pos >= json.length() || json[pos] != '"')
+        {
+        return false;
+        }
+    std::string utf8;
+    for (size_t current = pos + 1; current < json.length(); ++current)
+        {
+        if (json[current] == '"')
+            {
+            pos = current + 1;
+            value = wxString::FromUTF8(utf8);
+            return true;
+            }
+        if (json[current] != '\\')
+            {
+            utf8 += json[current];
+            continue;
+            }
+        if (++current >= json.length())
+            {
+            return false;
+            }
+        switch (json[current])
+            {
+        case 'n':
+            utf8 += '\n';
+            break;
+        case 'r':
+            utf8 += '\r';
+            break;
+        case 't':
+            utf8 += '\t';
+            break;
+        case 'u':
+            {
+            // only control characters are written this way
+            if (current + 4 >= json.length())
+                {
+                return false;
+                }
+            unsigned int codePoint{ 0 };
+            for (size_t i = 1; i <= 4; ++i)
+                {
+                const char digit = json[current + i];
+                codePoint <<= 4;
+                if (digit >= '0' && digit <= '9')
+                    {
+                    codePoint |= static_cast<unsigned int>(digit - '0');
+                    }
+                else if (digit >= 'a' && digit <= 'f')
+                    {
+                    codePoint |= static_cast<unsigned int>(digit - 'a' + 10);
+                    }
+                else if (digit >= 'A' && digit <= 'F')
+                    {
+                    codePoint |= static_cast<unsigned int>(digit - 'A' + 10);
+                    }
+                else
+                    {
+                    return false;
+                    }
+                }
+            if (codePoint >= 0x20)
+                {
+                return false;
+                }
+            utf8 += static_cast<char>(codePoint);
+            current += 4;
+            break;
+            }
+        default:
+            utf8 += json[current];
+            }
+        }
+    return false;
+    }
+
+//------------------------------------------------------
+bool ScoringEngine::ReadJsonInteger(const std::string& json, size_t& pos, long long& value)
+    {
+    const size_t start{ pos };
+    value = 0;
+    while (pos < json.length() && json[pos] >= '0' && json[pos] <= '9')
+        {
+        value = (value * 10) + (json[pos] - '0');
+        ++pos;
+        }
+    return pos > start;
+    }
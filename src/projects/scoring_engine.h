@@ -0,0 +1,128 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __SCORING_ENGINE_H__
+#define __SCORING_ENGINE_H__
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/string.h>
+
+/** @brief Interface for scoring documents on a service's worker threads
+        (see WatchFolderService and ScoringServer).
+    @details The results, and how they are written to (and read back from) JSON, are
+        defined here as well, so that the services do not depend on how documents
+        are analyzed. DocumentScorer is the implementation that the program uses.*/
+class ScoringEngine
+    {
+  public:
+    /// @brief The result of a test.
+    struct TestScore
+        {
+        /// @brief The test's ID.
+        wxString m_id;
+        /// @brief The test's (short) name.
+        wxString m_name;
+        /// @brief The grade level (NaN if not a grade-level test).
+        double m_gradeLevel{ std::numeric_limits<double>::quiet_NaN() };
+        /// @brief The index score (NaN if not an index test).
+        double m_indexScore{ std::numeric_limits<double>::quiet_NaN() };
+        /// @brief The predicted cloze score (NaN if not a cloze test).
+        double m_clozeScore{ std::numeric_limits<double>::quiet_NaN() };
+        };
+
+    /// @brief The results of scoring a document.
+    struct Result
+        {
+        /// @brief The document's path (or label, if scoring text).
+        wxString m_path;
+        /// @brief Whether the document was loaded and analyzed.
+        bool m_succeeded{ false };
+        /// @brief Why the document could not be scored.
+        wxString m_error;
+        /// @brief The number of words.
+        size_t m_words{ 0 };
+        /// @brief The number of sentences.
+        size_t m_sentences{ 0 };
+        /// @brief The results of the tests that could be calculated.
+        std::vector<TestScore> m_scores;
+        };
+
+    /// @brief Scores documents for one worker thread, one at a time.
+    class Worker
+        {
+      public:
+        /// @private
+        virtual ~Worker() = default;
+        /** @brief Scores a file.
+            @param filePath The path of the file (must be a local file).
+            @returns The results.*/
+        [[nodiscard]]
+        virtual Result ScoreFile(const wxString& filePath) = 0;
+        /** @brief Scores a block of text.
+            @param text The text to analyze.
+            @param label A label for the text (e.g., its source), included in the result.
+            @returns The results.*/
+        [[nodiscard]]
+        virtual Result ScoreText(std::wstring text, const wxString& label) = 0;
+        };
+
+    /// @private
+    ScoringEngine() = default;
+    /// @private
+    ScoringEngine(const ScoringEngine&) = delete;
+    /// @private
+    ScoringEngine& operator=(const ScoringEngine&) = delete;
+    /// @private
+    virtual ~ScoringEngine() = default;
+
+    /** @returns A new worker, which can then be used from another thread.
+        @warning This must be called from the main thread.*/
+    [[nodiscard]]
+    virtual std::unique_ptr<Worker> CreateWorker() const = 0;
+
+    /// @returns The IDs (or names, for custom tests) of the tests that documents are scored with.
+    [[nodiscard]]
+    virtual std::vector<wxString> GetTestNames() const = 0;
+
+    /** @brief Writes a result as a JSON object.
+        @param[in,out] json The string to append the object to.
+        @param result The result to write.*/
+    static void AppendJson(std::string& json, const Result& result);
+    /** @brief Writes a string as a (quoted and escaped) JSON string.
+        @param[in,out] json The string to append to.
+        @param text The text to write (as UTF-8).*/
+    static void AppendJsonString(std::string& json, const wxString& text);
+    /** @brief Writes a number as a JSON number (or @c null if NaN).
+        @param[in,out] json The string to append to.
+        @param value The value to write.*/
+    static void AppendJsonNumber(std::string& json, const double value);
+
+    /** @brief Reads a JSON string (as written by AppendJsonString()).
+        @param json The JSON to read from.
+        @param[in,out] pos The position of the string's opening quote. On success,
+            this is moved past the closing quote.
+        @param[out] value The (unescaped) string.
+        @returns @c false if there is not a (complete) string at @c pos.*/
+    static bool ReadJsonString(const std::string& json, size_t& pos, wxString& value);
+    /** @brief Reads a (non-negative) JSON integer.
+        @param json The JSON to read from.
+        @param[in,out] pos The position of the number. On success, this is moved past it.
+        @param[out] value The number.
+        @returns @c false if there is not a number at @c pos.*/
+    static bool ReadJsonInteger(const std::string& json, size_t& pos, long long& value);
+    };
+
+#endif //__SCORING_ENGINE_H__
@@ -0,0 +1,372 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "scoring_server.h"
+#include <algorithm>
+#include <cassert>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/time.h>
+
+//------------------------------------------------------
+ScoringServer::ScoringServer(const unsigned short port, const size_t workerCount,
+                             std::unique_ptr<ScoringEngine> scorer,
+                             const size_t maxQueuedConnections)
+    : m_port(port),
+      m_workerCount(workerCount > 0 ? workerCount :
+                                      std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+      m_scorer(std::move(scorer)), m_maxQueuedConnections(maxQueuedConnections)
+    {
+    assert(m_scorer && L"A scorer is required!");
+    Bind(wxEVT_SOCKET, &ScoringServer::OnServerEvent, this);
+    }
+
+//------------------------------------------------------
+bool ScoringServer::Start(wxString& errorMessage)
+    {
+    // allows sockets to be used from the workers
+    wxSocketBase::Initialize();
+
+    wxIPV4address address;
+    address.LocalHost();
+    address.Service(m_port);
+    m_server = new wxSocketServer(address, wxSOCKET_REUSEADDR);
+    if (!m_server->IsOk())
+        {
+        m_server->Destroy();
+        m_server = nullptr;
+        errorMessage = wxString::Format(_(L"Unable to listen for requests on port %u."),
+                                        static_cast<unsigned int>(m_port));
+        return false;
+        }
+    if (m_server->GetLocal(address))
+        {
+        m_port = address.Service();
+        }
+    m_server->SetEventHandler(*this);
+    m_server->SetNotify(wxSOCKET_CONNECTION_FLAG);
+    m_server->Notify(true);
+
+    m_testsJson = "{\"tests\":[";
+    const auto testNames = m_scorer->GetTestNames();
+    for (size_t i = 0; i < testNames.size(); ++i)
+        {
+        if (i > 0)
+            {
+            m_testsJson += ',';
+            }
+        ScoringEngine::AppendJsonString(m_testsJson, testNames[i]);
+        }
+    m_testsJson += "]}";
+
+    m_stopping = false;
+    for (size_t i = 0; i < m_workerCount; ++i)
+        {
+        m_scoringWorkers.push_back(m_scorer->CreateWorker());
+        m_workers.emplace_back([this, worker = m_scoringWorkers.back().get()]()
+                               { RunWorker(*worker); });
+        }
+
+    wxLogMessage(L"Listening for scoring requests on http://127.0.0.1:%u (%zu workers).",
+                 static_cast<unsigned int>(m_port), m_workerCount);
+    return true;
+    }
+
+//------------------------------------------------------
+void ScoringServer::Stop()
+    {
+    if (m_server != nullptr)
+        {
+        m_server->Notify(false);
+        m_server->Destroy();
+        m_server = nullptr;
+        }
+
+        {
+        const std::lock_guard lock(m_connectionsMutex);
+        m_stopping = true;
+        }
+    m_connectionsCondition.notify_all();
+    for (auto& worker : m_workers)
+        {
+        worker.join();
+        }
+    m_workers.clear();
+    m_scoringWorkers.clear();
+
+    for (auto& connection : m_connections)
+        {
+        connection->m_socket->Destroy();
+        }
+    m_connections.clear();
+    DestroyClosedSockets();
+    }
+
+//------------------------------------------------------
+void ScoringServer::OnServerEvent(wxSocketEvent& event)
+    {
+    if (event.GetSocketEvent() != wxSOCKET_CONNECTION || m_server == nullptr)
+        {
+        return;
+        }
+
+    while (wxSocketBase* socket = m_server->Accept(false))
+        {
+        // blocking, so that the workers can read and write without an event loop
+        socket->SetFlags(wxSOCKET_BLOCK);
+        socket->SetTimeout(IDLE_TIMEOUT);
+        socket->Notify(false);
+
+            {
+            const std::lock_guard lock(m_connectionsMutex);
+            if (m_connections.size() < m_maxQueuedConnections)
+                {
+                auto connection = std::make_unique<Connection>();
+                connection->m_socket = socket;
+                connection->m_lastActive = wxGetLocalTimeMillis();
+                m_connections.push_back(std::move(connection));
+                socket = nullptr;
+                }
+            }
+        if (socket == nullptr)
+            {
+            m_connectionsCondition.notify_one();
+            }
+        // too far behind, so turn the client away rather than letting the backlog grow
+        else
+            {
+            SendResponse(*socket, 503, FormatError(_(L"The server is busy.")), false);
+            socket->Destroy();
+            }
+        }
+    }
+
+//------------------------------------------------------
+void ScoringServer::RunWorker(ScoringEngine::Worker& worker)
+    {
+    std::vector<char> readBuffer(64 * 1024);
+    while (true)
+        {
+        std::unique_ptr<Connection> connection;
+            {
+            std::unique_lock lock(m_connectionsMutex);
+            m_connectionsCondition.wait(lock,
+                                        [this]() { return m_stopping || !m_connections.empty(); });
+            if (m_stopping)
+                {
+                return;
+                }
+            connection = std::move(m_connections.front());
+            m_connections.pop_front();
+            }
+
+        if (ServeConnection(*connection, worker, readBuffer))
+            {
+            // wait for the client's next request at the back of the queue,
+            // rather than holding up the other connections
+            const std::lock_guard lock(m_connectionsMutex);
+            m_connections.push_back(std::move(connection));
+            }
+        else
+            {
+            CloseConnection(std::move(connection));
+            }
+        }
+    }
+
+//------------------------------------------------------
+bool ScoringServer::ServeConnection(Connection& connection, ScoringEngine::Worker& worker,
+                                    std::vector<char>& readBuffer)
+    {
+    wxSocketBase& socket = *connection.m_socket;
+    HttpRequest request;
+    while (!m_stopping)
+        {
+        const auto parseResult = request.Parse(connection.m_buffer, MAX_BODY_SIZE);
+        if (parseResult == HttpRequest::ParseResult::Incomplete)
+            {
+            bool othersWaiting{ false };
+                {
+                const std::lock_guard lock(m_connectionsMutex);
+                othersWaiting = !m_connections.empty();
+                }
+            // nothing more yet, so keep the connection until it has been idle too long
+            if (!socket.WaitForRead(0, othersWaiting ? 1 : READ_WAIT))
+                {
+                return (wxGetLocalTimeMillis() - connection.m_lastActive) < IDLE_TIMEOUT * 1000;
+                }
+            socket.Read(readBuffer.data(), readBuffer.size());
+            // the client closed the connection
+            if (socket.Error() || socket.LastReadCount() == 0)
+                {
+                return false;
+                }
+            connection.m_buffer.append(readBuffer.data(), socket.LastReadCount());
+            connection.m_lastActive = wxGetLocalTimeMillis();
+            continue;
+            }
+        if (parseResult == HttpRequest::ParseResult::TooLarge)
+            {
+            SendResponse(socket, 413, FormatError(_(L"The request is too large.")), false);
+            return false;
+            }
+        if (parseResult == HttpRequest::ParseResult::Invalid)
+            {
+            SendResponse(socket, 400, FormatError(_(L"Invalid request.")), false);
+            return false;
+            }
+
+        int statusCode{ 200 };
+        std::string body;
+        try
+            {
+            body = HandleRequest(request, worker, statusCode);
+            }
+        catch (const std::exception& exp)
+            {
+            statusCode = 500;
+            body = FormatError(wxString{ exp.what() });
+            }
+        catch (...)
+            {
+            statusCode = 500;
+            body = FormatError(_(L"An unknown error occurred while scoring the document."));
+            }
+        if (!SendResponse(socket, statusCode, body, request.IsKeepAlive()) ||
+            !request.IsKeepAlive())
+            {
+            return false;
+            }
+        // clients can send requests without waiting for the previous response
+        connection.m_buffer.erase(0, request.GetRequestSize());
+        connection.m_lastActive = wxGetLocalTimeMillis();
+        }
+    return false;
+    }
+
+//------------------------------------------------------
+void ScoringServer::CloseConnection(std::unique_ptr<Connection> connection)
+    {
+    connection->m_socket->Close();
+        {
+        const std::lock_guard lock(m_connectionsMutex);
+        m_closedSockets.push_back(connection->m_socket);
+        }
+    // sockets are deleted from the main thread
+    // (if the server is stopped first, then Stop() deletes them)
+    CallAfter([this]() { DestroyClosedSockets(); });
+    }
+
+//------------------------------------------------------
+void ScoringServer::DestroyClosedSockets()
+    {
+    std::vector<wxSocketBase*> closedSockets;
+        {
+        const std::lock_guard lock(m_connectionsMutex);
+        closedSockets.swap(m_closedSockets);
+        }
+    for (auto* socket : closedSockets)
+        {
+        socket->Destroy();
+        }
+    }
+
+//------------------------------------------------------
+std::string ScoringServer::HandleRequest(const HttpRequest& request,
+                                         ScoringEngine::Worker& worker, int& statusCode) const
+    {
+    statusCode = 200;
+    const bool isGet = (request.GetMethod() == "GET");
+    const bool isPost = (request.GetMethod() == "POST");
+
+    if (request.GetPath() == "/health" || request.GetPath() == "/tests")
+        {
+        if (!isGet)
+            {
+            statusCode = 405;
+            return FormatError(_(L"Use GET for this request."));
+            }
+        return (request.GetPath() == "/tests") ?
+                   m_testsJson :
+                   "{\"status\":\"ok\",\"workers\":" + std::to_string(m_workerCount) + "}";
+        }
+    if (request.GetPath() != "/score")
+        {
+        statusCode = 404;
+        return FormatError(_(L"Unknown request. Use /score, /tests, or /health."));
+        }
+    if (!isGet && !isPost)
+        {
+        statusCode = 405;
+        return FormatError(_(L"Use GET (with a file path) or POST (with text) to score."));
+        }
+
+    ScoringEngine::Result result;
+    if (const auto filePath = request.GetQueryValue("path"))
+        {
+        const wxString path = wxString::FromUTF8(*filePath);
+        if (!wxFileName{ path }.IsAbsolute())
+            {
+            statusCode = 400;
+            return FormatError(_(L"The file path must be absolute."));
+            }
+        result = worker.ScoreFile(path);
+        }
+    else if (isPost)
+        {
+        const auto label = request.GetQueryValue("label");
+        result = worker.ScoreText(wxString::FromUTF8(request.GetBody()).ToStdWstring(),
+                                  label ? wxString::FromUTF8(*label) : wxString{});
+        }
+    else
+        {
+        statusCode = 400;
+        return FormatError(_(L"Specify a file path (path=...) or POST the text to score."));
+        }
+
+    if (!result.m_succeeded)
+        {
+        statusCode = 422;
+        }
+    std::string json;
+    ScoringEngine::AppendJson(json, result);
+    return json;
+    }
+
+//------------------------------------------------------
+bool ScoringServer::SendResponse(wxSocketBase& socket, const int statusCode,
+                                 const std::string& body, const bool keepAlive)
+    {
+    const std::string response =
+        HttpRequest::FormatResponse(statusCode, "application/json", body, keepAlive);
+    size_t written{ 0 };
+    while (written < response.length())
+        {
+        socket.Write(response.data() + written, response.length() - written);
+        if (socket.Error() || socket.LastWriteCount() == 0)
+            {
+            return false;
+            }
+        written += socket.LastWriteCount();
+        }
+    return true;
+    }
+
+//------------------------------------------------------
+std::string ScoringServer::FormatError(const wxString& message)
+    {
+    std::string json{ "{\"error\":" };
+    ScoringEngine::AppendJsonString(json, message);
+    json += '}';
+    return json;
+    }
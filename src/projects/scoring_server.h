@@ -0,0 +1,157 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __SCORING_SERVER_H__
+#define __SCORING_SERVER_H__
+
+#include "http_request.h"
+#include "scoring_engine.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <wx/event.h>
+#include <wx/longlong.h>
+#include <wx/socket.h>
+#include <wx/string.h>
+
+/** @brief Scores text and files sent to it over HTTP, on the loopback interface.
+    @details This keeps the program resident (e.g., with @c --headless and @c --serve from the
+        command line), so that the word lists, phrase lists, and syllabizers are loaded once,
+        and clients pay only for analyzing their documents. Each worker keeps its own
+        ScoringEngine::Worker (created once at startup), which is reused for every document
+        that it scores.\n
+        Open connections wait in a queue for a worker, which answers the requests that have
+        arrived on it and then puts it back at the end of the queue, rather than waiting on it
+        for the client's next request. That way, idle keep-alive connections don't hold up the
+        others, although clients should still reuse connections to score many documents
+        quickly. Connections are closed once they are idle for IDLE_TIMEOUT seconds. If the
+        queue is full, new connections are answered with @c 503 (Service Unavailable).
+    @par Requests
+        - <tt>POST /score[?label=...]</tt>: scores the request's body (UTF-8 text).
+        - <tt>GET /score?path=...</tt>: scores a local file (the path must be absolute).
+        - <tt>GET /tests</tt>: lists the tests that documents are scored with.
+        - <tt>GET /health</tt>: reports that the service is running.
+    @par Responses
+        Scores are returned as JSON (see ScoringEngine::AppendJson()), with the status
+        @c 200 if the document was scored and @c 422 if it could not be (e.g., the file
+        could not be read). Other errors are returned as <tt>{"error":"..."}</tt>.*/
+class ScoringServer final : public wxEvtHandler
+    {
+  public:
+    /** @brief Constructor.
+        @param port The port to listen on (@c 0 to let the system choose one).
+        @param workerCount The number of requests to answer at the same time
+            (@c 0 to use one per core).
+        @param scorer What to score the documents with (e.g., a DocumentScorer).
+        @param maxQueuedConnections The most open connections that can be waiting for a worker.
+        @warning This must be called from the main thread.*/
+    ScoringServer(const unsigned short port, const size_t workerCount,
+                  std::unique_ptr<ScoringEngine> scorer,
+                  const size_t maxQueuedConnections = MAX_QUEUED_CONNECTIONS);
+    /// @private
+    ScoringServer(const ScoringServer&) = delete;
+    /// @private
+    ScoringServer& operator=(const ScoringServer&) = delete;
+    /// @brief Destructor, which stops the server.
+    ~ScoringServer() { Stop(); }
+
+    /** @brief Starts listening for requests.
+        @param[out] errorMessage The reason that the server could not start.
+        @returns @c false if the port could not be listened on.*/
+    bool Start(wxString& errorMessage);
+
+    /** @brief Stops listening, waits for the workers to finish, and closes the connections.
+        @note Requests being scored are answered first.*/
+    void Stop();
+
+    /// @returns The port being listened on (useful if the system chose it).
+    [[nodiscard]]
+    unsigned short GetPort() const noexcept
+        {
+        return m_port;
+        }
+
+    /// @brief How long a connection can be idle before it is closed (in seconds).
+    constexpr static int IDLE_TIMEOUT{ 5 };
+    /// @brief How long a worker waits for more from a connection before putting it back
+    ///     into the queue (in milliseconds), if no other connections are waiting.
+    /// @details If others are waiting, then it only waits a moment.
+    constexpr static int READ_WAIT{ 100 };
+    /// @brief The largest document (in bytes) that can be sent to be scored.
+    constexpr static size_t MAX_BODY_SIZE{ 16 * 1024 * 1024 };
+    /// @brief The default for the most connections that can be waiting for a worker.
+    constexpr static size_t MAX_QUEUED_CONNECTIONS{ 1024 };
+
+  private:
+    /// @brief An open connection, and what has been read from it.
+    struct Connection
+        {
+        wxSocketBase* m_socket{ nullptr };
+        // what was read after the last request that was answered
+        std::string m_buffer;
+        // when the connection was accepted, or last sent something (in milliseconds)
+        wxLongLong m_lastActive{ 0 };
+        };
+
+    void OnServerEvent(wxSocketEvent& event);
+    /// @brief Serves connections from the queue until the server stops.
+    void RunWorker(ScoringEngine::Worker& worker);
+    /** @brief Answers the requests that have arrived on a connection.
+        @param connection The connection.
+        @param worker What to score the documents with.
+        @param readBuffer The worker's buffer to read from the socket into.
+        @returns @c true if the connection should stay open (and go back into the queue),
+            or @c false if it should be closed.*/
+    [[nodiscard]]
+    bool ServeConnection(Connection& connection, ScoringEngine::Worker& worker,
+                         std::vector<char>& readBuffer);
+    /// @brief Closes a connection (its socket is deleted on the main thread).
+    void CloseConnection(std::unique_ptr<Connection> connection);
+    /// @brief Deletes the sockets of the connections that the workers closed.
+    void DestroyClosedSockets();
+    /// @returns The response's body, and sets @c statusCode.
+    [[nodiscard]]
+    std::string HandleRequest(const HttpRequest& request, ScoringEngine::Worker& worker,
+                              int& statusCode) const;
+    /// @returns @c false if the response could not be sent.
+    static bool SendResponse(wxSocketBase& socket, const int statusCode, const std::string& body,
+                             const bool keepAlive);
+    [[nodiscard]]
+    static std::string FormatError(const wxString& message);
+
+    unsigned short m_port{ 0 };
+    size_t m_workerCount{ 1 };
+    std::unique_ptr<ScoringEngine> m_scorer;
+    size_t m_maxQueuedConnections{ MAX_QUEUED_CONNECTIONS };
+    // the response for /tests, which doesn't change while running
+    std::string m_testsJson;
+
+    wxSocketServer* m_server{ nullptr };
+    // what each worker thread scores with (which are only created on the main thread)
+    std::vector<std::unique_ptr<ScoringEngine::Worker>> m_scoringWorkers;
+    std::vector<std::thread> m_workers;
+    // open connections waiting for a worker
+    std::deque<std::unique_ptr<Connection>> m_connections;
+    // sockets closed by the workers, waiting to be deleted on the main thread
+    std::vector<wxSocketBase*> m_closedSockets;
+    std::mutex m_connectionsMutex;
+    std::condition_variable m_connectionsCondition;
+    std::atomic<bool> m_stopping{ false };
+    };
+
+#endif //__SCORING_SERVER_H__
@@ -0,0 +1,259 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __SETTINGS_XML_INDEX_H__
+#define __SETTINGS_XML_INDEX_H__
+
+#include <algorithm>
+#include <cwchar>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** @brief Index of the elements in a project's settings file.
+    @details The settings text is read once, recording where every element starts and ends.
+        After that, finding a section is a hash lookup (and a binary search when limited
+        to a parent section), rather than a linear search from the start of the text.
+        This keeps loading linear in the size of the settings, which matters for batch
+        projects with many documents.
+    @note The index points into the settings text, so the text must outlive it.*/
+class SettingsXmlIndex
+    {
+  public:
+    /// @brief A pair of pointers to the start of an element's opening tag and
+    ///     the start of its closing tag (both are null if the element was not found).
+    using Section = std::pair<const wchar_t*, const wchar_t*>;
+
+    /** @brief Constructor, which indexes the elements in the settings text.
+        @param text The settings text.
+        @param textEnd The end of the settings text.*/
+    SettingsXmlIndex(const wchar_t* text, const wchar_t* textEnd)
+        {
+        if (text == nullptr || textEnd == nullptr || textEnd <= text)
+            {
+            return;
+            }
+
+        // the names of the open elements and their positions in m_elements
+        std::vector<std::pair<std::wstring_view, size_t>> openElements;
+
+        const wchar_t* current = text;
+        while (current < textEnd)
+            {
+            current = std::find(current, textEnd, L'<');
+            if (current == textEnd)
+                {
+                break;
+                }
+            const std::wstring_view remaining{ current,
+                                               static_cast<size_t>(textEnd - current) };
+            // skip over comments, CDATA, and processing instructions
+            if (remaining.starts_with(L"<!--"))
+                {
+                current = SkipPast(current, textEnd, L"-->");
+                continue;
+                }
+            if (remaining.starts_with(L"<![CDATA["))
+                {
+                current = SkipPast(current, textEnd, L"]]>");
+                continue;
+                }
+            if (remaining.starts_with(L"<?"))
+                {
+                current = SkipPast(current, textEnd, L"?>");
+                continue;
+                }
+            if (remaining.starts_with(L"<!"))
+                {
+                current = SkipPast(current, textEnd, L">");
+                continue;
+                }
+
+            const bool isClosingTag = remaining.starts_with(L"</");
+            const wchar_t* nameStart = current + (isClosingTag ? 2 : 1);
+            const wchar_t* nameEnd = nameStart;
+            while (nameEnd < textEnd && !IsNameTerminator(*nameEnd))
+                {
+                ++nameEnd;
+                }
+            const std::wstring_view elementName{ nameStart,
+                                                 static_cast<size_t>(nameEnd - nameStart) };
+            const wchar_t* tagEnd = FindTagEnd(nameEnd, textEnd);
+            if (tagEnd == textEnd)
+                {
+                break;
+                }
+
+            if (isClosingTag)
+                {
+                // close the most recent element with this name (any elements that were
+                // opened after it are malformed and left unclosed)
+                const auto openPos =
+                    std::find_if(openElements.crbegin(), openElements.crend(),
+                                 [&elementName](const auto& openElement)
+                                 { return openElement.first == elementName; });
+                if (openPos != openElements.crend())
+                    {
+                    m_elements[openPos->second].m_contentEnd = current;
+                    openElements.erase(std::next(openPos).base(), openElements.end());
+                    }
+                }
+            else if (!elementName.empty())
+                {
+                // a self-closing element has no content
+                const bool isSelfClosing = (*(tagEnd - 1) == L'/');
+                m_elements.push_back(
+                    { elementName, current, isSelfClosing ? tagEnd + 1 : nullptr });
+                m_elementPositions[elementName].push_back(m_elements.size() - 1);
+                if (!isSelfClosing)
+                    {
+                    openElements.emplace_back(elementName, m_elements.size() - 1);
+                    }
+                }
+            current = tagEnd + 1;
+            }
+        }
+
+    /** @brief Finds the first element with the given name.
+        @param name The element's name.
+        @returns The section of the element.\n
+            Both pointers will be null if not found (or if the element was never closed).*/
+    [[nodiscard]]
+    Section FindSection(const std::wstring_view name) const
+        {
+        return FindSection(name, nullptr, nullptr);
+        }
+
+    /** @brief Finds the first element with the given name that starts within a parent section.
+        @param name The element's name.
+        @param rangeStart The start of the parent section (e.g., the start of a
+            previous sibling, to find the next one).
+        @param rangeEnd The end of the parent section.
+        @returns The section of the element.\n
+            Both pointers will be null if not found (or if the element was never closed).*/
+    [[nodiscard]]
+    Section FindSection(const std::wstring_view name, const wchar_t* rangeStart,
+                        const wchar_t* rangeEnd) const
+        {
+        const auto positions = m_elementPositions.find(name);
+        if (positions == m_elementPositions.cend())
+            {
+            return { nullptr, nullptr };
+            }
+        // positions are in document order, so binary search for the first one in the range
+        auto pos = (rangeStart == nullptr) ?
+                       positions->second.cbegin() :
+                       std::lower_bound(positions->second.cbegin(), positions->second.cend(),
+                                        rangeStart, [this](const size_t index, const wchar_t* start)
+                                        { return m_elements[index].m_start < start; });
+        for (; pos != positions->second.cend(); ++pos)
+            {
+            const auto& element = m_elements[*pos];
+            if (rangeEnd != nullptr && element.m_start >= rangeEnd)
+                {
+                break;
+                }
+            if (element.m_contentEnd != nullptr &&
+                (rangeEnd == nullptr || element.m_contentEnd <= rangeEnd))
+                {
+                return { element.m_start, element.m_contentEnd };
+                }
+            }
+        return { nullptr, nullptr };
+        }
+
+    /// @private
+    [[nodiscard]]
+    Section FindSection(const std::string_view name) const
+        {
+        return FindSection(std::wstring(name.cbegin(), name.cend()));
+        }
+
+    /// @private
+    [[nodiscard]]
+    Section FindSection(const std::string_view name, const wchar_t* rangeStart,
+                        const wchar_t* rangeEnd) const
+        {
+        return FindSection(std::wstring(name.cbegin(), name.cend()), rangeStart, rangeEnd);
+        }
+
+    /// @returns The number of elements that were indexed.
+    [[nodiscard]]
+    size_t GetElementCount() const noexcept
+        {
+        return m_elements.size();
+        }
+
+  private:
+    struct Element
+        {
+        std::wstring_view m_name;
+        // the start of the opening tag
+        const wchar_t* m_start{ nullptr };
+        // the start of the closing tag (null until the element is closed)
+        const wchar_t* m_contentEnd{ nullptr };
+        };
+
+    [[nodiscard]]
+    static bool IsNameTerminator(const wchar_t character) noexcept
+        {
+        return (character == L'>' || character == L'/' || character == L' ' ||
+                character == L'\t' || character == L'\n' || character == L'\r');
+        }
+
+    /// @returns The closing '>' of a tag (skipping over any in quoted attribute values),
+    ///     or @c textEnd if the tag is not terminated.
+    [[nodiscard]]
+    static const wchar_t* FindTagEnd(const wchar_t* current, const wchar_t* textEnd) noexcept
+        {
+        wchar_t quote{ 0 };
+        for (; current < textEnd; ++current)
+            {
+            if (quote != 0)
+                {
+                if (*current == quote)
+                    {
+                    quote = 0;
+                    }
+                }
+            else if (*current == L'\"' || *current == L'\'')
+                {
+                quote = *current;
+                }
+            else if (*current == L'>')
+                {
+                return current;
+                }
+            }
+        return textEnd;
+        }
+
+    /// @returns The position after @c terminator, or @c textEnd if not found.
+    [[nodiscard]]
+    static const wchar_t* SkipPast(const wchar_t* current, const wchar_t* textEnd,
+                                   const std::wstring_view terminator)
+        {
+        const auto found =
+            std::search(current, textEnd, terminator.cbegin(), terminator.cend());
+        return (found == textEnd) ? textEnd : found + terminator.length();
+        }
+
+    // every element, in document order
+    std::vector<Element> m_elements;
+    // each element name and where its elements are in m_elements (in document order)
+    std::unordered_map<std::wstring_view, std::vector<size_t>> m_elementPositions;
+    };
+
+#endif //__SETTINGS_XML_INDEX_H__
@@ -0,0 +1,350 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "source_file_watcher.h"
+#include <algorithm>
+#include <wx/evtloop.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/time.h>
+
+//------------------------------------------------------
+SourceFileWatcher::SourceFileWatcher() : m_debounceTimer(this), m_pollTimer(this)
+    {
+    Bind(wxEVT_TIMER, &SourceFileWatcher::OnDebounceTimer, this, m_debounceTimer.GetId());
+    Bind(wxEVT_TIMER, &SourceFileWatcher::OnPollTimer, this, m_pollTimer.GetId());
+#if wxUSE_FSWATCHER
+    Bind(wxEVT_FSWATCHER, &SourceFileWatcher::OnFileSystemEvent, this);
+#endif
+    }
+
+//------------------------------------------------------
+SourceFileWatcher::~SourceFileWatcher()
+    {
+    m_debounceTimer.Stop();
+    m_pollTimer.Stop();
+#if wxUSE_FSWATCHER
+    wxDELETE(m_fileSystemWatcher);
+#endif
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::Watch(const void* owner, const wxArrayString& files,
+                              ChangeCallback callback)
+    {
+    Unwatch(owner);
+
+    Owner newOwner;
+    newOwner.m_callback = std::move(callback);
+    for (const auto& file : files)
+        {
+        WatchedFile watchedFile;
+        if (file.empty() ||
+            !ReadFileState(file, watchedFile.m_lastModified, watchedFile.m_size))
+            {
+            continue;
+            }
+        watchedFile.m_path = file;
+        watchedFile.m_key = NormalizePath(file);
+        const wxString folder = wxFileName{ watchedFile.m_key }.GetPath();
+        if (AddWatchedFolder(folder))
+            {
+            watchedFile.m_watchedFolder = folder;
+            }
+        ++m_watchedFiles[watchedFile.m_key];
+        newOwner.m_files.push_back(std::move(watchedFile));
+        }
+
+    if (!newOwner.m_files.empty())
+        {
+        m_owners.insert(std::make_pair(owner, std::move(newOwner)));
+        }
+    UpdatePollTimer();
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::Unwatch(const void* owner)
+    {
+    const auto ownerPos = m_owners.find(owner);
+    if (ownerPos == m_owners.end())
+        {
+        return;
+        }
+    for (const auto& file : ownerPos->second.m_files)
+        {
+        if (!file.m_watchedFolder.empty())
+            {
+            RemoveWatchedFolder(file.m_watchedFolder);
+            }
+        auto filePos = m_watchedFiles.find(file.m_key);
+        if (filePos != m_watchedFiles.end() && --filePos->second == 0)
+            {
+            m_watchedFiles.erase(filePos);
+            m_pendingFiles.erase(file.m_key);
+            }
+        }
+    m_owners.erase(ownerPos);
+    UpdatePollTimer();
+    }
+
+//------------------------------------------------------
+size_t SourceFileWatcher::GetPolledFileCount() const
+    {
+    size_t polledCount{ 0 };
+    for (const auto& [owner, ownerInfo] : m_owners)
+        {
+        polledCount += std::count_if(ownerInfo.m_files.cbegin(), ownerInfo.m_files.cend(),
+                                     [](const auto& file) { return file.m_watchedFolder.empty(); });
+        }
+    return polledCount;
+    }
+
+//------------------------------------------------------
+wxString SourceFileWatcher::NormalizePath(const wxString& path)
+    {
+    wxFileName fn(path);
+    fn.Normalize(wxPATH_NORM_DOTS | wxPATH_NORM_TILDE | wxPATH_NORM_ABSOLUTE);
+#ifdef __WXMSW__
+    // paths are case insensitive on Windows
+    return fn.GetFullPath().Lower();
+#else
+    return fn.GetFullPath();
+#endif
+    }
+
+//------------------------------------------------------
+bool SourceFileWatcher::ReadFileState(const wxString& path, wxDateTime& lastModified,
+                                      wxULongLong& size)
+    {
+    if (!wxFileName::FileExists(path))
+        {
+        return false;
+        }
+    // files being written to can be briefly locked, so don't show errors about that
+    const wxLogNull noLogging;
+    lastModified = wxFileName{ path }.GetModificationTime();
+    size = wxFileName::GetSize(path);
+    return lastModified.IsValid() && size != wxInvalidSize;
+    }
+
+//------------------------------------------------------
+bool SourceFileWatcher::AddWatchedFolder(const wxString& folder)
+    {
+#if wxUSE_FSWATCHER
+    // system notifications don't include changes made by other machines to network shares
+    if (folder.StartsWith(L"\\\\") || folder.StartsWith(L"//"))
+        {
+        return false;
+        }
+
+    auto folderPos = m_watchedFolders.find(folder);
+    if (folderPos != m_watchedFolders.end())
+        {
+        ++folderPos->second;
+        return true;
+        }
+
+    // the system watcher needs a running event loop (which there won't be
+    // if running a script unattended at startup), so create it on demand
+    if (m_fileSystemWatcher == nullptr)
+        {
+        if (wxEventLoopBase::GetActive() == nullptr)
+            {
+            return false;
+            }
+        m_fileSystemWatcher = new wxFileSystemWatcher;
+        m_fileSystemWatcher->SetOwner(this);
+        }
+
+    const wxLogNull noLogging;
+    if (!m_fileSystemWatcher->Add(wxFileName::DirName(folder),
+                                  wxFSW_EVENT_CREATE | wxFSW_EVENT_DELETE | wxFSW_EVENT_RENAME |
+                                      wxFSW_EVENT_MODIFY | wxFSW_EVENT_WARNING |
+                                      wxFSW_EVENT_ERROR))
+        {
+        return false;
+        }
+    m_watchedFolders.insert(std::make_pair(folder, 1));
+    return true;
+#else
+    wxUnusedVar(folder);
+    return false;
+#endif
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::RemoveWatchedFolder(const wxString& folder)
+    {
+#if wxUSE_FSWATCHER
+    auto folderPos = m_watchedFolders.find(folder);
+    if (folderPos != m_watchedFolders.end() && --folderPos->second == 0)
+        {
+        m_watchedFolders.erase(folderPos);
+        if (m_fileSystemWatcher != nullptr)
+            {
+            const wxLogNull noLogging;
+            m_fileSystemWatcher->Remove(wxFileName::DirName(folder));
+            }
+        }
+#else
+    wxUnusedVar(folder);
+#endif
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::UpdatePollTimer()
+    {
+    const bool anyPolledFiles{ GetPolledFileCount() > 0 };
+    if (anyPolledFiles && !m_pollTimer.IsRunning())
+        {
+        m_pollTimer.Start(POLL_INTERVAL);
+        }
+    else if (!anyPolledFiles && m_pollTimer.IsRunning())
+        {
+        m_pollTimer.Stop();
+        }
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::QueueChangedFile(const wxString& key)
+    {
+    if (m_watchedFiles.find(key) != m_watchedFiles.cend())
+        {
+        m_pendingFiles.insert(key);
+        }
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::ScheduleDispatch()
+    {
+    if (m_pendingFiles.empty())
+        {
+        return;
+        }
+    const wxLongLong now = wxGetLocalTimeMillis();
+    if (!m_debounceTimer.IsRunning())
+        {
+        m_firstPendingTime = now;
+        m_debounceTimer.StartOnce(DEBOUNCE_INTERVAL);
+        }
+    // wait until the files are quiet, unless they have been changing for too long
+    else if ((now - m_firstPendingTime) < MAX_DEBOUNCE_DELAY)
+        {
+        m_debounceTimer.StartOnce(DEBOUNCE_INTERVAL);
+        }
+    }
+
+#if wxUSE_FSWATCHER
+//------------------------------------------------------
+void SourceFileWatcher::OnFileSystemEvent(wxFileSystemWatcherEvent& event)
+    {
+    const int changeType = event.GetChangeType();
+    // if notifications were lost (or the watch broke), then check all the files
+    if ((changeType & (wxFSW_EVENT_WARNING | wxFSW_EVENT_ERROR)) != 0)
+        {
+        for (const auto& [key, ownerCount] : m_watchedFiles)
+            {
+            m_pendingFiles.insert(key);
+            }
+        }
+    else
+        {
+        QueueChangedFile(NormalizePath(event.GetPath().GetFullPath()));
+        // editors often save by writing a temporary file and renaming it over the original
+        if ((changeType & wxFSW_EVENT_RENAME) != 0)
+            {
+            QueueChangedFile(NormalizePath(event.GetNewPath().GetFullPath()));
+            }
+        }
+    ScheduleDispatch();
+    }
+#endif
+
+//------------------------------------------------------
+void SourceFileWatcher::OnPollTimer([[maybe_unused]] wxTimerEvent& event)
+    {
+    for (const auto& [owner, ownerInfo] : m_owners)
+        {
+        for (const auto& file : ownerInfo.m_files)
+            {
+            wxDateTime lastModified;
+            wxULongLong size{ 0 };
+            if (file.m_watchedFolder.empty() &&
+                ReadFileState(file.m_path, lastModified, size) &&
+                (lastModified != file.m_lastModified || size != file.m_size))
+                {
+                m_pendingFiles.insert(file.m_key);
+                }
+            }
+        }
+    ScheduleDispatch();
+    }
+
+//------------------------------------------------------
+void SourceFileWatcher::OnDebounceTimer([[maybe_unused]] wxTimerEvent& event)
+    {
+    // a callback is still running (e.g., a project is reloading and yielding to
+    // its progress dialog), so wait for it to finish
+    if (m_dispatching)
+        {
+        m_debounceTimer.StartOnce(DEBOUNCE_INTERVAL);
+        return;
+        }
+
+    std::set<wxString> pendingFiles;
+    std::swap(pendingFiles, m_pendingFiles);
+
+    // gather the files that really changed for each owner
+    // (notifications are also sent for files just being read or touched)
+    std::vector<std::pair<const void*, wxArrayString>> changes;
+    for (auto& [owner, ownerInfo] : m_owners)
+        {
+        wxArrayString changedFiles;
+        for (auto& file : ownerInfo.m_files)
+            {
+            wxDateTime lastModified;
+            wxULongLong size{ 0 };
+            // if the file is missing, then it is probably in the middle of being replaced,
+            // so wait for the notification about it being recreated
+            if (pendingFiles.find(file.m_key) != pendingFiles.cend() &&
+                ReadFileState(file.m_path, lastModified, size) &&
+                (lastModified != file.m_lastModified || size != file.m_size))
+                {
+                file.m_lastModified = lastModified;
+                file.m_size = size;
+                changedFiles.push_back(file.m_path);
+                }
+            }
+        if (!changedFiles.empty())
+            {
+            changes.emplace_back(owner, std::move(changedFiles));
+            }
+        }
+
+    m_dispatching = true;
+    for (const auto& [owner, changedFiles] : changes)
+        {
+        // an earlier callback may have closed (and unregistered) this owner
+        const auto ownerPos = m_owners.find(owner);
+        if (ownerPos != m_owners.cend() && ownerPos->second.m_callback)
+            {
+            // copy the callback, as the owner may re-register (replacing it) while it runs
+            const ChangeCallback callback = ownerPos->second.m_callback;
+            callback(changedFiles);
+            }
+        }
+    m_dispatching = false;
+
+    // files that changed while the callbacks were running
+    ScheduleDispatch();
+    }
@@ -0,0 +1,158 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __SOURCE_FILE_WATCHER_H__
+#define __SOURCE_FILE_WATCHER_H__
+
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+#include <wx/arrstr.h>
+#include <wx/datetime.h>
+#include <wx/event.h>
+#include <wx/fswatcher.h>
+#include <wx/longlong.h>
+#include <wx/string.h>
+#include <wx/timer.h>
+
+/** @brief Notifies projects when their (linked) source documents are edited.
+    @details Each project registers the files that it reads from, along with a callback.
+        When files change, the callback is called with the files that were changed.\n
+        Where possible, the folders containing the files are watched for change notifications
+        from the system (e.g., inotify on Linux), so nothing is done while the files
+        are idle. Files that cannot be watched that way (e.g., files on network shares, or if
+        the system's watcher is unavailable) are polled for changes instead.\n
+        Editors often save a file with a burst of writes (or by writing a temporary file and
+        renaming it), so notifications are debounced: a file is only reported once it has been
+        quiet for a moment. Changes that arrive together (across all projects) are
+        reported together, one callback per project, and callbacks are never nested
+        (e.g., if a project is still reloading when other files change).
+    @note Callbacks are called from the main thread's event loop.\n
+        A file is only reported if its modification time or size actually changed since
+        it was registered (or last reported), so the project reloading it won't trigger
+        another notification.*/
+class SourceFileWatcher final : public wxEvtHandler
+    {
+  public:
+    /// @brief Callback for when files are changed.
+    /// @details The parameter is the list of changed files (as they were passed to Watch()).
+    using ChangeCallback = std::function<void(const wxArrayString& changedFiles)>;
+
+    /// @private
+    SourceFileWatcher();
+    /// @private
+    SourceFileWatcher(const SourceFileWatcher&) = delete;
+    /// @private
+    SourceFileWatcher& operator=(const SourceFileWatcher&) = delete;
+    /// @private
+    ~SourceFileWatcher();
+
+    /** @brief Starts watching files for an owner (e.g., a project).
+        @details If the owner is already watching files, then its list of files
+            and callback are replaced.
+        @param owner The owner of the files, used to identify it later in Unwatch().
+        @param files The files to watch. Files that do not exist are ignored.
+        @param callback The function to call when any of the files change.
+        @warning The owner must call Unwatch() before it is destroyed.*/
+    void Watch(const void* owner, const wxArrayString& files, ChangeCallback callback);
+
+    /** @brief Stops watching an owner's files.
+        @param owner The owner of the files.*/
+    void Unwatch(const void* owner);
+
+    /// @returns @c true if an owner is watching any files.
+    /// @param owner The owner of the files.
+    [[nodiscard]]
+    bool IsWatching(const void* owner) const
+        {
+        return m_owners.find(owner) != m_owners.cend();
+        }
+
+    /// @returns The number of files being polled (rather than watched through
+    ///     the system's change notifications).
+    [[nodiscard]]
+    size_t GetPolledFileCount() const;
+
+    /// @brief How long a file must be quiet before it is reported (in milliseconds).
+    constexpr static int DEBOUNCE_INTERVAL{ 750 };
+    /// @brief The longest that a file that keeps changing will go without being reported
+    ///     (in milliseconds).
+    constexpr static int MAX_DEBOUNCE_DELAY{ 5000 };
+    /// @brief How often files that cannot be watched are polled (in milliseconds).
+    constexpr static int POLL_INTERVAL{ 5000 };
+
+  private:
+    struct WatchedFile
+        {
+        // the path as the owner passed it in
+        wxString m_path;
+        // the normalized path, used for looking up notifications
+        wxString m_key;
+        // the folder being watched for it (empty if being polled)
+        wxString m_watchedFolder;
+        wxDateTime m_lastModified;
+        wxULongLong m_size{ 0 };
+        };
+
+    struct Owner
+        {
+        std::vector<WatchedFile> m_files;
+        ChangeCallback m_callback;
+        };
+
+#ifdef __UNITTEST
+  public:
+#endif
+    /// @returns The path in the form used for looking up notifications.
+    [[nodiscard]]
+    static wxString NormalizePath(const wxString& path);
+    /// @brief Marks a file as possibly changed (if it is being watched).
+    void QueueChangedFile(const wxString& key);
+    /// @brief Starts (or restarts) waiting for the pending files to be quiet.
+    void ScheduleDispatch();
+#ifdef __UNITTEST
+  private:
+#endif
+    /// @brief Reads the file's modification time and size.
+    /// @returns @c false if the file could not be read.
+    static bool ReadFileState(const wxString& path, wxDateTime& lastModified, wxULongLong& size);
+    /// @returns @c true if the folder is now being watched through the system.
+    bool AddWatchedFolder(const wxString& folder);
+    void RemoveWatchedFolder(const wxString& folder);
+    void UpdatePollTimer();
+
+#if wxUSE_FSWATCHER
+    void OnFileSystemEvent(wxFileSystemWatcherEvent& event);
+#endif
+    void OnPollTimer([[maybe_unused]] wxTimerEvent& event);
+    void OnDebounceTimer([[maybe_unused]] wxTimerEvent& event);
+
+    std::map<const void*, Owner> m_owners;
+    // the normalized paths of all watched files, with how many owners are watching them
+    std::map<wxString, size_t> m_watchedFiles;
+    // the folders being watched through the system, with how many files are in them
+    std::map<wxString, size_t> m_watchedFolders;
+    // files that were reported as changed, but not yet dispatched
+    std::set<wxString> m_pendingFiles;
+    wxLongLong m_firstPendingTime{ 0 };
+    bool m_dispatching{ false };
+
+#if wxUSE_FSWATCHER
+    wxFileSystemWatcher* m_fileSystemWatcher{ nullptr };
+#endif
+    wxTimer m_debounceTimer;
+    wxTimer m_pollTimer;
+    };
+
+#endif //__SOURCE_FILE_WATCHER_H__
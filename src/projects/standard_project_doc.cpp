@@ -41,6 +41,11 @@ wxIMPLEMENT_DYNAMIC_CLASS(ProjectDoc, wxDocument)
     void ProjectDoc::ShowQueuedMessages()
     {
     BaseProjectView* view = dynamic_cast<BaseProjectView*>(GetFirstView());
+    // without a view, these have already been logged
+    if (view == nullptr)
+        {
+        return;
+        }
     for (std::vector<WarningMessage>::const_iterator queuedMsgIter = GetQueuedMessages().begin();
          queuedMsgIter != GetQueuedMessages().end(); ++queuedMsgIter)
         {
@@ -61,7 +66,7 @@ void ProjectDoc::ExcludeAllCustomTestsTests()
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
     for (std::vector<CustomReadabilityTestInterface>::const_iterator pos =
              GetCustTestsInUse().begin();
-         pos != GetCustTestsInUse().end(); ++pos)
+         view != nullptr && pos != GetCustTestsInUse().end(); ++pos)
         {
         while (
             view->GetWordsBreakdownView().RemoveWindowById(pos->GetIterator()->get_interface_id()))
@@ -76,6 +81,10 @@ std::vector<CustomReadabilityTestInterface>::iterator
 ProjectDoc::RemoveCustomReadabilityTest(const wxString& testName, const int Id)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::RemoveCustomReadabilityTest(testName, Id);
+        }
 
     // remove any views that are related to this test
     // (text window and word list window)
@@ -128,6 +137,12 @@ void ProjectDoc::RefreshStatisticsReports()
         }
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    // a window-less project (from a headless script) has no reports to rebuild
+    if (view == nullptr)
+        {
+        ResetRefreshRequired();
+        return;
+        }
     const auto selectedItem = view->GetSideBar()->GetSelectedFolderId();
 
     wxWindowUpdateLocker noUpdates(GetDocumentWindow());
@@ -166,6 +181,12 @@ void ProjectDoc::RefreshGraphs()
         return;
         }
 
+    if (GetFirstView() == nullptr)
+        {
+        ResetRefreshRequired();
+        return;
+        }
+
     wxWindowUpdateLocker noUpdates(GetDocumentWindow());
     BaseProjectProcessingLock processingLock(this);
     DisplayReadabilityScores(false);
@@ -192,9 +213,18 @@ void ProjectDoc::RefreshProject()
         return;
         }
 
+    // a newly included test may need a familiar-word list that was skipped
+    // when the document was last indexed
+    if (LoadingOriginalTextSucceeded() && IsMissingWordListPasses())
+        {
+        RefreshRequired(ProjectRefresh::FullReindexing);
+        }
+
     StopRealtimeUpdate();
 
-    wxBusyCursor bc;
+    const std::unique_ptr<wxBusyCursor> busyCursor{ wxGetApp().IsHeadless() ?
+                                                        nullptr :
+                                                        std::make_unique<wxBusyCursor>() };
 
     // reload the excluded phrases
     LoadExcludePhrases();
@@ -202,15 +232,22 @@ void ProjectDoc::RefreshProject()
     // load appended template file (if there is one)
     LoadAppendedDocument();
 
+    // headless scripts open projects without a view, so only the results get recalculated
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    const auto selectedItem = view->GetSideBar()->GetSelectedSubItemId();
+    const auto selectedItem =
+        (view != nullptr) ? view->GetSideBar()->GetSelectedSubItemId() : wxID_ANY;
+    const auto lockWindow = [view, this]()
+    {
+        return (view != nullptr) ? std::make_unique<wxWindowUpdateLocker>(GetDocumentWindow()) :
+                                   nullptr;
+    };
 
     // If the original text is gone (there won't be anything to analyze),
     // or if just cosmetic changes (e.g., graph options), then don't re-index,
     // just do a simple refresh.
     if (LoadingOriginalTextSucceeded() == false || !IsDocumentReindexingRequired())
         {
-        wxWindowUpdateLocker noUpdates(GetDocumentWindow());
+        const auto noUpdates = lockWindow();
         BaseProjectProcessingLock processingLock(this);
         DisplayReadabilityScores(false);
         DisplayStatistics();
@@ -226,23 +263,28 @@ void ProjectDoc::RefreshProject()
             UpdateHighlightedTextWindows();
             }
 
-        view->UpdateSideBarIcons();
-        view->UpdateRibbonState();
-        view->Present();
-        UpdateAllViews();
-
-        if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+        if (view != nullptr)
             {
-            view->GetSideBar()->SelectFolder(0, true, true);
-            }
+            view->UpdateSideBarIcons();
+            view->UpdateRibbonState();
+            view->Present();
+            UpdateAllViews();
 
-        GetDocumentWindow()->Refresh();
+            if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+                {
+                view->GetSideBar()->SelectFolder(0, true, true);
+                }
+
+            GetDocumentWindow()->Refresh();
+            }
         ResetRefreshRequired();
+        // in case real-time updating was toggled
+        RestartRealtimeUpdate();
         Modify(true);
         return;
         }
     BaseProjectProcessingLock processingLock(this);
-    wxWindowUpdateLocker noUpdates(GetDocumentWindow());
+    const auto noUpdates = lockWindow();
 
     // reload the document
     if (GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
@@ -253,7 +295,6 @@ void ProjectDoc::RefreshProject()
             ResetRefreshRequired();
             return;
             }
-        UpdateSourceFileModifiedTime();
         RestartRealtimeUpdate();
         }
     // if embedded, then reload our embedded content
@@ -287,9 +328,13 @@ void ProjectDoc::RefreshProject()
            disable on the text view windows. On macOS, disabling/re-enabling
            text controls appears to reset their font color (which we are customizing
            in DisplayHighlightedText().*/
-        wxBusyInfo bi(wxBusyInfoFlags()
-                          .Text(_(L"Reloading project..."))
-                          .Parent(wxGetApp().GetParentingWindow()));
+        const std::unique_ptr<wxBusyInfo> bi{
+            wxGetApp().IsHeadless() ?
+                nullptr :
+                std::make_unique<wxBusyInfo>(wxBusyInfoFlags()
+                                                 .Text(_(L"Reloading project..."))
+                                                 .Parent(wxGetApp().GetParentingWindow()))
+        };
 #ifdef __WXGTK__
         wxMilliSleep(100);
         wxTheApp->Yield();
@@ -313,7 +358,10 @@ void ProjectDoc::RefreshProject()
                              "Project cannot be recalculated.") :
                            _(L"No valid words were entered. Project cannot be recalculated."),
                        _(L"Import Error"), wxOK | wxICON_INFORMATION);
-            GetDocumentWindow()->Refresh();
+            if (view != nullptr)
+                {
+                GetDocumentWindow()->Refresh();
+                }
 
             ResetRefreshRequired();
             return;
@@ -334,21 +382,27 @@ void ProjectDoc::RefreshProject()
 
         Modify(true);
 
-        view->UpdateSideBarIcons();
-        view->UpdateRibbonState();
-        view->Present();
-        UpdateAllViews();
+        if (view != nullptr)
+            {
+            view->UpdateSideBarIcons();
+            view->UpdateRibbonState();
+            view->Present();
+            UpdateAllViews();
+            }
         }
 
-    // See if the view that was originally selected is gone.
-    // If so then select the scores section.
-    if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+    if (view != nullptr)
         {
-        view->GetSideBar()->SelectFolder(0, true, true);
-        }
-    view->ShowSideBar(view->IsSideBarShown());
+        // See if the view that was originally selected is gone.
+        // If so then select the scores section.
+        if (!view->GetSideBar()->SelectSubItemById(selectedItem, true, true))
+            {
+            view->GetSideBar()->SelectFolder(0, true, true);
+            }
+        view->ShowSideBar(view->IsSideBarShown());
 
-    GetDocumentWindow()->Refresh();
+        GetDocumentWindow()->Refresh();
+        }
 
     ResetRefreshRequired();
 
@@ -387,9 +441,9 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
                 }
             catch (...)
                 {
-                wxMessageBox(_(L"An unknown error occurred while analyzing the document. "
-                               "Unable to create project."),
-                             _(L"Error"), wxOK | wxICON_EXCLAMATION);
+                LogMessage(_(L"An unknown error occurred while analyzing the document. "
+                             "Unable to create project."),
+                           _(L"Error"), wxOK | wxICON_EXCLAMATION);
                 return false;
                 }
             }
@@ -417,9 +471,9 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
                     }
                 catch (...)
                     {
-                    wxMessageBox(_(L"An unknown error occurred while analyzing the document. "
-                                   "Unable to create project."),
-                                 _(L"Error"), wxOK | wxICON_EXCLAMATION);
+                    LogMessage(_(L"An unknown error occurred while analyzing the document. "
+                                 "Unable to create project."),
+                               _(L"Error"), wxOK | wxICON_EXCLAMATION);
                     return false;
                     }
                 return true;
@@ -431,7 +485,6 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
                 {
                 if (LoadExternalDocument())
                     {
-                    UpdateSourceFileModifiedTime();
                     LogMessage(_(L"The document's content could not be found in the project file. "
                                  "Original document will be reloaded."),
                                _(L"Warning"), wxOK | wxICON_INFORMATION);
@@ -442,7 +495,7 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
                 // file and external file can't be found either.
                 else
                     {
-                    wxMessageBox(
+                    LogMessage(
                         _(L"Document content could not be found in the project file and "
                           "external document could not be located.\nUnable to create project."),
                         _(L"Error"), wxOK | wxICON_EXCLAMATION);
@@ -458,14 +511,13 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
             {
             if (LoadExternalDocument())
                 {
-                UpdateSourceFileModifiedTime();
                 return true;
                 }
             else
                 {
-                wxMessageBox(_(L"External document could not be located.\n"
-                               "Unable to create project."),
-                             _(L"Error"), wxOK | wxICON_EXCLAMATION);
+                LogMessage(_(L"External document could not be located.\n"
+                             "Unable to create project."),
+                           _(L"Error"), wxOK | wxICON_EXCLAMATION);
                 return false;
                 }
             }
@@ -473,9 +525,9 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
            it to embed, but just for the sake of being verbose... */
         else // TextSource::EnteredText
             {
-            wxMessageBox(_(L"Manually entered text was not embedded previously.\n"
-                           "Unable to create project."),
-                         _(L"Error"), wxOK | wxICON_EXCLAMATION);
+            LogMessage(_(L"Manually entered text was not embedded previously.\n"
+                         "Unable to create project."),
+                       _(L"Error"), wxOK | wxICON_EXCLAMATION);
             return false;
             }
         }
@@ -486,7 +538,9 @@ bool ProjectDoc::LoadProjectFile(const char* projectFileText, const size_t textL
 //------------------------------------------------
 bool ProjectDoc::OnOpenDocument(const wxString& filename)
     {
-    wxBusyCursor bc;
+    const std::unique_ptr<wxBusyCursor> busyCursor{ wxGetApp().IsHeadless() ?
+                                                        nullptr :
+                                                        std::make_unique<wxBusyCursor>() };
 
     wxLogMessage(L"Opening project \"%s\"", filename);
     // make sure there aren't any projects getting updated before we start opening a new one.
@@ -600,9 +654,13 @@ bool ProjectDoc::OnOpenDocument(const wxString& filename)
        external file could not be found (if applicable).*/
     if (LoadingOriginalTextSucceeded())
         {
-        wxBusyInfo bi(wxBusyInfoFlags()
-                          .Text(_(L"Loading project..."))
-                          .Parent(wxGetApp().GetParentingWindow()));
+        const std::unique_ptr<wxBusyInfo> bi{
+            wxGetApp().IsHeadless() ?
+                nullptr :
+                std::make_unique<wxBusyInfo>(wxBusyInfoFlags()
+                                                 .Text(_(L"Loading project..."))
+                                                 .Parent(wxGetApp().GetParentingWindow()))
+        };
 #ifdef __WXGTK__
         wxMilliSleep(100);
         wxTheApp->Yield();
@@ -656,20 +714,23 @@ bool ProjectDoc::OnOpenDocument(const wxString& filename)
     SetDocumentSaved(true);
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    view->UpdateSideBarIcons();
-    view->UpdateRibbonState();
-    view->Present();
-    UpdateAllViews();
+    if (view != nullptr)
+        {
+        view->UpdateSideBarIcons();
+        view->UpdateRibbonState();
+        view->Present();
+        UpdateAllViews();
 
-    const auto selectedIndex =
-        view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_READABILITY_SCORES_SECTION_ID);
-    view->GetSideBar()->SelectFolder(selectedIndex.value_or(0), true);
+        const auto selectedIndex =
+            view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_READABILITY_SCORES_SECTION_ID);
+        view->GetSideBar()->SelectFolder(selectedIndex.value_or(0), true);
 
-    ShowQueuedMessages();
+        ShowQueuedMessages();
 
-    if (WarningManager::HasWarning(_DT(L"note-project-properties")))
-        {
-        view->ShowInfoMessage(*WarningManager::GetWarning(_DT(L"note-project-properties")));
+        if (WarningManager::HasWarning(_DT(L"note-project-properties")))
+            {
+            view->ShowInfoMessage(*WarningManager::GetWarning(_DT(L"note-project-properties")));
+            }
         }
 
     if (GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
@@ -1095,6 +1156,8 @@ bool ProjectDoc::RunProjectWizard(const wxString& path)
 //-------------------------------------------------------
 void ProjectDoc::DisplayReadabilityScores(const bool setFocus)
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayReadabilityScores");
     // this area can be included for an empty project, just won't show anything
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
     if (view)
@@ -1317,13 +1380,20 @@ bool ProjectDoc::OnCreate(const wxString& path, long flags)
             {
             SetOriginalDocumentFilePath(path);
             SetTextSource(TextSource::FromFile);
-            return wxDocument::OnCreate(wxString{}, flags);
+            return CreateView(wxString{}, flags);
             }
         // scripting framework passes this in to create an empty project
         // that can have files added later
         else if (path == L"EMPTY_PROJECT")
             {
-            return wxDocument::OnCreate(wxString{}, flags);
+            return CreateView(wxString{}, flags);
+            }
+        // the wizard is interactive, so it can't be used headless
+        else if (wxGetApp().IsHeadless())
+            {
+            LogMessage(wxString::Format(_(L"'%s': unable to create project."), path), _(L"Error"),
+                       wxOK | wxICON_EXCLAMATION);
+            return false;
             }
         // otherwise, use the wizard if raw text (or no text, or examples file path) was passed in
         else
@@ -1334,7 +1404,15 @@ bool ProjectDoc::OnCreate(const wxString& path, long flags)
                 }
             }
         }
-    return wxDocument::OnCreate(path, flags);
+    return CreateView(path, flags);
+    }
+
+//-------------------------------------------------------
+bool ProjectDoc::CreateView(const wxString& path, const long flags)
+    {
+    // when running headless, projects are only used for their results
+    // and don't have a window (or view) to display them in
+    return wxGetApp().IsHeadless() ? true : wxDocument::OnCreate(path, flags);
     }
 
 //-------------------------------------------------------
@@ -1345,12 +1423,16 @@ bool ProjectDoc::OnNewDocument()
         return false;
         }
 
-    wxBusyCursor bc;
+    const std::unique_ptr<wxBusyCursor> busyCursor{ wxGetApp().IsHeadless() ?
+                                                        nullptr :
+                                                        std::make_unique<wxBusyCursor>() };
 
     BaseProjectProcessingLock processingLock(this);
 
+    // (projects created by headless scripts don't have a view)
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    wxASSERT_MSG(view->GetFrame(), L"Invalid frame for newly created document!");
+    wxASSERT_MSG(view == nullptr || view->GetFrame(),
+                 L"Invalid frame for newly created document!");
 
     LoadExcludePhrases();
 
@@ -1370,11 +1452,6 @@ bool ProjectDoc::OnNewDocument()
             {
             return false;
             }
-
-        if (GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
-            {
-            UpdateSourceFileModifiedTime();
-            }
         SetTitle(ParseTitleFromFileName(GetOriginalDocumentFilePath()));
         SetFilename(ParseTitleFromFileName(GetOriginalDocumentFilePath()), true);
         }
@@ -1418,7 +1495,7 @@ bool ProjectDoc::OnNewDocument()
                 auto warningIter =
                     WarningManager::GetWarning(_DT(L"high-count-sentences-being-ignored"));
                 if (warningIter != WarningManager::GetWarnings().end() &&
-                    warningIter->ShouldBeShown())
+                    warningIter->ShouldBeShown() && view != nullptr)
                     {
                     wxRichMessageDialog msg(view->GetFrame(), warningIter->GetMessage(),
                                             warningIter->GetTitle(), warningIter->GetFlags());
@@ -1448,9 +1525,13 @@ bool ProjectDoc::OnNewDocument()
 
         // make the busy message go out of scope before queued messages appear
         {
-        wxBusyInfo bi(wxBusyInfoFlags()
-                          .Text(_(L"Loading project..."))
-                          .Parent(wxGetApp().GetParentingWindow()));
+        const std::unique_ptr<wxBusyInfo> bi{
+            wxGetApp().IsHeadless() ?
+                nullptr :
+                std::make_unique<wxBusyInfo>(wxBusyInfoFlags()
+                                                 .Text(_(L"Loading project..."))
+                                                 .Parent(wxGetApp().GetParentingWindow()))
+        };
 #ifdef __WXGTK__
         wxMilliSleep(100);
         wxTheApp->Yield();
@@ -1488,15 +1569,21 @@ bool ProjectDoc::OnNewDocument()
 
         Modify(true);
 
-        view->UpdateSideBarIcons();
-        view->UpdateRibbonState();
-        view->Present();
-        UpdateAllViews();
+        if (view != nullptr)
+            {
+            view->UpdateSideBarIcons();
+            view->UpdateRibbonState();
+            view->Present();
+            UpdateAllViews();
+            }
         }
 
-    const auto selectedIndex =
-        view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_READABILITY_SCORES_SECTION_ID);
-    view->GetSideBar()->SelectFolder(selectedIndex.value_or(0), true);
+    if (view != nullptr)
+        {
+        const auto selectedIndex =
+            view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_READABILITY_SCORES_SECTION_ID);
+        view->GetSideBar()->SelectFolder(selectedIndex.value_or(0), true);
+        }
 
     if (GetTotalWords() == 0)
         {
@@ -1578,7 +1665,8 @@ bool ProjectDoc::OnNewDocument()
         {
         auto warningIter =
             WarningManager::GetWarning(_DT(L"incomplete-sentences-valid-from-length"));
-        if (warningIter != WarningManager::GetWarnings().end() && warningIter->ShouldBeShown())
+        if (warningIter != WarningManager::GetWarnings().end() && warningIter->ShouldBeShown() &&
+            view != nullptr)
             {
             ListDlg listDlg(
                 view->GetFrame(), longIncompleteSentences, false,
@@ -1620,33 +1708,31 @@ bool ProjectDoc::OnNewDocument()
     }
 
 //-------------------------------------------------------
-void ProjectDoc::UpdateSourceFileModifiedTime()
+void ProjectDoc::RestartRealtimeUpdate()
     {
-    FilePathResolver resolvePath;
-    resolvePath.ResolvePath(GetOriginalDocumentFilePath(), false);
-    if ((resolvePath.IsLocalOrNetworkFile() || resolvePath.IsArchivedFile() ||
-         resolvePath.IsExcelCell()) &&
-        wxFileName::FileExists(resolvePath.GetResolvedPath()))
+    if (IsRealTimeUpdating() &&
+        GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
         {
-        m_sourceFileLastModified = wxFileName(resolvePath.GetResolvedPath()).GetModificationTime();
+        wxArrayString sourceFiles;
+        sourceFiles.push_back(GetWatchableFilePath(GetOriginalDocumentFilePath()));
+        wxGetApp().GetSourceFileWatcher().Watch(
+            this, sourceFiles,
+            [this]([[maybe_unused]] const wxArrayString& changedFiles) { OnSourceFileChanged(); });
+        }
+    else
+        {
+        StopRealtimeUpdate();
         }
     }
 
 //-------------------------------------------------------
-void ProjectDoc::OnRealTimeTimer([[maybe_unused]] wxTimerEvent& event)
+void ProjectDoc::OnSourceFileChanged()
     {
-    if (GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
+    if (IsRealTimeUpdating() &&
+        GetDocumentStorageMethod() == TextStorage::LoadFromExternalDocument)
         {
-        StopRealtimeUpdate();
-        const auto previousModTime{ m_sourceFileLastModified };
-        UpdateSourceFileModifiedTime();
-        if (m_sourceFileLastModified.IsValid() && previousModTime.IsValid() &&
-            previousModTime < m_sourceFileLastModified)
-            {
-            RefreshRequired(RefreshRequirement::FullReindexing);
-            RefreshProject();
-            }
-        RestartRealtimeUpdate();
+        RefreshRequired(RefreshRequirement::FullReindexing);
+        RefreshProject();
         }
     }
 
@@ -1654,6 +1740,8 @@ void ProjectDoc::OnRealTimeTimer([[maybe_unused]] wxTimerEvent& event)
 void ProjectDoc::DisplayWordsBreakdown()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayWordsBreakdown");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -1663,6 +1751,10 @@ void ProjectDoc::DisplayWordsBreakdown()
     DisplayWordCharts();
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     // place the word lists beneath the last graph in the Words Breakdown section
     int lastGraphPosition{ wxNOT_FOUND };
@@ -1861,7 +1953,7 @@ void ProjectDoc::DisplayWordsBreakdown()
             dynamic_cast<ListCtrlEx*>(view->GetWordsBreakdownView().FindWindowById(
                 BaseProjectView::SPACHE_WORDS_LIST_PAGE_ID));
         if (GetWordsBreakdownInfo().IsSpacheUnfamiliarEnabled() &&
-            GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()) &&
+            GetReadabilityTests().is_test_included(readability::test_key::spache) &&
             GetTotalUniqueHardWordsSpache() > 0 && GetSpacheHardWordData())
             {
             if (listView)
@@ -1914,7 +2006,7 @@ void ProjectDoc::DisplayWordsBreakdown()
             dynamic_cast<ListCtrlEx*>(view->GetWordsBreakdownView().FindWindowById(
                 BaseProjectView::HARRIS_JACOBSON_WORDS_LIST_PAGE_ID));
         if (GetWordsBreakdownInfo().IsHarrisJacobsonUnfamiliarEnabled() &&
-            GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()) &&
+            GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson) &&
             GetTotalUniqueHarrisJacobsonHardWords() > 0 && GetHarrisJacobsonHardWordDataData())
             {
             if (listView)
@@ -2226,6 +2318,8 @@ void ProjectDoc::DisplayWordsBreakdown()
 void ProjectDoc::DisplaySentenceCharts()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplaySentenceCharts");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -2233,6 +2327,10 @@ void ProjectDoc::DisplaySentenceCharts()
         }
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     // box plot of sentence lengths
@@ -2427,6 +2525,8 @@ void ProjectDoc::DisplaySentenceCharts()
 void ProjectDoc::DisplayWordCharts()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayWordCharts");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -2434,6 +2534,10 @@ void ProjectDoc::DisplayWordCharts()
         }
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     // word bar chart
@@ -2523,7 +2627,7 @@ void ProjectDoc::DisplayWordCharts()
                 GraphItems::Label(_(L"DC (unfamiliar)")), GetGraphBarEffect(),
                 GetGraphBarOpacity()));
             }
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::spache))
             {
             wordBarChart->AddBar(BarChart::Bar(
                 ++currentBar,
@@ -2536,7 +2640,7 @@ void ProjectDoc::DisplayWordCharts()
                 GraphItems::Label(_(L"Spache (unfamiliar)")), GetGraphBarEffect(),
                 GetGraphBarOpacity()));
             }
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
             {
             wordBarChart->AddBar(BarChart::Bar(
                 ++currentBar,
@@ -2575,7 +2679,7 @@ void ProjectDoc::DisplayWordCharts()
                                         wxNumberFormatter::Style::Style_NoTrailingZeroes |
                                             wxNumberFormatter::Style::Style_WithThousandsSep),
             GraphItems::Label(_(L"Monosyllabic")), GetGraphBarEffect(), GetGraphBarOpacity()));
-        if (GetReadabilityTests().is_test_included(ReadabilityMessages::EFLAW()))
+        if (GetReadabilityTests().is_test_included(readability::test_key::eflaw))
             {
             wordBarChart->AddBar(BarChart::Bar(
                 ++currentBar,
@@ -2877,6 +2981,10 @@ void ProjectDoc::AddCrawfordGraph(const bool setFocus)
 
     // Crawford graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* crawfordGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -2935,6 +3043,10 @@ void ProjectDoc::AddDB2Plot(const bool setFocus)
 
     // DB2
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* db2PlotView = dynamic_cast<Wisteria::Canvas*>(
@@ -2997,6 +3109,10 @@ void ProjectDoc::AddLixGermanGauge(const bool setFocus)
 
     // Lix Gauge (German)
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* lixGaugeView =
@@ -3061,6 +3177,10 @@ void ProjectDoc::AddLixGauge(const bool setFocus)
 
     // Lix Gauge
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* lixGaugeView = dynamic_cast<Wisteria::Canvas*>(
@@ -3132,6 +3252,10 @@ void ProjectDoc::AddFleschChart(const bool setFocus)
 
     // Flesch chart
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* fleschChartCanvas = dynamic_cast<Wisteria::Canvas*>(
@@ -3219,6 +3343,10 @@ bool ProjectDoc::AddSchwartzTest(const bool setFocus)
         }
     // Schwartz graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::AddSchwartzTest(setFocus);
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* schwartzGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -3379,6 +3507,10 @@ bool ProjectDoc::AddFraseTest(const bool setFocus)
         }
     // FRASE graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::AddFraseTest(setFocus);
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* fraseGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -3470,6 +3602,8 @@ bool ProjectDoc::AddFraseTest(const bool setFocus)
 //-------------------------------------------------------
 void ProjectDoc::DisplayReadabilityGraphs()
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayReadabilityGraphs");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -3479,48 +3613,52 @@ void ProjectDoc::DisplayReadabilityGraphs()
     try
         {
         ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+        if (view == nullptr)
+            {
+            return;
+            }
         wxGCDC gdc(view->GetDocFrame());
 
         // remove Fry graph if test is not included (Note that this chart is added by AddFryTest,
         // not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::FRY()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::fry))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::FRY_PAGE_ID);
             }
         // remove GPM (Spanish) Fry graph if test is not included
         // (Note that this chart is added by AddGilliamPenaMountainFryTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::GPM_FRY()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::gpm_fry))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::GPM_FRY_PAGE_ID);
             }
         // remove FRASE graph if test is not included (Note that this chart is added by
         // AddFraseTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::FRASE()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::frase))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::FRASE_PAGE_ID);
             }
         // remove Schwartz graph if test is not included (Note that this chart is added by
         // AddSchwartzTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::SCHWARTZ()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::schwartz))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::SCHWARTZ_PAGE_ID);
             }
         // remove Flesch Chart graph if test is not included (Note that this chart is added by
         // AddFleschTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::FLESCH()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::flesch))
             {
             view->GetReadabilityResultsView().RemoveWindowById(
                 BaseProjectView::FLESCH_CHART_PAGE_ID);
             }
         // remove DB2 graph if test is not included (Note that this chart is added by AddDB2,
         // not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::DANIELSON_BRYAN_2()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::danielson_bryan_2))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::DB2_PAGE_ID);
             }
         // remove Lix Gauge if test is not included (Note that this chart is added by AddLixTest,
         // not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::LIX()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::lix))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::LIX_GAUGE_PAGE_ID);
             }
@@ -3528,21 +3666,21 @@ void ProjectDoc::DisplayReadabilityGraphs()
         // (Note that this chart is added by AddLixGermanXXX, not here).
         if (!GetReadabilityTests().is_test_included(
                 ReadabilityMessages::LIX_GERMAN_CHILDRENS_LITERATURE()) &&
-            !GetReadabilityTests().is_test_included(ReadabilityMessages::LIX_GERMAN_TECHNICAL()))
+            !GetReadabilityTests().is_test_included(readability::test_key::lix_german_technical))
             {
             view->GetReadabilityResultsView().RemoveWindowById(
                 BaseProjectView::LIX_GAUGE_GERMAN_PAGE_ID);
             }
         // remove Crawford graph if test is not included (Note that this chart is added by
         // AddCrawfordTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::CRAWFORD()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::crawford))
             {
             view->GetReadabilityResultsView().RemoveWindowById(
                 BaseProjectView::CRAWFORD_GRAPH_PAGE_ID);
             }
         // remove Raygor graph if test is not included (Note that this chart is added by
         // AddRaygorTest, not here).
-        if (!GetReadabilityTests().is_test_included(ReadabilityMessages::RAYGOR()))
+        if (!GetReadabilityTests().is_test_included(readability::test_key::raygor))
             {
             view->GetReadabilityResultsView().RemoveWindowById(BaseProjectView::RAYGOR_PAGE_ID);
             }
@@ -3934,9 +4072,14 @@ void ProjectDoc::DisplaySentencesBreakdown()
 //-------------------------------------------------------
 void ProjectDoc::DisplayStatistics()
     {
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayStatistics");
     // this area can be included for an empty project, just won't show anything
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    assert(view);
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetStatisticsInfo().IsReportEnabled())
         {
@@ -4101,6 +4244,10 @@ bool ProjectDoc::AddGilliamPenaMountainFryTest(const bool setFocus)
         }
     // GPM (Fry) graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::AddGilliamPenaMountainFryTest(setFocus);
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* fryGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -4259,6 +4406,10 @@ bool ProjectDoc::AddFryTest(const bool setFocus)
         }
     // Fry graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::AddFryTest(setFocus);
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* fryGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -4419,6 +4570,10 @@ bool ProjectDoc::AddRaygorTest(const bool setFocus)
         }
     // Raygor graph
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return BaseProject::AddRaygorTest(setFocus);
+        }
     wxGCDC gdc(view->GetDocFrame());
 
     Wisteria::Canvas* raygorGraphView = dynamic_cast<Wisteria::Canvas*>(
@@ -4561,8 +4716,11 @@ bool ProjectDoc::AddDolchSightWords()
     RefreshProject();
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    view->GetSideBar()->SelectFolder(
-        view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_DOLCH_SECTION_ID));
+    if (view != nullptr)
+        {
+        view->GetSideBar()->SelectFolder(
+            view->GetSideBar()->FindFolder(BaseProjectView::SIDEBAR_DOLCH_SECTION_ID));
+        }
 
     return true;
     }
@@ -4578,7 +4736,7 @@ void ProjectDoc::SetReadabilityTestResult(const wxString& testId, const wxString
                                           indexScore, clozeScore, setFocus);
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    assert(view && "Invalid view when adding test!");
+    // (no view if the project was opened by a headless script)
     if (!view)
         {
         return;
@@ -4658,6 +4816,10 @@ void ProjectDoc::SetReadabilityTestResult(const wxString& testId, const wxString
 void ProjectDoc::UpdateHighlightedTextWindows()
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
     // DC
     if (GetWordsBreakdownInfo().IsDCUnfamiliarEnabled() && IsDaleChallLikeTestIncluded())
         {
@@ -4672,7 +4834,7 @@ void ProjectDoc::UpdateHighlightedTextWindows()
         }
     // Spache
     if (GetWordsBreakdownInfo().IsSpacheUnfamiliarEnabled() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+        GetReadabilityTests().is_test_included(readability::test_key::spache))
         {
         const auto buddyWindowPosition = view->GetWordsBreakdownView().FindWindowPositionById(
             BaseProjectView::SPACHE_WORDS_LIST_PAGE_ID);
@@ -4685,7 +4847,7 @@ void ProjectDoc::UpdateHighlightedTextWindows()
         }
     // HJ
     if (GetWordsBreakdownInfo().IsHarrisJacobsonUnfamiliarEnabled() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+        GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
         {
         const auto buddyWindowPosition = view->GetWordsBreakdownView().FindWindowPositionById(
             BaseProjectView::HARRIS_JACOBSON_WORDS_LIST_PAGE_ID);
@@ -5694,6 +5856,8 @@ ProjectDoc::BuildHeader(const wxColour& backgroundColor,
 void ProjectDoc::DisplayHighlightedText(const wxColour& highlightColor, const wxFont& textViewFont)
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayHighlightedText");
     if (GetWords() == nullptr)
         {
         return;
@@ -5702,6 +5866,10 @@ void ProjectDoc::DisplayHighlightedText(const wxColour& highlightColor, const wx
     try
         {
         ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+        if (view == nullptr)
+            {
+            return;
+            }
 
         // build the general highlighters
         const HighlighterColors highlighterColorsThemed =
@@ -5957,7 +6125,7 @@ void ProjectDoc::DisplayHighlightedText(const wxColour& highlightColor, const wx
         // HJ buffers
         if (GetProjectLanguage() == readability::test_language::english_test &&
             GetWordsBreakdownInfo().IsHarrisJacobsonUnfamiliarEnabled() &&
-            GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+            GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
             {
             hjBuffer.reserve(textBufferLength);
             hjPaperBuffer.reserve(textBufferLength);
@@ -6023,7 +6191,7 @@ void ProjectDoc::DisplayHighlightedText(const wxColour& highlightColor, const wx
         // Spache
         if (GetProjectLanguage() == readability::test_language::english_test &&
             GetWordsBreakdownInfo().IsSpacheUnfamiliarEnabled() &&
-            GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+            GetReadabilityTests().is_test_included(readability::test_key::spache))
             {
             spacheBuffer.reserve(textBufferLength);
             spachePaperBuffer.reserve(textBufferLength);
@@ -6474,6 +6642,10 @@ void ProjectDoc::LoadThreeSyllTextWindow(const std::wstring& mainBuffer,
                                          const std::wstring& paperBuffer)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetWordsBreakdownInfo().Is3PlusSyllablesEnabled() && GetTotalUnique3PlusSyllableWords() > 0)
         {
@@ -6499,6 +6671,10 @@ void ProjectDoc::LoadSixCharsTextWindow(const std::wstring& mainBuffer,
                                         const std::wstring& paperBuffer)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetWordsBreakdownInfo().Is6PlusCharacterEnabled() && GetTotalUnique6CharsPlusWords() > 0)
         {
@@ -6524,10 +6700,14 @@ void ProjectDoc::LoadSpacheTextWindow(const std::wstring& mainBuffer,
                                       const std::wstring& paperBuffer)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetProjectLanguage() == readability::test_language::english_test &&
         GetWordsBreakdownInfo().IsSpacheUnfamiliarEnabled() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+        GetReadabilityTests().is_test_included(readability::test_key::spache))
         {
         m_spacheTextWindow =
             dynamic_cast<FormattedTextCtrl*>(view->GetWordsBreakdownView().FindWindowById(
@@ -6550,10 +6730,14 @@ void ProjectDoc::LoadSpacheTextWindow(const std::wstring& mainBuffer,
 void ProjectDoc::LoadHJTextWindow(const std::wstring& mainBuffer, const std::wstring& paperBuffer)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetProjectLanguage() == readability::test_language::english_test &&
         GetWordsBreakdownInfo().IsHarrisJacobsonUnfamiliarEnabled() &&
-        GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+        GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
         {
         m_hjTextWindow =
             dynamic_cast<FormattedTextCtrl*>(view->GetWordsBreakdownView().FindWindowById(
@@ -6591,6 +6775,10 @@ void ProjectDoc::LoadHJTextWindow(const std::wstring& mainBuffer, const std::wst
 void ProjectDoc::LoadDCTextWindow(const std::wstring& mainBuffer, const std::wstring& paperBuffer)
     {
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (GetProjectLanguage() == readability::test_language::english_test &&
         GetWordsBreakdownInfo().IsDCUnfamiliarEnabled() && IsDaleChallLikeTestIncluded())
@@ -6686,7 +6874,7 @@ bool ProjectDoc::OnSaveDocument(const wxString& filename)
        This helps us from corrupting the original file if something goes wrong
        during the write process.*/
     wxTempFileOutputStream out(filename);
-    wxZipOutputStream zip(out, 9 /*Maximum compression*/);
+    wxZipOutputStream zip(out, wxGetApp().GetAppOptions().GetProjectCompressionLevel());
 
     // settings.xml
     Wisteria::ZipCatalog::WriteText(zip, ProjectSettingsFileLabel(), FormatProjectSettings());
@@ -6751,6 +6939,8 @@ bool ProjectDoc::OnSaveDocument(const wxString& filename)
 void ProjectDoc::DisplayOverlyLongSentences()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayOverlyLongSentences");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -6758,6 +6948,10 @@ void ProjectDoc::DisplayOverlyLongSentences()
         }
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     if (!GetWords())
         {
@@ -6869,6 +7063,8 @@ void ProjectDoc::DisplayOverlyLongSentences()
 void ProjectDoc::DisplayGrammar()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplayGrammar");
     // if working with an empty project
     if (GetWords() == nullptr)
         {
@@ -6876,6 +7072,10 @@ void ProjectDoc::DisplayGrammar()
         }
 
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
+    if (view == nullptr)
+        {
+        return;
+        }
 
     const auto resetListView = [](ListCtrlEx* listView)
     {
@@ -7602,8 +7802,10 @@ void ProjectDoc::DisplayGrammar()
 void ProjectDoc::DisplaySightWords()
     {
     PROFILE();
+    const pipeline_stats::scoped_timer stageTimer(pipeline_stats::stage::ui_population,
+                                                  "ProjectDoc::DisplaySightWords");
     ProjectView* view = dynamic_cast<ProjectView*>(GetFirstView());
-    assert(view && "Error getting view when displaying sight words!");
+    // (no view if the project was opened by a headless script)
     if (!view)
         {
         return;
@@ -16,14 +16,18 @@
 
 #include "../app/readability_app.h"
 #include "base_project_doc.h"
-#include <wx/timer.h>
 
 /// @brief Standard project document.
 class ProjectDoc final : public BaseProjectDoc
     {
   public:
     /// @brief Constructor.
-    ProjectDoc() : m_realTimeTimer(this) { Bind(wxEVT_TIMER, &ProjectDoc::OnRealTimeTimer, this); }
+    ProjectDoc()
+        {
+        // a standard project is loaded by itself, so its cores are free
+        // to tokenize a long document concurrently
+        TokenizeInParallel(true);
+        }
 
     /// @private
     ProjectDoc(const ProjectDoc&) = delete;
@@ -31,7 +35,11 @@ class ProjectDoc final : public BaseProjectDoc
     ProjectDoc& operator=(const ProjectDoc&) = delete;
 
     /// @private
-    ~ProjectDoc() { DeleteExcludedPhrases(); }
+    ~ProjectDoc()
+        {
+        StopRealtimeUpdate();
+        DeleteExcludedPhrases();
+        }
 
     /// @private
     bool OnOpenDocument(const wxString& filename) final;
@@ -89,15 +97,12 @@ class ProjectDoc final : public BaseProjectDoc
         return m_passiveVoiceData;
         }
 
-    void StopRealtimeUpdate() { m_realTimeTimer.Stop(); }
+    /// @brief Stops reloading the project when the source document changes.
+    void StopRealtimeUpdate() { wxGetApp().GetSourceFileWatcher().Unwatch(this); }
 
-    void RestartRealtimeUpdate()
-        {
-        if (IsRealTimeUpdating())
-            {
-            m_realTimeTimer.Start(REALTIME_UPDATE_INTERVAL);
-            }
-        }
+    /// @brief Starts watching the (linked) source document for changes,
+    ///     if real-time updating is enabled.
+    void RestartRealtimeUpdate();
 
   private:
     [[nodiscard]]
@@ -283,9 +288,10 @@ class ProjectDoc final : public BaseProjectDoc
                                                     const std::wstring& paperBuffer);
 
     bool OnCreate(const wxString& path, long flags) final;
+    /// @brief Creates the project's view, unless running headless.
+    bool CreateView(const wxString& path, const long flags);
 
-    void UpdateSourceFileModifiedTime();
-    void OnRealTimeTimer([[maybe_unused]] wxTimerEvent& event);
+    void OnSourceFileChanged();
 
     std::shared_ptr<Wisteria::UI::ListCtrlExNumericDataProvider> m_dupWordData{
         std::make_shared<Wisteria::UI::ListCtrlExNumericDataProvider>()
@@ -329,10 +335,6 @@ class ProjectDoc final : public BaseProjectDoc
     Wisteria::UI::FormattedTextCtrl* m_spacheTextWindow{ nullptr };
     Wisteria::UI::FormattedTextCtrl* m_hjTextWindow{ nullptr };
 
-    wxDateTime m_sourceFileLastModified;
-    constexpr static int REALTIME_UPDATE_INTERVAL{ 5000 }; // in milliseconds
-    wxTimer m_realTimeTimer;
-
     wxString GetSentenceWordCountsColumnName() const { return _DT(L"SENTENCE_WORD_COUNTS"); }
 
     wxString GetSentenceIndicesColumnName() const { return _DT(L"SENTENCE_INDICES"); }
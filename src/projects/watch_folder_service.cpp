@@ -0,0 +1,430 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "watch_folder_service.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <wx/dir.h>
+#include <wx/evtloop.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/time.h>
+#include <wx/tokenzr.h>
+
+//------------------------------------------------------
+WatchFolderService::WatchFolderService(const wxString& folder, const wxString& storePath,
+                                       const size_t workerCount,
+                                       std::unique_ptr<ScoringEngine> scorer,
+                                       const wxString& fileFilter)
+    : m_storePath(storePath),
+      m_workerCount(workerCount > 0 ? workerCount :
+                                      std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+      m_scorer(std::move(scorer)), m_dispatchTimer(this), m_pollTimer(this)
+    {
+    assert(m_scorer && L"A scorer is required!");
+    wxFileName folderName = wxFileName::DirName(folder);
+    folderName.Normalize(wxPATH_NORM_DOTS | wxPATH_NORM_TILDE | wxPATH_NORM_ABSOLUTE);
+    m_folder = folderName.GetPath();
+
+    wxStringTokenizer tkz(fileFilter, L"*.;", wxTOKEN_STRTOK);
+    while (tkz.HasMoreTokens())
+        {
+        m_extensions.insert(tkz.GetNextToken().Lower());
+        }
+
+    Bind(wxEVT_TIMER, &WatchFolderService::OnDispatchTimer, this, m_dispatchTimer.GetId());
+    Bind(wxEVT_TIMER, &WatchFolderService::OnPollTimer, this, m_pollTimer.GetId());
+#if wxUSE_FSWATCHER
+    Bind(wxEVT_FSWATCHER, &WatchFolderService::OnFileSystemEvent, this);
+#endif
+    }
+
+//------------------------------------------------------
+WatchFolderService::~WatchFolderService()
+    {
+    m_dispatchTimer.Stop();
+    m_pollTimer.Stop();
+#if wxUSE_FSWATCHER
+    wxDELETE(m_fileSystemWatcher);
+#endif
+    // the workers post their results back to this object, so wait for them
+    // (the results themselves are dropped along with the pending events)
+    for (auto& worker : m_workers)
+        {
+        worker.wait();
+        }
+    }
+
+//------------------------------------------------------
+bool WatchFolderService::Start(wxString& errorMessage)
+    {
+    if (!wxFileName::DirExists(m_folder))
+        {
+        errorMessage = wxString::Format(_(L"Folder to watch not found:\n%s"), m_folder);
+        return false;
+        }
+
+    LoadStoreIndex();
+    if (!m_store.Open(m_storePath, L"ab"))
+        {
+        errorMessage = wxString::Format(_(L"Unable to write to the results file:\n%s"),
+                                        m_storePath);
+        return false;
+        }
+
+#if wxUSE_FSWATCHER
+    // the system watcher needs a running event loop
+    if (wxEventLoopBase::GetActive() != nullptr)
+        {
+        m_fileSystemWatcher = new wxFileSystemWatcher;
+        m_fileSystemWatcher->SetOwner(this);
+        const wxLogNull noLogging;
+        if (!m_fileSystemWatcher->AddTree(wxFileName::DirName(m_folder)))
+            {
+            wxDELETE(m_fileSystemWatcher);
+            }
+        }
+    if (m_fileSystemWatcher == nullptr)
+        {
+        m_pollTimer.Start(POLL_INTERVAL);
+        }
+#else
+    m_pollTimer.Start(POLL_INTERVAL);
+#endif
+
+    wxLogMessage(L"Watching '%s' for documents (%zu already scored, %zu workers).", m_folder,
+                 m_scoredFiles.size(), m_workerCount);
+    // catch up on whatever arrived while the service wasn't running
+    ScanFolder(m_folder);
+    m_dispatchTimer.Start(DISPATCH_INTERVAL);
+    return true;
+    }
+
+//------------------------------------------------------
+void WatchFolderService::LoadStoreIndex()
+    {
+    m_scoredFiles.clear();
+    if (!wxFileName::FileExists(m_storePath))
+        {
+        return;
+        }
+    wxFFile store(m_storePath, L"rb");
+    if (!store.IsOpened())
+        {
+        return;
+        }
+
+    // only the path, modification time, and size at the start of each line are needed
+    const auto readLine = [this](const std::string& line)
+    {
+        const std::string_view PATH_KEY{ "{\"path\":" };
+        const std::string_view MODIFIED_KEY{ ",\"modified\":" };
+        const std::string_view SIZE_KEY{ ",\"size\":" };
+        size_t pos{ 0 };
+        wxString path;
+        long long modified{ 0 }, size{ 0 };
+        if (line.compare(pos, PATH_KEY.length(), PATH_KEY) != 0)
+            {
+            return;
+            }
+        pos += PATH_KEY.length();
+        if (!ScoringEngine::ReadJsonString(line, pos, path) ||
+            line.compare(pos, MODIFIED_KEY.length(), MODIFIED_KEY) != 0)
+            {
+            return;
+            }
+        pos += MODIFIED_KEY.length();
+        if (!ScoringEngine::ReadJsonInteger(line, pos, modified) ||
+            line.compare(pos, SIZE_KEY.length(), SIZE_KEY) != 0)
+            {
+            return;
+            }
+        pos += SIZE_KEY.length();
+        if (!ScoringEngine::ReadJsonInteger(line, pos, size))
+            {
+            return;
+            }
+        // removed files are written with a zero time
+        if (modified == 0)
+            {
+            m_scoredFiles.erase(path);
+            }
+        else
+            {
+            m_scoredFiles[path] = FileState{ wxLongLong{ modified },
+                                             wxULongLong{ static_cast<wxULongLong_t>(size) } };
+            }
+    };
+
+    std::vector<char> buffer(1024 * 1024);
+    std::string line;
+    size_t bytesRead{ 0 };
+    while ((bytesRead = store.Read(buffer.data(), buffer.size())) > 0)
+        {
+        for (size_t i = 0; i < bytesRead; ++i)
+            {
+            if (buffer[i] == '\n')
+                {
+                readLine(line);
+                line.clear();
+                }
+            else
+                {
+                line += buffer[i];
+                }
+            }
+        }
+    // (a last line without a newline was cut off, so it is ignored)
+    }
+
+//------------------------------------------------------
+bool WatchFolderService::ReadFileState(const wxString& path, FileState& state)
+    {
+    if (!wxFileName::FileExists(path))
+        {
+        return false;
+        }
+    // files being copied can be briefly locked, so don't show errors about that
+    const wxLogNull noLogging;
+    const wxDateTime modified = wxFileName{ path }.GetModificationTime();
+    const wxULongLong size = wxFileName::GetSize(path);
+    if (!modified.IsValid() || size == wxInvalidSize)
+        {
+        return false;
+        }
+    state.m_modified = modified.GetValue();
+    state.m_size = size;
+    return true;
+    }
+
+//------------------------------------------------------
+bool WatchFolderService::IsSupportedFile(const wxString& path) const
+    {
+    return m_extensions.find(wxFileName{ path }.GetExt().Lower()) != m_extensions.cend();
+    }
+
+//------------------------------------------------------
+void WatchFolderService::ScanFolder(const wxString& folder)
+    {
+    wxArrayString files;
+        {
+        const wxLogNull noLogging;
+        wxDir::GetAllFiles(folder, &files, wxString{}, wxDIR_FILES | wxDIR_DIRS);
+        }
+    for (const auto& file : files)
+        {
+        if (!IsSupportedFile(file))
+            {
+            continue;
+            }
+        FileState state;
+        const auto scoredPos = m_scoredFiles.find(file);
+        if (scoredPos == m_scoredFiles.cend() ||
+            (ReadFileState(file, state) && !(state == scoredPos->second)))
+            {
+            QueueFile(file);
+            }
+        }
+    }
+
+//------------------------------------------------------
+void WatchFolderService::QueueFile(const wxString& path)
+    {
+    if (!IsSupportedFile(path))
+        {
+        return;
+        }
+    auto pendingPos = m_pendingFiles.find(path);
+    if (pendingPos != m_pendingFiles.end())
+        {
+        pendingPos->second = wxGetLocalTimeMillis();
+        }
+    // if the backlog is full, then drop this and pick it up from a scan later
+    else if (m_pendingFiles.size() >= MAX_PENDING_FILES)
+        {
+        m_rescanNeeded = true;
+        }
+    else
+        {
+        m_pendingFiles.insert(std::make_pair(path, wxGetLocalTimeMillis()));
+        }
+    }
+
+//------------------------------------------------------
+void WatchFolderService::DispatchFiles()
+    {
+    // forget about workers that are finished
+    m_workers.erase(std::remove_if(m_workers.begin(), m_workers.end(),
+                                   [](const auto& worker)
+                                   {
+                                       return worker.wait_for(std::chrono::seconds(0)) ==
+                                              std::future_status::ready;
+                                   }),
+                    m_workers.end());
+
+    const wxLongLong now = wxGetLocalTimeMillis();
+    auto pendingPos = m_pendingFiles.begin();
+    while (m_scoringFiles.size() < m_workerCount && pendingPos != m_pendingFiles.end())
+        {
+        // still being written to, or already being scored (it will be scored again after that)
+        if ((now - pendingPos->second) < QUIET_INTERVAL ||
+            m_scoringFiles.find(pendingPos->first) != m_scoringFiles.cend())
+            {
+            ++pendingPos;
+            continue;
+            }
+
+        const wxString path = pendingPos->first;
+        pendingPos = m_pendingFiles.erase(pendingPos);
+
+        // skip files that were deleted, or only touched since they were scored
+        FileState state;
+        if (!ReadFileState(path, state))
+            {
+            continue;
+            }
+        const auto scoredPos = m_scoredFiles.find(path);
+        if (scoredPos != m_scoredFiles.cend() && state == scoredPos->second)
+            {
+            continue;
+            }
+
+        m_scoringFiles.insert(path);
+        m_workers.push_back(std::async(
+            std::launch::async,
+            [this, path, state, worker = std::shared_ptr<ScoringEngine::Worker>(
+                                    m_scorer->CreateWorker())]()
+            {
+                const ScoringEngine::Result result = worker->ScoreFile(path);
+                CallAfter([this, result, state]() { OnFileScored(result, state); });
+            }));
+        }
+    }
+
+//------------------------------------------------------
+void WatchFolderService::OnFileScored(const ScoringEngine::Result& result,
+                                      const FileState& state)
+    {
+    m_scoringFiles.erase(result.m_path);
+    // the file is gone, so its result would only bring it back into the store
+    if (m_removedWhileScoring.erase(result.m_path) > 0)
+        {
+        wxLogVerbose(L"'%s' was removed while being scored.", result.m_path);
+        DispatchFiles();
+        return;
+        }
+    m_scoredFiles[result.m_path] = state;
+
+    std::string record{ ",\"result\":" };
+    ScoringEngine::AppendJson(record, result);
+    AppendToStore(result.m_path, state, record);
+    if (result.m_succeeded)
+        {
+        wxLogVerbose(L"Scored '%s'.", result.m_path);
+        }
+    else
+        {
+        wxLogVerbose(L"Unable to score '%s': %s", result.m_path, result.m_error);
+        }
+    DispatchFiles();
+    }
+
+//------------------------------------------------------
+void WatchFolderService::OnFileRemoved(const wxString& path)
+    {
+    m_pendingFiles.erase(path);
+    if (m_scoringFiles.find(path) != m_scoringFiles.cend())
+        {
+        m_removedWhileScoring.insert(path);
+        }
+    if (m_scoredFiles.erase(path) > 0)
+        {
+        AppendToStore(path, FileState{}, ",\"removed\":true");
+        }
+    }
+
+//------------------------------------------------------
+void WatchFolderService::AppendToStore(const wxString& path, const FileState& state,
+                                       const std::string& record)
+    {
+    std::string line{ "{\"path\":" };
+    ScoringEngine::AppendJsonString(line, path);
+    line += ",\"modified\":" + std::to_string(state.m_modified.GetValue()) +
+            ",\"size\":" + std::to_string(state.m_size.GetValue()) + ",\"time\":";
+    ScoringEngine::AppendJsonString(line, wxDateTime::Now().FormatISOCombined());
+    line += record;
+    line += "}\n";
+    m_store.Write(line.data(), line.length());
+    m_store.Flush();
+    }
+
+#if wxUSE_FSWATCHER
+//------------------------------------------------------
+void WatchFolderService::OnFileSystemEvent(wxFileSystemWatcherEvent& event)
+    {
+    const int changeType = event.GetChangeType();
+    // notifications were lost (e.g., the system's queue overflowed)
+    if ((changeType & (wxFSW_EVENT_WARNING | wxFSW_EVENT_ERROR)) != 0)
+        {
+        m_rescanNeeded = true;
+        return;
+        }
+
+    const wxString path = event.GetPath().GetFullPath();
+    if ((changeType & wxFSW_EVENT_DELETE) != 0)
+        {
+        OnFileRemoved(path);
+        }
+    else if ((changeType & wxFSW_EVENT_RENAME) != 0)
+        {
+        OnFileRemoved(path);
+        QueueFile(event.GetNewPath().GetFullPath());
+        }
+    else if ((changeType & (wxFSW_EVENT_CREATE | wxFSW_EVENT_MODIFY)) != 0)
+        {
+        // A folder moved (or copied) into the tree doesn't send events for its files,
+        // so watch it and queue what is already in it
+        if ((changeType & wxFSW_EVENT_CREATE) != 0 && wxFileName::DirExists(path))
+            {
+                {
+                const wxLogNull noLogging;
+                m_fileSystemWatcher->AddTree(wxFileName::DirName(path));
+                }
+            ScanFolder(path);
+            }
+        else
+            {
+            QueueFile(path);
+            }
+        }
+    }
+#endif
+
+//------------------------------------------------------
+void WatchFolderService::OnDispatchTimer([[maybe_unused]] wxTimerEvent& event)
+    {
+    // pick up notifications that were dropped, once the backlog has room again
+    if (m_rescanNeeded && m_pendingFiles.size() < (MAX_PENDING_FILES / 2))
+        {
+        m_rescanNeeded = false;
+        ScanFolder(m_folder);
+        }
+    DispatchFiles();
+    }
+
+//------------------------------------------------------
+void WatchFolderService::OnPollTimer([[maybe_unused]] wxTimerEvent& event)
+    {
+    ScanFolder(m_folder);
+    }
@@ -0,0 +1,189 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __WATCH_FOLDER_SERVICE_H__
+#define __WATCH_FOLDER_SERVICE_H__
+
+#include "scoring_engine.h"
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include <wx/event.h>
+#include <wx/ffile.h>
+#include <wx/fswatcher.h>
+#include <wx/longlong.h>
+#include <wx/string.h>
+#include <wx/timer.h>
+
+/** @brief Scores the documents in a folder (and its subfolders) as they are added or changed,
+        appending the results to a file.
+    @details This is meant to be run as a long-running service (e.g., with @c --headless
+        and @c --watch from the command line), where files are regularly dropped into
+        shared folders.\n
+        The folder is watched through the system's change notifications (e.g., inotify on
+        Linux), so only the files that were added or changed are read; the folder is never
+        re-scanned, except once at startup (to catch up on files that arrived while the service
+        was not running) and if the system reports that notifications were lost.
+        Files are scored once they have been quiet for a moment (so that files still being
+        copied are not read early).
+    @par Results store
+        The results are appended to a JSON Lines file, one line (object) per scored (or
+        removed) file, and the file is flushed after every line. Each line starts with the
+        file's path, modification time (in milliseconds since the epoch), and size, which
+        is what is read back when the service restarts to know which files are already
+        scored. A file that is later changed gets a new line, so the last line for a path
+        is its current result.
+    @par Concurrency
+        Files are scored on worker threads, with at most one file per worker at a time.
+        Files waiting to be scored are only kept as a list of paths; if that list grows too
+        large (e.g., a huge copy into the folder), then new notifications are dropped and
+        the folder is scanned again once the backlog has cleared. Because the store
+        records what was scored, that scan only picks up what was dropped.*/
+class WatchFolderService final : public wxEvtHandler
+    {
+  public:
+    /** @brief Constructor.
+        @param folder The folder to watch (including its subfolders).
+        @param storePath The file to append the results to.
+        @param workerCount The number of files to score at the same time
+            (@c 0 to use one per core).
+        @param scorer What to score the files with (e.g., a DocumentScorer).
+        @param fileFilter The wildcards of the files to score (e.g., <tt>*.txt;*.docx</tt>).
+        @warning This must be called from the main thread.*/
+    WatchFolderService(const wxString& folder, const wxString& storePath,
+                       const size_t workerCount, std::unique_ptr<ScoringEngine> scorer,
+                       const wxString& fileFilter);
+    /// @private
+    WatchFolderService(const WatchFolderService&) = delete;
+    /// @private
+    WatchFolderService& operator=(const WatchFolderService&) = delete;
+    /// @brief Destructor, which waits for the files being scored.
+    ~WatchFolderService();
+
+    /** @brief Reads the results already in the store and starts watching the folder.
+        @details Files that are new (or changed) since they were last scored are queued.
+        @param[out] errorMessage The reason that the service could not start.
+        @returns @c false if the folder does not exist or the store cannot be written to.*/
+    bool Start(wxString& errorMessage);
+
+    /// @returns The number of files waiting to be scored.
+    [[nodiscard]]
+    size_t GetPendingCount() const noexcept
+        {
+        return m_pendingFiles.size();
+        }
+
+    /// @returns The number of files being scored.
+    [[nodiscard]]
+    size_t GetScoringCount() const noexcept
+        {
+        return m_scoringFiles.size();
+        }
+
+    /// @returns The number of files with results in the store.
+    [[nodiscard]]
+    size_t GetScoredCount() const noexcept
+        {
+        return m_scoredFiles.size();
+        }
+
+    /// @returns @c true if change notifications were dropped (or lost), and the folder
+    ///     will be scanned again once the backlog has room.
+    [[nodiscard]]
+    bool IsRescanNeeded() const noexcept
+        {
+        return m_rescanNeeded;
+        }
+
+    /// @brief How long a file must be quiet before it is scored (in milliseconds).
+    constexpr static int QUIET_INTERVAL{ 1000 };
+    /// @brief How often waiting files are handed to the workers (in milliseconds).
+    constexpr static int DISPATCH_INTERVAL{ 250 };
+    /// @brief How often the folder is scanned if change notifications are not
+    ///     available on this system (in milliseconds).
+    constexpr static int POLL_INTERVAL{ 5000 };
+    /// @brief The most files that can be waiting to be scored before notifications are
+    ///     dropped (and the folder is scanned again later).
+    constexpr static size_t MAX_PENDING_FILES{ 100'000 };
+
+  private:
+    struct FileState
+        {
+        wxLongLong m_modified{ 0 };
+        wxULongLong m_size{ 0 };
+
+        [[nodiscard]]
+        bool operator==(const FileState& that) const
+            {
+            return m_modified == that.m_modified && m_size == that.m_size;
+            }
+        };
+
+    /// @brief Reads the paths and file states of the results already in the store.
+    void LoadStoreIndex();
+    [[nodiscard]]
+    static bool ReadFileState(const wxString& path, FileState& state);
+    [[nodiscard]]
+    bool IsSupportedFile(const wxString& path) const;
+    /// @brief Queues the files in a folder that are new or changed since they were scored.
+    void ScanFolder(const wxString& folder);
+#ifdef __UNITTEST
+  public:
+#endif
+    /// @brief Marks a file as changed, to be scored once it is quiet.
+    void QueueFile(const wxString& path);
+    /// @brief Starts scoring quiet files, while there are free workers.
+    void DispatchFiles();
+    void OnFileRemoved(const wxString& path);
+#ifdef __UNITTEST
+  private:
+#endif
+    void OnFileScored(const ScoringEngine::Result& result, const FileState& state);
+    void AppendToStore(const wxString& path, const FileState& state, const std::string& record);
+
+#if wxUSE_FSWATCHER
+    void OnFileSystemEvent(wxFileSystemWatcherEvent& event);
+#endif
+    void OnDispatchTimer([[maybe_unused]] wxTimerEvent& event);
+    void OnPollTimer([[maybe_unused]] wxTimerEvent& event);
+
+    wxString m_folder;
+    wxString m_storePath;
+    size_t m_workerCount{ 1 };
+    std::unique_ptr<ScoringEngine> m_scorer;
+    // lowercased extensions of the document types that can be scored
+    std::set<wxString> m_extensions;
+
+    wxFFile m_store;
+    // the state of each file when it was last scored
+    std::map<wxString, FileState> m_scoredFiles;
+    // files waiting to be scored, with when they were last changed
+    std::map<wxString, wxLongLong> m_pendingFiles;
+    // files being scored by the workers
+    std::set<wxString> m_scoringFiles;
+    // files that were removed while being scored (their results are dropped)
+    std::set<wxString> m_removedWhileScoring;
+    std::vector<std::future<void>> m_workers;
+    // set if notifications were dropped (or lost), so the folder needs to be scanned again
+    bool m_rescanNeeded{ false };
+
+#if wxUSE_FSWATCHER
+    wxFileSystemWatcher* m_fileSystemWatcher{ nullptr };
+#endif
+    wxTimer m_dispatchTimer;
+    wxTimer m_pollTimer;
+    };
+
+#endif //__WATCH_FOLDER_SERVICE_H__
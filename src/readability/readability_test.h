@@ -15,7 +15,10 @@
 #define __READABILITY_TEST_H__
 
 #include <vector>
+#include <array>
 #include <bitset>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include "../indexing/character_traits.h"
 
@@ -62,6 +65,9 @@ namespace readability
         TEST_FACTOR_COUNT
         };
 
+    /// A set of test factors.
+    using test_factor_set = std::bitset<static_cast<size_t>(test_factor::TEST_FACTOR_COUNT)>;
+
     /// The type of student materials that a readability test is meant for.
     enum class test_teaching_level
         {
@@ -96,6 +102,143 @@ namespace readability
         INDUSTRY_CLASSIFICATION_COUNT
         };
 
+    /** @brief Compile-time keys for the standard (i.e., non-custom) tests.
+        @details These give each standard test a dense index, so that finding one in a
+            readability_test_collection is constant time. String IDs and names are then
+            only needed to resolve a test at API boundaries (e.g., project files, scripts,
+            or list column headers).*/
+    enum class test_key
+        {
+        ari,
+        coleman_liau,
+        dale_chall,
+        forcast,
+        flesch,
+        flesch_kincaid,
+        fry,
+        gunning_fog,
+        lix,
+        eflaw,
+        new_fog,
+        raygor,
+        rix,
+        simple_ari,
+        spache,
+        smog,
+        smog_simplified,
+        modified_smog,
+        psk_flesch,
+        harris_jacobson,
+        psk_dale_chall,
+        bormuth_cloze_mean,
+        bormuth_grade_placement_35,
+        psk_gunning_fog,
+        farr_jenkins_paterson,
+        new_farr_jenkins_paterson,
+        psk_farr_jenkins_paterson,
+        wheeler_smith,
+        gpm_fry,
+        frase,
+        crawford,
+        sol_spanish,
+        degrees_of_reading_power,
+        degrees_of_reading_power_ge,
+        new_ari,
+        flesch_kincaid_simplified,
+        dolch,
+        amstad,
+        smog_bamberger_vanecek,
+        wheeler_smith_bamberger_vanecek,
+        qu,
+        neue_wiener_sachtextformel1,
+        neue_wiener_sachtextformel2,
+        neue_wiener_sachtextformel3,
+        lix_german_childrens_literature,
+        lix_german_technical,
+        rix_german_fiction,
+        rix_german_nonfiction,
+        schwartz,
+        elf,
+        danielson_bryan_1,
+        danielson_bryan_2,
+        TEST_KEY_COUNT
+        };
+
+    /// @brief The string IDs of the standard tests, in the order of @c test_key.
+    /// @note These must match the IDs from @c ReadabilityMessages.
+    inline constexpr std::array<std::wstring_view, static_cast<size_t>(test_key::TEST_KEY_COUNT)>
+        standard_test_ids = {
+        L"ari-test",
+        L"coleman-liau-test",
+        L"dale-chall-test",
+        L"forcast-test",
+        L"flesch-test",
+        L"flesch-kincaid-test",
+        L"fry-test",
+        L"gunning-fog-test",
+        L"lix-test",
+        L"eflaw-test",
+        L"new-fog-count-test",
+        L"raygor-test",
+        L"rix-test",
+        L"new-ari-simplified",
+        L"spache-test",
+        L"smog-test",
+        L"smog-test-simplified",
+        L"modified-smog",
+        L"psk-test",
+        L"harris-jacobson",
+        L"psk-dale-chall",
+        L"bormuth-cloze-mean-machine-passage",
+        L"bormuth-grade-placement-35-machine-passage",
+        L"psk-fog",
+        L"farr-jenkins-paterson",
+        L"new-farr-jenkins-paterson",
+        L"psk-farr-jenkins-paterson",
+        L"wheeler-smith",
+        L"gilliam-pena-mountain-fry-graph",
+        L"frase",
+        L"crawford",
+        L"sol-spanish",
+        L"degrees-of-reading-power",
+        L"degrees-of-reading-power-grade-equivalent",
+        L"new-ari",
+        L"flesch-kincaid-test-simplified",
+        L"dolch",
+        L"amstad",
+        L"smog-bamberger-vanecek",
+        L"wheeler-smith-bamberger-vanecek",
+        L"qu-bamberger-vanecek",
+        L"neue-wiener-sachtextformel1",
+        L"neue-wiener-sachtextformel2",
+        L"neue-wiener-sachtextformel3",
+        L"lix-german-childrens-literature",
+        L"lix-german-technical",
+        L"rix-german-fiction",
+        L"rix-german-nonfiction",
+        L"schwartz",
+        L"easy-listening-formula",
+        L"danielson-bryan-1",
+        L"danielson-bryan-2",
+        };
+
+    /// @returns The key of the standard test with the given string ID, or
+    ///     @c test_key::TEST_KEY_COUNT if @c id is not a standard test's ID.
+    /// @param id The test's string ID.
+    [[nodiscard]]
+    constexpr test_key find_test_key(const std::wstring_view id) noexcept
+        {
+        for (size_t i = 0; i < standard_test_ids.size(); ++i)
+            {
+            if (standard_test_ids[i] == id)
+                { return static_cast<test_key>(i); }
+            }
+        return test_key::TEST_KEY_COUNT;
+        }
+
+    static_assert(find_test_key(L"flesch-test") == test_key::flesch);
+    static_assert(find_test_key(L"danielson-bryan-2") == test_key::danielson_bryan_2);
+
     class base_test
         {
     public:
@@ -207,6 +350,10 @@ namespace readability
             { return m_test_factors.test(static_cast<size_t>(factor)); }
         void reset_factors() noexcept
             { m_test_factors.reset(); }
+        /// @returns All the factors used in the test's equation.
+        [[nodiscard]]
+        const test_factor_set& get_factors() const noexcept
+            { return m_test_factors; }
 
         /// Teaching level for test
         void add_teaching_level(const test_teaching_level level)
@@ -227,8 +374,7 @@ namespace readability
         std::bitset<static_cast<size_t>(test_language::TEST_LANGUAGE_COUNT)>
             m_language{ 0 };
         // factors
-        std::bitset<static_cast<size_t>(test_factor::TEST_FACTOR_COUNT)>
-            m_test_factors{ 0 };
+        test_factor_set m_test_factors{ 0 };
         // teaching level
         std::bitset<static_cast<size_t>(test_teaching_level::TEST_TEACHING_LEVEL_COUNT)>
             m_teaching_level{ 0 };
@@ -278,7 +424,8 @@ namespace readability
             m_description(description),
             m_formula(formula),
             m_readability_test_type(test_type),
-            m_is_integral(is_integral)
+            m_is_integral(is_integral),
+            m_key(find_test_key(id))
             { m_interfaceId = interface_id; }
         /// Copy CTOR.
         explicit readability_test(const readability_test& that) :
@@ -289,7 +436,8 @@ namespace readability
             m_description(that.m_description),
             m_formula(that.m_formula),
             m_readability_test_type(that.m_readability_test_type),
-            m_is_integral(that.m_is_integral)
+            m_is_integral(that.m_is_integral),
+            m_key(that.m_key)
             {
             m_interfaceId = that.m_interfaceId;
             copy_classifications(that);
@@ -305,6 +453,7 @@ namespace readability
             m_formula = that.m_formula;
             m_readability_test_type = that.m_readability_test_type;
             m_is_integral = that.m_is_integral;
+            m_key = that.m_key;
             }
         [[nodiscard]]
         bool operator<(const readability_test& that) const noexcept
@@ -346,6 +495,11 @@ namespace readability
         [[nodiscard]]
         readability_test_type get_test_type() const noexcept
             { return m_readability_test_type; }
+        /// @returns The test's compile-time key, or @c test_key::TEST_KEY_COUNT
+        ///     if not a standard test.
+        [[nodiscard]]
+        test_key get_key() const noexcept
+            { return m_key; }
     private:
         // ID used in the project file
         string_type m_id;
@@ -356,6 +510,7 @@ namespace readability
         readability_test_type m_readability_test_type{ readability_test_type::grade_level };
         // whether test scores do NOT use floating-point precision (e.g., index tests)
         bool m_is_integral{ false };
+        test_key m_key{ test_key::TEST_KEY_COUNT };
         };
 
     /// Class to hold all of the tests for a project.
@@ -364,6 +519,9 @@ namespace readability
         {
     public:
         using string_type = traits::case_insensitive_wstring_ex;
+        /// @brief Constructor.
+        readability_test_collection() noexcept
+            { rebuild_key_index(); }
         /// Adds a test to the collection. Will only add it if not already in there.
         /// @param test The test to add.
         template<typename T>
@@ -373,6 +531,7 @@ namespace readability
                 { return; }
             auto pos = std::lower_bound(m_tests.begin(), m_tests.end(), test);
             m_tests.insert(pos, test_typeT(test));
+            rebuild_key_index();
             }
         /// Adds a collection of readability_test objects all at once.
         ///     Duplicates will be removed in here, and
@@ -389,6 +548,7 @@ namespace readability
                 std::unique(m_tests.begin(), m_tests.end());
             if (endOfUniquePos != m_tests.end())
                 { m_tests.erase(endOfUniquePos, m_tests.end()); }
+            rebuild_key_index();
             }
         /// @returns The number of tests in the collection.
         [[nodiscard]]
@@ -396,7 +556,10 @@ namespace readability
             { return m_tests.size(); }
         /// Removes all tests.
         void clear() noexcept
-            { m_tests.clear(); }
+            {
+            m_tests.clear();
+            rebuild_key_index();
+            }
         /// Reserves space before a bunch of calls to add_test.
         /// @param size The amount of space requested to reserve for x number of tests.
         void reserve(const size_t size)
@@ -477,6 +640,36 @@ namespace readability
             else
                 { return iterator->get_test().get_description(); }
             }
+        /// @brief Searches for a standard test by its compile-time key.
+        /// @details This is constant time, so it is preferred over searching by
+        ///     string in code that looks up tests repeatedly.
+        /// @param key The test's key.
+        /// @returns A pair: the iterator to the test and a boolean
+        ///     indicating whether the test was found or not.
+        [[nodiscard]]
+        std::pair<typename std::vector<test_typeT>::iterator, bool> find_test(const test_key key)
+            {
+            const size_t index = get_key_index(key);
+            return (index < m_tests.size()) ?
+                std::pair<typename std::vector<test_typeT>::iterator, bool>(
+                    m_tests.begin() + index, true) :
+                std::pair<typename std::vector<test_typeT>::iterator, bool>(m_tests.end(), false);
+            }
+        /// @brief Searches for a standard test by its compile-time key.
+        /// @param key The test's key.
+        /// @returns A pair: the iterator to the test and a boolean
+        ///     indicating whether the test was found or not.
+        [[nodiscard]]
+        std::pair<typename std::vector<test_typeT>::const_iterator, bool>
+            find_test(const test_key key) const
+            {
+            const size_t index = get_key_index(key);
+            return (index < m_tests.size()) ?
+                std::pair<typename std::vector<test_typeT>::const_iterator, bool>(
+                    m_tests.cbegin() + index, true) :
+                std::pair<typename std::vector<test_typeT>::const_iterator, bool>(m_tests.cend(),
+                                                                                  false);
+            }
         /// @brief Searches for a test.
         /// @param test The test to find (this key can be an ID
         ///     (the integer or string one), short name, or long name).
@@ -538,11 +731,54 @@ namespace readability
                 { return (test.get_test().get_test_type() == readability_test_type::grade_level ||
                           test.get_test().get_test_type() == readability_test_type::index_value_and_grade_level); });
             }
+        /// @returns The combined factors of the included tests.
+        /// @details Factors describe which statistics (e.g., which familiar-word lists)
+        ///     a test's equation depends on, so a project can use this to skip the
+        ///     analysis passes that none of its tests need.
+        [[nodiscard]]
+        test_factor_set get_included_test_factors() const
+            {
+            test_factor_set factors;
+            for (const auto& test : m_tests)
+                {
+                if (test.is_included())
+                    { factors |= as_test(test).get_factors(); }
+                }
+            return factors;
+            }
     private:
+        [[nodiscard]]
+        static const readability_test& as_test(const test_typeT& test) noexcept
+            {
+            if constexpr (std::is_base_of_v<readability_test, test_typeT>)
+                { return test; }
+            else
+                { return test.get_test(); }
+            }
+        [[nodiscard]]
+        size_t get_key_index(const test_key key) const noexcept
+            {
+            return (key < test_key::TEST_KEY_COUNT) ?
+                m_key_index[static_cast<size_t>(key)] : m_tests.size();
+            }
+        /// Maps the standard tests' keys to their (sorted) positions.
+        /// Must be called whenever tests are added or removed.
+        void rebuild_key_index() noexcept
+            {
+            m_key_index.fill(static_cast<size_t>(-1));
+            for (size_t i = 0; i < m_tests.size(); ++i)
+                {
+                const auto key = as_test(m_tests[i]).get_key();
+                if (key < test_key::TEST_KEY_COUNT)
+                    { m_key_index[static_cast<size_t>(key)] = i; }
+                }
+            }
         // Although this is a vector, the container keeps this sorted via the add_test* functions.
         // This is a vector so that can use the more liberal == operators for the tests,
         // rather than the < operator.
         std::vector<test_typeT> m_tests;
+        // positions of the standard tests in m_tests, indexed by test_key
+        std::array<size_t, static_cast<size_t>(test_key::TEST_KEY_COUNT)> m_key_index{};
         };
     }
 
@@ -2179,7 +2179,7 @@ wxString ProjectReportFormat::FormatStatisticsInfo(
                             wxNumberFormatter::Style::Style_WithThousandsSep));
                 }
             }
-        if (project->GetReadabilityTests().is_test_included(ReadabilityMessages::GUNNING_FOG()))
+        if (project->GetReadabilityTests().is_test_included(readability::test_key::gunning_fog))
             {
             // Fog
             htmlText += tableStart +
@@ -2361,7 +2361,7 @@ wxString ProjectReportFormat::FormatStatisticsInfo(
              SpecializedTestTextExclusion::ExcludeIncompleteSentencesExceptHeadings) ?
                 project->GetTotalNumeralsFromCompleteSentencesAndHeaders() :
                 project->GetTotalNumerals();
-        if (project->GetReadabilityTests().is_test_included(ReadabilityMessages::HARRIS_JACOBSON()))
+        if (project->GetReadabilityTests().is_test_included(readability::test_key::harris_jacobson))
             {
             // Harris-Jacobson
             htmlText += tableStart + formatHeader(_(L"Harris-Jacobson Unfamiliar Words"));
@@ -2442,7 +2442,7 @@ wxString ProjectReportFormat::FormatStatisticsInfo(
                 }
             }
 
-        if (project->GetReadabilityTests().is_test_included(ReadabilityMessages::SPACHE()))
+        if (project->GetReadabilityTests().is_test_included(readability::test_key::spache))
             {
             // Spache
             htmlText += tableStart + formatHeader(_(L"Spache Unfamiliar Words"));
@@ -2508,7 +2508,7 @@ wxString ProjectReportFormat::FormatStatisticsInfo(
                                               wxNumberFormatter::Style::Style_WithThousandsSep));
                 }
             }
-        if (project->GetReadabilityTests().is_test_included(ReadabilityMessages::EFLAW()))
+        if (project->GetReadabilityTests().is_test_included(readability::test_key::eflaw))
             {
             // EFLAW Miniwords
             htmlText += tableStart + formatHeader(_(L"McAlpine EFLAW Miniwords"));
@@ -0,0 +1,257 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "batch_findings_provider.h"
+#include <numeric>
+
+//------------------------------------------------------
+wxString BatchFindingsDataProvider::FormatFindings(const FindingsRecord& record) const
+    {
+    const bool useQuotes{ m_quoteMethod == QuoteMethod::AlwaysQuote ||
+                          record.m_findings.size() > 1 };
+    wxString findingsStr;
+    for (const auto& [findingId, frequency] : record.m_findings)
+        {
+        // quotes will be needed if a multiplier is being added
+        if (frequency > 1)
+            {
+            findingsStr.Append(L'\"')
+                .Append(m_stringPool->Get(findingId))
+                .Append(wxString::Format(L"\" * %u, ", frequency));
+            }
+        else if (useQuotes)
+            {
+            findingsStr.Append(L'\"').Append(m_stringPool->Get(findingId)).Append(L"\", ");
+            }
+        else
+            {
+            findingsStr.Append(m_stringPool->Get(findingId)).Append(L", ");
+            }
+        }
+    // chop off the last ", "
+    if (findingsStr.length() > 2)
+        {
+        findingsStr.RemoveLast(2);
+        }
+    return findingsStr;
+    }
+
+//------------------------------------------------------
+wxString BatchFindingsDataProvider::FormatSuggestions(const FindingsRecord& record) const
+    {
+    const bool useQuotes{ record.m_suggestions.size() > 1 };
+    wxString suggestionsStr;
+    for (const auto suggestionId : record.m_suggestions)
+        {
+        if (useQuotes)
+            {
+            suggestionsStr.Append(L'\"').Append(m_stringPool->Get(suggestionId)).Append(L"\", ");
+            }
+        else
+            {
+            suggestionsStr.Append(m_stringPool->Get(suggestionId)).Append(L", ");
+            }
+        }
+    if (suggestionsStr.length() > 2)
+        {
+        suggestionsStr.RemoveLast(2);
+        }
+    return suggestionsStr;
+    }
+
+//------------------------------------------------------
+wxString BatchFindingsDataProvider::GetItemText(const size_t row, const size_t column) const
+    {
+    if (row >= m_rows.size())
+        {
+        return wxString{};
+        }
+    const FindingsRecord& record = m_rows[row];
+    switch (column)
+        {
+    case 0:
+        return m_stringPool->Get(record.m_documentPath);
+    case 1:
+        return m_stringPool->Get(record.m_documentDescription);
+    case 2:
+        return std::to_wstring(record.m_totalCount);
+    case 3:
+        return FormatFindings(record);
+    case 4:
+        return m_includeSuggestions ? FormatSuggestions(record) : wxString{};
+    default:
+        return wxString{};
+        }
+    }
+
+//------------------------------------------------------
+wxString BatchFindingsDataProvider::GetItemTextFormatted(const size_t row,
+                                                         const size_t column) const
+    {
+    if (column == 2 && row < m_rows.size())
+        {
+        return wxNumberFormatter::ToString(static_cast<double>(m_rows[row].m_totalCount), 0,
+                                           wxNumberFormatter::Style::Style_WithThousandsSep);
+        }
+    return GetItemText(row, column);
+    }
+
+//------------------------------------------------------
+void BatchFindingsDataProvider::SetItemText(
+    [[maybe_unused]] const size_t row, [[maybe_unused]] const size_t column,
+    [[maybe_unused]] const wxString& text, [[maybe_unused]] const Wisteria::NumberFormatInfo format,
+    [[maybe_unused]] const double sortableValue)
+    {
+    wxFAIL_MSG(L"Batch findings are read only; use AddDocument() instead.");
+    }
+
+//------------------------------------------------------
+void BatchFindingsDataProvider::SetItemValue(
+    [[maybe_unused]] const size_t row, [[maybe_unused]] const size_t column,
+    [[maybe_unused]] const double value, [[maybe_unused]] const Wisteria::NumberFormatInfo format,
+    [[maybe_unused]] const double sortableValue)
+    {
+    wxFAIL_MSG(L"Batch findings are read only; use AddDocument() instead.");
+    }
+
+//------------------------------------------------------
+double BatchFindingsDataProvider::GetColumnSum(const size_t column) const
+    {
+    if (column != 2)
+        {
+        return 0;
+        }
+    double total{ 0 };
+    for (const auto& record : m_rows)
+        {
+        total += record.m_totalCount;
+        }
+    return total;
+    }
+
+//------------------------------------------------------
+wxString BatchFindingsDataProvider::GetSortKey(const FindingsRecord& record,
+                                               const size_t column) const
+    {
+    switch (column)
+        {
+    case 0:
+        return wxString{ m_stringPool->Get(record.m_documentPath) }.MakeLower();
+    case 1:
+        return wxString{ m_stringPool->Get(record.m_documentDescription) }.MakeLower();
+    case 3:
+        return FormatFindings(record).MakeLower();
+    case 4:
+        return m_includeSuggestions ? FormatSuggestions(record).MakeLower() : wxString{};
+    default:
+        return wxString{};
+        }
+    }
+
+//------------------------------------------------------
+void BatchFindingsDataProvider::Sort(const size_t column, const Wisteria::SortDirection direction,
+                                     size_t low /*= 0*/,
+                                     size_t high /*= static_cast<size_t>(-1)*/)
+    {
+    Sort(std::vector<std::pair<size_t, Wisteria::SortDirection>>{ { column, direction } }, low,
+         high);
+    }
+
+//------------------------------------------------------
+void BatchFindingsDataProvider::Sort(
+    const std::vector<std::pair<size_t, Wisteria::SortDirection>>& columns, size_t low /*= 0*/,
+    size_t high /*= static_cast<size_t>(-1)*/)
+    {
+    if (columns.empty() || m_rows.empty())
+        {
+        return;
+        }
+    high = std::min(high, m_rows.size());
+    if (low >= high)
+        {
+        return;
+        }
+
+    // Format each row's sort keys once up front (rather than formatting both rows
+    // for every comparison), then sort the rows' indices by those keys.
+    const size_t rowCount{ high - low };
+    std::vector<wxString> sortKeys(rowCount * columns.size());
+    for (size_t i = 0; i < rowCount; ++i)
+        {
+        for (size_t col = 0; col < columns.size(); ++col)
+            {
+            if (columns[col].first != 2)
+                {
+                sortKeys[(i * columns.size()) + col] =
+                    GetSortKey(m_rows[low + i], columns[col].first);
+                }
+            }
+        }
+
+    std::vector<size_t> sortedIndices(rowCount);
+    std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+    std::stable_sort(
+        sortedIndices.begin(), sortedIndices.end(),
+        [this, low, &columns, &sortKeys](const size_t first, const size_t second)
+        {
+            for (size_t col = 0; col < columns.size(); ++col)
+                {
+                const auto& [column, direction] = columns[col];
+                int result{ 0 };
+                if (column == 2)
+                    {
+                    const size_t firstCount{ m_rows[low + first].m_totalCount };
+                    const size_t secondCount{ m_rows[low + second].m_totalCount };
+                    result = (firstCount < secondCount) ? -1 : (firstCount > secondCount) ? 1 : 0;
+                    }
+                else
+                    {
+                    result = sortKeys[(first * columns.size()) + col].compare(
+                        sortKeys[(second * columns.size()) + col]);
+                    }
+                if (result != 0)
+                    {
+                    return (direction == Wisteria::SortDirection::SortAscending) ? (result < 0) :
+                                                                                   (result > 0);
+                    }
+                }
+            return false;
+        });
+
+    std::vector<FindingsRecord> sortedRows;
+    sortedRows.reserve(rowCount);
+    for (const auto index : sortedIndices)
+        {
+        sortedRows.push_back(std::move(m_rows[low + index]));
+        }
+    std::move(sortedRows.begin(), sortedRows.end(), m_rows.begin() + low);
+    }
+
+//------------------------------------------------------
+long BatchFindingsDataProvider::Find(const wchar_t* textToFind,
+                                     const size_t startIndex /*= 0*/) const
+    {
+    if (textToFind == nullptr)
+        {
+        return wxNOT_FOUND;
+        }
+    const wxString searchStr{ textToFind };
+    for (size_t i = startIndex; i < m_rows.size(); ++i)
+        {
+        if (searchStr.CmpNoCase(m_stringPool->Get(m_rows[i].m_documentPath)) == 0)
+            {
+            return static_cast<long>(i);
+            }
+        }
+    return wxNOT_FOUND;
+    }
@@ -0,0 +1,360 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef BATCH_FINDINGS_PROVIDER_H
+#define BATCH_FINDINGS_PROVIDER_H
+
+#include "../../Wisteria-Dataviz/src/ui/controls/listctrlexdataprovider.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <wx/numformatter.h>
+#include <wx/string.h>
+
+/// @brief Interned strings (file paths, labels, grammar findings, and suggestions)
+///     shared between a batch project's finding lists.
+/// @details Each string is stored once, no matter how many documents or
+///     lists refer to it. Strings are reference counted, so that they are removed
+///     once the last row using them is deleted (and their IDs are reused).
+class BatchFindingsStringPool
+    {
+  public:
+    /** @brief Adds a string to the pool (if not already in there).
+        @param str The string to add.
+        @returns The string's ID in the pool.
+        @note Each call should be balanced by a call to Release() once the
+            ID is no longer used.*/
+    [[nodiscard]]
+    uint32_t Intern(const wxString& str)
+        {
+        const auto [pos, inserted] = m_ids.try_emplace(str.ToStdWstring(), 0);
+        if (inserted)
+            {
+            if (!m_freeIds.empty())
+                {
+                pos->second = m_freeIds.back();
+                m_freeIds.pop_back();
+                m_strings[pos->second] = &pos->first;
+                }
+            else
+                {
+                pos->second = static_cast<uint32_t>(m_strings.size());
+                m_strings.push_back(&pos->first);
+                m_refCounts.push_back(0);
+                }
+            }
+        ++m_refCounts[pos->second];
+        return pos->second;
+        }
+
+    /** @brief Releases a reference to a string, removing it if nothing else uses it.
+        @param id The string's ID (from Intern()).*/
+    void Release(const uint32_t id)
+        {
+        if (id < m_refCounts.size() && m_refCounts[id] > 0 && --m_refCounts[id] == 0)
+            {
+            m_ids.erase(m_ids.find(*m_strings[id]));
+            m_strings[id] = nullptr;
+            m_freeIds.push_back(id);
+            }
+        }
+
+    /// @returns The string for an ID returned from Intern().
+    /// @param id The string's ID.
+    [[nodiscard]]
+    const std::wstring& Get(const uint32_t id) const
+        {
+        return *m_strings[id];
+        }
+
+    /// @returns The number of unique strings in the pool.
+    [[nodiscard]]
+    size_t GetCount() const noexcept
+        {
+        return m_ids.size();
+        }
+
+    /// @brief Empties the pool.
+    /// @warning Any ID previously returned by Intern() is invalidated.
+    void Clear()
+        {
+        m_strings.clear();
+        m_refCounts.clear();
+        m_freeIds.clear();
+        m_ids.clear();
+        }
+
+  private:
+    // node-based map, so the addresses of its keys are stable
+    std::unordered_map<std::wstring, uint32_t> m_ids;
+    std::vector<const std::wstring*> m_strings;
+    std::vector<uint32_t> m_refCounts;
+    // IDs of removed strings, which can be given to new ones
+    std::vector<uint32_t> m_freeIds;
+    };
+
+/** @brief Virtual list data for a batch project's per-document grammar findings
+        (e.g., passive voice, wordy phrases).
+    @details Each row is a compact record: the document's path and label, the number of
+        findings, and the unique findings (and optional suggestions) with their frequencies,
+        all as IDs into a shared BatchFindingsStringPool.\n
+        The cells are only formatted into strings when the list control asks for them
+        (i.e., when they are displayed, sorted, or exported), so memory scales with
+        the vocabulary of the findings rather than the number of formatted rows.\n
+        The columns are:
+        - Document path
+        - Document label
+        - Number of findings
+        - The findings (e.g., "\"very unique\" * 2, \"end result\"")
+        - The suggestions (if the list was constructed to include them)
+    @note This is read-only; cells can't be edited, but rows can be deleted.*/
+class BatchFindingsDataProvider final : public Wisteria::UI::ListCtrlExDataProviderBase
+    {
+  public:
+    /// @brief How findings are quoted when formatted.
+    enum class QuoteMethod
+        {
+        /// @brief Quote the findings if there is more than one
+        ///     (or if one has a multiplier).
+        QuoteIfMultiple,
+        /// @brief Always quote the findings.
+        AlwaysQuote
+        };
+
+    /** @brief Constructor.
+        @param stringPool The string pool to intern paths, labels, and findings into.
+        @param includeSuggestions @c true to include a column of suggestions.
+        @param quoteMethod How to quote findings.*/
+    BatchFindingsDataProvider(std::shared_ptr<BatchFindingsStringPool> stringPool,
+                              const bool includeSuggestions,
+                              const QuoteMethod quoteMethod = QuoteMethod::QuoteIfMultiple)
+        : m_stringPool(std::move(stringPool)), m_includeSuggestions(includeSuggestions),
+          m_quoteMethod(quoteMethod)
+        {
+        }
+
+    /// @private
+    BatchFindingsDataProvider(const BatchFindingsDataProvider&) = delete;
+    /// @private
+    BatchFindingsDataProvider& operator=(const BatchFindingsDataProvider&) = delete;
+
+    /// @private
+    ~BatchFindingsDataProvider() { DeleteAllItems(); }
+
+    /** @brief Adds a document's findings.
+        @param documentPath The document's file path.
+        @param documentDescription The document's label.
+        @param totalCount The total number of findings.
+        @param findings A map of unique findings and their frequencies
+            (e.g., a @c frequency_set's data).*/
+    template<typename findingsT>
+    void AddDocument(const wxString& documentPath, const wxString& documentDescription,
+                     const size_t totalCount, const findingsT& findings)
+        {
+        FindingsRecord record{ CreateRecord(documentPath, documentDescription, totalCount) };
+        record.m_findings.reserve(findings.size());
+        for (const auto& [finding, frequency] : findings)
+            {
+            record.m_findings.emplace_back(m_stringPool->Intern(finding.c_str()),
+                                           static_cast<uint32_t>(frequency));
+            }
+        m_rows.push_back(std::move(record));
+        }
+
+    /** @brief Adds a document's findings, along with suggestions for them.
+        @param documentPath The document's file path.
+        @param documentDescription The document's label.
+        @param findings A map of unique findings and a pair of their suggestion and frequency
+            (e.g., a @c frequency_map's data).
+        @note The total count is calculated from the findings' frequencies.*/
+    template<typename findingsT>
+    void AddDocumentWithSuggestions(const wxString& documentPath,
+                                    const wxString& documentDescription,
+                                    const findingsT& findings)
+        {
+        FindingsRecord record{ CreateRecord(documentPath, documentDescription, 0) };
+        record.m_findings.reserve(findings.size());
+        record.m_suggestions.reserve(findings.size());
+        for (const auto& [finding, suggestionAndFrequency] : findings)
+            {
+            record.m_findings.emplace_back(m_stringPool->Intern(finding.c_str()),
+                                           static_cast<uint32_t>(suggestionAndFrequency.second));
+            record.m_suggestions.push_back(m_stringPool->Intern(suggestionAndFrequency.first));
+            record.m_totalCount += suggestionAndFrequency.second;
+            }
+        m_rows.push_back(std::move(record));
+        }
+
+    /// @returns The sum of a numeric column.
+    /// @param column The column to total (only the count column is numeric).
+    [[nodiscard]]
+    double GetColumnSum(const size_t column) const;
+
+    // list control interface
+    //-----------------------
+
+    /// @private
+    [[nodiscard]]
+    wxString GetItemText(const size_t row, const size_t column) const final;
+    /// @private
+    [[nodiscard]]
+    wxString GetItemTextFormatted(const size_t row, const size_t column) const final;
+
+    /// @private
+    void SetItemText(const size_t row, const size_t column, const wxString& text,
+                     const Wisteria::NumberFormatInfo format =
+                         Wisteria::NumberFormatInfo::NumberFormatType::StandardFormatting,
+                     const double sortableValue = std::numeric_limits<double>::quiet_NaN()) final;
+    /// @private
+    void SetItemValue(const size_t row, const size_t column, const double value,
+                      const Wisteria::NumberFormatInfo format =
+                          Wisteria::NumberFormatInfo::NumberFormatType::StandardFormatting,
+                      const double sortableValue = std::numeric_limits<double>::quiet_NaN()) final;
+
+    /// @private
+    [[nodiscard]]
+    int GetItemImage([[maybe_unused]] const size_t row,
+                     [[maybe_unused]] const size_t column) const final
+        {
+        return -1;
+        }
+
+    /// @private
+    void SetItemImage([[maybe_unused]] const size_t row, [[maybe_unused]] const size_t column,
+                      [[maybe_unused]] const int image) final
+        {
+        }
+
+    /// @private
+    [[nodiscard]]
+    size_t GetItemCount() const final
+        {
+        return m_rows.size();
+        }
+
+    /// @private
+    [[nodiscard]]
+    size_t GetColumnCount() const final
+        {
+        return m_includeSuggestions ? 5 : 4;
+        }
+
+    /// @private
+    void DeleteAllItems() final { SetSize(0); }
+
+    /// @private
+    void DeleteItem(const size_t row) final
+        {
+        if (row < m_rows.size())
+            {
+            ReleaseRecord(m_rows[row]);
+            m_rows.erase(m_rows.begin() + row);
+            }
+        }
+
+    /// @private
+    void SetSize(const size_t rowCount) final
+        {
+        if (rowCount < m_rows.size())
+            {
+            std::for_each(m_rows.cbegin() + rowCount, m_rows.cend(),
+                          [this](const auto& record) { ReleaseRecord(record); });
+            m_rows.resize(rowCount);
+            }
+        }
+
+    /// @private
+    void SetSize(const size_t rowCount, [[maybe_unused]] const size_t columnCount) final
+        {
+        SetSize(rowCount);
+        }
+
+    /// @private
+    void SwapRows(const size_t row1, const size_t row2) final
+        {
+        if (row1 < m_rows.size() && row2 < m_rows.size())
+            {
+            std::swap(m_rows[row1], m_rows[row2]);
+            }
+        }
+
+    /// @private
+    void Sort(const size_t column, const Wisteria::SortDirection direction, size_t low = 0,
+              size_t high = static_cast<size_t>(-1)) final;
+    /// @private
+    void Sort(const std::vector<std::pair<size_t, Wisteria::SortDirection>>& columns,
+              size_t low = 0, size_t high = static_cast<size_t>(-1)) final;
+
+    /// @private
+    [[nodiscard]]
+    long Find(const wchar_t* textToFind, const size_t startIndex = 0) const final;
+
+  private:
+    /// @brief One document's findings.
+    struct FindingsRecord
+        {
+        uint32_t m_documentPath{ 0 };
+        uint32_t m_documentDescription{ 0 };
+        size_t m_totalCount{ 0 };
+        // IDs of the unique findings and their frequencies
+        std::vector<std::pair<uint32_t, uint32_t>> m_findings;
+        // IDs of the suggestions (parallel with the findings)
+        std::vector<uint32_t> m_suggestions;
+        };
+
+    [[nodiscard]]
+    FindingsRecord CreateRecord(const wxString& documentPath, const wxString& documentDescription,
+                                const size_t totalCount)
+        {
+        FindingsRecord record;
+        record.m_documentPath = m_stringPool->Intern(documentPath);
+        record.m_documentDescription = m_stringPool->Intern(documentDescription);
+        record.m_totalCount = totalCount;
+        return record;
+        }
+
+    /// @brief Releases the pooled strings that a record uses.
+    void ReleaseRecord(const FindingsRecord& record)
+        {
+        m_stringPool->Release(record.m_documentPath);
+        m_stringPool->Release(record.m_documentDescription);
+        for (const auto& [findingId, frequency] : record.m_findings)
+            {
+            m_stringPool->Release(findingId);
+            }
+        for (const auto suggestionId : record.m_suggestions)
+            {
+            m_stringPool->Release(suggestionId);
+            }
+        }
+
+    [[nodiscard]]
+    wxString FormatFindings(const FindingsRecord& record) const;
+    [[nodiscard]]
+    wxString FormatSuggestions(const FindingsRecord& record) const;
+    /// @returns The (lowercased) text that a row is sorted by for a (non-numeric) column.
+    [[nodiscard]]
+    wxString GetSortKey(const FindingsRecord& record, const size_t column) const;
+
+    std::shared_ptr<BatchFindingsStringPool> m_stringPool;
+    std::vector<FindingsRecord> m_rows;
+    bool m_includeSuggestions{ false };
+    QuoteMethod m_quoteMethod{ QuoteMethod::QuoteIfMultiple };
+    };
+
+#endif // BATCH_FINDINGS_PROVIDER_H
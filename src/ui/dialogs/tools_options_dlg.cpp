@@ -3444,20 +3444,16 @@ void ToolsOptionsDlg::CreateControls()
             panelSizer->Add(m_docStorageRadioBox,
                             wxSizerFlags{}.Border(wxLEFT, OPTION_INDENT_SIZE));
 
-            // not relevant with batch projects
-            if (IsGeneralSettings() || IsStandardProjectSettings())
-                {
-                panelSizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
-
-                m_realTimeUpdateCheckBox = new wxCheckBox(
-                    projectSettingsPage, ID_REALTIME_UPDATE_BUTTON, _(L"Real-time update"),
-                    wxDefaultPosition, wxDefaultSize, 0, wxGenericValidator(&m_realTimeUpdate));
-                m_realTimeUpdateCheckBox->Enable(
-                    static_cast<TextStorage>(m_documentStorageMethod.get_value()) ==
-                    TextStorage::NoEmbedText);
-                panelSizer->Add(m_realTimeUpdateCheckBox,
-                                wxSizerFlags{}.Border(wxLEFT, OPTION_INDENT_SIZE));
-                }
+            panelSizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
+
+            m_realTimeUpdateCheckBox = new wxCheckBox(
+                projectSettingsPage, ID_REALTIME_UPDATE_BUTTON, _(L"Real-time update"),
+                wxDefaultPosition, wxDefaultSize, 0, wxGenericValidator(&m_realTimeUpdate));
+            m_realTimeUpdateCheckBox->Enable(
+                static_cast<TextStorage>(m_documentStorageMethod.get_value()) ==
+                TextStorage::NoEmbedText);
+            panelSizer->Add(m_realTimeUpdateCheckBox,
+                            wxSizerFlags{}.Border(wxLEFT, OPTION_INDENT_SIZE));
 
             panelSizer->AddSpacer(wxSizerFlags::GetDefaultBorder());
             }
@@ -0,0 +1,278 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "visitedurlset.h"
+#include <wx/log.h>
+
+namespace
+    {
+    // file signature for saved sets
+    constexpr char URL_SET_SIGNATURE[8]{ 'R', 'S', 'U', 'R', 'L', 'S', 'E', 'T' };
+    constexpr uint32_t URL_SET_VERSION{ 1 };
+    // number of hashes to buffer when reading/writing files
+    constexpr size_t HASH_BLOCK_SIZE{ 4096 };
+    } // namespace
+
+//----------------------------------
+uint64_t VisitedUrlSet::HashUrl(const wxString& url)
+    {
+    // same normalization that wxStringLessWebPath uses for comparisons
+    // (after resolving), but done once per URL instead of once per comparison
+    wxString path{ url };
+    if (path.length() > 0 && path[path.length() - 1] == L'/')
+        {
+        path.RemoveLast();
+        }
+    path.MakeLower();
+
+    // 64-bit FNV-1a
+    uint64_t hashValue{ 14'695'981'039'346'656'037ULL };
+    for (const auto ch : path)
+        {
+        hashValue ^= static_cast<uint64_t>(static_cast<wxChar>(ch));
+        hashValue *= 1'099'511'628'211ULL;
+        }
+    return (hashValue == EMPTY_SLOT) ? 1 : hashValue;
+    }
+
+//----------------------------------
+bool VisitedUrlSet::InsertHash(const uint64_t hashValue)
+    {
+    if (ContainsHash(hashValue))
+        {
+        return false;
+        }
+    // keep load factor under 50%
+    if ((m_tableCount + 1) * 2 > m_table.size())
+        {
+        Grow();
+        }
+    const size_t mask = m_table.size() - 1;
+    size_t slot = hashValue & mask;
+    while (m_table[slot] != EMPTY_SLOT)
+        {
+        slot = (slot + 1) & mask;
+        }
+    m_table[slot] = hashValue;
+    ++m_tableCount;
+
+    if (m_maxInMemory > 0 && m_tableCount >= m_maxInMemory)
+        {
+        Spill();
+        }
+    return true;
+    }
+
+//----------------------------------
+bool VisitedUrlSet::ContainsHash(const uint64_t hashValue) const
+    {
+    if (!m_table.empty())
+        {
+        const size_t mask = m_table.size() - 1;
+        size_t slot = hashValue & mask;
+        while (m_table[slot] != EMPTY_SLOT)
+            {
+            if (m_table[slot] == hashValue)
+                {
+                return true;
+                }
+            slot = (slot + 1) & mask;
+            }
+        }
+    return IsInBloomFilter(hashValue);
+    }
+
+//----------------------------------
+void VisitedUrlSet::Grow()
+    {
+    std::vector<uint64_t> oldTable;
+    oldTable.swap(m_table);
+    m_table.resize(oldTable.empty() ? 1024 : oldTable.size() * 2, EMPTY_SLOT);
+    const size_t mask = m_table.size() - 1;
+    for (const auto hashValue : oldTable)
+        {
+        if (hashValue != EMPTY_SLOT)
+            {
+            size_t slot = hashValue & mask;
+            while (m_table[slot] != EMPTY_SLOT)
+                {
+                slot = (slot + 1) & mask;
+                }
+            m_table[slot] = hashValue;
+            }
+        }
+    }
+
+//----------------------------------
+void VisitedUrlSet::SpillToDisk(const size_t maxInMemory, const size_t expectedUrls,
+                                const double falsePositiveRate)
+    {
+    m_maxInMemory = maxInMemory;
+    if (m_maxInMemory == 0 || !m_bloomBits.empty())
+        {
+        return;
+        }
+    // standard Bloom filter sizing: m = -n*ln(p) / ln(2)^2, k = (m/n)*ln(2)
+    const double urlCount = static_cast<double>(std::max<size_t>(expectedUrls, maxInMemory));
+    const double bitCount =
+        std::ceil(-urlCount * std::log(falsePositiveRate) / (std::log(2.0) * std::log(2.0)));
+    m_bloomBits.resize(static_cast<size_t>(bitCount), false);
+    m_bloomHashCount =
+        std::max<size_t>(1, static_cast<size_t>(std::round((bitCount / urlCount) * std::log(2.0))));
+
+    if (m_tableCount >= m_maxInMemory)
+        {
+        Spill();
+        }
+    }
+
+//----------------------------------
+void VisitedUrlSet::Spill()
+    {
+    if (m_spillFilePath.empty())
+        {
+        m_spillFilePath = wxFileName::CreateTempFileName(L"rsurls");
+        }
+    wxFile spillFile(m_spillFilePath, wxFile::write_append);
+    if (!spillFile.IsOpened())
+        {
+        // keep everything in memory rather than lose URLs
+        wxLogWarning(L"Unable to open URL spill file '%s'.", m_spillFilePath);
+        m_maxInMemory = 0;
+        return;
+        }
+
+    std::vector<uint64_t> block;
+    block.reserve(HASH_BLOCK_SIZE);
+    for (const auto hashValue : m_table)
+        {
+        if (hashValue != EMPTY_SLOT)
+            {
+            AddToBloomFilter(hashValue);
+            block.push_back(hashValue);
+            if (block.size() == HASH_BLOCK_SIZE)
+                {
+                spillFile.Write(block.data(), block.size() * sizeof(uint64_t));
+                block.clear();
+                }
+            }
+        }
+    if (!block.empty())
+        {
+        spillFile.Write(block.data(), block.size() * sizeof(uint64_t));
+        }
+
+    m_spilledCount += m_tableCount;
+    m_tableCount = 0;
+    std::fill(m_table.begin(), m_table.end(), EMPTY_SLOT);
+    }
+
+//----------------------------------
+void VisitedUrlSet::RemoveSpillFile()
+    {
+    if (!m_spillFilePath.empty() && wxFileName::FileExists(m_spillFilePath))
+        {
+        wxRemoveFile(m_spillFilePath);
+        }
+    m_spillFilePath.clear();
+    }
+
+//----------------------------------
+void VisitedUrlSet::Clear()
+    {
+    m_table.clear();
+    m_tableCount = 0;
+    m_spilledCount = 0;
+    std::fill(m_bloomBits.begin(), m_bloomBits.end(), false);
+    RemoveSpillFile();
+    }
+
+//----------------------------------
+bool VisitedUrlSet::Save(const wxString& filePath) const
+    {
+    wxFile outFile(filePath, wxFile::write);
+    if (!outFile.IsOpened())
+        {
+        return false;
+        }
+    const uint64_t hashCount{ GetCount() };
+    outFile.Write(URL_SET_SIGNATURE, sizeof(URL_SET_SIGNATURE));
+    outFile.Write(&URL_SET_VERSION, sizeof(URL_SET_VERSION));
+    outFile.Write(&hashCount, sizeof(hashCount));
+
+    // exact hashes that were spilled to disk
+    if (m_spilledCount > 0)
+        {
+        wxFile spillFile(m_spillFilePath, wxFile::read);
+        if (!spillFile.IsOpened())
+            {
+            return false;
+            }
+        std::vector<uint64_t> block(HASH_BLOCK_SIZE);
+        ssize_t bytesRead{ 0 };
+        while ((bytesRead = spillFile.Read(block.data(), block.size() * sizeof(uint64_t))) > 0)
+            {
+            outFile.Write(block.data(), static_cast<size_t>(bytesRead));
+            }
+        }
+    // ...and the ones still in memory
+    for (const auto hashValue : m_table)
+        {
+        if (hashValue != EMPTY_SLOT)
+            {
+            outFile.Write(&hashValue, sizeof(hashValue));
+            }
+        }
+    return outFile.Close();
+    }
+
+//----------------------------------
+bool VisitedUrlSet::Load(const wxString& filePath)
+    {
+    wxFile inFile(filePath, wxFile::read);
+    if (!inFile.IsOpened())
+        {
+        return false;
+        }
+    char signature[sizeof(URL_SET_SIGNATURE)]{ 0 };
+    uint32_t version{ 0 };
+    uint64_t hashCount{ 0 };
+    if (inFile.Read(signature, sizeof(signature)) != sizeof(signature) ||
+        !std::equal(std::cbegin(signature), std::cend(signature),
+                    std::cbegin(URL_SET_SIGNATURE)) ||
+        inFile.Read(&version, sizeof(version)) != sizeof(version) ||
+        version > URL_SET_VERSION ||
+        inFile.Read(&hashCount, sizeof(hashCount)) != sizeof(hashCount))
+        {
+        wxLogWarning(L"'%s': invalid URL set file.", filePath);
+        return false;
+        }
+
+    std::vector<uint64_t> block(HASH_BLOCK_SIZE);
+    while (hashCount > 0)
+        {
+        const size_t toRead = std::min<uint64_t>(hashCount, block.size());
+        if (inFile.Read(block.data(), toRead * sizeof(uint64_t)) !=
+            static_cast<ssize_t>(toRead * sizeof(uint64_t)))
+            {
+            wxLogWarning(L"'%s': URL set file is truncated.", filePath);
+            return false;
+            }
+        for (size_t i = 0; i < toRead; ++i)
+            {
+            InsertHash(block[i]);
+            }
+        hashCount -= toRead;
+        }
+    return true;
+    }
@@ -0,0 +1,158 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef VISITED_URL_SET_H
+#define VISITED_URL_SET_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+/** @brief Compact set of URLs that have been seen while crawling.
+    @details URLs are normalized (trailing '/' removed and lowercased) and stored as
+        64-bit hashes in an open-addressing table, rather than as full strings. This makes
+        lookups constant time and keeps memory to eight bytes per URL.\n
+        For very large crawls, a memory cap can be set via SpillToDisk(). Once the in-memory
+        table reaches that cap, its hashes are appended to a temporary file and folded into
+        a Bloom filter, and the table is emptied. From that point, lookups may (rarely)
+        report an URL as seen when it was not, but will never miss an URL that was seen.
+    @note The set can be saved and reloaded via Save() and Load(), which is how a crawl
+        can be resumed later.\n
+        URLs should be resolved (e.g., via FilePathResolver) by the caller before being
+        added or looked up.*/
+class VisitedUrlSet
+    {
+  public:
+    /// @private
+    VisitedUrlSet() = default;
+    /// @private
+    VisitedUrlSet(const VisitedUrlSet&) = delete;
+    /// @private
+    VisitedUrlSet& operator=(const VisitedUrlSet&) = delete;
+
+    /// @private
+    ~VisitedUrlSet() { RemoveSpillFile(); }
+
+    /** @brief Adds an URL to the set.
+        @param url The URL to add.
+        @returns @c true if the URL was not already in the set.*/
+    bool Insert(const wxString& url) { return InsertHash(HashUrl(url)); }
+
+    /** @returns @c true if @c url (or an URL that normalizes to the same path)
+            is in the set.
+        @param url The URL to look for.*/
+    [[nodiscard]]
+    bool Contains(const wxString& url) const
+        {
+        return ContainsHash(HashUrl(url));
+        }
+
+    /// @brief Empties the set and removes any spill file.
+    void Clear();
+
+    /// @returns The number of URLs added to the set.
+    [[nodiscard]]
+    size_t GetCount() const noexcept
+        {
+        return m_tableCount + m_spilledCount;
+        }
+
+    /** @brief Caps the number of URL hashes held in memory.
+        @details When the cap is reached, the in-memory hashes are moved into a
+            Bloom filter (backed by a spill file on disk) sized for @c expectedUrls.
+        @param maxInMemory The maximum number of hashes to keep in the exact table.
+            @c 0 disables spilling (the default).
+        @param expectedUrls The total number of URLs expected over the crawl;
+            used to size the Bloom filter.
+        @param falsePositiveRate The accepted rate of URLs being reported
+            as seen when they weren't.*/
+    void SpillToDisk(const size_t maxInMemory, const size_t expectedUrls = 10'000'000,
+                     const double falsePositiveRate = 0.0001);
+
+    /** @brief Saves the set to a file.
+        @param filePath The file to save to.
+        @returns @c true if successful.*/
+    bool Save(const wxString& filePath) const;
+    /** @brief Loads a set previously written by Save(), appending to the current set.
+        @param filePath The file to load.
+        @returns @c true if successful.*/
+    bool Load(const wxString& filePath);
+
+    /** @returns The normalized 64-bit hash of an URL.
+        @param url The URL to hash.*/
+    [[nodiscard]]
+    static uint64_t HashUrl(const wxString& url);
+
+  private:
+    bool InsertHash(uint64_t hashValue);
+    [[nodiscard]]
+    bool ContainsHash(uint64_t hashValue) const;
+    void Grow();
+    void Spill();
+    void RemoveSpillFile();
+
+    void AddToBloomFilter(const uint64_t hashValue)
+        {
+        const auto [firstHash, secondHash] = SplitHash(hashValue);
+        for (size_t i = 0; i < m_bloomHashCount; ++i)
+            {
+            const uint64_t bit = (firstHash + (i * secondHash)) % m_bloomBits.size();
+            m_bloomBits[bit] = true;
+            }
+        }
+
+    [[nodiscard]]
+    bool IsInBloomFilter(const uint64_t hashValue) const
+        {
+        if (m_bloomBits.empty())
+            {
+            return false;
+            }
+        const auto [firstHash, secondHash] = SplitHash(hashValue);
+        for (size_t i = 0; i < m_bloomHashCount; ++i)
+            {
+            const uint64_t bit = (firstHash + (i * secondHash)) % m_bloomBits.size();
+            if (!m_bloomBits[bit])
+                {
+                return false;
+                }
+            }
+        return true;
+        }
+
+    /// Kirsch-Mitzenmacher: two halves of one 64-bit hash emulate k independent hashes.
+    [[nodiscard]]
+    static std::pair<uint64_t, uint64_t> SplitHash(const uint64_t hashValue) noexcept
+        {
+        return { hashValue & 0xFFFFFFFF, (hashValue >> 32) | 1 };
+        }
+
+    // zero marks an empty slot, so hashes of zero are remapped to one
+    constexpr static uint64_t EMPTY_SLOT{ 0 };
+
+    std::vector<uint64_t> m_table;
+    size_t m_tableCount{ 0 };
+
+    size_t m_maxInMemory{ 0 };
+    size_t m_spilledCount{ 0 };
+    std::vector<bool> m_bloomBits;
+    size_t m_bloomHashCount{ 0 };
+    wxString m_spillFilePath;
+    };
+
+#endif // VISITED_URL_SET_H
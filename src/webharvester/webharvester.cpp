@@ -13,6 +13,7 @@
 
 #include "webharvester.h"
 #include "filepathresolver.h"
+#include <wx/textfile.h>
 
 //----------------------------------
 bool wxStringLessWebPath::operator()(const wxString& first, const wxString& second) const
@@ -31,6 +32,13 @@ bool wxStringLessWebPath::operator()(const wxString& first, const wxString& seco
     return (firstPath.CmpNoCase(secondPath) < 0);
     }
 
+//----------------------------------
+wxString WebHarvester::ResolveVisitedUrl(const wxString& url)
+    {
+    FilePathResolver resolver;
+    return resolver.ResolvePath(url, true);
+    }
+
 //----------------------------------
 wxString WebHarvester::DownloadFile(wxString& Url, const wxString& fileExtension /*= wxString{}*/)
     {
@@ -403,6 +411,97 @@ void WebHarvester::DownloadFiles()
         }
     }
 
+//----------------------------------
+bool WebHarvester::SaveCrawlState(const wxString& folderPath) const
+    {
+    if (!wxFileName::DirExists(folderPath) &&
+        !wxFileName::Mkdir(folderPath, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+        {
+        return false;
+        }
+    if (!m_alreadyCrawledFiles.Save(
+            wxFileName{ folderPath, _DT(L"crawled.bin") }.GetFullPath()) ||
+        !m_harvestedUrls.Save(wxFileName{ folderPath, _DT(L"harvested.bin") }.GetFullPath()))
+        {
+        return false;
+        }
+
+    wxTextFile harvestedFile(wxFileName{ folderPath, _DT(L"harvested.txt") }.GetFullPath());
+    if (harvestedFile.Exists() ? !harvestedFile.Open() : !harvestedFile.Create())
+        {
+        return false;
+        }
+    harvestedFile.Clear();
+    for (const auto& link : m_harvestedLinks)
+        {
+        harvestedFile.AddLine(link);
+        }
+
+    // pages that were interrupted (with their depth levels)
+    wxTextFile pendingFile(wxFileName{ folderPath, _DT(L"pending.txt") }.GetFullPath());
+    if (pendingFile.Exists() ? !pendingFile.Open() : !pendingFile.Create())
+        {
+        return false;
+        }
+    pendingFile.Clear();
+    for (const auto& [pendingUrl, pendingLevel] : m_crawlStack)
+        {
+        pendingFile.AddLine(wxString::Format(L"%zu\t%s", pendingLevel, pendingUrl));
+        }
+
+    return harvestedFile.Write(wxTextFileType_None, wxConvUTF8) &&
+           pendingFile.Write(wxTextFileType_None, wxConvUTF8);
+    }
+
+//----------------------------------
+bool WebHarvester::LoadCrawlState(const wxString& folderPath)
+    {
+    m_harvestedLinks.clear();
+    m_harvestedUrls.Clear();
+    m_alreadyCrawledFiles.Clear();
+    m_crawlStack.clear();
+    m_resumeCrawl = false;
+
+    if (!m_alreadyCrawledFiles.Load(
+            wxFileName{ folderPath, _DT(L"crawled.bin") }.GetFullPath()) ||
+        !m_harvestedUrls.Load(wxFileName{ folderPath, _DT(L"harvested.bin") }.GetFullPath()))
+        {
+        wxLogWarning(L"'%s': unable to load crawl state.", folderPath);
+        return false;
+        }
+
+    wxTextFile harvestedFile;
+    if (harvestedFile.Open(wxFileName{ folderPath, _DT(L"harvested.txt") }.GetFullPath(),
+                           wxConvUTF8))
+        {
+        for (size_t i = 0; i < harvestedFile.GetLineCount(); ++i)
+            {
+            if (!harvestedFile[i].empty())
+                {
+                m_harvestedLinks.push_back(harvestedFile[i]);
+                }
+            }
+        }
+
+    wxTextFile pendingFile;
+    if (pendingFile.Open(wxFileName{ folderPath, _DT(L"pending.txt") }.GetFullPath(),
+                         wxConvUTF8))
+        {
+        for (size_t i = 0; i < pendingFile.GetLineCount(); ++i)
+            {
+            unsigned long pendingLevel{ 0 };
+            const wxString pendingUrl = pendingFile[i].AfterFirst(L'\t');
+            if (!pendingUrl.empty() && pendingFile[i].BeforeFirst(L'\t').ToULong(&pendingLevel))
+                {
+                m_crawlStack.emplace_back(pendingUrl, static_cast<size_t>(pendingLevel));
+                }
+            }
+        }
+
+    m_resumeCrawl = true;
+    return true;
+    }
+
 //----------------------------------
 bool WebHarvester::CrawlLinks()
     {
@@ -420,13 +519,38 @@ bool WebHarvester::CrawlLinks()
     m_isCancelled = false;
     m_currentLevel = 0;
 
-    m_harvestedLinks.clear();
     m_downloadedFiles.clear();
     m_brokenLinks.clear();
-    m_alreadyCrawledFiles.clear();
+    if (m_resumeCrawl)
+        {
+        // finish crawling the pages that were interrupted last time
+        // (outermost first), then fall through to the root URL (which will
+        // be skipped if it was already fully crawled)
+        m_resumeCrawl = false;
+        auto pendingCrawls{ std::move(m_crawlStack) };
+        m_crawlStack.clear();
+        for (auto& [pendingUrl, pendingLevel] : pendingCrawls)
+            {
+            if (m_isCancelled)
+                {
+                break;
+                }
+            m_currentLevel = (pendingLevel > 0) ? pendingLevel - 1 : 0;
+            CrawlLinks(pendingUrl, html_utilities::hyperlink_parse::hyperlink_parse_method::html,
+                       true);
+            }
+        m_currentLevel = 0;
+        }
+    else
+        {
+        m_harvestedLinks.clear();
+        m_harvestedUrls.Clear();
+        m_alreadyCrawledFiles.Clear();
+        m_crawlStack.clear();
+        }
     // depth level of zero means that we just want to download the root URL and don't actually
     // crawl anything
-    if (GetDepthLevel() > 0)
+    if (!m_isCancelled && GetDepthLevel() > 0)
         {
         CrawlLinks(m_url, html_utilities::hyperlink_parse::hyperlink_parse_method::html);
         }
@@ -461,9 +585,10 @@ bool WebHarvester::CrawlLinks()
 
 //----------------------------------
 bool WebHarvester::CrawlLinks(wxString& url,
-                              const html_utilities::hyperlink_parse::hyperlink_parse_method method)
+                              const html_utilities::hyperlink_parse::hyperlink_parse_method method,
+                              const bool resuming /*= false*/)
     {
-    if (m_isCancelled || url.empty() || HasUrlAlreadyBeenCrawled(url))
+    if (m_isCancelled || url.empty() || (!resuming && HasUrlAlreadyBeenCrawled(url)))
         {
         return false;
         }
@@ -487,7 +612,7 @@ bool WebHarvester::CrawlLinks(wxString& url,
             {
             --m_currentLevel;
             // don't bother trying to crawl this later if it failed
-            m_alreadyCrawledFiles.insert(url);
+            m_alreadyCrawledFiles.Insert(ResolveVisitedUrl(url));
             return false;
             }
         if (m_useJsCookies)
@@ -515,7 +640,7 @@ bool WebHarvester::CrawlLinks(wxString& url,
                     {
                     --m_currentLevel;
                     // don't bother trying to crawl this later if it failed
-                    m_alreadyCrawledFiles.insert(url);
+                    m_alreadyCrawledFiles.Insert(ResolveVisitedUrl(url));
                     return false;
                     }
 
@@ -539,18 +664,21 @@ bool WebHarvester::CrawlLinks(wxString& url,
     if (!VerifyUrlDomainCriteria(url))
         {
         // prevent crawling it later if it doesn't meet our criteria
-        m_alreadyCrawledFiles.insert(url);
+        m_alreadyCrawledFiles.Insert(ResolveVisitedUrl(url));
         --m_currentLevel;
         return false;
         }
-    if (HasUrlAlreadyBeenCrawled(url))
+
+    // it's ready to be crawled now, so marked it as crawled for later
+    // (if it was already marked, then it's either been crawled or we are resuming it)
+    if (!m_alreadyCrawledFiles.Insert(ResolveVisitedUrl(url)) && !resuming)
         {
         --m_currentLevel;
         return false;
         }
-
-    // it's ready to be crawled now, so marked it as crawled for later
-    m_alreadyCrawledFiles.insert(url);
+    // track it until all of its links are processed, so that an interrupted
+    // crawl can be resumed from here (left in place if cancelled)
+    m_crawlStack.emplace_back(url, m_currentLevel);
 
     wxYield();
     if (m_progressDlg)
@@ -598,6 +726,7 @@ bool WebHarvester::CrawlLinks(wxString& url,
             return false;
             }
         }
+    m_crawlStack.pop_back();
     --m_currentLevel;
 
     return true;
@@ -878,7 +1007,8 @@ bool WebHarvester::HarvestLink(wxString& url, const wxString& fileExtension)
         {
         return false;
         }
-    m_harvestedLinks.insert(url);
+    m_harvestedUrls.Insert(ResolveVisitedUrl(url));
+    m_harvestedLinks.push_back(url);
     if (IsDownloadingFilesWhileCrawling())
         {
         wxString downloadPath = DownloadFile(url, fileExtension);
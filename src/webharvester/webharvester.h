@@ -20,12 +20,14 @@
 #include "../Wisteria-Dataviz/src/util/downloadfile.h"
 #include "../Wisteria-Dataviz/src/util/fileutil.h"
 #include "../Wisteria-Dataviz/src/util/textstream.h"
+#include "visitedurlset.h"
 #include <algorithm>
 #include <functional>
 #include <limits>
 #include <optional>
 #include <set>
 #include <string_view>
+#include <vector>
 #include <wx/dir.h>
 #include <wx/file.h>
 #include <wx/filename.h>
@@ -456,13 +458,40 @@ class WebHarvester
     /// @param handler The @c wxEvtHandler to connect the downloader to.
     void SetEventHandler(wxEvtHandler* handler) { m_downloader.SetAndBindEventHandler(handler); }
 
-    /// @returns The list of harvested links.
+    /// @returns The list of harvested links, in the order that they were found.
     [[nodiscard]]
-    const std::set<wxString, wxStringLessWebPath>& GetHarvestedLinks() const noexcept
+    const std::vector<wxString>& GetHarvestedLinks() const noexcept
         {
         return m_harvestedLinks;
         }
 
+    /** @brief Limits how many crawled and harvested URLs are tracked in memory.
+        @details Seen URLs are tracked as 64-bit hashes. For crawls with millions of links,
+            setting this will move older hashes into a Bloom filter backed by a temporary
+            file once the limit is reached.
+        @param maxUrls The maximum number of URLs (per set) to hold in memory exactly.
+            @c 0 (the default) keeps everything in memory.
+        @param expectedUrls The total number of URLs expected over the crawl.
+        @note Once spilling, an URL may (very rarely) be skipped as a false positive.*/
+    void SetMaxInMemoryUrls(const size_t maxUrls, const size_t expectedUrls = 10'000'000)
+        {
+        m_alreadyCrawledFiles.SpillToDisk(maxUrls, expectedUrls);
+        m_harvestedUrls.SpillToDisk(maxUrls, expectedUrls);
+        }
+
+    /** @brief Saves the current crawl state (crawled and harvested links, and the
+            pages still being crawled if cancelled) into a folder.
+        @param folderPath The folder to save the state files into.
+        @returns @c true if successful.
+        @sa LoadCrawlState().*/
+    bool SaveCrawlState(const wxString& folderPath) const;
+    /** @brief Loads a crawl state previously saved with SaveCrawlState().
+        @details The next call to CrawlLinks() will then resume from this state,
+            rather than starting over.
+        @param folderPath The folder containing the state files.
+        @returns @c true if successful.*/
+    bool LoadCrawlState(const wxString& folderPath);
+
     /// @returns The list of files downloaded.
     /// @note DownloadFilesWhileCrawling() must be enabled.
     [[nodiscard]]
@@ -632,21 +661,26 @@ class WebHarvester
     bool HarvestLink(wxString& url, const wxString& fileExtension);
     //----------------------------------
     bool CrawlLinks(wxString& url,
-                    const html_utilities::hyperlink_parse::hyperlink_parse_method method);
+                    const html_utilities::hyperlink_parse::hyperlink_parse_method method,
+                    const bool resuming = false);
     // cppcheck-suppress constParameter
     void CrawlLink(const wxString& currentLink, html_utilities::html_url_format& formatUrl,
                    const wxString& mainUrl, const html_utilities::hyperlink_parse& linkParser);
 
+    /// @returns The URL resolved the way that the visited-URL sets expect.
+    [[nodiscard]]
+    static wxString ResolveVisitedUrl(const wxString& url);
+
     [[nodiscard]]
     bool HasUrlAlreadyBeenHarvested(const wxString& url) const
         {
-        return (m_harvestedLinks.find(url) != m_harvestedLinks.cend());
+        return m_harvestedUrls.Contains(ResolveVisitedUrl(url));
         }
 
     [[nodiscard]]
     bool HasUrlAlreadyBeenCrawled(const wxString& url) const
         {
-        return (m_alreadyCrawledFiles.find(url) != m_alreadyCrawledFiles.cend());
+        return m_alreadyCrawledFiles.Contains(ResolveVisitedUrl(url));
         }
 
     [[nodiscard]]
@@ -678,10 +712,14 @@ class WebHarvester
     std::set<wxString, wxStringLessNoCase> m_fileExtensions;
     // cached state information
     std::set<wxString, wxStringLessNoCase> m_JsCookies;
-    std::set<wxString, wxStringLessWebPath> m_harvestedLinks;
+    std::vector<wxString> m_harvestedLinks;
+    VisitedUrlSet m_harvestedUrls;
     std::set<wxString> m_downloadedFiles;
     std::map<wxString, wxString> m_brokenLinks;
-    std::set<wxString, wxStringLessWebPath> m_alreadyCrawledFiles;
+    VisitedUrlSet m_alreadyCrawledFiles;
+    // pages (and their depth levels) that are still being crawled
+    std::vector<std::pair<wxString, size_t>> m_crawlStack;
+    bool m_resumeCrawl{ false };
     size_t m_currentLevel{ 0 };
     bool m_isCancelled{ false };
 
@@ -11,10 +11,12 @@
  *   Blake Madden - initial implementation
  ********************************************************************************/
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "../src/indexing/tokenize.h"
+#include <tuple>
 
 // clang-format off
 // NOLINTBEGIN
@@ -537,5 +539,76 @@ TEST_CASE("Document tokenize", "[document]")
         }
     }
 
+TEST_CASE("Tokenize whitespace runs", "[document]")
+    {
+    // the words, sentences, paragraphs, and punctuation of a document
+    const auto tokenizeText = [](const std::wstring& text)
+        {
+        tokenize::document_tokenize<> tokenize(text.data(), text.length(), false, false, false,
+                                               false);
+        std::vector<std::tuple<std::wstring, size_t, size_t, bool>> words;
+        const wchar_t* pos{ nullptr };
+        while ((pos = tokenize()) != nullptr)
+            {
+            words.emplace_back(std::wstring{ pos, tokenize.get_current_word_length() },
+                               tokenize.get_current_sentence_index(),
+                               tokenize.get_current_paragraph_index(), tokenize.is_tabbed());
+            }
+        std::vector<std::pair<wchar_t, size_t>> punctuation;
+        for (const auto& punct : tokenize.get_punctuation())
+            {
+            punctuation.emplace_back(punct.get_punctuation_mark(), punct.get_word_position());
+            }
+        return std::make_pair(words, punctuation);
+        };
+
+    SECTION("Long runs are the same as single spaces")
+        {
+        const std::wstring spaces(40, L' ');
+        const auto padded = tokenizeText(L"The" + spaces + L"cat (sat)" + spaces + L"down." +
+                                         spaces + L"It was\n\n" + spaces + L"happy \u201Cthen\u201D" +
+                                         spaces + L". The end" + spaces);
+        const auto single = tokenizeText(L"The cat (sat) down. It was\n\n happy \u201Cthen\u201D . The end ");
+        CHECK(padded == single);
+        REQUIRE(padded.first.size() == 10);
+        CHECK(std::get<1>(padded.first[5]) == 1); // "was"
+        CHECK(std::get<2>(padded.first[6]) == 1); // "happy"
+        }
+
+    SECTION("Tabs")
+        {
+        const auto result = tokenizeText(L"One" + std::wstring(17, L' ') + L"two" +
+                                         std::wstring(17, L' ') + L"\t\tthree   four\t");
+        REQUIRE(result.first.size() == 4);
+        CHECK_FALSE(std::get<3>(result.first[1]));
+        CHECK(std::get<3>(result.first[2]));
+        CHECK_FALSE(std::get<3>(result.first[3]));
+        }
+    }
+
+// hidden, run with "[benchmark]" to compare tokenizer throughput between builds
+TEST_CASE("Tokenize benchmark", "[.][benchmark][document]")
+    {
+    std::wstring text;
+    for (size_t i = 0; i < 2'000; ++i)
+        {
+        text += L"The quick brown fox—who was “very” fast—jumped over 3½ lazy dogs' "
+                L"backs in Zürich & Москва on 12/05/2024 at 5:00 PM.\n\n"
+                L"Dr. Smith's e-mail (smith@example.com) said: \"It's $4.50, isn't it?\" ";
+        }
+
+    BENCHMARK("Tokenize document")
+        {
+        tokenize::document_tokenize<> tokenize(text.data(), text.length(), false, false, false,
+                                               false);
+        size_t wordCount{ 0 };
+        while (tokenize() != nullptr)
+            {
+            ++wordCount;
+            }
+        return wordCount;
+        };
+    }
+
 // NOLINTEND
 // clang-format on
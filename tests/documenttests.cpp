@@ -15,6 +15,7 @@
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include "../src/indexing/german_syllabize.h"
+#include "../src/indexing/near_duplicates.h"
 #include "../src/indexing/word.h"
 #include "../src/indexing/word_collection.h"
 
@@ -4537,5 +4538,232 @@ TEST_CASE("Document 2", "[document]")
         CHECK(doc.get_word_count() == 12);
         }
     }
+
+TEST_CASE("Document parallel tokenizing", "[document]")
+    {
+    grammar::english_syllabize ENsyllabizer;
+    stemming::english_stem<std::wstring> ENStemmer;
+    grammar::is_english_coordinating_conjunction is_conjunction;
+    grammar::phrase_collection pmap;
+    grammar::phrase_collection copyrightPMap;
+    grammar::phrase_collection citationPMap;
+    word_list Known_proper_nouns;
+    word_list Known_personal_nouns;
+    word_list Known_spellings;
+    word_list Secondary_known_spellings;
+    word_list Programming_known_spellings;
+
+    const auto checkSameAsSequential = [&](const std::wstring& text)
+        {
+        for (size_t options = 0; options < 16; ++options)
+            {
+            document<MYWORD> sequentialDoc(L"", &ENsyllabizer, &ENStemmer, &is_conjunction, &pmap, &copyrightPMap, &citationPMap, &Known_proper_nouns, &Known_personal_nouns, &Known_spellings, &Secondary_known_spellings, &Programming_known_spellings, &Stop_list);
+            sequentialDoc.load_document(text.c_str(), text.length(), options & 1, options & 2, options & 4, options & 8);
+            // tiny sections, so that the text is split at (nearly) every paragraph break
+            for (const size_t sectionLength : { 1, 8, 64, 256 })
+                {
+                document<MYWORD> doc(L"", &ENsyllabizer, &ENStemmer, &is_conjunction, &pmap, &copyrightPMap, &citationPMap, &Known_proper_nouns, &Known_personal_nouns, &Known_spellings, &Secondary_known_spellings, &Programming_known_spellings, &Stop_list);
+                doc.tokenize_in_parallel(true);
+                doc.set_parallel_section_length(sectionLength);
+                doc.load_document(text.c_str(), text.length(), options & 1, options & 2, options & 4, options & 8);
+
+                REQUIRE(doc.get_word_count() == sequentialDoc.get_word_count());
+                for (size_t i = 0; i < doc.get_word_count(); ++i)
+                    {
+                    const auto& word = doc.get_word(i);
+                    const auto& expectedWord = sequentialDoc.get_word(i);
+                    CHECK(std::wstring{ word.c_str() } == std::wstring{ expectedWord.c_str() });
+                    CHECK(word.get_sentence_index() == expectedWord.get_sentence_index());
+                    CHECK(word.get_sentence_position() == expectedWord.get_sentence_position());
+                    CHECK(word.get_paragraph_index() == expectedWord.get_paragraph_index());
+                    CHECK(word.get_syllable_count() == expectedWord.get_syllable_count());
+                    CHECK(word.get_punctuation_count() == expectedWord.get_punctuation_count());
+                    CHECK(word.is_numeric() == expectedWord.is_numeric());
+                    CHECK(word.is_valid() == expectedWord.is_valid());
+                    }
+                REQUIRE(doc.get_sentences().size() == sequentialDoc.get_sentences().size());
+                for (size_t i = 0; i < doc.get_sentences().size(); ++i)
+                    {
+                    CHECK(doc.get_sentences()[i].get_first_word_index() == sequentialDoc.get_sentences()[i].get_first_word_index());
+                    CHECK(doc.get_sentences()[i].get_last_word_index() == sequentialDoc.get_sentences()[i].get_last_word_index());
+                    CHECK(doc.get_sentences()[i].get_ending_punctuation() == sequentialDoc.get_sentences()[i].get_ending_punctuation());
+                    CHECK(doc.get_sentences()[i].get_type() == sequentialDoc.get_sentences()[i].get_type());
+                    }
+                REQUIRE(doc.get_paragraphs().size() == sequentialDoc.get_paragraphs().size());
+                for (size_t i = 0; i < doc.get_paragraphs().size(); ++i)
+                    {
+                    CHECK(doc.get_paragraphs()[i].get_first_sentence_index() == sequentialDoc.get_paragraphs()[i].get_first_sentence_index());
+                    CHECK(doc.get_paragraphs()[i].get_last_sentence_index() == sequentialDoc.get_paragraphs()[i].get_last_sentence_index());
+                    CHECK(doc.get_paragraphs()[i].get_leading_end_of_line_count() == sequentialDoc.get_paragraphs()[i].get_leading_end_of_line_count());
+                    }
+                REQUIRE(doc.get_punctuation().size() == sequentialDoc.get_punctuation().size());
+                for (size_t i = 0; i < doc.get_punctuation().size(); ++i)
+                    {
+                    CHECK(doc.get_punctuation()[i].get_punctuation_mark() == sequentialDoc.get_punctuation()[i].get_punctuation_mark());
+                    CHECK(doc.get_punctuation()[i].get_word_position() == sequentialDoc.get_punctuation()[i].get_word_position());
+                    CHECK(doc.get_punctuation()[i].is_connected_to_previous_word() == sequentialDoc.get_punctuation()[i].is_connected_to_previous_word());
+                    }
+                }
+            }
+        };
+
+    SECTION("Prose")
+        {
+        std::wstring text;
+        for (size_t i = 0; i < 20; ++i)
+            {
+            text += L"The quick brown fox, who was rather tired, jumped over the lazy dog. "
+                    L"It was a sunny day\nand everyone (mostly) was happy!\n\n"
+                    L"\"Are you sure?\" she asked. \"Yes,\" said Dr. Smith.\n\n";
+            }
+        checkSameAsSequential(text);
+        }
+
+    SECTION("Headers, lists, and tables of contents")
+        {
+        const std::wstring text =
+            L"Contents\n\nOverview.......3\nInstallation....12\n\nChapter 1\n\n"
+            L"Introduction\n\nThis is the first paragraph\nwith no ending punctuation\n\n"
+            L"\t• First bullet point\n\t• Second bullet point\n\n"
+            L"1. Numbered item\n2. Another numbered item\n\n"
+            L"**********\n\nA line after a separator. It costs $5.00 (or 10%).\n\n"
+            L"Summary\n\n\n\nThe end.";
+        checkSameAsSequential(text);
+        }
+
+    SECTION("Page breaks and words split across lines")
+        {
+        const std::wstring text =
+            L"The first page ends with a hyphen-\n\nated word that continues.\f"
+            L"The second page starts here, and is short\f\f\n"
+            L"Third page. It has an abbrev. e.g. and etc.\r\n\r\n"
+            L"  Indented paragraph with 'single quotes' and a URL www.example.com/page.\r\n\r\n"
+            L"Last paragraph… with an ellipsis...\n\n";
+        checkSameAsSequential(text);
+        }
+    }
+
+TEST_CASE("Document near duplicates", "[document][near-duplicates]")
+    {
+    grammar::english_syllabize ENsyllabizer;
+    stemming::english_stem<std::wstring> ENStemmer;
+    grammar::is_english_coordinating_conjunction is_conjunction;
+    grammar::phrase_collection pmap;
+    grammar::phrase_collection copyrightPMap;
+    grammar::phrase_collection citationPMap;
+    word_list Known_proper_nouns;
+    word_list Known_personal_nouns;
+    word_list Known_spellings;
+    word_list Secondary_known_spellings;
+    word_list Programming_known_spellings;
+
+    // builds a document of (pseudo) random words, so that it has lots of unique shingles
+    const auto makeText = [](uint32_t seed)
+        {
+        const std::vector<std::wstring> vocabulary =
+            { L"the", L"river", L"bank", L"was", L"quiet", L"after", L"storm", L"and", L"a",
+              L"heron", L"waited", L"for", L"fish", L"near", L"old", L"mill", L"where",
+              L"children", L"played", L"every", L"summer", L"morning", L"under", L"willow",
+              L"trees", L"while", L"boats", L"drifted", L"past", L"slowly" };
+        std::wstring text;
+        for (size_t i = 0; i < 300; ++i)
+            {
+            seed = seed * 1'664'525U + 1'013'904'223U;
+            text += vocabulary[(seed >> 16) % vocabulary.size()];
+            text += ((i + 1) % 12 == 0) ? L". " : L" ";
+            }
+        return text;
+        };
+
+    const auto makeSignature = [&](const std::wstring& text)
+        {
+        document<MYWORD> doc(L"", &ENsyllabizer, &ENStemmer, &is_conjunction, &pmap, &copyrightPMap, &citationPMap, &Known_proper_nouns, &Known_personal_nouns, &Known_spellings, &Secondary_known_spellings, &Programming_known_spellings, &Stop_list);
+        doc.load_document(text.c_str(), text.length(), false, false, false, false);
+        minhash_signature signature;
+        signature.add_words(doc.get_words().cbegin(), doc.get_words().cend());
+        return signature;
+        };
+
+    const std::wstring original = makeText(1);
+    // a few words changed near the start, middle, and end
+    std::wstring edited = original;
+    edited.replace(0, 3, L"A");
+    edited.insert(edited.length() / 2, L" otters ");
+    edited += L"The end.";
+    std::wstring uppercased = original;
+    std::transform(uppercased.begin(), uppercased.end(), uppercased.begin(), towupper);
+
+    const auto originalSig = makeSignature(original);
+    const auto editedSig = makeSignature(edited);
+    const auto uppercasedSig = makeSignature(uppercased);
+    const auto unrelatedSig = makeSignature(makeText(2));
+    const auto otherUnrelatedSig = makeSignature(makeText(3));
+
+    SECTION("Signatures")
+        {
+        CHECK_FALSE(originalSig.empty());
+        CHECK(originalSig.get_shingle_count() == 298);
+        CHECK(originalSig.estimate_similarity(originalSig) == 1);
+        CHECK(originalSig.estimate_similarity(uppercasedSig) == 1);
+        CHECK(originalSig.estimate_similarity(editedSig) >= 0.8);
+        CHECK(originalSig.estimate_similarity(editedSig) < 1.0);
+        CHECK(originalSig.estimate_similarity(unrelatedSig) < 0.2);
+        }
+
+    SECTION("Short and empty")
+        {
+        minhash_signature empty;
+        CHECK(empty.empty());
+        CHECK(empty.estimate_similarity(empty) == 0);
+        CHECK(empty.estimate_similarity(originalSig) == 0);
+
+        const auto shortSig = makeSignature(L"Hello world.");
+        CHECK(shortSig.get_shingle_count() == 1);
+        CHECK(shortSig.estimate_similarity(makeSignature(L"HELLO WORLD!")) == 1);
+        CHECK(shortSig.estimate_similarity(makeSignature(L"Hello there.")) < 0.2);
+        }
+
+    SECTION("Index")
+        {
+        near_duplicate_index index;
+        index.add(10, originalSig);
+        index.add(11, unrelatedSig);
+        index.add(12, editedSig);
+        index.add(13, otherUnrelatedSig);
+        index.add(14, uppercasedSig);
+        index.add(15, minhash_signature{});
+        CHECK(index.size() == 5);
+
+        const auto clusters = index.find_clusters(0.8);
+        REQUIRE(clusters.size() == 1);
+        CHECK(clusters[0] == std::vector<size_t>{ 10, 12, 14 });
+
+        const auto match = index.find_most_similar(editedSig, 0.8);
+        REQUIRE(match);
+        CHECK((match->m_id == 10 || match->m_id == 14 || match->m_id == 12));
+        CHECK_FALSE(index.find_most_similar(makeSignature(makeText(4)), 0.8));
+
+        index.clear();
+        CHECK(index.size() == 0);
+        CHECK(index.find_clusters(0.8).empty());
+        CHECK_FALSE(index.find_most_similar(originalSig, 0.8));
+        }
+
+    SECTION("Many identical")
+        {
+        near_duplicate_index index;
+        for (size_t i = 0; i < 500; ++i)
+            {
+            index.add(i, originalSig);
+            }
+        index.add(500, unrelatedSig);
+        const auto clusters = index.find_clusters(0.9);
+        REQUIRE(clusters.size() == 1);
+        CHECK(clusters[0].size() == 500);
+        CHECK(clusters[0].front() == 0);
+        CHECK(clusters[0].back() == 499);
+        }
+    }
+
 // NOLINTEND
 // clang-format on
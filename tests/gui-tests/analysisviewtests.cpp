@@ -0,0 +1,221 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../src/indexing/article.h"
+#include "../../src/indexing/conjunction.h"
+#include "../../src/indexing/syllable.h"
+#include "../../src/lua-scripting/lua_analysis_views.h"
+
+// NOLINTBEGIN
+
+using namespace LuaScripting;
+
+namespace
+    {
+    /// @brief Runs a Lua chunk and returns its (numeric) result, or NaN if it failed.
+    double RunLuaNumber(lua_State* L, const std::string& script)
+        {
+        if (luaL_dostring(L, script.c_str()) != LUA_OK)
+            {
+            lua_pop(L, 1);
+            return std::numeric_limits<double>::quiet_NaN();
+            }
+        const double value = lua_isnil(L, -1) ? -1 : lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        return value;
+        }
+
+    /// @brief Checks a view's length, items, and reductions against the expected values.
+    void CheckView(lua_State* L, const std::string& name, const std::vector<double>& expected)
+        {
+        CHECK(RunLuaNumber(L, "return #" + name) == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            {
+            // booleans are compared as 1 or 0
+            CHECK(RunLuaNumber(L, "local v = " + name + "[" + std::to_string(i + 1) +
+                                      "]; if type(v) == 'boolean' then return v and 1 or 0 end; "
+                                      "return v") == expected[i]);
+            }
+        // out of range
+        CHECK(RunLuaNumber(L, "return " + name + "[0]") == -1);
+        CHECK(RunLuaNumber(L, "return " + name + "[" + std::to_string(expected.size() + 1) +
+                                  "]") == -1);
+
+        double sum{ 0 };
+        for (const auto value : expected)
+            {
+            sum += value;
+            }
+        CHECK(RunLuaNumber(L, "return " + name + ":Sum()") == sum);
+        CHECK(RunLuaNumber(L, "return #" + name + ":ToTable()") == expected.size());
+        if (!expected.empty())
+            {
+            CHECK(RunLuaNumber(L, "return " + name + ":Min()") ==
+                  *std::min_element(expected.cbegin(), expected.cend()));
+            CHECK(RunLuaNumber(L, "return " + name + ":Max()") ==
+                  *std::max_element(expected.cbegin(), expected.cend()));
+            CHECK(RunLuaNumber(L, "return " + name + ":Mean()") == sum / expected.size());
+            }
+        else
+            {
+            CHECK(RunLuaNumber(L, "return " + name + ":Mean()") == -1);
+            }
+        }
+
+    /// @returns The values from a document's vector, converted by @c toNumber.
+    template<typename T, typename Fn>
+    std::vector<double> ToNumbers(const std::vector<T>& values, Fn toNumber)
+        {
+        std::vector<double> numbers;
+        for (const auto& value : values)
+            {
+            numbers.push_back(static_cast<double>(toNumber(value)));
+            }
+        return numbers;
+        }
+    } // namespace
+
+TEST_CASE("Lua analysis views", "[lua][analysisviews]")
+    {
+    grammar::english_syllabize syllabizer;
+    stemming::english_stem<std::wstring> stemmer;
+    grammar::is_english_coordinating_conjunction isConjunction;
+    grammar::is_incorrect_english_article isMismatchedArticle;
+    grammar::phrase_collection knownPhrases;
+    grammar::phrase_collection copyrightPhrases;
+    grammar::phrase_collection citationPhrases;
+    word_list knownProperNouns;
+    word_list knownPersonalNouns;
+    word_list knownSpellings;
+    word_list secondaryKnownSpellings;
+    word_list programmingKnownSpellings;
+    word_list stopList;
+
+    auto doc = std::make_shared<CaseInSensitiveNonStemmingDocument>(
+        L"", &syllabizer, &stemmer, &isConjunction, &knownPhrases, &copyrightPhrases,
+        &citationPhrases, &knownProperNouns, &knownPersonalNouns, &knownSpellings,
+        &secondaryKnownSpellings, &programmingKnownSpellings, &stopList);
+    doc->set_mismatched_article_function(&isMismatchedArticle);
+    const wchar_t text[] = L"The book was given to him.\n\nand it is a a apple. "
+                           L"But the dog ran away quickly.";
+    doc->load_document(text, std::wcslen(text), false, false, false, false);
+    REQUIRE(doc->get_words().size() > 0);
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    RegisterAnalysisViews(L);
+    const auto pushView = [L, &doc](const char* name, const AnalysisArrayType arrayType)
+    {
+        PushAnalysisArray(L, doc, arrayType);
+        lua_setglobal(L, name);
+    };
+
+    SECTION("Word views")
+        {
+        pushView("words", AnalysisArrayType::WordText);
+        pushView("syllables", AnalysisArrayType::WordSyllableCounts);
+        pushView("characters", AnalysisArrayType::WordCharacterCounts);
+        pushView("sentences", AnalysisArrayType::WordSentenceIndices);
+        pushView("validity", AnalysisArrayType::WordValidity);
+
+        CHECK(RunLuaNumber(L, "return #words") == doc->get_words().size());
+        CHECK(RunLuaNumber(L, "return words[1] == 'The' and 1 or 0") == 1);
+        CHECK(RunLuaNumber(L, "return words[3] == 'was' and 1 or 0") == 1);
+        // word text has no numbers to add up
+        CHECK(RunLuaNumber(L, "return pcall(words.Sum, words) and 1 or 0") == 0);
+
+        CheckView(L, "syllables", ToNumbers(doc->get_words(), [](const auto& word)
+                                            { return word.get_syllable_count(); }));
+        CheckView(L, "characters", ToNumbers(doc->get_words(), [](const auto& word)
+                                             { return word.get_length_excluding_punctuation(); }));
+        CheckView(L, "sentences", ToNumbers(doc->get_words(), [](const auto& word)
+                                            { return word.get_sentence_index() + 1; }));
+        CheckView(L, "validity", ToNumbers(doc->get_words(), [](const auto& word)
+                                           { return word.is_valid() ? 1 : 0; }));
+        // the first sentence is words 1-6
+        CHECK(RunLuaNumber(L, "return sentences[6]") == 1);
+        CHECK(RunLuaNumber(L, "return sentences[7]") == 2);
+        }
+
+    SECTION("Sentence and paragraph views")
+        {
+        pushView("wordCounts", AnalysisArrayType::SentenceWordCounts);
+        pushView("firstWords", AnalysisArrayType::SentenceFirstWordIndices);
+        pushView("validity", AnalysisArrayType::SentenceValidity);
+        pushView("sentenceCounts", AnalysisArrayType::ParagraphSentenceCounts);
+        pushView("firstSentences", AnalysisArrayType::ParagraphFirstSentenceIndices);
+
+        CheckView(L, "wordCounts", ToNumbers(doc->get_sentences(), [](const auto& sentence)
+                                             { return sentence.get_word_count(); }));
+        CheckView(L, "firstWords", ToNumbers(doc->get_sentences(), [](const auto& sentence)
+                                             { return sentence.get_first_word_index() + 1; }));
+        CheckView(L, "validity", ToNumbers(doc->get_sentences(), [](const auto& sentence)
+                                           { return sentence.is_valid() ? 1 : 0; }));
+        CheckView(L, "sentenceCounts", ToNumbers(doc->get_paragraphs(), [](const auto& paragraph)
+                                                 { return paragraph.get_sentence_count(); }));
+        CheckView(L, "firstSentences",
+                  ToNumbers(doc->get_paragraphs(), [](const auto& paragraph)
+                            { return paragraph.get_first_sentence_index() + 1; }));
+        CHECK(RunLuaNumber(L, "return wordCounts[1]") == 6);
+        CHECK(RunLuaNumber(L, "return firstWords[2]") == 7);
+        // one view's values can index another
+        CHECK(RunLuaNumber(L, "return firstWords[firstSentences[2]]") == 7);
+        }
+
+    SECTION("Grammar views")
+        {
+        pushView("repeated", AnalysisArrayType::RepeatedWordIndices);
+        pushView("articles", AnalysisArrayType::ArticleMismatchIndices);
+        pushView("passive", AnalysisArrayType::PassiveVoiceIndices);
+        pushView("conjunctions", AnalysisArrayType::ConjunctionStartingSentenceIndices);
+        pushView("lowercased", AnalysisArrayType::LowercasedSentenceIndices);
+
+        const auto toLuaIndex = [](const size_t index) { return index + 1; };
+        CheckView(L, "repeated", ToNumbers(doc->get_duplicate_word_indices(), toLuaIndex));
+        CheckView(L, "articles", ToNumbers(doc->get_incorrect_article_indices(), toLuaIndex));
+        CheckView(L, "passive", ToNumbers(doc->get_passive_voice_indices(),
+                                          [](const auto& phrase) { return phrase.first + 1; }));
+        CheckView(L, "conjunctions",
+                  ToNumbers(doc->get_conjunction_beginning_sentences(), toLuaIndex));
+        CheckView(L, "lowercased", ToNumbers(doc->get_lowercase_beginning_sentences(), toLuaIndex));
+        // "was given"
+        CHECK(RunLuaNumber(L, "return passive[1]") == 3);
+        }
+
+    SECTION("Empty views")
+        {
+        // no document
+        PushAnalysisArray(L, nullptr, AnalysisArrayType::WordSyllableCounts);
+        lua_setglobal(L, "noDocument");
+        CheckView(L, "noDocument", {});
+        CHECK(RunLuaNumber(L, "return noDocument:Min()") == -1);
+
+        // a document without any text
+        auto emptyDoc = std::make_shared<CaseInSensitiveNonStemmingDocument>(
+            L"", &syllabizer, &stemmer, &isConjunction, &knownPhrases, &copyrightPhrases,
+            &citationPhrases, &knownProperNouns, &knownPersonalNouns, &knownSpellings,
+            &secondaryKnownSpellings, &programmingKnownSpellings, &stopList);
+        PushAnalysisArray(L, emptyDoc, AnalysisArrayType::PassiveVoiceIndices);
+        lua_setglobal(L, "emptyDocument");
+        CheckView(L, "emptyDocument", {});
+        }
+
+    SECTION("Views see the document re-indexed in place")
+        {
+        pushView("wordCounts", AnalysisArrayType::SentenceWordCounts);
+        CHECK(RunLuaNumber(L, "return #wordCounts") == doc->get_sentences().size());
+        const wchar_t newText[] = L"One two three.";
+        doc->load_document(newText, std::wcslen(newText), false, false, false, false);
+        CHECK(RunLuaNumber(L, "return #wordCounts") == 1);
+        CHECK(RunLuaNumber(L, "return wordCounts[1]") == 3);
+        }
+
+    lua_close(L);
+    }
+
+// NOLINTEND
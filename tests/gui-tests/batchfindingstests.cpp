@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <utility>
+#include <wx/wx.h>
+#include "../../src/ui/controls/batch_findings_provider.h"
+
+// NOLINTBEGIN
+
+TEST_CASE("Batch findings string pool", "[batchfindings]")
+    {
+    SECTION("Interning")
+        {
+        BatchFindingsStringPool pool;
+        const auto firstId = pool.Intern(L"end result");
+        CHECK(pool.Intern(L"end result") == firstId);
+        const auto secondId = pool.Intern(L"very unique");
+        CHECK(secondId != firstId);
+        CHECK(pool.Get(firstId) == L"end result");
+        CHECK(pool.Get(secondId) == L"very unique");
+        CHECK(pool.GetCount() == 2);
+        }
+
+    SECTION("Releasing")
+        {
+        BatchFindingsStringPool pool;
+        const auto firstId = pool.Intern(L"end result");
+        CHECK(pool.Intern(L"end result") == firstId);
+        const auto secondId = pool.Intern(L"very unique");
+        // still referenced once
+        pool.Release(firstId);
+        CHECK(pool.GetCount() == 2);
+        CHECK(pool.Get(firstId) == L"end result");
+        pool.Release(firstId);
+        CHECK(pool.GetCount() == 1);
+        // the removed string's ID is reused
+        CHECK(pool.Intern(L"past history") == firstId);
+        CHECK(pool.Get(firstId) == L"past history");
+        CHECK(pool.Get(secondId) == L"very unique");
+        // releasing too many times is ignored
+        pool.Release(secondId);
+        pool.Release(secondId);
+        CHECK(pool.GetCount() == 1);
+        }
+    }
+
+TEST_CASE("Batch findings provider", "[batchfindings]")
+    {
+    auto pool = std::make_shared<BatchFindingsStringPool>();
+
+    SECTION("Formatting")
+        {
+        BatchFindingsDataProvider data(pool, false);
+        data.AddDocument(L"/docs/a.txt", L"A", 3,
+                         std::map<std::wstring, size_t>{ { L"end result", 2 },
+                                                         { L"very unique", 1 } });
+        data.AddDocument(L"/docs/b.txt", L"B", 1,
+                         std::map<std::wstring, size_t>{ { L"past history", 1 } });
+        CHECK(data.GetItemCount() == 2);
+        CHECK(data.GetColumnCount() == 4);
+        CHECK(data.GetItemText(0, 0) == L"/docs/a.txt");
+        CHECK(data.GetItemText(0, 1) == L"A");
+        CHECK(data.GetItemText(0, 2) == L"3");
+        CHECK(data.GetItemText(0, 3) == L"\"end result\" * 2, \"very unique\"");
+        // a single finding isn't quoted
+        CHECK(data.GetItemText(1, 3) == L"past history");
+        CHECK(data.GetColumnSum(2) == 4);
+        CHECK(data.Find(L"/DOCS/B.TXT") == 1);
+        CHECK(data.Find(L"/docs/c.txt") == wxNOT_FOUND);
+
+        BatchFindingsDataProvider quotedData(pool, false,
+                                             BatchFindingsDataProvider::QuoteMethod::AlwaysQuote);
+        quotedData.AddDocument(L"/docs/b.txt", L"B", 1,
+                               std::map<std::wstring, size_t>{ { L"and", 1 } });
+        CHECK(quotedData.GetItemText(0, 3) == L"\"and\"");
+        }
+
+    SECTION("Suggestions")
+        {
+        BatchFindingsDataProvider data(pool, true);
+        data.AddDocumentWithSuggestions(
+            L"/docs/a.txt", L"A",
+            std::map<std::wstring, std::pair<std::wstring, size_t>>{
+                { L"end result", { L"result", 2 } }, { L"past history", { L"history", 1 } } });
+        CHECK(data.GetColumnCount() == 5);
+        CHECK(data.GetItemText(0, 2) == L"3");
+        CHECK(data.GetItemText(0, 4) == L"\"result\", \"history\"");
+        }
+
+    SECTION("Sorting")
+        {
+        BatchFindingsDataProvider data(pool, false);
+        data.AddDocument(L"/docs/c.txt", L"Same", 2,
+                         std::map<std::wstring, size_t>{ { L"Beta", 2 } });
+        data.AddDocument(L"/docs/a.txt", L"same", 5,
+                         std::map<std::wstring, size_t>{ { L"alpha", 5 } });
+        data.AddDocument(L"/docs/B.txt", L"Other", 2,
+                         std::map<std::wstring, size_t>{ { L"gamma", 1 }, { L"delta", 1 } });
+
+        // text is compared without case
+        data.Sort(0, Wisteria::SortDirection::SortAscending);
+        CHECK(data.GetItemText(0, 0) == L"/docs/a.txt");
+        CHECK(data.GetItemText(1, 0) == L"/docs/B.txt");
+        CHECK(data.GetItemText(2, 0) == L"/docs/c.txt");
+
+        data.Sort(3, Wisteria::SortDirection::SortDescending);
+        CHECK(data.GetItemText(0, 3) == L"\"delta\", \"gamma\"");
+        CHECK(data.GetItemText(1, 3) == L"\"Beta\" * 2");
+        CHECK(data.GetItemText(2, 3) == L"\"alpha\" * 5");
+
+        data.Sort(2, Wisteria::SortDirection::SortDescending);
+        CHECK(data.GetItemText(0, 2) == L"5");
+        // ties keep their previous order
+        CHECK(data.GetItemText(1, 0) == L"/docs/B.txt");
+        CHECK(data.GetItemText(2, 0) == L"/docs/c.txt");
+
+        // by label, then by count for ties ("Same" and "same")
+        data.Sort({ { 1, Wisteria::SortDirection::SortAscending },
+                    { 2, Wisteria::SortDirection::SortAscending } });
+        CHECK(data.GetItemText(0, 1) == L"Other");
+        CHECK(data.GetItemText(1, 0) == L"/docs/c.txt");
+        CHECK(data.GetItemText(2, 0) == L"/docs/a.txt");
+
+        // only part of the list
+        data.Sort(0, Wisteria::SortDirection::SortDescending, 1, 3);
+        CHECK(data.GetItemText(0, 1) == L"Other");
+        CHECK(data.GetItemText(1, 0) == L"/docs/c.txt");
+        CHECK(data.GetItemText(2, 0) == L"/docs/a.txt");
+        data.Sort(0, Wisteria::SortDirection::SortAscending, 1, 3);
+        CHECK(data.GetItemText(1, 0) == L"/docs/a.txt");
+        CHECK(data.GetItemText(2, 0) == L"/docs/c.txt");
+        }
+
+    SECTION("Deleted rows release their strings")
+        {
+            {
+            BatchFindingsDataProvider data(pool, true);
+            BatchFindingsDataProvider otherData(pool, false);
+            data.AddDocumentWithSuggestions(
+                L"/docs/a.txt", L"A",
+                std::map<std::wstring, std::pair<std::wstring, size_t>>{
+                    { L"end result", { L"result", 1 } } });
+            data.AddDocumentWithSuggestions(
+                L"/docs/b.txt", L"B",
+                std::map<std::wstring, std::pair<std::wstring, size_t>>{
+                    { L"past history", { L"history", 1 } } });
+            otherData.AddDocument(L"/docs/a.txt", L"A", 1,
+                                  std::map<std::wstring, size_t>{ { L"and", 1 } });
+            // paths, labels, findings, and suggestions
+            CHECK(pool->GetCount() == 9);
+
+            data.DeleteItem(1);
+            CHECK(pool->GetCount() == 5);
+            CHECK(data.GetItemText(0, 3) == L"end result");
+
+            // the path and label are still used by the other list
+            data.DeleteAllItems();
+            CHECK(pool->GetCount() == 3);
+            CHECK(otherData.GetItemText(0, 0) == L"/docs/a.txt");
+            }
+        // lists release what they use when they are destroyed
+        CHECK(pool->GetCount() == 0);
+        }
+    }
+
+// NOLINTEND
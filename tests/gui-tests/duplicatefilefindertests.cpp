@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <wx/filename.h>
+#include <wx/wx.h>
+#include "../../src/document-helpers/duplicate_file_finder.h"
+#include "testscoringengine.h"
+
+// NOLINTBEGIN
+
+namespace
+    {
+    uint64_t HashString(const std::string& text)
+        {
+        return DuplicateFileFinder::HashBytes(text.data(), text.length());
+        }
+
+    /// @returns Content that isn't just a repeated pattern (so that hashing it is meaningful).
+    std::string MakeContent(const size_t length)
+        {
+        std::string content(length, '\0');
+        for (size_t i = 0; i < length; ++i)
+            { content[i] = static_cast<char>((i * 7 + 3) ^ (i >> 8)); }
+        return content;
+        }
+    } // namespace
+
+TEST_CASE("Duplicate file hashing", "[duplicatefiles]")
+    {
+    SECTION("Known answers")
+        {
+        // XXH64 (with a seed of zero) reference values
+        CHECK(HashString("") == 0xEF46DB3751D8E999ULL);
+        CHECK(HashString("a") == 0xD24EC4F1A98C6E5BULL);
+        CHECK(HashString("abc") == 0x44BC2CF5AD770999ULL);
+        // longer than a stripe (32 bytes), so the accumulators are used
+        CHECK(HashString("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ULL);
+        }
+
+    SECTION("Split updates give the same digest")
+        {
+        const std::string content = MakeContent(1000);
+        const uint64_t expected = HashString(content);
+        // block sizes that start and end mid stripe, on stripe boundaries, and empty
+        const size_t blockSizes[] = { 1, 3, 31, 32, 33, 64, 5, 0, 200 };
+        DuplicateFileFinder::StreamHash hash;
+        size_t position{ 0 };
+        for (const auto blockSize : blockSizes)
+            {
+            hash.Update(content.data() + position, blockSize);
+            position += blockSize;
+            }
+        hash.Update(content.data() + position, content.length() - position);
+        CHECK(hash.GetDigest() == expected);
+
+        // one byte at a time
+        DuplicateFileFinder::StreamHash byteHash;
+        for (const auto& ch : content)
+            { byteHash.Update(&ch, 1); }
+        CHECK(byteHash.GetDigest() == expected);
+        }
+    }
+
+TEST_CASE("Duplicate file finder", "[duplicatefiles]")
+    {
+    TempFolder folder{ L"rsdupes" };
+    wxArrayString files;
+    const auto addFile = [&folder, &files](const wxString& name, const std::string& content)
+        {
+        files.push_back(folder.AddFile(name, content));
+        return files.back();
+        };
+    // small files (hashed in full while sampling)
+    const wxString small1 = addFile(L"a1.txt", "Same text.");
+    const wxString small2 = addFile(L"a2.txt", "Same text.");
+    // same size, different content
+    addFile(L"b.txt", "Diff text.");
+
+    // files larger than the sample (32KB), so they are hashed in full afterwards
+    const std::string largeContent = MakeContent(100 * 1024);
+    const wxString large1 = addFile(L"c1.bin", largeContent);
+    const wxString large2 = addFile(L"c2.bin", largeContent);
+    // same size, beginning, and end (so the same sample), but different in the middle
+    std::string changedLargeContent = largeContent;
+    changedLargeContent[changedLargeContent.length() / 2] ^= 0x01;
+    addFile(L"c3.bin", changedLargeContent);
+
+    // empty files are skipped
+    addFile(L"d1.txt", std::string{});
+    addFile(L"d2.txt", std::string{});
+    // as are missing files
+    files.push_back(wxFileName{ folder.GetFolder(), L"missing.txt" }.GetFullPath());
+
+    const std::vector<std::vector<wxString>> expected{ { small1, small2 }, { large1, large2 } };
+
+    SECTION("Hashes")
+        {
+        DuplicateFileFinder finder;
+        CHECK(finder.FindDuplicates(files) == expected);
+        CHECK_FALSE(finder.WasCancelled());
+        }
+
+    SECTION("Verified content")
+        {
+        DuplicateFileFinder finder;
+        finder.VerifyContent(true);
+        finder.SetThreadCount(1);
+        CHECK(finder.FindDuplicates(files) == expected);
+        }
+
+    SECTION("Cancel")
+        {
+        DuplicateFileFinder finder;
+        finder.SetProgressCallback([]([[maybe_unused]] const wxString& message,
+                                      [[maybe_unused]] const size_t processed,
+                                      [[maybe_unused]] const size_t total) { return false; });
+        CHECK(finder.FindDuplicates(files).empty());
+        CHECK(finder.WasCancelled());
+        }
+    }
+
+// NOLINTEND
@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/wfstream.h>
+#include <wx/wx.h>
+#include "../../src/Wisteria-Dataviz/src/util/zipcatalog.h"
+#include "../../src/projects/embedded_text_writer.h"
+
+// NOLINTBEGIN
+
+namespace
+    {
+    std::vector<const std::wstring*> GetTextPointers(const std::vector<std::wstring>& texts)
+        {
+        std::vector<const std::wstring*> pointers;
+        for (const auto& text : texts)
+            { pointers.push_back(&text); }
+        return pointers;
+        }
+
+    /// @brief Writes texts straight into a project file (i.e., how an older save left them).
+    void WriteProjectFile(const wxString& filePath, const std::vector<std::wstring>& texts)
+        {
+        wxFFileOutputStream out(filePath);
+        wxZipOutputStream zip(out);
+        for (size_t i = 0; i < texts.size(); ++i)
+            {
+            Wisteria::ZipCatalog::WriteText(zip, EmbeddedTextWriter::GetEntryName(i), texts[i]);
+            }
+        zip.Close();
+        out.Close();
+        }
+
+    /// @brief Reads back the entries written to a project in memory.
+    std::vector<std::wstring> ReadProject(wxMemoryOutputStream& project, const size_t count)
+        {
+        std::vector<char> data(project.GetLength());
+        project.CopyTo(data.data(), data.size());
+        Wisteria::ZipCatalog cat(data.data(), data.size());
+        std::vector<std::wstring> texts;
+        for (size_t i = 0; i < count; ++i)
+            { texts.push_back(cat.ReadTextFile(EmbeddedTextWriter::GetEntryName(i))); }
+        return texts;
+        }
+
+    std::vector<EmbeddedTextWriter::Fingerprint>
+    GetFingerprints(const std::vector<std::wstring>& texts)
+        {
+        std::vector<EmbeddedTextWriter::Fingerprint> fingerprints;
+        for (const auto& text : texts)
+            { fingerprints.push_back(EmbeddedTextWriter::GetFingerprint(text)); }
+        return fingerprints;
+        }
+    } // namespace
+
+TEST_CASE("Embedded text fingerprints", "[embeddedtext]")
+    {
+    SECTION("Empty")
+        {
+        const auto fingerprint = EmbeddedTextWriter::GetFingerprint(std::wstring{});
+        // XXH64 of nothing
+        CHECK(fingerprint.m_hash == 0xEF46DB3751D8E999ULL);
+        CHECK(fingerprint.m_length == 0);
+        }
+
+    SECTION("Equality")
+        {
+        const std::wstring text{ L"It was a dark and stormy night." };
+        CHECK(EmbeddedTextWriter::GetFingerprint(text) ==
+              EmbeddedTextWriter::GetFingerprint(std::wstring{ text }));
+        CHECK_FALSE(EmbeddedTextWriter::GetFingerprint(text) ==
+                    EmbeddedTextWriter::GetFingerprint(text + L" "));
+        CHECK(EmbeddedTextWriter::GetFingerprint(text).m_length == text.length());
+        // a matching hash isn't enough
+        auto collision = EmbeddedTextWriter::GetFingerprint(text);
+        ++collision.m_length;
+        CHECK_FALSE(collision == EmbeddedTextWriter::GetFingerprint(text));
+        }
+    }
+
+TEST_CASE("Embedded text writer", "[embeddedtext]")
+    {
+    const wxString previousFilePath = wxFileName::CreateTempFileName(L"rsproject");
+    const std::vector<std::wstring> texts{ L"First document.\n\nWith two paragraphs.", L"",
+                                           L"Third document, na\u00EFve \u65E5\u672C." };
+
+    SECTION("Round trip")
+        {
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        // no previous file, so everything is compressed
+        REQUIRE(writer.Write(zip, GetTextPointers(texts), wxString{}, {}));
+        zip.Close();
+        CHECK(writer.GetFingerprints() == GetFingerprints(texts));
+        CHECK(ReadProject(project, texts.size()) == texts);
+        }
+
+    SECTION("Unchanged text is copied from the previous file")
+        {
+        // the previous file has different text for the first document, but its fingerprint
+        // says it's unchanged, so that (old) entry is what gets copied
+        WriteProjectFile(previousFilePath, { L"Old text.", texts[1], texts[2] });
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        REQUIRE(
+            writer.Write(zip, GetTextPointers(texts), previousFilePath, GetFingerprints(texts)));
+        zip.Close();
+        const auto savedTexts = ReadProject(project, texts.size());
+        CHECK(savedTexts[0] == L"Old text.");
+        CHECK(savedTexts[1] == texts[1]);
+        CHECK(savedTexts[2] == texts[2]);
+        }
+
+    SECTION("Changed text is recompressed")
+        {
+        WriteProjectFile(previousFilePath, { L"Old text.", texts[1], texts[2] });
+        auto previousFingerprints = GetFingerprints(texts);
+        // same hash, different length
+        ++previousFingerprints[0].m_length;
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        REQUIRE(writer.Write(zip, GetTextPointers(texts), previousFilePath, previousFingerprints));
+        zip.Close();
+        CHECK(ReadProject(project, texts.size()) == texts);
+        }
+
+    SECTION("Previous file is missing or has fewer documents")
+        {
+        WriteProjectFile(previousFilePath, { texts[0] });
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        REQUIRE(
+            writer.Write(zip, GetTextPointers(texts), previousFilePath, GetFingerprints(texts)));
+        zip.Close();
+        CHECK(ReadProject(project, texts.size()) == texts);
+
+        wxRemoveFile(previousFilePath);
+        wxMemoryOutputStream secondProject;
+        wxZipOutputStream secondZip(secondProject);
+        REQUIRE(writer.Write(secondZip, GetTextPointers(texts), previousFilePath,
+                             GetFingerprints(texts)));
+        secondZip.Close();
+        CHECK(ReadProject(secondProject, texts.size()) == texts);
+        }
+
+    SECTION("Several chunks")
+        {
+        const size_t documentCount = EmbeddedTextWriter::MAX_CHUNK_DOCUMENTS_PER_THREAD *
+                                         std::max<size_t>(std::thread::hardware_concurrency(), 1) *
+                                         2 +
+                                     3;
+        std::vector<std::wstring> manyTexts;
+        for (size_t i = 0; i < documentCount; ++i)
+            {
+            manyTexts.push_back(L"Document " + std::to_wstring(i) + L" " +
+                                std::wstring(i * 10, L'x'));
+            }
+        std::vector<size_t> progress;
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        writer.SetProgressCallback(
+            [&progress](const size_t processed, [[maybe_unused]] const size_t total)
+            {
+                progress.push_back(processed);
+                return true;
+            });
+        REQUIRE(writer.Write(zip, GetTextPointers(manyTexts), wxString{}, {}));
+        zip.Close();
+        CHECK(ReadProject(project, manyTexts.size()) == manyTexts);
+        REQUIRE_FALSE(progress.empty());
+        CHECK(std::is_sorted(progress.cbegin(), progress.cend()));
+        CHECK(progress.back() == documentCount);
+        }
+
+    SECTION("Cancel")
+        {
+        wxMemoryOutputStream project;
+        wxZipOutputStream zip(project);
+        EmbeddedTextWriter writer(wxZ_BEST_SPEED);
+        writer.SetProgressCallback([]([[maybe_unused]] const size_t processed,
+                                      [[maybe_unused]] const size_t total) { return false; });
+        CHECK_FALSE(writer.Write(zip, GetTextPointers(texts), wxString{}, {}));
+        CHECK(writer.WasCancelled());
+        CHECK(writer.GetFailedDocument() == std::numeric_limits<size_t>::max());
+        zip.Close();
+        }
+
+    wxRemoveFile(previousFilePath);
+    }
+
+// NOLINTEND
@@ -0,0 +1,255 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wx/socket.h>
+#include <wx/wx.h>
+#include "../../src/projects/scoring_server.h"
+#include "testscoringengine.h"
+
+// NOLINTBEGIN
+
+namespace
+    {
+    struct HttpReply
+        {
+        int m_status{ 0 };
+        std::string m_body;
+        };
+
+    /// @brief A blocking client (to be used from another thread) that keeps its connection open.
+    class TestClient
+        {
+    public:
+        explicit TestClient(const unsigned short port)
+            : m_socket(new wxSocketClient(wxSOCKET_BLOCK))
+            {
+            m_socket->SetTimeout(10);
+            wxIPV4address address;
+            address.LocalHost();
+            address.Service(port);
+            m_socket->Connect(address, true);
+            }
+        TestClient(const TestClient&) = delete;
+        TestClient& operator=(const TestClient&) = delete;
+        ~TestClient() { m_socket->Destroy(); }
+
+        HttpReply Send(const std::string& method, const std::string& target,
+                       const std::string& body = std::string{})
+            {
+            const std::string request = method + " " + target +
+                                        " HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: " +
+                                        std::to_string(body.length()) + "\r\n\r\n" + body;
+            m_socket->Write(request.data(), request.length());
+            return ReadReply();
+            }
+
+        /// @returns The next reply, or a status of 0 if the connection was closed first.
+        HttpReply ReadReply()
+            {
+            HttpReply reply;
+            size_t headerEnd{ std::string::npos };
+            size_t contentLength{ 0 };
+            while (true)
+                {
+                if (headerEnd == std::string::npos)
+                    {
+                    headerEnd = m_buffer.find("\r\n\r\n");
+                    if (headerEnd != std::string::npos)
+                        {
+                        reply.m_status = std::stoi(m_buffer.substr(m_buffer.find(' ') + 1, 3));
+                        const std::string LENGTH_HEADER{ "Content-Length: " };
+                        const size_t lengthPos = m_buffer.find(LENGTH_HEADER);
+                        if (lengthPos != std::string::npos && lengthPos < headerEnd)
+                            {
+                            contentLength = std::stoul(
+                                m_buffer.substr(lengthPos + LENGTH_HEADER.length()));
+                            }
+                        headerEnd += 4;
+                        }
+                    }
+                if (headerEnd != std::string::npos &&
+                    m_buffer.length() >= headerEnd + contentLength)
+                    {
+                    reply.m_body = m_buffer.substr(headerEnd, contentLength);
+                    m_buffer.erase(0, headerEnd + contentLength);
+                    return reply;
+                    }
+                char readBuffer[4096];
+                m_socket->Read(readBuffer, sizeof(readBuffer));
+                if (m_socket->Error() || m_socket->LastReadCount() == 0)
+                    { return HttpReply{}; }
+                m_buffer.append(readBuffer, m_socket->LastReadCount());
+                }
+            }
+
+    private:
+        wxSocketClient* m_socket{ nullptr };
+        std::string m_buffer;
+        };
+
+    /// @brief Waits (while handling the server's events) for a client thread to finish.
+    template<typename T>
+    T GetClientResult(std::future<T>& result)
+        {
+        WaitForCondition([&result]()
+            { return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready; },
+            60'000);
+        return result.get();
+        }
+    } // namespace
+
+TEST_CASE("Scoring server", "[scoringserver]")
+    {
+    auto gate = std::make_shared<ScoringGate>();
+
+    SECTION("Responses")
+        {
+        ScoringServer server(0, 2, std::make_unique<TestScoringEngine>(gate));
+        wxString errorMessage;
+        REQUIRE(server.Start(errorMessage));
+        REQUIRE(server.GetPort() != 0);
+
+        // all on one (keep-alive) connection
+        auto result = std::async(std::launch::async,
+            [port = server.GetPort()]()
+            {
+            TestClient client(port);
+            std::vector<HttpReply> replies;
+            replies.push_back(client.Send("POST", "/score?label=memo", "Some text"));
+            replies.push_back(client.Send("POST", "/score", "fail"));
+            replies.push_back(client.Send("GET", "/nowhere"));
+            replies.push_back(client.Send("GET", "/tests"));
+            replies.push_back(client.Send("DELETE", "/score"));
+            return replies;
+            });
+        const auto replies = GetClientResult(result);
+        REQUIRE(replies.size() == 5);
+
+        CHECK(replies[0].m_status == 200);
+        CHECK(replies[0].m_body ==
+              R"({"path":"memo","succeeded":true,"words":9,"sentences":1,"scores":[)"
+              R"({"id":"flesch","name":"flesch","grade-level":null,"index":65.5,"cloze":null}]})");
+
+        CHECK(replies[1].m_status == 422);
+        CHECK(replies[1].m_body ==
+              R"({"path":"","succeeded":false,"error":"Unable to analyze the document."})");
+
+        CHECK(replies[2].m_status == 404);
+        CHECK(replies[2].m_body.find(R"({"error":)") == 0);
+
+        CHECK(replies[3].m_status == 200);
+        CHECK(replies[3].m_body == R"({"tests":["flesch","smog"]})");
+
+        CHECK(replies[4].m_status == 405);
+        }
+
+    SECTION("Busy")
+        {
+        // one worker, and room for only one connection to wait for it
+        ScoringServer server(0, 1, std::make_unique<TestScoringEngine>(gate), 1);
+        wxString errorMessage;
+        REQUIRE(server.Start(errorMessage));
+        gate->Close();
+
+        auto scoring = std::async(std::launch::async,
+            [port = server.GetPort()]()
+            {
+            TestClient client(port);
+            return client.Send("POST", "/score", "Some text").m_status;
+            });
+        // (the gate has to be opened again below, so don't bail out here)
+        CHECK(WaitForCondition([&gate]() { return gate->GetWaitingCount() == 1; }));
+
+        auto waiting = std::async(std::launch::async,
+            [port = server.GetPort()]()
+            {
+            TestClient queuedClient(port);
+            TestClient turnedAwayClient(port);
+            // (answered as soon as it is accepted, without reading a request)
+            const int turnedAwayStatus = turnedAwayClient.ReadReply().m_status;
+            const int queuedStatus = queuedClient.Send("GET", "/health").m_status;
+            return std::make_pair(queuedStatus, turnedAwayStatus);
+            });
+        // let the third connection be turned away before the worker is free
+        WaitForCondition([]() { return false; }, 1'000);
+        gate->Open();
+
+        CHECK(GetClientResult(scoring) == 200);
+        const auto [queuedStatus, turnedAwayStatus] = GetClientResult(waiting);
+        CHECK(queuedStatus == 200);
+        CHECK(turnedAwayStatus == 503);
+        }
+
+    SECTION("Idle connections don't hold up the workers")
+        {
+        ScoringServer server(0, 1, std::make_unique<TestScoringEngine>(gate));
+        wxString errorMessage;
+        REQUIRE(server.Start(errorMessage));
+
+        auto result = std::async(std::launch::async,
+            [port = server.GetPort()]()
+            {
+            // answered, then left open without sending anything else
+            TestClient idleClient(port);
+            idleClient.Send("GET", "/health");
+
+            TestClient client(port);
+            const auto start = std::chrono::steady_clock::now();
+            const int status = client.Send("POST", "/score", "Some text").m_status;
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            return std::make_pair(status, elapsed);
+            });
+        const auto [status, elapsed] = GetClientResult(result);
+        CHECK(status == 200);
+        // well under the time that the idle connection would be closed
+        CHECK(elapsed < std::chrono::seconds(ScoringServer::IDLE_TIMEOUT) / 5);
+        }
+
+    SECTION("Throughput")
+        {
+        // This measures the server itself (parsing, queueing, and answering requests),
+        // with a scorer that doesn't analyze anything. Throughput with DocumentScorer
+        // depends on the program's word lists and projects, which this runner doesn't
+        // link, so that has to be measured against a running server.
+        constexpr size_t CLIENT_COUNT{ 4 };
+        constexpr size_t REQUESTS_PER_CLIENT{ 500 };
+        // more connections than workers, so they have to take turns
+        ScoringServer server(0, 2, std::make_unique<TestScoringEngine>(gate));
+        wxString errorMessage;
+        REQUIRE(server.Start(errorMessage));
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::future<size_t>> results;
+        for (size_t i = 0; i < CLIENT_COUNT; ++i)
+            {
+            results.push_back(std::async(std::launch::async,
+                [port = server.GetPort()]()
+                {
+                TestClient client(port);
+                size_t succeeded{ 0 };
+                for (size_t j = 0; j < REQUESTS_PER_CLIENT; ++j)
+                    {
+                    if (client.Send("POST", "/score", "Some text.").m_status == 200)
+                        { ++succeeded; }
+                    }
+                return succeeded;
+                }));
+            }
+        size_t succeeded{ 0 };
+        for (auto& result : results)
+            { succeeded += GetClientResult(result); }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        CHECK(succeeded == CLIENT_COUNT * REQUESTS_PER_CLIENT);
+        WARN("Scoring server (without analysis): " << succeeded << " requests over " << CLIENT_COUNT
+             << " keep-alive connections in " << elapsed.count() << " seconds ("
+             << static_cast<size_t>(succeeded / elapsed.count()) << " requests per second).");
+        }
+
+    gate->Open();
+    }
+
+// NOLINTEND
@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <vector>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/wx.h>
+#include "../../src/projects/source_file_watcher.h"
+#include "testscoringengine.h"
+
+// NOLINTBEGIN
+
+namespace
+    {
+    /// @brief Edits a file (changing its size) and reports it, as the system would.
+    void EditFile(SourceFileWatcher& watcher, const wxString& path)
+        {
+        wxFFile file(path, L"ab");
+        file.Write(wxString{ L" More text." });
+        file.Close();
+        watcher.QueueChangedFile(SourceFileWatcher::NormalizePath(path));
+        watcher.ScheduleDispatch();
+        }
+
+    /// @brief A callback's calls, with when they were made.
+    struct Notifications
+        {
+        SourceFileWatcher::ChangeCallback GetCallback()
+            {
+            return [this](const wxArrayString& changedFiles)
+                {
+                std::vector<wxString> files(changedFiles.begin(), changedFiles.end());
+                std::sort(files.begin(), files.end());
+                m_calls.push_back(files);
+                m_times.push_back(wxGetLocalTimeMillis());
+                };
+            }
+
+        std::vector<std::vector<wxString>> m_calls;
+        std::vector<wxLongLong> m_times;
+        };
+
+    /// @brief Handles events for a while (e.g., to see that nothing else is reported).
+    void Pause(const long milliseconds) { WaitForCondition([]() { return false; }, milliseconds); }
+    } // namespace
+
+TEST_CASE("Source file watcher debouncing", "[sourcefilewatcher]")
+    {
+    TempFolder folder{ L"rssource" };
+    const wxString file = folder.AddFile(L"document.txt");
+    SourceFileWatcher watcher;
+    Notifications notifications;
+    int owner{ 0 };
+    watcher.Watch(&owner, wxArrayString(1, &file), notifications.GetCallback());
+    REQUIRE(watcher.IsWatching(&owner));
+
+    SECTION("A burst of writes is reported once, after the file is quiet")
+        {
+        // an editor saving with several writes, closer together than the debounce interval
+        wxLongLong lastWrite{ 0 };
+        for (int i = 0; i < 5; ++i)
+            {
+            EditFile(watcher, file);
+            lastWrite = wxGetLocalTimeMillis();
+            Pause(SourceFileWatcher::DEBOUNCE_INTERVAL / 4);
+            }
+        CHECK(notifications.m_calls.empty());
+
+        REQUIRE(WaitForCondition([&notifications]() { return !notifications.m_calls.empty(); }));
+        CHECK((notifications.m_times.front() - lastWrite) >=
+              (SourceFileWatcher::DEBOUNCE_INTERVAL * 9) / 10);
+        CHECK(notifications.m_calls.front() == std::vector<wxString>{ file });
+
+        Pause(SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+        CHECK(notifications.m_calls.size() == 1);
+        }
+
+    SECTION("A file that keeps changing is still reported")
+        {
+        const wxLongLong firstWrite = wxGetLocalTimeMillis();
+        while (notifications.m_calls.empty() &&
+               (wxGetLocalTimeMillis() - firstWrite) < SourceFileWatcher::MAX_DEBOUNCE_DELAY * 2)
+            {
+            EditFile(watcher, file);
+            Pause(SourceFileWatcher::DEBOUNCE_INTERVAL / 4);
+            }
+        REQUIRE(notifications.m_calls.size() == 1);
+        CHECK((notifications.m_times.front() - firstWrite) <
+              SourceFileWatcher::MAX_DEBOUNCE_DELAY + SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+        }
+
+    SECTION("Files that are only read or touched are not reported")
+        {
+        // a notification, but the file's time and size are the same
+        watcher.QueueChangedFile(SourceFileWatcher::NormalizePath(file));
+        watcher.ScheduleDispatch();
+        Pause(SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+        CHECK(notifications.m_calls.empty());
+        }
+
+    SECTION("Files are not reported after being unwatched")
+        {
+        EditFile(watcher, file);
+        watcher.Unwatch(&owner);
+        CHECK_FALSE(watcher.IsWatching(&owner));
+        Pause(SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+        CHECK(notifications.m_calls.empty());
+        }
+
+    watcher.Unwatch(&owner);
+    }
+
+TEST_CASE("Source file watcher coalescing", "[sourcefilewatcher]")
+    {
+    TempFolder folder{ L"rssource" };
+    const wxString firstFile = folder.AddFile(L"first.txt");
+    const wxString secondFile = folder.AddFile(L"second.txt");
+    const wxString thirdFile = folder.AddFile(L"third.txt");
+    SourceFileWatcher watcher;
+
+    Notifications projectNotifications;
+    int project{ 0 };
+    wxArrayString projectFiles;
+    projectFiles.push_back(firstFile);
+    projectFiles.push_back(secondFile);
+    projectFiles.push_back(thirdFile);
+    watcher.Watch(&project, projectFiles, projectNotifications.GetCallback());
+
+    // another project sharing one of the files
+    Notifications otherNotifications;
+    int otherProject{ 0 };
+    watcher.Watch(&otherProject, wxArrayString(1, &secondFile),
+                  otherNotifications.GetCallback());
+
+    SECTION("Files changed together are reported together, once per project")
+        {
+        EditFile(watcher, firstFile);
+        EditFile(watcher, secondFile);
+        REQUIRE(WaitForCondition(
+            [&]()
+            {
+                return !projectNotifications.m_calls.empty() &&
+                       !otherNotifications.m_calls.empty();
+            }));
+        Pause(SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+
+        REQUIRE(projectNotifications.m_calls.size() == 1);
+        std::vector<wxString> expectedFiles{ firstFile, secondFile };
+        std::sort(expectedFiles.begin(), expectedFiles.end());
+        CHECK(projectNotifications.m_calls.front() == expectedFiles);
+
+        REQUIRE(otherNotifications.m_calls.size() == 1);
+        CHECK(otherNotifications.m_calls.front() == std::vector<wxString>{ secondFile });
+        }
+
+    SECTION("Changes during a callback are reported afterwards")
+        {
+        // a project reloading (and yielding) when another file changes
+        bool editedDuringCallback{ false };
+        int nestedCalls{ 0 };
+        bool inCallback{ false };
+        watcher.Watch(&otherProject, wxArrayString(1, &secondFile),
+                      [&](const wxArrayString& changedFiles)
+                      {
+                          if (inCallback)
+                              {
+                              ++nestedCalls;
+                              }
+                          inCallback = true;
+                          if (!editedDuringCallback)
+                              {
+                              editedDuringCallback = true;
+                              EditFile(watcher, thirdFile);
+                              Pause(SourceFileWatcher::DEBOUNCE_INTERVAL * 2);
+                              }
+                          otherNotifications.GetCallback()(changedFiles);
+                          inCallback = false;
+                      });
+        EditFile(watcher, secondFile);
+        REQUIRE(WaitForCondition([&projectNotifications]()
+                                 { return projectNotifications.m_calls.size() == 2; }));
+        CHECK(nestedCalls == 0);
+        CHECK(projectNotifications.m_calls[0] == std::vector<wxString>{ secondFile });
+        CHECK(projectNotifications.m_calls[1] == std::vector<wxString>{ thirdFile });
+        CHECK(otherNotifications.m_calls.size() == 1);
+        }
+
+    watcher.Unwatch(&project);
+    watcher.Unwatch(&otherProject);
+    }
+
+// NOLINTEND
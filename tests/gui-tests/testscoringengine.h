@@ -0,0 +1,183 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#ifndef __TEST_SCORING_ENGINE_H__
+#define __TEST_SCORING_ENGINE_H__
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <wx/app.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/time.h>
+#include <wx/utils.h>
+#include "../../src/projects/scoring_engine.h"
+
+// NOLINTBEGIN
+
+/// @brief Holds the (fake) workers of a TestScoringEngine until it is opened.
+class ScoringGate
+    {
+public:
+    void Close()
+        {
+        std::lock_guard lock(m_mutex);
+        m_open = false;
+        }
+    void Open()
+        {
+            {
+            std::lock_guard lock(m_mutex);
+            m_open = true;
+            }
+        m_condition.notify_all();
+        }
+    void Wait()
+        {
+        std::unique_lock lock(m_mutex);
+        ++m_waiting;
+        m_condition.wait(lock, [this]() { return m_open; });
+        --m_waiting;
+        }
+    /// @returns The number of workers being held.
+    size_t GetWaitingCount()
+        {
+        std::lock_guard lock(m_mutex);
+        return m_waiting;
+        }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_open{ true };
+    size_t m_waiting{ 0 };
+    };
+
+/// @brief A scorer that doesn't analyze anything, for testing the services that use one.
+/// @details Files and text "succeed" with their length as the word count, unless the
+///     text is "fail". Workers wait for the gate before they return.
+class TestScoringEngine final : public ScoringEngine
+    {
+public:
+    explicit TestScoringEngine(std::shared_ptr<ScoringGate> gate) : m_gate(std::move(gate))
+        {}
+
+    [[nodiscard]]
+    std::unique_ptr<Worker> CreateWorker() const final
+        { return std::make_unique<TestWorker>(m_gate); }
+
+    [[nodiscard]]
+    std::vector<wxString> GetTestNames() const final
+        { return { L"flesch", L"smog" }; }
+
+private:
+    class TestWorker final : public Worker
+        {
+    public:
+        explicit TestWorker(std::shared_ptr<ScoringGate> gate) : m_gate(std::move(gate))
+            {}
+
+        [[nodiscard]]
+        Result ScoreFile(const wxString& filePath) final
+            {
+            m_gate->Wait();
+            Result result;
+            result.m_path = filePath;
+            result.m_succeeded = true;
+            result.m_words = 1;
+            result.m_sentences = 1;
+            return result;
+            }
+
+        [[nodiscard]]
+        Result ScoreText(std::wstring text, const wxString& label) final
+            {
+            m_gate->Wait();
+            Result result;
+            result.m_path = label;
+            if (text == L"fail")
+                {
+                result.m_error = L"Unable to analyze the document.";
+                return result;
+                }
+            result.m_succeeded = true;
+            result.m_words = text.length();
+            result.m_sentences = 1;
+            TestScore score;
+            score.m_id = score.m_name = L"flesch";
+            score.m_indexScore = 65.5;
+            result.m_scores.push_back(score);
+            return result;
+            }
+    private:
+        std::shared_ptr<ScoringGate> m_gate;
+        };
+
+    std::shared_ptr<ScoringGate> m_gate;
+    };
+
+/// @brief Handles events until @c condition is met.
+/// @returns @c false if it timed out.
+inline bool WaitForCondition(const std::function<bool()>& condition,
+                             const long timeoutMilliseconds = 10'000)
+    {
+    const wxLongLong start = wxGetLocalTimeMillis();
+    while (!condition())
+        {
+        if ((wxGetLocalTimeMillis() - start) > timeoutMilliseconds)
+            { return false; }
+        wxTheApp->Yield(true);
+        wxMilliSleep(10);
+        }
+    return true;
+    }
+
+/// @brief A temporary folder of test files, removed (with its files) afterwards.
+class TempFolder
+    {
+public:
+    /// @param prefix The start of the folder's (unique) name.
+    explicit TempFolder(const wxString& prefix)
+        {
+        const wxString tempFile = wxFileName::CreateTempFileName(prefix);
+        wxRemoveFile(tempFile);
+        m_folder = tempFile;
+        wxFileName::Mkdir(m_folder);
+        }
+    TempFolder(const TempFolder&) = delete;
+    TempFolder& operator=(const TempFolder&) = delete;
+    ~TempFolder() { wxFileName::Rmdir(m_folder, wxPATH_RMDIR_RECURSIVE); }
+
+    /// @brief Writes a file (as-is, byte for byte) into the folder.
+    /// @returns The file's full path.
+    wxString AddFile(const wxString& name, const std::string& content = "Some text.") const
+        {
+        const wxString path = wxFileName{ m_folder, name }.GetFullPath();
+        wxFFile file(path, L"wb");
+        file.Write(content.data(), content.length());
+        file.Close();
+        return path;
+        }
+
+    [[nodiscard]]
+    const wxString& GetFolder() const noexcept
+        { return m_folder; }
+private:
+    wxString m_folder;
+    };
+
+// NOLINTEND
+
+#endif //__TEST_SCORING_ENGINE_H__
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include <wx/filename.h>
+#include <wx/wx.h>
+#include "../../src/webharvester/visitedurlset.h"
+
+// NOLINTBEGIN
+
+TEST_CASE("Visited URL set", "[webharvester][visitedurlset]")
+    {
+    SECTION("Insert and contains")
+        {
+        VisitedUrlSet urls;
+        CHECK(urls.Insert(L"https://www.example.com/docs/page.html"));
+        CHECK(urls.Contains(L"https://www.example.com/docs/page.html"));
+        CHECK_FALSE(urls.Contains(L"https://www.example.com/docs/other.html"));
+        // already in the set
+        CHECK_FALSE(urls.Insert(L"https://www.example.com/docs/page.html"));
+        CHECK(urls.GetCount() == 1);
+        }
+
+    SECTION("Normalization")
+        {
+        VisitedUrlSet urls;
+        CHECK(urls.Insert(L"https://www.example.com/docs/"));
+        // trailing slash and casing are ignored
+        CHECK(urls.Contains(L"https://www.example.com/docs"));
+        CHECK(urls.Contains(L"HTTPS://WWW.EXAMPLE.COM/Docs/"));
+        CHECK_FALSE(urls.Insert(L"https://www.example.com/DOCS"));
+        CHECK(urls.GetCount() == 1);
+        CHECK(VisitedUrlSet::HashUrl(L"https://example.com/a/") ==
+              VisitedUrlSet::HashUrl(L"https://EXAMPLE.com/a"));
+        CHECK(VisitedUrlSet::HashUrl(L"https://example.com/a") !=
+              VisitedUrlSet::HashUrl(L"https://example.com/b"));
+        }
+
+    SECTION("Growing")
+        {
+        VisitedUrlSet urls;
+        // several times the initial table size
+        for (size_t i = 0; i < 10'000; ++i)
+            {
+            CHECK(urls.Insert(wxString::Format(L"https://www.example.com/page%zu.html", i)));
+            }
+        CHECK(urls.GetCount() == 10'000);
+        size_t found{ 0 };
+        for (size_t i = 0; i < 10'000; ++i)
+            {
+            if (urls.Contains(wxString::Format(L"https://www.example.com/page%zu.html", i)))
+                {
+                ++found;
+                }
+            }
+        CHECK(found == 10'000);
+        CHECK_FALSE(urls.Contains(L"https://www.example.com/page10000.html"));
+        }
+
+    SECTION("Spilling has no false negatives and bounded false positives")
+        {
+        VisitedUrlSet urls;
+        // spill every 100 URLs, into a filter sized for 1,000 URLs at 1%
+        urls.SpillToDisk(100, 1'000, 0.01);
+        for (size_t i = 0; i < 1'000; ++i)
+            {
+            urls.Insert(wxString::Format(L"https://www.example.com/seen%zu.html", i));
+            }
+        CHECK(urls.GetCount() == 1'000);
+
+        // everything added is still found after being spilled
+        size_t found{ 0 };
+        for (size_t i = 0; i < 1'000; ++i)
+            {
+            if (urls.Contains(wxString::Format(L"https://www.example.com/seen%zu.html", i)))
+                {
+                ++found;
+                }
+            }
+        CHECK(found == 1'000);
+
+        // ...but some URLs that weren't added are reported as seen now
+        size_t falsePositives{ 0 };
+        for (size_t i = 0; i < 10'000; ++i)
+            {
+            if (urls.Contains(wxString::Format(L"https://www.example.com/unseen%zu.html", i)))
+                {
+                ++falsePositives;
+                }
+            }
+        CHECK(falsePositives > 0);
+        // around 1% is expected, allow for some variance
+        CHECK(falsePositives < 300);
+        }
+
+    SECTION("Without spilling there are no false positives")
+        {
+        VisitedUrlSet urls;
+        for (size_t i = 0; i < 1'000; ++i)
+            {
+            urls.Insert(wxString::Format(L"https://www.example.com/seen%zu.html", i));
+            }
+        size_t falsePositives{ 0 };
+        for (size_t i = 0; i < 10'000; ++i)
+            {
+            if (urls.Contains(wxString::Format(L"https://www.example.com/unseen%zu.html", i)))
+                {
+                ++falsePositives;
+                }
+            }
+        CHECK(falsePositives == 0);
+        }
+
+    SECTION("Save and load")
+        {
+        const wxString filePath = wxFileName::CreateTempFileName(L"rsurltest");
+            {
+            VisitedUrlSet urls;
+            urls.SpillToDisk(100, 1'000, 0.01);
+            // some spilled, some still in memory
+            for (size_t i = 0; i < 250; ++i)
+                {
+                urls.Insert(wxString::Format(L"https://www.example.com/page%zu.html", i));
+                }
+            CHECK(urls.Save(filePath));
+            }
+
+        VisitedUrlSet loadedUrls;
+        CHECK(loadedUrls.Load(filePath));
+        CHECK(loadedUrls.GetCount() == 250);
+        size_t found{ 0 };
+        for (size_t i = 0; i < 250; ++i)
+            {
+            if (loadedUrls.Contains(wxString::Format(L"https://www.example.com/page%zu.html", i)))
+                {
+                ++found;
+                }
+            }
+        CHECK(found == 250);
+        // loaded without spilling, so lookups are exact again
+        CHECK_FALSE(loadedUrls.Contains(L"https://www.example.com/page250.html"));
+
+        // not a URL set file
+        wxFile badFile(filePath, wxFile::write);
+        badFile.Write(L"hello");
+        badFile.Close();
+        VisitedUrlSet badUrls;
+        CHECK_FALSE(badUrls.Load(filePath));
+        wxRemoveFile(filePath);
+        }
+
+    SECTION("Clear")
+        {
+        VisitedUrlSet urls;
+        urls.SpillToDisk(10, 100, 0.01);
+        for (size_t i = 0; i < 50; ++i)
+            {
+            urls.Insert(wxString::Format(L"https://www.example.com/page%zu.html", i));
+            }
+        urls.Clear();
+        CHECK(urls.GetCount() == 0);
+        CHECK_FALSE(urls.Contains(L"https://www.example.com/page0.html"));
+        CHECK(urls.Insert(L"https://www.example.com/page0.html"));
+        }
+    }
+
+// NOLINTEND
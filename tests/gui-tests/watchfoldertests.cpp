@@ -0,0 +1,240 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/wx.h>
+#include "../../src/projects/watch_folder_service.h"
+#include "testscoringengine.h"
+
+// NOLINTBEGIN
+
+namespace
+    {
+    /// @brief A temporary folder to watch (and its results file), removed afterwards.
+    class TempWatchFolder : public TempFolder
+        {
+    public:
+        TempWatchFolder()
+            : TempFolder(L"rswatch"),
+              m_storePath(wxFileName{ wxFileName::GetTempDir(),
+                                      wxFileName{ GetFolder() }.GetName() + L".jsonl" }
+                              .GetFullPath())
+            {}
+        ~TempWatchFolder() { wxRemoveFile(m_storePath); }
+
+        [[nodiscard]]
+        wxString ReadStore() const
+            {
+            wxString content;
+            wxFFile store(m_storePath, L"rb");
+            if (store.IsOpened())
+                { store.ReadAll(&content, wxConvUTF8); }
+            return content;
+            }
+
+        std::unique_ptr<WatchFolderService>
+        CreateService(const std::shared_ptr<ScoringGate>& gate) const
+            {
+            return std::make_unique<WatchFolderService>(
+                GetFolder(), m_storePath, 1, std::make_unique<TestScoringEngine>(gate),
+                L"*.txt;*.htm");
+            }
+
+    private:
+        wxString m_storePath;
+        };
+    } // namespace
+
+TEST_CASE("Scoring JSON", "[watchfolder][scoringjson]")
+    {
+    SECTION("Strings round trip")
+        {
+        const wxString texts[] = {
+            L"", L"plain", L"say \"hi\"", L"C:\\docs\\file.txt", L"line\nbreak\r\n\ttab",
+            wxString{ L"bell\x07" } + wxString{ L"\x1F" }, L"na\u00EFve \u65E5\u672C\u8A9E" };
+        for (const auto& text : texts)
+            {
+            std::string json{ "[" };
+            ScoringEngine::AppendJsonString(json, text);
+            json += ",1]";
+            size_t pos{ 1 };
+            wxString readText;
+            CHECK(ScoringEngine::ReadJsonString(json, pos, readText));
+            CHECK(readText == text);
+            // right after the closing quote
+            CHECK(json[pos] == ',');
+            }
+        }
+
+    SECTION("Bad strings")
+        {
+        size_t pos{ 0 };
+        wxString value;
+        CHECK_FALSE(ScoringEngine::ReadJsonString("nope", pos, value));
+        CHECK_FALSE(ScoringEngine::ReadJsonString("\"cut off", pos, value));
+        CHECK_FALSE(ScoringEngine::ReadJsonString("\"cut off\\", pos, value));
+        CHECK_FALSE(ScoringEngine::ReadJsonString("\"\\u00zz\"", pos, value));
+        // the position is left alone if nothing is read
+        CHECK(pos == 0);
+        }
+
+    SECTION("Results")
+        {
+        ScoringEngine::Result result;
+        result.m_path = L"/docs/\"odd\" name.txt";
+        result.m_succeeded = true;
+        result.m_words = 120;
+        result.m_sentences = 8;
+        ScoringEngine::TestScore score;
+        score.m_id = L"flesch";
+        score.m_name = L"Flesch";
+        score.m_indexScore = 65.5;
+        result.m_scores.push_back(score);
+        std::string json;
+        ScoringEngine::AppendJson(json, result);
+        CHECK(json.find("\"words\":120,\"sentences\":8") != std::string::npos);
+        CHECK(json.find("\"grade-level\":null,\"index\":65.5,\"cloze\":null") !=
+              std::string::npos);
+        // the path is read back from the start of the object
+        size_t pos{ std::string{ "{\"path\":" }.length() };
+        wxString path;
+        CHECK(ScoringEngine::ReadJsonString(json, pos, path));
+        CHECK(path == result.m_path);
+
+        result.m_succeeded = false;
+        result.m_error = L"No text was found in the document.";
+        json.clear();
+        ScoringEngine::AppendJson(json, result);
+        CHECK(json.find("\"succeeded\":false,\"error\":\"No text was found") !=
+              std::string::npos);
+        CHECK(json.find("scores") == std::string::npos);
+        }
+
+    SECTION("Integers")
+        {
+        size_t pos{ 0 };
+        long long value{ 0 };
+        CHECK(ScoringEngine::ReadJsonInteger("1700000000123,", pos, value));
+        CHECK(value == 1'700'000'000'123);
+        CHECK(pos == 13);
+        pos = 0;
+        CHECK_FALSE(ScoringEngine::ReadJsonInteger("null", pos, value));
+        }
+    }
+
+TEST_CASE("Watch folder service", "[watchfolder]")
+    {
+    TempWatchFolder folder;
+    auto gate = std::make_shared<ScoringGate>();
+
+    SECTION("Store round trip")
+        {
+        // quotes, backslashes, and non-ASCII characters all have to survive being stored
+#ifdef __WXMSW__
+        const wxString filePath = folder.AddFile(L"na\u00EFve \u65E5\u672C.txt");
+#else
+        const wxString filePath = folder.AddFile(L"say \"hi\" \\ na\u00EFve.txt");
+#endif
+        folder.AddFile(L"skipped.pdfx", "Not a supported file.");
+            {
+            auto service = folder.CreateService(gate);
+            wxString errorMessage;
+            REQUIRE(service->Start(errorMessage));
+            CHECK(service->GetPendingCount() == 1);
+            CHECK(WaitForCondition([&service]() { return service->GetScoredCount() == 1; }));
+            }
+        CHECK(folder.ReadStore().Contains(L"\"succeeded\":true"));
+
+        // restarting reads what was already scored and doesn't queue it again
+        auto service = folder.CreateService(gate);
+        wxString errorMessage;
+        REQUIRE(service->Start(errorMessage));
+        CHECK(service->GetScoredCount() == 1);
+        CHECK(service->GetPendingCount() == 0);
+
+        // a changed file is queued again
+        service.reset();
+        wxFFile file(filePath, L"ab");
+        file.Write(wxString{ L" More text." });
+        file.Close();
+        service = folder.CreateService(gate);
+        REQUIRE(service->Start(errorMessage));
+        CHECK(service->GetPendingCount() == 1);
+        }
+
+    SECTION("Back-pressure")
+        {
+        auto service = folder.CreateService(gate);
+        for (size_t i = 0; i < WatchFolderService::MAX_PENDING_FILES; ++i)
+            {
+            service->QueueFile(wxString::Format(L"/docs/file%zu.txt", i));
+            }
+        CHECK(service->GetPendingCount() == WatchFolderService::MAX_PENDING_FILES);
+        CHECK_FALSE(service->IsRescanNeeded());
+        // a file already waiting only has its time updated
+        service->QueueFile(L"/docs/file0.txt");
+        CHECK_FALSE(service->IsRescanNeeded());
+        // unsupported files are ignored
+        service->QueueFile(L"/docs/image.png");
+        CHECK_FALSE(service->IsRescanNeeded());
+        // the backlog is full, so this is dropped (and picked up by a scan later)
+        service->QueueFile(L"/docs/one-more.txt");
+        CHECK(service->GetPendingCount() == WatchFolderService::MAX_PENDING_FILES);
+        CHECK(service->IsRescanNeeded());
+        }
+
+    SECTION("Quiet interval")
+        {
+        auto service = folder.CreateService(gate);
+        wxString errorMessage;
+        REQUIRE(service->Start(errorMessage));
+        gate->Close();
+
+        const wxString filePath = folder.AddFile(L"arriving.txt");
+        service->QueueFile(filePath);
+        // still being written to, as far as the service knows
+        service->DispatchFiles();
+        CHECK(service->GetPendingCount() == 1);
+        CHECK(service->GetScoringCount() == 0);
+
+        wxMilliSleep(WatchFolderService::QUIET_INTERVAL + 100);
+        service->DispatchFiles();
+        CHECK(service->GetPendingCount() == 0);
+        CHECK(service->GetScoringCount() == 1);
+
+        // changed again while being scored, so it waits until that's done
+        service->QueueFile(filePath);
+        wxMilliSleep(WatchFolderService::QUIET_INTERVAL + 100);
+        service->DispatchFiles();
+        CHECK(service->GetPendingCount() == 1);
+        CHECK(service->GetScoringCount() == 1);
+
+        gate->Open();
+        CHECK(WaitForCondition([&service]() { return service->GetScoredCount() == 1; }));
+        }
+
+    SECTION("Files removed while being scored are dropped")
+        {
+        auto service = folder.CreateService(gate);
+        wxString errorMessage;
+        REQUIRE(service->Start(errorMessage));
+        gate->Close();
+
+        const wxString filePath = folder.AddFile(L"short-lived.txt");
+        service->QueueFile(filePath);
+        wxMilliSleep(WatchFolderService::QUIET_INTERVAL + 100);
+        service->DispatchFiles();
+        REQUIRE(service->GetScoringCount() == 1);
+
+        wxRemoveFile(filePath);
+        service->OnFileRemoved(filePath);
+        gate->Open();
+        CHECK(WaitForCondition([&service]() { return service->GetScoringCount() == 0; }));
+        CHECK(service->GetScoredCount() == 0);
+        CHECK_FALSE(folder.ReadStore().Contains(L"short-lived.txt"));
+        }
+    }
+
+// NOLINTEND
@@ -0,0 +1,116 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "../src/projects/http_request.h"
+#include <catch2/catch_test_macros.hpp>
+
+// clang-format off
+// NOLINTBEGIN
+
+TEST_CASE("HTTP request", "[http-request]")
+    {
+    HttpRequest request;
+
+    SECTION("GET with query")
+        {
+        const std::string buffer{ "GET /score?path=%2Fdocs%2Fmy+file.txt&empty HTTP/1.1\r\n"
+                                  "Host: 127.0.0.1\r\n\r\n" };
+        CHECK(request.Parse(buffer, 1024) == HttpRequest::ParseResult::Complete);
+        CHECK(request.GetMethod() == "GET");
+        CHECK(request.GetPath() == "/score");
+        CHECK(request.GetQueryValue("path") == std::optional<std::string>{ "/docs/my file.txt" });
+        CHECK(request.GetQueryValue("empty") == std::optional<std::string>{ "" });
+        CHECK_FALSE(request.GetQueryValue("label"));
+        CHECK(request.GetHeader("host") == std::optional<std::string>{ "127.0.0.1" });
+        CHECK(request.GetBody().empty());
+        CHECK(request.GetRequestSize() == buffer.length());
+        CHECK(request.IsKeepAlive());
+        }
+
+    SECTION("POST with body, pipelined")
+        {
+        const std::string first{ "POST /score HTTP/1.1\r\nContent-Length: 11\r\n\r\nHello world" };
+        const std::string buffer{ first + "GET /health HTTP/1.1\r\n\r\n" };
+        CHECK(request.Parse(buffer, 1024) == HttpRequest::ParseResult::Complete);
+        CHECK(request.GetMethod() == "POST");
+        CHECK(request.GetBody() == "Hello world");
+        CHECK(request.GetRequestSize() == first.length());
+
+        CHECK(request.Parse(std::string_view{ buffer }.substr(request.GetRequestSize()), 1024) ==
+              HttpRequest::ParseResult::Complete);
+        CHECK(request.GetPath() == "/health");
+        }
+
+    SECTION("Incomplete")
+        {
+        CHECK(request.Parse("GET /health HTTP/1.1\r\nHost: 127", 1024) ==
+              HttpRequest::ParseResult::Incomplete);
+        CHECK(request.Parse("POST /score HTTP/1.1\r\nContent-Length: 11\r\n\r\nHello", 1024) ==
+              HttpRequest::ParseResult::Incomplete);
+        }
+
+    SECTION("Invalid")
+        {
+        CHECK(request.Parse("hello\r\n\r\n", 1024) == HttpRequest::ParseResult::Invalid);
+        CHECK(request.Parse("GET score HTTP/1.1\r\n\r\n", 1024) ==
+              HttpRequest::ParseResult::Invalid);
+        CHECK(request.Parse("GET /score SPDY/3\r\n\r\n", 1024) ==
+              HttpRequest::ParseResult::Invalid);
+        CHECK(request.Parse("POST /score HTTP/1.1\r\nContent-Length: -1\r\n\r\n", 1024) ==
+              HttpRequest::ParseResult::Invalid);
+        CHECK(request.Parse("POST /score HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", 1024) ==
+              HttpRequest::ParseResult::Invalid);
+        }
+
+    SECTION("Too large")
+        {
+        CHECK(request.Parse("POST /score HTTP/1.1\r\nContent-Length: 2048\r\n\r\n", 1024) ==
+              HttpRequest::ParseResult::TooLarge);
+        CHECK(request.Parse(std::string(HttpRequest::MAX_HEADER_SIZE + 1, 'a'), 1024) ==
+              HttpRequest::ParseResult::TooLarge);
+        }
+
+    SECTION("Keep alive")
+        {
+        CHECK(request.Parse("GET / HTTP/1.1\r\nConnection: Close\r\n\r\n", 0) ==
+              HttpRequest::ParseResult::Complete);
+        CHECK_FALSE(request.IsKeepAlive());
+        CHECK(request.Parse("GET / HTTP/1.0\r\n\r\n", 0) == HttpRequest::ParseResult::Complete);
+        CHECK_FALSE(request.IsKeepAlive());
+        CHECK(request.Parse("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n", 0) ==
+              HttpRequest::ParseResult::Complete);
+        CHECK(request.IsKeepAlive());
+        }
+
+    SECTION("Decode URL")
+        {
+        CHECK(HttpRequest::DecodeUrl("a%20b+c", false) == "a b+c");
+        CHECK(HttpRequest::DecodeUrl("a%20b+c", true) == "a b c");
+        // malformed escapes are left as they are
+        CHECK(HttpRequest::DecodeUrl("100%", true) == "100%");
+        CHECK(HttpRequest::DecodeUrl("%zz", true) == "%zz");
+        }
+
+    SECTION("Response")
+        {
+        CHECK(HttpRequest::FormatResponse(200, "application/json", "{}", true) ==
+              "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\n"
+              "Connection: keep-alive\r\n\r\n{}");
+        CHECK(HttpRequest::FormatResponse(404, "text/plain", "", false) ==
+              "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 0\r\n"
+              "Connection: close\r\n\r\n");
+        }
+    }
+
+// NOLINTEND
+// clang-format on
@@ -11,6 +11,7 @@
  *   Blake Madden - initial implementation
  ********************************************************************************/
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -295,5 +296,125 @@ TEST_CASE("ischaracter", "[ischaracter]")
             }
         }
     }
+
+// the reference definitions are what is used at compile time
+static_assert(is_character::is_alpha(L'a') && !is_character::is_alpha(L'1'));
+static_assert(is_character::is_space(0x3000) && is_character{}(L'#'));
+
+TEST_CASE("ischaracter lookup table", "[ischaracter]")
+    {
+    SECTION("Matches reference")
+        {
+        const auto expected = [](const wchar_t ch)
+            {
+            return std::vector<bool>{
+                is_character::reference::is_upper(ch), is_character::reference::is_lower(ch),
+                is_character::reference::is_alpha(ch), is_character::reference::is_vowel(ch),
+                is_character::reference::is_consonant(ch),
+                is_character::reference::can_character_begin_word(ch),
+                is_character::reference::can_character_begin_word_uppercase(ch),
+                is_character::reference::can_character_end_word(ch),
+                is_character::reference::can_character_end_numeral(ch),
+                is_character::reference::is_word_character(ch),
+                is_character::reference::is_dash(ch), is_character::reference::is_apostrophe(ch),
+                is_character::reference::can_character_prefix_numeral(ch),
+                is_character::reference::is_quote(ch),
+                is_character::reference::is_single_quote(ch),
+                is_character::reference::is_double_quote(ch),
+                is_character::reference::is_numeric(ch),
+                is_character::reference::is_extended_numeric(ch),
+                is_character::reference::is_space(ch),
+                is_character::reference::is_space_horizontal(ch),
+                is_character::reference::is_space_horizontal_except_tab(ch),
+                is_character::reference::is_space_vertical(ch),
+                is_character::reference::is_punctuation(ch),
+                (is_character::reference::is_lower(ch) && is_character::reference::is_consonant(ch)) };
+            };
+        const auto actual = [](const wchar_t ch)
+            {
+            return std::vector<bool>{
+                is_character::is_upper(ch), is_character::is_lower(ch),
+                is_character::is_alpha(ch), is_character::is_vowel(ch),
+                is_character::is_consonant(ch), is_character::can_character_begin_word(ch),
+                is_character::can_character_begin_word_uppercase(ch),
+                is_character::can_character_end_word(ch),
+                is_character::can_character_end_numeral(ch), is_character{}(ch),
+                is_character::is_dash(ch), is_character::is_apostrophe(ch),
+                is_character::can_character_prefix_numeral(ch), is_character::is_quote(ch),
+                is_character::is_single_quote(ch), is_character::is_double_quote(ch),
+                is_character::is_numeric(ch), is_character::is_extended_numeric(ch),
+                is_character::is_space(ch), is_character::is_space_horizontal(ch),
+                is_character::is_space_horizontal_except_tab(ch),
+                is_character::is_space_vertical(ch), is_character::is_punctuation(ch),
+                is_character::is_lower_consonant(ch) };
+            };
+        // every character in the table (only report the first mismatch, there are a lot of them)
+        wchar_t mismatch{ 0 };
+        for (uint32_t i = 0; i <= 0xFFFF; ++i)
+            {
+            const auto ch = static_cast<wchar_t>(i);
+            if (expected(ch) != actual(ch))
+                {
+                mismatch = ch;
+                break;
+                }
+            }
+        CHECK(static_cast<uint32_t>(mismatch) == 0);
+        // outside of the table
+        if constexpr (sizeof(wchar_t) > 2)
+            {
+            CHECK(expected(static_cast<wchar_t>(0x1F600)) == actual(static_cast<wchar_t>(0x1F600)));
+            CHECK(expected(static_cast<wchar_t>(-1)) == actual(static_cast<wchar_t>(-1)));
+            }
+        }
+
+    SECTION("Properties")
+        {
+        CHECK(is_character::get_properties(L'b') ==
+            (is_character::property::lower | is_character::property::alpha |
+             is_character::property::consonant | is_character::property::begin_word |
+             is_character::property::end_word | is_character::property::word_character));
+        CHECK(is_character::get_properties(L' ') ==
+            (is_character::property::space | is_character::property::space_horizontal |
+             is_character::property::space_horizontal_except_tab));
+        }
+    }
+
+// hidden, run with "[benchmark]"
+TEST_CASE("ischaracter lookup table benchmark", "[.][benchmark][ischaracter]")
+    {
+    std::wstring text;
+    for (size_t i = 0; i < 2'000; ++i)
+        {
+        text += L"The quick brown fox—who was “very” fast—jumped over 3½ lazy dogs' "
+                L"backs in Zürich & Москва on 12/05/2024 at 5:00 PM. ";
+        }
+
+    BENCHMARK("Reference definitions")
+        {
+        size_t count{ 0 };
+        for (const auto ch : text)
+            {
+            count += is_character::reference::is_word_character(ch) +
+                     is_character::reference::is_space(ch) +
+                     is_character::reference::is_punctuation(ch) +
+                     is_character::reference::can_character_begin_word(ch);
+            }
+        return count;
+        };
+
+    BENCHMARK("Lookup table")
+        {
+        size_t count{ 0 };
+        for (const auto ch : text)
+            {
+            count += is_character{}(ch) + is_character::is_space(ch) +
+                     is_character::is_punctuation(ch) +
+                     is_character::can_character_begin_word(ch);
+            }
+        return count;
+        };
+    }
+
 // NOLINTEND
 // clang-format on
@@ -0,0 +1,98 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "../src/indexing/pipeline_stats.h"
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+// clang-format off
+// NOLINTBEGIN
+
+using namespace pipeline_stats;
+
+TEST_CASE("Pipeline stats", "[pipeline-stats]")
+    {
+    reset();
+
+    SECTION("Disabled")
+        {
+        set_enabled(false);
+            {
+            scoped_timer timer(stage::tokenize, "tokenize");
+            CHECK_FALSE(timer.is_active());
+            }
+        CHECK(to_json().find("\"tokenize\"") == std::string::npos);
+        CHECK(to_chrome_trace() == "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}");
+        }
+
+    SECTION("Totals and trace")
+        {
+        set_enabled(true);
+            {
+            scoped_timer timer(stage::extract, "BaseProject::ExtractRawText");
+            CHECK(timer.is_active());
+            timer.set_items(42);
+            timer.set_detail("C:\\docs\\\"a\".txt");
+            }
+        add_time(stage::syllabize, std::chrono::milliseconds(5), 100);
+        set_enabled(false);
+
+        const auto json = to_json();
+        CHECK(json.find("{\"stage\":\"extract\",\"calls\":1,\"items\":42,") != std::string::npos);
+        CHECK(json.find("{\"stage\":\"syllabize\",\"calls\":1,\"items\":100,\"totalMs\":5.0") != std::string::npos);
+        const auto trace = to_chrome_trace();
+        CHECK(trace.find("\"name\":\"BaseProject::ExtractRawText\",\"cat\":\"extract\",\"ph\":\"X\"") != std::string::npos);
+        CHECK(trace.find("\"detail\":\"C:\\\\docs\\\\\\\"a\\\".txt\"") != std::string::npos);
+        // totals-only stages are not in the trace
+        CHECK(trace.find("\"syllabize\"") == std::string::npos);
+        }
+
+    SECTION("Nested timers are only counted once")
+        {
+        set_enabled(true);
+            {
+            scoped_timer outer(stage::ui_population, "outer");
+                {
+                scoped_timer inner(stage::ui_population, "inner");
+                }
+            }
+        set_enabled(false);
+        CHECK(to_json().find("{\"stage\":\"ui-population\",\"calls\":1,") != std::string::npos);
+        const auto trace = to_chrome_trace();
+        CHECK(trace.find("\"name\":\"outer\"") != std::string::npos);
+        CHECK(trace.find("\"name\":\"inner\"") != std::string::npos);
+        }
+
+    SECTION("Threads")
+        {
+        set_enabled(true);
+        std::thread worker([]()
+            {
+            scoped_timer timer(stage::statistics, "worker");
+            timer.set_items(1);
+            });
+        worker.join();
+            {
+            scoped_timer timer(stage::statistics, "main");
+            timer.set_items(2);
+            }
+        set_enabled(false);
+        // results from a finished thread are kept and merged into the totals
+        CHECK(to_json().find("\"stages\":[{\"stage\":\"statistics\",\"calls\":2,\"items\":3,") != std::string::npos);
+        reset();
+        CHECK(to_json().find("\"statistics\"") == std::string::npos);
+        }
+    }
+
+// NOLINTEND
+// clang-format on
@@ -13,6 +13,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <bitset>
 #include "../src/projects/project_refresh.h"
 
 // clang-format off
@@ -52,6 +53,29 @@ TEST_CASE("Project refresh", "[project]")
         CHECK(bp.IsTextSectionRefreshRequired());
         CHECK(bp.IsDocumentReindexingRequired() == false);
         }
+    SECTION("Missing passes")
+        {
+        ProjectRefresh bp;
+        bp.RefreshRequired(ProjectRefresh::Minimal);
+        // everything needed was loaded (and more)
+        CHECK_FALSE(bp.RefreshRequiredForMissingPasses(std::bitset<3>{ 0b001 }, std::bitset<3>{ 0b011 }));
+        CHECK_FALSE(bp.RefreshRequiredForMissingPasses(std::bitset<3>{ 0 }, std::bitset<3>{ 0 }));
+        CHECK(bp.IsRefreshRequired());
+        CHECK(bp.IsDocumentReindexingRequired() == false);
+        // a pass that is needed now was skipped
+        CHECK(bp.RefreshRequiredForMissingPasses(std::bitset<3>{ 0b101 }, std::bitset<3>{ 0b001 }));
+        CHECK(bp.IsRefreshRequired());
+        CHECK(bp.IsDocumentReindexingRequired());
+        // other requested refreshes are kept
+        bp.ResetRefreshRequired();
+        bp.RefreshRequired(ProjectRefresh::TextSection);
+        CHECK(bp.RefreshRequiredForMissingPasses(std::bitset<3>{ 0b100 }, std::bitset<3>{ 0 }));
+        CHECK(bp.IsTextSectionRefreshRequired());
+        CHECK(bp.IsDocumentReindexingRequired());
+        // reindexing is only requested, never cleared
+        CHECK_FALSE(bp.RefreshRequiredForMissingPasses(std::bitset<3>{ 0 }, std::bitset<3>{ 0b111 }));
+        CHECK(bp.IsDocumentReindexingRequired());
+        }
     }
 // NOLINTEND
 // clang-format on
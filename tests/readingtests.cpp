@@ -202,6 +202,57 @@ TEST_CASE("Test collections", "[test-collection][readability-tests]")
         col.add_test(BOFFO);
         CHECK(col.get_grade_level_test_count() == 2);
         }
+    SECTION("KeyLookup")
+        {
+        CHECK(readability::find_test_key(L"flesch-test") == readability::test_key::flesch);
+        CHECK(readability::find_test_key(L"boffo") == readability::test_key::TEST_KEY_COUNT);
+        readability::readability_test_collection<readability::readability_project_test<std::vector<double>>> col;
+        CHECK(col.find_test(readability::test_key::lix).second == false);
+        readability::readability_test LIX(L"lix-test", 8, L"Lix test", L"Laebarindex", L"This is the lix test", readability::readability_test_type::grade_level, false, L"");
+        readability::readability_test RIX(L"rix-test", 9, L"Rix test", L"Rate index", L"Rate index is great", readability::readability_test_type::grade_level, false, L"");
+        readability::readability_test BOFFO(L"Boffo", 10, L"Boffo test", L"Boffo", L"Boffo is great", readability::readability_test_type::index_value, false, L"");
+        CHECK(LIX.get_key() == readability::test_key::lix);
+        CHECK(BOFFO.get_key() == readability::test_key::TEST_KEY_COUNT);
+        // keys should still point to the right tests after others are inserted in front of them
+        col.add_test(RIX);
+        col.add_test(BOFFO);
+        col.add_test(LIX);
+        CHECK(col.find_test(readability::test_key::lix).second);
+        CHECK(col.find_test(readability::test_key::lix).first->get_test().get_id() == L"lix-test");
+        CHECK(col.find_test(readability::test_key::rix).first->get_test().get_interface_id() == 9);
+        CHECK(col.find_test(readability::test_key::flesch).second == false);
+        CHECK(col.is_test_included(readability::test_key::rix) == false);
+        col.include_test(readability::test_key::rix, true);
+        CHECK(col.is_test_included(L"rix-test"));
+        col.clear();
+        CHECK(col.find_test(readability::test_key::rix).second == false);
+        }
+    SECTION("IncludedFactors")
+        {
+        readability::readability_test_collection<readability::readability_project_test<std::vector<double>>> col;
+        readability::readability_test DC(L"dale-chall-test", 1, L"DC", L"Dale-Chall", L"Dale-Chall test", readability::readability_test_type::grade_level, false, L"");
+        DC.add_factor(readability::test_factor::word_familiarity_dale_chall);
+        DC.add_factor(readability::test_factor::sentence_length);
+        readability::readability_test SPACHE(L"spache-test", 2, L"Spache", L"Spache", L"Spache test", readability::readability_test_type::grade_level, false, L"");
+        SPACHE.add_factor(readability::test_factor::word_familiarity_spache);
+        readability::readability_test SMOG(L"smog-test", 3, L"SMOG", L"SMOG", L"SMOG test", readability::readability_test_type::grade_level, false, L"");
+        SMOG.add_factor(readability::test_factor::word_complexity_3_plus_syllables);
+        col.add_test(DC);
+        col.add_test(SPACHE);
+        col.add_test(SMOG);
+        // nothing included yet
+        CHECK(col.get_included_test_factors().none());
+        col.include_test(readability::test_key::smog, true);
+        auto factors = col.get_included_test_factors();
+        CHECK(factors.test(static_cast<size_t>(readability::test_factor::word_complexity_3_plus_syllables)));
+        CHECK_FALSE(factors.test(static_cast<size_t>(readability::test_factor::word_familiarity_dale_chall)));
+        CHECK_FALSE(factors.test(static_cast<size_t>(readability::test_factor::word_familiarity_spache)));
+        col.include_test(readability::test_key::dale_chall, true);
+        factors = col.get_included_test_factors();
+        CHECK(factors.test(static_cast<size_t>(readability::test_factor::word_familiarity_dale_chall)));
+        CHECK(factors.test(static_cast<size_t>(readability::test_factor::sentence_length)));
+        CHECK_FALSE(factors.test(static_cast<size_t>(readability::test_factor::word_familiarity_spache)));
+        }
     }
 
 TEST_CASE("Base test tests", "[base-test][readability-tests]")
@@ -0,0 +1,29 @@
+-- Loads the example documents into a batch project while running headless
+-- (where the project doesn't have a window) and checks that they were analyzed.
+--
+-- Run with: readstudio --headless --lua=headless-batch-project.lua
+
+ExamplesFolder = Application.GetAbsoluteFilePath(
+            Debug.GetScriptFolder(),
+            "../../examples/")
+
+docs = BatchProject(ExamplesFolder)
+
+-- (nothing is returned if the project couldn't be created)
+stats = docs:GetDocumentStatistics()
+if stats == nil then
+  error("Unable to create a batch project from " .. ExamplesFolder)
+end
+if stats:GetRowCount() == 0 then
+  error("No documents were loaded from " .. ExamplesFolder)
+end
+
+-- every loaded document should have been indexed
+if stats:GetColumn("Words"):Min() <= 0 then
+  error("A document was loaded without any words")
+end
+if stats:GetColumn("Sentences"):Min() <= 0 then
+  error("A document was loaded without any sentences")
+end
+
+docs:Close()
@@ -0,0 +1,98 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "../src/projects/settings_xml_index.h"
+#include <catch2/catch_test_macros.hpp>
+
+// clang-format off
+// NOLINTBEGIN
+
+using namespace std::literals::string_view_literals;
+
+namespace
+    {
+    std::wstring_view SectionText(const SettingsXmlIndex::Section& section)
+        {
+        return (section.first == nullptr) ? std::wstring_view{} :
+            std::wstring_view{ section.first, static_cast<size_t>(section.second - section.first) };
+        }
+    }
+
+TEST_CASE("Settings XML index", "[project][settings-xml]")
+    {
+    SECTION("Sections")
+        {
+        const std::wstring text{ L"<?xml version=\"1.0\"?>\n<project version=\"2.0\">"
+                                 L"<document><path>a.txt</path><path>b.txt</path><reviewer>Bob</reviewer></document>"
+                                 L"<grammar><value>1</value></grammar></project>" };
+        const SettingsXmlIndex index(text.c_str(), text.c_str() + text.length());
+        CHECK(index.GetElementCount() == 7);
+        CHECK(SectionText(index.FindSection(L"grammar"sv)) == L"<grammar><value>1</value>");
+        CHECK(SectionText(index.FindSection("reviewer"sv)) == L"<reviewer>Bob");
+        CHECK(index.FindSection(L"missing"sv).first == nullptr);
+        // names must match exactly (not just as a prefix)
+        CHECK(index.FindSection(L"doc"sv).first == nullptr);
+        }
+
+    SECTION("Within parent")
+        {
+        const std::wstring text{ L"<graphs><title><color>red</color></title><axis><color>blue</color></axis></graphs>"
+                                 L"<color>green</color>" };
+        const SettingsXmlIndex index(text.c_str(), text.c_str() + text.length());
+        const auto axis = index.FindSection(L"axis"sv);
+        CHECK(SectionText(index.FindSection(L"color"sv, axis.first, axis.second)) == L"<color>blue");
+        const auto graphs = index.FindSection(L"graphs"sv);
+        CHECK(SectionText(index.FindSection(L"color"sv, graphs.first, graphs.second)) == L"<color>red");
+        // not in the parent
+        const auto title = index.FindSection(L"title"sv);
+        CHECK(index.FindSection(L"axis"sv, title.first, title.second).first == nullptr);
+        }
+
+    SECTION("Siblings")
+        {
+        const std::wstring text{ L"<tests><test>1</test><test>2</test><test>3</test></tests>" };
+        const SettingsXmlIndex index(text.c_str(), text.c_str() + text.length());
+        const auto tests = index.FindSection(L"tests"sv);
+        std::vector<std::wstring_view> values;
+        for (auto test = index.FindSection(L"test"sv, tests.first, tests.second);
+             test.first != nullptr;
+             test = index.FindSection(L"test"sv, test.second, tests.second))
+            { values.push_back(SectionText(test)); }
+        CHECK(values == std::vector<std::wstring_view>{ L"<test>1", L"<test>2", L"<test>3" });
+        }
+
+    SECTION("Nested and self-closing")
+        {
+        const std::wstring text{ L"<list><list><item value=\"a>b\"/></list><empty /></list>" };
+        const SettingsXmlIndex index(text.c_str(), text.c_str() + text.length());
+        CHECK(SectionText(index.FindSection(L"list"sv)) == L"<list><list><item value=\"a>b\"/></list><empty />");
+        CHECK(SectionText(index.FindSection(L"item"sv)) == L"<item value=\"a>b\"/>");
+        CHECK(SectionText(index.FindSection(L"empty"sv)) == L"<empty />");
+        }
+
+    SECTION("Malformed")
+        {
+        const std::wstring text{ L"<!-- <grammar> --><open><closed>1</closed><![CDATA[<fake>]]>" };
+        const SettingsXmlIndex index(text.c_str(), text.c_str() + text.length());
+        CHECK(index.FindSection(L"grammar"sv).first == nullptr);
+        CHECK(index.FindSection(L"fake"sv).first == nullptr);
+        // never closed
+        CHECK(index.FindSection(L"open"sv).first == nullptr);
+        CHECK(SectionText(index.FindSection(L"closed"sv)) == L"<closed>1");
+        const SettingsXmlIndex emptyIndex(nullptr, nullptr);
+        CHECK(emptyIndex.GetElementCount() == 0);
+        }
+    }
+
+// NOLINTEND
+// clang-format on
@@ -0,0 +1,110 @@
+/********************************************************************************
+ * Copyright (c) 2005-2025 Blake Madden
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0.
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ *
+ * Contributors:
+ *   Blake Madden - initial implementation
+ ********************************************************************************/
+
+#include "../src/indexing/utf8_decode.h"
+#include <catch2/catch_test_macros.hpp>
+
+// clang-format off
+// NOLINTBEGIN
+
+using namespace encoding;
+using namespace std::literals::string_view_literals;
+
+TEST_CASE("BOM sniffing", "[utf8-decode]")
+    {
+    CHECK(sniff_bom("") == byte_order_mark::none);
+    CHECK(sniff_bom("hello") == byte_order_mark::none);
+    CHECK(sniff_bom("\xEF\xBB\xBFhello") == byte_order_mark::utf8);
+    CHECK(sniff_bom("\xFF\xFEh\0"sv) == byte_order_mark::utf16_little_endian);
+    CHECK(sniff_bom("\xFE\xFF\0h"sv) == byte_order_mark::utf16_big_endian);
+    CHECK(sniff_bom("\xFF\xFE\0\0"sv) == byte_order_mark::utf32_little_endian);
+    CHECK(sniff_bom("\0\0\xFE\xFF"sv) == byte_order_mark::utf32_big_endian);
+    CHECK(bom_length(byte_order_mark::utf8) == 3);
+    CHECK(bom_length(byte_order_mark::none) == 0);
+    }
+
+TEST_CASE("ASCII prefix", "[utf8-decode]")
+    {
+    CHECK(ascii_prefix_length("") == 0);
+    CHECK(ascii_prefix_length("short") == 5);
+    // non-ASCII at every position, so that the vectorized, word, and byte loops are all hit
+    const std::string ascii(40, 'a');
+    for (size_t i = 0; i < ascii.length(); ++i)
+        {
+        std::string text{ ascii };
+        text[i] = '\xC3';
+        CHECK(ascii_prefix_length(text) == i);
+        }
+    CHECK(ascii_prefix_length(ascii) == ascii.length());
+    }
+
+TEST_CASE("UTF-8 validation", "[utf8-decode]")
+    {
+    CHECK(is_valid_utf8(""));
+    CHECK(is_valid_utf8("plain ASCII text that is longer than sixteen bytes"));
+    CHECK(is_valid_utf8("caf\xC3\xA9 na\xC3\xAFve"));
+    CHECK(is_valid_utf8("\xE2\x82\xAC"));         // euro sign
+    CHECK(is_valid_utf8("\xF0\x9F\x98\x80"));     // emoji
+    CHECK_FALSE(is_valid_utf8("\xC3"));           // truncated
+    CHECK_FALSE(is_valid_utf8("\xC0\xAF"));       // overlong
+    CHECK_FALSE(is_valid_utf8("\xE0\x80\xAF"));   // overlong
+    CHECK_FALSE(is_valid_utf8("\xED\xA0\x80"));   // surrogate
+    CHECK_FALSE(is_valid_utf8("\xF4\x90\x80\x80")); // past U+10FFFF
+    CHECK_FALSE(is_valid_utf8("caf\xE9"));        // Latin-1
+    CHECK_FALSE(is_valid_utf8("\x80"));           // stray continuation
+    }
+
+TEST_CASE("UTF-8 widening", "[utf8-decode]")
+    {
+    std::wstring buffer;
+
+    SECTION("ASCII")
+        {
+        CHECK(utf8_to_wide("The quick brown fox jumps over the lazy dog.", buffer));
+        CHECK(buffer == L"The quick brown fox jumps over the lazy dog.");
+        CHECK(utf8_to_wide("", buffer));
+        CHECK(buffer.empty());
+        }
+
+    SECTION("Mixed")
+        {
+        CHECK(utf8_to_wide("A long run of ASCII before an accent: caf\xC3\xA9, and more ASCII.",
+                           buffer));
+        CHECK(buffer == L"A long run of ASCII before an accent: café, and more ASCII.");
+        CHECK(utf8_to_wide("\xE2\x82\xAC" "5", buffer));
+        CHECK(buffer == L"€5");
+        }
+
+    SECTION("Supplementary plane")
+        {
+        CHECK(utf8_to_wide("a\xF0\x9F\x98\x80z", buffer));
+        CHECK(buffer == L"a\U0001F600z");
+        }
+
+    SECTION("Invalid")
+        {
+        CHECK_FALSE(utf8_to_wide("valid start, then Latin-1: caf\xE9", buffer));
+        }
+
+    SECTION("Buffer reuse")
+        {
+        CHECK(utf8_to_wide(std::string(1000, 'x'), buffer));
+        const auto capacity = buffer.capacity();
+        CHECK(utf8_to_wide("short", buffer));
+        CHECK(buffer == L"short");
+        CHECK(buffer.capacity() == capacity);
+        }
+    }
+
+// NOLINTEND
+// clang-format on
@@ -118,6 +118,70 @@ TEST_CASE("Spell checker", "[spellchecker]")
         CHECK(spellCheck(MYWORD(L"the\\ncat")));
         CHECK_FALSE(spellCheck(MYWORD(L"the\\ncatz")));
         }
+    SECTION("Known Spelling Probe")
+        {
+        word_list knownWords;
+        word_list customKnownWords;
+        word_list programmerWords;
+        knownWords.load_words(L"the cat in cat is all about that nothing", true, true);
+        customKnownWords.add_word(L"dogs");
+        programmerWords.load_words(L"printf", true, true);
+        is_correctly_spelled_word<MYWORD,word_list> spellCheck(&knownWords, &customKnownWords, &programmerWords, false, false, false, true, true, true, true);
+        // should match checking a newly constructed word (i.e., no flags set)
+        for (const auto* text : { L"Cat", L"cats", L"dogs", L"all-about", L"all-aboutz", L"printf",
+                                  L"camelCaseWord", L"Text1", L"nothin'", L"readme.txt", L"" })
+            {
+            CHECK(spellCheck.is_known_spelling(word_list::word_type{ text }) == spellCheck(MYWORD(text)));
+            }
+        CHECK(spellCheck.is_known_spelling(word_list::word_type{ L"nothin'" }));
+        CHECK_FALSE(spellCheck.is_known_spelling(word_list::word_type{ L"cats" }));
+        }
+    SECTION("Verdict Cache")
+        {
+        word_list knownWords;
+        word_list customKnownWords;
+        word_list programmerWords;
+        knownWords.load_words(L"the cat in cat is all about that nothing", true, true);
+        programmerWords.load_words(L"printf", true, true);
+        spelling_verdict_cache verdicts;
+        is_correctly_spelled_word<MYWORD,word_list> spellCheck(&knownWords, &customKnownWords, &programmerWords, false, false, false, true, true, true, true);
+        is_correctly_spelled_word<MYWORD,word_list> cachedSpellCheck(&knownWords, &customKnownWords, &programmerWords, false, false, false, true, true, true, true);
+        cachedSpellCheck.set_verdict_cache(&verdicts);
+        CHECK(cachedSpellCheck.get_verdict_cache() == &verdicts);
+        const auto texts = { L"Cat", L"cat", L"cats", L"dogs", L"all-about", L"all-aboutz", L"printf",
+                             L"camelCaseWord", L"Text1", L"nothin'", L"readme.txt", L"" };
+        // first pass fills the cache, the second reads from it
+        for (int pass = 0; pass < 2; ++pass)
+            {
+            for (const auto* text : texts)
+                {
+                CHECK(cachedSpellCheck(MYWORD(text)) == spellCheck(MYWORD(text)));
+                CHECK(cachedSpellCheck.is_known_spelling(word_list::word_type{ text }) ==
+                      spellCheck.is_known_spelling(word_list::word_type{ text }));
+                }
+            }
+        // word text is cached case sensitively
+        CHECK(verdicts.size() == texts.size() - 1);
+        // word flags and options are part of the verdict
+        CHECK_FALSE(cachedSpellCheck(MYWORD(L"Za",2,0,0,0,false,true,false,false,1,0)));
+        CHECK(cachedSpellCheck(MYWORD(L"Za",2,0,0,0,false,true,false,true,1,0)));
+        CHECK_FALSE(cachedSpellCheck(MYWORD(L"Za",2,0,0,0,false,true,false,false,1,0)));
+        cachedSpellCheck.ignore_programmer_code(false);
+        CHECK_FALSE(cachedSpellCheck(MYWORD(L"camelCaseWord")));
+        cachedSpellCheck.ignore_programmer_code(true);
+        CHECK(cachedSpellCheck(MYWORD(L"camelCaseWord")));
+        // editing a dictionary invalidates what was cached
+        CHECK_FALSE(cachedSpellCheck(MYWORD(L"dogs")));
+        customKnownWords.add_word(L"dogs");
+        CHECK(cachedSpellCheck(MYWORD(L"dogs")));
+        CHECK(verdicts.size() == 1);
+        knownWords.load_words(L"cats", true, true);
+        CHECK(cachedSpellCheck(MYWORD(L"cats")));
+        CHECK_FALSE(cachedSpellCheck(MYWORD(L"dog")));
+        verdicts.clear();
+        CHECK(verdicts.size() == 0);
+        CHECK(cachedSpellCheck(MYWORD(L"dogs")));
+        }
     }
 
 TEST_CASE("Social Media", "[social-media]")
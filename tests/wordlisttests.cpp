@@ -13,6 +13,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../src/indexing/perfect_hash_set.h"
 #include "../src/indexing/word_list.h"
 #include "../src/indexing/word.h"
 #include "../src/readability/readability.h"
@@ -919,5 +920,44 @@ TEST_CASE("Word lists", "[word-list]")
         CHECK(WL.get_words().at(3) == L"the");
         }
     }
+TEST_CASE("Perfect hash set", "[word-list]")
+    {
+    static constexpr grammar::perfect_hash_set words{ { L"am", L"are", L"aren't", L"I", L"\u0438\u043B\u0438" } };
+    static_assert(words.size() == 5);
+
+    SECTION("Contains")
+        {
+        CHECK(words.contains(L"am"));
+        CHECK(words.contains(L"are"));
+        CHECK(words.contains(L"aren't"));
+        CHECK(words.contains(L"I"));
+        CHECK(words.contains(L"\u0438\u043B\u0438"));
+        }
+    SECTION("Case insensitive")
+        {
+        CHECK(words.contains(L"AM"));
+        CHECK(words.contains(L"aRe"));
+        CHECK(words.contains(L"i"));
+        CHECK(words.contains(L"\u0418\u041B\u0418"));
+        // full-width
+        CHECK(words.contains(L"\xFF41\xFF4D"));
+        CHECK(words.contains(L"\xFF21\xFF2D"));
+        }
+    SECTION("Apostrophes")
+        {
+        CHECK(words.contains(L"aren\u2019t"));
+        CHECK(words.contains(L"AREN\u2019T"));
+        CHECK_FALSE(words.contains(L"arent"));
+        }
+    SECTION("Not contained")
+        {
+        CHECK_FALSE(words.contains(L""));
+        CHECK_FALSE(words.contains(L"a"));
+        CHECK_FALSE(words.contains(L"ar"));
+        CHECK_FALSE(words.contains(L"ares"));
+        CHECK_FALSE(words.contains(L"is"));
+        CHECK_FALSE(words.contains(L"\u0438"));
+        }
+    }
 // NOLINTEND
 // clang-format on
@@ -5,6 +5,7 @@ SET(APP_SRC_FILES
     src/app/readability_app_options.cpp
     src/app/readability_app.cpp
     src/document-helpers/chapter_split.cpp
+    src/document-helpers/duplicate_file_finder.cpp
     src/graphs/frasegraph.cpp
     src/graphs/frygraph.cpp
     src/graphs/polygon_readability_graph.cpp
@@ -12,21 +13,21 @@ SET(APP_SRC_FILES
     src/graphs/schwartzgraph.cpp
     src/indexing/abbreviation.cpp
     src/indexing/article.cpp
-    src/indexing/conjunction.cpp
     src/indexing/contraction.cpp
     src/indexing/diacritics.cpp
     src/indexing/double_words.cpp
-    src/indexing/negating_word.cpp
     src/indexing/passive_voice.cpp
-    src/indexing/pronoun.cpp
+    src/indexing/pipeline_stats.cpp
     src/indexing/romanize.cpp
     src/indexing/stop_lists.cpp
     src/indexing/syllable.cpp
     src/indexing/word_functional.cpp
+    src/lua-scripting/lua_analysis_views.cpp
     src/lua-scripting/lua_application.cpp
     src/lua-scripting/lua_batch_project.cpp
     src/lua-scripting/lua_debug.cpp
     src/lua-scripting/lua_interface.cpp
+    src/lua-scripting/lua_profiler.cpp
     src/lua-scripting/lua_screenshot.cpp
     src/lua-scripting/lua_standard_project.cpp
     src/lua-scripting/onelua_no_warnings.c
@@ -35,14 +36,22 @@ SET(APP_SRC_FILES
     src/projects/base_project.cpp
     src/projects/batch_project_doc.cpp
     src/projects/batch_project_view.cpp
+    src/projects/document_scorer.cpp
+    src/projects/embedded_text_writer.cpp
+    src/projects/http_request.cpp
     src/projects/project_frame.cpp
+    src/projects/scoring_engine.cpp
+    src/projects/scoring_server.cpp
+    src/projects/source_file_watcher.cpp
     src/projects/standard_project_doc.cpp
     src/projects/standard_project_view.cpp
+    src/projects/watch_folder_service.cpp
     src/results-format/project_report_format.cpp
     src/results-format/readability_messages.cpp
     src/test-helpers/readability_formula_parser.cpp
     src/tinyexpr-plusplus/tinyexpr.cpp
     src/tinyxml2/tinyxml2.cpp
+    src/ui/controls/batch_findings_provider.cpp
     src/ui/controls/explanation_listctrl.cpp
     src/ui/controls/word_list_property.cpp
     src/ui/dialogs/about_dlg_ex.cpp
@@ -61,6 +70,7 @@ SET(APP_SRC_FILES
     src/ui/dialogs/web_harvester_dlg.cpp
     src/ui/dialogs/word_list_dlg.cpp
     src/webharvester/filepathresolver.cpp
+    src/webharvester/visitedurlset.cpp
     src/webharvester/webharvester.cpp
     src/Wisteria-Dataviz/src/base/axis.cpp
     src/Wisteria-Dataviz/src/base/canvas.cpp